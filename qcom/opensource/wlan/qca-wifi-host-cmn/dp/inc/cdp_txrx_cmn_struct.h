@@ -93,6 +93,8 @@
 #define CDP_DP_RX_FISA_STATS	   26
 #define CDP_DP_SWLM_STATS	   27
 #define CDP_DP_TX_HW_LATENCY_STATS 28
+#define CDP_WBUFF_STATS            29
+#define CDP_DP_LAT_TRACE_STATS     30
 
 #define WME_AC_TO_TID(_ac) (       \
 		((_ac) == WME_AC_VO) ? 6 : \
@@ -2508,6 +2510,121 @@ struct cdp_monitor_filter {
 	uint16_t mo_data;
 };
 
+#ifdef QCA_MONITOR_CAP_RING
+#define CDP_MON_CAP_HDR_MAGIC		0x4d43
+#define CDP_MON_CAP_HDR_VERSION		1
+
+#define CDP_MON_CAP_FLAG_FCS_ERR	0x0001
+#define CDP_MON_CAP_FLAG_TRUNCATED	0x0002
+#define CDP_MON_CAP_FLAG_SGI		0x0004
+#define CDP_MON_CAP_FLAG_LDPC		0x0008
+#define CDP_MON_CAP_FLAG_STBC		0x0010
+
+/**
+ * struct cdp_mon_cap_hdr - per MPDU record header in the capture ring
+ * @magic: CDP_MON_CAP_HDR_MAGIC, used by the consumer to resync
+ * @version: CDP_MON_CAP_HDR_VERSION
+ * @hdr_len: length of this header
+ * @rec_len: total record length including header and padding
+ * @cap_len: number of frame bytes following the header
+ * @orig_len: length of the MPDU as received
+ * @seq: per pdev record sequence number, gaps indicate ring drops
+ * @ppdu_id: PPDU id, shared by all MPDUs of one PPDU
+ * @tsft: TSF of the PPDU
+ * @chan_freq: channel frequency in MHz
+ * @chan_noise_floor: channel noise floor in dBm
+ * @rssi_comb: combined RSSI
+ * @preamble_type: preamble type (legacy/HT/VHT/HE/EHT)
+ * @mcs: MCS index
+ * @nss: number of spatial streams
+ * @bw: PPDU bandwidth
+ * @reception_type: SU/MU-MIMO/OFDMA reception type
+ * @reserved: reserved, set to 0
+ * @flags: CDP_MON_CAP_FLAG_* bits
+ */
+struct cdp_mon_cap_hdr {
+	uint16_t magic;
+	uint8_t version;
+	uint8_t hdr_len;
+	uint32_t rec_len;
+	uint32_t cap_len;
+	uint32_t orig_len;
+	uint32_t seq;
+	uint32_t ppdu_id;
+	uint64_t tsft;
+	uint16_t chan_freq;
+	int16_t chan_noise_floor;
+	int8_t rssi_comb;
+	uint8_t preamble_type;
+	uint8_t mcs;
+	uint8_t nss;
+	uint8_t bw;
+	uint8_t reception_type;
+	uint16_t reserved;
+	uint32_t flags;
+} qdf_packed;
+
+/**
+ * struct cdp_mon_cap_ring_cfg - capture ring configuration
+ * @snaplen: max number of frame bytes copied per MPDU, 0 for full MPDU
+ * @subbuf_size: size of one ring sub-buffer in bytes
+ * @num_subbufs: number of sub-buffers per cpu
+ * @filter: frame filter pushed down to the monitor rings
+ */
+struct cdp_mon_cap_ring_cfg {
+	uint32_t snaplen;
+	uint32_t subbuf_size;
+	uint32_t num_subbufs;
+	struct cdp_monitor_filter filter;
+};
+
+/**
+ * struct cdp_mon_cap_ring_stats - capture ring statistics
+ * @mpdu_captured: MPDU records written to the ring
+ * @bytes_captured: frame bytes written to the ring
+ * @mpdu_truncated: MPDU records truncated to snaplen
+ * @drop_ring_full: MPDUs dropped because the consumer lagged
+ * @drop_restitch: MPDUs dropped because restitching failed
+ */
+struct cdp_mon_cap_ring_stats {
+	uint64_t mpdu_captured;
+	uint64_t bytes_captured;
+	uint32_t mpdu_truncated;
+	uint32_t drop_ring_full;
+	uint32_t drop_restitch;
+};
+#endif /* QCA_MONITOR_CAP_RING */
+
+/**
+ * enum cdp_lat_trace_stage - packet stages time stamped by the DP stage
+ *	latency tracer
+ * @CDP_LAT_TX_HDD_XMIT: frame entered hdd_hard_start_xmit, starts a trace
+ * @CDP_LAT_TX_DP_SEND: frame entered dp_tx_send
+ * @CDP_LAT_TX_TCL_ENQ: descriptor written to the TCL ring
+ * @CDP_LAT_TX_FW_COMP: completion reaped from the WBM release ring
+ * @CDP_LAT_TX_COMP_PROC: completion processed by the tx completion handler
+ * @CDP_LAT_TX_FREE: frame freed back to the stack, ends the trace
+ * @CDP_LAT_RX_REAP: frame reaped from the REO destination ring, starts a
+ *  trace
+ * @CDP_LAT_RX_DELIVER: frame handed to the OS shim
+ * @CDP_LAT_RX_HDD: frame entered the HDD rx callback
+ * @CDP_LAT_RX_STACK: frame delivered to the network stack, ends the trace
+ * @CDP_LAT_STAGE_MAX: number of stages
+ */
+enum cdp_lat_trace_stage {
+	CDP_LAT_TX_HDD_XMIT,
+	CDP_LAT_TX_DP_SEND,
+	CDP_LAT_TX_TCL_ENQ,
+	CDP_LAT_TX_FW_COMP,
+	CDP_LAT_TX_COMP_PROC,
+	CDP_LAT_TX_FREE,
+	CDP_LAT_RX_REAP,
+	CDP_LAT_RX_DELIVER,
+	CDP_LAT_RX_HDD,
+	CDP_LAT_RX_STACK,
+	CDP_LAT_STAGE_MAX,
+};
+
 /**
  * enum cdp_dp_cfg - CDP ENUMs to get to DP configation
  * @cfg_dp_enable_data_stall: context passed to be used by consumer
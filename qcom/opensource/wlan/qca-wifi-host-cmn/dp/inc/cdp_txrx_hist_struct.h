@@ -55,11 +55,13 @@ enum cdp_hist_bucket_index {
  * @CDP_HIST_TYPE_SW_ENQEUE_DELAY: From stack to HW enqueue delay
  * @CDP_HIST_TYPE_HW_COMP_DELAY: From HW enqueue to completion delay
  * @CDP_HIST_TYPE_REAP_STACK: Rx HW reap to stack deliver delay
+ * @CDP_HIST_TYPE_STAGE_LAT: Per packet stage to stage latency in us
  */
 enum cdp_hist_types {
 	CDP_HIST_TYPE_SW_ENQEUE_DELAY,
 	CDP_HIST_TYPE_HW_COMP_DELAY,
 	CDP_HIST_TYPE_REAP_STACK,
+	CDP_HIST_TYPE_STAGE_LAT,
 	CDP_HIST_TYPE_MAX,
 };
 
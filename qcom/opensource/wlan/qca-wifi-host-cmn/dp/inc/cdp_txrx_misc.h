@@ -960,4 +960,27 @@ cdp_get_tx_rings_grp_bitmap(ol_txrx_soc_handle soc)
 
 	return 0;
 }
+
+#ifdef WLAN_DP_LAT_TRACE
+/**
+ * cdp_lat_trace_stamp() - time stamp a packet at a DP latency trace stage
+ * @soc: soc handle
+ * @nbuf: packet
+ * @stage: stage the packet is at
+ *
+ * Called per packet, an invalid instance is not logged.
+ *
+ * Return: none
+ */
+static inline void
+cdp_lat_trace_stamp(ol_txrx_soc_handle soc, qdf_nbuf_t nbuf,
+		    enum cdp_lat_trace_stage stage)
+{
+	if (qdf_unlikely(!soc || !soc->ops || !soc->ops->misc_ops))
+		return;
+
+	if (soc->ops->misc_ops->lat_trace_stamp)
+		soc->ops->misc_ops->lat_trace_stamp(soc, nbuf, stage);
+}
+#endif /* WLAN_DP_LAT_TRACE */
 #endif /* _CDP_TXRX_MISC_H_ */
@@ -68,4 +68,83 @@ cdp_deliver_tx_mgmt(ol_txrx_soc_handle soc, uint8_t pdev_id,
 	return soc->ops->mon_ops->txrx_deliver_tx_mgmt(soc, pdev_id, nbuf);
 }
 
+#ifdef QCA_MONITOR_CAP_RING
+/**
+ * cdp_mon_cap_ring_enable() - Enable the monitor capture ring
+ * @soc: Datapath SOC handle
+ * @pdev_id: id of datapath PDEV handle
+ * @cfg: capture ring configuration
+ *
+ * Monitor MPDUs are written to a per pdev stream channel prefixed with a
+ * struct cdp_mon_cap_hdr instead of being delivered to the monitor netdev.
+ *
+ * Return: QDF_STATUS
+ */
+static inline QDF_STATUS
+cdp_mon_cap_ring_enable(ol_txrx_soc_handle soc, uint8_t pdev_id,
+			struct cdp_mon_cap_ring_cfg *cfg)
+{
+	if (!soc || !soc->ops) {
+		dp_cdp_debug("Invalid Instance");
+		QDF_BUG(0);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	if (!soc->ops->mon_ops ||
+	    !soc->ops->mon_ops->txrx_mon_cap_ring_enable)
+		return QDF_STATUS_E_FAILURE;
+
+	return soc->ops->mon_ops->txrx_mon_cap_ring_enable(soc, pdev_id, cfg);
+}
+
+/**
+ * cdp_mon_cap_ring_disable() - Disable the monitor capture ring
+ * @soc: Datapath SOC handle
+ * @pdev_id: id of datapath PDEV handle
+ *
+ * Return: QDF_STATUS
+ */
+static inline QDF_STATUS
+cdp_mon_cap_ring_disable(ol_txrx_soc_handle soc, uint8_t pdev_id)
+{
+	if (!soc || !soc->ops) {
+		dp_cdp_debug("Invalid Instance");
+		QDF_BUG(0);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	if (!soc->ops->mon_ops ||
+	    !soc->ops->mon_ops->txrx_mon_cap_ring_disable)
+		return QDF_STATUS_E_FAILURE;
+
+	return soc->ops->mon_ops->txrx_mon_cap_ring_disable(soc, pdev_id);
+}
+
+/**
+ * cdp_mon_cap_ring_get_stats() - Get the monitor capture ring stats
+ * @soc: Datapath SOC handle
+ * @pdev_id: id of datapath PDEV handle
+ * @stats: buffer to fill the stats
+ *
+ * Return: QDF_STATUS
+ */
+static inline QDF_STATUS
+cdp_mon_cap_ring_get_stats(ol_txrx_soc_handle soc, uint8_t pdev_id,
+			   struct cdp_mon_cap_ring_stats *stats)
+{
+	if (!soc || !soc->ops) {
+		dp_cdp_debug("Invalid Instance");
+		QDF_BUG(0);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	if (!soc->ops->mon_ops ||
+	    !soc->ops->mon_ops->txrx_mon_cap_ring_get_stats)
+		return QDF_STATUS_E_FAILURE;
+
+	return soc->ops->mon_ops->txrx_mon_cap_ring_get_stats(soc, pdev_id,
+							      stats);
+}
+#endif /* QCA_MONITOR_CAP_RING */
+
 #endif
@@ -904,6 +904,16 @@ struct cdp_mon_ops {
 		(*config_full_mon_mode)(struct cdp_soc_t *soc, uint8_t val);
 	QDF_STATUS (*soc_config_full_mon_mode)(struct cdp_pdev *cdp_pdev,
 					       uint8_t val);
+#ifdef QCA_MONITOR_CAP_RING
+	QDF_STATUS (*txrx_mon_cap_ring_enable)
+		(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
+		 struct cdp_mon_cap_ring_cfg *cfg);
+	QDF_STATUS (*txrx_mon_cap_ring_disable)
+		(struct cdp_soc_t *soc_hdl, uint8_t pdev_id);
+	QDF_STATUS (*txrx_mon_cap_ring_get_stats)
+		(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
+		 struct cdp_mon_cap_ring_stats *stats);
+#endif
 };
 
 struct cdp_host_stats_ops {
@@ -1301,6 +1311,11 @@ struct ol_if_ops {
 	QDF_STATUS(*dp_send_unit_test_cmd)(uint32_t vdev_id,
 					   uint32_t module_id,
 					   uint32_t arg_count, uint32_t *arg);
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+	void (*dp_bus_bw_demand_ind)(struct cdp_ctrl_objmgr_psoc *ctrl_psoc,
+				     uint8_t intr_id, uint32_t pkts,
+				     uint8_t backlog);
+#endif
 
 };
 
@@ -1341,6 +1356,7 @@ struct ol_if_ops {
  * @set_swlm_enable: Enable or Disable Software Latency Manager.
  * @is_swlm_enabled: Check if Software latency manager is enabled or not.
  * @display_txrx_hw_info: Dump the DP rings info
+ * @lat_trace_stamp: time stamp a packet at a DP latency trace stage
  *
  * Function pointers for miscellaneous soc/pdev/vdev related operations.
  */
@@ -1433,6 +1449,10 @@ struct cdp_misc_ops {
 	uint8_t (*is_swlm_enabled)(struct cdp_soc_t *soc_hdl);
 	void (*display_txrx_hw_info)(struct cdp_soc_t *soc_hdl);
 	uint32_t (*get_tx_rings_grp_bitmap)(struct cdp_soc_t *soc_hdl);
+#ifdef WLAN_DP_LAT_TRACE
+	void (*lat_trace_stamp)(struct cdp_soc_t *soc_hdl, qdf_nbuf_t nbuf,
+				enum cdp_lat_trace_stage stage);
+#endif
 };
 
 /**
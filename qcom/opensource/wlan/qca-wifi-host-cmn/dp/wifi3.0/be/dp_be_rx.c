@@ -38,6 +38,7 @@
 #endif
 #include "dp_hist.h"
 #include "dp_rx_buffer_pool.h"
+#include "dp_lat_trace.h"
 
 #ifndef AST_OFFLOAD_ENABLE
 static void
@@ -581,6 +582,7 @@ done:
 
 		rx_pdev = vdev->pdev;
 		DP_RX_TID_SAVE(nbuf, tid);
+		dp_lat_trace_stamp(soc, nbuf, CDP_LAT_RX_REAP);
 		if (qdf_unlikely(rx_pdev->delay_stats_flag) ||
 		    qdf_unlikely(wlan_cfg_is_peer_ext_stats_enabled(
 				 soc->wlan_cfg_ctx)) ||
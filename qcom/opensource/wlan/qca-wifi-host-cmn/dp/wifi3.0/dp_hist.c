@@ -69,6 +69,22 @@ static uint16_t dp_hist_fw2hw_dbucket[CDP_HIST_BUCKET_MAX] = {
 static uint16_t dp_hist_reap2stack_bucket[CDP_HIST_BUCKET_MAX] = {
 	0, 5, 10, 15, 20, 25, 30, 35, 40, 45};
 
+/*
+ * dp_hist_stage_lat_bucket: Packet stage latency bucket in us
+ * @index_0 = 0_10 us
+ * @index_1 = 10_25 us
+ * @index_2 = 25_50 us
+ * @index_3 = 50_100 us
+ * @index_4 = 100_250 us
+ * @index_5 = 250_500 us
+ * @index_6 = 500_1000 us
+ * @index_7 = 1000_2500 us
+ * @index_8 = 2500_10000 us
+ * @index_9 = 10000+ us
+ */
+static uint16_t dp_hist_stage_lat_bucket[CDP_HIST_BUCKET_MAX] = {
+	0, 10, 25, 50, 100, 250, 500, 1000, 2500, 10000};
+
 /*
  * dp_hist_find_bucket_idx: Find the bucket index
  * @bucket_array: Bucket array
@@ -119,6 +135,10 @@ static void dp_hist_fill_buckets(struct cdp_hist_bucket *hist_bucket, int value)
 		idx =  dp_hist_find_bucket_idx(
 				&dp_hist_reap2stack_bucket[0], value);
 		break;
+	case CDP_HIST_TYPE_STAGE_LAT:
+		idx =  dp_hist_find_bucket_idx(
+				&dp_hist_stage_lat_bucket[0], value);
+		break;
 	default:
 		break;
 	}
@@ -1667,9 +1667,117 @@ void dp_ipa_deregister_op_cb(struct cdp_soc_t *soc_hdl, uint8_t pdev_id)
 	pdev->usr_ctxt = NULL;
 }
 
+#ifdef WLAN_IPA_EXC_ZERO_COPY
+/**
+ * dp_ipa_exc_zc_share() - get an nbuf to forward an IPA bcast/mcast frame
+ * @soc: soc
+ * @vdev: vdev the frame is forwarded on
+ * @nbuf: IPA exception nbuf, passed to the network stack as well
+ *
+ * The forwarded nbuf is a clone sharing the IPA buffer, which is released
+ * when both the stack and the tx completion dropped their reference. The
+ * frame is copied when the tx path of the vdev may rewrite the payload.
+ *
+ * Return: nbuf to forward, NULL if out of memory
+ */
+static qdf_nbuf_t dp_ipa_exc_zc_share(struct dp_soc *soc,
+				      struct dp_vdev *vdev,
+				      qdf_nbuf_t nbuf)
+{
+	if (qdf_unlikely(vdev->multipass_en || vdev->mesh_vdev ||
+			 vdev->tx_encap_type != htt_cmn_pkt_type_ethernet)) {
+		qdf_atomic_inc(&soc->ipa_exc_zc.copy_fallback);
+		return qdf_nbuf_copy(nbuf);
+	}
+
+	nbuf = qdf_nbuf_clone(nbuf);
+	if (nbuf)
+		qdf_atomic_inc(&soc->ipa_exc_zc.copy_avoided);
+
+	return nbuf;
+}
+
+/**
+ * dp_ipa_exc_zc_handoff() - mark an IPA buffer handed to the tx path
+ * @nbuf: nbuf about to be sent
+ *
+ * The tx completion recognizes the nbuf by its frame type and accounts the
+ * time since the handoff.
+ *
+ * Return: None
+ */
+static inline void dp_ipa_exc_zc_handoff(qdf_nbuf_t nbuf)
+{
+	qdf_nbuf_set_tx_ftype(nbuf, CB_FTYPE_INTRABSS_FWD);
+	qdf_nbuf_set_timestamp(nbuf);
+}
+
+static inline void dp_ipa_exc_zc_handoff_done(struct dp_soc *soc)
+{
+	qdf_atomic_inc(&soc->ipa_exc_zc.handoff);
+}
+
+void dp_ipa_exc_zc_release(struct dp_soc *soc, qdf_nbuf_t nbuf)
+{
+	struct dp_ipa_exc_zc_stats *stats = &soc->ipa_exc_zc;
+	uint32_t turnaround = qdf_nbuf_get_timedelta_us(nbuf);
+	uint8_t bin = 0;
+
+	while (bin < DP_IPA_EXC_ZC_TURNAROUND_BINS - 1 &&
+	       turnaround >= DP_IPA_EXC_ZC_TURNAROUND_BIN0_US << (bin * 3))
+		bin++;
+
+	qdf_atomic_inc(&stats->release);
+	qdf_atomic_inc(&stats->turnaround[bin]);
+}
+
+/**
+ * dp_ipa_exc_zc_print_stats() - print the IPA exception buffer stats
+ * @soc: soc
+ *
+ * Return: None
+ */
+static void dp_ipa_exc_zc_print_stats(struct dp_soc *soc)
+{
+	struct dp_ipa_exc_zc_stats *stats = &soc->ipa_exc_zc;
+
+	dp_info("IPA exception: copy avoided %d fallback %d",
+		qdf_atomic_read(&stats->copy_avoided),
+		qdf_atomic_read(&stats->copy_fallback));
+	dp_info("IPA exception: handoff %d release %d turnaround <125us %d <1ms %d <8ms %d >=8ms %d",
+		qdf_atomic_read(&stats->handoff),
+		qdf_atomic_read(&stats->release),
+		qdf_atomic_read(&stats->turnaround[0]),
+		qdf_atomic_read(&stats->turnaround[1]),
+		qdf_atomic_read(&stats->turnaround[2]),
+		qdf_atomic_read(&stats->turnaround[3]));
+}
+#else
+static inline qdf_nbuf_t dp_ipa_exc_zc_share(struct dp_soc *soc,
+					     struct dp_vdev *vdev,
+					     qdf_nbuf_t nbuf)
+{
+	return qdf_nbuf_copy(nbuf);
+}
+
+static inline void dp_ipa_exc_zc_handoff(qdf_nbuf_t nbuf)
+{
+}
+
+static inline void dp_ipa_exc_zc_handoff_done(struct dp_soc *soc)
+{
+}
+
+static inline void dp_ipa_exc_zc_print_stats(struct dp_soc *soc)
+{
+}
+#endif /* WLAN_IPA_EXC_ZERO_COPY */
+
 QDF_STATUS dp_ipa_get_stat(struct cdp_soc_t *soc_hdl, uint8_t pdev_id)
 {
-	/* TBD */
+	struct dp_soc *soc = cdp_soc_t_to_dp_soc(soc_hdl);
+
+	dp_ipa_exc_zc_print_stats(soc);
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -2698,6 +2806,7 @@ static qdf_nbuf_t dp_ipa_intrabss_send(struct dp_pdev *pdev,
 		return nbuf;
 
 	qdf_mem_zero(nbuf->cb, sizeof(nbuf->cb));
+	dp_ipa_exc_zc_handoff(nbuf);
 	len = qdf_nbuf_len(nbuf);
 
 	if (dp_tx_send((struct cdp_soc_t *)pdev->soc, vdev->vdev_id, nbuf)) {
@@ -2706,6 +2815,7 @@ static qdf_nbuf_t dp_ipa_intrabss_send(struct dp_pdev *pdev,
 		return nbuf;
 	}
 
+	dp_ipa_exc_zc_handoff_done(pdev->soc);
 	DP_STATS_INC_PKT(vdev_peer, rx.intra_bss.pkts, 1, len);
 	dp_peer_unref_delete(vdev_peer, DP_MOD_ID_IPA);
 	return NULL;
@@ -2746,7 +2856,7 @@ bool dp_ipa_rx_intrabss_fwd(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		goto out;
 
 	if (da_is_bcmc) {
-		nbuf_copy = qdf_nbuf_copy(nbuf);
+		nbuf_copy = dp_ipa_exc_zc_share(soc, vdev, nbuf);
 		if (!nbuf_copy)
 			goto out;
 
@@ -275,6 +275,36 @@ bool dp_ipa_is_mdm_platform(void);
 
 qdf_nbuf_t dp_ipa_handle_rx_reo_reinject(struct dp_soc *soc, qdf_nbuf_t nbuf);
 
+#ifdef WLAN_IPA_EXC_ZERO_COPY
+/**
+ * dp_ipa_exc_zc_release() - account the release of a forwarded IPA buffer
+ * @soc: soc
+ * @nbuf: nbuf handed to the tx path by intra-BSS forwarding
+ *
+ * Return: None
+ */
+void dp_ipa_exc_zc_release(struct dp_soc *soc, qdf_nbuf_t nbuf);
+
+/**
+ * dp_ipa_exc_zc_tx_comp() - check a completed tx nbuf for an IPA buffer
+ * @soc: soc
+ * @nbuf: nbuf about to be freed by the tx completion
+ *
+ * Return: None
+ */
+static inline void dp_ipa_exc_zc_tx_comp(struct dp_soc *soc, qdf_nbuf_t nbuf)
+{
+	if (qdf_likely(qdf_nbuf_get_tx_ftype(nbuf) != CB_FTYPE_INTRABSS_FWD))
+		return;
+
+	dp_ipa_exc_zc_release(soc, nbuf);
+}
+#else
+static inline void dp_ipa_exc_zc_tx_comp(struct dp_soc *soc, qdf_nbuf_t nbuf)
+{
+}
+#endif
+
 /**
  * dp_ipa_tx_buf_smmu_mapping() - Create SMMU mappings for IPA
  *				  allocated TX buffers
@@ -409,6 +439,10 @@ static inline qdf_nbuf_t dp_ipa_handle_rx_reo_reinject(struct dp_soc *soc,
 	return nbuf;
 }
 
+static inline void dp_ipa_exc_zc_tx_comp(struct dp_soc *soc, qdf_nbuf_t nbuf)
+{
+}
+
 static inline QDF_STATUS dp_ipa_tx_buf_smmu_mapping(struct cdp_soc_t *soc_hdl,
 						    uint8_t pdev_id)
 {
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <qdf_atomic.h>
+#include <qdf_mem.h>
+#include <qdf_time.h>
+#include <qdf_util.h>
+#include <cdp_txrx_hist_struct.h>
+#include "dp_types.h"
+#include "dp_internal.h"
+#include "dp_hist.h"
+#include "dp_lat_trace.h"
+
+/* Stamps kept per CPU, must be a power of 2 */
+#define DP_LAT_TRACE_RING_SIZE 256
+/* Packets traced at the same time, must be a power of 2 */
+#define DP_LAT_TRACE_MAX_INFLIGHT 64
+/* A trace not ended within this time is for a dropped packet */
+#define DP_LAT_TRACE_STALE_US 1000000
+/* Most recent stamps of each CPU printed in the stats */
+#define DP_LAT_TRACE_DUMP_RECS 16
+
+#define DP_LAT_STAGE_IS_RX(_stage) ((_stage) >= CDP_LAT_RX_REAP)
+
+/**
+ * struct dp_lat_trace_rec - one stamp in the per CPU ring
+ * @ts_us: time of the stamp
+ * @pkt: address of the packet, identifies it across CPUs
+ * @delta_us: time since the previous stage of the packet
+ * @stage: enum cdp_lat_trace_stage
+ */
+struct dp_lat_trace_rec {
+	uint64_t ts_us;
+	uintptr_t pkt;
+	uint32_t delta_us;
+	uint8_t stage;
+};
+
+/**
+ * struct dp_lat_trace_pkt - a packet being traced
+ * @nbuf: the packet, NULL while the slot is being set up or released
+ * @first_ts: time of the first stage
+ * @last_ts: time of the last stage stamped
+ * @last_stage: last stage stamped
+ */
+struct dp_lat_trace_pkt {
+	qdf_nbuf_t nbuf;
+	uint64_t first_ts;
+	uint64_t last_ts;
+	uint8_t last_stage;
+};
+
+/**
+ * struct dp_lat_trace_cpu - per CPU tracer state
+ * @sample_cnt: packets seen at a first stage since the last sample
+ * @ring_idx: next stamp ring index
+ * @ring: stamp ring
+ * @stage_hist: latency from the previous stage, per stage
+ * @e2e_hist: latency from the first to the last stage, tx and rx
+ * @slot_busy: samples and stamps skipped because the in flight slot was
+ *  taken or locked
+ *
+ * Only updated from the CPU it belongs to, with preemption disabled.
+ */
+struct dp_lat_trace_cpu {
+	uint32_t sample_cnt;
+	uint32_t ring_idx;
+	struct dp_lat_trace_rec ring[DP_LAT_TRACE_RING_SIZE];
+	struct cdp_hist_stats stage_hist[CDP_LAT_STAGE_MAX];
+	struct cdp_hist_stats e2e_hist[2];
+	uint32_t slot_busy;
+};
+
+/**
+ * struct dp_lat_trace - stage latency tracer
+ * @sample_rate: one out of every sample_rate packets is traced
+ * @in_flight: packets being traced
+ * @stale: traces of dropped packets reclaimed
+ * @slot_map: in flight slots in use
+ * @slot_lock: in flight slots being set up, stamped or released, a CPU
+ *  finding the bit set skips its update instead of spinning
+ * @pkts: in flight slots, indexed by a hash of the packet address
+ * @cpu: per CPU state
+ */
+struct dp_lat_trace {
+	uint32_t sample_rate;
+	qdf_atomic_t in_flight;
+	qdf_atomic_t stale;
+	qdf_bitmap(slot_map, DP_LAT_TRACE_MAX_INFLIGHT);
+	qdf_bitmap(slot_lock, DP_LAT_TRACE_MAX_INFLIGHT);
+	struct dp_lat_trace_pkt pkts[DP_LAT_TRACE_MAX_INFLIGHT];
+	struct dp_lat_trace_cpu cpu[QDF_MAX_AVAILABLE_CPU];
+};
+
+static const char * const dp_lat_trace_stage_str[CDP_LAT_STAGE_MAX] = {
+	[CDP_LAT_TX_HDD_XMIT] = "TX hdd xmit",
+	[CDP_LAT_TX_DP_SEND] = "TX dp send",
+	[CDP_LAT_TX_TCL_ENQ] = "TX tcl enqueue",
+	[CDP_LAT_TX_FW_COMP] = "TX fw completion",
+	[CDP_LAT_TX_COMP_PROC] = "TX comp handler",
+	[CDP_LAT_TX_FREE] = "TX stack free",
+	[CDP_LAT_RX_REAP] = "RX reo reap",
+	[CDP_LAT_RX_DELIVER] = "RX dp deliver",
+	[CDP_LAT_RX_HDD] = "RX hdd",
+	[CDP_LAT_RX_STACK] = "RX to stack",
+};
+
+/**
+ * dp_lat_trace_slot() - in flight slot index of a packet
+ * @nbuf: packet
+ *
+ * Return: slot index
+ */
+static inline uint32_t dp_lat_trace_slot(qdf_nbuf_t nbuf)
+{
+	uintptr_t addr = (uintptr_t)nbuf;
+
+	addr ^= addr >> 12;
+
+	return (addr >> 6) & (DP_LAT_TRACE_MAX_INFLIGHT - 1);
+}
+
+/**
+ * dp_lat_trace_slot_trylock() - take exclusive ownership of a slot
+ * @tr: tracer
+ * @idx: slot index
+ *
+ * Return: true if the slot was locked
+ */
+static inline bool dp_lat_trace_slot_trylock(struct dp_lat_trace *tr,
+					     uint32_t idx)
+{
+	return !qdf_atomic_test_and_set_bit(idx, tr->slot_lock);
+}
+
+/**
+ * dp_lat_trace_slot_unlock() - release a slot locked by
+ * dp_lat_trace_slot_trylock()
+ * @tr: tracer
+ * @idx: slot index
+ *
+ * Return: None
+ */
+static inline void dp_lat_trace_slot_unlock(struct dp_lat_trace *tr,
+					    uint32_t idx)
+{
+	/* fully ordered, publishes the slot updates before the unlock */
+	qdf_atomic_test_and_clear_bit(idx, tr->slot_lock);
+}
+
+/**
+ * dp_lat_trace_cpu_get() - pin the current CPU and get its tracer state
+ * @tr: tracer
+ *
+ * Only the first QDF_MAX_AVAILABLE_CPU CPUs have a state. A CPU past them
+ * would have to share one with another CPU, while the state is only
+ * protected by being per CPU, so it does not sample or record stamps.
+ *
+ * Return: per CPU state, NULL if the current CPU has none; the CPU stays
+ *	   pinned either way until qdf_put_cpu_pinned()
+ */
+static inline struct dp_lat_trace_cpu *
+dp_lat_trace_cpu_get(struct dp_lat_trace *tr)
+{
+	int cpu = qdf_get_cpu_pinned();
+
+	if (qdf_unlikely(cpu >= QDF_MAX_AVAILABLE_CPU))
+		return NULL;
+
+	return &tr->cpu[cpu];
+}
+
+/**
+ * dp_lat_trace_record() - log a stamp and update the stage histogram
+ * @cpu: per CPU state of the current CPU
+ * @nbuf: packet
+ * @stage: stage stamped
+ * @now: time of the stamp
+ * @delta: time since the previous stage, not used for a first stage
+ *
+ * Return: None
+ */
+static void dp_lat_trace_record(struct dp_lat_trace_cpu *cpu, qdf_nbuf_t nbuf,
+				enum cdp_lat_trace_stage stage, uint64_t now,
+				uint32_t delta)
+{
+	struct dp_lat_trace_rec *rec;
+
+	rec = &cpu->ring[cpu->ring_idx++ & (DP_LAT_TRACE_RING_SIZE - 1)];
+	rec->ts_us = now;
+	rec->pkt = (uintptr_t)nbuf;
+	rec->delta_us = delta;
+	rec->stage = stage;
+
+	if (stage != CDP_LAT_TX_HDD_XMIT && stage != CDP_LAT_RX_REAP)
+		dp_hist_update_stats(&cpu->stage_hist[stage], delta);
+}
+
+/**
+ * dp_lat_trace_start() - sample a packet at the first stage of a direction
+ * @tr: tracer
+ * @cpu: per CPU state of the current CPU
+ * @nbuf: packet
+ * @stage: CDP_LAT_TX_HDD_XMIT or CDP_LAT_RX_REAP
+ *
+ * Return: None
+ */
+static void dp_lat_trace_start(struct dp_lat_trace *tr,
+			       struct dp_lat_trace_cpu *cpu, qdf_nbuf_t nbuf,
+			       enum cdp_lat_trace_stage stage)
+{
+	uint32_t idx = dp_lat_trace_slot(nbuf);
+	struct dp_lat_trace_pkt *pkt = &tr->pkts[idx];
+	uint64_t now;
+
+	if (++cpu->sample_cnt < tr->sample_rate)
+		return;
+
+	/* Another CPU sets up, stamps or releases the slot, sample later */
+	if (!dp_lat_trace_slot_trylock(tr, idx)) {
+		cpu->slot_busy++;
+		return;
+	}
+
+	now = qdf_get_log_timestamp_usecs();
+	if (qdf_atomic_test_and_set_bit(idx, tr->slot_map)) {
+		/*
+		 * Slot taken. Reclaim it only if it traces the same buffer,
+		 * which was then dropped before its last stage and is now
+		 * reused, or if the trace is too old to still be alive.
+		 */
+		if (pkt->nbuf != nbuf &&
+		    now - pkt->last_ts < DP_LAT_TRACE_STALE_US) {
+			cpu->slot_busy++;
+			goto unlock;
+		}
+		qdf_atomic_inc(&tr->stale);
+	} else {
+		qdf_atomic_inc(&tr->in_flight);
+	}
+
+	cpu->sample_cnt = 0;
+	/* lockless readers only use nbuf to filter, hide the slot first */
+	pkt->nbuf = NULL;
+	qdf_wmb();
+	pkt->first_ts = now;
+	pkt->last_ts = now;
+	pkt->last_stage = stage;
+	qdf_wmb();
+	pkt->nbuf = nbuf;
+
+	dp_lat_trace_record(cpu, nbuf, stage, now, 0);
+
+unlock:
+	dp_lat_trace_slot_unlock(tr, idx);
+}
+
+/**
+ * dp_lat_trace_end() - end the trace of a packet at its last stage
+ * @tr: tracer, with the slot locked
+ * @cpu: per CPU state of the current CPU, NULL to only release the slot
+ * @pkt: in flight slot of the packet
+ * @idx: slot index
+ * @stage: CDP_LAT_TX_FREE or CDP_LAT_RX_STACK
+ * @now: time of the last stage
+ *
+ * Return: None
+ */
+static void dp_lat_trace_end(struct dp_lat_trace *tr,
+			     struct dp_lat_trace_cpu *cpu,
+			     struct dp_lat_trace_pkt *pkt, uint32_t idx,
+			     enum cdp_lat_trace_stage stage, uint64_t now)
+{
+	if (cpu)
+		dp_hist_update_stats(&cpu->e2e_hist[DP_LAT_STAGE_IS_RX(stage)],
+				     now - pkt->first_ts);
+
+	pkt->nbuf = NULL;
+	qdf_wmb();
+	if (qdf_atomic_test_and_clear_bit(idx, tr->slot_map))
+		qdf_atomic_dec(&tr->in_flight);
+}
+
+void __dp_lat_trace_stamp(struct dp_lat_trace *tr, qdf_nbuf_t nbuf,
+			  enum cdp_lat_trace_stage stage)
+{
+	struct dp_lat_trace_cpu *cpu;
+	struct dp_lat_trace_pkt *pkt;
+	uint32_t idx;
+	uint64_t now;
+
+	if (qdf_unlikely(!nbuf))
+		return;
+
+	if (stage == CDP_LAT_TX_HDD_XMIT || stage == CDP_LAT_RX_REAP) {
+		/* stay on this CPU while its state is updated */
+		cpu = dp_lat_trace_cpu_get(tr);
+		if (cpu)
+			dp_lat_trace_start(tr, cpu, nbuf, stage);
+		qdf_put_cpu_pinned();
+		return;
+	}
+
+	if (qdf_likely(!qdf_atomic_read(&tr->in_flight)))
+		return;
+
+	idx = dp_lat_trace_slot(nbuf);
+	pkt = &tr->pkts[idx];
+	if (qdf_likely(pkt->nbuf != nbuf))
+		return;
+
+	cpu = dp_lat_trace_cpu_get(tr);
+
+	if (!dp_lat_trace_slot_trylock(tr, idx)) {
+		if (cpu)
+			cpu->slot_busy++;
+		goto out;
+	}
+
+	/*
+	 * Recheck under the slot lock, the slot may have been reclaimed
+	 * since. Stages are stamped once and in order, per direction.
+	 */
+	if (pkt->nbuf != nbuf || stage <= pkt->last_stage ||
+	    DP_LAT_STAGE_IS_RX(stage) != DP_LAT_STAGE_IS_RX(pkt->last_stage))
+		goto unlock;
+
+	/* a CPU without a state still ends the trace, unrecorded */
+	now = qdf_get_log_timestamp_usecs();
+	if (cpu)
+		dp_lat_trace_record(cpu, nbuf, stage, now, now - pkt->last_ts);
+	pkt->last_ts = now;
+	pkt->last_stage = stage;
+
+	if (stage == CDP_LAT_TX_FREE || stage == CDP_LAT_RX_STACK)
+		dp_lat_trace_end(tr, cpu, pkt, idx, stage, now);
+
+unlock:
+	dp_lat_trace_slot_unlock(tr, idx);
+out:
+	qdf_put_cpu_pinned();
+}
+
+void dp_lat_trace_stamp_wifi3(struct cdp_soc_t *soc_hdl, qdf_nbuf_t nbuf,
+			      enum cdp_lat_trace_stage stage)
+{
+	dp_lat_trace_stamp(cdp_soc_t_to_dp_soc(soc_hdl), nbuf, stage);
+}
+
+/**
+ * dp_lat_trace_init_hist() - initialize the histograms of a CPU
+ * @cpu: per CPU state
+ *
+ * Return: None
+ */
+static void dp_lat_trace_init_hist(struct dp_lat_trace_cpu *cpu)
+{
+	uint8_t i;
+
+	for (i = 0; i < CDP_LAT_STAGE_MAX; i++) {
+		dp_hist_init(&cpu->stage_hist[i], CDP_HIST_TYPE_STAGE_LAT);
+		cpu->stage_hist[i].min = INT_MAX;
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(cpu->e2e_hist); i++) {
+		dp_hist_init(&cpu->e2e_hist[i], CDP_HIST_TYPE_STAGE_LAT);
+		cpu->e2e_hist[i].min = INT_MAX;
+	}
+}
+
+void dp_lat_trace_attach(struct dp_soc *soc, uint32_t sample_rate)
+{
+	struct dp_lat_trace *tr;
+	uint8_t cpu;
+
+	if (!sample_rate || soc->lat_trace)
+		return;
+
+	tr = qdf_mem_malloc(sizeof(*tr));
+	if (!tr)
+		return;
+
+	tr->sample_rate = sample_rate;
+	qdf_atomic_init(&tr->in_flight);
+	qdf_atomic_init(&tr->stale);
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		dp_lat_trace_init_hist(&tr->cpu[cpu]);
+
+	qdf_wmb();
+	soc->lat_trace = tr;
+	dp_info("%pK: Stage latency tracing enabled, sample rate 1/%u",
+		soc, sample_rate);
+}
+
+void dp_lat_trace_detach(struct dp_soc *soc)
+{
+	struct dp_lat_trace *tr = soc->lat_trace;
+
+	if (!tr)
+		return;
+
+	/* Called once the data path is stopped, no stamp is in progress */
+	soc->lat_trace = NULL;
+	qdf_mem_free(tr);
+}
+
+/**
+ * dp_lat_trace_print_hist() - print one latency histogram
+ * @name: histogram name
+ * @hist: histogram
+ *
+ * Return: None
+ */
+static void dp_lat_trace_print_hist(const char *name,
+				    struct cdp_hist_stats *hist)
+{
+	uint64_t *freq = hist->hist.freq;
+	uint64_t count = 0;
+	uint8_t i;
+
+	for (i = 0; i < CDP_HIST_BUCKET_MAX; i++)
+		count += freq[i];
+
+	if (!count)
+		return;
+
+	DP_PRINT_STATS("%-16s cnt %llu min %d max %d avg %d us", name, count,
+		       hist->min, hist->max, hist->avg);
+	DP_PRINT_STATS("  <10:%llu <25:%llu <50:%llu <100:%llu <250:%llu",
+		       freq[0], freq[1], freq[2], freq[3], freq[4]);
+	DP_PRINT_STATS("  <500:%llu <1000:%llu <2500:%llu <10000:%llu >=10000:%llu",
+		       freq[5], freq[6], freq[7], freq[8], freq[9]);
+}
+
+void dp_lat_trace_print_stats(struct dp_soc *soc)
+{
+	struct dp_lat_trace *tr = soc->lat_trace;
+	struct cdp_hist_stats *hist;
+	struct dp_lat_trace_cpu *cpu;
+	struct dp_lat_trace_rec *rec;
+	uint32_t slot_busy = 0;
+	uint32_t idx, n;
+	uint8_t i, c;
+
+	if (!tr) {
+		DP_PRINT_STATS("Stage latency tracing disabled");
+		return;
+	}
+
+	hist = qdf_mem_malloc(sizeof(*hist) * (CDP_LAT_STAGE_MAX + 2));
+	if (!hist)
+		return;
+
+	for (i = 0; i < CDP_LAT_STAGE_MAX + 2; i++) {
+		dp_hist_init(&hist[i], CDP_HIST_TYPE_STAGE_LAT);
+		hist[i].min = INT_MAX;
+	}
+
+	for (c = 0; c < QDF_MAX_AVAILABLE_CPU; c++) {
+		cpu = &tr->cpu[c];
+		for (i = 0; i < CDP_LAT_STAGE_MAX; i++)
+			dp_accumulate_hist_stats(&cpu->stage_hist[i],
+						 &hist[i]);
+		dp_accumulate_hist_stats(&cpu->e2e_hist[0],
+					 &hist[CDP_LAT_STAGE_MAX]);
+		dp_accumulate_hist_stats(&cpu->e2e_hist[1],
+					 &hist[CDP_LAT_STAGE_MAX + 1]);
+		slot_busy += cpu->slot_busy;
+	}
+
+	DP_PRINT_STATS("Stage latency: sample 1/%u in_flight %d stale %d busy %u",
+		       tr->sample_rate, qdf_atomic_read(&tr->in_flight),
+		       qdf_atomic_read(&tr->stale), slot_busy);
+	DP_PRINT_STATS("Latency since the previous stage:");
+	for (i = 0; i < CDP_LAT_STAGE_MAX; i++)
+		dp_lat_trace_print_hist(dp_lat_trace_stage_str[i], &hist[i]);
+	dp_lat_trace_print_hist("TX end to end", &hist[CDP_LAT_STAGE_MAX]);
+	dp_lat_trace_print_hist("RX end to end", &hist[CDP_LAT_STAGE_MAX + 1]);
+	qdf_mem_free(hist);
+
+	for (c = 0; c < QDF_MAX_AVAILABLE_CPU; c++) {
+		cpu = &tr->cpu[c];
+		n = QDF_MIN(cpu->ring_idx, DP_LAT_TRACE_DUMP_RECS);
+		if (!n)
+			continue;
+
+		DP_PRINT_STATS("CPU %u last %u stamps:", c, n);
+		for (idx = cpu->ring_idx - n; idx != cpu->ring_idx; idx++) {
+			rec = &cpu->ring[idx & (DP_LAT_TRACE_RING_SIZE - 1)];
+			DP_PRINT_STATS("  %llu pkt %pK %-16s +%u us",
+				       rec->ts_us, (void *)rec->pkt,
+				       dp_lat_trace_stage_str[rec->stage],
+				       rec->delta_us);
+		}
+	}
+}
+
+void dp_lat_trace_clear_stats(struct dp_soc *soc)
+{
+	struct dp_lat_trace *tr = soc->lat_trace;
+	struct dp_lat_trace_cpu *cpu;
+	uint8_t c;
+
+	if (!tr)
+		return;
+
+	for (c = 0; c < QDF_MAX_AVAILABLE_CPU; c++) {
+		cpu = &tr->cpu[c];
+		dp_lat_trace_init_hist(cpu);
+		cpu->ring_idx = 0;
+		cpu->slot_busy = 0;
+	}
+	qdf_atomic_init(&tr->stale);
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: dp_lat_trace.h
+ * Sampled per packet stage latency tracing.
+ *
+ * One out of every sample_rate packets entering the driver is traced. The
+ * traced packet is time stamped at each stage it passes, and the time
+ * spent since the previous stage is added to a per stage histogram. Each
+ * stamp is also logged in a per CPU ring for post mortem analysis. Every
+ * soc has its own tracer, stages outside DP stamp through the
+ * lat_trace_stamp CDP misc op.
+ */
+
+#ifndef _DP_LAT_TRACE_H_
+#define _DP_LAT_TRACE_H_
+
+#include <qdf_types.h>
+#include <qdf_nbuf.h>
+#include <cdp_txrx_cmn_struct.h>
+#include "dp_types.h"
+
+#ifdef WLAN_DP_LAT_TRACE
+/**
+ * __dp_lat_trace_stamp() - time stamp a packet at a stage
+ * @tr: tracer of the soc
+ * @nbuf: packet
+ * @stage: stage the packet is at
+ *
+ * Return: None
+ */
+void __dp_lat_trace_stamp(struct dp_lat_trace *tr, qdf_nbuf_t nbuf,
+			  enum cdp_lat_trace_stage stage);
+
+/**
+ * dp_lat_trace_stamp() - time stamp a packet at a stage if tracing is on
+ * @soc: DP soc handle
+ * @nbuf: packet
+ * @stage: stage the packet is at
+ *
+ * The first stage of a direction decides if the packet is sampled, later
+ * stages only stamp packets already being traced.
+ *
+ * Return: None
+ */
+static inline void dp_lat_trace_stamp(struct dp_soc *soc, qdf_nbuf_t nbuf,
+				      enum cdp_lat_trace_stage stage)
+{
+	struct dp_lat_trace *tr = soc->lat_trace;
+
+	if (qdf_likely(!tr))
+		return;
+
+	__dp_lat_trace_stamp(tr, nbuf, stage);
+}
+
+/**
+ * dp_lat_trace_stamp_list() - time stamp a list of packets at a stage
+ * @soc: DP soc handle
+ * @nbuf_list: packets linked through qdf_nbuf_next()
+ * @stage: stage the packets are at
+ *
+ * Return: None
+ */
+static inline void dp_lat_trace_stamp_list(struct dp_soc *soc,
+					   qdf_nbuf_t nbuf_list,
+					   enum cdp_lat_trace_stage stage)
+{
+	struct dp_lat_trace *tr = soc->lat_trace;
+
+	if (qdf_likely(!tr))
+		return;
+
+	for (; nbuf_list; nbuf_list = qdf_nbuf_next(nbuf_list))
+		__dp_lat_trace_stamp(tr, nbuf_list, stage);
+}
+
+/**
+ * dp_lat_trace_stamp_wifi3() - time stamp a packet for the CDP misc op
+ * @soc_hdl: CDP soc handle
+ * @nbuf: packet
+ * @stage: stage the packet is at
+ *
+ * Return: None
+ */
+void dp_lat_trace_stamp_wifi3(struct cdp_soc_t *soc_hdl, qdf_nbuf_t nbuf,
+			      enum cdp_lat_trace_stage stage);
+
+/**
+ * dp_lat_trace_attach() - allocate the soc tracer and start sampling
+ * @soc: DP soc handle
+ * @sample_rate: trace one of every sample_rate packets, 0 to disable
+ *
+ * Return: None
+ */
+void dp_lat_trace_attach(struct dp_soc *soc, uint32_t sample_rate);
+
+/**
+ * dp_lat_trace_detach() - stop sampling and free the soc tracer
+ * @soc: DP soc handle
+ *
+ * Return: None
+ */
+void dp_lat_trace_detach(struct dp_soc *soc);
+
+/**
+ * dp_lat_trace_print_stats() - print the stage latency histograms and the
+ * most recent stamps of each CPU
+ * @soc: DP soc handle
+ *
+ * Return: None
+ */
+void dp_lat_trace_print_stats(struct dp_soc *soc);
+
+/**
+ * dp_lat_trace_clear_stats() - clear the histograms and stamp rings
+ * @soc: DP soc handle
+ *
+ * Return: None
+ */
+void dp_lat_trace_clear_stats(struct dp_soc *soc);
+#else
+static inline void dp_lat_trace_stamp(struct dp_soc *soc, qdf_nbuf_t nbuf,
+				      enum cdp_lat_trace_stage stage)
+{
+}
+
+static inline void dp_lat_trace_stamp_list(struct dp_soc *soc,
+					   qdf_nbuf_t nbuf_list,
+					   enum cdp_lat_trace_stage stage)
+{
+}
+
+static inline void dp_lat_trace_attach(struct dp_soc *soc,
+				       uint32_t sample_rate)
+{
+}
+
+static inline void dp_lat_trace_detach(struct dp_soc *soc)
+{
+}
+
+static inline void dp_lat_trace_print_stats(struct dp_soc *soc)
+{
+}
+
+static inline void dp_lat_trace_clear_stats(struct dp_soc *soc)
+{
+}
+#endif /* WLAN_DP_LAT_TRACE */
+#endif /* _DP_LAT_TRACE_H_ */
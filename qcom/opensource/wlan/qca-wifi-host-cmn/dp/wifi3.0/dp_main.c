@@ -89,6 +89,7 @@ cdp_dump_flow_pool_info(struct cdp_soc_t *soc)
 #ifdef WLAN_DP_FEATURE_SW_LATENCY_MGR
 #include <dp_swlm.h>
 #endif
+#include "dp_lat_trace.h"
 
 #ifdef WLAN_FEATURE_STATS_EXT
 #define INIT_RX_HW_STATS_LOCK(_soc) \
@@ -2483,6 +2484,91 @@ static uint32_t dp_service_near_full_srngs(void *dp_ctx, uint32_t dp_budget)
 
 #ifndef QCA_HOST_MODE_WIFI_DISABLED
 
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+/* Minimum spacing between two demand indications from a NAPI context */
+#define DP_BUS_BW_IND_WINDOW_US 10000
+/* Residual rx ring occupancy (percent) indicated without rate limiting */
+#define DP_BUS_BW_IND_BACKLOG_PCT 50
+
+/**
+ * dp_bus_bw_ring_backlog() - Residual occupancy of a serviced rx ring
+ * @soc: DP soc handle
+ * @hal_ring_hdl: rx destination ring
+ *
+ * Return: occupancy of the ring in percent
+ */
+static inline uint8_t dp_bus_bw_ring_backlog(struct dp_soc *soc,
+					     hal_ring_handle_t hal_ring_hdl)
+{
+	uint32_t num_entries = hal_srng_get_num_entries(soc->hal_soc,
+							hal_ring_hdl);
+
+	if (!num_entries)
+		return 0;
+
+	return (hal_srng_dst_num_valid(soc->hal_soc, hal_ring_hdl, 1) * 100) /
+		num_entries;
+}
+
+/**
+ * dp_bus_bw_demand_update() - Accumulate NAPI demand and indicate it to the
+ *			       bus bandwidth manager
+ * @soc: DP soc handle
+ * @int_ctx: interrupt context which was serviced
+ * @pkts: rx frames and tx completions reaped in this poll
+ * @backlog: highest residual rx ring occupancy in this poll, in percent
+ *
+ * Indications are rate limited to one per DP_BUS_BW_IND_WINDOW_US for each
+ * interrupt context. A ring which is not being drained fast enough is
+ * indicated right away, so that the vote can be raised before the periodic
+ * bus bandwidth work notices the load.
+ *
+ * Return: None
+ */
+static inline void dp_bus_bw_demand_update(struct dp_soc *soc,
+					   struct dp_intr *int_ctx,
+					   uint32_t pkts, uint8_t backlog)
+{
+	uint64_t now;
+
+	if (!soc->cdp_soc.ol_ops->dp_bus_bw_demand_ind)
+		return;
+
+	int_ctx->bw_ind_pkts += pkts;
+	if (backlog > int_ctx->bw_ind_backlog)
+		int_ctx->bw_ind_backlog = backlog;
+
+	if (!int_ctx->bw_ind_pkts)
+		return;
+
+	now = qdf_get_log_timestamp();
+	if (int_ctx->bw_ind_backlog < DP_BUS_BW_IND_BACKLOG_PCT &&
+	    qdf_log_timestamp_to_usecs(now - int_ctx->bw_ind_ts) <
+	    DP_BUS_BW_IND_WINDOW_US)
+		return;
+
+	soc->cdp_soc.ol_ops->dp_bus_bw_demand_ind(soc->ctrl_psoc,
+						  int_ctx->dp_intr_id,
+						  int_ctx->bw_ind_pkts,
+						  int_ctx->bw_ind_backlog);
+	int_ctx->bw_ind_ts = now;
+	int_ctx->bw_ind_pkts = 0;
+	int_ctx->bw_ind_backlog = 0;
+}
+#else
+static inline uint8_t dp_bus_bw_ring_backlog(struct dp_soc *soc,
+					     hal_ring_handle_t hal_ring_hdl)
+{
+	return 0;
+}
+
+static inline void dp_bus_bw_demand_update(struct dp_soc *soc,
+					   struct dp_intr *int_ctx,
+					   uint32_t pkts, uint8_t backlog)
+{
+}
+#endif
+
 /*
  * dp_service_srngs() - Top level interrupt handler for DP Ring interrupts
  * @dp_ctx: DP SOC handle
@@ -2505,6 +2591,9 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 	uint8_t rx_wbm_rel_mask = int_ctx->rx_wbm_rel_ring_mask;
 	uint8_t reo_status_mask = int_ctx->reo_status_ring_mask;
 	uint32_t remaining_quota = dp_budget;
+	uint32_t data_work_done = 0;
+	uint8_t backlog = 0;
+	uint8_t ring_backlog;
 
 	dp_verbose_debug("tx %x rx %x rx_err %x rx_wbm_rel %x reo_status %x rx_mon_ring %x host2rxdma %x rxdma2host %x\n",
 			 tx_mask, rx_mask, rx_err_mask, rx_wbm_rel_mask,
@@ -2527,6 +2616,7 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 					 tx_mask, index, budget,
 					 work_done);
 		}
+		data_work_done += work_done;
 		budget -= work_done;
 		if (budget <= 0)
 			goto budget_done;
@@ -2586,6 +2676,11 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 				dp_verbose_debug("rx mask 0x%x ring %d, work_done %d budget %d",
 						 rx_mask, ring,
 						 work_done, budget);
+				data_work_done += work_done;
+				ring_backlog = dp_bus_bw_ring_backlog(soc,
+					soc->reo_dest_ring[ring].hal_srng);
+				if (ring_backlog > backlog)
+					backlog = ring_backlog;
 				budget -=  work_done;
 				if (budget <= 0)
 					goto budget_done;
@@ -2613,6 +2708,7 @@ static uint32_t dp_service_srngs(void *dp_ctx, uint32_t dp_budget)
 	intr_stats->num_masks++;
 
 budget_done:
+	dp_bus_bw_demand_update(soc, int_ctx, data_work_done, backlog);
 	return dp_budget - budget;
 }
 
@@ -5744,6 +5840,7 @@ static void dp_soc_detach(struct cdp_soc_t *txrx_soc)
 	soc->arch_ops.txrx_soc_detach(soc);
 
 	dp_sysfs_deinitialize_stats(soc);
+	dp_lat_trace_detach(soc);
 	dp_soc_swlm_detach(soc);
 	dp_soc_tx_desc_sw_pools_free(soc);
 	dp_soc_srng_free(soc);
@@ -10578,6 +10675,10 @@ static QDF_STATUS dp_txrx_dump_stats(struct cdp_soc_t *psoc, uint16_t value,
 		dp_pdev_print_tx_delay_stats(soc);
 		break;
 
+	case CDP_DP_LAT_TRACE_STATS:
+		dp_lat_trace_print_stats(soc);
+		break;
+
 	default:
 		status = QDF_STATUS_E_INVAL;
 		break;
@@ -10820,6 +10921,10 @@ QDF_STATUS dp_txrx_clear_dump_stats(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 		dp_pdev_clear_tx_delay_stats(soc);
 		break;
 
+	case CDP_DP_LAT_TRACE_STATS:
+		dp_lat_trace_clear_stats(soc);
+		break;
+
 	default:
 		status = QDF_STATUS_E_INVAL;
 		break;
@@ -12900,6 +13005,9 @@ static struct cdp_misc_ops dp_ops_misc = {
 	.register_pktdump_cb = dp_register_packetdump_callback,
 	.unregister_pktdump_cb = dp_deregister_packetdump_callback,
 #endif
+#ifdef WLAN_DP_LAT_TRACE
+	.lat_trace_stamp = dp_lat_trace_stamp_wifi3,
+#endif
 };
 #endif
 
@@ -13313,6 +13421,8 @@ dp_soc_attach(struct cdp_ctrl_objmgr_psoc *ctrl_psoc,
 	}
 
 	dp_soc_swlm_attach(soc);
+	dp_lat_trace_attach(soc, wlan_cfg_get_lat_trace_sample_rate(
+					soc->wlan_cfg_ctx));
 	dp_soc_set_interrupt_mode(soc);
 	dp_soc_set_def_pdev(soc);
 
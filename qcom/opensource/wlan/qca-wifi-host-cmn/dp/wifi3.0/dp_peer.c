@@ -3156,6 +3156,77 @@ static void dp_reo_desc_defer_free(struct dp_soc *soc)
 }
 #endif /* !WLAN_DP_FEATURE_DEFERRED_REO_QDESC_DESTROY */
 
+#ifdef WLAN_DP_REO_DESC_BATCH_FLUSH
+/*
+ * dp_reo_desc_mark_delete() - note when the rx tid delete was issued
+ * @desc: descriptor of the REO queue being deleted
+ *
+ * Return: None
+ */
+static inline void dp_reo_desc_mark_delete(struct reo_desc_list_node *desc)
+{
+	desc->del_ts = qdf_get_system_timestamp();
+}
+
+/*
+ * dp_reo_desc_free_lat_stats() - account the teardown latency of a REO
+ * queue, from the rx tid delete to the queue memory being released
+ * @soc: DP SOC handle
+ * @desc: descriptor of the REO queue being freed
+ * @curr_ts: current system timestamp
+ *
+ * Return: None
+ */
+static void dp_reo_desc_free_lat_stats(struct dp_soc *soc,
+				       struct reo_desc_list_node *desc,
+				       unsigned long curr_ts)
+{
+	uint32_t lat_ms = curr_ts - desc->del_ts;
+	uint32_t bucket;
+
+	if (lat_ms < 10)
+		bucket = 0;
+	else if (lat_ms < 100)
+		bucket = 1;
+	else if (lat_ms < 1000)
+		bucket = 2;
+	else
+		bucket = 3;
+
+	DP_STATS_INC(soc, rx.reo_qdesc_free.freed, 1);
+	DP_STATS_INC(soc, rx.reo_qdesc_free.lat_sum_ms, lat_ms);
+	DP_STATS_INC(soc, rx.reo_qdesc_free.lat_hist[bucket], 1);
+	if (lat_ms > soc->stats.rx.reo_qdesc_free.lat_max_ms)
+		soc->stats.rx.reo_qdesc_free.lat_max_ms = lat_ms;
+}
+
+/*
+ * dp_reo_desc_flush_stats() - account a flush cache command sent for a
+ * single REO descriptor
+ * @soc: DP SOC handle
+ *
+ * Return: None
+ */
+static inline void dp_reo_desc_flush_stats(struct dp_soc *soc)
+{
+	DP_STATS_INC(soc, rx.reo_qdesc_free.desc_flush, 1);
+}
+#else
+static inline void dp_reo_desc_mark_delete(struct reo_desc_list_node *desc)
+{
+}
+
+static inline void
+dp_reo_desc_free_lat_stats(struct dp_soc *soc, struct reo_desc_list_node *desc,
+			   unsigned long curr_ts)
+{
+}
+
+static inline void dp_reo_desc_flush_stats(struct dp_soc *soc)
+{
+}
+#endif /* WLAN_DP_REO_DESC_BATCH_FLUSH */
+
 /*
  * dp_reo_desc_free() - Callback free reo descriptor memory after
  * HW cache flush
@@ -3172,6 +3243,8 @@ static void dp_reo_desc_free(struct dp_soc *soc, void *cb_ctxt,
 	struct dp_rx_tid *rx_tid = &freedesc->rx_tid;
 	unsigned long curr_ts = qdf_get_system_timestamp();
 
+	dp_reo_desc_free_lat_stats(soc, freedesc, curr_ts);
+
 	if ((reo_status->fl_cache_status.header.status !=
 		HAL_REO_CMD_SUCCESS) &&
 		(reo_status->fl_cache_status.header.status !=
@@ -3511,6 +3584,366 @@ dp_resend_update_reo_cmd(struct dp_soc *soc,
 	return QDF_STATUS_SUCCESS;
 }
 
+/*
+ * dp_reo_desc_flush_ext() - Flush the extension descriptors of a REO
+ * queue from HW cache
+ *
+ * @soc: DP SOC handle
+ * @desc: descriptor of the REO queue
+ *
+ * Return: QDF_STATUS_SUCCESS if all the flush commands were queued
+ */
+static QDF_STATUS dp_reo_desc_flush_ext(struct dp_soc *soc,
+					struct reo_desc_list_node *desc)
+{
+	struct dp_rx_tid *rx_tid = &desc->rx_tid;
+	struct hal_reo_cmd_params params;
+	uint32_t desc_size, tot_desc_size;
+
+	/* Flush and invalidate REO descriptor from HW cache: Base and
+	 * extension descriptors should be flushed separately */
+	if (desc->pending_ext_desc_size)
+		tot_desc_size = desc->pending_ext_desc_size;
+	else
+		tot_desc_size = rx_tid->hw_qdesc_alloc_size;
+	/* Get base descriptor size by passing non-qos TID */
+	desc_size = hal_get_reo_qdesc_size(soc->hal_soc, 0,
+					   DP_NON_QOS_TID);
+
+	/* Flush reo extension descriptors */
+	while ((tot_desc_size -= desc_size) > 0) {
+		qdf_mem_zero(&params, sizeof(params));
+		params.std.addr_lo =
+			((uint64_t)(rx_tid->hw_qdesc_paddr) +
+			tot_desc_size) & 0xffffffff;
+		params.std.addr_hi =
+			(uint64_t)(rx_tid->hw_qdesc_paddr) >> 32;
+
+		if (QDF_STATUS_SUCCESS != dp_reo_send_cmd(soc,
+						CMD_FLUSH_CACHE,
+						&params,
+						NULL,
+						NULL)) {
+			dp_info_rl("fail to send CMD_CACHE_FLUSH:"
+				   "tid %d desc %pK", rx_tid->tid,
+				   (void *)(rx_tid->hw_qdesc_paddr));
+			desc->pending_ext_desc_size = tot_desc_size +
+							      desc_size;
+			return QDF_STATUS_E_FAILURE;
+		}
+		dp_reo_desc_flush_stats(soc);
+	}
+
+	desc->pending_ext_desc_size = desc_size;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/*
+ * dp_reo_desc_flush() - Flush the base and extension descriptors of a REO
+ * queue from HW cache, the queue memory is freed from the flush callback
+ *
+ * @soc: DP SOC handle
+ * @desc: descriptor of the REO queue to be freed
+ * @reo_status: REO command status
+ *
+ * Return: QDF_STATUS_SUCCESS if all the flush commands were queued
+ */
+static QDF_STATUS dp_reo_desc_flush(struct dp_soc *soc,
+				    struct reo_desc_list_node *desc,
+				    union hal_reo_status *reo_status)
+{
+	struct dp_rx_tid *rx_tid = &desc->rx_tid;
+	struct hal_reo_cmd_params params;
+
+	if (dp_reo_desc_flush_ext(soc, desc) != QDF_STATUS_SUCCESS) {
+		dp_reo_desc_clean_up(soc, desc, reo_status);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	/* Flush base descriptor */
+	qdf_mem_zero(&params, sizeof(params));
+	params.std.need_status = 1;
+	params.std.addr_lo =
+		(uint64_t)(rx_tid->hw_qdesc_paddr) & 0xffffffff;
+	params.std.addr_hi = (uint64_t)(rx_tid->hw_qdesc_paddr) >> 32;
+
+	if (QDF_STATUS_SUCCESS != dp_reo_send_cmd(soc,
+						  CMD_FLUSH_CACHE,
+						  &params,
+						  dp_reo_desc_free,
+						  (void *)desc)) {
+		union hal_reo_status reo_status;
+		/*
+		 * If dp_reo_send_cmd return failure, related TID queue desc
+		 * should be unmapped. Also locally reo_desc, together with
+		 * TID queue desc also need to be freed accordingly.
+		 *
+		 * Here invoke desc_free function directly to do clean up.
+		 *
+		 * In case of MCL path add the desc back to the free
+		 * desc list and defer deletion.
+		 */
+		dp_info_rl("fail to send REO cmd to flush cache: tid %d",
+			   rx_tid->tid);
+		dp_reo_desc_clean_up(soc, desc, &reo_status);
+		DP_STATS_INC(soc, rx.err.reo_cmd_send_fail, 1);
+		return QDF_STATUS_E_FAILURE;
+	}
+	dp_reo_desc_flush_stats(soc);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+#ifdef WLAN_DP_REO_DESC_BATCH_FLUSH
+/*
+ * struct dp_reo_desc_batch - REO queues released by the status of their
+ * last flush command
+ * @descs: descriptors of the REO queues
+ */
+struct dp_reo_desc_batch {
+	qdf_list_t descs;
+};
+
+uint32_t dp_reo_desc_freelist_limit_scale(uint64_t total_kb,
+					  uint64_t avail_kb)
+{
+	uint32_t limit;
+
+	if (!total_kb || avail_kb * 16 >= total_kb)
+		return REO_DESC_FREELIST_SIZE;
+
+	limit = qdf_do_div(avail_kb * 16 * REO_DESC_FREELIST_SIZE, total_kb);
+
+	return QDF_MAX(limit, REO_DESC_FREELIST_MIN_SIZE);
+}
+
+/*
+ * dp_reo_desc_freelist_limit() - Number of REO queues to hold in the
+ * freelist before flushing them
+ *
+ * Queues are coalesced so that one command status covers many of them,
+ * but every queue held pins its descriptor memory, so the limit follows
+ * the available memory.
+ *
+ * @soc: DP SOC handle
+ * @list_size: REO queues in the freelist
+ *
+ * Return: freelist limit
+ */
+static uint32_t dp_reo_desc_freelist_limit(struct dp_soc *soc,
+					   uint32_t list_size)
+{
+	uint32_t limit;
+
+	if (list_size > soc->stats.rx.reo_qdesc_free.freelist_max)
+		soc->stats.rx.reo_qdesc_free.freelist_max = list_size;
+
+	limit = dp_reo_desc_freelist_limit_scale(qdf_get_totalramsize(),
+						 qdf_get_availramsize());
+	if (limit < REO_DESC_FREELIST_SIZE)
+		DP_STATS_INC(soc, rx.reo_qdesc_free.low_mem, 1);
+
+	return limit;
+}
+
+/*
+ * dp_reo_cmd_ring_stats() - Record the REO command ring occupancy
+ * @soc: DP SOC handle
+ *
+ * Return: None
+ */
+static void dp_reo_cmd_ring_stats(struct dp_soc *soc)
+{
+	hal_ring_handle_t hal_ring_hdl = soc->reo_cmd_ring.hal_srng;
+	uint32_t used;
+
+	used = hal_srng_get_num_entries(soc->hal_soc, hal_ring_hdl) - 1 -
+		hal_srng_src_num_avail(soc->hal_soc, hal_ring_hdl, 0);
+	if (used > soc->stats.rx.reo_qdesc_free.cmd_ring_max_used)
+		soc->stats.rx.reo_qdesc_free.cmd_ring_max_used = used;
+}
+
+/*
+ * dp_reo_desc_batch_add() - Add a REO queue to the batch to be released
+ * by one flush command status
+ * @batch: batch, allocated on the first add
+ * @desc: descriptor of the REO queue
+ *
+ * Return: false if the queue is to be flushed on its own
+ */
+static bool dp_reo_desc_batch_add(struct dp_reo_desc_batch **batch,
+				  struct reo_desc_list_node *desc)
+{
+	if (!*batch) {
+		*batch = qdf_mem_malloc(sizeof(**batch));
+		if (!*batch)
+			return false;
+
+		qdf_list_create(&(*batch)->descs, 0);
+	}
+
+	qdf_list_insert_back(&(*batch)->descs, (qdf_list_node_t *)desc);
+
+	return true;
+}
+
+/*
+ * dp_reo_desc_batch_free() - Callback to free the REO queues of a batch
+ * after the last of their flush commands
+ * @soc: DP SOC handle
+ * @cb_ctxt: batch
+ * @reo_status: REO command status
+ *
+ * Return: None
+ */
+static void dp_reo_desc_batch_free(struct dp_soc *soc, void *cb_ctxt,
+				   union hal_reo_status *reo_status)
+{
+	struct dp_reo_desc_batch *batch = cb_ctxt;
+	struct reo_desc_list_node *desc;
+
+	while (qdf_list_remove_front(&batch->descs,
+				     (qdf_list_node_t **)&desc) ==
+	       QDF_STATUS_SUCCESS)
+		dp_reo_desc_free(soc, desc, reo_status);
+
+	qdf_list_destroy(&batch->descs);
+	qdf_mem_free(batch);
+}
+
+/*
+ * dp_reo_desc_batch_flush() - Release the REO queues of a batch
+ * @soc: DP SOC handle
+ * @batch: batch of REO queues
+ * @reo_status: REO command status
+ *
+ * The base and extension descriptors of every queue are flushed by
+ * address, so the cached descriptors of other peers are left alone. Only
+ * the last command asks for a status: REO runs its commands in order, so
+ * that status frees every queue of the batch with one callback.
+ *
+ * Return: None
+ */
+static void dp_reo_desc_batch_flush(struct dp_soc *soc,
+				    struct dp_reo_desc_batch *batch,
+				    union hal_reo_status *reo_status)
+{
+	struct hal_reo_cmd_params params;
+	struct reo_desc_list_node *desc;
+	union hal_reo_status status;
+	qdf_list_node_t *node;
+	uint32_t num, i;
+	bool last;
+
+	if (!batch)
+		return;
+
+	dp_reo_cmd_ring_stats(soc);
+
+	num = qdf_list_size(&batch->descs);
+	if (num == 1) {
+		qdf_list_remove_front(&batch->descs, (qdf_list_node_t **)&desc);
+		qdf_list_destroy(&batch->descs);
+		qdf_mem_free(batch);
+		dp_reo_desc_flush(soc, desc, reo_status);
+		return;
+	}
+
+	qdf_list_peek_front(&batch->descs, &node);
+	for (i = 1; i <= num; i++) {
+		desc = (struct reo_desc_list_node *)node;
+		last = i == num;
+		if (!last)
+			qdf_list_peek_next(&batch->descs, node, &node);
+
+		if (dp_reo_desc_flush_ext(soc, desc) != QDF_STATUS_SUCCESS)
+			goto fail;
+
+		qdf_mem_zero(&params, sizeof(params));
+		params.std.need_status = last;
+		params.std.addr_lo =
+			(uint64_t)(desc->rx_tid.hw_qdesc_paddr) & 0xffffffff;
+		params.std.addr_hi =
+			(uint64_t)(desc->rx_tid.hw_qdesc_paddr) >> 32;
+
+		/* the batch belongs to the callback once the last is queued */
+		if (dp_reo_send_cmd(soc, CMD_FLUSH_CACHE, &params,
+				    last ? dp_reo_desc_batch_free : NULL,
+				    last ? batch : NULL) !=
+		    QDF_STATUS_SUCCESS)
+			goto fail;
+		dp_reo_desc_flush_stats(soc);
+	}
+
+	DP_STATS_INC(soc, rx.reo_qdesc_free.batch_flush, 1);
+	DP_STATS_INC(soc, rx.reo_qdesc_free.batch_desc, num);
+	if (num > soc->stats.rx.reo_qdesc_free.batch_max)
+		soc->stats.rx.reo_qdesc_free.batch_max = num;
+
+	return;
+
+fail:
+	/*
+	 * No status will come back for the commands already queued, so
+	 * every queue of the batch goes through the usual send failure
+	 * clean up.
+	 */
+	dp_info_rl("fail to send REO cmd to flush cache for %u descs", num);
+	DP_STATS_INC(soc, rx.err.reo_cmd_send_fail, 1);
+	while (qdf_list_remove_front(&batch->descs,
+				     (qdf_list_node_t **)&desc) ==
+	       QDF_STATUS_SUCCESS)
+		dp_reo_desc_clean_up(soc, desc, &status);
+
+	qdf_list_destroy(&batch->descs);
+	qdf_mem_free(batch);
+}
+#else
+struct dp_reo_desc_batch;
+
+static inline uint32_t dp_reo_desc_freelist_limit(struct dp_soc *soc,
+						  uint32_t list_size)
+{
+	return REO_DESC_FREELIST_SIZE;
+}
+
+static inline bool dp_reo_desc_batch_add(struct dp_reo_desc_batch **batch,
+					 struct reo_desc_list_node *desc)
+{
+	return false;
+}
+
+static inline void dp_reo_desc_batch_flush(struct dp_soc *soc,
+					   struct dp_reo_desc_batch *batch,
+					   union hal_reo_status *reo_status)
+{
+}
+#endif /* WLAN_DP_REO_DESC_BATCH_FLUSH */
+
+struct reo_desc_list_node *
+dp_reo_desc_freelist_next(struct dp_soc *soc, unsigned long curr_ts,
+			  uint32_t limit, uint32_t *list_size)
+{
+	struct reo_desc_list_node *desc;
+
+	if (qdf_list_peek_front(&soc->reo_desc_freelist,
+				(qdf_list_node_t **)&desc) !=
+	    QDF_STATUS_SUCCESS)
+		return NULL;
+
+	if (*list_size < limit &&
+	    curr_ts <= desc->free_ts + REO_DESC_FREE_DEFER_MS &&
+	    !(desc->resend_update_reo_cmd && *list_size))
+		return NULL;
+
+	qdf_list_remove_front(&soc->reo_desc_freelist,
+			      (qdf_list_node_t **)&desc);
+	(*list_size)--;
+
+	return desc;
+}
+
 /*
  * dp_rx_tid_delete_cb() - Callback to flush reo descriptor HW cache
  * after deleting the entries (ie., setting valid=0)
@@ -3527,9 +3960,8 @@ void dp_rx_tid_delete_cb(struct dp_soc *soc, void *cb_ctxt,
 	uint32_t list_size;
 	struct reo_desc_list_node *desc;
 	unsigned long curr_ts = qdf_get_system_timestamp();
-	uint32_t desc_size, tot_desc_size;
-	struct hal_reo_cmd_params params;
-	bool flush_failure = false;
+	struct dp_reo_desc_batch *batch = NULL;
+	uint32_t limit;
 
 	DP_RX_REO_QDESC_UPDATE_EVT(freedesc);
 
@@ -3564,17 +3996,10 @@ void dp_rx_tid_delete_cb(struct dp_soc *soc, void *cb_ctxt,
 	 */
 	dp_reo_limit_clean_batch_sz(&list_size);
 
-	while ((qdf_list_peek_front(&soc->reo_desc_freelist,
-		(qdf_list_node_t **)&desc) == QDF_STATUS_SUCCESS) &&
-		((list_size >= REO_DESC_FREELIST_SIZE) ||
-		(curr_ts > (desc->free_ts + REO_DESC_FREE_DEFER_MS)) ||
-		(desc->resend_update_reo_cmd && list_size))) {
-		struct dp_rx_tid *rx_tid;
-
-		qdf_list_remove_front(&soc->reo_desc_freelist,
-				(qdf_list_node_t **)&desc);
-		list_size--;
-		rx_tid = &desc->rx_tid;
+	limit = dp_reo_desc_freelist_limit(soc, list_size);
+	while ((desc = dp_reo_desc_freelist_next(soc, curr_ts, limit,
+						 &list_size))) {
+		struct dp_rx_tid *rx_tid = &desc->rx_tid;
 
 		/* First process descs with resend_update_reo_cmd set */
 		if (desc->resend_update_reo_cmd) {
@@ -3585,76 +4010,14 @@ void dp_rx_tid_delete_cb(struct dp_soc *soc, void *cb_ctxt,
 				continue;
 		}
 
-		/* Flush and invalidate REO descriptor from HW cache: Base and
-		 * extension descriptors should be flushed separately */
-		if (desc->pending_ext_desc_size)
-			tot_desc_size = desc->pending_ext_desc_size;
-		else
-			tot_desc_size = rx_tid->hw_qdesc_alloc_size;
-		/* Get base descriptor size by passing non-qos TID */
-		desc_size = hal_get_reo_qdesc_size(soc->hal_soc, 0,
-						   DP_NON_QOS_TID);
-
-		/* Flush reo extension descriptors */
-		while ((tot_desc_size -= desc_size) > 0) {
-			qdf_mem_zero(&params, sizeof(params));
-			params.std.addr_lo =
-				((uint64_t)(rx_tid->hw_qdesc_paddr) +
-				tot_desc_size) & 0xffffffff;
-			params.std.addr_hi =
-				(uint64_t)(rx_tid->hw_qdesc_paddr) >> 32;
-
-			if (QDF_STATUS_SUCCESS != dp_reo_send_cmd(soc,
-							CMD_FLUSH_CACHE,
-							&params,
-							NULL,
-							NULL)) {
-				dp_info_rl("fail to send CMD_CACHE_FLUSH:"
-					   "tid %d desc %pK", rx_tid->tid,
-					   (void *)(rx_tid->hw_qdesc_paddr));
-				desc->pending_ext_desc_size = tot_desc_size +
-								      desc_size;
-				dp_reo_desc_clean_up(soc, desc, reo_status);
-				flush_failure = true;
-				break;
-			}
-		}
-
-		if (flush_failure)
-			break;
-		else
-			desc->pending_ext_desc_size = desc_size;
-
-		/* Flush base descriptor */
-		qdf_mem_zero(&params, sizeof(params));
-		params.std.need_status = 1;
-		params.std.addr_lo =
-			(uint64_t)(rx_tid->hw_qdesc_paddr) & 0xffffffff;
-		params.std.addr_hi = (uint64_t)(rx_tid->hw_qdesc_paddr) >> 32;
+		if (dp_reo_desc_batch_add(&batch, desc))
+			continue;
 
-		if (QDF_STATUS_SUCCESS != dp_reo_send_cmd(soc,
-							  CMD_FLUSH_CACHE,
-							  &params,
-							  dp_reo_desc_free,
-							  (void *)desc)) {
-			union hal_reo_status reo_status;
-			/*
-			 * If dp_reo_send_cmd return failure, related TID queue desc
-			 * should be unmapped. Also locally reo_desc, together with
-			 * TID queue desc also need to be freed accordingly.
-			 *
-			 * Here invoke desc_free function directly to do clean up.
-			 *
-			 * In case of MCL path add the desc back to the free
-			 * desc list and defer deletion.
-			 */
-			dp_info_rl("fail to send REO cmd to flush cache: tid %d",
-				   rx_tid->tid);
-			dp_reo_desc_clean_up(soc, desc, &reo_status);
-			DP_STATS_INC(soc, rx.err.reo_cmd_send_fail, 1);
+		if (dp_reo_desc_flush(soc, desc, reo_status) !=
+		    QDF_STATUS_SUCCESS)
 			break;
-		}
 	}
+	dp_reo_desc_batch_flush(soc, batch, reo_status);
 	qdf_spin_unlock_bh(&soc->reo_desc_freelist_lock);
 
 	dp_reo_desc_defer_free(soc);
@@ -3683,6 +4046,7 @@ static int dp_rx_tid_delete_wifi3(struct dp_peer *peer, int tid)
 
 	freedesc->rx_tid = *rx_tid;
 	freedesc->resend_update_reo_cmd = false;
+	dp_reo_desc_mark_delete(freedesc);
 
 	qdf_mem_zero(&params, sizeof(params));
 
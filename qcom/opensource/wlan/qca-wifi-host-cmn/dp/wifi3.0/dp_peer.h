@@ -869,6 +869,42 @@ void dp_rx_tid_delete_cb(struct dp_soc *soc,
 			 void *cb_ctxt,
 			 union hal_reo_status *reo_status);
 
+/*
+ * dp_reo_desc_freelist_next() - Remove the next REO queue to release from
+ * the freelist
+ *
+ * @soc: DP SOC handle
+ * @curr_ts: current system timestamp in ms
+ * @limit: freelist limit
+ * @list_size: REO queues in the freelist, decremented on removal
+ *
+ * The oldest queue is released once it is older than
+ * REO_DESC_FREE_DEFER_MS, when its REO update command has to be resent, or
+ * while the freelist holds @limit queues or more.
+ * Call with reo_desc_freelist_lock held.
+ *
+ * Return: REO queue removed from the freelist, NULL if none is due
+ */
+struct reo_desc_list_node *
+dp_reo_desc_freelist_next(struct dp_soc *soc, unsigned long curr_ts,
+			  uint32_t limit, uint32_t *list_size);
+
+#ifdef WLAN_DP_REO_DESC_BATCH_FLUSH
+/*
+ * dp_reo_desc_freelist_limit_scale() - Scale the REO queue freelist limit
+ * with the available memory
+ *
+ * @total_kb: total ram in Kb
+ * @avail_kb: ram available for allocation in Kb
+ *
+ * Return: REO_DESC_FREELIST_SIZE, scaled down with the share of available
+ *	memory once that drops under 1/16 of the total, with a floor of
+ *	REO_DESC_FREELIST_MIN_SIZE
+ */
+uint32_t dp_reo_desc_freelist_limit_scale(uint64_t total_kb,
+					  uint64_t avail_kb);
+#endif
+
 #ifdef QCA_PEER_EXT_STATS
 QDF_STATUS dp_peer_ext_stats_ctx_alloc(struct dp_soc *soc,
 				       struct dp_peer *peer);
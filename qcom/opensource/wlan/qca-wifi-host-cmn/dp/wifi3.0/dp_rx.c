@@ -32,6 +32,7 @@
 #include "dp_ipa.h"
 #include "dp_hist.h"
 #include "dp_rx_buffer_pool.h"
+#include "dp_lat_trace.h"
 #ifdef WIFI_MONITOR_SUPPORT
 #include "dp_htt.h"
 #include <dp_mon.h>
@@ -281,6 +282,8 @@ dp_pdev_nbuf_alloc_and_map_replenish(struct dp_soc *dp_soc,
  *	       or NULL during dp rx initialization or out of buffer
  *	       interrupt.
  * @tail: tail of descs list
+ * @reo_ring_num: REO ring whose rx processing replenishes, to draw from
+ *		  and return descs to its free stack, or DP_RX_DESC_NO_RING
  * @func_name: name of the caller function
  * Return: return success or failure
  */
@@ -290,6 +293,7 @@ QDF_STATUS __dp_rx_buffers_replenish(struct dp_soc *dp_soc, uint32_t mac_id,
 				uint32_t num_req_buffers,
 				union dp_rx_desc_list_elem_t **desc_list,
 				union dp_rx_desc_list_elem_t **tail,
+				uint8_t reo_ring_num,
 				const char *func_name)
 {
 	uint32_t num_alloc_desc;
@@ -344,11 +348,12 @@ QDF_STATUS __dp_rx_buffers_replenish(struct dp_soc *dp_soc, uint32_t mac_id,
 		   CRITICAL_BUFFER_THRESHOLD) {
 		/* Append some free descriptors to tail */
 		num_alloc_desc =
-			dp_rx_get_free_desc_list(dp_soc, mac_id,
-						 rx_desc_pool,
-						 CRITICAL_BUFFER_THRESHOLD,
-						 &desc_list_append,
-						 &tail_append);
+			dp_rx_ring_get_free_desc_list(dp_soc, mac_id,
+						      rx_desc_pool,
+						      CRITICAL_BUFFER_THRESHOLD,
+						      &desc_list_append,
+						      &tail_append,
+						      reo_ring_num);
 
 		if (num_alloc_desc) {
 			temp_list = *desc_list;
@@ -373,11 +378,12 @@ QDF_STATUS __dp_rx_buffers_replenish(struct dp_soc *dp_soc, uint32_t mac_id,
 	 * if desc_list is NULL, allocate the descs from freelist
 	 */
 	if (!(*desc_list)) {
-		num_alloc_desc = dp_rx_get_free_desc_list(dp_soc, mac_id,
-							  rx_desc_pool,
-							  num_req_buffers,
-							  desc_list,
-							  tail);
+		num_alloc_desc = dp_rx_ring_get_free_desc_list(dp_soc, mac_id,
+							       rx_desc_pool,
+							       num_req_buffers,
+							       desc_list,
+							       tail,
+							       reo_ring_num);
 
 		if (!num_alloc_desc) {
 			dp_rx_err("%pK: no free rx_descs in freelist", dp_soc);
@@ -472,8 +478,9 @@ free_descs:
 	 * add any available free desc back to the free list
 	 */
 	if (*desc_list)
-		dp_rx_add_desc_list_to_free_list(dp_soc, desc_list, tail,
-			mac_id, rx_desc_pool);
+		dp_rx_ring_add_desc_list_to_free_list(dp_soc, desc_list, tail,
+						      mac_id, rx_desc_pool,
+						      reo_ring_num);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -1653,6 +1660,7 @@ QDF_STATUS dp_rx_deliver_to_stack(struct dp_soc *soc,
 				&nbuf_tail, peer->mac_addr.raw);
 	}
 
+	dp_lat_trace_stamp_list(soc, nbuf_head, CDP_LAT_RX_DELIVER);
 	dp_rx_check_delivery_to_stack(soc, vdev, peer, nbuf_head);
 
 	return QDF_STATUS_SUCCESS;
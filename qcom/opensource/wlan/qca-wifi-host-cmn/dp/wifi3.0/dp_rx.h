@@ -118,6 +118,9 @@ struct dp_rx_desc_dbg_info {
  *			  nbuf is already unmapped
  * @in_err_state	: Nbuf sanity failed for this descriptor.
  * @nbuf_data_addr	: VA of nbuf data posted
+ *
+ * Fields used on replenish and reap come first so that they share a
+ * cache line, the debug fields follow.
  */
 struct dp_rx_desc {
 	qdf_nbuf_t nbuf;
@@ -125,14 +128,14 @@ struct dp_rx_desc {
 	qdf_dma_addr_t paddr_buf_start;
 	uint32_t cookie;
 	uint8_t	 pool_id;
+	uint8_t	in_use:1,
+		unmapped:1,
+		in_err_state:1;
 #ifdef RX_DESC_DEBUG_CHECK
 	uint32_t magic;
 	uint8_t *nbuf_data_addr;
 	struct dp_rx_desc_dbg_info *dbg_info;
 #endif
-	uint8_t	in_use:1,
-		unmapped:1,
-		in_err_state:1;
 };
 
 #ifndef QCA_HOST_MODE_WIFI_DISABLED
@@ -188,10 +191,21 @@ struct dp_rx_desc {
 #define dp_rx_add_to_free_desc_list(head, tail, new) \
 	__dp_rx_add_to_free_desc_list(head, tail, new, __func__)
 
+/* Replenish not done from the rx processing context of a REO ring */
+#define DP_RX_DESC_NO_RING 0xff
+
 #define dp_rx_buffers_replenish(soc, mac_id, rxdma_srng, rx_desc_pool, \
 				num_buffers, desc_list, tail) \
 	__dp_rx_buffers_replenish(soc, mac_id, rxdma_srng, rx_desc_pool, \
-				  num_buffers, desc_list, tail, __func__)
+				  num_buffers, desc_list, tail, \
+				  DP_RX_DESC_NO_RING, __func__)
+
+#define dp_rx_buffers_replenish_ring(soc, mac_id, rxdma_srng, rx_desc_pool, \
+				     num_buffers, desc_list, tail, \
+				     reo_ring_num) \
+	__dp_rx_buffers_replenish(soc, mac_id, rxdma_srng, rx_desc_pool, \
+				  num_buffers, desc_list, tail, \
+				  reo_ring_num, __func__)
 
 #ifdef DP_RX_SPECIAL_FRAME_NEED
 /**
@@ -448,24 +462,55 @@ union dp_rx_desc_list_elem_t {
 union dp_rx_desc_list_elem_t *dp_rx_desc_find(uint16_t page_id, uint16_t offset,
 					      struct rx_desc_pool *rx_pool);
 
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+/*
+ * The pool is one array split in pages of DP_RX_DESC_FLAT_PAGE_ELEMS
+ * descriptors, so the page ID and offset of a cookie form the array index.
+ */
+#define DP_RX_DESC_FLAT_PAGE_ELEMS (1 << DP_RX_DESC_PAGE_ID_SHIFT)
+#define DP_RX_DESC_FLAT_MAX_ELEMS (1 << DP_RX_DESC_POOL_ID_SHIFT)
+#define DP_RX_DESC_FLAT_COOKIE_GET_INDEX(_cookie) \
+	((_cookie) & (DP_RX_DESC_FLAT_MAX_ELEMS - 1))
+
+/**
+ * dp_rx_desc_pool_elem() - find rx descriptor element from cookie
+ * @rx_desc_pool: rx descriptor pool the cookie belongs to
+ * @cookie: rx descriptor cookie
+ *
+ * Return: RX descriptor element
+ */
+static inline union dp_rx_desc_list_elem_t *
+dp_rx_desc_pool_elem(struct rx_desc_pool *rx_desc_pool, uint32_t cookie)
+{
+	return (union dp_rx_desc_list_elem_t *)
+		(rx_desc_pool->desc_base + rx_desc_pool->elem_size *
+		 DP_RX_DESC_FLAT_COOKIE_GET_INDEX(cookie));
+}
+#else
+static inline union dp_rx_desc_list_elem_t *
+dp_rx_desc_pool_elem(struct rx_desc_pool *rx_desc_pool, uint32_t cookie)
+{
+	uint16_t page_id = DP_RX_DESC_MULTI_PAGE_COOKIE_GET_PAGE_ID(cookie);
+	uint8_t offset = DP_RX_DESC_MULTI_PAGE_COOKIE_GET_OFFSET(cookie);
+
+	return (union dp_rx_desc_list_elem_t *)
+		(rx_desc_pool->desc_pages.cacheable_pages[page_id] +
+		rx_desc_pool->elem_size * offset);
+}
+#endif /* WLAN_DP_RX_DESC_RING_POOL */
+
 static inline
 struct dp_rx_desc *dp_get_rx_desc_from_cookie(struct dp_soc *soc,
 					      struct rx_desc_pool *pool,
 					      uint32_t cookie)
 {
 	uint8_t pool_id = DP_RX_DESC_MULTI_PAGE_COOKIE_GET_POOL_ID(cookie);
-	uint16_t page_id = DP_RX_DESC_MULTI_PAGE_COOKIE_GET_PAGE_ID(cookie);
-	uint8_t offset = DP_RX_DESC_MULTI_PAGE_COOKIE_GET_OFFSET(cookie);
-	struct rx_desc_pool *rx_desc_pool;
 	union dp_rx_desc_list_elem_t *rx_desc_elem;
 
 	if (qdf_unlikely(pool_id >= MAX_PDEV_CNT))
 		return NULL;
 
-	rx_desc_pool = &pool[pool_id];
-	rx_desc_elem = (union dp_rx_desc_list_elem_t *)
-		(rx_desc_pool->desc_pages.cacheable_pages[page_id] +
-		rx_desc_pool->elem_size * offset);
+	rx_desc_elem = dp_rx_desc_pool_elem(&pool[pool_id], cookie);
 
 	return &rx_desc_elem->rx_desc;
 }
@@ -476,18 +521,12 @@ struct dp_rx_desc *dp_get_rx_mon_status_desc_from_cookie(struct dp_soc *soc,
 							 uint32_t cookie)
 {
 	uint8_t pool_id = DP_RX_DESC_MULTI_PAGE_COOKIE_GET_POOL_ID(cookie);
-	uint16_t page_id = DP_RX_DESC_MULTI_PAGE_COOKIE_GET_PAGE_ID(cookie);
-	uint8_t offset = DP_RX_DESC_MULTI_PAGE_COOKIE_GET_OFFSET(cookie);
-	struct rx_desc_pool *rx_desc_pool;
 	union dp_rx_desc_list_elem_t *rx_desc_elem;
 
 	if (qdf_unlikely(pool_id >= NUM_RXDMA_RINGS_PER_PDEV))
 		return NULL;
 
-	rx_desc_pool = &pool[pool_id];
-	rx_desc_elem = (union dp_rx_desc_list_elem_t *)
-		(rx_desc_pool->desc_pages.cacheable_pages[page_id] +
-		rx_desc_pool->elem_size * offset);
+	rx_desc_elem = dp_rx_desc_pool_elem(&pool[pool_id], cookie);
 
 	return &rx_desc_elem->rx_desc;
 }
@@ -677,6 +716,11 @@ static inline bool dp_rx_is_sw_cookie_valid(struct dp_soc *soc,
 	    offset >= rx_desc_pool->desc_pages.num_element_per_page)
 		goto fail;
 
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+	if (DP_RX_DESC_FLAT_COOKIE_GET_INDEX(cookie) >= rx_desc_pool->pool_size)
+		goto fail;
+#endif
+
 	return true;
 
 fail:
@@ -721,6 +765,71 @@ uint16_t dp_rx_get_free_desc_list(struct dp_soc *soc, uint32_t pool_id,
 				union dp_rx_desc_list_elem_t **desc_list,
 				union dp_rx_desc_list_elem_t **tail);
 
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+/**
+ * dp_rx_ring_get_free_desc_list() - provide a list of descriptors, taken
+ *	from the free stack of a REO ring first and then from the pool
+ * @soc: core txrx main context
+ * @pool_id: pool_id which is one of 3 mac_ids
+ * @rx_desc_pool: rx descriptor pool pointer
+ * @num_descs: number of descs requested
+ * @desc_list: attach the descs to this list (output parameter)
+ * @tail: attach the point to last desc of free list (output parameter)
+ * @reo_ring_num: REO ring the caller processes, or DP_RX_DESC_NO_RING
+ *
+ * Return: number of descs allocated
+ */
+uint16_t dp_rx_ring_get_free_desc_list(struct dp_soc *soc, uint32_t pool_id,
+				       struct rx_desc_pool *rx_desc_pool,
+				       uint16_t num_descs,
+				       union dp_rx_desc_list_elem_t **desc_list,
+				       union dp_rx_desc_list_elem_t **tail,
+				       uint8_t reo_ring_num);
+
+/**
+ * dp_rx_ring_add_desc_list_to_free_list() - return a desc list to the free
+ *	stack of a REO ring, the pool freelist takes what does not fit
+ * @soc: core txrx main context
+ * @local_desc_list: local desc list provided by the caller
+ * @tail: attach the point to last desc of local desc list
+ * @pool_id: pool_id which is one of 3 mac_ids
+ * @rx_desc_pool: rx descriptor pool pointer
+ * @reo_ring_num: REO ring the caller processes, or DP_RX_DESC_NO_RING
+ *
+ * Return: None
+ */
+void dp_rx_ring_add_desc_list_to_free_list(struct dp_soc *soc,
+				union dp_rx_desc_list_elem_t **local_desc_list,
+				union dp_rx_desc_list_elem_t **tail,
+				uint16_t pool_id,
+				struct rx_desc_pool *rx_desc_pool,
+				uint8_t reo_ring_num);
+#else
+static inline
+uint16_t dp_rx_ring_get_free_desc_list(struct dp_soc *soc, uint32_t pool_id,
+				       struct rx_desc_pool *rx_desc_pool,
+				       uint16_t num_descs,
+				       union dp_rx_desc_list_elem_t **desc_list,
+				       union dp_rx_desc_list_elem_t **tail,
+				       uint8_t reo_ring_num)
+{
+	return dp_rx_get_free_desc_list(soc, pool_id, rx_desc_pool, num_descs,
+					desc_list, tail);
+}
+
+static inline
+void dp_rx_ring_add_desc_list_to_free_list(struct dp_soc *soc,
+				union dp_rx_desc_list_elem_t **local_desc_list,
+				union dp_rx_desc_list_elem_t **tail,
+				uint16_t pool_id,
+				struct rx_desc_pool *rx_desc_pool,
+				uint8_t reo_ring_num)
+{
+	dp_rx_add_desc_list_to_free_list(soc, local_desc_list, tail, pool_id,
+					 rx_desc_pool);
+}
+#endif /* WLAN_DP_RX_DESC_RING_POOL */
+
 QDF_STATUS dp_rx_pdev_desc_pool_alloc(struct dp_pdev *pdev);
 void dp_rx_pdev_desc_pool_free(struct dp_pdev *pdev);
 
@@ -1422,6 +1531,8 @@ dp_rx_update_flow_tag(struct dp_soc *soc, struct dp_vdev *vdev,
  *	       or NULL during dp rx initialization or out of buffer
  *	       interrupt.
  * @tail: tail of descs list
+ * @reo_ring_num: REO ring whose rx processing replenishes, to draw from
+ *		  and return descs to its free stack, or DP_RX_DESC_NO_RING
  * @func_name: name of the caller function
  * Return: return success or failure
  */
@@ -1431,6 +1542,7 @@ QDF_STATUS __dp_rx_buffers_replenish(struct dp_soc *dp_soc, uint32_t mac_id,
 				 uint32_t num_req_buffers,
 				 union dp_rx_desc_list_elem_t **desc_list,
 				 union dp_rx_desc_list_elem_t **tail,
+				 uint8_t reo_ring_num,
 				 const char *func_name);
 
 /*
@@ -21,6 +21,109 @@
 #include "dp_ipa.h"
 #include <qdf_module.h>
 
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+/*
+ * dp_rx_desc_ring_stack_init() - set up empty REO ring stacks, the pool
+ *				  freelist holds all the descriptors
+ * @rx_desc_pool: rx descriptor pool pointer
+ *
+ * Return: None
+ */
+static void dp_rx_desc_ring_stack_init(struct rx_desc_pool *rx_desc_pool)
+{
+	struct dp_rx_desc_ring_stack *stack;
+	uint8_t ring;
+
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++) {
+		stack = &rx_desc_pool->ring_stack[ring];
+		qdf_spinlock_create(&stack->lock);
+		stack->top = NULL;
+		stack->count = 0;
+		stack->hit = 0;
+		stack->miss = 0;
+		stack->spill = 0;
+		stack->drain = 0;
+	}
+}
+
+/*
+ * dp_rx_desc_ring_stack_deinit() - destroy the REO ring stack locks
+ * @rx_desc_pool: rx descriptor pool pointer
+ *
+ * Return: None
+ */
+static void dp_rx_desc_ring_stack_deinit(struct rx_desc_pool *rx_desc_pool)
+{
+	uint8_t ring;
+
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++)
+		qdf_spinlock_destroy(&rx_desc_pool->ring_stack[ring].lock);
+}
+
+/*
+ * dp_rx_desc_ring_stack_drain() - return the descriptors held by the REO
+ *				   ring stacks to the pool freelist
+ * @rx_desc_pool: rx descriptor pool pointer
+ *
+ * The stacks can hold DP_RX_DESC_RING_STACK_SIZE descriptors per REO ring,
+ * which replenish paths without a ring, or for another ring, cannot reach.
+ * Drained when the freelist cannot fill a request.
+ *
+ * Return: number of descriptors returned to the freelist
+ */
+static uint32_t
+dp_rx_desc_ring_stack_drain(struct rx_desc_pool *rx_desc_pool)
+{
+	struct dp_rx_desc_ring_stack *stack;
+	union dp_rx_desc_list_elem_t *list, *tail;
+	uint32_t count, total = 0;
+	uint8_t ring;
+
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++) {
+		stack = &rx_desc_pool->ring_stack[ring];
+
+		qdf_spin_lock_bh(&stack->lock);
+		list = stack->top;
+		count = stack->count;
+		stack->top = NULL;
+		stack->count = 0;
+		stack->drain += count;
+		qdf_spin_unlock_bh(&stack->lock);
+
+		if (!list)
+			continue;
+
+		for (tail = list; tail->next; tail = tail->next)
+			;
+
+		qdf_spin_lock_bh(&rx_desc_pool->lock);
+		tail->next = rx_desc_pool->freelist;
+		rx_desc_pool->freelist = list;
+		qdf_spin_unlock_bh(&rx_desc_pool->lock);
+
+		total += count;
+	}
+
+	return total;
+}
+#else
+static inline void
+dp_rx_desc_ring_stack_init(struct rx_desc_pool *rx_desc_pool)
+{
+}
+
+static inline void
+dp_rx_desc_ring_stack_deinit(struct rx_desc_pool *rx_desc_pool)
+{
+}
+
+static inline uint32_t
+dp_rx_desc_ring_stack_drain(struct rx_desc_pool *rx_desc_pool)
+{
+	return 0;
+}
+#endif /* WLAN_DP_RX_DESC_RING_POOL */
+
 #ifdef RX_DESC_MULTI_PAGE_ALLOC
 A_COMPILE_TIME_ASSERT(cookie_size_check,
 		      PAGE_SIZE / sizeof(union dp_rx_desc_list_elem_t) <=
@@ -46,21 +149,113 @@ QDF_STATUS dp_rx_desc_pool_is_allocated(struct rx_desc_pool *rx_desc_pool)
 
 qdf_export_symbol(dp_rx_desc_pool_is_allocated);
 
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+A_COMPILE_TIME_ASSERT(flat_cookie_size_check,
+		      DP_RX_DESC_FLAT_PAGE_ELEMS <=
+		      RX_DESC_MULTI_PAGE_COOKIE_OFFSET_MASK + 1);
+
 /*
- * dp_rx_desc_pool_alloc() - Allocate a memory pool for software rx
- *			     descriptors
+ * dp_rx_desc_elem_size() - size of an rx descriptor in the pool array
  *
+ * Descriptors are padded to a power of two up to a cache line, or to
+ * whole cache lines beyond, so that none of them straddles cache lines.
+ *
+ * Return: element size
+ */
+static uint16_t dp_rx_desc_elem_size(void)
+{
+	uint16_t desc_size = sizeof(union dp_rx_desc_list_elem_t);
+	uint16_t elem_size = 1;
+
+	if (desc_size > QDF_CACHE_LINE_SZ)
+		return qdf_roundup(desc_size, QDF_CACHE_LINE_SZ);
+
+	while (elem_size < desc_size)
+		elem_size <<= 1;
+
+	return elem_size;
+}
+
+/*
+ * dp_rx_desc_pool_mem_alloc() - Allocate the descriptors of a pool as one
+ *				 cookie indexed array
  * @soc: core txrx main context
  * @num_elem: number of rx descriptors (size of the pool)
  * @rx_desc_pool: rx descriptor pool pointer
  *
- * Return: QDF_STATUS  QDF_STATUS_SUCCESS
- *		       QDF_STATUS_E_NOMEM
- *		       QDF_STATUS_E_FAULT
+ * The array is described through desc_pages as pages of
+ * DP_RX_DESC_FLAT_PAGE_ELEMS descriptors, so the page ID and offset of a
+ * cookie make up the array index and the code walking the pool by pages
+ * is unchanged.
+ *
+ * Return: QDF_STATUS_SUCCESS on success
  */
-QDF_STATUS dp_rx_desc_pool_alloc(struct dp_soc *soc,
-				 uint32_t num_elem,
-				 struct rx_desc_pool *rx_desc_pool)
+static QDF_STATUS dp_rx_desc_pool_mem_alloc(struct dp_soc *soc,
+					    uint32_t num_elem,
+					    struct rx_desc_pool *rx_desc_pool)
+{
+	struct qdf_mem_multi_page_t *pages = &rx_desc_pool->desc_pages;
+	union dp_rx_desc_list_elem_t *rx_desc_elem;
+	uint16_t elem_size = dp_rx_desc_elem_size();
+	uint32_t num_pages, i;
+
+	if (!num_elem || num_elem > DP_RX_DESC_FLAT_MAX_ELEMS) {
+		qdf_err("invalid rx desc pool size %u", num_elem);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	num_pages = (num_elem + DP_RX_DESC_FLAT_PAGE_ELEMS - 1) /
+		    DP_RX_DESC_FLAT_PAGE_ELEMS;
+	pages->cacheable_pages = qdf_mem_malloc(num_pages * sizeof(void *));
+	if (!pages->cacheable_pages)
+		return QDF_STATUS_E_NOMEM;
+
+	/* whole pages, so any cookie passing the page checks is in bounds */
+	rx_desc_pool->desc_base = qdf_mem_valloc(num_pages *
+						 DP_RX_DESC_FLAT_PAGE_ELEMS *
+						 elem_size);
+	if (!rx_desc_pool->desc_base) {
+		qdf_err("rx desc array alloc fail, size=%u, elem=%u",
+			elem_size, num_elem);
+		qdf_mem_free(pages->cacheable_pages);
+		pages->cacheable_pages = NULL;
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	rx_desc_pool->elem_size = elem_size;
+	pages->num_element_per_page = DP_RX_DESC_FLAT_PAGE_ELEMS;
+	pages->num_pages = num_pages;
+	pages->page_size = DP_RX_DESC_FLAT_PAGE_ELEMS * elem_size;
+	for (i = 0; i < num_pages; i++)
+		pages->cacheable_pages[i] = rx_desc_pool->desc_base +
+					    i * pages->page_size;
+
+	for (i = 0; i < num_elem; i++) {
+		rx_desc_elem = (union dp_rx_desc_list_elem_t *)
+			(rx_desc_pool->desc_base + i * elem_size);
+		if (i == num_elem - 1)
+			rx_desc_elem->next = NULL;
+		else
+			rx_desc_elem->next = (union dp_rx_desc_list_elem_t *)
+				(rx_desc_pool->desc_base + (i + 1) * elem_size);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void dp_rx_desc_pool_mem_free(struct dp_soc *soc,
+				     struct rx_desc_pool *rx_desc_pool)
+{
+	qdf_mem_vfree(rx_desc_pool->desc_base);
+	rx_desc_pool->desc_base = NULL;
+	qdf_mem_free(rx_desc_pool->desc_pages.cacheable_pages);
+	qdf_mem_zero(&rx_desc_pool->desc_pages,
+		     sizeof(rx_desc_pool->desc_pages));
+}
+#else
+static QDF_STATUS dp_rx_desc_pool_mem_alloc(struct dp_soc *soc,
+					    uint32_t num_elem,
+					    struct rx_desc_pool *rx_desc_pool)
 {
 	uint32_t desc_size;
 	union dp_rx_desc_list_elem_t *rx_desc_elem;
@@ -82,14 +277,38 @@ QDF_STATUS dp_rx_desc_pool_alloc(struct dp_soc *soc,
 				    desc_size, num_elem, true)) {
 		qdf_err("overflow num link,size=%d, elem=%d",
 			desc_size, num_elem);
-		goto free_rx_desc_pool;
+		dp_rx_desc_pool_free(soc, rx_desc_pool);
+		return QDF_STATUS_E_FAULT;
 	}
+
 	return QDF_STATUS_SUCCESS;
+}
 
-free_rx_desc_pool:
-	dp_rx_desc_pool_free(soc, rx_desc_pool);
+static void dp_rx_desc_pool_mem_free(struct dp_soc *soc,
+				     struct rx_desc_pool *rx_desc_pool)
+{
+	dp_desc_multi_pages_mem_free(soc, rx_desc_pool->desc_type,
+				     &rx_desc_pool->desc_pages, 0, true);
+}
+#endif /* WLAN_DP_RX_DESC_RING_POOL */
 
-	return QDF_STATUS_E_FAULT;
+/*
+ * dp_rx_desc_pool_alloc() - Allocate a memory pool for software rx
+ *			     descriptors
+ *
+ * @soc: core txrx main context
+ * @num_elem: number of rx descriptors (size of the pool)
+ * @rx_desc_pool: rx descriptor pool pointer
+ *
+ * Return: QDF_STATUS  QDF_STATUS_SUCCESS
+ *		       QDF_STATUS_E_NOMEM
+ *		       QDF_STATUS_E_FAULT
+ */
+QDF_STATUS dp_rx_desc_pool_alloc(struct dp_soc *soc,
+				 uint32_t num_elem,
+				 struct rx_desc_pool *rx_desc_pool)
+{
+	return dp_rx_desc_pool_mem_alloc(soc, num_elem, rx_desc_pool);
 }
 
 qdf_export_symbol(dp_rx_desc_pool_alloc);
@@ -158,6 +377,8 @@ void dp_rx_desc_pool_init(struct dp_soc *soc, uint32_t pool_id,
 	if (!QDF_IS_STATUS_SUCCESS(status))
 		dp_err("RX desc pool initialization failed");
 
+	dp_rx_desc_ring_stack_init(rx_desc_pool);
+
 	qdf_spin_unlock_bh(&rx_desc_pool->lock);
 }
 
@@ -245,6 +466,7 @@ void dp_rx_desc_nbuf_and_pool_free(struct dp_soc *soc, uint32_t pool_id,
 	dp_rx_desc_nbuf_cleanup(soc, nbuf_unmap_list, nbuf_free_list,
 				rx_desc_pool->buf_size);
 	qdf_spinlock_destroy(&rx_desc_pool->lock);
+	dp_rx_desc_ring_stack_deinit(rx_desc_pool);
 }
 
 void dp_rx_desc_nbuf_free(struct dp_soc *soc,
@@ -268,8 +490,7 @@ void dp_rx_desc_pool_free(struct dp_soc *soc,
 	if (qdf_unlikely(!(rx_desc_pool->desc_pages.cacheable_pages)))
 		return;
 
-	dp_desc_multi_pages_mem_free(soc, rx_desc_pool->desc_type,
-				     &rx_desc_pool->desc_pages, 0, true);
+	dp_rx_desc_pool_mem_free(soc, rx_desc_pool);
 }
 
 qdf_export_symbol(dp_rx_desc_pool_free);
@@ -290,6 +511,7 @@ void dp_rx_desc_pool_deinit(struct dp_soc *soc,
 
 	qdf_spin_unlock_bh(&rx_desc_pool->lock);
 	qdf_spinlock_destroy(&rx_desc_pool->lock);
+	dp_rx_desc_ring_stack_deinit(rx_desc_pool);
 }
 
 qdf_export_symbol(dp_rx_desc_pool_deinit);
@@ -393,6 +615,8 @@ void dp_rx_desc_pool_init(struct dp_soc *soc, uint32_t pool_id,
 	if (!QDF_IS_STATUS_SUCCESS(status))
 		dp_err("RX desc pool initialization failed");
 
+	dp_rx_desc_ring_stack_init(rx_desc_pool);
+
 	qdf_spin_unlock_bh(&rx_desc_pool->lock);
 }
 
@@ -426,6 +650,7 @@ void dp_rx_desc_nbuf_and_pool_free(struct dp_soc *soc, uint32_t pool_id,
 	qdf_mem_free(rx_desc_pool->array);
 	qdf_spin_unlock_bh(&rx_desc_pool->lock);
 	qdf_spinlock_destroy(&rx_desc_pool->lock);
+	dp_rx_desc_ring_stack_deinit(rx_desc_pool);
 }
 
 void dp_rx_desc_nbuf_free(struct dp_soc *soc,
@@ -519,6 +744,7 @@ void dp_rx_desc_pool_deinit(struct dp_soc *soc,
 
 	qdf_spin_unlock_bh(&rx_desc_pool->lock);
 	qdf_spinlock_destroy(&rx_desc_pool->lock);
+	dp_rx_desc_ring_stack_deinit(rx_desc_pool);
 }
 
 qdf_export_symbol(dp_rx_desc_pool_deinit);
@@ -532,11 +758,8 @@ void dp_rx_desc_pool_deinit_generic(struct dp_soc *soc,
 }
 
 /*
- * dp_rx_get_free_desc_list() - provide a list of descriptors from
- *				the free rx desc pool.
- *
- * @soc: core txrx main context
- * @pool_id: pool_id which is one of 3 mac_ids
+ * __dp_rx_get_free_desc_list() - take a list of descriptors from the
+ *				  freelist of the rx desc pool
  * @rx_desc_pool: rx descriptor pool pointer
  * @num_descs: number of descs requested from freelist
  * @desc_list: attach the descs to this list (output parameter)
@@ -544,11 +767,11 @@ void dp_rx_desc_pool_deinit_generic(struct dp_soc *soc,
  *
  * Return: number of descs allocated from free list.
  */
-uint16_t dp_rx_get_free_desc_list(struct dp_soc *soc, uint32_t pool_id,
-				struct rx_desc_pool *rx_desc_pool,
-				uint16_t num_descs,
-				union dp_rx_desc_list_elem_t **desc_list,
-				union dp_rx_desc_list_elem_t **tail)
+static uint16_t
+__dp_rx_get_free_desc_list(struct rx_desc_pool *rx_desc_pool,
+			   uint16_t num_descs,
+			   union dp_rx_desc_list_elem_t **desc_list,
+			   union dp_rx_desc_list_elem_t **tail)
 {
 	uint16_t count;
 
@@ -570,6 +793,52 @@ uint16_t dp_rx_get_free_desc_list(struct dp_soc *soc, uint32_t pool_id,
 	return count;
 }
 
+/*
+ * dp_rx_get_free_desc_list() - provide a list of descriptors from
+ *				the free rx desc pool.
+ *
+ * @soc: core txrx main context
+ * @pool_id: pool_id which is one of 3 mac_ids
+ * @rx_desc_pool: rx descriptor pool pointer
+ * @num_descs: number of descs requested from freelist
+ * @desc_list: attach the descs to this list (output parameter)
+ * @tail: attach the point to last desc of free list (output parameter)
+ *
+ * When the freelist runs out, the descriptors held by the REO ring stacks
+ * are drained into it and the rest of the request is taken from there.
+ *
+ * Return: number of descs allocated from free list.
+ */
+uint16_t dp_rx_get_free_desc_list(struct dp_soc *soc, uint32_t pool_id,
+				struct rx_desc_pool *rx_desc_pool,
+				uint16_t num_descs,
+				union dp_rx_desc_list_elem_t **desc_list,
+				union dp_rx_desc_list_elem_t **tail)
+{
+	union dp_rx_desc_list_elem_t *more_list = NULL;
+	union dp_rx_desc_list_elem_t *more_tail = NULL;
+	uint16_t count, more;
+
+	count = __dp_rx_get_free_desc_list(rx_desc_pool, num_descs,
+					   desc_list, tail);
+	if (qdf_likely(count == num_descs) ||
+	    !dp_rx_desc_ring_stack_drain(rx_desc_pool))
+		return count;
+
+	more = __dp_rx_get_free_desc_list(rx_desc_pool, num_descs - count,
+					  &more_list, &more_tail);
+	if (!more)
+		return count;
+
+	if (count)
+		(*tail)->next = more_list;
+	else
+		*desc_list = more_list;
+	*tail = more_tail;
+
+	return count + more;
+}
+
 qdf_export_symbol(dp_rx_get_free_desc_list);
 
 /*
@@ -606,3 +875,99 @@ void dp_rx_add_desc_list_to_free_list(struct dp_soc *soc,
 }
 
 qdf_export_symbol(dp_rx_add_desc_list_to_free_list);
+
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+uint16_t dp_rx_ring_get_free_desc_list(struct dp_soc *soc, uint32_t pool_id,
+				       struct rx_desc_pool *rx_desc_pool,
+				       uint16_t num_descs,
+				       union dp_rx_desc_list_elem_t **desc_list,
+				       union dp_rx_desc_list_elem_t **tail,
+				       uint8_t reo_ring_num)
+{
+	struct dp_rx_desc_ring_stack *stack;
+	union dp_rx_desc_list_elem_t *pool_list = NULL;
+	union dp_rx_desc_list_elem_t *pool_tail = NULL;
+	uint16_t count, num_pool;
+
+	if (reo_ring_num >= MAX_REO_DEST_RINGS)
+		return dp_rx_get_free_desc_list(soc, pool_id, rx_desc_pool,
+						num_descs, desc_list, tail);
+
+	stack = &rx_desc_pool->ring_stack[reo_ring_num];
+
+	qdf_spin_lock_bh(&stack->lock);
+	*desc_list = *tail = stack->top;
+	for (count = 0; count < num_descs && stack->top; count++) {
+		*tail = stack->top;
+		stack->top = stack->top->next;
+	}
+	if (count)
+		(*tail)->next = NULL;
+	stack->count -= count;
+	stack->hit += count;
+	qdf_spin_unlock_bh(&stack->lock);
+
+	if (count == num_descs)
+		return count;
+
+	/* may drain the stacks, own one included, so not under its lock */
+	num_pool = dp_rx_get_free_desc_list(soc, pool_id, rx_desc_pool,
+					    num_descs - count,
+					    &pool_list, &pool_tail);
+	stack->miss += num_pool;
+	if (!num_pool)
+		return count;
+
+	if (count)
+		(*tail)->next = pool_list;
+	else
+		*desc_list = pool_list;
+	*tail = pool_tail;
+
+	return count + num_pool;
+}
+
+qdf_export_symbol(dp_rx_ring_get_free_desc_list);
+
+void dp_rx_ring_add_desc_list_to_free_list(struct dp_soc *soc,
+				union dp_rx_desc_list_elem_t **local_desc_list,
+				union dp_rx_desc_list_elem_t **tail,
+				uint16_t pool_id,
+				struct rx_desc_pool *rx_desc_pool,
+				uint8_t reo_ring_num)
+{
+	struct dp_rx_desc_ring_stack *stack;
+	union dp_rx_desc_list_elem_t *elem;
+
+	if (reo_ring_num >= MAX_REO_DEST_RINGS) {
+		dp_rx_add_desc_list_to_free_list(soc, local_desc_list, tail,
+						 pool_id, rx_desc_pool);
+		return;
+	}
+
+	stack = &rx_desc_pool->ring_stack[reo_ring_num];
+
+	qdf_spin_lock_bh(&stack->lock);
+	while (*local_desc_list &&
+	       stack->count < DP_RX_DESC_RING_STACK_SIZE) {
+		elem = *local_desc_list;
+		*local_desc_list = elem->next;
+		elem->next = stack->top;
+		stack->top = elem;
+		stack->count++;
+	}
+
+	if (!*local_desc_list) {
+		qdf_spin_unlock_bh(&stack->lock);
+		*tail = NULL;
+		return;
+	}
+
+	stack->spill++;
+	qdf_spin_unlock_bh(&stack->lock);
+	dp_rx_add_desc_list_to_free_list(soc, local_desc_list, tail,
+					 pool_id, rx_desc_pool);
+}
+
+qdf_export_symbol(dp_rx_ring_add_desc_list_to_free_list);
+#endif /* WLAN_DP_RX_DESC_RING_POOL */
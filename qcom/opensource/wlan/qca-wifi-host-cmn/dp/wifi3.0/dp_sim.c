@@ -0,0 +1,1053 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <qdf_mem.h>
+#include <qdf_nbuf.h>
+#include <qdf_threads.h>
+#include <qdf_time.h>
+#include <qdf_trace.h>
+#include <qdf_atomic.h>
+#include "hal_hw_headers.h"
+#include "hal_internal.h"
+#include "hal_api.h"
+#include "hal_rx.h"
+#include "target_type.h"
+#include "cdp_txrx_cmn_reg.h"
+#include <wlan_cfg.h>
+#include "dp_types.h"
+#include "dp_internal.h"
+#include "dp_peer.h"
+#include "dp_rx.h"
+#include "dp_tx.h"
+#include "dp_tx_desc.h"
+#include "dp_sim.h"
+
+#define DP_SIM_TARGET_BATCH 32
+#define DP_SIM_TARGET_IDLE_US 20
+#define DP_SIM_HOST_IDLE_US 10
+#define DP_SIM_RUN_TIMEOUT_MS 10000
+#define DP_SIM_VDEV_ID 0
+#define DP_SIM_PEER_ID 1
+#define DP_SIM_MAX_PEER_ID 2
+
+#define DP_SIM_PCAP_MAGIC 0xa1b2c3d4
+#define DP_SIM_PCAP_MAGIC_NS 0xa1b23c4d
+#define DP_SIM_PCAP_MAGIC_SWAPPED 0xd4c3b2a1
+#define DP_SIM_PCAP_MAGIC_NS_SWAPPED 0x4d3cb2a1
+#define DP_SIM_PCAP_HDR_LEN 24
+#define DP_SIM_PCAP_REC_HDR_LEN 16
+#define DP_SIM_PCAP_LINKTYPE_OFFSET 20
+#define DP_SIM_PCAP_INCL_LEN_OFFSET 8
+#define DP_SIM_PCAP_LINKTYPE_ETHERNET 1
+#define DP_SIM_MIN_FRAME_LEN 14
+
+/* dp_arch_ops.c */
+void dp_configure_arch_ops(struct dp_soc *soc);
+qdf_size_t dp_get_soc_context_size(uint16_t device_id);
+
+/**
+ * struct dp_sim_ring - simulated ring
+ * @srng: soc ring, used by the data path
+ * @entry_size: ring entry size, in dwords
+ * @ring_size: ring size, in dwords
+ * @target_ptr: target side ring pointer, in dwords; the tail pointer of a
+ *		ring the host produces to, the head pointer of a ring the host
+ *		consumes from
+ */
+struct dp_sim_ring {
+	struct dp_srng *srng;
+	uint32_t entry_size;
+	uint32_t ring_size;
+	uint32_t target_ptr;
+};
+
+/**
+ * struct dp_sim_frame - frame of the loaded capture
+ * @data: frame contents
+ * @len: frame length
+ */
+struct dp_sim_frame {
+	const uint8_t *data;
+	uint16_t len;
+};
+
+/**
+ * struct dp_sim - simulator instance
+ * @osdev: QDF device
+ * @hal_soc: host only HAL instance
+ * @arch_ops: descriptor handling of the simulated target
+ * @soc: data path soc driving the simulated rings
+ * @pdev: pdev of @soc
+ * @vdev: STA vdev of @pdev
+ * @peer: authorized peer of @vdev, the source and destination of all frames
+ * @int_ctx: interrupt context the handlers run in
+ * @refill_ring: RXDMA refill ring, host to target
+ * @reo_dst_ring: REO destination ring, target to host
+ * @tcl_ring: TCL data ring, host to target
+ * @comp_ring: WBM completion ring, target to host
+ * @tx_pool_created: the TX descriptor pool is allocated
+ * @pcap: copy of the loaded capture
+ * @frames: frames of @pcap
+ * @num_frames: number of entries in @frames
+ * @tx_frame: next frame the host transmits
+ * @rx_credits: frames the target still delivers in the current run
+ * @target_frame: next frame the target delivers
+ * @target_rx_starved: see &struct dp_sim_result
+ * @target_ring_full: see &struct dp_sim_result
+ * @stale: a run timed out and rings may hold stale entries
+ * @res: results of the current run
+ */
+struct dp_sim {
+	qdf_device_t osdev;
+	hal_soc_handle_t hal_soc;
+	struct dp_sim_arch_ops arch_ops;
+	struct dp_soc *soc;
+	struct dp_pdev *pdev;
+	struct dp_vdev *vdev;
+	struct dp_peer *peer;
+	struct dp_intr int_ctx;
+	struct dp_sim_ring refill_ring;
+	struct dp_sim_ring reo_dst_ring;
+	struct dp_sim_ring tcl_ring;
+	struct dp_sim_ring comp_ring;
+	bool tx_pool_created;
+	uint8_t *pcap;
+	struct dp_sim_frame *frames;
+	uint32_t num_frames;
+	uint32_t tx_frame;
+	qdf_atomic_t rx_credits;
+	uint32_t target_frame;
+	uint32_t target_rx_starved;
+	uint32_t target_ring_full;
+	bool stale;
+	struct dp_sim_result res;
+};
+
+static uint32_t dp_sim_default_target_type(void)
+{
+#if defined(QCA_WIFI_QCA6490)
+	return TARGET_TYPE_QCA6490;
+#elif defined(QCA_WIFI_QCA6390)
+	return TARGET_TYPE_QCA6390;
+#elif defined(QCA_WIFI_QCA6750)
+	return TARGET_TYPE_QCA6750;
+#elif defined(QCA_WIFI_QCA6290)
+	return TARGET_TYPE_QCA6290;
+#else
+	return 0;
+#endif
+}
+
+static QDF_STATUS dp_sim_arch_ops_attach(struct dp_sim *sim,
+					 uint32_t target_type,
+					 uint16_t *device_id)
+{
+	switch (target_type) {
+#ifdef CONFIG_LITHIUM
+	case TARGET_TYPE_QCA6290:
+	case TARGET_TYPE_QCA6390:
+	case TARGET_TYPE_QCA6490:
+	case TARGET_TYPE_QCA6750:
+		dp_sim_arch_ops_attach_li(&sim->arch_ops);
+		*device_id = LITHIUM_DP;
+		return QDF_STATUS_SUCCESS;
+#endif
+	default:
+		dp_err("target type %u not supported", target_type);
+		return QDF_STATUS_E_NOSUPPORT;
+	}
+}
+
+static QDF_STATUS dp_sim_ring_setup(struct dp_sim *sim,
+				    struct dp_sim_ring *ring,
+				    struct dp_srng *srng, int ring_type,
+				    uint32_t num_entries)
+{
+	struct hal_srng_params ring_params = { 0 };
+	uint32_t entry_size;
+
+	entry_size = hal_srng_get_entrysize(sim->hal_soc, ring_type);
+	num_entries = qdf_min(num_entries,
+			      hal_srng_max_entries(sim->hal_soc, ring_type));
+
+	ring_params.ring_base_vaddr = qdf_mem_malloc(entry_size * num_entries);
+	if (!ring_params.ring_base_vaddr)
+		return QDF_STATUS_E_NOMEM;
+
+	ring_params.num_entries = num_entries;
+	srng->hal_srng = hal_srng_setup(sim->hal_soc, ring_type, 0, 0,
+					&ring_params);
+	if (!srng->hal_srng) {
+		qdf_mem_free(ring_params.ring_base_vaddr);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	srng->base_vaddr_unaligned = ring_params.ring_base_vaddr;
+	srng->base_vaddr_aligned = ring_params.ring_base_vaddr;
+	srng->alloc_size = entry_size * num_entries;
+	srng->num_entries = num_entries;
+
+	ring->srng = srng;
+	ring->entry_size = entry_size >> 2;
+	ring->ring_size = ring->entry_size * num_entries;
+	ring->target_ptr = 0;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void dp_sim_ring_cleanup(struct dp_sim *sim, struct dp_sim_ring *ring)
+{
+	struct dp_srng *srng = ring->srng;
+
+	if (!srng)
+		return;
+
+	hal_srng_cleanup(sim->hal_soc, srng->hal_srng);
+	qdf_mem_free(srng->base_vaddr_unaligned);
+	qdf_mem_zero(srng, sizeof(*srng));
+	ring->srng = NULL;
+}
+
+static inline uint32_t dp_sim_ring_entries(struct dp_sim_ring *ring)
+{
+	return ring->ring_size / ring->entry_size;
+}
+
+/*
+ * Target side of the rings. The target owns the tail pointer of the rings
+ * the host produces to and the head pointer of the rings the host consumes
+ * from; the host copies of both live in the HAL shadow pointer memory.
+ */
+static inline uint32_t dp_sim_target_peer_ptr(struct dp_sim_ring *ring)
+{
+	struct hal_srng *srng = (struct hal_srng *)ring->srng->hal_srng;
+
+	if (srng->ring_dir == HAL_SRNG_SRC_RING)
+		return *(volatile uint32_t *)srng->u.src_ring.hp_addr;
+
+	return *(volatile uint32_t *)srng->u.dst_ring.tp_addr;
+}
+
+static inline void dp_sim_target_publish(struct dp_sim_ring *ring)
+{
+	struct hal_srng *srng = (struct hal_srng *)ring->srng->hal_srng;
+
+	if (srng->ring_dir == HAL_SRNG_SRC_RING)
+		*(volatile uint32_t *)srng->u.src_ring.tp_addr =
+			ring->target_ptr;
+	else
+		*(volatile uint32_t *)srng->u.dst_ring.hp_addr =
+			ring->target_ptr;
+}
+
+static inline uint32_t *dp_sim_target_entry(struct dp_sim_ring *ring)
+{
+	struct hal_srng *srng = (struct hal_srng *)ring->srng->hal_srng;
+
+	return &srng->ring_base_vaddr[ring->target_ptr];
+}
+
+static inline void dp_sim_target_advance(struct dp_sim_ring *ring)
+{
+	ring->target_ptr = (ring->target_ptr + ring->entry_size) %
+				ring->ring_size;
+}
+
+static inline bool dp_sim_target_dst_full(struct dp_sim_ring *ring,
+					  uint32_t host_tp)
+{
+	return ((ring->target_ptr + ring->entry_size) % ring->ring_size) ==
+		host_tp;
+}
+
+/* DMA of the RX TLVs and the frame into a refill buffer */
+static void dp_sim_target_rx_dma(struct dp_sim *sim, qdf_nbuf_t nbuf,
+				 struct dp_sim_frame *frame)
+{
+	uint16_t tlv_size = sim->soc->rx_pkt_tlv_size;
+	uint8_t *rx_tlv = qdf_nbuf_data(nbuf);
+
+	qdf_mem_zero(rx_tlv, tlv_size);
+	sim->arch_ops.rx_tlv_fill(rx_tlv);
+	qdf_mem_copy(rx_tlv + tlv_size, frame->data, frame->len);
+
+	/*
+	 * The host unmaps the buffer for the device to CPU direction, which
+	 * invalidates the cache on non coherent platforms; write the CPU
+	 * copy back first, as the DMA engine would have written memory.
+	 */
+	qdf_mem_dma_sync_single_for_device(sim->osdev,
+					   qdf_nbuf_get_frag_paddr(nbuf, 0),
+					   tlv_size + frame->len,
+					   DMA_TO_DEVICE);
+}
+
+static uint32_t dp_sim_target_rx(struct dp_sim *sim)
+{
+	struct dp_sim_ring *refill = &sim->refill_ring;
+	struct dp_sim_ring *reo_dst = &sim->reo_dst_ring;
+	struct hal_buf_info buf_info;
+	struct dp_rx_desc *rx_desc;
+	struct dp_sim_frame *frame;
+	uint32_t refill_hp, reo_tp;
+	uint32_t *buf_entry, *reo_entry;
+	uint32_t work = 0;
+
+	if (qdf_atomic_read(&sim->rx_credits) <= 0)
+		return 0;
+
+	refill_hp = dp_sim_target_peer_ptr(refill);
+	reo_tp = dp_sim_target_peer_ptr(reo_dst);
+	/* the entries up to the pointers read above are valid */
+	qdf_rmb();
+
+	while (work < DP_SIM_TARGET_BATCH &&
+	       qdf_atomic_read(&sim->rx_credits) > 0) {
+		if (refill->target_ptr == refill_hp) {
+			sim->target_rx_starved++;
+			break;
+		}
+
+		if (dp_sim_target_dst_full(reo_dst, reo_tp)) {
+			sim->target_ring_full++;
+			break;
+		}
+
+		/* the buffer posted by dp_rx_buffers_replenish() */
+		buf_entry = dp_sim_target_entry(refill);
+		hal_rx_buf_cookie_rbm_get(sim->hal_soc, buf_entry, &buf_info);
+		rx_desc = dp_rx_cookie_2_va_rxdma_buf(sim->soc,
+						      buf_info.sw_cookie);
+		if (qdf_unlikely(!rx_desc || !rx_desc->nbuf)) {
+			dp_err("bad refill cookie 0x%x", buf_info.sw_cookie);
+			dp_sim_target_advance(refill);
+			continue;
+		}
+
+		frame = &sim->frames[sim->target_frame];
+		if (++sim->target_frame == sim->num_frames)
+			sim->target_frame = 0;
+		dp_sim_target_rx_dma(sim, rx_desc->nbuf, frame);
+
+		reo_entry = dp_sim_target_entry(reo_dst);
+		qdf_mem_zero(reo_entry, reo_dst->entry_size << 2);
+		sim->arch_ops.rx_desc_fill(reo_entry, buf_entry, frame->len,
+					   DP_SIM_PEER_ID, DP_SIM_VDEV_ID);
+
+		dp_sim_target_advance(refill);
+		dp_sim_target_advance(reo_dst);
+		qdf_atomic_dec(&sim->rx_credits);
+		work++;
+	}
+
+	if (work) {
+		/* entries are written before the host sees the pointers */
+		qdf_mb();
+		dp_sim_target_publish(refill);
+		dp_sim_target_publish(reo_dst);
+	}
+
+	return work;
+}
+
+static uint32_t dp_sim_target_tx(struct dp_sim *sim)
+{
+	struct dp_sim_ring *tcl = &sim->tcl_ring;
+	struct dp_sim_ring *comp = &sim->comp_ring;
+	uint32_t tcl_hp, comp_tp;
+	uint32_t *comp_entry;
+	uint32_t work = 0;
+
+	tcl_hp = dp_sim_target_peer_ptr(tcl);
+	comp_tp = dp_sim_target_peer_ptr(comp);
+	qdf_rmb();
+
+	while (work < DP_SIM_TARGET_BATCH && tcl->target_ptr != tcl_hp) {
+		if (dp_sim_target_dst_full(comp, comp_tp)) {
+			sim->target_ring_full++;
+			break;
+		}
+
+		comp_entry = dp_sim_target_entry(comp);
+		qdf_mem_zero(comp_entry, comp->entry_size << 2);
+		sim->arch_ops.tx_comp_fill(comp_entry,
+					   dp_sim_target_entry(tcl),
+					   DP_SIM_PEER_ID);
+
+		dp_sim_target_advance(tcl);
+		dp_sim_target_advance(comp);
+		work++;
+	}
+
+	if (work) {
+		qdf_mb();
+		dp_sim_target_publish(tcl);
+		dp_sim_target_publish(comp);
+	}
+
+	return work;
+}
+
+static QDF_STATUS dp_sim_target_thread(void *context)
+{
+	struct dp_sim *sim = context;
+	uint32_t work;
+
+	while (!qdf_thread_should_stop()) {
+		work = dp_sim_target_rx(sim);
+		work += dp_sim_target_tx(sim);
+		if (!work)
+			qdf_sleep_us(DP_SIM_TARGET_IDLE_US);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/* stands in for the stack: count and drop */
+static QDF_STATUS dp_sim_osif_rx(void *osif_vdev, qdf_nbuf_t nbuf_list)
+{
+	struct dp_sim *sim = osif_vdev;
+	qdf_nbuf_t nbuf, next;
+
+	nbuf = nbuf_list;
+	while (nbuf) {
+		next = qdf_nbuf_next(nbuf);
+		sim->res.rx_pkts++;
+		sim->res.rx_bytes += qdf_nbuf_len(nbuf);
+		qdf_nbuf_free(nbuf);
+		nbuf = next;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/* frames are copied outside of the timed section, as the stack would */
+static qdf_nbuf_t dp_sim_tx_frame_alloc(struct dp_sim *sim)
+{
+	struct dp_sim_frame *frame = &sim->frames[sim->tx_frame];
+	qdf_nbuf_t nbuf;
+
+	nbuf = qdf_nbuf_alloc(sim->osdev, frame->len, 0, 4, false);
+	if (!nbuf)
+		return NULL;
+
+	if (++sim->tx_frame == sim->num_frames)
+		sim->tx_frame = 0;
+
+	qdf_nbuf_put_tail(nbuf, frame->len);
+	qdf_mem_copy(qdf_nbuf_data(nbuf), frame->data, frame->len);
+
+	return nbuf;
+}
+
+static inline uint32_t dp_sim_pcap_u32(const uint8_t *p, bool swapped)
+{
+	if (swapped)
+		return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+
+	return (p[3] << 24) | (p[2] << 16) | (p[1] << 8) | p[0];
+}
+
+QDF_STATUS dp_sim_load_pcap(struct dp_sim *sim, const uint8_t *data,
+			    qdf_size_t len)
+{
+	uint32_t max_len = RX_DATA_BUFFER_SIZE - sim->soc->rx_pkt_tlv_size;
+	struct dp_sim_frame *frames;
+	uint32_t num_frames = 0;
+	uint32_t skipped = 0;
+	uint32_t magic, incl_len;
+	qdf_size_t off;
+	bool swapped;
+	uint8_t *pcap;
+
+	if (len < DP_SIM_PCAP_HDR_LEN)
+		return QDF_STATUS_E_INVAL;
+
+	magic = dp_sim_pcap_u32(data, false);
+	switch (magic) {
+	case DP_SIM_PCAP_MAGIC:
+	case DP_SIM_PCAP_MAGIC_NS:
+		swapped = false;
+		break;
+	case DP_SIM_PCAP_MAGIC_SWAPPED:
+	case DP_SIM_PCAP_MAGIC_NS_SWAPPED:
+		swapped = true;
+		break;
+	default:
+		dp_err("not a pcap file, magic 0x%x", magic);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	if (dp_sim_pcap_u32(data + DP_SIM_PCAP_LINKTYPE_OFFSET, swapped) !=
+	    DP_SIM_PCAP_LINKTYPE_ETHERNET) {
+		dp_err("pcap link type is not ethernet");
+		return QDF_STATUS_E_NOSUPPORT;
+	}
+
+	pcap = qdf_mem_malloc(len);
+	if (!pcap)
+		return QDF_STATUS_E_NOMEM;
+
+	/* every record is at least a record header */
+	frames = qdf_mem_malloc(sizeof(*frames) *
+				((len - DP_SIM_PCAP_HDR_LEN) /
+				 DP_SIM_PCAP_REC_HDR_LEN + 1));
+	if (!frames) {
+		qdf_mem_free(pcap);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	qdf_mem_copy(pcap, data, len);
+	off = DP_SIM_PCAP_HDR_LEN;
+	while (off + DP_SIM_PCAP_REC_HDR_LEN <= len) {
+		incl_len = dp_sim_pcap_u32(pcap + off +
+					   DP_SIM_PCAP_INCL_LEN_OFFSET,
+					   swapped);
+		off += DP_SIM_PCAP_REC_HDR_LEN;
+		if (incl_len > len - off) {
+			dp_err("truncated pcap record at %zu", off);
+			break;
+		}
+
+		if (incl_len < DP_SIM_MIN_FRAME_LEN || incl_len > max_len) {
+			skipped++;
+		} else {
+			frames[num_frames].data = pcap + off;
+			frames[num_frames].len = incl_len;
+			num_frames++;
+		}
+		off += incl_len;
+	}
+
+	if (!num_frames) {
+		dp_err("no usable frame in pcap, %u skipped", skipped);
+		qdf_mem_free(frames);
+		qdf_mem_free(pcap);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	qdf_mem_free(sim->frames);
+	qdf_mem_free(sim->pcap);
+	sim->pcap = pcap;
+	sim->frames = frames;
+	sim->num_frames = num_frames;
+	sim->target_frame = 0;
+
+	dp_info("loaded %u frames, %u skipped", num_frames, skipped);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+qdf_export_symbol(dp_sim_load_pcap);
+
+static void dp_sim_result_calc(struct dp_sim_result *res, uint64_t rx_ns,
+			       uint64_t rx_cycles, uint64_t tx_ns,
+			       uint64_t tx_cycles)
+{
+	uint64_t elapsed_us = res->elapsed_us ? res->elapsed_us : 1;
+
+	res->rx_pps = qdf_do_div(res->rx_pkts * 1000000, elapsed_us);
+	res->tx_pps = qdf_do_div(res->tx_comp * 1000000, elapsed_us);
+
+	if (res->rx_pkts) {
+		res->rx_ns_per_pkt = qdf_do_div(rx_ns, res->rx_pkts);
+		res->rx_cycles_per_pkt = qdf_do_div(rx_cycles, res->rx_pkts);
+	}
+
+	if (res->tx_comp) {
+		res->tx_ns_per_pkt = qdf_do_div(tx_ns, res->tx_comp);
+		res->tx_cycles_per_pkt = qdf_do_div(tx_cycles, res->tx_comp);
+	}
+}
+
+static uint32_t dp_sim_tx_send(struct dp_sim *sim, qdf_nbuf_t *nbufs,
+			       uint32_t num, uint64_t *ns, uint64_t *cycles)
+{
+	struct cdp_soc_t *cdp_soc = dp_soc_to_cdp_soc_t(sim->soc);
+	uint64_t start_ns, start_cycles;
+	uint32_t i;
+
+	start_ns = qdf_sched_clock();
+	start_cycles = qdf_get_cycles();
+	for (i = 0; i < num; i++)
+		nbufs[i] = dp_tx_send(cdp_soc, DP_SIM_VDEV_ID, nbufs[i]);
+	*cycles += qdf_get_cycles() - start_cycles;
+	*ns += qdf_sched_clock() - start_ns;
+
+	/* a frame returned by dp_tx_send() was not queued */
+	for (i = 0; i < num; i++) {
+		if (qdf_unlikely(nbufs[i])) {
+			sim->res.tx_err++;
+			qdf_nbuf_free(nbufs[i]);
+		} else {
+			sim->res.tx_pkts++;
+		}
+	}
+
+	return num;
+}
+
+QDF_STATUS dp_sim_run(struct dp_sim *sim, struct dp_sim_params *params,
+		      struct dp_sim_result *result)
+{
+	uint64_t rx_ns = 0, rx_cycles = 0, tx_ns = 0, tx_cycles = 0;
+	uint64_t start_ns, ns, cycles, rx_reaped = 0;
+	uint32_t quota, done, budget, outstanding, max_outstanding, i;
+	uint32_t tcl_ring_full, alloc_fail;
+	struct dp_soc *soc = sim->soc;
+	struct dp_pdev *pdev = sim->pdev;
+	hal_ring_handle_t reo_ring = soc->reo_dest_ring[0].hal_srng;
+	hal_ring_handle_t comp_ring = soc->tx_comp_ring[0].hal_srng;
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	qdf_nbuf_t *tx_nbufs = NULL;
+	qdf_thread_t *target;
+	qdf_time_t deadline;
+
+	if (sim->stale)
+		return QDF_STATUS_E_FAULT;
+
+	if (!sim->num_frames || !params->num_pkts ||
+	    (!params->rx && !params->tx))
+		return QDF_STATUS_E_INVAL;
+
+	quota = params->quota ? params->quota : DP_SIM_DEF_QUOTA;
+	qdf_mem_zero(&sim->res, sizeof(sim->res));
+	sim->target_rx_starved = 0;
+	sim->target_ring_full = 0;
+	sim->tx_frame = 0;
+	tcl_ring_full = soc->stats.tx.tcl_ring_full[0];
+	alloc_fail = pdev->stats.replenish.nbuf_alloc_fail;
+
+	/* completions are reaped before the TCL ring can fill up */
+	max_outstanding = qdf_min(dp_sim_ring_entries(&sim->tcl_ring),
+				  dp_sim_ring_entries(&sim->comp_ring)) - 1;
+
+	if (params->tx) {
+		tx_nbufs = qdf_mem_malloc(sizeof(*tx_nbufs) * quota);
+		if (!tx_nbufs)
+			return QDF_STATUS_E_NOMEM;
+	}
+
+	if (params->rx)
+		qdf_atomic_set(&sim->rx_credits, params->num_pkts);
+
+	target = qdf_thread_run(dp_sim_target_thread, sim);
+	if (!target) {
+		qdf_atomic_set(&sim->rx_credits, 0);
+		qdf_mem_free(tx_nbufs);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	deadline = qdf_system_ticks() +
+		qdf_system_msecs_to_ticks(DP_SIM_RUN_TIMEOUT_MS);
+	start_ns = qdf_sched_clock();
+	while ((params->rx && rx_reaped < params->num_pkts) ||
+	       (params->tx && sim->res.tx_comp + sim->res.tx_err <
+				params->num_pkts)) {
+		done = 0;
+
+		if (params->rx) {
+			ns = qdf_sched_clock();
+			cycles = qdf_get_cycles();
+			done += soc->arch_ops.dp_rx_process(&sim->int_ctx,
+							    reo_ring, 0, quota);
+			rx_cycles += qdf_get_cycles() - cycles;
+			rx_ns += qdf_sched_clock() - ns;
+			rx_reaped += done;
+		}
+
+		if (params->tx) {
+			outstanding =
+				qdf_atomic_read(&pdev->num_tx_outstanding);
+			budget = params->num_pkts - sim->res.tx_pkts -
+				 sim->res.tx_err;
+			budget = qdf_min(budget, quota);
+			if (outstanding >= max_outstanding)
+				budget = 0;
+			else
+				budget = qdf_min(budget,
+						 max_outstanding - outstanding);
+			for (i = 0; i < budget; i++) {
+				tx_nbufs[i] = dp_sim_tx_frame_alloc(sim);
+				if (!tx_nbufs[i])
+					break;
+			}
+			done += dp_sim_tx_send(sim, tx_nbufs, i, &tx_ns,
+					       &tx_cycles);
+
+			ns = qdf_sched_clock();
+			cycles = qdf_get_cycles();
+			done += dp_tx_comp_handler(&sim->int_ctx, soc,
+						   comp_ring, 0, quota);
+			tx_cycles += qdf_get_cycles() - cycles;
+			tx_ns += qdf_sched_clock() - ns;
+			sim->res.tx_comp = sim->res.tx_pkts -
+				qdf_atomic_read(&pdev->num_tx_outstanding);
+		}
+
+		if (done)
+			continue;
+
+		if (qdf_system_time_after(qdf_system_ticks(), deadline)) {
+			dp_err("run timed out, rx %llu tx %llu/%llu",
+			       rx_reaped, sim->res.tx_pkts,
+			       sim->res.tx_comp);
+			status = QDF_STATUS_E_TIMEOUT;
+			break;
+		}
+
+		qdf_sleep_us(DP_SIM_HOST_IDLE_US);
+	}
+	sim->res.elapsed_us = qdf_do_div(qdf_sched_clock() - start_ns, 1000);
+
+	qdf_atomic_set(&sim->rx_credits, 0);
+	qdf_thread_join(target);
+	qdf_mem_free(tx_nbufs);
+
+	if (QDF_IS_STATUS_ERROR(status))
+		sim->stale = true;
+
+	sim->res.rx_err = rx_reaped - sim->res.rx_pkts;
+	sim->res.rx_alloc_fail = pdev->stats.replenish.nbuf_alloc_fail -
+				 alloc_fail;
+	sim->res.tx_ring_full = soc->stats.tx.tcl_ring_full[0] -
+				tcl_ring_full;
+	sim->res.target_rx_starved = sim->target_rx_starved;
+	sim->res.target_ring_full = sim->target_ring_full;
+	dp_sim_result_calc(&sim->res, rx_ns, rx_cycles, tx_ns, tx_cycles);
+	*result = sim->res;
+
+	return status;
+}
+
+qdf_export_symbol(dp_sim_run);
+
+static void dp_sim_rings_cleanup(struct dp_sim *sim)
+{
+	dp_sim_ring_cleanup(sim, &sim->comp_ring);
+	dp_sim_ring_cleanup(sim, &sim->tcl_ring);
+	dp_sim_ring_cleanup(sim, &sim->reo_dst_ring);
+	dp_sim_ring_cleanup(sim, &sim->refill_ring);
+}
+
+static QDF_STATUS dp_sim_rings_setup(struct dp_sim *sim, uint32_t ring_size)
+{
+	struct dp_soc *soc = sim->soc;
+
+	if (QDF_IS_STATUS_ERROR(dp_sim_ring_setup(sim, &sim->refill_ring,
+						  &soc->rx_refill_buf_ring[0],
+						  RXDMA_BUF, ring_size)) ||
+	    QDF_IS_STATUS_ERROR(dp_sim_ring_setup(sim, &sim->reo_dst_ring,
+						  &soc->reo_dest_ring[0],
+						  REO_DST, ring_size)) ||
+	    QDF_IS_STATUS_ERROR(dp_sim_ring_setup(sim, &sim->tcl_ring,
+						  &soc->tcl_data_ring[0],
+						  TCL_DATA, ring_size)) ||
+	    QDF_IS_STATUS_ERROR(dp_sim_ring_setup(sim, &sim->comp_ring,
+						  &soc->tx_comp_ring[0],
+						  WBM2SW_RELEASE, ring_size))) {
+		dp_sim_rings_cleanup(sim);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	soc->num_reo_dest_rings = 1;
+	soc->num_tcl_data_rings = 1;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+#ifdef QCA_LL_TX_FLOW_CONTROL_V2
+/* the flow pool of the vdev, as mapped by dp_tx_flow_pool_map() */
+static QDF_STATUS dp_sim_tx_pool_create(struct dp_soc *soc, uint16_t num)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[DP_SIM_VDEV_ID];
+
+	dp_tx_flow_control_init(soc);
+	qdf_spinlock_create(&pool->flow_pool_lock);
+	pool->status = FLOW_POOL_INACTIVE;
+
+	if (!dp_tx_create_flow_pool(soc, DP_SIM_VDEV_ID, num)) {
+		qdf_spinlock_destroy(&pool->flow_pool_lock);
+		dp_tx_flow_control_deinit(soc);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void dp_sim_tx_pool_delete(struct dp_soc *soc)
+{
+	dp_tx_flow_control_deinit(soc);
+	qdf_spinlock_destroy(&soc->tx_desc[DP_SIM_VDEV_ID].flow_pool_lock);
+}
+#else
+static QDF_STATUS dp_sim_tx_pool_create(struct dp_soc *soc, uint16_t num)
+{
+	if (QDF_IS_STATUS_ERROR(dp_tx_desc_pool_alloc(soc, 0, num)))
+		return QDF_STATUS_E_NOMEM;
+
+	if (QDF_IS_STATUS_ERROR(dp_tx_desc_pool_init(soc, 0, num))) {
+		dp_tx_desc_pool_free(soc, 0);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void dp_sim_tx_pool_delete(struct dp_soc *soc)
+{
+	dp_tx_desc_pool_deinit(soc, 0);
+	dp_tx_desc_pool_free(soc, 0);
+}
+#endif
+
+static void dp_sim_pools_free(struct dp_sim *sim)
+{
+	struct dp_pdev *pdev = sim->pdev;
+
+	if (sim->tx_pool_created) {
+		/* descriptors left by a timed out run */
+		dp_tx_desc_flush(pdev, NULL, true);
+		dp_sim_tx_pool_delete(sim->soc);
+		sim->tx_pool_created = false;
+	}
+
+	dp_rx_pdev_buffers_free(pdev);
+	dp_rx_pdev_desc_pool_deinit(pdev);
+	dp_rx_pdev_desc_pool_free(pdev);
+}
+
+static QDF_STATUS dp_sim_pools_alloc(struct dp_sim *sim)
+{
+	struct dp_pdev *pdev = sim->pdev;
+	struct dp_soc *soc = sim->soc;
+
+	if (QDF_IS_STATUS_ERROR(dp_rx_pdev_desc_pool_alloc(pdev)))
+		return QDF_STATUS_E_NOMEM;
+
+	if (QDF_IS_STATUS_ERROR(dp_rx_pdev_desc_pool_init(pdev))) {
+		dp_rx_pdev_desc_pool_free(pdev);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	/* fills the refill ring, as at pdev init */
+	if (QDF_IS_STATUS_ERROR(dp_rx_pdev_buffers_alloc(pdev)))
+		goto fail;
+
+	if (QDF_IS_STATUS_ERROR(dp_sim_tx_pool_create(soc,
+			wlan_cfg_get_num_tx_desc(soc->wlan_cfg_ctx))))
+		goto fail;
+	sim->tx_pool_created = true;
+
+	return QDF_STATUS_SUCCESS;
+
+fail:
+	dp_sim_pools_free(sim);
+	return QDF_STATUS_E_NOMEM;
+}
+
+static void dp_sim_objs_free(struct dp_sim *sim)
+{
+	struct dp_soc *soc = sim->soc;
+
+	if (soc->wlan_cfg_ctx)
+		wlan_cfg_soc_detach(soc->wlan_cfg_ctx);
+	if (sim->pdev && sim->pdev->wlan_cfg_ctx)
+		wlan_cfg_pdev_detach(sim->pdev->wlan_cfg_ctx);
+
+	qdf_spinlock_destroy(&soc->vdev_map_lock);
+	qdf_spinlock_destroy(&soc->peer_map_lock);
+	qdf_mem_free(soc->peer_id_to_obj_map);
+	qdf_mem_free(sim->peer);
+	qdf_mem_free(sim->vdev);
+	qdf_mem_free(sim->pdev);
+	qdf_mem_free(soc);
+	sim->soc = NULL;
+}
+
+/*
+ * The objects are set up the way dp_soc_attach(), dp_pdev_attach_wifi3(),
+ * dp_vdev_attach_wifi3() and dp_peer_create_wifi3() leave them, for the
+ * parts used by the RX and TX fast paths only; the vdev and the peer hold
+ * a reference until detach so that the data path never deletes them.
+ */
+static QDF_STATUS dp_sim_objs_alloc(struct dp_sim *sim, uint16_t device_id,
+				    struct hif_opaque_softc *hif_handle,
+				    struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
+{
+	struct cdp_soc_attach_params params = { 0 };
+	uint16_t rx_mon_tlv_size;
+	struct dp_soc *soc;
+	struct dp_pdev *pdev;
+	struct dp_vdev *vdev;
+	struct dp_peer *peer;
+
+	soc = qdf_mem_malloc(dp_get_soc_context_size(device_id));
+	if (!soc)
+		return QDF_STATUS_E_NOMEM;
+
+	sim->soc = soc;
+	soc->device_id = device_id;
+	soc->arch_id = cdp_get_arch_type_from_devid(device_id);
+	soc->osdev = sim->osdev;
+	soc->hif_handle = hif_handle;
+	soc->hal_soc = sim->hal_soc;
+	soc->ctrl_psoc = ctrl_psoc;
+	qdf_spinlock_create(&soc->peer_map_lock);
+	qdf_spinlock_create(&soc->vdev_map_lock);
+	qdf_atomic_init(&soc->num_tx_outstanding);
+	dp_configure_arch_ops(soc);
+
+	soc->wlan_cfg_ctx = wlan_cfg_soc_attach(ctrl_psoc);
+	soc->peer_id_to_obj_map = qdf_mem_malloc(DP_SIM_MAX_PEER_ID *
+						 sizeof(struct dp_peer *));
+	sim->pdev = qdf_mem_malloc(soc->arch_ops.txrx_get_context_size(
+						DP_CONTEXT_TYPE_PDEV));
+	sim->vdev = qdf_mem_malloc(soc->arch_ops.txrx_get_context_size(
+						DP_CONTEXT_TYPE_VDEV));
+	sim->peer = qdf_mem_malloc(soc->arch_ops.txrx_get_context_size(
+						DP_CONTEXT_TYPE_PEER));
+	if (!soc->wlan_cfg_ctx || !soc->peer_id_to_obj_map || !sim->pdev ||
+	    !sim->vdev || !sim->peer)
+		return QDF_STATUS_E_NOMEM;
+
+	hal_rx_get_tlv_size(soc->hal_soc, &soc->rx_pkt_tlv_size,
+			    &rx_mon_tlv_size);
+	soc->num_tx_allowed =
+		wlan_cfg_get_dp_soc_tx_device_limit(soc->wlan_cfg_ctx);
+	soc->max_peer_id = DP_SIM_MAX_PEER_ID;
+
+	pdev = sim->pdev;
+	pdev->soc = soc;
+	pdev->pdev_id = 0;
+	pdev->lmac_id = 0;
+	pdev->wlan_cfg_ctx = wlan_cfg_pdev_attach(ctrl_psoc);
+	if (!pdev->wlan_cfg_ctx)
+		return QDF_STATUS_E_NOMEM;
+	pdev->num_tx_allowed = wlan_cfg_get_num_tx_desc(soc->wlan_cfg_ctx);
+	dp_tx_pdev_init(pdev);
+	soc->pdev_list[0] = pdev;
+	soc->pdev_count = 1;
+
+	vdev = sim->vdev;
+	vdev->pdev = pdev;
+	vdev->vdev_id = DP_SIM_VDEV_ID;
+	vdev->lmac_id = pdev->lmac_id;
+	vdev->osdev = sim->osdev;
+	vdev->opmode = wlan_op_mode_sta;
+	vdev->tx_encap_type = htt_cmn_pkt_type_ethernet;
+	vdev->rx_decap_type = htt_cmn_pkt_type_ethernet;
+	vdev->osif_vdev = (ol_osif_vdev_handle)sim;
+	vdev->osif_rx = dp_sim_osif_rx;
+	qdf_atomic_init(&vdev->ref_cnt);
+	qdf_atomic_inc(&vdev->ref_cnt);
+	soc->vdev_id_map[DP_SIM_VDEV_ID] = vdev;
+
+	peer = sim->peer;
+	peer->vdev = vdev;
+	peer->peer_id = DP_SIM_PEER_ID;
+	peer->authorize = 1;
+	peer->peer_state = DP_PEER_STATE_ACTIVE;
+	qdf_atomic_init(&peer->ref_cnt);
+	qdf_atomic_inc(&peer->ref_cnt);
+	soc->peer_id_to_obj_map[DP_SIM_PEER_ID] = peer;
+
+	/* ring events are recorded in the history of interrupt context 0 */
+	sim->int_ctx.soc = soc;
+	sim->int_ctx.dp_intr_id = 0;
+
+	params.hif_handle = hif_handle;
+	params.qdf_osdev = sim->osdev;
+	params.device_id = device_id;
+
+	return soc->arch_ops.txrx_soc_attach(soc, &params);
+}
+
+struct dp_sim *dp_sim_attach(qdf_device_t osdev,
+			     struct hif_opaque_softc *hif_handle,
+			     struct cdp_ctrl_objmgr_psoc *ctrl_psoc,
+			     uint32_t target_type, uint32_t ring_size)
+{
+	struct dp_sim *sim;
+	uint16_t device_id;
+
+	if (!osdev || !hif_handle) {
+		dp_err("a loaded driver is required");
+		return NULL;
+	}
+
+	if (!target_type)
+		target_type = dp_sim_default_target_type();
+
+	sim = qdf_mem_malloc(sizeof(*sim));
+	if (!sim)
+		return NULL;
+
+	sim->osdev = osdev;
+	if (QDF_IS_STATUS_ERROR(dp_sim_arch_ops_attach(sim, target_type,
+						       &device_id)))
+		goto fail0;
+
+	sim->hal_soc = hal_sim_attach(osdev, target_type);
+	if (!sim->hal_soc)
+		goto fail0;
+
+	if (QDF_IS_STATUS_ERROR(dp_sim_objs_alloc(sim, device_id, hif_handle,
+						  ctrl_psoc)))
+		goto fail1;
+
+	if (QDF_IS_STATUS_ERROR(dp_sim_rings_setup(sim, ring_size ? ring_size :
+						   DP_SIM_DEF_RING_SIZE)))
+		goto fail2;
+
+	if (QDF_IS_STATUS_ERROR(dp_sim_pools_alloc(sim)))
+		goto fail3;
+
+	return sim;
+
+fail3:
+	dp_sim_rings_cleanup(sim);
+fail2:
+	sim->soc->arch_ops.txrx_soc_detach(sim->soc);
+fail1:
+	if (sim->soc)
+		dp_sim_objs_free(sim);
+	hal_sim_detach(sim->hal_soc);
+fail0:
+	qdf_mem_free(sim);
+	return NULL;
+}
+
+qdf_export_symbol(dp_sim_attach);
+
+void dp_sim_detach(struct dp_sim *sim)
+{
+	if (!sim)
+		return;
+
+	dp_sim_pools_free(sim);
+	dp_sim_rings_cleanup(sim);
+	sim->soc->arch_ops.txrx_soc_detach(sim->soc);
+	dp_sim_objs_free(sim);
+	hal_sim_detach(sim->hal_soc);
+	qdf_mem_free(sim->frames);
+	qdf_mem_free(sim->pcap);
+	qdf_mem_free(sim);
+}
+
+qdf_export_symbol(dp_sim_detach);
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: dp_sim.h
+ *
+ * Host only data path simulator.
+ *
+ * The simulator sets up RXDMA refill, REO destination, TCL data and WBM
+ * completion rings on a host only HAL instance (see hal_sim_attach()) and
+ * runs a simulated target in a kernel thread which services them:
+ * - every refill buffer posted by the host is filled with the next frame of
+ *   a capture and handed back through the REO destination ring
+ * - every TCL descriptor posted by the host is completed through the WBM
+ *   completion ring as acked by TQM
+ *
+ * The host side is the regular data path: the simulator attaches a minimal
+ * Lithium soc with one pdev, a STA vdev and an authorized peer, backed by
+ * the real RX and TX descriptor pools and the wlan_cfg defaults, and times
+ * dp_rx_process_li(), dp_tx_send() and dp_tx_comp_handler() against the
+ * simulated rings. Received frames are handed to a vdev osif_rx callback
+ * which counts and frees them, in place of the stack.
+ *
+ * The handlers record ring events in the history of interrupt context 0
+ * and take runtime PM references on the HIF handle passed at attach, so
+ * the simulator runs on a loaded driver; it does not touch its rings.
+ */
+
+#ifndef _DP_SIM_H_
+#define _DP_SIM_H_
+
+#include <qdf_types.h>
+#include <qdf_status.h>
+#include <hal_api.h>
+#include <cdp_txrx_handle.h>
+
+#define DP_SIM_DEF_RING_SIZE 1024
+#define DP_SIM_DEF_QUOTA 64
+
+struct dp_sim;
+
+/**
+ * struct dp_sim_arch_ops - per architecture descriptor handling of the
+ *			    simulated target
+ * @tx_comp_fill: fill a WBM completion, acked by TQM, for a TCL data
+ *		  descriptor of the given peer
+ * @rx_desc_fill: fill a REO destination descriptor for a refill buffer
+ *		  holding a single MSDU of the given length, received from
+ *		  the given peer of the given vdev
+ * @rx_tlv_fill: fill the zeroed RX TLVs in front of a received MSDU
+ *
+ * Ring entries are zeroed before the fill ops are called.
+ */
+struct dp_sim_arch_ops {
+	void (*tx_comp_fill)(void *comp_desc, void *tcl_desc,
+			     uint16_t peer_id);
+	void (*rx_desc_fill)(void *reo_desc, void *buf_addr_info,
+			     uint16_t len, uint16_t peer_id, uint8_t vdev_id);
+	void (*rx_tlv_fill)(uint8_t *rx_tlv);
+};
+
+/**
+ * struct dp_sim_params - simulation scenario
+ * @num_pkts: frames received and frames transmitted by the run
+ * @quota: descriptors handled per host ring reap or post
+ * @rx: simulate the receive path
+ * @tx: simulate the transmit and completion path
+ */
+struct dp_sim_params {
+	uint32_t num_pkts;
+	uint32_t quota;
+	bool rx;
+	bool tx;
+};
+
+/**
+ * struct dp_sim_result - simulation results
+ * @elapsed_us: wall time of the run
+ * @rx_pkts: frames delivered to the vdev by dp_rx_process_li()
+ * @rx_bytes: bytes of the delivered frames
+ * @rx_err: frames reaped from the REO destination ring but dropped by the
+ *	    data path
+ * @rx_alloc_fail: refill buffer allocation failures
+ * @rx_pps: frames received per second
+ * @rx_ns_per_pkt: time spent in dp_rx_process_li() per received frame,
+ *		   in ns
+ * @rx_cycles_per_pkt: cycles spent in dp_rx_process_li() per received
+ *		       frame
+ * @tx_pkts: frames accepted by dp_tx_send()
+ * @tx_comp: frames completed by dp_tx_comp_handler()
+ * @tx_err: frames rejected by dp_tx_send()
+ * @tx_ring_full: TCL data ring full drops counted by the data path
+ * @tx_pps: frames completed per second
+ * @tx_ns_per_pkt: time spent in dp_tx_send() and dp_tx_comp_handler() per
+ *		   completed frame, in ns
+ * @tx_cycles_per_pkt: cycles spent in dp_tx_send() and
+ *		       dp_tx_comp_handler() per completed frame
+ * @target_rx_starved: times the target had a frame but no refill buffer
+ * @target_ring_full: times the target found a destination ring full
+ */
+struct dp_sim_result {
+	uint64_t elapsed_us;
+	uint64_t rx_pkts;
+	uint64_t rx_bytes;
+	uint32_t rx_err;
+	uint32_t rx_alloc_fail;
+	uint64_t rx_pps;
+	uint64_t rx_ns_per_pkt;
+	uint64_t rx_cycles_per_pkt;
+	uint64_t tx_pkts;
+	uint64_t tx_comp;
+	uint32_t tx_err;
+	uint32_t tx_ring_full;
+	uint64_t tx_pps;
+	uint64_t tx_ns_per_pkt;
+	uint64_t tx_cycles_per_pkt;
+	uint32_t target_rx_starved;
+	uint32_t target_ring_full;
+};
+
+#ifdef WLAN_DP_SIM
+/**
+ * dp_sim_attach() - Create a simulator instance
+ * @osdev: QDF device used for buffer allocation and mapping
+ * @hif_handle: HIF handle of the loaded driver
+ * @ctrl_psoc: control path psoc, for the wlan_cfg defaults
+ * @target_type: target whose ring layout and descriptors are simulated,
+ *		 0 for the default target of the build
+ * @ring_size: entries per ring, capped to the ring maximum
+ *
+ * Return: simulator instance, NULL on failure or unsupported target
+ */
+struct dp_sim *dp_sim_attach(qdf_device_t osdev,
+			     struct hif_opaque_softc *hif_handle,
+			     struct cdp_ctrl_objmgr_psoc *ctrl_psoc,
+			     uint32_t target_type, uint32_t ring_size);
+
+/**
+ * dp_sim_detach() - Destroy a simulator instance
+ * @sim: simulator instance
+ *
+ * Return: None
+ */
+void dp_sim_detach(struct dp_sim *sim);
+
+/**
+ * dp_sim_load_pcap() - Load the frames fed to the simulated target
+ * @sim: simulator instance
+ * @data: pcap file contents, LINKTYPE_ETHERNET
+ * @len: length of @data
+ *
+ * The frames are copied; frames which do not fit a refill buffer are
+ * skipped.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_sim_load_pcap(struct dp_sim *sim, const uint8_t *data,
+			    qdf_size_t len);
+
+/**
+ * dp_sim_run() - Run a simulation scenario
+ * @sim: simulator instance with frames loaded
+ * @params: scenario
+ * @result: results of the run
+ *
+ * Blocks until @params->num_pkts frames have been received and completed,
+ * or until the run times out.
+ *
+ * Return: QDF_STATUS_E_TIMEOUT when the run did not complete, in which case
+ *	   @result holds the partial counts and @sim must be detached
+ */
+QDF_STATUS dp_sim_run(struct dp_sim *sim, struct dp_sim_params *params,
+		      struct dp_sim_result *result);
+
+#ifdef CONFIG_LITHIUM
+/**
+ * dp_sim_arch_ops_attach_li() - Attach the Lithium descriptor handling
+ * @ops: ops to fill
+ *
+ * Return: None
+ */
+void dp_sim_arch_ops_attach_li(struct dp_sim_arch_ops *ops);
+#endif
+#else
+static inline
+struct dp_sim *dp_sim_attach(qdf_device_t osdev,
+			     struct hif_opaque_softc *hif_handle,
+			     struct cdp_ctrl_objmgr_psoc *ctrl_psoc,
+			     uint32_t target_type, uint32_t ring_size)
+{
+	return NULL;
+}
+
+static inline void dp_sim_detach(struct dp_sim *sim)
+{
+}
+
+static inline
+QDF_STATUS dp_sim_load_pcap(struct dp_sim *sim, const uint8_t *data,
+			    qdf_size_t len)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline
+QDF_STATUS dp_sim_run(struct dp_sim *sim, struct dp_sim_params *params,
+		      struct dp_sim_result *result)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif /* WLAN_DP_SIM */
+#endif /* _DP_SIM_H_ */
@@ -6811,6 +6811,82 @@ void dp_print_soc_interrupt_stats(struct dp_soc *soc)
 	}
 }
 
+#ifdef WLAN_DP_REO_DESC_BATCH_FLUSH
+/**
+ * dp_print_soc_reo_qdesc_free_stats() - Print REO queue teardown stats
+ * @soc: DP SOC handle
+ *
+ * Return: None
+ */
+static void dp_print_soc_reo_qdesc_free_stats(struct dp_soc *soc)
+{
+	uint32_t freed = soc->stats.rx.reo_qdesc_free.freed;
+	uint64_t avg_lat = 0;
+
+	if (freed)
+		avg_lat = qdf_do_div(soc->stats.rx.reo_qdesc_free.lat_sum_ms,
+				     freed);
+
+	DP_PRINT_STATS("REO qdesc free:");
+	DP_PRINT_STATS("\tBatch flushes: %u descs: %u max: %u",
+		       soc->stats.rx.reo_qdesc_free.batch_flush,
+		       soc->stats.rx.reo_qdesc_free.batch_desc,
+		       soc->stats.rx.reo_qdesc_free.batch_max);
+	DP_PRINT_STATS("\tPer desc flush cmds: %u",
+		       soc->stats.rx.reo_qdesc_free.desc_flush);
+	DP_PRINT_STATS("\tLow memory limits: %u freelist max: %u",
+		       soc->stats.rx.reo_qdesc_free.low_mem,
+		       soc->stats.rx.reo_qdesc_free.freelist_max);
+	DP_PRINT_STATS("\tREO cmd ring max used: %u",
+		       soc->stats.rx.reo_qdesc_free.cmd_ring_max_used);
+	DP_PRINT_STATS("\tFreed: %u avg lat: %llu ms max lat: %u ms",
+		       freed, avg_lat,
+		       soc->stats.rx.reo_qdesc_free.lat_max_ms);
+	DP_PRINT_STATS("\tLat <10ms: %u <100ms: %u <1s: %u >=1s: %u",
+		       soc->stats.rx.reo_qdesc_free.lat_hist[0],
+		       soc->stats.rx.reo_qdesc_free.lat_hist[1],
+		       soc->stats.rx.reo_qdesc_free.lat_hist[2],
+		       soc->stats.rx.reo_qdesc_free.lat_hist[3]);
+}
+#else
+static inline void dp_print_soc_reo_qdesc_free_stats(struct dp_soc *soc)
+{
+}
+#endif /* WLAN_DP_REO_DESC_BATCH_FLUSH */
+
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+/**
+ * dp_print_soc_rx_desc_ring_stats() - Print the use of the per REO ring
+ *	free stacks of the rx descriptor pools
+ * @soc: DP SOC handle
+ *
+ * Return: None
+ */
+static void dp_print_soc_rx_desc_ring_stats(struct dp_soc *soc)
+{
+	struct dp_rx_desc_ring_stack *stack;
+	uint8_t pool_id, ring;
+
+	DP_PRINT_STATS("Rx desc ring free stacks:");
+	for (pool_id = 0; pool_id < MAX_RXDESC_POOLS; pool_id++) {
+		for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++) {
+			stack = &soc->rx_desc_buf[pool_id].ring_stack[ring];
+			if (!stack->hit && !stack->miss && !stack->spill)
+				continue;
+
+			DP_PRINT_STATS("\tpool %u ring %u: stack %u freelist %u spill %u drain %u held %u",
+				       pool_id, ring, stack->hit, stack->miss,
+				       stack->spill, stack->drain,
+				       stack->count);
+		}
+	}
+}
+#else
+static inline void dp_print_soc_rx_desc_ring_stats(struct dp_soc *soc)
+{
+}
+#endif /* WLAN_DP_RX_DESC_RING_POOL */
+
 void
 dp_print_soc_rx_stats(struct dp_soc *soc)
 {
@@ -6942,6 +7018,9 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 	DP_PRINT_STATS("Rx Flush count:%d", soc->stats.rx.err.rx_flush_count);
 	DP_PRINT_STATS("Rx invalid TID count:%d",
 		       soc->stats.rx.err.rx_invalid_tid_err);
+
+	dp_print_soc_reo_qdesc_free_stats(soc);
+	dp_print_soc_rx_desc_ring_stats(soc);
 }
 
 #ifdef FEATURE_TSO_STATS
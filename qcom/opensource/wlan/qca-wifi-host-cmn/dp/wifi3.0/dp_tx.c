@@ -43,6 +43,7 @@
 #ifdef WLAN_DP_FEATURE_SW_LATENCY_MGR
 #include <dp_swlm.h>
 #endif
+#include "dp_lat_trace.h"
 #ifdef WIFI_MONITOR_SUPPORT
 #include <dp_mon.h>
 #endif
@@ -789,6 +790,65 @@ static void dp_tx_free_remaining_tso_desc(struct dp_soc *soc,
 	dp_tx_free_tso_seg_list(soc, free_seg, msdu_info);
 }
 
+#ifdef FEATURE_TSO_SEG_TEMPLATE
+/**
+ * dp_tx_tso_seg_list_alloc() - allocate the segment list of a TSO packet
+ * @soc: core txrx main context
+ * @msdu_info: meta data associated with the msdu
+ * @num_seg: number of segments required
+ *
+ * All segment descriptors of the jumbo packet are taken from the pool
+ * in a single lock transaction.
+ *
+ * Return: 0 on success, non zero on failure
+ */
+static inline int dp_tx_tso_seg_list_alloc(struct dp_soc *soc,
+					   struct dp_tx_msdu_info_s *msdu_info,
+					   int num_seg)
+{
+	struct qdf_tso_info_t *tso_info = &msdu_info->u.tso_info;
+
+	tso_info->tso_seg_list =
+		dp_tx_tso_desc_alloc_multiple(soc,
+					      msdu_info->tx_queue.desc_pool_id,
+					      num_seg);
+
+	return !tso_info->tso_seg_list;
+}
+#else
+/**
+ * dp_tx_tso_seg_list_alloc() - allocate the segment list of a TSO packet
+ * @soc: core txrx main context
+ * @msdu_info: meta data associated with the msdu
+ * @num_seg: number of segments required
+ *
+ * Segments allocated before a failure are left on tso_seg_list for the
+ * caller to release.
+ *
+ * Return: 0 on success, non zero on failure
+ */
+static inline int dp_tx_tso_seg_list_alloc(struct dp_soc *soc,
+					   struct dp_tx_msdu_info_s *msdu_info,
+					   int num_seg)
+{
+	struct qdf_tso_info_t *tso_info = &msdu_info->u.tso_info;
+	struct qdf_tso_seg_elem_t *tso_seg;
+
+	while (num_seg) {
+		tso_seg = dp_tx_tso_desc_alloc(
+				soc, msdu_info->tx_queue.desc_pool_id);
+		if (!tso_seg)
+			return 1;
+
+		tso_seg->next = tso_info->tso_seg_list;
+		tso_info->tso_seg_list = tso_seg;
+		num_seg--;
+	}
+
+	return 0;
+}
+#endif /* FEATURE_TSO_SEG_TEMPLATE */
+
 /**
  * dp_tx_prepare_tso() - Given a jumbo msdu, prepare the TSO info
  * @vdev: virtual device handle
@@ -800,7 +860,6 @@ static void dp_tx_free_remaining_tso_desc(struct dp_soc *soc,
 static QDF_STATUS dp_tx_prepare_tso(struct dp_vdev *vdev,
 		qdf_nbuf_t msdu, struct dp_tx_msdu_info_s *msdu_info)
 {
-	struct qdf_tso_seg_elem_t *tso_seg;
 	int num_seg = qdf_nbuf_get_tso_num_seg(msdu);
 	struct dp_soc *soc = vdev->pdev->soc;
 	struct dp_pdev *pdev = vdev->pdev;
@@ -815,26 +874,16 @@ static QDF_STATUS dp_tx_prepare_tso(struct dp_vdev *vdev,
 
 	TSO_DEBUG(" %s: num_seg: %d", __func__, num_seg);
 
-	while (num_seg) {
-		tso_seg = dp_tx_tso_desc_alloc(
-				soc, msdu_info->tx_queue.desc_pool_id);
-		if (tso_seg) {
-			tso_seg->next = tso_info->tso_seg_list;
-			tso_info->tso_seg_list = tso_seg;
-			num_seg--;
-		} else {
-			dp_err_rl("Failed to alloc tso seg desc");
-			DP_STATS_INC_PKT(vdev->pdev,
-					 tso_stats.tso_no_mem_dropped, 1,
-					 qdf_nbuf_len(msdu));
-			dp_tx_free_remaining_tso_desc(soc, msdu_info, false);
+	if (qdf_unlikely(dp_tx_tso_seg_list_alloc(soc, msdu_info, num_seg))) {
+		dp_err_rl("Failed to alloc tso seg desc");
+		DP_STATS_INC_PKT(vdev->pdev,
+				 tso_stats.tso_no_mem_dropped, 1,
+				 qdf_nbuf_len(msdu));
+		dp_tx_free_remaining_tso_desc(soc, msdu_info, false);
 
-			return QDF_STATUS_E_NOMEM;
-		}
+		return QDF_STATUS_E_NOMEM;
 	}
 
-	TSO_DEBUG(" %s: num_seg: %d", __func__, num_seg);
-
 	tso_num_seg = dp_tso_num_seg_alloc(soc,
 			msdu_info->tx_queue.desc_pool_id);
 
@@ -2120,6 +2169,9 @@ void dp_tx_comp_free_buf(struct dp_soc *soc, struct dp_tx_desc_s *desc)
 	if (!nbuf)
 		return;
 
+	dp_lat_trace_stamp(soc, nbuf, CDP_LAT_TX_FREE);
+	dp_ipa_exc_zc_tx_comp(soc, nbuf);
+
 	/* If it is TDLS mgmt, don't unmap or free the frame */
 	if (desc->flags & DP_TX_DESC_FLAG_TDLS_FRAME)
 		return dp_non_std_htt_tx_comp_free_buff(soc, desc);
@@ -3108,6 +3160,8 @@ qdf_nbuf_t dp_tx_send(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	if (qdf_unlikely(!vdev))
 		return nbuf;
 
+	dp_lat_trace_stamp(soc, nbuf, CDP_LAT_TX_DP_SEND);
+
 	dp_verbose_debug("skb "QDF_MAC_ADDR_FMT,
 			 QDF_MAC_ADDR_REF(nbuf->data));
 
@@ -4476,11 +4530,14 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 							   desc->dma_addr,
 							   QDF_DMA_TO_DEVICE,
 							   desc->length);
+			dp_lat_trace_stamp(soc, desc->nbuf, CDP_LAT_TX_FREE);
+			dp_ipa_exc_zc_tx_comp(soc, desc->nbuf);
 			qdf_nbuf_free(desc->nbuf);
 			dp_tx_desc_free(soc, desc, desc->pool_id);
 			desc = next;
 			continue;
 		}
+		dp_lat_trace_stamp(soc, desc->nbuf, CDP_LAT_TX_COMP_PROC);
 		hal_tx_comp_get_status(&desc->comp, &ts, soc->hal_soc);
 
 		dp_tx_comp_process_tx_status(soc, desc, &ts, peer, ring_id);
@@ -4742,6 +4799,8 @@ more_data:
 					      &tx_desc->comp, 1);
 add_to_pool:
 			DP_HIST_PACKET_COUNT_INC(tx_desc->pdev->pdev_id);
+			dp_lat_trace_stamp(soc, tx_desc->nbuf,
+					   CDP_LAT_TX_FW_COMP);
 
 			/* First ring descriptor on the cycle */
 			if (!head_desc) {
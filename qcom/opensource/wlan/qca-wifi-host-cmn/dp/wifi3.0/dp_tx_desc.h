@@ -1024,6 +1024,48 @@ static inline void dp_tx_tso_desc_free(struct dp_soc *soc,
 	qdf_spin_unlock_bh(&soc->tx_tso_desc[pool_id].lock);
 }
 
+#ifdef FEATURE_TSO_SEG_TEMPLATE
+/**
+ * dp_tx_tso_desc_alloc_multiple() - allocate a chain of TSO segments
+ * @soc: device soc instance
+ * @pool_id: pool id should pick up tso descriptor
+ * @num_seg: number of TSO segments required
+ *
+ * Detaches @num_seg elements from the free list in a single lock
+ * transaction. The request is all or nothing, the pool is left
+ * untouched if it cannot satisfy it.
+ *
+ * Return: head of a NULL terminated list of @num_seg segments, NULL on
+ *	   failure
+ */
+static inline struct qdf_tso_seg_elem_t *
+dp_tx_tso_desc_alloc_multiple(struct dp_soc *soc, uint8_t pool_id,
+			      uint32_t num_seg)
+{
+	struct qdf_tso_seg_elem_t *head = NULL;
+	struct qdf_tso_seg_elem_t *tail;
+	uint32_t count;
+
+	if (qdf_unlikely(!num_seg))
+		return NULL;
+
+	qdf_spin_lock_bh(&soc->tx_tso_desc[pool_id].lock);
+	if (soc->tx_tso_desc[pool_id].num_free >= num_seg) {
+		head = soc->tx_tso_desc[pool_id].freelist;
+		tail = head;
+		for (count = 1; count < num_seg; count++)
+			tail = tail->next;
+
+		soc->tx_tso_desc[pool_id].freelist = tail->next;
+		soc->tx_tso_desc[pool_id].num_free -= num_seg;
+		tail->next = NULL;
+	}
+	qdf_spin_unlock_bh(&soc->tx_tso_desc[pool_id].lock);
+
+	return head;
+}
+#endif
+
 static inline
 struct qdf_tso_num_seg_elem_t  *dp_tso_num_seg_alloc(struct dp_soc *soc,
 		uint8_t pool_id)
@@ -196,6 +196,7 @@ struct cdp_soc_rate_stats_ctx;
 struct dp_rx_fst;
 struct dp_mon_filter;
 struct dp_mon_mpdu;
+struct dp_lat_trace;
 #ifdef QCA_WIFI_QCN9224
 struct dp_mon_filter_be;
 #endif
@@ -451,14 +452,48 @@ enum dp_desc_type {
 	DP_HW_CC_SPT_PAGE_TYPE,
 };
 
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+/* Max free RX descriptors cached by a REO destination ring per pool */
+#define DP_RX_DESC_RING_STACK_SIZE 128
+
+/**
+ * struct dp_rx_desc_ring_stack - free RX descriptors of a pool cached by
+ *	one REO destination ring
+ * @top: most recently freed descriptor
+ * @count: number of descriptors in the stack
+ * @lock: protects @top, @count and @drain, which are also used when the
+ *	stack is drained from other contexts
+ * @hit: descriptors handed out from the stack, without the pool lock
+ * @miss: descriptors taken from the pool freelist, under the pool lock
+ * @spill: times the stack was full and descriptors went to the freelist
+ * @drain: descriptors returned to the freelist when it ran out
+ *
+ * The stack is filled and emptied by the rx processing context of its REO
+ * ring, so its lock is only contended when the freelist runs out and the
+ * stacks are drained into it. @hit, @miss and @spill are only written by
+ * that context.
+ */
+struct dp_rx_desc_ring_stack {
+	union dp_rx_desc_list_elem_t *top;
+	uint32_t count;
+	qdf_spinlock_t lock;
+	uint32_t hit;
+	uint32_t miss;
+	uint32_t spill;
+	uint32_t drain;
+};
+#endif
+
 /**
  * struct rx_desc_pool
  * @pool_size: number of RX descriptor in the pool
  * @elem_size: Element size
  * @desc_pages: Multi page descriptors
+ * @desc_base: cookie indexed array backing desc_pages
  * @array: pointer to array of RX descriptor
  * @freelist: pointer to free RX descriptor link list
  * @lock: Protection for the RX descriptor pool
+ * @ring_stack: per REO destination ring stacks of free descriptors
  * @owner: owner for nbuf
  * @buf_size: Buffer size
  * @buf_alignment: Buffer alignment
@@ -470,11 +505,17 @@ struct rx_desc_pool {
 #ifdef RX_DESC_MULTI_PAGE_ALLOC
 	uint16_t elem_size;
 	struct qdf_mem_multi_page_t desc_pages;
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+	uint8_t *desc_base;
+#endif
 #else
 	union dp_rx_desc_list_elem_t *array;
 #endif
 	union dp_rx_desc_list_elem_t *freelist;
 	qdf_spinlock_t lock;
+#ifdef WLAN_DP_RX_DESC_RING_POOL
+	struct dp_rx_desc_ring_stack ring_stack[MAX_REO_DEST_RINGS];
+#endif
 	uint8_t owner;
 	uint16_t buf_size;
 	uint8_t buf_alignment;
@@ -921,10 +962,20 @@ struct dp_intr {
 
 	/* Interrupt Stats for individual masks */
 	struct dp_intr_stats intr_stats;
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+	/* Bus bandwidth demand accumulated since the last indication */
+	uint64_t bw_ind_ts;
+	uint32_t bw_ind_pkts;
+	uint8_t bw_ind_backlog;
+#endif
 };
 
 #define REO_DESC_FREELIST_SIZE 64
 #define REO_DESC_FREE_DEFER_MS 1000
+#ifdef WLAN_DP_REO_DESC_BATCH_FLUSH
+/* Freelist limit when the system is out of free memory */
+#define REO_DESC_FREELIST_MIN_SIZE 8
+#endif
 struct reo_desc_list_node {
 	qdf_list_node_t node;
 	unsigned long free_ts;
@@ -934,6 +985,10 @@ struct reo_desc_list_node {
 #ifdef REO_QDESC_HISTORY
 	uint8_t peer_mac[QDF_MAC_ADDR_SIZE];
 #endif
+#ifdef WLAN_DP_REO_DESC_BATCH_FLUSH
+	/* time the rx tid delete was issued, for teardown latency */
+	unsigned long del_ts;
+#endif
 };
 
 #ifdef WLAN_DP_FEATURE_DEFERRED_REO_QDESC_DESTROY
@@ -1165,6 +1220,33 @@ struct dp_soc_stats {
 			uint32_t rx_invalid_tid_err;
 		} err;
 
+#ifdef WLAN_DP_REO_DESC_BATCH_FLUSH
+		/* REO queue descriptor teardown */
+		struct {
+			/* Batches of descs completed by one cmd status */
+			uint32_t batch_flush;
+			/* Descs freed through a batch flush */
+			uint32_t batch_desc;
+			/* Largest batch completed by one cmd status */
+			uint32_t batch_max;
+			/* Per desc flush cmds */
+			uint32_t desc_flush;
+			/* Times the freelist limit was cut for low memory */
+			uint32_t low_mem;
+			/* Max descs pending in the freelist */
+			uint32_t freelist_max;
+			/* Max REO cmd ring entries in use when flushing */
+			uint32_t cmd_ring_max_used;
+			/* Descs freed, rx tid delete to queue memory free */
+			uint32_t freed;
+			/* Sum and max of the teardown latency in ms */
+			uint64_t lat_sum_ms;
+			uint32_t lat_max_ms;
+			/* Teardown latency <10ms, <100ms, <1s and above */
+			uint32_t lat_hist[4];
+		} reo_qdesc_free;
+#endif
+
 		/* packet count per core - per ring */
 		uint64_t ring_packets[NR_CPUS][MAX_REO_DEST_RINGS];
 	} rx;
@@ -1518,6 +1600,10 @@ struct dp_swlm_ops {
  *			   throughput did not meet session threshold
  * @tcl.coalesce_success: Num of TCL HP writes coalesced successfully.
  * @tcl.coalesce_fail: Num of TCL HP writes coalesces failed
+ * @tcl.ll_dscp: Num TCL register write coalescing skips, since the pkt
+ *		 carried a latency sensitive DSCP
+ * @tcl.pkts_thresh_reached: Num TCL HP writes flush after the expected
+ *			     burst was coalesced
  */
 struct dp_swlm_stats {
 	struct {
@@ -1531,9 +1617,84 @@ struct dp_swlm_stats {
 		uint32_t tput_criteria_fail;
 		uint32_t coalesce_success;
 		uint32_t coalesce_fail;
+		uint32_t ll_dscp;
+		uint32_t pkts_thresh_reached;
 	} tcl[MAX_TCL_DATA_RINGS];
 };
 
+#ifdef WLAN_DP_SWLM_ADAPTIVE
+/**
+ * enum dp_swlm_decision - decision of the adaptive TCL coalescing model
+ * @DP_SWLM_COALESCE: defer the TCL HP write
+ * @DP_SWLM_FLUSH_SPARSE: write, arrival rate too low to coalesce in the SLO
+ * @DP_SWLM_FLUSH_PKTS: write, the expected burst has been coalesced
+ * @DP_SWLM_FLUSH_TIME: write, the coalescing window expired
+ * @DP_SWLM_FLUSH_LL: write, latency sensitive frame
+ * @DP_SWLM_FLUSH_HOLDOFF: write, frame shortly after a latency sensitive one
+ * @DP_SWLM_DECISION_MAX: number of decisions
+ */
+enum dp_swlm_decision {
+	DP_SWLM_COALESCE,
+	DP_SWLM_FLUSH_SPARSE,
+	DP_SWLM_FLUSH_PKTS,
+	DP_SWLM_FLUSH_TIME,
+	DP_SWLM_FLUSH_LL,
+	DP_SWLM_FLUSH_HOLDOFF,
+	DP_SWLM_DECISION_MAX,
+};
+
+/**
+ * struct dp_swlm_model - arrival model of a TCL ring
+ * @last_ts: timestamp of the last frame in us
+ * @gap_ewma: EWMA of the inter-frame gap in us, Q4
+ * @burst_ewma: EWMA of the burst length in frames, Q4
+ * @burst_len: length of the current burst
+ * @session_end: end of the current coalescing window
+ * @session_pkts: frames coalesced in the current window, 0 if none open
+ * @target_pkts: frames after which the current window is flushed
+ * @ll_holdoff_end: no coalescing before this time, after a latency
+ *		    sensitive frame
+ */
+struct dp_swlm_model {
+	uint64_t last_ts;
+	uint32_t gap_ewma;
+	uint32_t burst_ewma;
+	uint32_t burst_len;
+	uint64_t session_end;
+	uint32_t session_pkts;
+	uint32_t target_pkts;
+	uint64_t ll_holdoff_end;
+};
+
+/**
+ * struct dp_swlm_trace_entry - record of one SWLM decision
+ * @ts: frame timestamp in us
+ * @gap: inter-frame gap EWMA in us at decision time
+ * @burst: burst length EWMA in frames at decision time
+ * @decision: enum dp_swlm_decision
+ */
+struct dp_swlm_trace_entry {
+	uint64_t ts;
+	uint16_t gap;
+	uint8_t burst;
+	uint8_t decision;
+};
+
+/**
+ * struct dp_swlm_replay_result - result of replaying frames through the model
+ * @pkts: number of frames replayed
+ * @doorbells: number of TCL HP writes
+ * @max_delay: highest latency added to a frame in us
+ * @total_delay: sum of the latency added to all frames in us
+ */
+struct dp_swlm_replay_result {
+	uint32_t pkts;
+	uint32_t doorbells;
+	uint32_t max_delay;
+	uint64_t total_delay;
+};
+#endif
+
 /**
  * struct dp_swlm_tcl_params: Parameters based on TCL for different modules
  *			      in the Software latency manager.
@@ -1549,6 +1710,10 @@ struct dp_swlm_stats {
  * @prev_rx_bytes: Previous RX bytes accounted
  * @expire_time: expiry time for sample
  * @tput_pass_cnt: threshold throughput pass counter
+ * @model: arrival model of the ring
+ * @timer_flushed: the flush timer wrote the HP of the open window
+ * @trace: decision trace of the ring
+ * @trace_idx: next trace entry to be written
  */
 struct dp_swlm_tcl_params {
 	struct dp_soc *soc;
@@ -1563,6 +1728,12 @@ struct dp_swlm_tcl_params {
 	uint32_t prev_rx_bytes;
 	uint64_t expire_time;
 	uint32_t tput_pass_cnt;
+#ifdef WLAN_DP_SWLM_ADAPTIVE
+	struct dp_swlm_model model;
+	bool timer_flushed;
+	struct dp_swlm_trace_entry *trace;
+	uint32_t trace_idx;
+#endif
 };
 
 /**
@@ -1572,13 +1743,15 @@ struct dp_swlm_tcl_params {
  *			   write coalescing
  * @tx_traffic_thresh: Threshold for TX traffic, to begin TCL register
  *			   write coalescing
- * @sampling_time: Sampling time to test the throughput threshold
- * @time_flush_thresh: Time threshold to flush the TCL HP register write
+ * @sampling_time: Sampling time in us to test the throughput threshold
+ * @time_flush_thresh: Time threshold in us to flush the TCL HP register
+ *		       write
  * @tx_thresh_multiplier: Multiplier to deduce the bytes threshold after
  *			      which the TCL HP register is written, thereby
  *			      ending the coalescing.
  * @tx_pkt_thresh: Threshold for TX packet count, to begin TCL register
  *		       write coalescing
+ * @latency_slo: Max latency in us the coalescing may add to a frame
  * @tcl: TCL ring specific params
  */
 
@@ -1589,6 +1762,7 @@ struct dp_swlm_params {
 	uint32_t time_flush_thresh;
 	uint32_t tx_thresh_multiplier;
 	uint32_t tx_pkt_thresh;
+	uint32_t latency_slo;
 	struct dp_swlm_tcl_params tcl[MAX_TCL_DATA_RINGS];
 };
 
@@ -1631,6 +1805,31 @@ struct ipa_dp_tx_rsc {
 	void **tx_buf_pool_vaddr_unaligned;
 	qdf_dma_addr_t *tx_buf_pool_paddr_unaligned;
 };
+
+#ifdef WLAN_IPA_EXC_ZERO_COPY
+#define DP_IPA_EXC_ZC_TURNAROUND_BINS 4
+#define DP_IPA_EXC_ZC_TURNAROUND_BIN0_US 125
+
+/**
+ * struct dp_ipa_exc_zc_stats - IPA exception buffer sharing stats
+ * @copy_avoided: bcast/mcast frames forwarded sharing the IPA buffer
+ * @copy_fallback: bcast/mcast frames copied as the buffer was not shared
+ * @handoff: IPA buffers handed to the tx path by intra-BSS forwarding
+ * @release: IPA buffers released by the tx completion
+ * @turnaround: histogram of the time from handoff to release, the first
+ *  bin is below DP_IPA_EXC_ZC_TURNAROUND_BIN0_US and each further one is
+ *  8 times wider
+ *
+ * Updated from the rx and tx completion contexts of all the rings.
+ */
+struct dp_ipa_exc_zc_stats {
+	qdf_atomic_t copy_avoided;
+	qdf_atomic_t copy_fallback;
+	qdf_atomic_t handoff;
+	qdf_atomic_t release;
+	qdf_atomic_t turnaround[DP_IPA_EXC_ZC_TURNAROUND_BINS];
+};
+#endif
 #endif
 
 struct dp_tx_msdu_info_s;
@@ -2143,6 +2342,9 @@ struct dp_soc {
 	qdf_spinlock_t ipa_rx_buf_map_lock;
 	bool ipa_rx_buf_map_lock_initialized;
 	uint8_t ipa_reo_ctx_lock_required[MAX_REO_DEST_RINGS];
+#ifdef WLAN_IPA_EXC_ZERO_COPY
+	struct dp_ipa_exc_zc_stats ipa_exc_zc;
+#endif
 #endif
 
 #ifdef WLAN_FEATURE_STATS_EXT
@@ -2245,6 +2447,10 @@ struct dp_soc {
 #ifdef WLAN_DP_FEATURE_SW_LATENCY_MGR
 	struct dp_swlm swlm;
 #endif
+#ifdef WLAN_DP_LAT_TRACE
+	/* sampled stage latency tracer, NULL while tracing is disabled */
+	struct dp_lat_trace *lat_trace;
+#endif
 #ifdef FEATURE_RUNTIME_PM
 	/* Dp runtime refcount */
 	qdf_atomic_t dp_runtime_refcount;
@@ -42,6 +42,7 @@
 #include "dp_hist.h"
 #include "dp_rx_buffer_pool.h"
 #include "dp_li.h"
+#include "dp_lat_trace.h"
 
 static inline
 bool is_sa_da_idx_valid(struct dp_soc *soc, uint8_t *rx_tlv_hdr,
@@ -563,9 +564,11 @@ done:
 
 		rx_desc_pool = &soc->rx_desc_buf[mac_id];
 
-		dp_rx_buffers_replenish(soc, mac_id, dp_rxdma_srng,
-					rx_desc_pool, rx_bufs_reaped[mac_id],
-					&head[mac_id], &tail[mac_id]);
+		dp_rx_buffers_replenish_ring(soc, mac_id, dp_rxdma_srng,
+					     rx_desc_pool,
+					     rx_bufs_reaped[mac_id],
+					     &head[mac_id], &tail[mac_id],
+					     reo_ring_num);
 	}
 
 	dp_verbose_debug("replenished %u\n", rx_bufs_reaped[0]);
@@ -662,6 +665,7 @@ done:
 
 		rx_pdev = vdev->pdev;
 		DP_RX_TID_SAVE(nbuf, tid);
+		dp_lat_trace_stamp(soc, nbuf, CDP_LAT_RX_REAP);
 		if (qdf_unlikely(rx_pdev->delay_stats_flag) ||
 		    qdf_unlikely(wlan_cfg_is_peer_ext_stats_enabled(
 				 soc->wlan_cfg_ctx)) ||
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <htt.h>
+#include "hal_hw_headers.h"
+#include "hal_rx.h"
+#include "hal_tx.h"
+#include "hal_li_rx.h"
+#include <hal_li_tx.h>
+#include "dp_sim.h"
+
+static void dp_sim_tx_comp_fill_li(void *comp_desc, void *tcl_desc,
+				   uint16_t peer_id)
+{
+	/* the TCL descriptor starts with its TLV header */
+	uint8_t *tcl_cmd = (uint8_t *)tcl_desc + sizeof(struct tlv_32_hdr);
+
+	/* the buffer, including its cookie, is released as it was queued */
+	qdf_mem_copy(comp_desc, tcl_cmd, sizeof(struct buffer_addr_info));
+	HAL_DESC_SET_FIELD(comp_desc, WBM_RELEASE_RING_2,
+			   RELEASE_SOURCE_MODULE,
+			   HAL_TX_COMP_RELEASE_SOURCE_TQM);
+	HAL_DESC_SET_FIELD(comp_desc, WBM_RELEASE_RING_2, TQM_RELEASE_REASON,
+			   HAL_TX_TQM_RR_FRAME_ACKED);
+	HAL_DESC_SET_FIELD(comp_desc, WBM_RELEASE_RING_7, SW_PEER_ID, peer_id);
+}
+
+static void dp_sim_rx_desc_fill_li(void *reo_desc, void *buf_addr_info,
+				   uint16_t len, uint16_t peer_id,
+				   uint8_t vdev_id)
+{
+	struct reo_destination_ring *reo_dst = reo_desc;
+	uint32_t peer_mdata = 0;
+
+	/* see dp_rx_peer_metadata_peer_id_get_li() */
+	HTT_RX_PEER_META_DATA_V0_PEER_ID_SET(peer_mdata, peer_id);
+	HTT_RX_PEER_META_DATA_V0_VDEV_ID_SET(peer_mdata, vdev_id);
+
+	qdf_mem_copy(&reo_dst->buf_or_link_desc_addr_info, buf_addr_info,
+		     sizeof(struct buffer_addr_info));
+	HAL_DESC_SET_FIELD(reo_desc, REO_DESTINATION_RING_2,
+			   RX_MPDU_DESC_INFO_DETAILS_MSDU_COUNT, 1);
+	HAL_DESC_SET_FIELD(reo_desc, REO_DESTINATION_RING_3,
+			   RX_MPDU_DESC_INFO_DETAILS_PEER_META_DATA,
+			   peer_mdata);
+	HAL_DESC_SET_FIELD(reo_desc, REO_DESTINATION_RING_4,
+			   RX_MSDU_DESC_INFO_DETAILS_FIRST_MSDU_IN_MPDU_FLAG, 1);
+	HAL_DESC_SET_FIELD(reo_desc, REO_DESTINATION_RING_4,
+			   RX_MSDU_DESC_INFO_DETAILS_LAST_MSDU_IN_MPDU_FLAG, 1);
+	HAL_DESC_SET_FIELD(reo_desc, REO_DESTINATION_RING_4,
+			   RX_MSDU_DESC_INFO_DETAILS_MSDU_LENGTH, len);
+	HAL_DESC_SET_FIELD(reo_desc, REO_DESTINATION_RING_7, REO_PUSH_REASON,
+			   HAL_REO_ROUTING_INSTRUCTION);
+}
+
+/* a zeroed TLV area with msdu_done set is a plain, unencrypted MSDU */
+static void dp_sim_rx_tlv_fill_li(uint8_t *rx_tlv)
+{
+	struct rx_pkt_tlvs *pkt_tlvs = (struct rx_pkt_tlvs *)rx_tlv;
+
+	HAL_RX_FLD_SET(&pkt_tlvs->attn_tlv.rx_attn, RX_ATTENTION_2, MSDU_DONE,
+		       1);
+}
+
+void dp_sim_arch_ops_attach_li(struct dp_sim_arch_ops *ops)
+{
+	ops->tx_comp_fill = dp_sim_tx_comp_fill_li;
+	ops->rx_desc_fill = dp_sim_rx_desc_fill_li;
+	ops->rx_tlv_fill = dp_sim_rx_tlv_fill_li;
+}
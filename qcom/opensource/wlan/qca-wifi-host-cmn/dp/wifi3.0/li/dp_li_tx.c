@@ -30,6 +30,7 @@
 #include "dp_txrx_wds.h"
 #endif
 #include "dp_li.h"
+#include "dp_lat_trace.h"
 
 extern uint8_t sec_type_map[MAX_CDP_SEC_TYPE];
 
@@ -442,6 +443,7 @@ dp_tx_hw_enqueue_li(struct dp_soc *soc, struct dp_vdev *vdev,
 	tx_desc->flags |= DP_TX_DESC_FLAG_QUEUED_TX;
 	dp_vdev_peer_stats_update_protocol_cnt_tx(vdev, tx_desc->nbuf);
 	hal_tx_desc_sync(hal_tx_desc_cached, hal_tx_desc);
+	dp_lat_trace_stamp(soc, tx_desc->nbuf, CDP_LAT_TX_TCL_ENQ);
 	coalesce = dp_tx_attempt_coalescing(soc, vdev, tx_desc, tid,
 					    msdu_info, ring_id);
 	DP_STATS_INC_PKT(vdev, tx_i.processed, 1, tx_desc->length);
@@ -3405,6 +3405,11 @@ struct cdp_mon_ops dp_ops_mon_1_0 = {
 	.txrx_deliver_tx_mgmt = dp_deliver_tx_mgmt,
 	.config_full_mon_mode = dp_config_full_mon_mode,
 	.soc_config_full_mon_mode = dp_soc_config_full_mon_mode,
+#ifdef QCA_MONITOR_CAP_RING
+	.txrx_mon_cap_ring_enable = dp_mon_cap_ring_enable,
+	.txrx_mon_cap_ring_disable = dp_mon_cap_ring_disable,
+	.txrx_mon_cap_ring_get_stats = dp_mon_cap_ring_get_stats,
+#endif
 };
 
 struct dp_mon_ops *dp_mon_ops_get_1_0(void)
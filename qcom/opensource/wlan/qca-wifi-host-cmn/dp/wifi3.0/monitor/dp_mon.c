@@ -242,6 +242,203 @@ dp_pdev_set_advance_monitor_filter(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 }
 #endif
 
+#ifdef QCA_MONITOR_CAP_RING
+/**
+ * dp_mon_cap_ring_release() - Close the stream channel of a capture ring
+ * @cap_ring: capture ring detached from the monitor pdev
+ *
+ * Return: void
+ */
+static void dp_mon_cap_ring_release(struct dp_mon_cap_ring *cap_ring)
+{
+	qdf_streamfs_flush(cap_ring->chan);
+	qdf_streamfs_close(cap_ring->chan);
+	qdf_streamfs_remove_dir_recursive(cap_ring->dir);
+	qdf_mem_free(cap_ring);
+}
+
+QDF_STATUS dp_mon_cap_ring_enable(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
+				  struct cdp_mon_cap_ring_cfg *cfg)
+{
+	struct dp_soc *soc = (struct dp_soc *)soc_hdl;
+	struct dp_pdev *pdev =
+		dp_get_pdev_from_soc_pdev_id_wifi3(soc, pdev_id);
+	struct dp_mon_pdev *mon_pdev;
+	struct dp_mon_cap_ring *cap_ring;
+	struct dp_mon_ops *mon_ops;
+	uint32_t subbuf_size, num_subbufs;
+	char name[32];
+	QDF_STATUS status;
+
+	if (!pdev || !pdev->monitor_pdev || !cfg)
+		return QDF_STATUS_E_INVAL;
+
+	mon_pdev = pdev->monitor_pdev;
+
+	subbuf_size = cfg->subbuf_size ? cfg->subbuf_size :
+					 DP_MON_CAP_RING_SUBBUF_SIZE;
+	num_subbufs = cfg->num_subbufs ? cfg->num_subbufs :
+					 DP_MON_CAP_RING_NUM_SUBBUFS;
+	if (subbuf_size <= sizeof(struct cdp_mon_cap_hdr)) {
+		dp_mon_err("%pK: capture ring sub-buffer size %u too small",
+			   soc, subbuf_size);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	cap_ring = qdf_mem_malloc(sizeof(*cap_ring));
+	if (!cap_ring)
+		return QDF_STATUS_E_NOMEM;
+
+	/* channel setup may sleep, do it before taking mon_lock */
+	qdf_scnprintf(name, sizeof(name), "dp_mon_cap_%u_%u",
+		      soc->device_id, pdev->pdev_id);
+	cap_ring->dir = qdf_streamfs_create_dir(name, NULL);
+	if (!cap_ring->dir) {
+		dp_mon_err("%pK: capture ring dir create failed", soc);
+		qdf_mem_free(cap_ring);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	cap_ring->chan = qdf_streamfs_open("ppdu", cap_ring->dir,
+					   subbuf_size, num_subbufs, NULL);
+	if (!cap_ring->chan) {
+		dp_mon_err("%pK: capture ring chan create failed", soc);
+		qdf_streamfs_remove_dir_recursive(cap_ring->dir);
+		qdf_mem_free(cap_ring);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	cap_ring->snaplen = cfg->snaplen;
+	cap_ring->max_rec_len = subbuf_size & ~(sizeof(uint32_t) - 1);
+
+	/* ring setup allocates, keep it outside mon_lock as well */
+	mon_ops = dp_mon_ops_get(soc);
+	if (!wlan_cfg_is_delay_mon_replenish(soc->wlan_cfg_ctx)) {
+		if (mon_ops && mon_ops->mon_vdev_set_monitor_mode_rings)
+			mon_ops->mon_vdev_set_monitor_mode_rings(pdev, true);
+	}
+
+	qdf_spin_lock_bh(&mon_pdev->mon_lock);
+
+	/* capture ring owns the monitor rings just like a monitor vdev */
+	if (mon_pdev->cap_ring || mon_pdev->mvdev || mon_pdev->mcopy_mode) {
+		qdf_spin_unlock_bh(&mon_pdev->mon_lock);
+		dp_mon_cap_ring_release(cap_ring);
+		return QDF_STATUS_E_RESOURCES;
+	}
+
+	mon_pdev->monitor_configured = true;
+	dp_mon_filter_setup_cap_ring(pdev, &cfg->filter);
+	status = dp_mon_filter_update(pdev);
+	if (status != QDF_STATUS_SUCCESS) {
+		dp_mon_err("%pK: Failed to set capture ring filters", soc);
+		dp_mon_filter_reset_cap_ring(pdev);
+		mon_pdev->monitor_configured = false;
+		qdf_spin_unlock_bh(&mon_pdev->mon_lock);
+		dp_mon_cap_ring_release(cap_ring);
+		return status;
+	}
+
+	mon_pdev->cap_ring = cap_ring;
+	qdf_spin_unlock_bh(&mon_pdev->mon_lock);
+
+	dp_mon_info("%pK: capture ring enabled snaplen %u subbuf %u x %u",
+		    soc, cap_ring->snaplen, subbuf_size, num_subbufs);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS dp_mon_cap_ring_disable(struct cdp_soc_t *soc_hdl, uint8_t pdev_id)
+{
+	struct dp_soc *soc = (struct dp_soc *)soc_hdl;
+	struct dp_pdev *pdev =
+		dp_get_pdev_from_soc_pdev_id_wifi3(soc, pdev_id);
+	struct dp_mon_pdev *mon_pdev;
+	struct dp_mon_cap_ring *cap_ring;
+	struct dp_mon_ops *mon_ops;
+
+	if (!pdev || !pdev->monitor_pdev)
+		return QDF_STATUS_E_INVAL;
+
+	mon_pdev = pdev->monitor_pdev;
+
+	qdf_spin_lock_bh(&mon_pdev->mon_lock);
+	cap_ring = mon_pdev->cap_ring;
+	if (!cap_ring) {
+		qdf_spin_unlock_bh(&mon_pdev->mon_lock);
+		return QDF_STATUS_E_ALREADY;
+	}
+
+	mon_pdev->cap_ring = NULL;
+	mon_pdev->monitor_configured = false;
+	dp_mon_filter_reset_cap_ring(pdev);
+	if (dp_mon_filter_update(pdev) != QDF_STATUS_SUCCESS)
+		dp_mon_err("%pK: Failed to reset capture ring filters", soc);
+	qdf_spin_unlock_bh(&mon_pdev->mon_lock);
+
+	mon_ops = dp_mon_ops_get(soc);
+	if (!wlan_cfg_is_delay_mon_replenish(soc->wlan_cfg_ctx)) {
+		if (mon_ops && mon_ops->mon_vdev_set_monitor_mode_rings)
+			mon_ops->mon_vdev_set_monitor_mode_rings(pdev, false);
+	}
+
+	dp_mon_info("%pK: capture ring disabled mpdu %llu drop full %u restitch %u",
+		    soc, cap_ring->stats.mpdu_captured,
+		    cap_ring->stats.drop_ring_full,
+		    cap_ring->stats.drop_restitch);
+	dp_mon_cap_ring_release(cap_ring);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS dp_mon_cap_ring_get_stats(struct cdp_soc_t *soc_hdl,
+				     uint8_t pdev_id,
+				     struct cdp_mon_cap_ring_stats *stats)
+{
+	struct dp_pdev *pdev =
+		dp_get_pdev_from_soc_pdev_id_wifi3((struct dp_soc *)soc_hdl,
+						   pdev_id);
+	struct dp_mon_pdev *mon_pdev;
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+
+	if (!pdev || !pdev->monitor_pdev || !stats)
+		return QDF_STATUS_E_INVAL;
+
+	mon_pdev = pdev->monitor_pdev;
+
+	qdf_spin_lock_bh(&mon_pdev->mon_lock);
+	if (mon_pdev->cap_ring)
+		*stats = mon_pdev->cap_ring->stats;
+	else
+		status = QDF_STATUS_E_INVAL;
+	qdf_spin_unlock_bh(&mon_pdev->mon_lock);
+
+	return status;
+}
+
+/**
+ * dp_mon_cap_ring_deinit() - Tear down the capture ring on pdev deinit
+ * @pdev: DP pdev handle
+ *
+ * Return: void
+ */
+static void dp_mon_cap_ring_deinit(struct dp_pdev *pdev)
+{
+	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
+	struct dp_mon_cap_ring *cap_ring = mon_pdev->cap_ring;
+
+	if (!cap_ring)
+		return;
+
+	mon_pdev->cap_ring = NULL;
+	dp_mon_cap_ring_release(cap_ring);
+}
+#else
+static inline void dp_mon_cap_ring_deinit(struct dp_pdev *pdev)
+{
+}
+#endif /* QCA_MONITOR_CAP_RING */
+
 QDF_STATUS
 dp_deliver_tx_mgmt(struct cdp_soc_t *cdp_soc, uint8_t pdev_id, qdf_nbuf_t nbuf)
 {
@@ -1127,9 +1324,11 @@ QDF_STATUS dp_filter_neighbour_peer(struct dp_pdev *pdev,
 		/* Next Hop scenario not yet handle */
 		vdev = dp_rx_nac_filter(pdev, rx_pkt_hdr);
 		if (vdev) {
+			qdf_spin_lock_bh(&mon_pdev->mon_lock);
 			dp_rx_mon_deliver(pdev->soc, pdev->pdev_id,
 					  pdev->invalid_peer_head_msdu,
 					  pdev->invalid_peer_tail_msdu);
+			qdf_spin_unlock_bh(&mon_pdev->mon_lock);
 
 			pdev->invalid_peer_head_msdu = NULL;
 			pdev->invalid_peer_tail_msdu = NULL;
@@ -2313,6 +2512,7 @@ QDF_STATUS dp_mon_pdev_deinit(struct dp_pdev *pdev)
 		return QDF_STATUS_SUCCESS;
 
 	dp_tx_ppdu_stats_detach(pdev);
+	dp_mon_cap_ring_deinit(pdev);
 
 	if (mon_ops->rx_mon_buffers_free)
 		mon_ops->rx_mon_buffers_free(pdev);
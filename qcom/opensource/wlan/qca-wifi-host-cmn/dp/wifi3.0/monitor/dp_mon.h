@@ -26,6 +26,10 @@
 #include "dp_tx_capture.h"
 #endif
 
+#ifdef QCA_MONITOR_CAP_RING
+#include "qdf_streamfs.h"
+#endif
+
 #define DP_INTR_POLL_TIMER_MS	5
 
 #define MON_VDEV_TIMER_INIT 0x1
@@ -555,6 +559,30 @@ struct dp_mon_ops {
 	void (*mon_register_feature_ops)(struct dp_soc *soc);
 };
 
+#ifdef QCA_MONITOR_CAP_RING
+/* Default capture ring geometry, per cpu */
+#define DP_MON_CAP_RING_SUBBUF_SIZE	(64 * 1024)
+#define DP_MON_CAP_RING_NUM_SUBBUFS	64
+
+/**
+ * struct dp_mon_cap_ring - monitor capture ring context
+ * @chan: stream channel the MPDU records are written to
+ * @dir: debugfs directory holding the per cpu channel files
+ * @snaplen: max frame bytes copied per MPDU, 0 for the full MPDU
+ * @max_rec_len: largest record which fits in one sub-buffer
+ * @seq: sequence number of the next record
+ * @stats: capture ring statistics
+ */
+struct dp_mon_cap_ring {
+	qdf_streamfs_chan_t chan;
+	qdf_dentry_t dir;
+	uint32_t snaplen;
+	uint32_t max_rec_len;
+	uint32_t seq;
+	struct cdp_mon_cap_ring_stats stats;
+};
+#endif /* QCA_MONITOR_CAP_RING */
+
 struct dp_mon_soc {
 	/* Holds all monitor related fields extracted from dp_soc */
 	/* Holds pointer to monitor ops */
@@ -704,6 +732,10 @@ struct  dp_mon_pdev {
 	bool tx_sniffer_enable;
 	/* mirror copy mode */
 	enum m_copy_mode mcopy_mode;
+#ifdef QCA_MONITOR_CAP_RING
+	/* capture ring, non NULL while capture ring mode is enabled */
+	struct dp_mon_cap_ring *cap_ring;
+#endif
 	bool enable_reap_timer_non_pkt;
 	bool bpr_enable;
 	/* Pdev level flag to check peer based pktlog enabled or
@@ -1090,6 +1122,42 @@ static inline bool dp_mon_is_enable_reap_timer_non_pkt(struct dp_pdev *pdev)
 	return pdev->monitor_pdev->enable_reap_timer_non_pkt;
 }
 
+#ifdef QCA_MONITOR_CAP_RING
+/**
+ * dp_rx_mon_cap_ring_enabled() - check if capture ring mode is enabled
+ * @mon_pdev: monitor pdev handle
+ *
+ * Return: true if MPDUs are to be written to the capture ring
+ */
+static inline bool dp_rx_mon_cap_ring_enabled(struct dp_mon_pdev *mon_pdev)
+{
+	return !!mon_pdev->cap_ring;
+}
+
+/**
+ * dp_rx_mon_cap_ring_restitch_drop() - account an MPDU lost to restitching
+ * @mon_pdev: monitor pdev handle
+ *
+ * Return: void
+ */
+static inline void
+dp_rx_mon_cap_ring_restitch_drop(struct dp_mon_pdev *mon_pdev)
+{
+	if (mon_pdev->cap_ring)
+		mon_pdev->cap_ring->stats.drop_restitch++;
+}
+#else
+static inline bool dp_rx_mon_cap_ring_enabled(struct dp_mon_pdev *mon_pdev)
+{
+	return false;
+}
+
+static inline void
+dp_rx_mon_cap_ring_restitch_drop(struct dp_mon_pdev *mon_pdev)
+{
+}
+#endif /* QCA_MONITOR_CAP_RING */
+
 /*
  * dp_monitor_is_enable_mcopy_mode() - check if mcopy mode is enabled
  * @pdev: point to dp pdev
@@ -3153,6 +3221,40 @@ dp_pdev_set_advance_monitor_filter(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 }
 #endif /* QCA_ADVANCE_MON_FILTER_SUPPORT */
 
+#ifdef QCA_MONITOR_CAP_RING
+/**
+ * dp_mon_cap_ring_enable() - Enable the monitor capture ring
+ * @soc_hdl: Datapath soc handle
+ * @pdev_id: id of datapath PDEV handle
+ * @cfg: capture ring configuration
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_mon_cap_ring_enable(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
+				  struct cdp_mon_cap_ring_cfg *cfg);
+
+/**
+ * dp_mon_cap_ring_disable() - Disable the monitor capture ring
+ * @soc_hdl: Datapath soc handle
+ * @pdev_id: id of datapath PDEV handle
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_mon_cap_ring_disable(struct cdp_soc_t *soc_hdl, uint8_t pdev_id);
+
+/**
+ * dp_mon_cap_ring_get_stats() - Get the monitor capture ring stats
+ * @soc_hdl: Datapath soc handle
+ * @pdev_id: id of datapath PDEV handle
+ * @stats: buffer to fill the stats
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_mon_cap_ring_get_stats(struct cdp_soc_t *soc_hdl,
+				     uint8_t pdev_id,
+				     struct cdp_mon_cap_ring_stats *stats);
+#endif /* QCA_MONITOR_CAP_RING */
+
 /**
  * dp_deliver_tx_mgmt() - Deliver mgmt frame for tx capture
  * @cdp_soc : data path soc handle
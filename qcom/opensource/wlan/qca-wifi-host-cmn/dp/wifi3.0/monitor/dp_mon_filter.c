@@ -203,6 +203,39 @@ void dp_mon_filter_reset_mon_mode(struct dp_pdev *pdev)
 		mon_ops->mon_filter_reset_mon_mode(pdev);
 }
 
+#ifdef QCA_MONITOR_CAP_RING
+void dp_mon_filter_setup_cap_ring(struct dp_pdev *pdev,
+				  struct cdp_monitor_filter *filter_val)
+{
+	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
+
+	mon_pdev->mon_filter_mode = filter_val->mode;
+	mon_pdev->fp_mgmt_filter = filter_val->fp_mgmt;
+	mon_pdev->fp_ctrl_filter = filter_val->fp_ctrl;
+	mon_pdev->fp_data_filter = filter_val->fp_data;
+	mon_pdev->mo_mgmt_filter = filter_val->mo_mgmt;
+	mon_pdev->mo_ctrl_filter = filter_val->mo_ctrl;
+	mon_pdev->mo_data_filter = filter_val->mo_data;
+
+	dp_mon_filter_setup_mon_mode(pdev);
+}
+
+void dp_mon_filter_reset_cap_ring(struct dp_pdev *pdev)
+{
+	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
+
+	dp_mon_filter_reset_mon_mode(pdev);
+
+	mon_pdev->mon_filter_mode = MON_FILTER_ALL;
+	mon_pdev->fp_mgmt_filter = FILTER_MGMT_ALL;
+	mon_pdev->fp_ctrl_filter = FILTER_CTRL_ALL;
+	mon_pdev->fp_data_filter = FILTER_DATA_ALL;
+	mon_pdev->mo_mgmt_filter = FILTER_MGMT_ALL;
+	mon_pdev->mo_ctrl_filter = FILTER_CTRL_ALL;
+	mon_pdev->mo_data_filter = FILTER_DATA_ALL;
+}
+#endif /* QCA_MONITOR_CAP_RING */
+
 #ifdef WDI_EVENT_ENABLE
 void dp_mon_filter_setup_rx_pkt_log_full(struct dp_pdev *pdev)
 {
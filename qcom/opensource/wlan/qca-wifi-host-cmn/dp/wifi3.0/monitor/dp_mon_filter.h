@@ -187,6 +187,25 @@ void dp_mon_filter_setup_mon_mode(struct dp_pdev *pdev);
  */
 void dp_mon_filter_reset_mon_mode(struct dp_pdev *pdev);
 
+#ifdef QCA_MONITOR_CAP_RING
+/**
+ * dp_mon_filter_setup_cap_ring() - Setup the capture ring mode filter
+ * @pdev: DP pdev handle
+ * @filter_val: frame filter requested by the capture ring consumer
+ *
+ * The requested filter is pushed down to the monitor status and destination
+ * rings so that frames the consumer is not interested in never reach host.
+ */
+void dp_mon_filter_setup_cap_ring(struct dp_pdev *pdev,
+				  struct cdp_monitor_filter *filter_val);
+
+/**
+ * dp_mon_filter_reset_cap_ring() - Reset the capture ring mode filter
+ * @pdev: DP pdev handle
+ */
+void dp_mon_filter_reset_cap_ring(struct dp_pdev *pdev);
+#endif /* QCA_MONITOR_CAP_RING */
+
 #ifdef WDI_EVENT_ENABLE
 /**
  * dp_mon_filter_setup_rx_pkt_log_full() - Setup the Rx pktlog full mode filter
@@ -1274,6 +1274,95 @@ dp_rx_handle_smart_mesh_mode(struct dp_soc *soc, struct dp_pdev *pdev,
 	return 0;
 }
 
+#ifdef QCA_MONITOR_CAP_RING
+/**
+ * dp_rx_mon_cap_ring_flags() - derive capture record flags from PPDU status
+ * @rx_status: PPDU rx status
+ *
+ * Return: CDP_MON_CAP_FLAG_* bitmap
+ */
+static inline uint32_t
+dp_rx_mon_cap_ring_flags(struct mon_rx_status *rx_status)
+{
+	uint32_t flags = 0;
+
+	if (rx_status->rs_fcs_err)
+		flags |= CDP_MON_CAP_FLAG_FCS_ERR;
+	if (rx_status->sgi)
+		flags |= CDP_MON_CAP_FLAG_SGI;
+	if (rx_status->ldpc)
+		flags |= CDP_MON_CAP_FLAG_LDPC;
+	if (rx_status->is_stbc)
+		flags |= CDP_MON_CAP_FLAG_STBC;
+
+	return flags;
+}
+
+QDF_STATUS dp_rx_mon_cap_ring_deliver(struct dp_soc *soc, struct dp_pdev *pdev,
+				      qdf_nbuf_t mpdu)
+{
+	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
+	struct dp_mon_cap_ring *cap_ring = mon_pdev->cap_ring;
+	struct mon_rx_status *rx_status = &mon_pdev->ppdu_info.rx_status;
+	struct cdp_mon_cap_hdr *hdr;
+	uint32_t orig_len, cap_len, rec_len, flags;
+	uint32_t seq;
+
+	orig_len = qdf_nbuf_len(mpdu);
+	cap_len = orig_len;
+	if (cap_ring->snaplen && cap_len > cap_ring->snaplen)
+		cap_len = cap_ring->snaplen;
+
+	/* a record never spans sub-buffers, clip what does not fit */
+	if (cap_len > cap_ring->max_rec_len - sizeof(*hdr))
+		cap_len = cap_ring->max_rec_len - sizeof(*hdr);
+
+	flags = dp_rx_mon_cap_ring_flags(rx_status);
+	if (cap_len < orig_len) {
+		flags |= CDP_MON_CAP_FLAG_TRUNCATED;
+		cap_ring->stats.mpdu_truncated++;
+	}
+
+	/* consume the sequence number even on drop to expose the gap */
+	seq = cap_ring->seq++;
+	rec_len = qdf_roundup(sizeof(*hdr) + cap_len, sizeof(uint32_t));
+	hdr = qdf_streamfs_reserve(cap_ring->chan, rec_len);
+	if (!hdr) {
+		cap_ring->stats.drop_ring_full++;
+		qdf_nbuf_free(mpdu);
+		return QDF_STATUS_E_RESOURCES;
+	}
+
+	hdr->magic = CDP_MON_CAP_HDR_MAGIC;
+	hdr->version = CDP_MON_CAP_HDR_VERSION;
+	hdr->hdr_len = sizeof(*hdr);
+	hdr->rec_len = rec_len;
+	hdr->cap_len = cap_len;
+	hdr->orig_len = orig_len;
+	hdr->seq = seq;
+	hdr->ppdu_id = mon_pdev->ppdu_info.com_info.ppdu_id;
+	hdr->tsft = rx_status->tsft;
+	hdr->chan_freq = rx_status->chan_freq;
+	hdr->chan_noise_floor = pdev->chan_noise_floor;
+	hdr->rssi_comb = rx_status->rssi_comb;
+	hdr->preamble_type = rx_status->preamble_type;
+	hdr->mcs = rx_status->mcs;
+	hdr->nss = rx_status->nss;
+	hdr->bw = rx_status->bw;
+	hdr->reception_type = rx_status->reception_type;
+	hdr->reserved = 0;
+	hdr->flags = flags;
+
+	qdf_nbuf_copy_bits(mpdu, 0, cap_len, (uint8_t *)(hdr + 1));
+
+	cap_ring->stats.mpdu_captured++;
+	cap_ring->stats.bytes_captured += cap_len;
+	qdf_nbuf_free(mpdu);
+
+	return QDF_STATUS_SUCCESS;
+}
+#endif /* QCA_MONITOR_CAP_RING */
+
 qdf_nbuf_t
 dp_rx_nbuf_prepare(struct dp_soc *soc, struct dp_pdev *pdev)
 {
@@ -1468,7 +1557,7 @@ QDF_STATUS dp_rx_mon_deliver(struct dp_soc *soc, uint32_t mac_id,
 	rs = &mon_pdev->rx_mon_recv_status;
 
 	if (!mon_pdev->mvdev && !mon_pdev->mcopy_mode &&
-	    !mon_pdev->rx_pktlog_cbf)
+	    !mon_pdev->rx_pktlog_cbf && !dp_rx_mon_cap_ring_enabled(mon_pdev))
 		goto mon_deliver_fail;
 
 	/* restitch mon MPDU for delivery via monitor interface */
@@ -1478,11 +1567,16 @@ QDF_STATUS dp_rx_mon_deliver(struct dp_soc *soc, uint32_t mac_id,
 	/* If MPDU restitch fails, free buffers*/
 	if (!mon_mpdu) {
 		dp_info("MPDU restitch failed, free buffers");
+		dp_rx_mon_cap_ring_restitch_drop(mon_pdev);
 		goto mon_deliver_fail;
 	}
 
 	dp_rx_mon_process_dest_pktlog(soc, mac_id, mon_mpdu);
 
+	/* capture ring bypasses radiotap and the monitor netdev */
+	if (dp_rx_mon_cap_ring_enabled(mon_pdev))
+		return dp_rx_mon_cap_ring_deliver(soc, pdev, mon_mpdu);
+
 	/* monitor vap cannot be present when mcopy is enabled
 	 * hence same skb can be consumed
 	 */
@@ -417,6 +417,31 @@ dp_rx_process_mcopy_mode(struct dp_soc *soc, struct dp_pdev *pdev,
 }
 #endif /* QCA_MCOPY_SUPPORT */
 
+#ifdef QCA_MONITOR_CAP_RING
+/**
+ * dp_rx_mon_cap_ring_deliver() - write a restitched MPDU to the capture ring
+ * @soc: core txrx main context
+ * @pdev: pdev structure
+ * @mpdu: restitched MPDU, consumed by this function
+ *
+ * The MPDU is prefixed with a struct cdp_mon_cap_hdr built from the current
+ * PPDU status and copied into a reserved slot of the stream channel, no
+ * radiotap header is built and nothing is handed to the network stack.
+ * Must be called with mon_lock held.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_rx_mon_cap_ring_deliver(struct dp_soc *soc, struct dp_pdev *pdev,
+				      qdf_nbuf_t mpdu);
+#else
+static inline QDF_STATUS
+dp_rx_mon_cap_ring_deliver(struct dp_soc *soc, struct dp_pdev *pdev,
+			   qdf_nbuf_t mpdu)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif /* QCA_MONITOR_CAP_RING */
+
 /**
  * dp_rx_handle_smart_mesh_mode() - Deliver header for smart mesh
  * @soc: Datapath SOC handle
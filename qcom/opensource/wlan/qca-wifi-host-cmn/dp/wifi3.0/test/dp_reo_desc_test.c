@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_list.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "dp_types.h"
+#include "dp_peer.h"
+#include "dp_reo_desc_test.h"
+
+#define ut_reo_desc_num 8
+#define ut_reo_desc_now (10 * REO_DESC_FREE_DEFER_MS)
+#define ut_reo_desc_aged (ut_reo_desc_now - REO_DESC_FREE_DEFER_MS - 1)
+#define ut_reo_desc_fresh (ut_reo_desc_now - REO_DESC_FREE_DEFER_MS)
+
+#define ut_assert(cond) \
+do { \
+	if (!(cond)) { \
+		qdf_nofl_alert("FAIL: %s:%d assert %s", \
+			       __func__, __LINE__, #cond); \
+		errors++; \
+	} \
+} while (0)
+
+/* the rx tid delete freelist of a stub soc, nothing else is touched */
+struct ut_reo_desc_ctx {
+	struct dp_soc *soc;
+	struct reo_desc_list_node desc[ut_reo_desc_num];
+	uint32_t list_size;
+};
+
+static QDF_STATUS ut_reo_desc_setup(struct ut_reo_desc_ctx *ctx)
+{
+	ctx->soc = qdf_mem_malloc(sizeof(*ctx->soc));
+	if (!ctx->soc)
+		return QDF_STATUS_E_NOMEM;
+
+	qdf_list_create(&ctx->soc->reo_desc_freelist, REO_DESC_FREELIST_SIZE);
+	ctx->list_size = 0;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void ut_reo_desc_teardown(struct ut_reo_desc_ctx *ctx)
+{
+	qdf_list_node_t *node;
+
+	while (qdf_list_remove_front(&ctx->soc->reo_desc_freelist, &node) ==
+	       QDF_STATUS_SUCCESS)
+		;
+
+	qdf_list_destroy(&ctx->soc->reo_desc_freelist);
+	qdf_mem_free(ctx->soc);
+}
+
+static void ut_reo_desc_add(struct ut_reo_desc_ctx *ctx, uint32_t idx,
+			    unsigned long free_ts, bool resend)
+{
+	struct reo_desc_list_node *desc = &ctx->desc[idx];
+
+	qdf_mem_zero(desc, sizeof(*desc));
+	desc->free_ts = free_ts;
+	desc->resend_update_reo_cmd = resend;
+	qdf_list_insert_back(&ctx->soc->reo_desc_freelist,
+			     (qdf_list_node_t *)desc);
+	ctx->list_size++;
+}
+
+/* release with the given limit, return the number of queues released */
+static uint32_t ut_reo_desc_release(struct ut_reo_desc_ctx *ctx,
+				    uint32_t limit, uint32_t *first)
+{
+	struct reo_desc_list_node *desc;
+	uint32_t num = 0;
+
+	while ((desc = dp_reo_desc_freelist_next(ctx->soc, ut_reo_desc_now,
+						 limit, &ctx->list_size))) {
+		if (!num && first)
+			*first = desc - ctx->desc;
+		num++;
+	}
+
+	return num;
+}
+
+static uint32_t ut_reo_desc_defer(void)
+{
+	struct ut_reo_desc_ctx ctx;
+	uint32_t errors = 0;
+	uint32_t first = ut_reo_desc_num;
+	uint32_t i;
+
+	if (QDF_IS_STATUS_ERROR(ut_reo_desc_setup(&ctx)))
+		return 1;
+
+	/* nothing is released from an empty list */
+	ut_assert(!ut_reo_desc_release(&ctx, REO_DESC_FREELIST_SIZE, NULL));
+
+	/* three aged queues ahead of fresh ones, under the limit */
+	for (i = 0; i < 3; i++)
+		ut_reo_desc_add(&ctx, i, ut_reo_desc_aged, false);
+	for (; i < ut_reo_desc_num; i++)
+		ut_reo_desc_add(&ctx, i, ut_reo_desc_fresh, false);
+
+	ut_assert(ut_reo_desc_release(&ctx, REO_DESC_FREELIST_SIZE,
+				      &first) == 3);
+	ut_assert(first == 0);
+	ut_assert(ctx.list_size == ut_reo_desc_num - 3);
+	ut_assert(qdf_list_size(&ctx.soc->reo_desc_freelist) ==
+		  ut_reo_desc_num - 3);
+
+	/* the remaining queues are all within REO_DESC_FREE_DEFER_MS */
+	ut_assert(!ut_reo_desc_release(&ctx, REO_DESC_FREELIST_SIZE, NULL));
+
+	ut_reo_desc_teardown(&ctx);
+
+	return errors;
+}
+
+static uint32_t ut_reo_desc_limit(void)
+{
+	struct ut_reo_desc_ctx ctx;
+	uint32_t errors = 0;
+	uint32_t first = ut_reo_desc_num;
+	uint32_t limit = 5;
+	uint32_t i;
+
+	if (QDF_IS_STATUS_ERROR(ut_reo_desc_setup(&ctx)))
+		return 1;
+
+	for (i = 0; i < ut_reo_desc_num; i++)
+		ut_reo_desc_add(&ctx, i, ut_reo_desc_fresh, false);
+
+	/* over the limit only the oldest queues are trimmed, not the list */
+	ut_assert(ut_reo_desc_release(&ctx, limit, &first) ==
+		  ut_reo_desc_num - limit + 1);
+	ut_assert(first == 0);
+	ut_assert(ctx.list_size == limit - 1);
+	ut_assert(qdf_list_size(&ctx.soc->reo_desc_freelist) == limit - 1);
+
+	ut_reo_desc_teardown(&ctx);
+
+	return errors;
+}
+
+static uint32_t ut_reo_desc_resend(void)
+{
+	struct ut_reo_desc_ctx ctx;
+	uint32_t errors = 0;
+	uint32_t first = ut_reo_desc_num;
+
+	if (QDF_IS_STATUS_ERROR(ut_reo_desc_setup(&ctx)))
+		return 1;
+
+	/* a fresh queue with a pending update is released, the next one not */
+	ut_reo_desc_add(&ctx, 0, ut_reo_desc_fresh, true);
+	ut_reo_desc_add(&ctx, 1, ut_reo_desc_fresh, false);
+
+	ut_assert(ut_reo_desc_release(&ctx, REO_DESC_FREELIST_SIZE,
+				      &first) == 1);
+	ut_assert(first == 0);
+	ut_assert(ctx.list_size == 1);
+
+	ut_reo_desc_teardown(&ctx);
+
+	return errors;
+}
+
+#ifdef WLAN_DP_REO_DESC_BATCH_FLUSH
+static uint32_t ut_reo_desc_limit_scale(void)
+{
+	uint64_t total_kb = 4 * 1024 * 1024;
+	uint32_t errors = 0;
+
+	ut_assert(dp_reo_desc_freelist_limit_scale(0, 0) ==
+		  REO_DESC_FREELIST_SIZE);
+	ut_assert(dp_reo_desc_freelist_limit_scale(total_kb, total_kb / 2) ==
+		  REO_DESC_FREELIST_SIZE);
+	ut_assert(dp_reo_desc_freelist_limit_scale(total_kb, total_kb / 16) ==
+		  REO_DESC_FREELIST_SIZE);
+	ut_assert(dp_reo_desc_freelist_limit_scale(total_kb, total_kb / 32) ==
+		  REO_DESC_FREELIST_SIZE / 2);
+	ut_assert(dp_reo_desc_freelist_limit_scale(total_kb, 0) ==
+		  REO_DESC_FREELIST_MIN_SIZE);
+
+	return errors;
+}
+#else
+static inline uint32_t ut_reo_desc_limit_scale(void)
+{
+	return 0;
+}
+#endif
+
+uint32_t dp_reo_desc_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += ut_reo_desc_defer();
+	errors += ut_reo_desc_limit();
+	errors += ut_reo_desc_resend();
+	errors += ut_reo_desc_limit_scale();
+
+	return errors;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __DP_REO_DESC_TEST
+#define __DP_REO_DESC_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_DP_REO_DESC_TEST
+/**
+ * dp_reo_desc_unit_test() - run the REO queue freelist unit test suite
+ *
+ * Feeds REO queue descriptors of different ages through the rx tid delete
+ * freelist release policy and checks that only aged queues, queues with a
+ * pending REO update and queues over the freelist limit are released, and
+ * how the freelist limit follows the available memory.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t dp_reo_desc_unit_test(void);
+#else
+static inline uint32_t dp_reo_desc_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_DP_REO_DESC_TEST */
+
+#endif /* __DP_REO_DESC_TEST */
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "dp_types.h"
+#include "dp_rx.h"
+#include "dp_rx_desc_test.h"
+
+#define ut_rx_desc_pool_size 4096
+#define ut_rx_desc_ring_size 1024
+#define ut_rx_desc_ring_fill 512
+#define ut_rx_desc_batch 64
+#define ut_rx_desc_cycles 4000
+#define ut_rx_desc_ring 0
+
+/* a standalone pool and a refill ring carrying the posted cookies */
+struct ut_rx_desc_ctx {
+	struct rx_desc_pool pool;
+	uint32_t ring[ut_rx_desc_ring_size];
+	uint32_t head;
+	uint32_t tail;
+};
+
+static QDF_STATUS ut_rx_desc_pool_setup(struct rx_desc_pool *pool)
+{
+	QDF_STATUS status;
+	uint8_t ring;
+
+	pool->desc_type = DP_RX_DESC_BUF_TYPE;
+	status = dp_rx_desc_pool_alloc(NULL, ut_rx_desc_pool_size, pool);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	/* dp_rx_desc_pool_init() without the arch specific cookie setup */
+	qdf_spinlock_create(&pool->lock);
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++)
+		qdf_spinlock_create(&pool->ring_stack[ring].lock);
+	pool->pool_size = ut_rx_desc_pool_size;
+#ifdef RX_DESC_MULTI_PAGE_ALLOC
+	pool->freelist = pool->desc_pages.cacheable_pages[0];
+#else
+	pool->freelist = &pool->array[0];
+#endif
+
+	return dp_rx_desc_pool_init_generic(NULL, pool, 0);
+}
+
+static void ut_rx_desc_pool_teardown(struct rx_desc_pool *pool)
+{
+	uint8_t ring;
+
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++)
+		qdf_spinlock_destroy(&pool->ring_stack[ring].lock);
+	qdf_spinlock_destroy(&pool->lock);
+	dp_rx_desc_pool_free(NULL, pool);
+}
+
+static uint32_t ut_rx_desc_replenish(struct ut_rx_desc_ctx *ctx,
+				     uint16_t num, uint8_t ring)
+{
+	union dp_rx_desc_list_elem_t *list, *tail, *elem;
+	uint16_t num_alloc;
+
+	num_alloc = dp_rx_ring_get_free_desc_list(NULL, 0, &ctx->pool, num,
+						  &list, &tail, ring);
+	for (elem = list; num_alloc && elem; elem = elem->next) {
+		elem->rx_desc.in_use = 1;
+		ctx->ring[ctx->head++ % ut_rx_desc_ring_size] =
+			elem->rx_desc.cookie;
+	}
+
+	if (num_alloc != num) {
+		qdf_nofl_alert("FAIL: %u of %u rx descs allocated",
+			       num_alloc, num);
+		return 1;
+	}
+
+	return 0;
+}
+
+static uint32_t ut_rx_desc_reap(struct ut_rx_desc_ctx *ctx, uint16_t num,
+				uint8_t ring)
+{
+	union dp_rx_desc_list_elem_t *list = NULL, *tail = NULL, *elem;
+	struct dp_rx_desc *rx_desc;
+	uint32_t errors = 0;
+	uint32_t cookie;
+
+	while (num-- && ctx->tail != ctx->head) {
+		cookie = ctx->ring[ctx->tail++ % ut_rx_desc_ring_size];
+		rx_desc = dp_get_rx_desc_from_cookie(NULL, &ctx->pool, cookie);
+		if (rx_desc->cookie != cookie || !rx_desc->in_use)
+			errors++;
+
+		rx_desc->in_use = 0;
+		elem = (union dp_rx_desc_list_elem_t *)rx_desc;
+		elem->next = list;
+		if (!list)
+			tail = elem;
+		list = elem;
+	}
+
+	if (list)
+		dp_rx_ring_add_desc_list_to_free_list(NULL, &list, &tail, 0,
+						      &ctx->pool, ring);
+
+	if (errors)
+		qdf_nofl_alert("FAIL: %u rx cookies did not match", errors);
+
+	return errors;
+}
+
+static uint32_t ut_rx_desc_count_free(struct ut_rx_desc_ctx *ctx)
+{
+	union dp_rx_desc_list_elem_t *elem;
+	uint32_t count = 0;
+	uint8_t ring;
+
+	for (elem = ctx->pool.freelist; elem; elem = elem->next)
+		count++;
+
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++)
+		for (elem = ctx->pool.ring_stack[ring].top; elem;
+		     elem = elem->next)
+			count++;
+
+	return count;
+}
+
+static uint32_t ut_rx_desc_run(const char *name, uint8_t ring)
+{
+	struct ut_rx_desc_ctx *ctx;
+	struct dp_rx_desc_ring_stack *stack;
+	uint32_t errors = 0;
+	uint32_t cycle, num_free;
+	uint64_t start_ns, ns;
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	if (QDF_IS_STATUS_ERROR(ut_rx_desc_pool_setup(&ctx->pool))) {
+		qdf_nofl_alert("FAIL: rx desc pool setup");
+		qdf_mem_free(ctx);
+		return 1;
+	}
+
+	errors += ut_rx_desc_replenish(ctx, ut_rx_desc_ring_fill, ring);
+
+	start_ns = qdf_sched_clock();
+	for (cycle = 0; cycle < ut_rx_desc_cycles && !errors; cycle++) {
+		errors += ut_rx_desc_reap(ctx, ut_rx_desc_batch, ring);
+		errors += ut_rx_desc_replenish(ctx, ut_rx_desc_batch, ring);
+	}
+	ns = qdf_sched_clock() - start_ns;
+
+	errors += ut_rx_desc_reap(ctx, ut_rx_desc_ring_size, ring);
+
+	num_free = ut_rx_desc_count_free(ctx);
+	if (num_free != ut_rx_desc_pool_size) {
+		qdf_nofl_alert("FAIL: %s %u of %u rx descs free after the run",
+			       name, num_free, ut_rx_desc_pool_size);
+		errors++;
+	}
+
+	qdf_nofl_info("dp_rx_desc %s: %llu ns/desc",
+		      name, qdf_do_div(ns, (uint64_t)ut_rx_desc_cycles *
+				       ut_rx_desc_batch * 2));
+
+	if (ring < MAX_REO_DEST_RINGS) {
+		stack = &ctx->pool.ring_stack[ring];
+		qdf_nofl_info("dp_rx_desc %s: stack %u freelist %u spill %u",
+			      name, stack->hit, stack->miss, stack->spill);
+		/* past the first fill every cycle is served by the stack */
+		if (stack->miss > ut_rx_desc_ring_fill) {
+			qdf_nofl_alert("FAIL: %s %u rx descs from the freelist",
+				       name, stack->miss);
+			errors++;
+		}
+	}
+
+	ut_rx_desc_pool_teardown(&ctx->pool);
+	qdf_mem_free(ctx);
+
+	return errors;
+}
+
+/* hand the first @num descs of @list back through @ring */
+static void ut_rx_desc_give(struct ut_rx_desc_ctx *ctx,
+			    union dp_rx_desc_list_elem_t **list,
+			    uint32_t num, uint8_t ring)
+{
+	union dp_rx_desc_list_elem_t *head = *list, *tail = NULL;
+
+	while (num-- && *list) {
+		tail = *list;
+		*list = tail->next;
+	}
+
+	if (!tail)
+		return;
+
+	tail->next = NULL;
+	dp_rx_ring_add_desc_list_to_free_list(NULL, &head, &tail, 0,
+					      &ctx->pool, ring);
+}
+
+/* full ring stacks drain when a ringless replenish runs out */
+static uint32_t ut_rx_desc_drain(void)
+{
+	union dp_rx_desc_list_elem_t *list, *tail;
+	struct ut_rx_desc_ctx *ctx;
+	struct dp_rx_desc_ring_stack *stack;
+	uint32_t errors = 0;
+	uint16_t num;
+	uint8_t ring;
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	if (QDF_IS_STATUS_ERROR(ut_rx_desc_pool_setup(&ctx->pool))) {
+		qdf_nofl_alert("FAIL: rx desc pool setup");
+		qdf_mem_free(ctx);
+		return 1;
+	}
+
+	num = dp_rx_ring_get_free_desc_list(NULL, 0, &ctx->pool,
+					    ut_rx_desc_pool_size, &list, &tail,
+					    DP_RX_DESC_NO_RING);
+	if (num != ut_rx_desc_pool_size) {
+		qdf_nofl_alert("FAIL: %u of %u rx descs in a fresh pool",
+			       num, ut_rx_desc_pool_size);
+		errors++;
+	}
+
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++)
+		ut_rx_desc_give(ctx, &list, DP_RX_DESC_RING_STACK_SIZE, ring);
+	ut_rx_desc_give(ctx, &list, ut_rx_desc_pool_size,
+			DP_RX_DESC_NO_RING);
+
+	num = dp_rx_ring_get_free_desc_list(NULL, 0, &ctx->pool,
+					    ut_rx_desc_pool_size, &list, &tail,
+					    DP_RX_DESC_NO_RING);
+	if (num != ut_rx_desc_pool_size) {
+		qdf_nofl_alert("FAIL: %u of %u rx descs reachable without a ring",
+			       num, ut_rx_desc_pool_size);
+		errors++;
+	}
+
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++) {
+		stack = &ctx->pool.ring_stack[ring];
+		if (stack->top || stack->count ||
+		    stack->drain != DP_RX_DESC_RING_STACK_SIZE) {
+			qdf_nofl_alert("FAIL: ring %u stack holds %u drained %u",
+				       ring, stack->count, stack->drain);
+			errors++;
+		}
+	}
+
+	ut_rx_desc_give(ctx, &list, ut_rx_desc_pool_size,
+			DP_RX_DESC_NO_RING);
+	num = ut_rx_desc_count_free(ctx);
+	if (num != ut_rx_desc_pool_size) {
+		qdf_nofl_alert("FAIL: drain %u of %u rx descs free after the run",
+			       num, ut_rx_desc_pool_size);
+		errors++;
+	}
+
+	ut_rx_desc_pool_teardown(&ctx->pool);
+	qdf_mem_free(ctx);
+
+	return errors;
+}
+
+uint32_t dp_rx_desc_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += ut_rx_desc_run("freelist", DP_RX_DESC_NO_RING);
+	errors += ut_rx_desc_run("ring stack", ut_rx_desc_ring);
+	errors += ut_rx_desc_drain();
+
+	return errors;
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __DP_RX_DESC_TEST
+#define __DP_RX_DESC_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_DP_RX_DESC_TEST
+/**
+ * dp_rx_desc_unit_test() - run the rx descriptor pool unit test suite
+ *
+ * Runs replenish/reap cycles over a standalone rx descriptor pool, once
+ * through the pool freelist and once through a REO ring free stack, checks
+ * the cookie lookups and that no descriptor is lost, and logs the host
+ * cost per descriptor of each path. Then fills every REO ring free stack
+ * and checks a replenish without a ring still gets the whole pool.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t dp_rx_desc_unit_test(void);
+#else
+static inline uint32_t dp_rx_desc_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_DP_RX_DESC_TEST */
+
+#endif /* __DP_RX_DESC_TEST */
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_file.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "dp_sim.h"
+#include "dp_sim_test.h"
+
+#define ut_sim_ring_size 512
+#define ut_sim_pkts 20000
+#define ut_sim_pcap_hdr_len 24
+#define ut_sim_pcap_rec_hdr_len 16
+#define ut_sim_pcap_path "wlan/dp_sim.pcap"
+
+static const uint16_t ut_sim_frame_lens[] = { 64, 590, 1514 };
+
+static void ut_sim_put_u32(uint8_t *p, uint32_t val)
+{
+	p[0] = val & 0xff;
+	p[1] = (val >> 8) & 0xff;
+	p[2] = (val >> 16) & 0xff;
+	p[3] = (val >> 24) & 0xff;
+}
+
+/* little endian, microsecond resolution, LINKTYPE_ETHERNET */
+static uint8_t *ut_sim_pcap_build(qdf_size_t *len)
+{
+	uint8_t *pcap, *rec;
+	qdf_size_t size = ut_sim_pcap_hdr_len;
+	uint32_t i, j;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(ut_sim_frame_lens); i++)
+		size += ut_sim_pcap_rec_hdr_len + ut_sim_frame_lens[i];
+
+	pcap = qdf_mem_malloc(size);
+	if (!pcap)
+		return NULL;
+
+	ut_sim_put_u32(pcap, 0xa1b2c3d4);
+	pcap[4] = 2;
+	pcap[6] = 4;
+	ut_sim_put_u32(pcap + 16, 65535);
+	ut_sim_put_u32(pcap + 20, 1);
+
+	rec = pcap + ut_sim_pcap_hdr_len;
+	for (i = 0; i < QDF_ARRAY_SIZE(ut_sim_frame_lens); i++) {
+		ut_sim_put_u32(rec + 8, ut_sim_frame_lens[i]);
+		ut_sim_put_u32(rec + 12, ut_sim_frame_lens[i]);
+		rec += ut_sim_pcap_rec_hdr_len;
+		/* broadcast IPv4 frame with a payload pattern */
+		qdf_mem_set(rec, 6, 0xff);
+		rec[12] = 0x08;
+		for (j = 14; j < ut_sim_frame_lens[i]; j++)
+			rec[j] = j;
+		rec += ut_sim_frame_lens[i];
+	}
+
+	*len = size;
+
+	return pcap;
+}
+
+static uint32_t ut_sim_check(const char *name, struct dp_sim_params *params,
+			     struct dp_sim_result *res, uint64_t rx_bytes)
+{
+	uint32_t errors = 0;
+
+	qdf_nofl_info("dp_sim %s data path: rx %llu pps %llu ns/pkt %llu cycles/pkt, tx %llu pps %llu ns/pkt %llu cycles/pkt, starved %u full %u",
+		      name, res->rx_pps, res->rx_ns_per_pkt,
+		      res->rx_cycles_per_pkt, res->tx_pps, res->tx_ns_per_pkt,
+		      res->tx_cycles_per_pkt, res->target_rx_starved,
+		      res->target_ring_full);
+
+	if (params->rx && (res->rx_pkts != params->num_pkts || res->rx_err ||
+			   res->rx_alloc_fail)) {
+		qdf_nofl_alert("FAIL: %s rx %llu of %u, %u errors, %u alloc failures",
+			       name, res->rx_pkts, params->num_pkts,
+			       res->rx_err, res->rx_alloc_fail);
+		errors++;
+	}
+
+	if (params->rx && rx_bytes && res->rx_bytes != rx_bytes) {
+		qdf_nofl_alert("FAIL: %s rx %llu bytes, expected %llu",
+			       name, res->rx_bytes, rx_bytes);
+		errors++;
+	}
+
+	if (params->tx && (res->tx_pkts != params->num_pkts ||
+			   res->tx_comp != params->num_pkts || res->tx_err)) {
+		qdf_nofl_alert("FAIL: %s tx %llu comp %llu of %u, %u errors",
+			       name, res->tx_pkts, res->tx_comp,
+			       params->num_pkts, res->tx_err);
+		errors++;
+	}
+
+	return errors;
+}
+
+static uint32_t ut_sim_synthetic(struct dp_sim *sim)
+{
+	struct dp_sim_params params = { .num_pkts = ut_sim_pkts };
+	struct dp_sim_result res;
+	uint64_t rx_bytes = 0;
+	uint32_t errors = 0;
+	qdf_size_t len;
+	uint8_t *pcap;
+	uint32_t i;
+	QDF_STATUS status;
+
+	pcap = ut_sim_pcap_build(&len);
+	if (!pcap)
+		return 1;
+
+	/* a bad magic and a truncated header are rejected */
+	pcap[0] ^= 0xff;
+	if (dp_sim_load_pcap(sim, pcap, len) != QDF_STATUS_E_INVAL) {
+		qdf_nofl_alert("FAIL: pcap with bad magic loaded");
+		errors++;
+	}
+	pcap[0] ^= 0xff;
+
+	if (dp_sim_load_pcap(sim, pcap, ut_sim_pcap_hdr_len - 1) !=
+	    QDF_STATUS_E_INVAL) {
+		qdf_nofl_alert("FAIL: truncated pcap loaded");
+		errors++;
+	}
+
+	status = dp_sim_load_pcap(sim, pcap, len);
+	qdf_mem_free(pcap);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_nofl_alert("FAIL: pcap load status %d", status);
+		return errors + 1;
+	}
+
+	/* the target cycles through the frames from the first one */
+	for (i = 0; i < ut_sim_pkts; i++)
+		rx_bytes += ut_sim_frame_lens[i %
+					QDF_ARRAY_SIZE(ut_sim_frame_lens)];
+
+	params.rx = true;
+	status = dp_sim_run(sim, &params, &res);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_nofl_alert("FAIL: rx run status %d", status);
+		return errors + 1;
+	}
+	errors += ut_sim_check("rx", &params, &res, rx_bytes);
+
+	params.rx = false;
+	params.tx = true;
+	status = dp_sim_run(sim, &params, &res);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_nofl_alert("FAIL: tx run status %d", status);
+		return errors + 1;
+	}
+	errors += ut_sim_check("tx", &params, &res, 0);
+
+	params.rx = true;
+	status = dp_sim_run(sim, &params, &res);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_nofl_alert("FAIL: rx/tx run status %d", status);
+		return errors + 1;
+	}
+	errors += ut_sim_check("rx/tx", &params, &res, 0);
+
+	return errors;
+}
+
+/* optional, for replaying a real capture */
+static uint32_t ut_sim_pcap_file(struct dp_sim *sim)
+{
+	struct dp_sim_params params = {
+		.num_pkts = ut_sim_pkts,
+		.rx = true,
+		.tx = true,
+	};
+	struct dp_sim_result res;
+	qdf_size_t len;
+	char *pcap;
+	QDF_STATUS status;
+
+	if (QDF_IS_STATUS_ERROR(qdf_file_read_bytes(ut_sim_pcap_path, &pcap,
+						    &len)))
+		return 0;
+
+	status = dp_sim_load_pcap(sim, (uint8_t *)pcap, len);
+	qdf_file_buf_free(pcap);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_nofl_alert("FAIL: %s load status %d", ut_sim_pcap_path,
+			       status);
+		return 1;
+	}
+
+	status = dp_sim_run(sim, &params, &res);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_nofl_alert("FAIL: %s run status %d", ut_sim_pcap_path,
+			       status);
+		return 1;
+	}
+
+	return ut_sim_check(ut_sim_pcap_path, &params, &res, 0);
+}
+
+uint32_t dp_sim_unit_test(qdf_device_t osdev,
+			  struct hif_opaque_softc *hif_handle,
+			  struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
+{
+	struct dp_sim *sim;
+	uint32_t errors = 0;
+
+	sim = dp_sim_attach(osdev, hif_handle, ctrl_psoc, 0,
+			    ut_sim_ring_size);
+	if (!sim) {
+		qdf_nofl_alert("FAIL: dp sim attach");
+		return 1;
+	}
+
+	errors += ut_sim_synthetic(sim);
+	errors += ut_sim_pcap_file(sim);
+
+	dp_sim_detach(sim);
+
+	return errors;
+}
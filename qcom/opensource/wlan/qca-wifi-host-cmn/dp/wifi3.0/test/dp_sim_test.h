@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __DP_SIM_TEST
+#define __DP_SIM_TEST
+
+#include "qdf_types.h"
+#include "cdp_txrx_handle.h"
+
+struct hif_opaque_softc;
+
+#ifdef WLAN_DP_SIM_TEST
+/**
+ * dp_sim_unit_test() - run the DP simulator unit test suite
+ * @osdev: QDF device of the loaded driver
+ * @hif_handle: HIF handle of the loaded driver
+ * @ctrl_psoc: control path psoc of the loaded driver
+ *
+ * Runs the receive and transmit data path handlers against the simulated
+ * rings over a synthetic capture, and over wlan/dp_sim.pcap when the
+ * firmware path holds one, and logs the packet rate and the host cost per
+ * packet of the handlers.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t dp_sim_unit_test(qdf_device_t osdev,
+			  struct hif_opaque_softc *hif_handle,
+			  struct cdp_ctrl_objmgr_psoc *ctrl_psoc);
+#else
+static inline
+uint32_t dp_sim_unit_test(qdf_device_t osdev,
+			  struct hif_opaque_softc *hif_handle,
+			  struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
+{
+	return 0;
+}
+#endif /* WLAN_DP_SIM_TEST */
+
+#endif /* __DP_SIM_TEST */
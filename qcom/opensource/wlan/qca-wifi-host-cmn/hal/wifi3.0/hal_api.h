@@ -854,6 +854,30 @@ void *hal_attach(struct hif_opaque_softc *hif_handle, qdf_device_t qdf_dev);
  */
 extern void hal_detach(void *hal_soc);
 
+#ifdef WLAN_DP_SIM
+/**
+ * hal_sim_attach() - Initialize a host only HAL instance
+ * @qdf_dev: QDF device
+ * @target_type: target whose ring layout and descriptor ops are used
+ *
+ * Rings set up on this instance keep their head and tail pointers in host
+ * memory and are never programmed into HW, so that a simulated target can
+ * service them. The SRNG HW init ops of the target are replaced for this,
+ * hal_srng_setup() itself is unchanged.
+ *
+ * Return: Opaque HAL SOC handle, NULL on failure or unsupported target
+ */
+void *hal_sim_attach(qdf_device_t qdf_dev, uint32_t target_type);
+
+/**
+ * hal_sim_detach() - Detach a host only HAL instance
+ * @hal_soc: HAL SOC handle from hal_sim_attach()
+ *
+ * Return: None
+ */
+void hal_sim_detach(void *hal_soc);
+#endif
+
 #define HAL_SRNG_LMAC_RING 0x80000000
 /* SRNG flags passed in hal_srng_params.flags */
 #define HAL_SRNG_MSI_SWAP				0x00000008
@@ -1193,6 +1193,128 @@ extern void hal_detach(void *hal_soc)
 }
 qdf_export_symbol(hal_detach);
 
+#ifdef WLAN_DP_SIM
+/*
+ * Host pointers of the rings which are not LMAC rings are kept past the
+ * ones LMAC rings use, which are indexed from HAL_SRNG_LMAC1_ID_START.
+ */
+#define HAL_SIM_HOST_PTR(hal, ring_id) \
+	(&(hal)->shadow_wrptr_mem_vaddr[HAL_SRNG_ID_MAX + (ring_id)])
+
+static qdf_iomem_t hal_sim_get_window_address(struct hal_soc *hal,
+					      qdf_iomem_t addr)
+{
+	return addr;
+}
+
+/**
+ * hal_sim_srng_src_hw_init() - set up a simulated source ring
+ * @hal: HAL instance from hal_sim_attach()
+ * @srng: ring being set up
+ *
+ * Instead of programming the ring into HW, the head pointer is moved to
+ * host memory where the simulated target reads it, same as FW does for
+ * LMAC rings.
+ *
+ * Return: None
+ */
+static void hal_sim_srng_src_hw_init(struct hal_soc *hal,
+				     struct hal_srng *srng)
+{
+	srng->u.src_ring.hp_addr = HAL_SIM_HOST_PTR(hal, srng->ring_id);
+	srng->flags |= HAL_SRNG_LMAC_RING;
+}
+
+/**
+ * hal_sim_srng_dst_hw_init() - set up a simulated destination ring
+ * @hal: HAL instance from hal_sim_attach()
+ * @srng: ring being set up
+ *
+ * Same as hal_sim_srng_src_hw_init(), for the tail pointer.
+ *
+ * Return: None
+ */
+static void hal_sim_srng_dst_hw_init(struct hal_soc *hal,
+				     struct hal_srng *srng)
+{
+	srng->u.dst_ring.tp_addr = HAL_SIM_HOST_PTR(hal, srng->ring_id);
+	srng->flags |= HAL_SRNG_LMAC_RING;
+}
+
+void *hal_sim_attach(qdf_device_t qdf_dev, uint32_t target_type)
+{
+	struct hal_soc *hal;
+	int i;
+
+	hal = qdf_mem_malloc(sizeof(*hal));
+	if (!hal)
+		return NULL;
+
+	hal->qdf_dev = qdf_dev;
+	hal->target_type = target_type;
+
+	hal->shadow_rdptr_mem_vaddr =
+		qdf_mem_malloc(sizeof(*hal->shadow_rdptr_mem_vaddr) *
+			       HAL_SRNG_ID_MAX);
+	if (!hal->shadow_rdptr_mem_vaddr)
+		goto fail0;
+
+	hal->shadow_wrptr_mem_vaddr =
+		qdf_mem_malloc(sizeof(*hal->shadow_wrptr_mem_vaddr) *
+			       HAL_SRNG_ID_MAX * 2);
+	if (!hal->shadow_wrptr_mem_vaddr)
+		goto fail1;
+
+	for (i = 0; i < HAL_SRNG_ID_MAX; i++) {
+		hal->srng_list[i].initialized = 0;
+		hal->srng_list[i].ring_id = i;
+	}
+
+	qdf_spinlock_create(&hal->register_access_lock);
+
+	hal->ops = qdf_mem_malloc(sizeof(*hal->ops));
+	if (!hal->ops)
+		goto fail2;
+
+	hal_target_based_configure(hal);
+	if (!hal->hw_srng_table) {
+		hal_err("target type %u not supported", target_type);
+		goto fail3;
+	}
+
+	/* rings are serviced by the simulated target, never by HW */
+	hal->ops->hal_get_window_address = hal_sim_get_window_address;
+	hal->ops->hal_srng_src_hw_init = hal_sim_srng_src_hw_init;
+	hal->ops->hal_srng_dst_hw_init = hal_sim_srng_dst_hw_init;
+
+	return (void *)hal;
+
+fail3:
+	qdf_mem_free(hal->ops);
+fail2:
+	qdf_spinlock_destroy(&hal->register_access_lock);
+	qdf_mem_free(hal->shadow_wrptr_mem_vaddr);
+fail1:
+	qdf_mem_free(hal->shadow_rdptr_mem_vaddr);
+fail0:
+	qdf_mem_free(hal);
+	return NULL;
+}
+qdf_export_symbol(hal_sim_attach);
+
+void hal_sim_detach(void *hal_soc)
+{
+	struct hal_soc *hal = (struct hal_soc *)hal_soc;
+
+	qdf_mem_free(hal->ops);
+	qdf_spinlock_destroy(&hal->register_access_lock);
+	qdf_mem_free(hal->shadow_wrptr_mem_vaddr);
+	qdf_mem_free(hal->shadow_rdptr_mem_vaddr);
+	qdf_mem_free(hal);
+}
+qdf_export_symbol(hal_sim_detach);
+#endif
+
 #define HAL_CE_CHANNEL_DST_DEST_CTRL_ADDR(x)		((x) + 0x000000b0)
 #define HAL_CE_CHANNEL_DST_DEST_CTRL_DEST_MAX_LENGTH_BMSK	0x0000ffff
 #define HAL_CE_CHANNEL_DST_DEST_RING_CONSUMER_PREFETCH_TIMER_ADDR(x)	((x) + 0x00000040)
@@ -343,6 +343,60 @@ QDF_STATUS ce_completed_recv_next(struct CE_handle *copyeng,
 				  unsigned int *transfer_idp,
 				  unsigned int *flagsp);
 
+#ifdef HIF_CE_RECV_BATCH
+/* max descriptors reaped or posted in one ring transaction */
+#define CE_RECV_BATCH_MAX 16
+
+/**
+ * struct ce_recv_completion - one completed receive descriptor
+ * @transfer_context: per transfer context posted with the buffer
+ * @buffer: DMA address of the buffer
+ * @nbytes: number of bytes received
+ * @transfer_id: transfer id / meta data
+ * @flags: CE_RECV_FLAG_*
+ */
+struct ce_recv_completion {
+	void *transfer_context;
+	qdf_dma_addr_t buffer;
+	unsigned int nbytes;
+	unsigned int transfer_id;
+	unsigned int flags;
+};
+
+/**
+ * ce_completed_recv_batch() - reap a batch of completed receive descriptors
+ * @copyeng: which copy engine to use
+ * @comp: array receiving the completions
+ * @max: size of @comp
+ *
+ * On SRNG based copy engines the status ring is accessed, and its tail
+ * pointer updated, once for the whole batch.
+ *
+ * Return: number of completions stored in @comp
+ */
+uint32_t ce_completed_recv_batch(struct CE_handle *copyeng,
+				 struct ce_recv_completion *comp,
+				 uint32_t max);
+
+/**
+ * ce_recv_buf_enqueue_batch() - post a batch of receive buffers
+ * @copyeng: which copy engine to use
+ * @per_recv_context: per transfer contexts of the buffers
+ * @buffer: DMA addresses of the buffers
+ * @num: number of buffers
+ *
+ * On SRNG based copy engines the destination ring head pointer is
+ * updated once for the whole batch. Buffers are posted in order and
+ * posting stops at the first one that does not fit.
+ *
+ * Return: number of buffers posted
+ */
+uint32_t ce_recv_buf_enqueue_batch(struct CE_handle *copyeng,
+				   void **per_recv_context,
+				   qdf_dma_addr_t *buffer,
+				   uint32_t num);
+#endif /* HIF_CE_RECV_BATCH */
+
 /**
  * ce_completed_send_next() - Supply data for the next completed unprocessed
  * send descriptor.
@@ -591,6 +645,16 @@ struct ce_ops {
 			    int *num_shadow_registers_configured);
 	int (*ce_get_index_info)(struct hif_softc *scn, void *ce_state,
 				 struct ce_index *info);
+#ifdef HIF_CE_RECV_BATCH
+	uint32_t (*ce_completed_recv_batch_nolock)(
+			struct CE_state *CE_state,
+			struct ce_recv_completion *comp,
+			uint32_t max);
+	uint32_t (*ce_recv_buf_enqueue_batch)(struct CE_handle *copyeng,
+					      void **per_recv_context,
+					      qdf_dma_addr_t *buffer,
+					      uint32_t num);
+#endif
 };
 
 int hif_ce_bus_early_suspend(struct hif_softc *scn);
@@ -2855,6 +2855,82 @@ static inline void hif_ce_do_recv(struct hif_msg_callbacks *msg_callbacks,
 	}
 }
 
+#ifdef HIF_CE_RECV_BATCH
+/**
+ * hif_pci_ce_recv_data() - receive handler for a CE pipe
+ * @copyeng: copy engine handle
+ * @ce_context: pipe info of the CE
+ * @transfer_context: nbuf of the first completion
+ * @CE_data: DMA address of the first completion
+ * @nbytes: length of the first completion
+ * @transfer_id: transfer id of the first completion
+ * @flags: flags of the first completion
+ *
+ * Called by lower (CE) layer when data is received from the Target.
+ * Completions are reaped from the ring CE_RECV_BATCH_MAX at a time, the
+ * ring is refilled once per batch and the batch is then handed to the
+ * upper layer in order.
+ *
+ * Return: None
+ */
+static void
+hif_pci_ce_recv_data(struct CE_handle *copyeng, void *ce_context,
+		     void *transfer_context, qdf_dma_addr_t CE_data,
+		     unsigned int nbytes, unsigned int transfer_id,
+		     unsigned int flags)
+{
+	struct HIF_CE_pipe_info *pipe_info =
+		(struct HIF_CE_pipe_info *)ce_context;
+	struct HIF_CE_state *hif_state = pipe_info->HIF_CE_state;
+	struct CE_state *ce_state = (struct CE_state *) copyeng;
+	struct hif_softc *scn = HIF_GET_SOFTC(hif_state);
+	struct hif_opaque_softc *hif_ctx = GET_HIF_OPAQUE_HDL(scn);
+	struct hif_msg_callbacks *msg_callbacks =
+		 &pipe_info->pipe_callbacks;
+	struct ce_recv_completion comp[CE_RECV_BATCH_MAX];
+	uint32_t num, i;
+
+	comp[0].transfer_context = transfer_context;
+	comp[0].buffer = CE_data;
+	comp[0].nbytes = nbytes;
+	comp[0].transfer_id = transfer_id;
+	comp[0].flags = flags;
+	num = 1 + ce_completed_recv_batch(copyeng, &comp[1],
+					  CE_RECV_BATCH_MAX - 1);
+
+	do {
+		hif_pm_runtime_mark_last_busy(hif_ctx);
+		for (i = 0; i < num; i++)
+			qdf_nbuf_unmap_single(scn->qdf_dev,
+					      comp[i].transfer_context,
+					      QDF_DMA_FROM_DEVICE);
+
+		atomic_add(num, &pipe_info->recv_bufs_needed);
+		hif_post_recv_buffers_for_pipe(pipe_info);
+
+		for (i = 0; i < num; i++) {
+			if (scn->target_status == TARGET_STATUS_RESET)
+				qdf_nbuf_free(comp[i].transfer_context);
+			else
+				hif_ce_do_recv(msg_callbacks,
+					       comp[i].transfer_context,
+					       comp[i].nbytes, pipe_info);
+		}
+
+		/* Set up force_break flag if num of receices reaches
+		 * MAX_NUM_OF_RECEIVES
+		 */
+		ce_state->receive_count += num;
+		if (qdf_unlikely(hif_ce_service_should_yield(scn, ce_state))) {
+			ce_state->force_break = 1;
+			break;
+		}
+
+		num = ce_completed_recv_batch(copyeng, comp,
+					      CE_RECV_BATCH_MAX);
+	} while (num);
+}
+#else
 /* Called by lower (CE) layer when data is received from the Target. */
 static void
 hif_pci_ce_recv_data(struct CE_handle *copyeng, void *ce_context,
@@ -2898,6 +2974,7 @@ hif_pci_ce_recv_data(struct CE_handle *copyeng, void *ce_context,
 					&flags) == QDF_STATUS_SUCCESS);
 
 }
+#endif /* HIF_CE_RECV_BATCH */
 
 /* TBDXXX: Set CE High Watermark; invoke txResourceAvailHandler in response */
 
@@ -3095,6 +3172,151 @@ static void hif_post_recv_buffers_failure(struct HIF_CE_pipe_info *pipe_info,
 
 
 
+#ifdef HIF_CE_RECV_BATCH
+#ifdef WLAN_HIF_CE_RECV_BATCH_TEST
+uint32_t hif_ce_recv_batch_alloc_fails;
+
+static qdf_nbuf_t hif_recv_buf_alloc(struct hif_softc *scn,
+				     struct HIF_CE_pipe_info *pipe_info)
+{
+	if (hif_ce_recv_batch_alloc_fails) {
+		hif_ce_recv_batch_alloc_fails--;
+		return NULL;
+	}
+
+	return qdf_nbuf_alloc(scn->qdf_dev, pipe_info->buf_sz, 0, 4, false);
+}
+#else
+static inline qdf_nbuf_t hif_recv_buf_alloc(struct hif_softc *scn,
+					    struct HIF_CE_pipe_info *pipe_info)
+{
+	return qdf_nbuf_alloc(scn->qdf_dev, pipe_info->buf_sz, 0, 4, false);
+}
+#endif
+
+/**
+ * hif_prepare_recv_buf() - allocate and map one receive buffer
+ * @pipe_info: pipe the buffer is for
+ * @nbuf: allocated buffer
+ * @paddr: DMA address of the buffer
+ *
+ * On failure the buffer slot is returned to recv_bufs_needed.
+ *
+ * Return: QDF_STATUS_SUCCESS if the buffer is ready to be posted
+ */
+static QDF_STATUS hif_prepare_recv_buf(struct HIF_CE_pipe_info *pipe_info,
+				       qdf_nbuf_t *nbuf, qdf_dma_addr_t *paddr)
+{
+	struct hif_softc *scn = HIF_GET_SOFTC(pipe_info->HIF_CE_state);
+	unsigned int ce_id = ((struct CE_state *)pipe_info->ce_hdl)->id;
+	QDF_STATUS status;
+
+	hif_record_ce_desc_event(scn, ce_id, HIF_RX_DESC_PRE_NBUF_ALLOC,
+				 NULL, NULL, 0, 0);
+	*nbuf = hif_recv_buf_alloc(scn, pipe_info);
+	if (!*nbuf) {
+		hif_post_recv_buffers_failure(pipe_info, *nbuf,
+					      &pipe_info->nbuf_alloc_err_count,
+					      HIF_RX_NBUF_ALLOC_FAILURE,
+					      "HIF_RX_NBUF_ALLOC_FAILURE");
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	hif_record_ce_desc_event(scn, ce_id, HIF_RX_DESC_PRE_NBUF_MAP,
+				 NULL, *nbuf, 0, 0);
+	status = qdf_nbuf_map_single(scn->qdf_dev, *nbuf, QDF_DMA_FROM_DEVICE);
+	if (qdf_unlikely(status != QDF_STATUS_SUCCESS)) {
+		hif_post_recv_buffers_failure(pipe_info, *nbuf,
+					      &pipe_info->nbuf_dma_err_count,
+					      HIF_RX_NBUF_MAP_FAILURE,
+					      "HIF_RX_NBUF_MAP_FAILURE");
+		qdf_nbuf_free(*nbuf);
+		return status;
+	}
+
+	*paddr = qdf_nbuf_get_frag_paddr(*nbuf, 0);
+	hif_record_ce_desc_event(scn, ce_id, HIF_RX_DESC_POST_NBUF_MAP,
+				 NULL, *nbuf, 0, 0);
+	qdf_mem_dma_sync_single_for_device(scn->qdf_dev, *paddr,
+					   pipe_info->buf_sz, DMA_FROM_DEVICE);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
+{
+	struct hif_softc *scn = HIF_GET_SOFTC(pipe_info->HIF_CE_state);
+	void *nbufs[CE_RECV_BATCH_MAX];
+	qdf_dma_addr_t paddrs[CE_RECV_BATCH_MAX];
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	uint32_t bufs_posted = 0;
+	uint32_t prepared, posted, i;
+
+	if (pipe_info->buf_sz == 0) {
+		/* Unused Copy Engine */
+		return QDF_STATUS_SUCCESS;
+	}
+
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		/*
+		 * Reserve one needed buffer per allocation, as the unbatched
+		 * path does, so that a failure sees recv_bufs_needed exactly
+		 * as it was before that buffer and still detects an empty ring
+		 */
+		for (prepared = 0; prepared < CE_RECV_BATCH_MAX; prepared++) {
+			qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
+			if (atomic_read(&pipe_info->recv_bufs_needed) <= 0) {
+				qdf_spin_unlock_bh(
+					&pipe_info->recv_bufs_needed_lock);
+				break;
+			}
+			atomic_dec(&pipe_info->recv_bufs_needed);
+			qdf_spin_unlock_bh(&pipe_info->recv_bufs_needed_lock);
+
+			status = hif_prepare_recv_buf(pipe_info,
+						      (qdf_nbuf_t *)
+						      &nbufs[prepared],
+						      &paddrs[prepared]);
+			if (QDF_IS_STATUS_ERROR(status))
+				break;
+		}
+
+		if (!prepared)
+			break;
+
+		posted = ce_recv_buf_enqueue_batch(pipe_info->ce_hdl, nbufs,
+						   paddrs, prepared);
+		for (i = posted; i < prepared; i++) {
+			hif_post_recv_buffers_failure(pipe_info, nbufs[i],
+					&pipe_info->nbuf_ce_enqueue_err_count,
+					HIF_RX_NBUF_ENQUEUE_FAILURE,
+					"HIF_RX_NBUF_ENQUEUE_FAILURE");
+			qdf_nbuf_unmap_single(scn->qdf_dev, nbufs[i],
+					      QDF_DMA_FROM_DEVICE);
+			qdf_nbuf_free(nbufs[i]);
+			status = QDF_STATUS_E_FAILURE;
+		}
+		bufs_posted += posted;
+	}
+
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
+	pipe_info->nbuf_alloc_err_count =
+		(pipe_info->nbuf_alloc_err_count > bufs_posted) ?
+		pipe_info->nbuf_alloc_err_count - bufs_posted : 0;
+	pipe_info->nbuf_dma_err_count =
+		(pipe_info->nbuf_dma_err_count > bufs_posted) ?
+		pipe_info->nbuf_dma_err_count - bufs_posted : 0;
+	pipe_info->nbuf_ce_enqueue_err_count =
+		(pipe_info->nbuf_ce_enqueue_err_count > bufs_posted) ?
+	pipe_info->nbuf_ce_enqueue_err_count - bufs_posted : 0;
+	qdf_spin_unlock_bh(&pipe_info->recv_bufs_needed_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+#else
 QDF_STATUS hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
 {
 	struct CE_handle *ce_hdl;
@@ -3189,6 +3411,7 @@ QDF_STATUS hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
 
 	return QDF_STATUS_SUCCESS;
 }
+#endif /* HIF_CE_RECV_BATCH */
 
 /*
  * Try to post all desired receive buffers for all pipes.
@@ -166,6 +166,44 @@ static inline bool hif_dummy_grp_done(struct hif_exec_context *grp_entry, int
 extern struct hif_execution_ops tasklet_sched_ops;
 extern struct hif_execution_ops napi_sched_ops;
 
+#ifdef HIF_CE_RECV_BATCH
+/* 1, 2, 3-4, 5-8, 9-16 descriptors */
+#define CE_RECV_BATCH_HIST_BINS 5
+
+/**
+ * struct ce_recv_batch_stats - per CE batched receive statistics
+ * @reap_batches: non empty reap transactions on the status ring
+ * @reap_descs: descriptors reaped by those transactions
+ * @reap_hist: histogram of descriptors per reap transaction
+ * @post_batches: non empty post transactions on the destination ring
+ * @post_descs: buffers posted by those transactions
+ * @post_short: post transactions that could not post every buffer
+ */
+struct ce_recv_batch_stats {
+	uint32_t reap_batches;
+	uint32_t reap_descs;
+	uint32_t reap_hist[CE_RECV_BATCH_HIST_BINS];
+	uint32_t post_batches;
+	uint32_t post_descs;
+	uint32_t post_short;
+};
+
+/**
+ * hif_post_recv_buffers_for_pipe() - post receive buffers to a pipe
+ * @pipe_info: pipe to refill
+ *
+ * Posts up to recv_bufs_needed buffers, CE_RECV_BATCH_MAX per ring update.
+ *
+ * Return: QDF_STATUS_SUCCESS if every needed buffer was posted
+ */
+QDF_STATUS hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info);
+
+#ifdef WLAN_HIF_CE_RECV_BATCH_TEST
+/* receive buffer allocations left to fail, for the unit test */
+extern uint32_t hif_ce_recv_batch_alloc_fails;
+#endif
+#endif
+
 /**
  * struct ce_stats
  *
@@ -179,9 +217,13 @@ extern struct hif_execution_ops napi_sched_ops;
  * @ce_tasklet_sched_bucket: Tasklet time in queue buckets
  * @ce_tasklet_exec_last_update: Latest timestamp when bucket is updated
  * @ce_tasklet_sched_last_update: Latest timestamp when bucket is updated
+ * @recv_batch: batched receive statistics of each CE
  */
 struct ce_stats {
 	uint32_t ce_per_cpu[CE_COUNT_MAX][QDF_MAX_AVAILABLE_CPU];
+#ifdef HIF_CE_RECV_BATCH
+	struct ce_recv_batch_stats recv_batch[CE_COUNT_MAX];
+#endif
 #ifdef CE_TASKLET_DEBUG_ENABLE
 	uint32_t record_index[CE_COUNT_MAX];
 	uint64_t tasklet_sched_entry_ts[CE_COUNT_MAX];
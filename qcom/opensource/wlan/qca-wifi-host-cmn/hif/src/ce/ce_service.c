@@ -751,6 +751,48 @@ ce_recv_buf_enqueue(struct CE_handle *copyeng,
 }
 qdf_export_symbol(ce_recv_buf_enqueue);
 
+#ifdef HIF_CE_RECV_BATCH
+uint32_t ce_recv_buf_enqueue_batch(struct CE_handle *copyeng,
+				   void **per_recv_context,
+				   qdf_dma_addr_t *buffer,
+				   uint32_t num)
+{
+	struct CE_state *CE_state = (struct CE_state *)copyeng;
+	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(CE_state->scn);
+	struct ce_ops *ce_services = hif_state->ce_services;
+	struct ce_recv_batch_stats *stats;
+	uint32_t posted = 0;
+
+	if (!num)
+		return 0;
+
+	if (ce_services->ce_recv_buf_enqueue_batch) {
+		posted = ce_services->ce_recv_buf_enqueue_batch(copyeng,
+							per_recv_context,
+							buffer, num);
+	} else {
+		while (posted < num &&
+		       ce_services->ce_recv_buf_enqueue(copyeng,
+						per_recv_context[posted],
+						buffer[posted]) ==
+		       QDF_STATUS_SUCCESS)
+			posted++;
+	}
+
+	stats = &hif_state->stats.recv_batch[CE_state->id];
+	if (posted) {
+		stats->post_batches++;
+		stats->post_descs += posted;
+	}
+	if (posted < num)
+		stats->post_short++;
+
+	return posted;
+}
+
+qdf_export_symbol(ce_recv_buf_enqueue_batch);
+#endif /* HIF_CE_RECV_BATCH */
+
 void
 ce_send_watermarks_set(struct CE_handle *copyeng,
 		       unsigned int low_alert_nentries,
@@ -840,6 +882,50 @@ ce_completed_recv_next(struct CE_handle *copyeng,
 	return status;
 }
 
+#ifdef HIF_CE_RECV_BATCH
+uint32_t ce_completed_recv_batch(struct CE_handle *copyeng,
+				 struct ce_recv_completion *comp,
+				 uint32_t max)
+{
+	struct CE_state *CE_state = (struct CE_state *)copyeng;
+	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(CE_state->scn);
+	struct ce_ops *ce_services = hif_state->ce_services;
+	struct ce_recv_batch_stats *stats;
+	uint32_t num = 0;
+	uint32_t bin = 0;
+	void *ce_context;
+
+	qdf_spin_lock_bh(&CE_state->ce_index_lock);
+	if (ce_services->ce_completed_recv_batch_nolock) {
+		num = ce_services->ce_completed_recv_batch_nolock(CE_state,
+								  comp, max);
+	} else {
+		while (num < max &&
+		       ce_services->ce_completed_recv_next_nolock(
+				CE_state, &ce_context,
+				&comp[num].transfer_context,
+				&comp[num].buffer, &comp[num].nbytes,
+				&comp[num].transfer_id,
+				&comp[num].flags) == QDF_STATUS_SUCCESS)
+			num++;
+	}
+
+	if (num) {
+		stats = &hif_state->stats.recv_batch[CE_state->id];
+		while ((1 << bin) < num && bin < CE_RECV_BATCH_HIST_BINS - 1)
+			bin++;
+		stats->reap_batches++;
+		stats->reap_descs += num;
+		stats->reap_hist[bin]++;
+	}
+	qdf_spin_unlock_bh(&CE_state->ce_index_lock);
+
+	return num;
+}
+
+qdf_export_symbol(ce_completed_recv_batch);
+#endif /* HIF_CE_RECV_BATCH */
+
 QDF_STATUS
 ce_revoke_recv_next(struct CE_handle *copyeng,
 		    void **per_CE_contextp,
@@ -604,6 +604,40 @@ hif_ce_increment_interrupt_count(struct HIF_CE_state *hif_ce_state, int ce_id)
 	hif_ce_state->stats.ce_per_cpu[ce_id][cpu_id]++;
 }
 
+#ifdef HIF_CE_RECV_BATCH
+/**
+ * hif_display_ce_recv_batch_stats() - display batched receive stats
+ * @hif_ce_state: ce state
+ *
+ * Return: none
+ */
+static void
+hif_display_ce_recv_batch_stats(struct HIF_CE_state *hif_ce_state)
+{
+	struct ce_recv_batch_stats *stats;
+	uint8_t i;
+
+	qdf_debug("CE recv batch statistics (reap bins 1 2 3-4 5-8 9-16):");
+	for (i = 0; i < CE_COUNT_MAX; i++) {
+		stats = &hif_ce_state->stats.recv_batch[i];
+		if (!stats->reap_batches && !stats->post_batches)
+			continue;
+
+		qdf_debug("CE id[%2d] - reap %u/%u [%u %u %u %u %u] post %u/%u short %u",
+			  i, stats->reap_descs, stats->reap_batches,
+			  stats->reap_hist[0], stats->reap_hist[1],
+			  stats->reap_hist[2], stats->reap_hist[3],
+			  stats->reap_hist[4], stats->post_descs,
+			  stats->post_batches, stats->post_short);
+	}
+}
+#else
+static inline void
+hif_display_ce_recv_batch_stats(struct HIF_CE_state *hif_ce_state)
+{
+}
+#endif /* HIF_CE_RECV_BATCH */
+
 /**
  * hif_display_ce_stats() - display ce stats
  * @hif_ce_state: ce state
@@ -633,6 +667,8 @@ void hif_display_ce_stats(struct hif_softc *hif_ctx)
 		qdf_debug("CE id[%2d] - %s", i, str_buffer);
 	}
 
+	hif_display_ce_recv_batch_stats(hif_ce_state);
+
 	if (hif_ctx->ce_latency_stats)
 		hif_ce_latency_stats(hif_ctx);
 #undef STR_SIZE
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_defer.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "ce_api.h"
+#include "ce_internal.h"
+#include "ce_main.h"
+#include "hif_ce_recv_batch_test.h"
+
+#define ut_ce_nentries 64
+#define ut_ce_buf_sz 2048
+
+/* a standalone pipe whose refill never reaches a copy engine */
+struct ut_ce_ctx {
+	struct HIF_CE_state hif_state;
+	struct CE_state ce_state;
+	struct CE_ring_state dest_ring;
+	bool oom_ran;
+};
+
+static void ut_ce_oom_work(void *arg)
+{
+	struct ut_ce_ctx *ctx = arg;
+
+	ctx->oom_ran = true;
+}
+
+static struct HIF_CE_pipe_info *ut_ce_setup(struct ut_ce_ctx *ctx)
+{
+	struct HIF_CE_pipe_info *pipe_info = &ctx->hif_state.pipe_info[0];
+
+	ctx->dest_ring.nentries = ut_ce_nentries;
+	ctx->ce_state.dest_ring = &ctx->dest_ring;
+	qdf_create_work(0, &ctx->ce_state.oom_allocation_work,
+			ut_ce_oom_work, ctx);
+
+	pipe_info->ce_hdl = (struct CE_handle *)&ctx->ce_state;
+	pipe_info->HIF_CE_state = &ctx->hif_state;
+	pipe_info->buf_sz = ut_ce_buf_sz;
+	qdf_spinlock_create(&pipe_info->recv_bufs_needed_lock);
+
+	return pipe_info;
+}
+
+static void ut_ce_teardown(struct ut_ce_ctx *ctx)
+{
+	qdf_spinlock_destroy(&ctx->hif_state.pipe_info[0].recv_bufs_needed_lock);
+	qdf_destroy_work(0, &ctx->ce_state.oom_allocation_work);
+}
+
+static uint32_t ut_ce_alloc_fail(int needed, bool oom_expected)
+{
+	struct HIF_CE_pipe_info *pipe_info;
+	struct ut_ce_ctx *ctx;
+	uint32_t errors = 0;
+	QDF_STATUS status;
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	pipe_info = ut_ce_setup(ctx);
+	atomic_set(&pipe_info->recv_bufs_needed, needed);
+
+	hif_ce_recv_batch_alloc_fails = 1;
+	status = hif_post_recv_buffers_for_pipe(pipe_info);
+	hif_ce_recv_batch_alloc_fails = 0;
+	qdf_flush_work(&ctx->ce_state.oom_allocation_work);
+
+	if (QDF_IS_STATUS_SUCCESS(status)) {
+		qdf_nofl_alert("FAIL: needed %d refill succeeded", needed);
+		errors++;
+	}
+
+	if (atomic_read(&pipe_info->recv_bufs_needed) != needed ||
+	    pipe_info->nbuf_alloc_err_count != 1) {
+		qdf_nofl_alert("FAIL: needed %d -> %d alloc errors %u",
+			       needed,
+			       atomic_read(&pipe_info->recv_bufs_needed),
+			       pipe_info->nbuf_alloc_err_count);
+		errors++;
+	}
+
+	if (ctx->oom_ran != oom_expected) {
+		qdf_nofl_alert("FAIL: needed %d oom work ran %u expected %u",
+			       needed, ctx->oom_ran, oom_expected);
+		errors++;
+	}
+
+	ut_ce_teardown(ctx);
+	qdf_mem_free(ctx);
+
+	return errors;
+}
+
+uint32_t hif_ce_recv_batch_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	/* empty ring, nothing left to trigger a refill but the OOM work */
+	errors += ut_ce_alloc_fail(ut_ce_nentries - 1, true);
+	/* buffers still posted, their completions retry the refill */
+	errors += ut_ce_alloc_fail(ut_ce_nentries / 2, false);
+
+	return errors;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __HIF_CE_RECV_BATCH_TEST
+#define __HIF_CE_RECV_BATCH_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_HIF_CE_RECV_BATCH_TEST
+/**
+ * hif_ce_recv_batch_unit_test() - run the batched CE receive unit test suite
+ *
+ * Fails the first receive buffer allocation of a batched refill on a
+ * standalone pipe and checks that recv_bufs_needed is restored and that the
+ * OOM recovery work is scheduled only when the destination ring is empty.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t hif_ce_recv_batch_unit_test(void);
+#else
+static inline uint32_t hif_ce_recv_batch_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_HIF_CE_RECV_BATCH_TEST */
+
+#endif /* __HIF_CE_RECV_BATCH_TEST */
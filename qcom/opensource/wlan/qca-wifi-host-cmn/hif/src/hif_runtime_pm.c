@@ -44,6 +44,8 @@
 
 #define CNSS_RUNTIME_FILE "cnss_runtime_pm"
 #define CNSS_RUNTIME_FILE_PERM QDF_FILE_USR_READ
+#define CNSS_RUNTIME_PREDICT_FILE "cnss_runtime_pm_predict"
+#define CNSS_RUNTIME_PREDICT_FILE_PERM (QDF_FILE_USR_READ | QDF_FILE_USR_WRITE)
 
 #ifdef FEATURE_RUNTIME_PM
 #define PREVENT_LIST_STRING_LEN 200
@@ -334,6 +336,623 @@ static void hif_runtime_pm_debugfs_remove(struct hif_softc *scn)
 	qdf_debugfs_remove_file(rpm_ctx->pm_dentry);
 }
 
+#ifdef HIF_RTPM_AUTOSUSPEND_PREDICT
+/* Upper bounds of the idle gap histogram buckets in ms */
+static const uint32_t hif_rtpm_gap_hist_ms[HIF_RTPM_GAP_HIST_MAX] = {
+	50, 100, 200, 500, 1000, 2000, 5000, UINT_MAX};
+
+/* Upper bounds of the resume latency histogram buckets in us */
+static const uint32_t hif_rtpm_resume_hist_us[HIF_RTPM_RESUME_HIST_MAX] = {
+	1000, 2000, 5000, 10000, 20000, 50000, 100000, UINT_MAX};
+
+/**
+ * hif_rtpm_class_to_string() - Mapping traffic class into string
+ * @cls: traffic class
+ *
+ * Return: pointer to the string
+ */
+static const char *hif_rtpm_class_to_string(uint8_t cls)
+{
+	switch (cls) {
+	case HIF_RTPM_CLASS_DP_RX:
+		return "DP_RX";
+	case HIF_RTPM_CLASS_DP_TX:
+		return "DP_TX";
+	case HIF_RTPM_CLASS_CTRL:
+		return "CTRL";
+	default:
+		return "INVALID";
+	}
+}
+
+/**
+ * hif_rtpm_hist_bucket() - find the histogram bucket of a value
+ * @bounds: upper bounds of the buckets, the last one is UINT_MAX
+ * @num: number of buckets
+ * @val: value to be accounted
+ *
+ * Return: bucket index
+ */
+static uint8_t hif_rtpm_hist_bucket(const uint32_t *bounds, uint8_t num,
+				    uint32_t val)
+{
+	uint8_t i;
+
+	for (i = 0; i < num - 1; i++)
+		if (val < bounds[i])
+			break;
+
+	return i;
+}
+
+/**
+ * hif_rtpm_predict_break_even() - idle time a runtime suspend pays back at
+ * @predict: predictor context
+ *
+ * Taking the link down and up again costs power roughly in proportion to
+ * the time the transition takes, so the break even time scales with the
+ * measured resume latency.
+ *
+ * Return: break even idle time in ms
+ */
+static uint32_t hif_rtpm_predict_break_even(struct hif_rtpm_predict *predict)
+{
+	uint32_t break_even;
+
+	break_even = predict->resume_lat_avg_us *
+		     HIF_RTPM_PREDICT_BREAK_EVEN_FACTOR / 1000;
+
+	return QDF_MAX(break_even,
+		       (uint32_t)HIF_RTPM_PREDICT_BREAK_EVEN_MIN_MS);
+}
+
+/**
+ * hif_rtpm_predict_gap_update() - add an idle gap to a class model
+ * @stats: idle gap model of the class
+ * @gap: idle gap in ms
+ *
+ * The average and mean deviation are kept the way TCP keeps its RTT
+ * estimate, so average + 4 * deviation bounds most of the upcoming gaps.
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_gap_update(struct hif_rtpm_class_stats *stats,
+					uint32_t gap)
+{
+	int32_t err;
+
+	if (!stats->samples) {
+		stats->gap_avg_x8 = gap << 3;
+		stats->gap_dev_x4 = gap << 1;
+	} else {
+		err = (int32_t)gap - (int32_t)(stats->gap_avg_x8 >> 3);
+		stats->gap_avg_x8 += err;
+		if (err < 0)
+			err = -err;
+		stats->gap_dev_x4 += err - (stats->gap_dev_x4 >> 2);
+	}
+
+	stats->samples++;
+	stats->gap_hist[hif_rtpm_hist_bucket(hif_rtpm_gap_hist_ms,
+					     HIF_RTPM_GAP_HIST_MAX, gap)]++;
+}
+
+/**
+ * hif_rtpm_predict_delay() - choose the autosuspend delay
+ * @scn: hif context
+ * @predict: predictor context
+ * @now: current system time in ms
+ * @break_even: break even idle time in ms
+ * @predict_ms: filled with the predicted gap of the deciding class
+ *
+ * Each recently active class with enough history votes for a delay. A
+ * class whose gaps are on average longer than the break even time votes
+ * for suspending as early as possible. Any other class votes for staying
+ * up through its predicted gap, but never longer than the break even time
+ * so a misprediction costs at most twice the optimum. The longest vote
+ * wins since suspending under the feet of any class costs a resume.
+ *
+ * Return: autosuspend delay in ms
+ */
+static int hif_rtpm_predict_delay(struct hif_softc *scn,
+				  struct hif_rtpm_predict *predict,
+				  unsigned long now, uint32_t break_even,
+				  uint32_t *predict_ms)
+{
+	struct hif_rtpm_class_stats *stats;
+	uint32_t avg, upper, vote;
+	unsigned long last;
+	int delay = -1;
+	uint8_t cls;
+
+	*predict_ms = 0;
+	for (cls = 0; cls < HIF_RTPM_CLASS_MAX; cls++) {
+		stats = &predict->cls[cls];
+		/* a concurrent busy mark may be newer than now */
+		last = atomic_long_read(&stats->last_busy_ms);
+		if (stats->samples < HIF_RTPM_PREDICT_MIN_SAMPLES ||
+		    (now > last && now - last > HIF_RTPM_PREDICT_CLASS_IDLE_MS))
+			continue;
+
+		avg = stats->gap_avg_x8 >> 3;
+		upper = avg + stats->gap_dev_x4;
+		if (avg >= break_even)
+			vote = HIF_RTPM_DELAY_MIN;
+		else
+			vote = QDF_MIN(upper, break_even) +
+			       HIF_RTPM_PREDICT_MARGIN_MS;
+
+		if ((int)vote > delay) {
+			delay = vote;
+			*predict_ms = upper;
+		}
+	}
+
+	if (delay < 0)
+		return scn->hif_config.runtime_pm_delay;
+
+	return QDF_MIN(QDF_MAX(delay, HIF_RTPM_DELAY_MIN), HIF_RTPM_DELAY_MAX);
+}
+
+/**
+ * hif_rtpm_predict_busy() - account a busy mark of a traffic class
+ * @scn: hif context
+ * @cls: traffic class, HIF_RTPM_CLASS_MAX for marks not caused by traffic
+ *
+ * Busy marks within a burst only refresh the time stamp of the class,
+ * without the lock and at most once per ms, since this runs for every
+ * packet in the rx and tx paths. The mark which swaps in its time stamp
+ * after an idle gap owns the gap: it takes the lock, feeds the gap to the
+ * class model and reevaluates the autosuspend delay. The delay is applied
+ * from a work.
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_busy(struct hif_softc *scn,
+				  enum hif_rtpm_class cls)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+	struct hif_rtpm_predict *predict = &rpm_ctx->predict;
+	struct hif_rtpm_class_stats *stats;
+	struct hif_rtpm_decision *decision;
+	unsigned long now, last;
+	uint32_t gap, break_even, predict_ms;
+	int delay;
+	bool changed;
+
+	if (cls >= HIF_RTPM_CLASS_MAX || !READ_ONCE(predict->enabled))
+		return;
+
+	now = qdf_get_system_timestamp();
+	stats = &predict->cls[cls];
+
+	last = atomic_long_read(&stats->last_busy_ms);
+	if (last && now - last < HIF_RTPM_PREDICT_GAP_MIN_MS) {
+		if (last != now)
+			atomic_long_set(&stats->last_busy_ms, now);
+		return;
+	}
+
+	/* a concurrent mark already accounted the gap */
+	if (atomic_long_cmpxchg(&stats->last_busy_ms, last, now) != last ||
+	    !last)
+		return;
+
+	qdf_spin_lock_bh(&predict->lock);
+	if (!predict->enabled) {
+		qdf_spin_unlock_bh(&predict->lock);
+		return;
+	}
+
+	gap = QDF_MIN(now - last, (unsigned long)HIF_RTPM_PREDICT_GAP_MAX_MS);
+	hif_rtpm_predict_gap_update(stats, gap);
+	if (predict->pinned) {
+		qdf_spin_unlock_bh(&predict->lock);
+		return;
+	}
+
+	break_even = hif_rtpm_predict_break_even(predict);
+	delay = hif_rtpm_predict_delay(scn, predict, now, break_even,
+				       &predict_ms);
+
+	decision = &predict->log[predict->log_idx++ %
+				 HIF_RTPM_PREDICT_LOG_SIZE];
+	decision->ts_ms = now;
+	decision->cls = cls;
+	decision->gap_ms = gap;
+	decision->predict_ms = predict_ms;
+	decision->break_even_ms = break_even;
+	decision->old_delay = predict->target_delay;
+	decision->delay = delay;
+	predict->evaluations++;
+
+	/* ignore changes below 1/8 of the delay to not churn the pm core */
+	changed = abs(delay - predict->target_delay) >
+		  predict->target_delay / 8;
+	if (changed)
+		predict->target_delay = delay;
+	qdf_spin_unlock_bh(&predict->lock);
+
+	if (changed)
+		qdf_sched_work(0, &predict->delay_work);
+}
+
+/**
+ * hif_rtpm_predict_delay_work() - apply the predicted autosuspend delay
+ * @arg: hif context
+ *
+ * A delay set explicitly while the predicted one was being applied may
+ * have been overwritten by it, in which case the explicit delay is set
+ * again.
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_delay_work(void *arg)
+{
+	struct hif_softc *scn = arg;
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+	struct hif_rtpm_predict *predict = &rpm_ctx->predict;
+	int delay;
+	bool apply, repin;
+
+	qdf_spin_lock_bh(&predict->lock);
+	delay = predict->target_delay;
+	apply = predict->enabled && !predict->pinned && delay != rpm_ctx->delay;
+	qdf_spin_unlock_bh(&predict->lock);
+
+	if (!apply)
+		return;
+
+	__hif_pm_runtime_set_delay(hif_bus_get_dev(scn), delay);
+
+	qdf_spin_lock_bh(&predict->lock);
+	repin = predict->pinned;
+	if (repin) {
+		delay = predict->pin_delay;
+	} else {
+		rpm_ctx->delay = delay;
+		predict->delay_updates++;
+	}
+	qdf_spin_unlock_bh(&predict->lock);
+
+	if (repin) {
+		__hif_pm_runtime_set_delay(hif_bus_get_dev(scn), delay);
+		return;
+	}
+
+	hif_debug("Runtime PM delay predicted: %d ms", delay);
+}
+
+/**
+ * hif_rtpm_predict_resume_start() - time stamp the start of a resume
+ * @scn: hif context
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_resume_start(struct hif_softc *scn)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+
+	rpm_ctx->predict.resume_start_us = qdf_get_log_timestamp_usecs();
+}
+
+/**
+ * hif_rtpm_predict_resume_done() - account the latency of a resume
+ * @scn: hif context
+ *
+ * Also counts the suspends which ended before paying back their cost.
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_resume_done(struct hif_softc *scn)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+	struct hif_rtpm_predict *predict = &rpm_ctx->predict;
+	uint32_t lat, residency;
+	int32_t err;
+
+	if (!predict->resume_start_us)
+		return;
+
+	lat = qdf_get_log_timestamp_usecs() - predict->resume_start_us;
+	predict->resume_start_us = 0;
+	residency = jiffies_to_msecs(jiffies -
+				     rpm_ctx->pm_stats.suspend_jiffies);
+
+	qdf_spin_lock_bh(&predict->lock);
+	if (!predict->resume_lat_avg_us) {
+		predict->resume_lat_avg_us = lat;
+	} else {
+		err = (int32_t)lat - (int32_t)predict->resume_lat_avg_us;
+		predict->resume_lat_avg_us += err / 8;
+	}
+	predict->resume_hist[hif_rtpm_hist_bucket(hif_rtpm_resume_hist_us,
+						  HIF_RTPM_RESUME_HIST_MAX,
+						  lat)]++;
+	if (residency < hif_rtpm_predict_break_even(predict))
+		predict->short_suspends++;
+	qdf_spin_unlock_bh(&predict->lock);
+}
+
+/**
+ * hif_rtpm_predict_pin() - stop or resume predicting the delay
+ * @scn: hif context
+ * @pin: true when the delay is set explicitly, false when it is restored
+ * @delay: delay in ms set explicitly
+ *
+ * Called from the WoW wakeup event tasklet, so this must not sleep. A
+ * queued delay_work sees the pin and does nothing, and one already
+ * applying a predicted delay sets the explicit delay again once done.
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_pin(struct hif_softc *scn, bool pin, int delay)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+	struct hif_rtpm_predict *predict = &rpm_ctx->predict;
+
+	qdf_spin_lock_bh(&predict->lock);
+	predict->pinned = pin;
+	predict->pin_delay = delay;
+	predict->target_delay = scn->hif_config.runtime_pm_delay;
+	qdf_spin_unlock_bh(&predict->lock);
+}
+
+/**
+ * hif_rtpm_predict_debugfs_show() - show the predictor state and decisions
+ * @s: file to print to
+ * @data: unused
+ *
+ * Return: 0
+ */
+static int hif_rtpm_predict_debugfs_show(struct seq_file *s, void *data)
+{
+	struct hif_softc *scn = s->private;
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+	struct hif_rtpm_predict *predict = &rpm_ctx->predict;
+	struct hif_rtpm_class_stats *stats;
+	struct hif_rtpm_decision *decision;
+	unsigned long now = qdf_get_system_timestamp();
+	unsigned long last;
+	uint32_t i, num;
+	uint8_t cls;
+
+	qdf_spin_lock_bh(&predict->lock);
+	seq_printf(s, "%30s: %u\n", "enabled", predict->enabled);
+	seq_printf(s, "%30s: %u\n", "pinned", predict->pinned);
+	seq_printf(s, "%30s: %d ms\n", "delay", rpm_ctx->delay);
+	seq_printf(s, "%30s: %d ms\n", "target_delay", predict->target_delay);
+	seq_printf(s, "%30s: %d ms\n", "default_delay",
+		   scn->hif_config.runtime_pm_delay);
+	seq_printf(s, "%30s: %u ms\n", "break_even",
+		   hif_rtpm_predict_break_even(predict));
+	seq_printf(s, "%30s: %u\n", "evaluations", predict->evaluations);
+	seq_printf(s, "%30s: %u\n", "delay_updates", predict->delay_updates);
+	seq_printf(s, "%30s: %u\n", "short_suspends", predict->short_suspends);
+	seq_printf(s, "%30s: %u us\n", "resume_latency_avg",
+		   predict->resume_lat_avg_us);
+
+	seq_puts(s, "\nresume latency histogram\n");
+	for (i = 0; i < HIF_RTPM_RESUME_HIST_MAX - 1; i++)
+		seq_printf(s, "%22s< %6u us: %u\n", "",
+			   hif_rtpm_resume_hist_us[i],
+			   predict->resume_hist[i]);
+	seq_printf(s, "%22s>=%6u us: %u\n", "", hif_rtpm_resume_hist_us[i - 1],
+		   predict->resume_hist[i]);
+
+	seq_puts(s, "\nclass  samples  avg_ms  dev_ms  predict_ms  idle_ms  gap histogram (<50 <100 <200 <500 <1s <2s <5s >=5s)\n");
+	for (cls = 0; cls < HIF_RTPM_CLASS_MAX; cls++) {
+		stats = &predict->cls[cls];
+		/* busy marks move the stamp without the lock */
+		last = atomic_long_read(&stats->last_busy_ms);
+		seq_printf(s, "%-6s %8u %7u %7u %11u %8lu ",
+			   hif_rtpm_class_to_string(cls), stats->samples,
+			   stats->gap_avg_x8 >> 3, stats->gap_dev_x4 >> 2,
+			   (stats->gap_avg_x8 >> 3) + stats->gap_dev_x4,
+			   last && now > last ? now - last : 0);
+		for (i = 0; i < HIF_RTPM_GAP_HIST_MAX; i++)
+			seq_printf(s, " %u", stats->gap_hist[i]);
+		seq_puts(s, "\n");
+	}
+
+	seq_puts(s, "\ndecisions, newest first\n");
+	seq_puts(s, "age_ms     class  gap_ms  predict_ms  break_even_ms  delay_ms\n");
+	num = QDF_MIN(predict->log_idx, (uint32_t)HIF_RTPM_PREDICT_LOG_SIZE);
+	for (i = 1; i <= num; i++) {
+		decision = &predict->log[(predict->log_idx - i) %
+					 HIF_RTPM_PREDICT_LOG_SIZE];
+		seq_printf(s, "%-10lu %-6s %6u %11u %14u %5d -> %d\n",
+			   now - decision->ts_ms,
+			   hif_rtpm_class_to_string(decision->cls),
+			   decision->gap_ms, decision->predict_ms,
+			   decision->break_even_ms, decision->old_delay,
+			   decision->delay);
+	}
+	qdf_spin_unlock_bh(&predict->lock);
+
+	return 0;
+}
+
+/**
+ * hif_rtpm_predict_open() - open the predictor debugfs file
+ * @inode: inode of the file
+ * @file: file being opened
+ *
+ * Return: linux error code of single_open.
+ */
+static int hif_rtpm_predict_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, hif_rtpm_predict_debugfs_show,
+			   inode->i_private);
+}
+
+/**
+ * hif_rtpm_predict_write() - enable or disable the predictor
+ * @file: file being written
+ * @buf: user buffer holding 0 or 1
+ * @count: size of the user buffer
+ * @ppos: file position
+ *
+ * Disabling the predictor restores the autosuspend delay from the ini.
+ *
+ * Return: number of bytes consumed or linux error code
+ */
+static ssize_t hif_rtpm_predict_write(struct file *file,
+				      const char __user *buf,
+				      size_t count, loff_t *ppos)
+{
+	struct hif_softc *scn = ((struct seq_file *)file->private_data)->private;
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+	unsigned int enable;
+	int ret;
+
+	ret = kstrtouint_from_user(buf, count, 0, &enable);
+	if (ret)
+		return ret;
+
+	qdf_spin_lock_bh(&rpm_ctx->predict.lock);
+	rpm_ctx->predict.enabled = !!enable;
+	qdf_spin_unlock_bh(&rpm_ctx->predict.lock);
+	if (!enable)
+		hif_pm_runtime_restore_delay(GET_HIF_OPAQUE_HDL(scn));
+
+	return count;
+}
+
+static const struct file_operations hif_rtpm_predict_fops = {
+	.owner          = THIS_MODULE,
+	.open           = hif_rtpm_predict_open,
+	.release        = single_release,
+	.read           = seq_read,
+	.write          = hif_rtpm_predict_write,
+	.llseek         = seq_lseek,
+};
+
+/**
+ * hif_rtpm_predict_init() - initialize the autosuspend predictor
+ * @scn: hif context
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_init(struct hif_softc *scn)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+
+	qdf_spinlock_create(&rpm_ctx->predict.lock);
+	qdf_create_work(0, &rpm_ctx->predict.delay_work,
+			hif_rtpm_predict_delay_work, scn);
+}
+
+/**
+ * hif_rtpm_predict_deinit() - deinitialize the autosuspend predictor
+ * @scn: hif context
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_deinit(struct hif_softc *scn)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+
+	qdf_destroy_work(0, &rpm_ctx->predict.delay_work);
+	qdf_spinlock_destroy(&rpm_ctx->predict.lock);
+}
+
+/**
+ * hif_rtpm_predict_start() - start predicting the autosuspend delay
+ * @scn: hif context
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_start(struct hif_softc *scn)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+	struct hif_rtpm_predict *predict = &rpm_ctx->predict;
+
+	qdf_spin_lock_bh(&predict->lock);
+	predict->target_delay = scn->hif_config.runtime_pm_delay;
+	predict->pinned = false;
+	predict->enabled = true;
+	qdf_spin_unlock_bh(&predict->lock);
+
+	predict->dentry =
+		qdf_debugfs_create_entry(CNSS_RUNTIME_PREDICT_FILE,
+					 CNSS_RUNTIME_PREDICT_FILE_PERM,
+					 NULL, scn, &hif_rtpm_predict_fops);
+}
+
+/**
+ * hif_rtpm_predict_stop() - stop predicting the autosuspend delay
+ * @scn: hif context
+ *
+ * Return: None
+ */
+static void hif_rtpm_predict_stop(struct hif_softc *scn)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+
+	qdf_debugfs_remove_file(rpm_ctx->predict.dentry);
+	qdf_spin_lock_bh(&rpm_ctx->predict.lock);
+	rpm_ctx->predict.enabled = false;
+	qdf_spin_unlock_bh(&rpm_ctx->predict.lock);
+	qdf_flush_work(&rpm_ctx->predict.delay_work);
+}
+#else
+static inline void hif_rtpm_predict_busy(struct hif_softc *scn,
+					 enum hif_rtpm_class cls)
+{
+}
+
+static inline void hif_rtpm_predict_resume_start(struct hif_softc *scn)
+{
+}
+
+static inline void hif_rtpm_predict_resume_done(struct hif_softc *scn)
+{
+}
+
+static inline void hif_rtpm_predict_pin(struct hif_softc *scn, bool pin,
+					int delay)
+{
+}
+
+static inline void hif_rtpm_predict_init(struct hif_softc *scn)
+{
+}
+
+static inline void hif_rtpm_predict_deinit(struct hif_softc *scn)
+{
+}
+
+static inline void hif_rtpm_predict_start(struct hif_softc *scn)
+{
+}
+
+static inline void hif_rtpm_predict_stop(struct hif_softc *scn)
+{
+}
+#endif /* HIF_RTPM_AUTOSUSPEND_PREDICT */
+
+/**
+ * __hif_pm_runtime_mark_last_busy() - Mark last busy time for a class
+ * @scn: hif context
+ * @cls: traffic class which is busy
+ * @marker: address recorded as the last busy marker
+ *
+ * Return: void
+ */
+static void __hif_pm_runtime_mark_last_busy(struct hif_softc *scn,
+					    enum hif_rtpm_class cls,
+					    void *marker)
+{
+	struct hif_runtime_pm_ctx *rpm_ctx = hif_bus_get_rpm_ctx(scn);
+
+	rpm_ctx->pm_stats.last_busy_marker = marker;
+	rpm_ctx->pm_stats.last_busy_timestamp = qdf_get_log_timestamp_usecs();
+	hif_rtpm_predict_busy(scn, cls);
+
+	pm_runtime_mark_last_busy(hif_bus_get_dev(scn));
+}
+
 /**
  * hif_runtime_init() - Initialize Runtime PM
  * @dev: device structure
@@ -405,6 +1024,7 @@ void hif_pm_runtime_start(struct hif_softc *scn)
 	hif_runtime_init(dev, scn->hif_config.runtime_pm_delay);
 	rpm_ctx->delay = scn->hif_config.runtime_pm_delay;
 	hif_runtime_pm_debugfs_create(scn);
+	hif_rtpm_predict_start(scn);
 }
 
 /**
@@ -427,6 +1047,7 @@ void hif_pm_runtime_stop(struct hif_softc *scn)
 	    mode == QDF_GLOBAL_MONITOR_MODE)
 		return;
 
+	hif_rtpm_predict_stop(scn);
 	hif_runtime_exit(dev);
 
 	hif_pm_runtime_sync_resume(GET_HIF_OPAQUE_HDL(scn), RTPM_ID_PM_STOP);
@@ -463,6 +1084,7 @@ void hif_pm_runtime_open(struct hif_softc *scn)
 		qdf_atomic_init(&rpm_ctx->pm_stats.runtime_put_dbgid[i]);
 	}
 	INIT_LIST_HEAD(&rpm_ctx->prevent_suspend_list);
+	hif_rtpm_predict_init(scn);
 }
 
 /**
@@ -567,6 +1189,7 @@ void hif_pm_runtime_close(struct hif_softc *scn)
 		hif_pm_runtime_sanitize_on_ssr_exit(scn) :
 		hif_pm_runtime_sanitize_on_exit(scn);
 
+	hif_rtpm_predict_deinit(scn);
 	qdf_spinlock_destroy(&rpm_ctx->runtime_suspend_lock);
 }
 
@@ -743,7 +1366,8 @@ void hif_process_runtime_suspend_failure(struct hif_opaque_softc *hif_ctx)
 	struct hif_softc *scn = HIF_GET_SOFTC(hif_ctx);
 
 	hif_log_runtime_suspend_failure(hif_ctx);
-	hif_pm_runtime_mark_last_busy(hif_ctx);
+	__hif_pm_runtime_mark_last_busy(scn, HIF_RTPM_CLASS_MAX,
+					(void *)_THIS_IP_);
 	hif_runtime_pm_set_state_on(scn);
 }
 
@@ -848,6 +1472,7 @@ void hif_pre_runtime_resume(struct hif_opaque_softc *hif_ctx)
 
 	hif_pm_runtime_set_monitor_wake_intr(hif_ctx, 0);
 	hif_runtime_pm_set_state_resuming(scn);
+	hif_rtpm_predict_resume_start(scn);
 }
 
 /**
@@ -861,7 +1486,9 @@ void hif_process_runtime_resume_success(struct hif_opaque_softc *hif_ctx)
 	struct hif_softc *scn = HIF_GET_SOFTC(hif_ctx);
 
 	hif_log_runtime_resume_success(hif_ctx);
-	hif_pm_runtime_mark_last_busy(hif_ctx);
+	hif_rtpm_predict_resume_done(scn);
+	__hif_pm_runtime_mark_last_busy(scn, HIF_RTPM_CLASS_MAX,
+					(void *)_THIS_IP_);
 	hif_runtime_pm_set_state_on(scn);
 }
 
@@ -1143,18 +1770,12 @@ int hif_pm_runtime_request_resume(struct hif_opaque_softc *hif_ctx,
 void hif_pm_runtime_mark_last_busy(struct hif_opaque_softc *hif_ctx)
 {
 	struct hif_softc *scn = HIF_GET_SOFTC(hif_ctx);
-	struct hif_runtime_pm_ctx *rpm_ctx;
 
 	if (!scn)
 		return;
 
-	rpm_ctx = hif_bus_get_rpm_ctx(scn);
-	rpm_ctx->pm_stats.last_busy_marker = (void *)_RET_IP_;
-	rpm_ctx->pm_stats.last_busy_timestamp = qdf_get_log_timestamp_usecs();
-
-	pm_runtime_mark_last_busy(hif_bus_get_dev(scn));
-
-	return;
+	__hif_pm_runtime_mark_last_busy(scn, HIF_RTPM_CLASS_CTRL,
+					(void *)_RET_IP_);
 }
 
 /**
@@ -1307,7 +1928,11 @@ int hif_pm_runtime_put(struct hif_opaque_softc *hif_ctx,
 
 	hif_pm_stats_runtime_put_record(scn, rtpm_dbgid);
 
-	hif_pm_runtime_mark_last_busy(hif_ctx);
+	__hif_pm_runtime_mark_last_busy(scn,
+					rtpm_dbgid == RTPM_ID_DW_TX_HW_ENQUEUE ?
+					HIF_RTPM_CLASS_DP_TX :
+					HIF_RTPM_CLASS_CTRL,
+					(void *)_THIS_IP_);
 	hif_pm_runtime_put_auto(dev);
 
 	return 0;
@@ -1616,6 +2241,7 @@ QDF_STATUS hif_pm_runtime_set_delay(struct hif_opaque_softc *hif_ctx,
 		return QDF_STATUS_E_INVAL;
 	}
 
+	hif_rtpm_predict_pin(scn, true, delay);
 	__hif_pm_runtime_set_delay(hif_bus_get_dev(scn), delay);
 	rpm_ctx->delay = delay;
 	hif_info_high("Runtime PM delay set: %d ms", delay);
@@ -1634,6 +2260,7 @@ QDF_STATUS hif_pm_runtime_restore_delay(struct hif_opaque_softc *hif_ctx)
 	if (!hif_pci_pm_runtime_enabled(scn))
 		return QDF_STATUS_E_NOSUPPORT;
 
+	hif_rtpm_predict_pin(scn, false, scn->hif_config.runtime_pm_delay);
 	if (rpm_ctx->delay == scn->hif_config.runtime_pm_delay) {
 		hif_info_rl("Runtime PM delay already default: %d",
 			    rpm_ctx->delay);
@@ -1839,7 +2466,8 @@ void hif_pm_runtime_mark_dp_rx_busy(struct hif_opaque_softc *hif_ctx)
 	qdf_atomic_set(&rpm_ctx->pm_dp_rx_busy, 1);
 	rpm_ctx->dp_last_busy_timestamp = qdf_get_log_timestamp_usecs();
 
-	hif_pm_runtime_mark_last_busy(hif_ctx);
+	__hif_pm_runtime_mark_last_busy(scn, HIF_RTPM_CLASS_DP_RX,
+					(void *)_THIS_IP_);
 }
 
 /**
@@ -87,6 +87,120 @@ struct hif_pci_pm_stats {
 	struct hif_pm_runtime_htc_stats pm_stats_htc;
 };
 
+/**
+ * enum hif_rtpm_class - traffic classes tracked by the autosuspend predictor
+ * @HIF_RTPM_CLASS_DP_RX: data path rx, marked by the REO ring reap
+ * @HIF_RTPM_CLASS_DP_TX: data path tx, marked by the TCL ring enqueue
+ * @HIF_RTPM_CLASS_CTRL: copy engine, WMI and HTT traffic
+ * @HIF_RTPM_CLASS_MAX: number of classes, also used for busy marks that
+ *  are not caused by traffic
+ */
+enum hif_rtpm_class {
+	HIF_RTPM_CLASS_DP_RX,
+	HIF_RTPM_CLASS_DP_TX,
+	HIF_RTPM_CLASS_CTRL,
+	HIF_RTPM_CLASS_MAX,
+};
+
+#ifdef HIF_RTPM_AUTOSUSPEND_PREDICT
+#include <qdf_defer.h>
+
+/* Busy marks closer together than this belong to the same traffic burst */
+#define HIF_RTPM_PREDICT_GAP_MIN_MS 20
+/* Idle gaps a class needs to have seen before it is trusted */
+#define HIF_RTPM_PREDICT_MIN_SAMPLES 4
+/* A class that was not busy for this long no longer votes on the delay */
+#define HIF_RTPM_PREDICT_CLASS_IDLE_MS 10000
+/* Lower bound of the idle time a suspend/resume cycle has to pay back */
+#define HIF_RTPM_PREDICT_BREAK_EVEN_MIN_MS 200
+/* Break even time in units of the average resume latency */
+#define HIF_RTPM_PREDICT_BREAK_EVEN_FACTOR 10
+/* Extra idle time granted on top of a predicted gap */
+#define HIF_RTPM_PREDICT_MARGIN_MS 50
+/* Longer idle gaps are all alike to the predictor */
+#define HIF_RTPM_PREDICT_GAP_MAX_MS 60000
+#define HIF_RTPM_PREDICT_LOG_SIZE 32
+#define HIF_RTPM_GAP_HIST_MAX 8
+#define HIF_RTPM_RESUME_HIST_MAX 8
+
+/**
+ * struct hif_rtpm_class_stats - idle gap model of one traffic class
+ * @last_busy_ms: system time of the last busy mark, updated without the
+ *		  predictor lock
+ * @gap_avg_x8: moving average of the idle gaps in ms, scaled by 8
+ * @gap_dev_x4: moving mean deviation of the idle gaps in ms, scaled by 4
+ * @samples: number of idle gaps seen
+ * @gap_hist: idle gap histogram, see hif_rtpm_gap_hist_ms
+ */
+struct hif_rtpm_class_stats {
+	atomic_long_t last_busy_ms;
+	uint32_t gap_avg_x8;
+	uint32_t gap_dev_x4;
+	uint32_t samples;
+	uint32_t gap_hist[HIF_RTPM_GAP_HIST_MAX];
+};
+
+/**
+ * struct hif_rtpm_decision - one evaluation of the autosuspend delay
+ * @ts_ms: system time of the evaluation
+ * @cls: class whose idle gap triggered the evaluation
+ * @gap_ms: the idle gap that ended
+ * @predict_ms: predicted idle gap of the class deciding the delay
+ * @break_even_ms: break even idle time at the time of the evaluation
+ * @old_delay: autosuspend delay in ms before the evaluation
+ * @delay: autosuspend delay in ms chosen
+ */
+struct hif_rtpm_decision {
+	unsigned long ts_ms;
+	uint8_t cls;
+	uint32_t gap_ms;
+	uint32_t predict_ms;
+	uint32_t break_even_ms;
+	int old_delay;
+	int delay;
+};
+
+/**
+ * struct hif_rtpm_predict - traffic aware autosuspend delay predictor
+ * @lock: protects the models but their busy time stamps, the decision log
+ *	  and the target delay
+ * @delay_work: applies the target delay in process context
+ * @enabled: predictor enabled, toggled through debugfs; written under @lock,
+ *	     peeked at without it by the busy marks
+ * @pinned: delay set explicitly by hif_pm_runtime_set_delay()
+ * @pin_delay: delay in ms set by hif_pm_runtime_set_delay()
+ * @target_delay: delay in ms last chosen by the predictor
+ * @evaluations: number of delay evaluations
+ * @delay_updates: number of times the autosuspend delay was changed
+ * @resume_start_us: log time stamp of the resume in progress
+ * @resume_lat_avg_us: moving average of the resume latency
+ * @short_suspends: suspends that lasted less than the break even time
+ * @resume_hist: resume latency histogram, see hif_rtpm_resume_hist_us
+ * @cls: per traffic class idle gap models
+ * @log: ring of the most recent decisions
+ * @log_idx: total number of decisions logged
+ * @dentry: debugfs entry exposing the decisions
+ */
+struct hif_rtpm_predict {
+	qdf_spinlock_t lock;
+	qdf_work_t delay_work;
+	bool enabled;
+	bool pinned;
+	int pin_delay;
+	int target_delay;
+	uint32_t evaluations;
+	uint32_t delay_updates;
+	uint64_t resume_start_us;
+	uint32_t resume_lat_avg_us;
+	uint32_t short_suspends;
+	uint32_t resume_hist[HIF_RTPM_RESUME_HIST_MAX];
+	struct hif_rtpm_class_stats cls[HIF_RTPM_CLASS_MAX];
+	struct hif_rtpm_decision log[HIF_RTPM_PREDICT_LOG_SIZE];
+	uint32_t log_idx;
+	struct dentry *dentry;
+};
+#endif /* HIF_RTPM_AUTOSUSPEND_PREDICT */
+
 struct hif_runtime_pm_ctx {
 	atomic_t pm_state;
 	atomic_t monitor_wake_intr;
@@ -105,6 +219,9 @@ struct hif_runtime_pm_ctx {
 #ifdef WLAN_OPEN_SOURCE
 	struct dentry *pm_dentry;
 #endif
+#ifdef HIF_RTPM_AUTOSUSPEND_PREDICT
+	struct hif_rtpm_predict predict;
+#endif
 };
 
 #define HIF_RTPM_DELAY_MIN 100
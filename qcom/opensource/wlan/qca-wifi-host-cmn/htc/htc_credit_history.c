@@ -110,6 +110,114 @@ void htc_credit_record(enum htc_credit_exchange_type type, uint32_t tx_credit,
 	qdf_spin_unlock_bh(&g_htc_credit_lock);
 }
 
+#ifdef FEATURE_HTC_CREDIT_PREDICTION
+/* upper bounds of the credit stall histogram bins, in microseconds */
+static const uint32_t htc_credit_stall_bin_us[HTC_CREDIT_STALL_HIST_BINS - 1] = {
+	100, 500, 1000, 5000, 10000, 50000, 100000
+};
+
+void htc_credit_predict_replenish(HTC_ENDPOINT *ep)
+{
+	struct htc_credit_predictor *pred = &ep->credit_pred;
+	uint64_t stall_us;
+	int32_t delta;
+	uint32_t bin;
+
+	pred->update_requested = false;
+	if (pred->burst_credits) {
+		delta = (int32_t)(pred->burst_credits <<
+				  HTC_CREDIT_EWMA_SHIFT) -
+			(int32_t)pred->burst_ewma;
+		pred->burst_ewma += delta / HTC_CREDIT_EWMA_DIV;
+		pred->burst_credits = 0;
+	}
+
+	if (!pred->stall_start || !ep->TxCredits)
+		return;
+
+	stall_us = qdf_log_timestamp_to_usecs(qdf_get_log_timestamp() -
+					      pred->stall_start);
+	pred->stall_start = 0;
+
+	for (bin = 0; bin < HTC_CREDIT_STALL_HIST_BINS - 1; bin++) {
+		if (stall_us < htc_credit_stall_bin_us[bin])
+			break;
+	}
+	pred->stall_hist[bin]++;
+}
+
+void htc_tx_batch_record(HTC_ENDPOINT *ep, uint32_t num_pkts)
+{
+	uint32_t bin = 0;
+
+	if (!num_pkts)
+		return;
+
+	while ((1 << bin) < num_pkts && bin < HTC_TX_BATCH_HIST_BINS - 1)
+		bin++;
+	ep->credit_pred.batch_hist[bin]++;
+}
+
+/**
+ * htc_print_credit_prediction() - print the per endpoint credit model
+ * @htc: HTC handle
+ * @print: print callback
+ * @print_priv: print callback context
+ *
+ * Return: None
+ */
+static void htc_print_credit_prediction(HTC_HANDLE htc,
+					qdf_abstract_print *print,
+					void *print_priv)
+{
+	HTC_TARGET *target = GET_HTC_TARGET_FROM_HANDLE(htc);
+	struct htc_credit_predictor *pred;
+	HTC_ENDPOINT *ep;
+	int i;
+
+	if (!target)
+		return;
+
+	print(print_priv,
+	      "HTC TX batch bins: 1 2 3-4 5-8 9-16 17-32 33-64 65+");
+	print(print_priv,
+	      "HTC credit stall bins: <100us <500us <1ms <5ms <10ms <50ms <100ms 100ms+");
+
+	LOCK_HTC_TX(target);
+	for (i = 0; i < ENDPOINT_MAX; i++) {
+		ep = &target->endpoint[i];
+		if (!ep->service_id)
+			continue;
+
+		pred = &ep->credit_pred;
+		print(print_priv,
+		      "EP%d svc 0x%x credits %d burst avg %u.%02u early req %u",
+		      ep->Id, ep->service_id, ep->TxCredits,
+		      pred->burst_ewma >> HTC_CREDIT_EWMA_SHIFT,
+		      ((pred->burst_ewma & ((1 << HTC_CREDIT_EWMA_SHIFT) - 1)) *
+		       100) >> HTC_CREDIT_EWMA_SHIFT,
+		      pred->early_requests);
+		print(print_priv, "  batch %u %u %u %u %u %u %u %u",
+		      pred->batch_hist[0], pred->batch_hist[1],
+		      pred->batch_hist[2], pred->batch_hist[3],
+		      pred->batch_hist[4], pred->batch_hist[5],
+		      pred->batch_hist[6], pred->batch_hist[7]);
+		print(print_priv, "  stall %u %u %u %u %u %u %u %u",
+		      pred->stall_hist[0], pred->stall_hist[1],
+		      pred->stall_hist[2], pred->stall_hist[3],
+		      pred->stall_hist[4], pred->stall_hist[5],
+		      pred->stall_hist[6], pred->stall_hist[7]);
+	}
+	UNLOCK_HTC_TX(target);
+}
+#else
+static inline void htc_print_credit_prediction(HTC_HANDLE htc,
+					       qdf_abstract_print *print,
+					       void *print_priv)
+{
+}
+#endif /* FEATURE_HTC_CREDIT_PREDICTION */
+
 void htc_print_credit_history(HTC_HANDLE htc, uint32_t count,
 			      qdf_abstract_print *print, void *print_priv)
 {
@@ -149,6 +257,8 @@ void htc_print_credit_history(HTC_HANDLE htc, uint32_t count,
 	}
 
 	qdf_spin_unlock_bh(&g_htc_credit_lock);
+
+	htc_print_credit_prediction(htc, print, print_priv);
 }
 
 #ifdef WLAN_HANG_EVENT
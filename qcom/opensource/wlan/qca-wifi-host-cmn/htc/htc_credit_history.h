@@ -20,6 +20,7 @@
 #define _HTC_CREDIT_HISTORY_H_
 
 #include "htc_internal.h"
+#include <qdf_time.h>
 
 #ifdef FEATURE_HTC_CREDIT_HISTORY
 
@@ -79,4 +80,164 @@ void htc_credit_record(enum htc_credit_exchange_type type, uint32_t tx_credit,
 			uint32_t htc_tx_queue_depth)
 { }
 #endif /* FEATURE_HTC_CREDIT_HISTORY */
+
+#ifdef FEATURE_HTC_CREDIT_PREDICTION
+/* fixed point shift of htc_credit_predictor.burst_ewma */
+#define HTC_CREDIT_EWMA_SHIFT 4
+/* weight of the newest burst is 1/HTC_CREDIT_EWMA_DIV */
+#define HTC_CREDIT_EWMA_DIV 8
+
+/**
+ * htc_credit_predict_threshold() - credit level at which to ask for credits
+ * @ep: HTC endpoint
+ *
+ * The legacy low watermark is the number of credits needed by a single max
+ * size message. For the WMI endpoint the watermark is raised to the number
+ * of credits expected to be consumed before the next credit report, so the
+ * target is asked to return credits before a burst of commands runs the
+ * endpoint dry.
+ *
+ * Call with the HTC TX lock held.
+ *
+ * Return: credit level at or below which HTC_FLAGS_NEED_CREDIT_UPDATE is set
+ */
+static inline int htc_credit_predict_threshold(HTC_ENDPOINT *ep)
+{
+	int predicted = ep->credit_pred.burst_ewma >> HTC_CREDIT_EWMA_SHIFT;
+
+	if (ep->service_id != WMI_CONTROL_SVC ||
+	    predicted <= ep->TxCreditsPerMaxMsg)
+		return ep->TxCreditsPerMaxMsg;
+
+	return predicted;
+}
+
+/**
+ * htc_credit_predict_need_update() - check if a packet should ask for credits
+ * @ep: HTC endpoint
+ *
+ * Once the WMI endpoint is at or below htc_credit_predict_threshold() only
+ * the first packet of the burst carries HTC_FLAGS_NEED_CREDIT_UPDATE, the
+ * request is latched until the next credit report or until that packet is
+ * requeued. The other endpoints keep flagging every packet sent at or below
+ * the legacy low watermark.
+ *
+ * Call with the HTC TX lock held, after the packet credits were consumed.
+ *
+ * Return: true if HTC_FLAGS_NEED_CREDIT_UPDATE should be set
+ */
+static inline bool htc_credit_predict_need_update(HTC_ENDPOINT *ep)
+{
+	if (ep->service_id != WMI_CONTROL_SVC)
+		return ep->TxCredits <= ep->TxCreditsPerMaxMsg;
+
+	if (ep->TxCredits > htc_credit_predict_threshold(ep) ||
+	    ep->credit_pred.update_requested)
+		return false;
+
+	ep->credit_pred.update_requested = true;
+	if (ep->TxCredits > ep->TxCreditsPerMaxMsg)
+		ep->credit_pred.early_requests++;
+
+	return true;
+}
+
+/**
+ * htc_credit_predict_consume() - account credits consumed by one packet
+ * @ep: HTC endpoint
+ * @credits: credits consumed
+ *
+ * Call with the HTC TX lock held.
+ *
+ * Return: None
+ */
+static inline void htc_credit_predict_consume(HTC_ENDPOINT *ep, int credits)
+{
+	ep->credit_pred.burst_credits += credits;
+}
+
+/**
+ * htc_credit_predict_requeue() - undo the accounting of a requeued packet
+ * @ep: HTC endpoint
+ * @pkt: packet put back into the send queue, its credits reclaimed
+ *
+ * If @pkt carried the latched credit update request, the latch is cleared
+ * so that the next packet sent at or below the threshold asks again.
+ *
+ * Call with the HTC TX lock held.
+ *
+ * Return: None
+ */
+static inline void htc_credit_predict_requeue(HTC_ENDPOINT *ep,
+					      HTC_PACKET *pkt)
+{
+	struct htc_credit_predictor *pred = &ep->credit_pred;
+	uint32_t credits = pkt->PktInfo.AsTx.CreditsUsed;
+
+	pred->burst_credits -= qdf_min(pred->burst_credits, credits);
+	if (pkt->PktInfo.AsTx.SendFlags & HTC_FLAGS_NEED_CREDIT_UPDATE)
+		pred->update_requested = false;
+}
+
+/**
+ * htc_credit_predict_stall() - note that the endpoint ran out of credits
+ * @ep: HTC endpoint
+ *
+ * Call with the HTC TX lock held.
+ *
+ * Return: None
+ */
+static inline void htc_credit_predict_stall(HTC_ENDPOINT *ep)
+{
+	if (!ep->credit_pred.stall_start)
+		ep->credit_pred.stall_start = qdf_get_log_timestamp();
+}
+
+/**
+ * htc_credit_predict_replenish() - account a credit report for the endpoint
+ * @ep: HTC endpoint
+ *
+ * Folds the credits consumed since the previous report into the burst
+ * model, re-arms the credit update request and closes a pending credit
+ * stall, if any, into the stall histogram. Call with the HTC TX lock held, after the credits were added.
+ *
+ * Return: None
+ */
+void htc_credit_predict_replenish(HTC_ENDPOINT *ep);
+
+/**
+ * htc_tx_batch_record() - record the size of one send pass
+ * @ep: HTC endpoint
+ * @num_pkts: number of packets handed to HIF in the pass
+ *
+ * Return: None
+ */
+void htc_tx_batch_record(HTC_ENDPOINT *ep, uint32_t num_pkts);
+#else
+static inline bool htc_credit_predict_need_update(HTC_ENDPOINT *ep)
+{
+	return ep->TxCredits <= ep->TxCreditsPerMaxMsg;
+}
+
+static inline void htc_credit_predict_consume(HTC_ENDPOINT *ep, int credits)
+{
+}
+
+static inline void htc_credit_predict_requeue(HTC_ENDPOINT *ep,
+					      HTC_PACKET *pkt)
+{
+}
+
+static inline void htc_credit_predict_stall(HTC_ENDPOINT *ep)
+{
+}
+
+static inline void htc_credit_predict_replenish(HTC_ENDPOINT *ep)
+{
+}
+
+static inline void htc_tx_batch_record(HTC_ENDPOINT *ep, uint32_t num_pkts)
+{
+}
+#endif /* FEATURE_HTC_CREDIT_PREDICTION */
 #endif /* _HTC_CREDIT_HISTORY_H_ */
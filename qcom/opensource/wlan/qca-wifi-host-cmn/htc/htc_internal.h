@@ -118,6 +118,37 @@ htc_credit_exchange_type_str(enum htc_credit_exchange_type type)
 	}
 }
 
+#ifdef FEATURE_HTC_CREDIT_PREDICTION
+/* log2 buckets: 1, 2, 3-4, 5-8, 9-16, 17-32, 33-64, 65+ packets */
+#define HTC_TX_BATCH_HIST_BINS              8
+/* <100us, <500us, <1ms, <5ms, <10ms, <50ms, <100ms, 100ms+ */
+#define HTC_CREDIT_STALL_HIST_BINS          8
+
+/**
+ * struct htc_credit_predictor - per endpoint credit usage model
+ * @burst_ewma: moving average of credits consumed between two credit
+ *	reports, in units of 1/16 credit
+ * @burst_credits: credits consumed since the last credit report
+ * @early_requests: credit updates requested ahead of the legacy low
+ *	watermark because of the predicted burst size
+ * @update_requested: HTC_FLAGS_NEED_CREDIT_UPDATE was already sent since
+ *	the last credit report
+ * @stall_start: log timestamp of the first credit starvation not yet
+ *	relieved by a credit report, 0 if the endpoint is not stalled
+ * @batch_hist: histogram of packets handed to HIF per send pass
+ * @stall_hist: histogram of credit starvation durations
+ */
+struct htc_credit_predictor {
+	uint32_t burst_ewma;
+	uint32_t burst_credits;
+	uint32_t early_requests;
+	bool update_requested;
+	uint64_t stall_start;
+	uint32_t batch_hist[HTC_TX_BATCH_HIST_BINS];
+	uint32_t stall_hist[HTC_CREDIT_STALL_HIST_BINS];
+};
+#endif
+
 typedef struct _HTC_ENDPOINT {
 	HTC_ENDPOINT_ID Id;
 
@@ -175,6 +206,9 @@ typedef struct _HTC_ENDPOINT {
 	uint32_t num_requeues_warn;
 	/* total number of requeue attempts */
 	uint32_t total_num_requeues;
+#ifdef FEATURE_HTC_CREDIT_PREDICTION
+	struct htc_credit_predictor credit_pred;
+#endif
 
 } HTC_ENDPOINT;
 
@@ -964,6 +964,7 @@ static QDF_STATUS htc_issue_packets(HTC_TARGET *target,
 							      pPacket) {
 			    pEndpoint->TxCredits +=
 				pPacket->PktInfo.AsTx.CreditsUsed;
+			    htc_credit_predict_requeue(pEndpoint, pPacket);
 			} HTC_PACKET_QUEUE_ITERATE_END;
 			if (!pEndpoint->async_update) {
 				UNLOCK_HTC_TX(target);
@@ -1244,6 +1245,7 @@ static void get_htc_send_packets_credit_based(HTC_TARGET *target,
 						 pEndpoint->TxCredits,
 						 creditsRequired));
 #endif
+				htc_credit_predict_stall(pEndpoint);
 				if (do_pm_get)
 					hif_pm_runtime_put(target->hif_dev,
 							   rtpm_dbgid);
@@ -1253,10 +1255,10 @@ static void get_htc_send_packets_credit_based(HTC_TARGET *target,
 			pEndpoint->TxCredits -= creditsRequired;
 			INC_HTC_EP_STAT(pEndpoint, TxCreditsConsummed,
 					creditsRequired);
+			htc_credit_predict_consume(pEndpoint, creditsRequired);
 
 			/* check if we need credits back from the target */
-			if (pEndpoint->TxCredits <=
-			    pEndpoint->TxCreditsPerMaxMsg) {
+			if (htc_credit_predict_need_update(pEndpoint)) {
 				/* tell the target we need credits ASAP! */
 				sendFlags |= HTC_FLAGS_NEED_CREDIT_UPDATE;
 				if (pEndpoint->service_id == WMI_CONTROL_SVC) {
@@ -1689,6 +1691,9 @@ static enum HTC_SEND_QUEUE_RESULT htc_try_send(HTC_TARGET *target,
 			break;
 		}
 
+		htc_tx_batch_record(pEndpoint,
+				    HTC_PACKET_QUEUE_DEPTH(&sendQueue));
+
 		if (!pEndpoint->async_update)
 			UNLOCK_HTC_TX(target);
 
@@ -2803,6 +2808,7 @@ void htc_process_credit_rpt(HTC_TARGET *target, HTC_CREDIT_REPORT *pRpt,
 		}
 
 		pEndpoint->TxCredits += rpt_credits;
+		htc_credit_predict_replenish(pEndpoint);
 
 		if (pEndpoint->TxCredits
 		    && HTC_PACKET_QUEUE_DEPTH(&pEndpoint->TxQueue)) {
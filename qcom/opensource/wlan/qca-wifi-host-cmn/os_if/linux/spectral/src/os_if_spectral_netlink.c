@@ -527,6 +527,86 @@ os_if_spectral_nl_bcast_msg(struct wlan_objmgr_pdev *pdev,
 	return status;
 }
 
+#ifdef OPTIMIZED_SAMP_MESSAGE
+/**
+ * os_if_spectral_msg_len() - Length of a SAMP message
+ * @msg: SAMP message
+ *
+ * The FFT bins are appended to the message, past its fixed part.
+ *
+ * Return: length of @msg, including its FFT bins
+ */
+static size_t os_if_spectral_msg_len(struct spectral_samp_msg *msg)
+{
+	return sizeof(*msg) + msg->bin_pwr_count * sizeof(msg->bin_pwr[0]);
+}
+#else
+static size_t os_if_spectral_msg_len(struct spectral_samp_msg *msg)
+{
+	return sizeof(*msg);
+}
+#endif
+
+/**
+ * os_if_spectral_stream_msg() - Writes Spectral message to the report stream
+ * @pdev : Pointer to pdev
+ * @smsg_type: Spectral message type
+ *
+ * Used in place of the netlink send handlers when the batched report
+ * stream is open. The SAMP message, FFT bins included, is copied out of
+ * the prepared skb as one stream record of type @smsg_type and the skb is
+ * freed.
+ *
+ * Return: 0 on success, negative errno otherwise
+ */
+static int
+os_if_spectral_stream_msg(struct wlan_objmgr_pdev *pdev,
+			  enum spectral_msg_type smsg_type)
+{
+	struct pdev_spectral *ps = NULL;
+	struct qdf_streamfs_iov iov;
+	size_t max_len;
+	QDF_STATUS status;
+
+	if (!pdev) {
+		osif_err("PDEV is NULL!");
+		return -EINVAL;
+	}
+
+	if (smsg_type >= SPECTRAL_MSG_TYPE_MAX) {
+		osif_err("Invalid Spectral message type %u", smsg_type);
+		return -EINVAL;
+	}
+
+	ps = wlan_objmgr_pdev_get_comp_private_obj(pdev,
+						   WLAN_UMAC_COMP_SPECTRAL);
+	if (!ps || !ps->stream) {
+		osif_err("PDEV SPECTRAL stream is NULL!");
+		return -EINVAL;
+	}
+
+	if (!ps->skb[smsg_type]) {
+		osif_err("Socket buffer is null, msg_type= %u", smsg_type);
+		return -EINVAL;
+	}
+
+	iov.data = NLMSG_DATA((struct nlmsghdr *)ps->skb[smsg_type]->data);
+	iov.len = os_if_spectral_msg_len((struct spectral_samp_msg *)iov.data);
+	max_len = qdf_nbuf_len(ps->skb[smsg_type]) - NLMSG_HDRLEN;
+	if (iov.len > max_len) {
+		osif_err("Invalid SAMP message length %zu", iov.len);
+		status = QDF_STATUS_E_INVAL;
+	} else {
+		status = qdf_streamfs_batch_write(ps->stream, smsg_type,
+						  &iov, 1);
+	}
+
+	qdf_nbuf_free(ps->skb[smsg_type]);
+	ps->skb[smsg_type] = NULL;
+
+	return qdf_status_to_os_return(status);
+}
+
 /**
  * os_if_spectral_free_skb() - Free spectral SAMP message skb
  *
@@ -576,6 +656,7 @@ os_if_spectral_netlink_init(struct wlan_objmgr_pdev *pdev)
 {
 	struct spectral_nl_cb nl_cb = {0};
 	struct spectral_context *sptrl_ctx;
+	struct pdev_spectral *ps;
 
 	if (!pdev) {
 		osif_err("PDEV is NULL!");
@@ -601,6 +682,13 @@ os_if_spectral_netlink_init(struct wlan_objmgr_pdev *pdev)
 	nl_cb.send_nl_bcast = os_if_spectral_nl_bcast_msg;
 	nl_cb.send_nl_unicast = os_if_spectral_nl_unicast_msg;
 	nl_cb.free_sbuff = os_if_spectral_free_skb;
+
+	ps = wlan_objmgr_pdev_get_comp_private_obj(pdev,
+						   WLAN_UMAC_COMP_SPECTRAL);
+	if (ps && ps->stream) {
+		nl_cb.send_nl_bcast = os_if_spectral_stream_msg;
+		nl_cb.send_nl_unicast = os_if_spectral_stream_msg;
+	}
 	nl_cb.convert_to_phy_ch_width = wlan_spectral_get_phy_ch_width;
 	nl_cb.convert_to_nl_ch_width = wlan_spectral_get_nl80211_chwidth;
 
@@ -24,6 +24,7 @@
 #define __QDF_FILE_H
 
 #include "qdf_status.h"
+#include "qdf_types.h"
 
 /**
  * qdf_file_read() - read the entire contents of a file
@@ -40,6 +41,23 @@
  */
 QDF_STATUS qdf_file_read(const char *path, char **out_buf);
 
+/**
+ * qdf_file_read_bytes() - read the entire contents of a binary file
+ * @path: the full path of the file to read
+ * @out_buf: double pointer for referring to the file contents buffer
+ * @out_len: pointer to the number of bytes read
+ *
+ * Same as qdf_file_read(), for files which may contain null bytes. A
+ * missing file is not logged as an error, callers reading optional files
+ * log it themselves if needed.
+ *
+ * Consumers must free the allocated buffer by calling qdf_file_buf_free().
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS qdf_file_read_bytes(const char *path, char **out_buf,
+			       qdf_size_t *out_len);
+
 /**
  * qdf_file_buf_free() - free a previously allocated file buffer
  * @file_buf: pointer to the file buffer to free
@@ -369,6 +369,44 @@ static inline bool qdf_spinlock_irq_exec(qdf_handle_t hdl,
 	return __qdf_spinlock_irq_exec(hdl, &lock->lock, func, arg);
 }
 
+/**
+ * qdf_rcu_read_lock_bh() - start an RCU read side section with bottom
+ * halves disabled
+ *
+ * The section stays on one CPU and is not interrupted by the bottom halves
+ * of that CPU, so per CPU data used only from process and bottom half
+ * context may be accessed in it without a lock.
+ *
+ * Return: None
+ */
+static inline void qdf_rcu_read_lock_bh(void)
+{
+	__qdf_rcu_read_lock_bh();
+}
+
+/**
+ * qdf_rcu_read_unlock_bh() - end a section started by qdf_rcu_read_lock_bh()
+ *
+ * Return: None
+ */
+static inline void qdf_rcu_read_unlock_bh(void)
+{
+	__qdf_rcu_read_unlock_bh();
+}
+
+/**
+ * qdf_synchronize_rcu_bh() - wait for the sections started by
+ * qdf_rcu_read_lock_bh() that are in progress
+ *
+ * May sleep.
+ *
+ * Return: None
+ */
+static inline void qdf_synchronize_rcu_bh(void)
+{
+	__qdf_synchronize_rcu_bh();
+}
+
 /**
  * qdf_spin_lock() - Acquire a Spinlock(SMP) & disable Preemption (Preemptive)
  * @lock: Lock object
@@ -31,6 +31,74 @@
 typedef __qdf_streamfs_chan_t qdf_streamfs_chan_t;
 typedef __qdf_streamfs_chan_buf_t qdf_streamfs_chan_buf_t;
 
+#define QDF_STREAMFS_REC_MAGIC 0x5153
+
+/**
+ * struct qdf_streamfs_rec_hdr - header of a record on a batched channel
+ * @magic: QDF_STREAMFS_REC_MAGIC
+ * @type: producer defined record type
+ * @len: length of the payload following the header
+ * @seq: channel wide sequence number, assigned also to dropped records
+ * @lost: records dropped on the channel since the previous written record
+ *
+ * Batched channels keep one relay buffer per CPU, so records of a channel
+ * are spread over several files. The consumer merges them back in @seq
+ * order, and a gap in @seq or a non-zero @lost tells it reports were lost
+ * while it was lagging.
+ */
+struct qdf_streamfs_rec_hdr {
+	uint16_t magic;
+	uint16_t type;
+	uint32_t len;
+	uint32_t seq;
+	uint32_t lost;
+};
+
+/**
+ * struct qdf_streamfs_iov - one fragment of a batched record payload
+ * @data: fragment data
+ * @len: fragment length
+ */
+struct qdf_streamfs_iov {
+	const void *data;
+	size_t len;
+};
+
+/**
+ * struct qdf_streamfs_batch_cfg - batched channel configuration
+ * @subbuf_size: size of each per-CPU sub-buffer
+ * @n_subbufs: number of sub-buffers per CPU
+ * @coalesce: records written before the sub-buffers are flushed to the
+ *  consumer, 0 to flush only when a sub-buffer fills up
+ * @backpressure_cb: called from the write path when the channel becomes
+ *  congested (a record had to be dropped) and again when a record fits
+ *  after congestion; must not sleep
+ * @cb_ctx: context passed to @backpressure_cb
+ */
+struct qdf_streamfs_batch_cfg {
+	size_t subbuf_size;
+	size_t n_subbufs;
+	uint32_t coalesce;
+	void (*backpressure_cb)(void *cb_ctx, bool congested);
+	void *cb_ctx;
+};
+
+/**
+ * struct qdf_streamfs_batch_stats - batched channel counters
+ * @written: records written to the channel
+ * @dropped: records dropped because the consumer was lagging
+ * @flushes: coalesced flushes of the sub-buffers
+ * @congestions: transitions into the congested state
+ */
+struct qdf_streamfs_batch_stats {
+	uint32_t written;
+	uint32_t dropped;
+	uint32_t flushes;
+	uint32_t congestions;
+};
+
+typedef struct qdf_streamfs_batch *qdf_streamfs_batch_t;
+
 #ifdef WLAN_STREAMFS
 /**
  * qdf_streamfs_create_dir() - wrapper to create a debugfs directory
@@ -148,6 +216,104 @@ void qdf_streamfs_subbufs_consumed(qdf_streamfs_chan_t chan,
  */
 void qdf_streamfs_write(qdf_streamfs_chan_t chan, const void *data,
 			size_t length);
+
+/**
+ * qdf_streamfs_reserve() - reserve a slot in the channel
+ * @chan: relay channel
+ * @length: number of bytes to reserve
+ *
+ * Reserves a slot in the current cpu's channel buffer so that the caller
+ * can fill it in place. The caller must provide the synchronization
+ * needed for the current cpu's buffer.
+ *
+ * Return: pointer to the reserved slot, NULL if the channel is full
+ */
+void *qdf_streamfs_reserve(qdf_streamfs_chan_t chan, size_t length);
+
+/**
+ * qdf_streamfs_batch_open() - Open a batched, per-CPU streamfs channel
+ * @base_filename: base name of the per-CPU files, suffixed by the CPU id
+ * @parent: dentry of parent directory
+ * @cfg: channel configuration
+ *
+ * Return: channel handle, NULL on failure
+ */
+qdf_streamfs_batch_t
+qdf_streamfs_batch_open(const char *base_filename, qdf_dentry_t parent,
+			const struct qdf_streamfs_batch_cfg *cfg);
+
+/**
+ * qdf_streamfs_batch_close() - Flush and close a batched channel
+ * @batch: channel handle
+ *
+ * Return: None
+ */
+void qdf_streamfs_batch_close(qdf_streamfs_batch_t batch);
+
+/**
+ * qdf_streamfs_batch_write() - Write one record to a batched channel
+ * @batch: channel handle
+ * @type: producer defined record type
+ * @iov: payload fragments, written back to back after the record header
+ * @num_iov: number of entries in @iov
+ *
+ * The record is written to the sub-buffer of the current CPU without
+ * taking a lock, flushes switch that sub-buffer on the same CPU. It is
+ * never split, and it is dropped instead of overwriting data the consumer
+ * has not read yet. Can be called from any context.
+ *
+ * Return: QDF_STATUS_SUCCESS, QDF_STATUS_E_RESOURCES if the record was
+ * dropped because the consumer is lagging
+ */
+QDF_STATUS qdf_streamfs_batch_write(qdf_streamfs_batch_t batch, uint16_t type,
+				    const struct qdf_streamfs_iov *iov,
+				    uint8_t num_iov);
+
+/**
+ * qdf_streamfs_batch_flush() - Hand partially filled sub-buffers to the
+ * consumer
+ * @batch: channel handle
+ *
+ * Must be called from a context that can sleep, and not with interrupts
+ * disabled.
+ *
+ * Return: None
+ */
+void qdf_streamfs_batch_flush(qdf_streamfs_batch_t batch);
+
+/**
+ * qdf_streamfs_batch_is_congested() - Check if a batched channel drops
+ * records because the consumer is lagging
+ * @batch: channel handle
+ *
+ * Return: true if congested
+ */
+bool qdf_streamfs_batch_is_congested(qdf_streamfs_batch_t batch);
+
+/**
+ * qdf_streamfs_batch_get_stats() - Get batched channel counters
+ * @batch: channel handle
+ * @stats: buffer to fill with the counters
+ *
+ * Return: None
+ */
+void qdf_streamfs_batch_get_stats(qdf_streamfs_batch_t batch,
+				  struct qdf_streamfs_batch_stats *stats);
+
+#ifdef WLAN_STREAMFS_TEST
+/**
+ * qdf_streamfs_batch_count_records() - Count and check the records of a
+ * batched channel
+ * @batch: channel handle, without writer and without consumer
+ *
+ * Walks the sub-buffers of every CPU and checks that each record is
+ * complete and that sequence numbers increase within a CPU.
+ *
+ * Return: number of records, negative errno if the buffers are corrupted
+ * or being consumed
+ */
+int qdf_streamfs_batch_count_records(qdf_streamfs_batch_t batch);
+#endif
 #else
 static inline qdf_dentry_t qdf_streamfs_create_dir(
 			const char *name, qdf_dentry_t parent)
@@ -203,5 +369,44 @@ qdf_streamfs_write(qdf_streamfs_chan_t chan, const void *data,
 		   size_t length)
 {
 }
+
+static inline void *
+qdf_streamfs_reserve(qdf_streamfs_chan_t chan, size_t length)
+{
+	return NULL;
+}
+
+static inline qdf_streamfs_batch_t
+qdf_streamfs_batch_open(const char *base_filename, qdf_dentry_t parent,
+			const struct qdf_streamfs_batch_cfg *cfg)
+{
+	return NULL;
+}
+
+static inline void qdf_streamfs_batch_close(qdf_streamfs_batch_t batch)
+{
+}
+
+static inline QDF_STATUS
+qdf_streamfs_batch_write(qdf_streamfs_batch_t batch, uint16_t type,
+			 const struct qdf_streamfs_iov *iov, uint8_t num_iov)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline void qdf_streamfs_batch_flush(qdf_streamfs_batch_t batch)
+{
+}
+
+static inline bool qdf_streamfs_batch_is_congested(qdf_streamfs_batch_t batch)
+{
+	return false;
+}
+
+static inline void
+qdf_streamfs_batch_get_stats(qdf_streamfs_batch_t batch,
+			     struct qdf_streamfs_batch_stats *stats)
+{
+}
 #endif /* WLAN_STREAMFS */
 #endif /* _QDF_STREAMFS_H */
@@ -505,6 +505,20 @@ static inline uint64_t qdf_sched_clock(void)
 	return __qdf_sched_clock();
 }
 
+/**
+ * qdf_get_cycles() - get the architecture cycle counter
+ *
+ * This is the CPU cycle counter where the architecture exposes one to the
+ * kernel, and the architected timer counter otherwise. Only deltas taken on
+ * the same CPU are meaningful.
+ *
+ * Return: cycle counter value
+ */
+static inline uint64_t qdf_get_cycles(void)
+{
+	return __qdf_get_cycles();
+}
+
 /**
  * enum qdf_timestamp_unit - what unit the qdf timestamp is in
  * @KERNEL_LOG: boottime time in uS (micro seconds)
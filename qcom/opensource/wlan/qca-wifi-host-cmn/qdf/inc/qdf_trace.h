@@ -434,6 +434,55 @@ struct qdf_dp_trace_record_s {
 	uint8_t pdev_id;
 };
 
+#define QDF_DP_TRACE_BIN_MAGIC		0x42545044 /* "DPTB" */
+#define QDF_DP_TRACE_BIN_VERSION	1
+
+/**
+ * struct qdf_dp_trace_bin_hdr - header of the binary dp trace export
+ * @magic: QDF_DP_TRACE_BIN_MAGIC
+ * @version: QDF_DP_TRACE_BIN_VERSION
+ * @num_rings: number of per CPU rings the records were read from
+ * @ring_records: capacity of each per CPU ring
+ * @record_size: size of each struct qdf_dp_trace_bin_rec that follows
+ * @ts_now: log timestamp taken when the export was generated
+ * @ts_now_usecs: @ts_now converted to microseconds, lets the decoder scale
+ *  the record timestamps without knowing the timer frequency
+ *
+ * The header is followed by the valid records of every ring, ring by ring
+ * and oldest first within a ring. The decoder merges them on @time.
+ */
+struct qdf_dp_trace_bin_hdr {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t num_rings;
+	uint32_t ring_records;
+	uint32_t record_size;
+	uint64_t ts_now;
+	uint64_t ts_now_usecs;
+} qdf_packed;
+
+/**
+ * struct qdf_dp_trace_bin_rec - dp trace record in the binary export
+ * @time: log timestamp of the record
+ * @seq: sequence number of the record within its ring
+ * @pid: pid of the recording process, 0 in interrupt context
+ * @code: QDF_DP_TRACE_ID of the record
+ * @pdev_id: pdev id
+ * @size: number of valid bytes in @data
+ * @cpu: ring, ie. CPU, the record was written on
+ * @data: record payload
+ */
+struct qdf_dp_trace_bin_rec {
+	uint64_t time;
+	uint32_t seq;
+	uint32_t pid;
+	uint8_t code;
+	uint8_t pdev_id;
+	uint8_t size;
+	uint8_t cpu;
+	uint8_t data[QDF_DP_TRACE_RECORD_SIZE];
+} qdf_packed;
+
 /**
  * struct qdf_dp_trace_data - Parameters to configure/control DP trace
  * @head: Position of first record
@@ -1026,6 +1075,28 @@ void qdf_dp_log_proto_pkt_info(uint8_t *sa, uint8_t *da, uint8_t type,
  * Return: none
  */
 void qdf_dp_track_noack_check(qdf_nbuf_t nbuf, enum qdf_proto_subtype *subtype);
+
+#ifdef WLAN_DP_TRACE_PER_CPU
+/**
+ * qdf_dp_trace_get_records() - copy out the most recent dp trace records
+ * @recs: array to fill
+ * @max: number of entries in @recs
+ *
+ * The records of all CPUs are merged on their timestamp and returned
+ * oldest first.
+ *
+ * Return: number of records copied
+ */
+uint32_t qdf_dp_trace_get_records(struct qdf_dp_trace_record_s *recs,
+				  uint32_t max);
+#else
+static inline
+uint32_t qdf_dp_trace_get_records(struct qdf_dp_trace_record_s *recs,
+				  uint32_t max)
+{
+	return 0;
+}
+#endif
 #else
 static inline
 bool qdf_dp_trace_log_pkt(uint8_t vdev_id, struct sk_buff *skb,
@@ -1128,6 +1199,13 @@ void qdf_dp_track_noack_check(qdf_nbuf_t nbuf, enum qdf_proto_subtype *subtype)
 {
 }
 
+static inline
+uint32_t qdf_dp_trace_get_records(struct qdf_dp_trace_record_s *recs,
+				  uint32_t max)
+{
+	return 0;
+}
+
 static inline
 enum qdf_dp_tx_rx_status qdf_dp_get_status_from_htt(uint8_t status)
 {
@@ -663,6 +663,31 @@ int qdf_get_cpu(void)
 	return __qdf_get_cpu();
 }
 
+/**
+ * qdf_get_cpu_pinned() - get the current cpu index and stay on that cpu
+ *
+ * Preemption is disabled until qdf_put_cpu_pinned(), so per cpu data
+ * indexed by the returned cpu can be updated without a lock.
+ *
+ * Return: cpu index
+ */
+static inline
+int qdf_get_cpu_pinned(void)
+{
+	return __qdf_get_cpu_pinned();
+}
+
+/**
+ * qdf_put_cpu_pinned() - release the cpu taken by qdf_get_cpu_pinned()
+ *
+ * Return: None
+ */
+static inline
+void qdf_put_cpu_pinned(void)
+{
+	__qdf_put_cpu_pinned();
+}
+
 /**
  * qdf_get_hweight8() - count num of 1's in 8-bit bitmap
  * @value: input bitmap
@@ -734,6 +759,18 @@ uint64_t qdf_get_totalramsize(void)
 	return __qdf_get_totalramsize();
 }
 
+/**
+ * qdf_get_availramsize() - Get available ram size
+ *
+ * Return: ram size in Kb available for new allocations without swapping,
+ *	including reclaimable page cache and slab
+ */
+static inline
+uint64_t qdf_get_availramsize(void)
+{
+	return __qdf_get_availramsize();
+}
+
 /**
  * qdf_get_lower_32_bits() - get lower 32 bits from an address.
  * @addr: address
@@ -38,6 +38,7 @@
 #endif
 #include <linux/interrupt.h>
 #include <linux/pm_wakeup.h>
+#include <linux/rcupdate.h>
 
 /* define for flag */
 #define QDF_LINUX_UNLOCK_BH  1
@@ -339,6 +340,25 @@ static inline bool __qdf_spinlock_irq_exec(qdf_handle_t hdl,
 	return ret;
 }
 
+static inline void __qdf_rcu_read_lock_bh(void)
+{
+	rcu_read_lock_bh();
+}
+
+static inline void __qdf_rcu_read_unlock_bh(void)
+{
+	rcu_read_unlock_bh();
+}
+
+static inline void __qdf_synchronize_rcu_bh(void)
+{
+#if LINUX_VERSION_CODE < KERNEL_VERSION(4, 20, 0)
+	synchronize_rcu_bh();
+#else
+	synchronize_rcu();
+#endif
+}
+
 /**
  * __qdf_in_softirq() - in soft irq context
  *
@@ -38,6 +38,7 @@
 #else
 #include <linux/hrtimer.h>
 #endif
+#include <linux/timex.h>
 #ifdef MSM_PLATFORM
 #include <asm/arch_timer.h>
 #endif
@@ -278,6 +279,16 @@ static inline uint64_t __qdf_sched_clock(void)
 	return sched_clock();
 }
 
+/**
+ * __qdf_get_cycles() - get the architecture cycle counter
+ *
+ * Return: cycle counter value
+ */
+static inline uint64_t __qdf_get_cycles(void)
+{
+	return get_cycles();
+}
+
 /**
  * __qdf_get_monotonic_boottime() - get monotonic kernel boot time
  * This API is similar to qdf_get_system_boottime but it includes
@@ -319,6 +319,28 @@ int __qdf_get_cpu(void)
 }
 #endif
 
+/**
+ * __qdf_get_cpu_pinned() - get cpu_index with preemption disabled
+ *
+ * Return: cpu_index
+ */
+static inline
+int __qdf_get_cpu_pinned(void)
+{
+	return get_cpu();
+}
+
+/**
+ * __qdf_put_cpu_pinned() - enable preemption again
+ *
+ * Return: None
+ */
+static inline
+void __qdf_put_cpu_pinned(void)
+{
+	put_cpu();
+}
+
 static inline int __qdf_device_init_wakeup(__qdf_device_t qdf_dev, bool enable)
 {
 	return device_init_wakeup(qdf_dev->dev, enable);
@@ -338,6 +360,28 @@ __qdf_get_totalramsize(void)
 	return MEMINFO_KB(meminfo.totalram);
 }
 
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 6, 0)
+/**
+ * __qdf_get_availramsize() -  Get available ram size in Kb
+ *
+ * Return: Available ram size in Kb
+ */
+static inline uint64_t
+__qdf_get_availramsize(void)
+{
+	return MEMINFO_KB((uint64_t)si_mem_available());
+}
+#else
+static inline uint64_t
+__qdf_get_availramsize(void)
+{
+	struct sysinfo meminfo;
+
+	si_meminfo(&meminfo);
+	return MEMINFO_KB(meminfo.freeram);
+}
+#endif
+
 /**
  * __qdf_get_lower_32_bits() - get lower 32 bits from an address.
  * @addr: address
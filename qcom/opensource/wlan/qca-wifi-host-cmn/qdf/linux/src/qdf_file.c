@@ -72,6 +72,37 @@ QDF_STATUS qdf_file_read(const char *path, char **out_buf)
 }
 qdf_export_symbol(qdf_file_read);
 
+QDF_STATUS qdf_file_read_bytes(const char *path, char **out_buf,
+			       qdf_size_t *out_len)
+{
+	int errno;
+	const struct firmware *fw;
+	char *buf;
+
+	*out_buf = NULL;
+	*out_len = 0;
+
+	errno = qdf_firmware_request_nowarn(&fw, path, NULL);
+	if (errno) {
+		qdf_debug("Failed to read file %s", path);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	buf = qdf_mem_malloc(fw->size + 1);
+	if (!buf) {
+		release_firmware(fw);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	qdf_mem_copy(buf, fw->data, fw->size);
+	*out_len = fw->size;
+	release_firmware(fw);
+	*out_buf = buf;
+
+	return QDF_STATUS_SUCCESS;
+}
+qdf_export_symbol(qdf_file_read_bytes);
+
 void qdf_file_buf_free(char *file_buf)
 {
 	QDF_BUG(file_buf);
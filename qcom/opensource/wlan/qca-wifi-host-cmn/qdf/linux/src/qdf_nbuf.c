@@ -3313,6 +3313,9 @@ struct qdf_tso_cmn_seg_info_t {
 	uint16_t tcp_ipv6_csum_en;
 	uint16_t ip_id;
 	uint32_t tcp_seq_num;
+#ifdef FEATURE_TSO_SEG_TEMPLATE
+	struct qdf_tso_seg_t seg_tmpl;
+#endif
 };
 
 /**
@@ -3497,6 +3500,77 @@ static uint8_t __qdf_nbuf_get_tso_cmn_seg_info(qdf_device_t osdev,
 }
 
 
+#ifdef FEATURE_TSO_SEG_TEMPLATE
+/**
+ * __qdf_nbuf_init_tso_seg_tmpl() - build the per jumbo packet segment template
+ * @tso_cmn_info: Parameters common to all segements
+ *
+ * Everything that stays constant across the segments of a jumbo packet
+ * (checksum offload flags, TCP flags and the already DMA mapped EIT header
+ * fragment) is resolved once here, so that initializing a segment becomes
+ * a single structure copy instead of a memset plus a re-read of the TCP
+ * header for every segment.
+ *
+ * Return: None
+ */
+static inline void
+__qdf_nbuf_init_tso_seg_tmpl(struct qdf_tso_cmn_seg_info_t *tso_cmn_info)
+{
+	struct qdf_tso_seg_t *tmpl = &tso_cmn_info->seg_tmpl;
+
+	memset(tmpl, 0x0, sizeof(*tmpl));
+
+	tmpl->tso_flags.tso_enable = 1;
+	tmpl->tso_flags.ipv4_checksum_en = tso_cmn_info->ipv4_csum_en;
+	tmpl->tso_flags.tcp_ipv6_checksum_en = tso_cmn_info->tcp_ipv6_csum_en;
+	tmpl->tso_flags.tcp_ipv4_checksum_en = tso_cmn_info->tcp_ipv4_csum_en;
+	tmpl->tso_flags.tcp_flags_mask = 0x1FF;
+
+	tmpl->tso_flags.syn = tso_cmn_info->tcphdr->syn;
+	tmpl->tso_flags.rst = tso_cmn_info->tcphdr->rst;
+	tmpl->tso_flags.ack = tso_cmn_info->tcphdr->ack;
+	tmpl->tso_flags.urg = tso_cmn_info->tcphdr->urg;
+	tmpl->tso_flags.ece = tso_cmn_info->tcphdr->ece;
+	tmpl->tso_flags.cwr = tso_cmn_info->tcphdr->cwr;
+
+	tmpl->tso_frags[0].vaddr = tso_cmn_info->eit_hdr;
+	tmpl->tso_frags[0].length = tso_cmn_info->eit_hdr_len;
+	tmpl->tso_frags[0].paddr = tso_cmn_info->eit_hdr_dma_map_addr;
+	tmpl->total_len = tso_cmn_info->eit_hdr_len;
+}
+
+/**
+ * __qdf_nbuf_fill_tso_cmn_seg_info() - Init function for each TSO nbuf segment
+ *
+ * @curr_seg: Segment whose contents are initialized
+ * @tso_cmn_info: Parameters common to all segements
+ *
+ * Return: None
+ */
+static inline void __qdf_nbuf_fill_tso_cmn_seg_info(
+				struct qdf_tso_seg_elem_t *curr_seg,
+				struct qdf_tso_cmn_seg_info_t *tso_cmn_info)
+{
+	curr_seg->seg = tso_cmn_info->seg_tmpl;
+
+	/* The following fields change for the segments */
+	curr_seg->seg.tso_flags.ip_id = tso_cmn_info->ip_id;
+	tso_cmn_info->ip_id++;
+	curr_seg->seg.tso_flags.tcp_seq_num = tso_cmn_info->tcp_seq_num;
+
+	TSO_DEBUG("%s %d eit hdr %pK eit_hdr_len %d tcp_seq_num %u tso_info->total_len %u\n",
+		   __func__, __LINE__, tso_cmn_info->eit_hdr,
+		   tso_cmn_info->eit_hdr_len,
+		   curr_seg->seg.tso_flags.tcp_seq_num,
+		   curr_seg->seg.total_len);
+	qdf_tso_seg_dbg_record(curr_seg, TSOSEG_LOC_FILLCMNSEG);
+}
+#else
+static inline void
+__qdf_nbuf_init_tso_seg_tmpl(struct qdf_tso_cmn_seg_info_t *tso_cmn_info)
+{
+}
+
 /**
  * __qdf_nbuf_fill_tso_cmn_seg_info() - Init function for each TSO nbuf segment
  *
@@ -3554,6 +3628,7 @@ static inline void __qdf_nbuf_fill_tso_cmn_seg_info(
 		   curr_seg->seg.total_len);
 	qdf_tso_seg_dbg_record(curr_seg, TSOSEG_LOC_FILLCMNSEG);
 }
+#endif /* FEATURE_TSO_SEG_TEMPLATE */
 
 /**
  * __qdf_nbuf_get_tso_info() - function to divide a TSO nbuf
@@ -3600,6 +3675,8 @@ uint32_t __qdf_nbuf_get_tso_info(qdf_device_t osdev, struct sk_buff *skb,
 		return 0;
 	}
 
+	__qdf_nbuf_init_tso_seg_tmpl(&tso_cmn_info);
+
 	/* length of the first chunk of data in the skb */
 	skb_frag_len = skb_headlen(skb);
 
@@ -25,6 +25,47 @@
 #include <qdf_trace.h>
 #include <qdf_streamfs.h>
 #include <qdf_module.h>
+#include <qdf_atomic.h>
+#include <qdf_defer.h>
+#include <qdf_mem.h>
+#include <linux/cpu.h>
+#include <linux/smp.h>
+
+#define QDF_STREAMFS_BATCH_CONGESTED 0
+
+/**
+ * struct qdf_streamfs_batch - batched, per-CPU streamfs channel
+ * @chan: relay channel with one buffer per CPU
+ * @subbuf_size: size of each sub-buffer, bounds the record size
+ * @coalesce: records written between two flushes, 0 for no flush
+ * @backpressure_cb: congestion state change callback
+ * @cb_ctx: context for @backpressure_cb
+ * @flush_work: work flushing the sub-buffers, the flush may sleep
+ * @state: QDF_STREAMFS_BATCH_CONGESTED bit
+ * @pending: records written since the last flush was scheduled
+ * @seq: last sequence number handed out
+ * @lost: records dropped since the last written record
+ * @written: records written
+ * @dropped: records dropped
+ * @flushes: flushes scheduled
+ * @congestions: transitions into the congested state
+ */
+struct qdf_streamfs_batch {
+	qdf_streamfs_chan_t chan;
+	size_t subbuf_size;
+	uint32_t coalesce;
+	void (*backpressure_cb)(void *cb_ctx, bool congested);
+	void *cb_ctx;
+	qdf_work_t flush_work;
+	unsigned long state;
+	qdf_atomic_t pending;
+	qdf_atomic_t seq;
+	qdf_atomic_t lost;
+	qdf_atomic_t written;
+	qdf_atomic_t dropped;
+	qdf_atomic_t flushes;
+	qdf_atomic_t congestions;
+};
 
 /**
  * qdf_create_buf_file_handler() - Create streamfs buffer file
@@ -67,6 +108,31 @@ static struct rchan_callbacks g_qdf_streamfs_cb = {
 	.remove_buf_file = qdf_remove_buf_file_handler,
 };
 
+/**
+ * qdf_create_percpu_buf_file_handler() - Create per-CPU streamfs buffer file
+ * @filename: base name of files to create, suffixed with the cpu id
+ * @parent: dentry of parent directory, NULL for root directory
+ * @mode: filemode
+ * @buf: streamfs channel buf
+ * @is_global: pointer to set whether this buf file is global or not.
+ *
+ *  Returns dentry if successful, NULL otherwise.
+ */
+static qdf_dentry_t
+qdf_create_percpu_buf_file_handler(const char *filename, qdf_dentry_t parent,
+				   uint16_t mode, qdf_streamfs_chan_buf_t buf,
+				   int32_t *is_global)
+{
+	*is_global = 0;
+
+	return qdf_streamfs_create_file(filename, mode, parent, buf);
+}
+
+static struct rchan_callbacks g_qdf_streamfs_batch_cb = {
+	.create_buf_file = qdf_create_percpu_buf_file_handler,
+	.remove_buf_file = qdf_remove_buf_file_handler,
+};
+
 qdf_dentry_t
 qdf_streamfs_create_file(const char *name, uint16_t mode,
 			 qdf_dentry_t parent,
@@ -147,3 +213,337 @@ void qdf_streamfs_write(qdf_streamfs_chan_t chan,
 }
 
 qdf_export_symbol(qdf_streamfs_write);
+
+void *qdf_streamfs_reserve(qdf_streamfs_chan_t chan, size_t length)
+{
+	if (!chan)
+		return NULL;
+
+	return relay_reserve(chan, length);
+}
+
+qdf_export_symbol(qdf_streamfs_reserve);
+
+/**
+ * qdf_streamfs_batch_flush_cpu() - Flush the relay buffer of this CPU
+ * @info: relay buffer of this CPU
+ *
+ * Runs on the CPU owning the buffer with interrupts off, so it cannot
+ * interleave with qdf_streamfs_batch_write() filling a record there.
+ *
+ * Return: None
+ */
+static void qdf_streamfs_batch_flush_cpu(void *info)
+{
+	relay_switch_subbuf(info, 0);
+}
+
+/**
+ * qdf_streamfs_batch_flush_bufs() - Flush the relay buffers of all CPUs
+ * @batch: batched channel
+ *
+ * relay_flush() switches the sub-buffer of every CPU from the calling
+ * CPU, racing with the lockless writers of the other CPUs. Instead, each
+ * buffer is switched on its own CPU. Buffers of offline CPUs have no
+ * writer and are switched from here, CPU hotplug is held off meanwhile.
+ *
+ * Return: None
+ */
+static void qdf_streamfs_batch_flush_bufs(struct qdf_streamfs_batch *batch)
+{
+	struct rchan_buf *buf;
+	unsigned int cpu;
+
+	cpus_read_lock();
+	for_each_possible_cpu(cpu) {
+		buf = *per_cpu_ptr(batch->chan->buf, cpu);
+		if (!buf)
+			continue;
+
+		if (cpu_online(cpu))
+			smp_call_function_single(cpu,
+						 qdf_streamfs_batch_flush_cpu,
+						 buf, 1);
+		else
+			relay_switch_subbuf(buf, 0);
+	}
+	cpus_read_unlock();
+}
+
+/**
+ * qdf_streamfs_batch_flush_work() - Flush a batched channel from work context
+ * @arg: batched channel
+ *
+ * Return: None
+ */
+static void qdf_streamfs_batch_flush_work(void *arg)
+{
+	struct qdf_streamfs_batch *batch = arg;
+
+	qdf_streamfs_batch_flush_bufs(batch);
+}
+
+qdf_streamfs_batch_t
+qdf_streamfs_batch_open(const char *base_filename, qdf_dentry_t parent,
+			const struct qdf_streamfs_batch_cfg *cfg)
+{
+	struct qdf_streamfs_batch *batch;
+
+	if (!cfg || !cfg->subbuf_size || !cfg->n_subbufs)
+		return NULL;
+
+	batch = qdf_mem_malloc(sizeof(*batch));
+	if (!batch)
+		return NULL;
+
+	batch->subbuf_size = cfg->subbuf_size;
+	batch->coalesce = cfg->coalesce;
+	batch->backpressure_cb = cfg->backpressure_cb;
+	batch->cb_ctx = cfg->cb_ctx;
+	qdf_atomic_init(&batch->pending);
+	qdf_atomic_init(&batch->seq);
+	qdf_atomic_init(&batch->lost);
+	qdf_atomic_init(&batch->written);
+	qdf_atomic_init(&batch->dropped);
+	qdf_atomic_init(&batch->flushes);
+	qdf_atomic_init(&batch->congestions);
+	qdf_create_work(0, &batch->flush_work,
+			qdf_streamfs_batch_flush_work, batch);
+
+	batch->chan = relay_open(base_filename, (struct dentry *)parent,
+				 cfg->subbuf_size, cfg->n_subbufs,
+				 &g_qdf_streamfs_batch_cb, batch);
+	if (!batch->chan) {
+		qdf_destroy_work(0, &batch->flush_work);
+		qdf_mem_free(batch);
+		return NULL;
+	}
+
+	return batch;
+}
+
+qdf_export_symbol(qdf_streamfs_batch_open);
+
+void qdf_streamfs_batch_close(qdf_streamfs_batch_t batch)
+{
+	if (!batch)
+		return;
+
+	qdf_destroy_work(0, &batch->flush_work);
+	qdf_streamfs_batch_flush_bufs(batch);
+	relay_close(batch->chan);
+	qdf_mem_free(batch);
+}
+
+qdf_export_symbol(qdf_streamfs_batch_close);
+
+/**
+ * qdf_streamfs_batch_set_congested() - Update congestion state of a channel
+ * @batch: batched channel
+ * @congested: new congestion state
+ *
+ * Return: None
+ */
+static void qdf_streamfs_batch_set_congested(struct qdf_streamfs_batch *batch,
+					     bool congested)
+{
+	if (congested) {
+		if (qdf_atomic_test_and_set_bit(QDF_STREAMFS_BATCH_CONGESTED,
+						&batch->state))
+			return;
+		qdf_atomic_inc(&batch->congestions);
+	} else {
+		if (!qdf_atomic_test_bit(QDF_STREAMFS_BATCH_CONGESTED,
+					 &batch->state) ||
+		    !qdf_atomic_test_and_clear_bit(QDF_STREAMFS_BATCH_CONGESTED,
+						   &batch->state))
+			return;
+	}
+
+	if (batch->backpressure_cb)
+		batch->backpressure_cb(batch->cb_ctx, congested);
+}
+
+QDF_STATUS qdf_streamfs_batch_write(qdf_streamfs_batch_t batch, uint16_t type,
+				    const struct qdf_streamfs_iov *iov,
+				    uint8_t num_iov)
+{
+	struct qdf_streamfs_rec_hdr hdr;
+	unsigned long flags;
+	uint8_t *dst;
+	size_t len = 0;
+	uint8_t i;
+
+	if (!batch)
+		return QDF_STATUS_E_INVAL;
+
+	for (i = 0; i < num_iov; i++)
+		len += iov[i].len;
+
+	if (sizeof(hdr) + len > batch->subbuf_size)
+		return QDF_STATUS_E_INVAL;
+
+	hdr.magic = QDF_STREAMFS_REC_MAGIC;
+	hdr.type = type;
+	hdr.len = len;
+
+	/*
+	 * Each CPU has its own relay buffer, so keeping interrupts off on
+	 * this CPU while the record is reserved and filled is all the
+	 * serialization relay_reserve() needs. The sequence number is taken
+	 * in the same section, so that an interrupt on this CPU cannot
+	 * commit a later number ahead of this record.
+	 */
+	local_irq_save(flags);
+	dst = relay_reserve(batch->chan, sizeof(hdr) + len);
+	hdr.seq = qdf_atomic_inc_return(&batch->seq);
+	if (dst) {
+		hdr.lost = qdf_atomic_read(&batch->lost);
+		if (hdr.lost)
+			qdf_atomic_sub(hdr.lost, &batch->lost);
+		qdf_mem_copy(dst, &hdr, sizeof(hdr));
+		dst += sizeof(hdr);
+		for (i = 0; i < num_iov; i++) {
+			if (!iov[i].len)
+				continue;
+			qdf_mem_copy(dst, iov[i].data, iov[i].len);
+			dst += iov[i].len;
+		}
+	}
+	local_irq_restore(flags);
+
+	if (!dst) {
+		qdf_atomic_inc(&batch->lost);
+		qdf_atomic_inc(&batch->dropped);
+		qdf_streamfs_batch_set_congested(batch, true);
+		return QDF_STATUS_E_RESOURCES;
+	}
+
+	qdf_atomic_inc(&batch->written);
+	qdf_streamfs_batch_set_congested(batch, false);
+
+	if (batch->coalesce &&
+	    qdf_atomic_inc_return(&batch->pending) >= batch->coalesce) {
+		qdf_atomic_set(&batch->pending, 0);
+		qdf_atomic_inc(&batch->flushes);
+		qdf_sched_work(0, &batch->flush_work);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+qdf_export_symbol(qdf_streamfs_batch_write);
+
+void qdf_streamfs_batch_flush(qdf_streamfs_batch_t batch)
+{
+	if (!batch)
+		return;
+
+	qdf_atomic_set(&batch->pending, 0);
+	qdf_streamfs_batch_flush_bufs(batch);
+}
+
+qdf_export_symbol(qdf_streamfs_batch_flush);
+
+bool qdf_streamfs_batch_is_congested(qdf_streamfs_batch_t batch)
+{
+	if (!batch)
+		return false;
+
+	return qdf_atomic_test_bit(QDF_STREAMFS_BATCH_CONGESTED,
+				   &batch->state);
+}
+
+qdf_export_symbol(qdf_streamfs_batch_is_congested);
+
+void qdf_streamfs_batch_get_stats(qdf_streamfs_batch_t batch,
+				  struct qdf_streamfs_batch_stats *stats)
+{
+	if (!batch || !stats)
+		return;
+
+	stats->written = qdf_atomic_read(&batch->written);
+	stats->dropped = qdf_atomic_read(&batch->dropped);
+	stats->flushes = qdf_atomic_read(&batch->flushes);
+	stats->congestions = qdf_atomic_read(&batch->congestions);
+}
+
+qdf_export_symbol(qdf_streamfs_batch_get_stats);
+
+#ifdef WLAN_STREAMFS_TEST
+/**
+ * qdf_streamfs_batch_walk_subbuf() - Walk the records of a sub-buffer
+ * @data: start of the sub-buffer
+ * @len: bytes written to the sub-buffer
+ * @last_seq: sequence number of the previous record of the same CPU
+ *
+ * Return: number of records, -EINVAL if a record is corrupted
+ */
+static int qdf_streamfs_batch_walk_subbuf(const uint8_t *data, size_t len,
+					  uint32_t *last_seq)
+{
+	struct qdf_streamfs_rec_hdr hdr;
+	size_t off = 0;
+	int records = 0;
+
+	while (off < len) {
+		if (len - off < sizeof(hdr))
+			return -EINVAL;
+
+		qdf_mem_copy(&hdr, data + off, sizeof(hdr));
+		if (hdr.magic != QDF_STREAMFS_REC_MAGIC ||
+		    hdr.len > len - off - sizeof(hdr) ||
+		    (*last_seq && hdr.seq <= *last_seq))
+			return -EINVAL;
+
+		*last_seq = hdr.seq;
+		off += sizeof(hdr) + hdr.len;
+		records++;
+	}
+
+	return records;
+}
+
+int qdf_streamfs_batch_count_records(qdf_streamfs_batch_t batch)
+{
+	size_t subbuf_size = batch->chan->subbuf_size;
+	struct rchan_buf *buf;
+	uint32_t last_seq;
+	unsigned int cpu;
+	size_t i, len;
+	int records = 0;
+	int ret;
+
+	for_each_possible_cpu(cpu) {
+		buf = *per_cpu_ptr(batch->chan->buf, cpu);
+		if (!buf)
+			continue;
+
+		if (buf->subbufs_consumed)
+			return -EBUSY;
+
+		last_seq = 0;
+		for (i = 0; i < batch->chan->n_subbufs; i++) {
+			if (i < buf->subbufs_produced)
+				len = subbuf_size - buf->padding[i];
+			else if (i == buf->subbufs_produced &&
+				 buf->offset <= subbuf_size)
+				len = buf->offset;
+			else
+				break;
+
+			ret = qdf_streamfs_batch_walk_subbuf(buf->start +
+							     i * subbuf_size,
+							     len, &last_seq);
+			if (ret < 0)
+				return ret;
+
+			records += ret;
+		}
+	}
+
+	return records;
+}
+
+qdf_export_symbol(qdf_streamfs_batch_count_records);
+#endif /* WLAN_STREAMFS_TEST */
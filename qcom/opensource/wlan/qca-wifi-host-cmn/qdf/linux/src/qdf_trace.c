@@ -90,7 +90,46 @@ static tp_qdf_state_info_cb qdf_state_info_table[QDF_MODULE_ID_MAX];
 
 #ifdef CONFIG_DP_TRACE
 /* Static and Global variables */
-#ifdef WLAN_LOGGING_BUFFERS_DYNAMICALLY
+#ifdef WLAN_DP_TRACE_PER_CPU
+/* records per CPU ring, must be a power of 2 */
+#ifndef QDF_DP_TRACE_CPU_RECORDS
+#define QDF_DP_TRACE_CPU_RECORDS	512
+#endif
+#define QDF_DP_TRACE_CPU_RECORDS_MASK	(QDF_DP_TRACE_CPU_RECORDS - 1)
+#define QDF_DP_TRACE_NUM_RINGS		QDF_MAX_AVAILABLE_CPU
+
+/**
+ * struct qdf_dp_trace_slot - one record of a per CPU ring
+ * @seq: 1 + position the record was written at, 0 while it is written
+ * @rec: the record
+ */
+struct qdf_dp_trace_slot {
+	uint32_t seq;
+	struct qdf_dp_trace_record_s rec;
+};
+
+/**
+ * struct qdf_dp_trace_cpu_ring - dp trace records written on one CPU
+ * @widx: number of records ever reserved in the ring
+ * @tx_count: tx packets seen by qdf_dp_trace_set_track() on this CPU
+ * @rx_count: rx packets seen by qdf_dp_trace_set_track() on this CPU
+ * @slot: the records, indexed by position modulo QDF_DP_TRACE_CPU_RECORDS
+ *
+ * A writer reserves a position with an atomic increment of @widx, so
+ * writers of the same ring (eg. a softirq preempting a thread) never
+ * share a slot and no lock is taken. Readers validate each slot against
+ * its @seq and drop records that were overwritten while being read.
+ */
+struct qdf_dp_trace_cpu_ring {
+	qdf_atomic_t widx;
+	uint32_t tx_count;
+	uint32_t rx_count;
+	struct qdf_dp_trace_slot slot[QDF_DP_TRACE_CPU_RECORDS];
+};
+
+static struct qdf_dp_trace_cpu_ring *g_qdf_dp_trace_rings;
+static qdf_dentry_t g_qdf_dp_trace_bin_dentry;
+#elif defined(WLAN_LOGGING_BUFFERS_DYNAMICALLY)
 static struct qdf_dp_trace_record_s *g_qdf_dp_trace_tbl;
 #else
 static struct qdf_dp_trace_record_s
@@ -670,6 +709,332 @@ qdf_export_symbol(qdf_state_info_dump_all);
 
 #ifdef CONFIG_DP_TRACE
 
+#ifdef WLAN_DP_TRACE_PER_CPU
+static inline QDF_STATUS allocate_g_qdf_dp_trace_tbl_buffer(void)
+{
+	BUILD_BUG_ON_NOT_POWER_OF_2(QDF_DP_TRACE_CPU_RECORDS);
+
+	g_qdf_dp_trace_rings = qdf_mem_valloc(QDF_DP_TRACE_NUM_RINGS *
+					      sizeof(*g_qdf_dp_trace_rings));
+	QDF_BUG(g_qdf_dp_trace_rings);
+	return g_qdf_dp_trace_rings ? QDF_STATUS_SUCCESS : QDF_STATUS_E_NOMEM;
+}
+
+static inline void free_g_qdf_dp_trace_tbl_buffer(void)
+{
+	qdf_mem_vfree(g_qdf_dp_trace_rings);
+	g_qdf_dp_trace_rings = NULL;
+}
+
+/**
+ * qdf_dp_trace_read_slot() - read a record of a per CPU ring
+ * @ring_id: ring to read from
+ * @pos: position of the record in the ring
+ * @rec: buffer for the record, NULL to read only its timestamp
+ * @time: buffer for the timestamp, may be NULL
+ *
+ * Return: true if the record is valid, false if it was overwritten or is
+ *  still being written
+ */
+static bool qdf_dp_trace_read_slot(uint32_t ring_id, uint32_t pos,
+				   struct qdf_dp_trace_record_s *rec,
+				   uint64_t *time)
+{
+	struct qdf_dp_trace_cpu_ring *ring = &g_qdf_dp_trace_rings[ring_id];
+	struct qdf_dp_trace_slot *slot;
+	uint64_t ts = 0;
+
+	slot = &ring->slot[pos & QDF_DP_TRACE_CPU_RECORDS_MASK];
+	if (READ_ONCE(slot->seq) != pos + 1)
+		return false;
+
+	qdf_rmb();
+	if (rec)
+		*rec = slot->rec;
+	else
+		ts = READ_ONCE(slot->rec.time);
+	qdf_rmb();
+
+	if (READ_ONCE(slot->seq) != pos + 1)
+		return false;
+
+	if (time)
+		*time = rec ? rec->time : ts;
+
+	return true;
+}
+
+/**
+ * struct qdf_dp_trace_merge - time ordered walk over the per CPU rings
+ * @oldest: position of the oldest record still held by each ring
+ * @newest: position after the newest record of each ring
+ * @cur: position of the walk in each ring, records before it have been
+ *  stepped over backwards, records from it on are stepped over forwards
+ */
+struct qdf_dp_trace_merge {
+	uint32_t oldest[QDF_DP_TRACE_NUM_RINGS];
+	uint32_t newest[QDF_DP_TRACE_NUM_RINGS];
+	uint32_t cur[QDF_DP_TRACE_NUM_RINGS];
+};
+
+/**
+ * qdf_dp_trace_merge_init() - snapshot the rings and start a walk from
+ *  the newest record
+ * @merge: walk to initialize
+ *
+ * Records written after the snapshot are not part of the walk.
+ *
+ * Return: number of records held by the rings
+ */
+static uint32_t qdf_dp_trace_merge_init(struct qdf_dp_trace_merge *merge)
+{
+	uint32_t total = 0;
+	uint32_t written;
+	int i;
+
+	for (i = 0; i < QDF_DP_TRACE_NUM_RINGS; i++) {
+		written = qdf_atomic_read(&g_qdf_dp_trace_rings[i].widx);
+		merge->newest[i] = written;
+		merge->cur[i] = written;
+		merge->oldest[i] = written > QDF_DP_TRACE_CPU_RECORDS ?
+				   written - QDF_DP_TRACE_CPU_RECORDS : 0;
+		total += written - merge->oldest[i];
+	}
+
+	return total;
+}
+
+/**
+ * qdf_dp_trace_merge_peek() - get the timestamp of the next record of a ring
+ * @merge: walk in progress
+ * @ring_id: ring to peek into
+ * @forward: direction of the walk
+ * @time: buffer for the timestamp
+ *
+ * Records overwritten since the walk started are stepped over.
+ *
+ * Return: true if the ring has a next record, false if it is exhausted
+ */
+static bool qdf_dp_trace_merge_peek(struct qdf_dp_trace_merge *merge,
+				    int ring_id, bool forward, uint64_t *time)
+{
+	uint32_t *cur = &merge->cur[ring_id];
+
+	while (forward ? *cur < merge->newest[ring_id] :
+			 *cur > merge->oldest[ring_id]) {
+		if (qdf_dp_trace_read_slot(ring_id, forward ? *cur : *cur - 1,
+					   NULL, time))
+			return true;
+
+		if (forward)
+			(*cur)++;
+		else
+			(*cur)--;
+	}
+
+	return false;
+}
+
+/**
+ * qdf_dp_trace_merge_step() - step to the next record of a merged walk
+ * @merge: walk to step
+ * @forward: true to step to the next newer record, false to the next older
+ * @rec: buffer for the record stepped over
+ *
+ * Return: true if a record was read, false at the end of the walk
+ */
+static bool qdf_dp_trace_merge_step(struct qdf_dp_trace_merge *merge,
+				    bool forward,
+				    struct qdf_dp_trace_record_s *rec)
+{
+	uint64_t time, best_time = 0;
+	uint32_t pos;
+	int i, best;
+
+retry:
+	best = -1;
+	for (i = 0; i < QDF_DP_TRACE_NUM_RINGS; i++) {
+		if (!qdf_dp_trace_merge_peek(merge, i, forward, &time))
+			continue;
+
+		if (best < 0 ||
+		    (forward ? time < best_time : time > best_time)) {
+			best = i;
+			best_time = time;
+		}
+	}
+
+	if (best < 0)
+		return false;
+
+	if (forward)
+		pos = merge->cur[best]++;
+	else
+		pos = --merge->cur[best];
+
+	if (!qdf_dp_trace_read_slot(best, pos, rec, NULL))
+		goto retry;
+
+	return true;
+}
+
+/**
+ * qdf_dp_trace_this_ring() - get the ring of the current CPU
+ *
+ * Return: per CPU ring
+ */
+static inline struct qdf_dp_trace_cpu_ring *qdf_dp_trace_this_ring(void)
+{
+	return &g_qdf_dp_trace_rings[qdf_get_cpu() % QDF_DP_TRACE_NUM_RINGS];
+}
+
+/**
+ * qdf_dp_trace_get_track_count() - get the number of packets tracked
+ * @dir: direction
+ *
+ * Return: packets seen by qdf_dp_trace_set_track() in @dir on all CPUs
+ */
+static uint32_t qdf_dp_trace_get_track_count(enum qdf_proto_dir dir)
+{
+	uint32_t count = 0;
+	int i;
+
+	if (!g_qdf_dp_trace_rings)
+		return 0;
+
+	for (i = 0; i < QDF_DP_TRACE_NUM_RINGS; i++)
+		count += (dir == QDF_TX) ? g_qdf_dp_trace_rings[i].tx_count :
+					   g_qdf_dp_trace_rings[i].rx_count;
+
+	return count;
+}
+
+uint32_t qdf_dp_trace_get_records(struct qdf_dp_trace_record_s *recs,
+				  uint32_t max)
+{
+	struct qdf_dp_trace_merge merge;
+	uint32_t num, i;
+
+	if (!g_qdf_dp_trace_data.enable || !g_qdf_dp_trace_rings || !max)
+		return 0;
+
+	num = qdf_dp_trace_merge_init(&merge);
+	if (num > max)
+		num = max;
+
+	/* step back over the newest records, then copy them oldest first */
+	for (i = 0; i < num; i++)
+		if (!qdf_dp_trace_merge_step(&merge, false, &recs[0]))
+			break;
+
+	num = i;
+	for (i = 0; i < num; i++)
+		if (!qdf_dp_trace_merge_step(&merge, true, &recs[i]))
+			break;
+
+	return i;
+}
+qdf_export_symbol(qdf_dp_trace_get_records);
+
+/**
+ * qdf_dp_trace_bin_show() - export the per CPU rings in binary format
+ * @file: debugfs file to write to
+ * @arg: unused
+ *
+ * Writes a struct qdf_dp_trace_bin_hdr followed by one
+ * struct qdf_dp_trace_bin_rec per valid record, for offline decoding.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS qdf_dp_trace_bin_show(qdf_debugfs_file_t file, void *arg)
+{
+	struct qdf_dp_trace_bin_hdr hdr = {0};
+	struct qdf_dp_trace_bin_rec bin_rec;
+	struct qdf_dp_trace_record_s rec;
+	uint32_t written, pos;
+	int i;
+
+	if (!g_qdf_dp_trace_data.enable || !g_qdf_dp_trace_rings)
+		return QDF_STATUS_E_EMPTY;
+
+	hdr.magic = QDF_DP_TRACE_BIN_MAGIC;
+	hdr.version = QDF_DP_TRACE_BIN_VERSION;
+	hdr.num_rings = QDF_DP_TRACE_NUM_RINGS;
+	hdr.ring_records = QDF_DP_TRACE_CPU_RECORDS;
+	hdr.record_size = sizeof(bin_rec);
+	hdr.ts_now = qdf_get_log_timestamp();
+	hdr.ts_now_usecs = qdf_log_timestamp_to_usecs(hdr.ts_now);
+	qdf_debugfs_write(file, (uint8_t *)&hdr, sizeof(hdr));
+
+	for (i = 0; i < QDF_DP_TRACE_NUM_RINGS; i++) {
+		written = qdf_atomic_read(&g_qdf_dp_trace_rings[i].widx);
+		pos = written > QDF_DP_TRACE_CPU_RECORDS ?
+		      written - QDF_DP_TRACE_CPU_RECORDS : 0;
+
+		for (; pos < written; pos++) {
+			if (!qdf_dp_trace_read_slot(i, pos, &rec, NULL))
+				continue;
+
+			bin_rec.time = rec.time;
+			bin_rec.seq = pos;
+			bin_rec.pid = rec.pid;
+			bin_rec.code = rec.code;
+			bin_rec.pdev_id = rec.pdev_id;
+			bin_rec.size = rec.size;
+			bin_rec.cpu = i;
+			qdf_mem_copy(bin_rec.data, rec.data, sizeof(rec.data));
+			qdf_debugfs_write(file, (uint8_t *)&bin_rec,
+					  sizeof(bin_rec));
+		}
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static struct qdf_debugfs_fops g_qdf_dp_trace_bin_fops = {
+	.show = qdf_dp_trace_bin_show,
+};
+
+/**
+ * qdf_dp_trace_bin_init() - create the binary export debugfs file
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_bin_init(void)
+{
+	g_qdf_dp_trace_bin_dentry =
+		qdf_debugfs_create_file("dp_trace_bin", QDF_FILE_USR_READ,
+					NULL, &g_qdf_dp_trace_bin_fops);
+}
+
+/**
+ * qdf_dp_trace_bin_deinit() - remove the binary export debugfs file
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_bin_deinit(void)
+{
+	if (!g_qdf_dp_trace_bin_dentry)
+		return;
+
+	qdf_debugfs_remove_file(g_qdf_dp_trace_bin_dentry);
+	g_qdf_dp_trace_bin_dentry = NULL;
+}
+#else
+static uint32_t qdf_dp_trace_get_track_count(enum qdf_proto_dir dir)
+{
+	return (dir == QDF_TX) ? g_qdf_dp_trace_data.tx_count :
+				 g_qdf_dp_trace_data.rx_count;
+}
+
+static inline void qdf_dp_trace_bin_init(void)
+{
+}
+
+static inline void qdf_dp_trace_bin_deinit(void)
+{
+}
+
 #ifdef WLAN_LOGGING_BUFFERS_DYNAMICALLY
 static inline QDF_STATUS allocate_g_qdf_dp_trace_tbl_buffer(void)
 {
@@ -693,6 +1058,7 @@ static inline QDF_STATUS allocate_g_qdf_dp_trace_tbl_buffer(void)
 static inline void free_g_qdf_dp_trace_tbl_buffer(void)
 { }
 #endif
+#endif /* WLAN_DP_TRACE_PER_CPU */
 
 #define QDF_DP_TRACE_PREPEND_STR_SIZE 100
 /*
@@ -783,6 +1149,8 @@ void qdf_dp_trace_init(bool live_mode_config, uint8_t thresh,
 					qdf_dp_display_event_record;
 
 	qdf_dp_trace_cb_table[QDF_DP_TRACE_MAX] = qdf_dp_unused;
+
+	qdf_dp_trace_bin_init();
 }
 qdf_export_symbol(qdf_dp_trace_init);
 
@@ -795,6 +1163,7 @@ void qdf_dp_trace_deinit(void)
 	g_qdf_dp_trace_data.no_of_record = 0;
 	spin_unlock_bh(&l_dp_trace_lock);
 
+	qdf_dp_trace_bin_deinit();
 	free_g_qdf_dp_trace_tbl_buffer();
 }
 /**
@@ -946,6 +1315,31 @@ uint32_t qdf_dp_get_proto_bitmap(void)
  *
  * Return: None
  */
+#ifdef WLAN_DP_TRACE_PER_CPU
+void qdf_dp_trace_set_track(qdf_nbuf_t nbuf, enum qdf_proto_dir dir)
+{
+	struct qdf_dp_trace_cpu_ring *ring;
+	uint32_t count = 0;
+
+	if (!g_qdf_dp_trace_data.enable || !g_qdf_dp_trace_rings)
+		return;
+
+	/* every nth packet is picked per CPU, no lock is needed */
+	ring = qdf_dp_trace_this_ring();
+	if (QDF_TX == dir)
+		count = ++ring->tx_count;
+	else if (QDF_RX == dir)
+		count = ++ring->rx_count;
+
+	if ((g_qdf_dp_trace_data.no_of_record != 0) &&
+	    (count % g_qdf_dp_trace_data.no_of_record == 0)) {
+		if (QDF_TX == dir)
+			QDF_NBUF_CB_TX_DP_TRACE(nbuf) = 1;
+		else if (QDF_RX == dir)
+			QDF_NBUF_CB_RX_DP_TRACE(nbuf) = 1;
+	}
+}
+#else
 void qdf_dp_trace_set_track(qdf_nbuf_t nbuf, enum qdf_proto_dir dir)
 {
 	uint32_t count = 0;
@@ -968,6 +1362,7 @@ void qdf_dp_trace_set_track(qdf_nbuf_t nbuf, enum qdf_proto_dir dir)
 	}
 	spin_unlock_bh(&l_dp_trace_lock);
 }
+#endif
 qdf_export_symbol(qdf_dp_trace_set_track);
 
 /* Number of bytes to be grouped together while printing DP-Trace data */
@@ -1365,8 +1760,74 @@ end:
  * @metadata_size: sizeof meta data
  * @print: whether to print record
  *
+ * With WLAN_DP_TRACE_PER_CPU the record is written to the ring of the
+ * current CPU without taking a lock. Live mode throttling only stops the
+ * prints, the in memory verbosity is left untouched so packet level
+ * tracing stays on at high throughput.
+ *
  * Return: none
  */
+#ifdef WLAN_DP_TRACE_PER_CPU
+static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
+			      uint8_t *data, uint8_t data_size,
+			      uint8_t *meta_data, uint8_t metadata_size,
+			      bool print)
+{
+	struct qdf_dp_trace_cpu_ring *ring;
+	struct qdf_dp_trace_slot *slot;
+	struct qdf_dp_trace_record_s *rec;
+	bool print_this_record = false;
+	uint32_t pos;
+	u8 info = 0;
+
+	if (code >= QDF_DP_TRACE_MAX) {
+		QDF_TRACE_ERROR(QDF_MODULE_ID_QDF,
+				"invalid record code %u, max code %u",
+				code, QDF_DP_TRACE_MAX);
+		return;
+	}
+
+	if (qdf_unlikely(!g_qdf_dp_trace_rings))
+		return;
+
+	if (print || g_qdf_dp_trace_data.force_live_mode) {
+		print_this_record = true;
+	} else if (g_qdf_dp_trace_data.live_mode == 1) {
+		/* racy count, it only rate limits the prints */
+		print_this_record = true;
+		if (++g_qdf_dp_trace_data.print_pkt_cnt >
+				g_qdf_dp_trace_data.high_tput_thresh) {
+			g_qdf_dp_trace_data.live_mode = 0;
+			info |= QDF_DP_TRACE_RECORD_INFO_THROTTLED;
+		}
+	}
+
+	ring = qdf_dp_trace_this_ring();
+	pos = qdf_atomic_inc_return(&ring->widx) - 1;
+	slot = &ring->slot[pos & QDF_DP_TRACE_CPU_RECORDS_MASK];
+
+	/* invalidate the slot while it is rewritten */
+	WRITE_ONCE(slot->seq, 0);
+	qdf_wmb();
+
+	rec = &slot->rec;
+	rec->code = code;
+	rec->pdev_id = pdev_id;
+	rec->size = 0;
+	qdf_dp_fill_record_data(rec, data, data_size,
+				meta_data, metadata_size);
+	rec->time = qdf_get_log_timestamp();
+	rec->pid = (in_interrupt() ? 0 : current->pid);
+
+	qdf_wmb();
+	WRITE_ONCE(slot->seq, pos + 1);
+
+	info |= QDF_DP_TRACE_RECORD_INFO_LIVE;
+	if (print_this_record)
+		qdf_dp_trace_cb_table[code](rec, (uint16_t)pos,
+					    QDF_TRACE_DEFAULT_PDEV_ID, info);
+}
+#else
 static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 			      uint8_t *data, uint8_t data_size,
 			      uint8_t *meta_data, uint8_t metadata_size,
@@ -1449,6 +1910,7 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 		qdf_dp_trace_cb_table[rec->code] (rec, index,
 					QDF_TRACE_DEFAULT_PDEV_ID, info);
 }
+#endif
 
 /**
  * qdf_get_rate_limit_by_type() - Get the rate limit by pkt type
@@ -2683,6 +3145,26 @@ qdf_export_symbol(qdf_dp_trace_enable_live_mode);
  *
  * Return: none
  */
+#ifdef WLAN_DP_TRACE_PER_CPU
+void qdf_dp_trace_clear_buffer(void)
+{
+	int i;
+
+	g_qdf_dp_trace_data.num = 0;
+	g_qdf_dp_trace_data.dump_counter = 0;
+	g_qdf_dp_trace_data.num_records_to_dump = MAX_QDF_DP_TRACE_RECORDS;
+	if (!g_qdf_dp_trace_rings)
+		return;
+
+	for (i = 0; i < QDF_DP_TRACE_NUM_RINGS; i++) {
+		qdf_atomic_set(&g_qdf_dp_trace_rings[i].widx, 0);
+		g_qdf_dp_trace_rings[i].tx_count = 0;
+		g_qdf_dp_trace_rings[i].rx_count = 0;
+		qdf_mem_zero(g_qdf_dp_trace_rings[i].slot,
+			     sizeof(g_qdf_dp_trace_rings[i].slot));
+	}
+}
+#else
 void qdf_dp_trace_clear_buffer(void)
 {
 	g_qdf_dp_trace_data.head = INVALID_QDF_DP_TRACE_ADDR;
@@ -2695,13 +3177,14 @@ void qdf_dp_trace_clear_buffer(void)
 		       MAX_QDF_DP_TRACE_RECORDS *
 		       sizeof(struct qdf_dp_trace_record_s));
 }
+#endif
 qdf_export_symbol(qdf_dp_trace_clear_buffer);
 
 void qdf_dp_trace_dump_stats(void)
 {
 		DPTRACE_PRINT("STATS |DPT: tx %u rx %u icmp(%u %u) arp(%u %u) icmpv6(%u %u %u %u %u %u) dhcp(%u %u %u %u %u %u) eapol(%u %u %u %u %u)",
-			      g_qdf_dp_trace_data.tx_count,
-			      g_qdf_dp_trace_data.rx_count,
+			      qdf_dp_trace_get_track_count(QDF_TX),
+			      qdf_dp_trace_get_track_count(QDF_RX),
 			      g_qdf_dp_trace_data.icmp_req,
 			      g_qdf_dp_trace_data.icmp_resp,
 			      g_qdf_dp_trace_data.arp_req,
@@ -2897,28 +3380,14 @@ static void qdf_dpt_display_record_debugfs(qdf_debugfs_file_t file,
 				       record->data, record->size);
 }
 
-uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
-				      enum qdf_dpt_debugfs_state state)
+/**
+ * qdf_dpt_print_config_debugfs() - print dp trace config and stats
+ * @file: debugfs file to write to
+ *
+ * Return: None
+ */
+static void qdf_dpt_print_config_debugfs(qdf_debugfs_file_t file)
 {
-	uint32_t i = 0;
-	uint32_t tail;
-	uint32_t count = g_qdf_dp_trace_data.num;
-
-	if (!g_qdf_dp_trace_data.enable) {
-		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
-		  "%s: Tracing Disabled", __func__);
-		return QDF_STATUS_E_EMPTY;
-	}
-
-	if (!count) {
-		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
-		  "%s: no packets", __func__);
-		return QDF_STATUS_E_EMPTY;
-	}
-
-	if (state == QDF_DPT_DEBUGFS_STATE_SHOW_IN_PROGRESS)
-		return g_qdf_dp_trace_data.curr_pos;
-
 	qdf_debugfs_printf(file,
 		"DPT: config - bitmap 0x%x verb %u #rec %u rec_requested %u live_config %u thresh %u time_limit %u\n",
 		g_qdf_dp_trace_data.proto_bitmap,
@@ -2952,6 +3421,193 @@ uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
 		g_qdf_dp_trace_data.eapol_m3,
 		g_qdf_dp_trace_data.eapol_m4,
 		g_qdf_dp_trace_data.eapol_others);
+}
+
+/**
+ * qdf_dpt_display_record_by_code_debugfs() - print one dp trace record
+ * @file: debugfs file to write to
+ * @record: record to print
+ * @index: index printed with the record
+ *
+ * Return: None
+ */
+static void
+qdf_dpt_display_record_by_code_debugfs(qdf_debugfs_file_t file,
+				       struct qdf_dp_trace_record_s *record,
+				       uint32_t index)
+{
+	switch (record->code) {
+	case QDF_DP_TRACE_TXRX_PACKET_PTR_RECORD:
+	case QDF_DP_TRACE_TXRX_FAST_PACKET_PTR_RECORD:
+	case QDF_DP_TRACE_FREE_PACKET_PTR_RECORD:
+		qdf_dpt_display_ptr_record_debugfs(file, record, index);
+		break;
+
+	case QDF_DP_TRACE_EAPOL_PACKET_RECORD:
+	case QDF_DP_TRACE_DHCP_PACKET_RECORD:
+	case QDF_DP_TRACE_ARP_PACKET_RECORD:
+	case QDF_DP_TRACE_ICMP_PACKET_RECORD:
+	case QDF_DP_TRACE_ICMPv6_PACKET_RECORD:
+		qdf_dpt_display_proto_pkt_debugfs(file, record, index);
+		break;
+
+	case QDF_DP_TRACE_TX_CREDIT_RECORD:
+		qdf_dpt_display_credit_record_debugfs(file, record, index);
+		break;
+
+	case QDF_DP_TRACE_MGMT_PACKET_RECORD:
+		qdf_dpt_display_mgmt_pkt_debugfs(file, record, index);
+		break;
+
+	case QDF_DP_TRACE_EVENT_RECORD:
+		qdf_dpt_display_event_record_debugfs(file, record, index);
+		break;
+
+	case QDF_DP_TRACE_HDD_TX_TIMEOUT:
+		qdf_debugfs_printf(
+				file, "DPT: %04d: %llu %s\n",
+				index, record->time,
+				qdf_dp_code_to_string(record->code));
+		qdf_debugfs_printf(file, "HDD TX Timeout\n");
+		break;
+
+	case QDF_DP_TRACE_HDD_SOFTAP_TX_TIMEOUT:
+		qdf_debugfs_printf(
+				file, "DPT: %04d: %llu %s\n",
+				index, record->time,
+				qdf_dp_code_to_string(record->code));
+		qdf_debugfs_printf(file, "HDD SoftAP TX Timeout\n");
+		break;
+
+	case QDF_DP_TRACE_CE_FAST_PACKET_ERR_RECORD:
+		qdf_debugfs_printf(
+				file, "DPT: %04d: %llu %s\n",
+				index, record->time,
+				qdf_dp_code_to_string(record->code));
+		qdf_debugfs_printf(file, "CE Fast Packet Error\n");
+		break;
+
+	case QDF_DP_TRACE_MAX:
+		qdf_debugfs_printf(file,
+			"%s: QDF_DP_TRACE_MAX event should not be generated\n",
+			__func__);
+		break;
+
+	case QDF_DP_TRACE_HDD_TX_PACKET_RECORD:
+	case QDF_DP_TRACE_HDD_RX_PACKET_RECORD:
+	case QDF_DP_TRACE_TX_PACKET_RECORD:
+	case QDF_DP_TRACE_RX_PACKET_RECORD:
+	case QDF_DP_TRACE_LI_DP_TX_PACKET_RECORD:
+	case QDF_DP_TRACE_LI_DP_RX_PACKET_RECORD:
+
+	default:
+		qdf_dpt_display_record_debugfs(file, record, index);
+		break;
+	}
+}
+
+#ifdef WLAN_DP_TRACE_PER_CPU
+/* walk of the debugfs read in progress, kept across pages */
+static struct qdf_dp_trace_merge g_qdf_dpt_debugfs_merge;
+
+uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
+				      enum qdf_dpt_debugfs_state state)
+{
+	struct qdf_dp_trace_merge merge;
+	uint32_t count;
+
+	if (!g_qdf_dp_trace_data.enable || !g_qdf_dp_trace_rings) {
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
+		  "%s: Tracing Disabled", __func__);
+		return QDF_STATUS_E_EMPTY;
+	}
+
+	if (state == QDF_DPT_DEBUGFS_STATE_SHOW_IN_PROGRESS)
+		return g_qdf_dp_trace_data.dump_counter;
+
+	count = qdf_dp_trace_merge_init(&merge);
+	if (!count) {
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
+		  "%s: no packets", __func__);
+		return QDF_STATUS_E_EMPTY;
+	}
+
+	qdf_dpt_print_config_debugfs(file);
+
+	qdf_debugfs_printf(file,
+		"DPT: Total Records: %u, %u per CPU rings of %u records\n",
+		count, QDF_DP_TRACE_NUM_RINGS, QDF_DP_TRACE_CPU_RECORDS);
+
+	g_qdf_dp_trace_data.num = count;
+	g_qdf_dp_trace_data.dump_counter = 0;
+	g_qdf_dpt_debugfs_merge = merge;
+
+	return 0;
+}
+qdf_export_symbol(qdf_dpt_get_curr_pos_debugfs);
+
+QDF_STATUS qdf_dpt_dump_stats_debugfs(qdf_debugfs_file_t file,
+				      uint32_t curr_pos)
+{
+	struct qdf_dp_trace_record_s p_record;
+	uint16_t num_records_to_dump = g_qdf_dp_trace_data.num_records_to_dump;
+
+	if (!g_qdf_dp_trace_data.enable || !g_qdf_dp_trace_rings) {
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_ERROR,
+			  "%s: Tracing Disabled", __func__);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	if (num_records_to_dump > g_qdf_dp_trace_data.num)
+		num_records_to_dump = g_qdf_dp_trace_data.num;
+
+	if (WARN_ON(QDF_DP_TRACE_MAX_RECORD_SIZE <
+				QDF_DP_TRACE_PREPEND_STR_SIZE + BUFFER_SIZE))
+		return QDF_STATUS_E_FAILURE;
+
+	/* newest first, the walk resumes where the previous page stopped */
+	while (g_qdf_dp_trace_data.dump_counter < num_records_to_dump) {
+		if ((file->size - file->count) < QDF_DP_TRACE_MAX_RECORD_SIZE)
+			return QDF_STATUS_E_FAILURE;
+
+		if (!qdf_dp_trace_merge_step(&g_qdf_dpt_debugfs_merge, false,
+					     &p_record))
+			break;
+
+		qdf_dpt_display_record_by_code_debugfs(
+				file, &p_record,
+				g_qdf_dp_trace_data.dump_counter++);
+	}
+
+	g_qdf_dp_trace_data.dump_counter = 0;
+
+	return QDF_STATUS_SUCCESS;
+}
+qdf_export_symbol(qdf_dpt_dump_stats_debugfs);
+#else
+uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
+				      enum qdf_dpt_debugfs_state state)
+{
+	uint32_t i = 0;
+	uint32_t tail;
+	uint32_t count = g_qdf_dp_trace_data.num;
+
+	if (!g_qdf_dp_trace_data.enable) {
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
+		  "%s: Tracing Disabled", __func__);
+		return QDF_STATUS_E_EMPTY;
+	}
+
+	if (!count) {
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
+		  "%s: no packets", __func__);
+		return QDF_STATUS_E_EMPTY;
+	}
+
+	if (state == QDF_DPT_DEBUGFS_STATE_SHOW_IN_PROGRESS)
+		return g_qdf_dp_trace_data.curr_pos;
+
+	qdf_dpt_print_config_debugfs(file);
 
 	qdf_debugfs_printf(file,
 		"DPT: Total Records: %d, Head: %d, Tail: %d\n",
@@ -3021,76 +3677,7 @@ QDF_STATUS qdf_dpt_dump_stats_debugfs(qdf_debugfs_file_t file,
 			return QDF_STATUS_E_FAILURE;
 		}
 
-		switch (p_record.code) {
-		case QDF_DP_TRACE_TXRX_PACKET_PTR_RECORD:
-		case QDF_DP_TRACE_TXRX_FAST_PACKET_PTR_RECORD:
-		case QDF_DP_TRACE_FREE_PACKET_PTR_RECORD:
-			qdf_dpt_display_ptr_record_debugfs(file, &p_record, i);
-			break;
-
-		case QDF_DP_TRACE_EAPOL_PACKET_RECORD:
-		case QDF_DP_TRACE_DHCP_PACKET_RECORD:
-		case QDF_DP_TRACE_ARP_PACKET_RECORD:
-		case QDF_DP_TRACE_ICMP_PACKET_RECORD:
-		case QDF_DP_TRACE_ICMPv6_PACKET_RECORD:
-			qdf_dpt_display_proto_pkt_debugfs(file, &p_record, i);
-			break;
-
-		case QDF_DP_TRACE_TX_CREDIT_RECORD:
-			qdf_dpt_display_credit_record_debugfs(file, &p_record,
-							      i);
-			break;
-
-		case QDF_DP_TRACE_MGMT_PACKET_RECORD:
-			qdf_dpt_display_mgmt_pkt_debugfs(file, &p_record, i);
-			break;
-
-		case QDF_DP_TRACE_EVENT_RECORD:
-			qdf_dpt_display_event_record_debugfs(file, &p_record,
-							     i);
-			break;
-
-		case QDF_DP_TRACE_HDD_TX_TIMEOUT:
-			qdf_debugfs_printf(
-					file, "DPT: %04d: %llu %s\n",
-					i, p_record.time,
-					qdf_dp_code_to_string(p_record.code));
-			qdf_debugfs_printf(file, "HDD TX Timeout\n");
-			break;
-
-		case QDF_DP_TRACE_HDD_SOFTAP_TX_TIMEOUT:
-			qdf_debugfs_printf(
-					file, "DPT: %04d: %llu %s\n",
-					i, p_record.time,
-					qdf_dp_code_to_string(p_record.code));
-			qdf_debugfs_printf(file, "HDD SoftAP TX Timeout\n");
-			break;
-
-		case QDF_DP_TRACE_CE_FAST_PACKET_ERR_RECORD:
-			qdf_debugfs_printf(
-					file, "DPT: %04d: %llu %s\n",
-					i, p_record.time,
-					qdf_dp_code_to_string(p_record.code));
-			qdf_debugfs_printf(file, "CE Fast Packet Error\n");
-			break;
-
-		case QDF_DP_TRACE_MAX:
-			qdf_debugfs_printf(file,
-				"%s: QDF_DP_TRACE_MAX event should not be generated\n",
-				__func__);
-			break;
-
-		case QDF_DP_TRACE_HDD_TX_PACKET_RECORD:
-		case QDF_DP_TRACE_HDD_RX_PACKET_RECORD:
-		case QDF_DP_TRACE_TX_PACKET_RECORD:
-		case QDF_DP_TRACE_RX_PACKET_RECORD:
-		case QDF_DP_TRACE_LI_DP_TX_PACKET_RECORD:
-		case QDF_DP_TRACE_LI_DP_RX_PACKET_RECORD:
-
-		default:
-			qdf_dpt_display_record_debugfs(file, &p_record, i);
-			break;
-		}
+		qdf_dpt_display_record_by_code_debugfs(file, &p_record, i);
 
 		if (++g_qdf_dp_trace_data.dump_counter == num_records_to_dump)
 			break;
@@ -3109,6 +3696,7 @@ QDF_STATUS qdf_dpt_dump_stats_debugfs(qdf_debugfs_file_t file,
 	return QDF_STATUS_SUCCESS;
 }
 qdf_export_symbol(qdf_dpt_dump_stats_debugfs);
+#endif
 
 /**
  * qdf_dpt_set_value_debugfs() - Configure the value to control DP trace
@@ -3139,6 +3727,50 @@ qdf_export_symbol(qdf_dpt_set_value_debugfs);
  *
  * Return: None
  */
+#ifdef WLAN_DP_TRACE_PER_CPU
+void qdf_dp_trace_dump_all(uint32_t count, uint8_t pdev_id)
+{
+	struct qdf_dp_trace_merge merge;
+	struct qdf_dp_trace_record_s p_record;
+	uint32_t total, i;
+
+	if (!g_qdf_dp_trace_data.enable || !g_qdf_dp_trace_rings) {
+		DPTRACE_PRINT("Tracing Disabled");
+		return;
+	}
+
+	DPTRACE_PRINT(
+		"DPT: config - bitmap 0x%x verb %u #rec %u live_config %u thresh %u time_limit %u",
+		g_qdf_dp_trace_data.proto_bitmap,
+		g_qdf_dp_trace_data.verbosity,
+		g_qdf_dp_trace_data.no_of_record,
+		g_qdf_dp_trace_data.live_mode_config,
+		g_qdf_dp_trace_data.high_tput_thresh,
+		g_qdf_dp_trace_data.thresh_time_limit);
+
+	qdf_dp_trace_dump_stats();
+
+	total = qdf_dp_trace_merge_init(&merge);
+	DPTRACE_PRINT("DPT: Total Records: %u, %u per CPU rings of %u records",
+		      total, QDF_DP_TRACE_NUM_RINGS, QDF_DP_TRACE_CPU_RECORDS);
+
+	if (!count || count > total)
+		count = total;
+
+	/* step back over the count newest records, then dump oldest first */
+	for (i = 0; i < count; i++)
+		if (!qdf_dp_trace_merge_step(&merge, false, &p_record))
+			break;
+
+	count = i;
+	for (i = 0; i < count; i++) {
+		if (!qdf_dp_trace_merge_step(&merge, true, &p_record))
+			break;
+		qdf_dp_trace_cb_table[p_record.code](&p_record, (uint16_t)i,
+						     pdev_id, false);
+	}
+}
+#else
 void qdf_dp_trace_dump_all(uint32_t count, uint8_t pdev_id)
 {
 	struct qdf_dp_trace_record_s p_record;
@@ -3203,6 +3835,7 @@ void qdf_dp_trace_dump_all(uint32_t count, uint8_t pdev_id)
 		spin_unlock_bh(&l_dp_trace_lock);
 	}
 }
+#endif
 qdf_export_symbol(qdf_dp_trace_dump_all);
 
 /**
@@ -3251,6 +3884,20 @@ void qdf_dp_trace_throttle_live_mode(bool high_bw_request)
 }
 qdf_export_symbol(qdf_dp_trace_throttle_live_mode);
 
+#ifdef WLAN_DP_TRACE_PER_CPU
+/*
+ * Per CPU recording is cheap enough to keep the configured verbosity under
+ * data traffic, only live mode is throttled.
+ */
+void qdf_dp_trace_apply_tput_policy(bool is_data_traffic)
+{
+	if (!g_qdf_dp_trace_data.dynamic_verbosity_modify)
+		g_qdf_dp_trace_data.verbosity =
+					g_qdf_dp_trace_data.ini_conf_verbosity;
+
+	qdf_dp_trace_throttle_live_mode(is_data_traffic);
+}
+#else
 void qdf_dp_trace_apply_tput_policy(bool is_data_traffic)
 {
 	if (g_qdf_dp_trace_data.dynamic_verbosity_modify) {
@@ -3269,6 +3916,7 @@ check_live_mode:
 	qdf_dp_trace_throttle_live_mode(is_data_traffic);
 }
 #endif
+#endif
 
 struct qdf_print_ctrl print_ctrl_obj[MAX_PRINT_CONFIG_SUPPORTED];
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_dp_trace_test.h"
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_util.h"
+
+#define ut_dpt_iterations 4096
+#define ut_dpt_check_records 256
+#define ut_dpt_nbuf_len 64
+
+static uint64_t qdf_dp_trace_ut_run(qdf_nbuf_t nbuf, uint32_t iterations)
+{
+	uint64_t start;
+	uint32_t i;
+
+	start = qdf_get_log_timestamp();
+	for (i = 0; i < iterations; i++)
+		qdf_dp_trace_ptr(nbuf, QDF_DP_TRACE_LI_DP_TX_PACKET_PTR_RECORD,
+				 QDF_TRACE_DEFAULT_PDEV_ID,
+				 (uint8_t *)&nbuf, sizeof(nbuf), i, 0,
+				 QDF_TX_RX_STATUS_OK);
+
+	return qdf_get_log_timestamp() - start;
+}
+
+static uint32_t qdf_dp_trace_ut_check_order(struct qdf_dp_trace_record_s *recs,
+					    uint32_t num)
+{
+	uint32_t errors = 0;
+	uint32_t i;
+
+	if (num != ut_dpt_check_records) {
+		qdf_nofl_alert("FAIL: read back %u records; expected %u",
+			       num, ut_dpt_check_records);
+		errors++;
+	}
+
+	for (i = 1; i < num; i++) {
+		if (recs[i].time < recs[i - 1].time) {
+			qdf_nofl_alert("FAIL: record %u time %llu < %llu", i,
+				       recs[i].time, recs[i - 1].time);
+			errors++;
+			break;
+		}
+	}
+
+	return errors;
+}
+
+uint32_t qdf_dp_trace_unit_test(void)
+{
+	struct qdf_dp_trace_record_s *recs;
+	uint64_t traced, filtered;
+	uint32_t errors = 0;
+	uint8_t verbosity;
+	qdf_nbuf_t nbuf;
+	uint32_t num;
+
+	recs = qdf_mem_malloc(sizeof(*recs) * ut_dpt_check_records);
+	if (!recs)
+		return 1;
+
+	nbuf = qdf_nbuf_alloc(NULL, ut_dpt_nbuf_len, 0, 4, false);
+	if (!nbuf) {
+		qdf_mem_free(recs);
+		return 1;
+	}
+
+	qdf_nbuf_put_tail(nbuf, ut_dpt_nbuf_len);
+	QDF_NBUF_CB_TX_DP_TRACE(nbuf) = 1;
+	QDF_NBUF_CB_TX_PACKET_TRACK(nbuf) = QDF_NBUF_TX_PKT_DATA_TRACK;
+
+	/* keep live mode out of the way, it would measure printk */
+	qdf_dp_trace_apply_tput_policy(true);
+	verbosity = qdf_dp_get_verbosity();
+
+	qdf_dp_trace_set_verbosity(QDF_DP_TRACE_VERBOSITY_BASE);
+	filtered = qdf_dp_trace_ut_run(nbuf, ut_dpt_iterations);
+
+	qdf_dp_trace_set_verbosity(QDF_DP_TRACE_VERBOSITY_HIGH);
+	traced = qdf_dp_trace_ut_run(nbuf, ut_dpt_iterations);
+
+	num = qdf_dp_trace_get_records(recs, ut_dpt_check_records);
+
+	qdf_dp_trace_set_verbosity(verbosity);
+	qdf_nbuf_free(nbuf);
+
+	if (!num) {
+		qdf_nofl_info("DPT: tracing disabled, skipped");
+		goto free_recs;
+	}
+
+	errors += qdf_dp_trace_ut_check_order(recs, num);
+
+	qdf_nofl_info("DPT: %u packets, %llu ns/packet traced, %llu ns/packet filtered",
+		      ut_dpt_iterations,
+		      qdf_do_div(qdf_log_timestamp_to_usecs(traced) * 1000,
+				 ut_dpt_iterations),
+		      qdf_do_div(qdf_log_timestamp_to_usecs(filtered) * 1000,
+				 ut_dpt_iterations));
+
+free_recs:
+	qdf_mem_free(recs);
+
+	return errors;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <linux/if_ether.h>
+#include <linux/ip.h>
+#include <linux/tcp.h>
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_nbuf_tso_test.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_util.h"
+
+#define ut_tso_mss 1448
+#define ut_tso_num_seg 16
+#define ut_tso_hdr_len (ETH_HLEN + sizeof(struct iphdr) + sizeof(struct tcphdr))
+#define ut_tso_ip_id 0x1234
+#define ut_tso_seq 0x10000000
+#define ut_tso_iterations 1024
+
+static qdf_nbuf_t qdf_nbuf_tso_ut_build(qdf_device_t osdev)
+{
+	uint32_t len = ut_tso_hdr_len + ut_tso_mss * ut_tso_num_seg;
+	struct sk_buff *skb;
+	struct ethhdr *eth;
+	struct iphdr *iph;
+	struct tcphdr *tcph;
+
+	skb = qdf_nbuf_alloc(osdev, len, 0, 4, false);
+	if (!skb)
+		return NULL;
+
+	qdf_mem_zero(skb_put(skb, len), len);
+
+	skb_reset_mac_header(skb);
+	skb_set_network_header(skb, ETH_HLEN);
+	skb_set_transport_header(skb, ETH_HLEN + sizeof(*iph));
+	skb->protocol = htons(ETH_P_IP);
+
+	eth = eth_hdr(skb);
+	eth->h_proto = htons(ETH_P_IP);
+
+	iph = ip_hdr(skb);
+	iph->version = 4;
+	iph->ihl = sizeof(*iph) / 4;
+	iph->protocol = IPPROTO_TCP;
+	iph->id = htons(ut_tso_ip_id);
+	iph->tot_len = htons(len - ETH_HLEN);
+
+	tcph = tcp_hdr(skb);
+	tcph->doff = sizeof(*tcph) / 4;
+	tcph->seq = htonl(ut_tso_seq);
+	tcph->ack = 1;
+	tcph->psh = 1;
+
+	skb_shinfo(skb)->gso_size = ut_tso_mss;
+	skb_shinfo(skb)->gso_segs = ut_tso_num_seg;
+	skb_shinfo(skb)->gso_type = SKB_GSO_TCPV4;
+
+	return skb;
+}
+
+static void qdf_nbuf_tso_ut_init_info(struct qdf_tso_info_t *tso_info,
+				      struct qdf_tso_seg_elem_t *segs,
+				      struct qdf_tso_num_seg_elem_t *num_seg,
+				      uint32_t count)
+{
+	uint32_t i;
+
+	qdf_mem_zero(tso_info, sizeof(*tso_info));
+	for (i = 0; i < count; i++)
+		segs[i].next = (i + 1 < count) ? &segs[i + 1] : NULL;
+
+	num_seg->next = NULL;
+	tso_info->tso_seg_list = segs;
+	tso_info->tso_num_seg_list = num_seg;
+	tso_info->num_segs = count;
+}
+
+static void qdf_nbuf_tso_ut_unmap(qdf_device_t osdev,
+				  struct qdf_tso_info_t *tso_info)
+{
+	struct qdf_tso_seg_elem_t *seg;
+
+	for (seg = tso_info->tso_seg_list; seg; seg = seg->next)
+		qdf_nbuf_unmap_tso_segment(osdev, seg, !seg->next);
+}
+
+static uint32_t qdf_nbuf_tso_ut_check(struct qdf_tso_info_t *tso_info)
+{
+	struct qdf_tso_seg_elem_t *first = tso_info->tso_seg_list;
+	struct qdf_tso_seg_elem_t *seg;
+	uint32_t errors = 0;
+	uint32_t i = 0;
+
+	for (seg = first; seg; seg = seg->next, i++) {
+		struct qdf_tso_flags_t *flags = &seg->seg.tso_flags;
+
+		if (seg->seg.num_frags != 2 ||
+		    seg->seg.total_len != ut_tso_hdr_len + ut_tso_mss) {
+			qdf_nofl_alert("FAIL: seg %u frags %u len %u", i,
+				       seg->seg.num_frags, seg->seg.total_len);
+			errors++;
+		}
+
+		if (seg->seg.tso_frags[0].paddr !=
+		    first->seg.tso_frags[0].paddr) {
+			qdf_nofl_alert("FAIL: seg %u header not shared", i);
+			errors++;
+		}
+
+		if (flags->ip_id != (uint16_t)(ut_tso_ip_id + i) ||
+		    flags->tcp_seq_num != ut_tso_seq + i * ut_tso_mss) {
+			qdf_nofl_alert("FAIL: seg %u ip_id 0x%x seq 0x%x", i,
+				       flags->ip_id, flags->tcp_seq_num);
+			errors++;
+		}
+
+		if (!flags->tso_enable || !flags->ack || flags->syn ||
+		    flags->psh != (i == ut_tso_num_seg - 1)) {
+			qdf_nofl_alert("FAIL: seg %u unexpected tcp flags", i);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+uint32_t qdf_nbuf_tso_unit_test(qdf_device_t osdev)
+{
+	struct qdf_tso_seg_elem_t *segs;
+	struct qdf_tso_num_seg_elem_t num_seg;
+	struct qdf_tso_info_t tso_info;
+	uint64_t start, ticks = 0;
+	uint32_t errors = 0;
+	qdf_nbuf_t nbuf;
+	uint32_t i;
+
+	if (!osdev) {
+		qdf_nofl_alert("FAIL: no qdf device");
+		return 1;
+	}
+
+	nbuf = qdf_nbuf_tso_ut_build(osdev);
+	if (!nbuf)
+		return 1;
+
+	if (qdf_nbuf_get_tso_num_seg(nbuf) != ut_tso_num_seg) {
+		qdf_nofl_alert("FAIL: num seg %u; expected %u",
+			       qdf_nbuf_get_tso_num_seg(nbuf), ut_tso_num_seg);
+		errors++;
+		goto free_nbuf;
+	}
+
+	segs = qdf_mem_malloc(sizeof(*segs) * ut_tso_num_seg);
+	if (!segs) {
+		errors++;
+		goto free_nbuf;
+	}
+
+	qdf_nbuf_tso_ut_init_info(&tso_info, segs, &num_seg, ut_tso_num_seg);
+	if (qdf_nbuf_get_tso_info(osdev, nbuf, &tso_info) != ut_tso_num_seg) {
+		qdf_nofl_alert("FAIL: segmentation returned %u segments",
+			       tso_info.num_segs);
+		errors++;
+		goto free_segs;
+	}
+	errors += qdf_nbuf_tso_ut_check(&tso_info);
+	qdf_nbuf_tso_ut_unmap(osdev, &tso_info);
+
+	for (i = 0; i < ut_tso_iterations; i++) {
+		qdf_nbuf_tso_ut_init_info(&tso_info, segs, &num_seg,
+					  ut_tso_num_seg);
+		start = qdf_get_log_timestamp();
+		qdf_nbuf_get_tso_info(osdev, nbuf, &tso_info);
+		qdf_nbuf_tso_ut_unmap(osdev, &tso_info);
+		ticks += qdf_get_log_timestamp() - start;
+	}
+
+	qdf_nofl_info("TSO: %u segs x %u B, %u packets, %llu ticks, %llu ns/packet",
+		      ut_tso_num_seg, ut_tso_mss, ut_tso_iterations, ticks,
+		      qdf_do_div(qdf_log_timestamp_to_usecs(ticks) * 1000,
+				 ut_tso_iterations));
+
+free_segs:
+	qdf_mem_free(segs);
+free_nbuf:
+	qdf_nbuf_free(nbuf);
+
+	return errors;
+}
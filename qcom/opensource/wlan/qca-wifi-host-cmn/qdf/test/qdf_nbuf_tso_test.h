@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __QDF_NBUF_TSO_TEST
+#define __QDF_NBUF_TSO_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_NBUF_TSO_TEST
+/**
+ * qdf_nbuf_tso_unit_test() - run the qdf nbuf TSO unit test suite
+ * @osdev: qdf device used to DMA map the TSO fragments
+ *
+ * Validates the segment layout produced by qdf_nbuf_get_tso_info() for a
+ * synthetic TCP jumbo packet and logs the average cost of segmenting,
+ * mapping and unmapping one such packet.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t qdf_nbuf_tso_unit_test(qdf_device_t osdev);
+#else
+static inline uint32_t qdf_nbuf_tso_unit_test(qdf_device_t osdev)
+{
+	return 0;
+}
+#endif /* WLAN_NBUF_TSO_TEST */
+
+#endif /* __QDF_NBUF_TSO_TEST */
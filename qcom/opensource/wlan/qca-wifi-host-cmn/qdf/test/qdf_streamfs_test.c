@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_streamfs.h"
+#include "qdf_streamfs_test.h"
+#include "qdf_atomic.h"
+#include "qdf_defer.h"
+#include "qdf_trace.h"
+
+#define ut_bp_subbuf_size 256
+#define ut_bp_n_subbufs 2
+#define ut_bp_coalesce 4
+#define ut_bp_writes 256
+#define ut_bp_payload 48
+
+#define ut_race_subbuf_size 4096
+#define ut_race_n_subbufs 32
+#define ut_race_writes 2000
+#define ut_race_payload 60
+#define ut_race_flush_every 100
+
+/**
+ * struct qdf_streamfs_ut_ctx - streamfs unit test context
+ * @batch: channel under test
+ * @congested: back-pressure callbacks reporting congestion
+ * @uncongested: back-pressure callbacks reporting the end of congestion
+ * @work: writer work of the race test
+ * @progress: records attempted by the writer work
+ * @written: records the writer work got in
+ * @done: set by the writer work when it finished
+ */
+struct qdf_streamfs_ut_ctx {
+	qdf_streamfs_batch_t batch;
+	uint32_t congested;
+	uint32_t uncongested;
+	qdf_work_t work;
+	qdf_atomic_t progress;
+	uint32_t written;
+	bool done;
+};
+
+static void qdf_streamfs_ut_backpressure_cb(void *cb_ctx, bool congested)
+{
+	struct qdf_streamfs_ut_ctx *ctx = cb_ctx;
+
+	if (congested)
+		ctx->congested++;
+	else
+		ctx->uncongested++;
+}
+
+static qdf_streamfs_batch_t
+qdf_streamfs_ut_open(struct qdf_streamfs_ut_ctx *ctx, qdf_dentry_t dir,
+		     size_t subbuf_size, size_t n_subbufs, uint32_t coalesce)
+{
+	struct qdf_streamfs_batch_cfg cfg = {
+		.subbuf_size = subbuf_size,
+		.n_subbufs = n_subbufs,
+		.coalesce = coalesce,
+		.backpressure_cb = qdf_streamfs_ut_backpressure_cb,
+		.cb_ctx = ctx,
+	};
+
+	return qdf_streamfs_batch_open("ut", dir, &cfg);
+}
+
+static uint32_t qdf_streamfs_ut_backpressure(qdf_dentry_t dir)
+{
+	struct qdf_streamfs_ut_ctx ctx = {0};
+	struct qdf_streamfs_batch_stats stats = {0};
+	static uint8_t payload[ut_bp_subbuf_size];
+	struct qdf_streamfs_iov iov;
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	ctx.batch = qdf_streamfs_ut_open(&ctx, dir, ut_bp_subbuf_size,
+					 ut_bp_n_subbufs, ut_bp_coalesce);
+	QDF_BUG(ctx.batch);
+	if (!ctx.batch)
+		return 1;
+
+	/* a record never spans sub-buffers */
+	iov.data = payload;
+	iov.len = ut_bp_subbuf_size;
+	if (qdf_streamfs_batch_write(ctx.batch, 0, &iov, 1) !=
+	    QDF_STATUS_E_INVAL)
+		errors++;
+
+	/* nobody reads the channel, it must fill up and drop */
+	iov.len = ut_bp_payload;
+	for (i = 0; i < ut_bp_writes; i++)
+		status = qdf_streamfs_batch_write(ctx.batch, 0, &iov, 1);
+
+	qdf_streamfs_batch_get_stats(ctx.batch, &stats);
+	if (stats.written + stats.dropped != ut_bp_writes ||
+	    !stats.written || !stats.dropped)
+		errors++;
+
+	if (status != QDF_STATUS_E_RESOURCES ||
+	    !qdf_streamfs_batch_is_congested(ctx.batch))
+		errors++;
+
+	if (ctx.congested != stats.congestions || !ctx.congested ||
+	    ctx.uncongested + 1 != ctx.congested)
+		errors++;
+
+	if (stats.flushes != stats.written / ut_bp_coalesce)
+		errors++;
+
+	qdf_streamfs_batch_close(ctx.batch);
+
+	return errors;
+}
+
+static void qdf_streamfs_ut_writer(void *arg)
+{
+	struct qdf_streamfs_ut_ctx *ctx = arg;
+	static uint8_t payload[ut_race_payload];
+	struct qdf_streamfs_iov iov = { payload, sizeof(payload) };
+	uint32_t i;
+
+	for (i = 0; i < ut_race_writes; i++) {
+		if (QDF_IS_STATUS_SUCCESS(qdf_streamfs_batch_write(ctx->batch,
+								   1, &iov,
+								   1)))
+			ctx->written++;
+		qdf_atomic_inc(&ctx->progress);
+	}
+
+	ctx->done = true;
+}
+
+static uint32_t qdf_streamfs_ut_flush_race(qdf_dentry_t dir)
+{
+	struct qdf_streamfs_ut_ctx ctx = {0};
+	struct qdf_streamfs_batch_stats stats = {0};
+	uint32_t next_flush = ut_race_flush_every;
+	uint32_t errors = 0;
+	int records;
+
+	/* no coalescing, the flushes below are the only ones */
+	ctx.batch = qdf_streamfs_ut_open(&ctx, dir, ut_race_subbuf_size,
+					 ut_race_n_subbufs, 0);
+	QDF_BUG(ctx.batch);
+	if (!ctx.batch)
+		return 1;
+
+	qdf_atomic_init(&ctx.progress);
+	qdf_create_work(0, &ctx.work, qdf_streamfs_ut_writer, &ctx);
+	qdf_sched_work(0, &ctx.work);
+
+	while (!ctx.done) {
+		if (qdf_atomic_read(&ctx.progress) >= next_flush) {
+			qdf_streamfs_batch_flush(ctx.batch);
+			next_flush += ut_race_flush_every;
+		}
+		schedule();
+	}
+	qdf_destroy_work(0, &ctx.work);
+
+	/* every record got in whole, whichever CPU the flush ran on */
+	qdf_streamfs_batch_get_stats(ctx.batch, &stats);
+	records = qdf_streamfs_batch_count_records(ctx.batch);
+	if (records < 0 || (uint32_t)records != ctx.written ||
+	    stats.written != ctx.written ||
+	    stats.written + stats.dropped != ut_race_writes)
+		errors++;
+
+	qdf_streamfs_batch_close(ctx.batch);
+
+	return errors;
+}
+
+uint32_t qdf_streamfs_unit_test(void)
+{
+	qdf_dentry_t dir;
+	uint32_t errors = 0;
+
+	dir = qdf_streamfs_create_dir("qdf_streamfs_test", NULL);
+	if (!dir) {
+		qdf_err("Failed to create test directory");
+		return 1;
+	}
+
+	errors += qdf_streamfs_ut_backpressure(dir);
+	errors += qdf_streamfs_ut_flush_race(dir);
+
+	qdf_streamfs_remove_dir_recursive(dir);
+
+	if (errors)
+		qdf_err("%u streamfs test cases failed", errors);
+
+	return errors;
+}
@@ -569,6 +569,145 @@ wlan_spectral_psoc_obj_destroy_handler(struct wlan_objmgr_psoc *psoc,
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * spectral_stream_stop_work() - stop spectral scans on stream congestion
+ * @arg: pdev_spectral object
+ *
+ * Spectral reports are produced faster than the stream reader consumes
+ * them, stop the active scans rather than keep dropping reports.
+ *
+ * Return: None
+ */
+static void spectral_stream_stop_work(void *arg)
+{
+	struct pdev_spectral *ps = arg;
+	struct wlan_objmgr_pdev *pdev = ps->psptrl_pdev;
+	struct spectral_context *sc;
+	enum spectral_scan_mode smode = SPECTRAL_SCAN_MODE_NORMAL;
+	enum spectral_cp_error_code err;
+
+	if (ps->stream_closing)
+		return;
+
+	sc = spectral_get_spectral_ctx_from_pdev(pdev);
+	if (!sc || !sc->sptrlc_is_spectral_active ||
+	    !sc->sptrlc_stop_spectral_scan)
+		return;
+
+	for (; smode < SPECTRAL_SCAN_MODE_MAX; smode++) {
+		if (!sc->sptrlc_is_spectral_active(pdev, smode))
+			continue;
+
+		spectral_info("Stream congested, stopping spectral mode %d",
+			      smode);
+		sc->sptrlc_stop_spectral_scan(pdev, smode, &err);
+	}
+}
+
+/**
+ * spectral_stream_backpressure_cb() - congestion change of spectral stream
+ * @cb_ctx: pdev_spectral object
+ * @congested: true if reports are being dropped
+ *
+ * Called from the report path, so the scan stop is deferred to a work.
+ *
+ * Return: None
+ */
+static void spectral_stream_backpressure_cb(void *cb_ctx, bool congested)
+{
+	struct pdev_spectral *ps = cb_ctx;
+
+	if (congested)
+		qdf_sched_work(0, &ps->stream_stop_work);
+}
+
+/**
+ * spectral_stream_open() - open the batched spectral report stream
+ * @pdev: pointer to pdev object
+ * @ps: pointer to pdev_spectral object
+ *
+ * The stream is only opened when spectral_stream_coalesce is set, the
+ * reports are sent over netlink otherwise.
+ *
+ * Return: None
+ */
+static void spectral_stream_open(struct wlan_objmgr_pdev *pdev,
+				 struct pdev_spectral *ps)
+{
+	struct qdf_streamfs_batch_cfg cfg = {0};
+	char folder[32];
+
+	cfg.coalesce = cfg_get(wlan_pdev_get_psoc(pdev),
+			       CFG_SPECTRAL_STREAM_COALESCE);
+	if (!cfg.coalesce)
+		return;
+
+	qdf_snprintf(folder, sizeof(folder), "spectral%u",
+		     wlan_objmgr_pdev_get_pdev_id(pdev));
+	ps->stream_dir = qdf_streamfs_create_dir(folder, NULL);
+	if (!ps->stream_dir) {
+		spectral_err("Stream directory create failed");
+		return;
+	}
+
+	qdf_create_work(0, &ps->stream_stop_work, spectral_stream_stop_work,
+			ps);
+
+	cfg.subbuf_size = SPECTRAL_STREAM_SUBBUF_SIZE;
+	cfg.n_subbufs = SPECTRAL_STREAM_NUM_SUBBUFS;
+	cfg.backpressure_cb = spectral_stream_backpressure_cb;
+	cfg.cb_ctx = ps;
+	ps->stream = qdf_streamfs_batch_open("spectral_dump", ps->stream_dir,
+					     &cfg);
+	if (!ps->stream) {
+		spectral_err("Stream create failed");
+		qdf_destroy_work(0, &ps->stream_stop_work);
+		qdf_streamfs_remove_dir_recursive(ps->stream_dir);
+		ps->stream_dir = NULL;
+	}
+}
+
+/**
+ * spectral_stream_quiesce() - stop scan stops from the spectral stream
+ * @ps: pointer to pdev_spectral object
+ *
+ * Called before the pdev spectral deinit, after which the congestion work
+ * must not touch the scans any more. The stream itself stays open until
+ * spectral_stream_close(), as reports may still be in flight until the
+ * deinit returns.
+ *
+ * Return: None
+ */
+static void spectral_stream_quiesce(struct pdev_spectral *ps)
+{
+	if (!ps->stream)
+		return;
+
+	ps->stream_closing = true;
+	qdf_cancel_work(&ps->stream_stop_work);
+}
+
+/**
+ * spectral_stream_close() - close the batched spectral report stream
+ * @ps: pointer to pdev_spectral object
+ *
+ * Must be called once no more reports are produced, after the pdev
+ * spectral deinit.
+ *
+ * Return: None
+ */
+static void spectral_stream_close(struct pdev_spectral *ps)
+{
+	if (!ps->stream)
+		return;
+
+	qdf_streamfs_batch_close(ps->stream);
+	ps->stream = NULL;
+	qdf_destroy_work(0, &ps->stream_stop_work);
+	qdf_streamfs_remove_dir_recursive(ps->stream_dir);
+	ps->stream_dir = NULL;
+}
+
 QDF_STATUS
 wlan_spectral_pdev_obj_create_handler(struct wlan_objmgr_pdev *pdev, void *arg)
 {
@@ -616,6 +755,7 @@ wlan_spectral_pdev_obj_create_handler(struct wlan_objmgr_pdev *pdev, void *arg)
 		}
 		ps->psptrl_target_handle = target_handle;
 	}
+	spectral_stream_open(pdev, ps);
 	wlan_objmgr_pdev_component_obj_attach(pdev, WLAN_UMAC_COMP_SPECTRAL,
 					      (void *)ps, QDF_STATUS_SUCCESS);
 
@@ -650,8 +790,10 @@ wlan_spectral_pdev_obj_destroy_handler(struct wlan_objmgr_pdev *pdev,
 	ps = wlan_objmgr_pdev_get_comp_private_obj(pdev,
 						   WLAN_UMAC_COMP_SPECTRAL);
 	if (ps) {
+		spectral_stream_quiesce(ps);
 		if (sc->sptrlc_pdev_spectral_deinit)
 			sc->sptrlc_pdev_spectral_deinit(pdev);
+		spectral_stream_close(ps);
 		ps->psptrl_target_handle = NULL;
 		wlan_objmgr_pdev_component_obj_detach(pdev,
 						      WLAN_UMAC_COMP_SPECTRAL,
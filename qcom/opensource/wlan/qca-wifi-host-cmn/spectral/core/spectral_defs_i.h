@@ -28,6 +28,8 @@
 #include <qdf_list.h>
 #include <qdf_timer.h>
 #include <qdf_util.h>
+#include <qdf_defer.h>
+#include <qdf_streamfs.h>
 #include <wlan_spectral_public_structs.h>
 #include <wlan_spectral_utils_api.h>
 #include <spectral_ioctl.h>
@@ -76,6 +78,10 @@
 #define spectral_debug_rl_nofl(format, args...) \
 	QDF_TRACE_DEBUG_RL_NO_FL(QDF_MODULE_ID_SPECTRAL, format, ## args)
 
+/* Per-CPU relay buffer geometry of the batched spectral report stream */
+#define SPECTRAL_STREAM_SUBBUF_SIZE  16384
+#define SPECTRAL_STREAM_NUM_SUBBUFS  16
+
 /**
  * struct pdev_spectral - Radio specific spectral object
  * @psptrl_pdev:          Back-pointer to struct wlan_objmgr_pdev
@@ -84,6 +90,12 @@
  * @psptrl_target_handle: reference to spectral lmac object
  * @skb:                  Socket buffer for sending samples to applications
  * @spectral_pid :        Spectral port ID
+ * @stream_dir:           streamfs directory of @stream
+ * @stream:               Batched relay channel used for the samples instead
+ *                        of netlink when spectral_stream_coalesce is set
+ * @stream_stop_work:     Work stopping the scans when @stream is congested
+ * @stream_closing:       Set once the pdev spectral deinit started, the
+ *                        scans are not stopped by @stream_stop_work then
  */
 struct pdev_spectral {
 	struct wlan_objmgr_pdev *psptrl_pdev;
@@ -91,6 +103,10 @@ struct pdev_spectral {
 	void *psptrl_target_handle;
 	struct sk_buff *skb[SPECTRAL_MSG_TYPE_MAX];
 	uint32_t spectral_pid;
+	qdf_dentry_t stream_dir;
+	qdf_streamfs_batch_t stream;
+	qdf_work_t stream_stop_work;
+	bool stream_closing;
 };
 
 struct spectral_wmi_ops;
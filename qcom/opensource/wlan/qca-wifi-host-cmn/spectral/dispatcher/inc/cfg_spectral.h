@@ -64,8 +64,39 @@
 	CFG_INI_BOOL("poison_spectral_bufs", false, \
 			"Enable spectral bufs poison at init")
 
+/*
+ * <ini>
+ * spectral_stream_coalesce - Spectral reports batched per streamfs flush
+ * @Min: 0
+ * @Max: 256
+ * @Default: 0
+ *
+ * This ini selects how Spectral reports are delivered to user space. With
+ * 0 each report is sent as a netlink message. A non-zero value streams
+ * the reports as sequence numbered records through per-CPU relay buffers
+ * (spectral<pdev_id>/spectral_dump<cpu>), flushed once per this many
+ * reports. When the reader lags and reports start being dropped, the
+ * active Spectral scans are stopped.
+ *
+ * Related: None
+ *
+ * Supported Feature: Spectral
+ *
+ * Usage: External
+ *
+ * </ini>
+ */
+#define CFG_SPECTRAL_STREAM_COALESCE \
+	CFG_INI_UINT("spectral_stream_coalesce", \
+		0, \
+		256, \
+		0, \
+		CFG_VALUE_OR_DEFAULT, \
+		"spectral reports per streamfs flush")
+
 #define CFG_SPECTRAL_ALL \
 	CFG(CFG_SPECTRAL_DISABLE) \
-	CFG(CFG_SPECTRAL_POISON_BUFS)
+	CFG(CFG_SPECTRAL_POISON_BUFS) \
+	CFG(CFG_SPECTRAL_STREAM_COALESCE)
 
 #endif
@@ -33,6 +33,10 @@
 
 #define CFR_STOP_STR           "CFR-CAPTURE-STOPPED"
 
+/* Record types on the batched CFR streamfs channel */
+#define CFR_STREAM_REC_REPORT  0
+#define CFR_STREAM_REC_STOP    1
+
 /**
  * wlan_cfr_psoc_obj_create_handler() - psoc object create handler for cfr
  * @psoc - pointer to psoc object
@@ -132,6 +136,27 @@ cfr_streamfs_write(struct pdev_cfr *pa, const void *write_data,
 QDF_STATUS
 cfr_streamfs_flush(struct pdev_cfr *pa);
 
+/**
+ * cfr_streamfs_write_report() - write one CFR report to stream filesystem
+ * @pa - pointer to pdev_cfr object
+ * @head - report header
+ * @hlen - header length
+ * @data - CFR data
+ * @dlen - data length
+ * @tail - report trailer
+ * @tlen - trailer length
+ *
+ * On the batched channel the report is written as a single record and
+ * flushed together with other reports, otherwise it is written to the
+ * global channel and flushed on its own.
+ *
+ * Return: status of fs write
+ */
+QDF_STATUS
+cfr_streamfs_write_report(struct pdev_cfr *pa, const void *head, size_t hlen,
+			  const void *data, size_t dlen, const void *tail,
+			  size_t tlen);
+
 /**
  * cfr_stop_indication() - write cfr stop string
  * @vdev - pointer to vdev object
@@ -390,6 +390,55 @@ static char *cfr_get_dev_name(struct wlan_objmgr_pdev *pdev)
 }
 #endif
 
+/**
+ * cfr_stream_backpressure_cb() - congestion change of batched CFR channel
+ * @cb_ctx: pdev_cfr object
+ * @congested: true if reports are being dropped
+ *
+ * Return: None
+ */
+static void cfr_stream_backpressure_cb(void *cb_ctx, bool congested)
+{
+	struct pdev_cfr *pa = cb_ctx;
+
+	if (congested)
+		cfr_debug("pdev %d: cfr reader lagging, dropping reports",
+			  wlan_objmgr_pdev_get_pdev_id(pa->pdev_obj));
+	else
+		cfr_debug("pdev %d: cfr reader caught up",
+			  wlan_objmgr_pdev_get_pdev_id(pa->pdev_obj));
+}
+
+/**
+ * cfr_streamfs_open() - open the CFR streamfs channel
+ * @pdev: pointer to pdev object
+ * @pa: pointer to pdev_cfr object
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS cfr_streamfs_open(struct wlan_objmgr_pdev *pdev,
+				    struct pdev_cfr *pa)
+{
+	struct qdf_streamfs_batch_cfg cfg = {0};
+
+	cfg.coalesce = cfg_get(wlan_pdev_get_psoc(pdev),
+			       CFG_CFR_STREAM_COALESCE);
+	if (!cfg.coalesce) {
+		pa->chan_ptr = qdf_streamfs_open("cfr_dump", pa->dir_ptr,
+						 pa->subbuf_size,
+						 pa->num_subbufs, NULL);
+		return pa->chan_ptr ? QDF_STATUS_SUCCESS : QDF_STATUS_E_FAILURE;
+	}
+
+	cfg.subbuf_size = pa->subbuf_size;
+	cfg.n_subbufs = pa->num_subbufs;
+	cfg.backpressure_cb = cfr_stream_backpressure_cb;
+	cfg.cb_ctx = pa;
+	pa->stream = qdf_streamfs_batch_open("cfr_dump", pa->dir_ptr, &cfg);
+
+	return pa->stream ? QDF_STATUS_SUCCESS : QDF_STATUS_E_FAILURE;
+}
+
 QDF_STATUS cfr_streamfs_init(struct wlan_objmgr_pdev *pdev)
 {
 	struct pdev_cfr *pa = NULL;
@@ -433,11 +482,7 @@ QDF_STATUS cfr_streamfs_init(struct wlan_objmgr_pdev *pdev)
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	pa->chan_ptr = qdf_streamfs_open("cfr_dump", pa->dir_ptr,
-					 pa->subbuf_size,
-					 pa->num_subbufs, NULL);
-
-	if (!pa->chan_ptr) {
+	if (QDF_IS_STATUS_ERROR(cfr_streamfs_open(pdev, pa))) {
 		cfr_err("Chan create failed");
 		qdf_streamfs_remove_dir_recursive(pa->dir_ptr);
 		pa->dir_ptr = NULL;
@@ -463,6 +508,11 @@ QDF_STATUS cfr_streamfs_remove(struct wlan_objmgr_pdev *pdev)
 			pa->chan_ptr = NULL;
 		}
 
+		if (pa->stream) {
+			qdf_streamfs_batch_close(pa->stream);
+			pa->stream = NULL;
+		}
+
 		if (pa->dir_ptr) {
 			qdf_streamfs_remove_dir_recursive(pa->dir_ptr);
 			pa->dir_ptr = NULL;
@@ -489,6 +539,11 @@ QDF_STATUS cfr_streamfs_write(struct pdev_cfr *pa, const void *write_data,
 
 QDF_STATUS cfr_streamfs_flush(struct pdev_cfr *pa)
 {
+	if (pa->stream) {
+		qdf_streamfs_batch_flush(pa->stream);
+		return QDF_STATUS_SUCCESS;
+	}
+
 	if (pa->chan_ptr) {
 
 	/* Flush the data write to channel buffer */
@@ -499,6 +554,42 @@ QDF_STATUS cfr_streamfs_flush(struct pdev_cfr *pa)
 	return QDF_STATUS_SUCCESS;
 }
 
+QDF_STATUS
+cfr_streamfs_write_report(struct pdev_cfr *pa, const void *head, size_t hlen,
+			  const void *data, size_t dlen, const void *tail,
+			  size_t tlen)
+{
+	struct qdf_streamfs_iov iov[3];
+	QDF_STATUS status = QDF_STATUS_E_FAILURE;
+
+	if (pa->stream) {
+		iov[0].data = head;
+		iov[0].len = head ? hlen : 0;
+		iov[1].data = data;
+		iov[1].len = data ? dlen : 0;
+		iov[2].data = tail;
+		iov[2].len = tail ? tlen : 0;
+
+		return qdf_streamfs_batch_write(pa->stream,
+						CFR_STREAM_REC_REPORT,
+						iov, QDF_ARRAY_SIZE(iov));
+	}
+
+	if (head)
+		status = cfr_streamfs_write(pa, head, hlen);
+
+	if (data)
+		status = cfr_streamfs_write(pa, data, dlen);
+
+	if (tail)
+		status = cfr_streamfs_write(pa, tail, tlen);
+
+	/* finalise the write */
+	status = cfr_streamfs_flush(pa);
+
+	return status;
+}
+
 QDF_STATUS cfr_stop_indication(struct wlan_objmgr_vdev *vdev)
 {
 	struct pdev_cfr *pa;
@@ -518,6 +609,18 @@ QDF_STATUS cfr_stop_indication(struct wlan_objmgr_vdev *vdev)
 	if (pa->nl_cb.cfr_nl_cb)
 		return QDF_STATUS_SUCCESS;
 
+	if (pa->stream) {
+		struct qdf_streamfs_iov iov = {CFR_STOP_STR,
+					       sizeof(CFR_STOP_STR)};
+
+		qdf_streamfs_batch_write(pa->stream, CFR_STREAM_REC_STOP,
+					 &iov, 1);
+		qdf_streamfs_batch_flush(pa->stream);
+		cfr_debug("stop indication done");
+
+		return QDF_STATUS_SUCCESS;
+	}
+
 	status = cfr_streamfs_write(pa, (const void *)CFR_STOP_STR,
 				    sizeof(CFR_STOP_STR));
 
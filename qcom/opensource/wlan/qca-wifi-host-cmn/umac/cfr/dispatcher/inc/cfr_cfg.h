@@ -49,7 +49,39 @@
 		"cfr disable bitmap")
 
 
+/*
+ * <ini>
+ * cfr_stream_coalesce - CFR reports batched per streamfs flush
+ * @Min: 0
+ * @Max: 256
+ * @Default: 0
+ *
+ * This ini selects how CFR reports are streamed to user space over
+ * streamfs. With 0 each report is written to one global relay buffer and
+ * flushed on its own. A non-zero value switches to a batched channel:
+ * reports are written as sequence numbered records to per-CPU relay
+ * buffers (cfr_dump0, cfr_dump1, ...), reports are dropped and counted
+ * rather than overwritten when the reader lags, and the buffers are
+ * flushed once per this many reports.
+ *
+ * Related: None
+ *
+ * Supported Feature: CFR
+ *
+ * Usage: External
+ *
+ * </ini>
+ */
+#define CFG_CFR_STREAM_COALESCE \
+	CFG_INI_UINT("cfr_stream_coalesce", \
+		0, \
+		256, \
+		0, \
+		CFG_VALUE_OR_DEFAULT, \
+		"cfr reports per streamfs flush")
+
 #define CFG_CFR_ALL \
-	CFG(CFG_CFR_DISABLE)
+	CFG(CFG_CFR_DISABLE) \
+	CFG(CFG_CFR_STREAM_COALESCE)
 
 #endif /* __CFR_CONFIG_H */
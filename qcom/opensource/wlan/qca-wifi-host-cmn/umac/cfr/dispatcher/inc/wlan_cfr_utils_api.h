@@ -516,6 +516,8 @@ struct nl_event_cb {
  * subbuf_size: Size of sub-buffer used in relayfs
  * chan_ptr: Channel in relayfs
  * dir_ptr: Parent directory of relayfs file
+ * stream: Batched per-CPU relayfs channel, used instead of chan_ptr when
+ * cfr_stream_coalesce is set
  * lut: lookup table used to store asynchronous DBR and TX/RX events for
  * correlation
  * lut_num: Number of lut
@@ -580,6 +582,7 @@ struct pdev_cfr {
 	uint32_t subbuf_size;
 	qdf_streamfs_chan_t chan_ptr;
 	qdf_dentry_t dir_ptr;
+	qdf_streamfs_batch_t stream;
 	struct look_up_table **lut;
 	uint32_t lut_num;
 	uint32_t dbr_buf_size;
@@ -31,7 +31,7 @@ uint32_t tgt_cfr_info_send(struct wlan_objmgr_pdev *pdev, void *head,
 			   size_t tlen)
 {
 	struct pdev_cfr *pa;
-	uint32_t status, total_len;
+	uint32_t total_len;
 	uint8_t *nl_data = NULL;
 
 	pa = wlan_objmgr_pdev_get_comp_private_obj(pdev, WLAN_UMAC_COMP_CFR);
@@ -68,20 +68,8 @@ uint32_t tgt_cfr_info_send(struct wlan_objmgr_pdev *pdev, void *head,
 		return QDF_STATUS_SUCCESS;
 	}
 
-	if (head)
-		status = cfr_streamfs_write(pa, (const void *)head, hlen);
-
-	if (data)
-		status = cfr_streamfs_write(pa, (const void *)data, dlen);
-
-	if (tail)
-		status = cfr_streamfs_write(pa, (const void *)tail, tlen);
-
-
-	/* finalise the write */
-	status = cfr_streamfs_flush(pa);
-
-	return status;
+	return cfr_streamfs_write_report(pa, head, hlen, data, dlen,
+					 tail, tlen);
 }
 
 void tgt_cfr_support_set(struct wlan_objmgr_psoc *psoc, uint32_t value)
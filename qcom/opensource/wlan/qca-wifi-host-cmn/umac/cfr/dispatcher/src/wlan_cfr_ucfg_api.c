@@ -1074,6 +1074,14 @@ QDF_STATUS ucfg_cfr_rcc_dump_dbg_counters(struct wlan_objmgr_vdev *vdev)
 		pcfr->clear_txrx_event);
 	cfr_err("cfr_dma_aborts = %llu\n",
 		pcfr->cfr_dma_aborts);
+	if (pcfr->stream) {
+		struct qdf_streamfs_batch_stats stream_stats = {0};
+
+		qdf_streamfs_batch_get_stats(pcfr->stream, &stream_stats);
+		cfr_err("stream written = %u dropped = %u flushes = %u congestions = %u\n",
+			stream_stats.written, stream_stats.dropped,
+			stream_stats.flushes, stream_stats.congestions);
+	}
 
 	cfr_rcc_stats = qdf_mem_malloc(sizeof(struct cdp_cfr_rcc_stats));
 	if (!cfr_rcc_stats) {
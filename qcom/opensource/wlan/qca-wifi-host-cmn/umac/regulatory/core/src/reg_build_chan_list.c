@@ -1794,8 +1794,18 @@ reg_modify_chan_list_for_avoid_chan_ext(struct wlan_regulatory_pdev_priv_obj
 }
 #endif
 
-void reg_compute_pdev_current_chan_list(struct wlan_regulatory_pdev_priv_obj
-					*pdev_priv_obj)
+/**
+ * reg_compute_pdev_base_chan_list() - Compute the base of the current channel
+ * list
+ * @pdev_priv_obj: Pointer to regulatory pdev private object
+ *
+ * Applies the passes which depend only on the master channel lists and the
+ * pdev configuration, and caches the result in base_chan_list so that updates
+ * of the NOL state can skip them.
+ */
+static void
+reg_compute_pdev_base_chan_list(struct wlan_regulatory_pdev_priv_obj
+				*pdev_priv_obj)
 {
 	reg_modify_6g_afc_chan_list(pdev_priv_obj);
 
@@ -1818,6 +1828,21 @@ void reg_compute_pdev_current_chan_list(struct wlan_regulatory_pdev_priv_obj
 	reg_modify_chan_list_for_dfs_channels(pdev_priv_obj->cur_chan_list,
 					      pdev_priv_obj->dfs_enabled);
 
+	qdf_mem_copy(pdev_priv_obj->base_chan_list,
+		     pdev_priv_obj->cur_chan_list,
+		     NUM_CHANNELS * sizeof(struct regulatory_channel));
+	pdev_priv_obj->base_chan_list_valid = true;
+}
+
+/**
+ * reg_compute_pdev_chan_list_overlays() - Apply the NOL, concurrency and
+ * bandwidth passes to the current channel list
+ * @pdev_priv_obj: Pointer to regulatory pdev private object
+ */
+static void
+reg_compute_pdev_chan_list_overlays(struct wlan_regulatory_pdev_priv_obj
+				    *pdev_priv_obj)
+{
 	reg_modify_chan_list_for_nol_list(pdev_priv_obj->cur_chan_list);
 
 	reg_modify_chan_list_for_indoor_channels(pdev_priv_obj);
@@ -1851,6 +1876,82 @@ void reg_compute_pdev_current_chan_list(struct wlan_regulatory_pdev_priv_obj
 	reg_modify_chan_list_for_avoid_chan_ext(pdev_priv_obj);
 }
 
+/**
+ * reg_update_pdev_chan_delta() - Record the channels of the current channel
+ * list which changed since the previous computation
+ * @pdev_priv_obj: Pointer to regulatory pdev private object
+ *
+ * Changed channels are accumulated in chan_delta until they are reported to
+ * the channel change listeners.
+ *
+ * Return: number of channels changed by the last computation
+ */
+static uint16_t
+reg_update_pdev_chan_delta(struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj)
+{
+	struct regulatory_channel *cur_chan_list = pdev_priv_obj->cur_chan_list;
+	struct regulatory_channel *prev_chan_list =
+					pdev_priv_obj->prev_chan_list;
+	struct reg_chan_delta *delta = &pdev_priv_obj->chan_delta;
+	enum channel_enum chan_enum;
+	uint16_t num_changed = 0;
+
+	for (chan_enum = 0; chan_enum < NUM_CHANNELS; chan_enum++) {
+		if (!qdf_mem_cmp(&cur_chan_list[chan_enum],
+				 &prev_chan_list[chan_enum],
+				 sizeof(struct regulatory_channel)))
+			continue;
+
+		prev_chan_list[chan_enum] = cur_chan_list[chan_enum];
+		num_changed++;
+		if (qdf_test_bit(chan_enum, delta->chan_bitmap))
+			continue;
+
+		qdf_set_bit(chan_enum, delta->chan_bitmap);
+		delta->num_changed++;
+	}
+
+	return num_changed;
+}
+
+void reg_compute_pdev_current_chan_list(struct wlan_regulatory_pdev_priv_obj
+					*pdev_priv_obj)
+{
+	reg_compute_pdev_base_chan_list(pdev_priv_obj);
+
+	reg_compute_pdev_chan_list_overlays(pdev_priv_obj);
+
+	reg_update_pdev_chan_delta(pdev_priv_obj);
+}
+
+uint16_t
+reg_update_pdev_chan_list_for_nol(struct wlan_regulatory_pdev_priv_obj
+				  *pdev_priv_obj)
+{
+	struct regulatory_channel *base_chan_list =
+					pdev_priv_obj->base_chan_list;
+	struct regulatory_channel *mas_chan_list = pdev_priv_obj->mas_chan_list;
+	enum channel_enum chan_enum;
+
+	if (!pdev_priv_obj->base_chan_list_valid)
+		reg_compute_pdev_base_chan_list(pdev_priv_obj);
+
+	/* the base passes never modify the NOL state of a channel */
+	for (chan_enum = 0; chan_enum < NUM_CHANNELS; chan_enum++) {
+		base_chan_list[chan_enum].nol_chan =
+			mas_chan_list[chan_enum].nol_chan;
+		base_chan_list[chan_enum].nol_history =
+			mas_chan_list[chan_enum].nol_history;
+	}
+
+	qdf_mem_copy(pdev_priv_obj->cur_chan_list, base_chan_list,
+		     NUM_CHANNELS * sizeof(struct regulatory_channel));
+
+	reg_compute_pdev_chan_list_overlays(pdev_priv_obj);
+
+	return reg_update_pdev_chan_delta(pdev_priv_obj);
+}
+
 void reg_reset_reg_rules(struct reg_rule_info *reg_rules)
 {
 	qdf_mem_zero(reg_rules, sizeof(*reg_rules));
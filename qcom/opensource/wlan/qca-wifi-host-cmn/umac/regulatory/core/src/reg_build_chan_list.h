@@ -76,6 +76,20 @@ reg_save_reg_rules_to_pdev(struct reg_rule_info *psoc_reg_rules,
 void reg_compute_pdev_current_chan_list(
 		struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj);
 
+/**
+ * reg_update_pdev_chan_list_for_nol() - Recompute the pdev current channel
+ * list after a change of the NOL state of the master channel list
+ * @pdev_priv_obj: Pointer to regdb pdev private object.
+ *
+ * Only the passes which follow the NOL pass are applied again, on top of the
+ * base channel list cached by the last reg_compute_pdev_current_chan_list().
+ *
+ * Return: number of channels of the current channel list which changed
+ */
+uint16_t
+reg_update_pdev_chan_list_for_nol(struct wlan_regulatory_pdev_priv_obj
+				  *pdev_priv_obj);
+
 /**
  * reg_propagate_mas_chan_list_to_pdev() - Propagate master channel list to pdev
  * @psoc: Pointer to psoc object.
@@ -40,11 +40,13 @@
  * @pdev: Pointer to global pdev structure.
  * @ch_avoid_ind: if chan avoid indicated
  * @avoid_info: chan avoid info if @ch_avoid_ind is true
+ * @delta: channels changed since the previous call
  */
 static void reg_call_chan_change_cbks(struct wlan_objmgr_psoc *psoc,
 				      struct wlan_objmgr_pdev *pdev,
 				      bool ch_avoid_ind,
-				      struct avoid_freq_ind_data *avoid_info)
+				      struct avoid_freq_ind_data *avoid_info,
+				      struct reg_chan_delta *delta)
 {
 	struct chan_change_cbk_entry *cbk_list;
 	struct wlan_regulatory_psoc_priv_obj *psoc_priv_obj;
@@ -53,6 +55,7 @@ static void reg_call_chan_change_cbks(struct wlan_objmgr_psoc *psoc,
 	uint32_t ctr;
 	struct avoid_freq_ind_data *avoid_freq_ind = NULL;
 	reg_chan_change_callback callback;
+	reg_chan_delta_callback delta_callback;
 
 	psoc_priv_obj = reg_get_psoc_obj(psoc);
 	if (!IS_VALID_PSOC_REG_OBJ(psoc_priv_obj)) {
@@ -85,10 +88,14 @@ static void reg_call_chan_change_cbks(struct wlan_objmgr_psoc *psoc,
 		qdf_spin_lock_bh(&psoc_priv_obj->cbk_list_lock);
 		if (cbk_list[ctr].cbk)
 			callback = cbk_list[ctr].cbk;
+		delta_callback = cbk_list[ctr].delta_cbk;
 		qdf_spin_unlock_bh(&psoc_priv_obj->cbk_list_lock);
 		if (callback)
 			callback(psoc, pdev, cur_chan_list, avoid_freq_ind,
 				 cbk_list[ctr].arg);
+		else if (delta_callback)
+			delta_callback(psoc, pdev, cur_chan_list, delta,
+				       cbk_list[ctr].arg);
 	}
 	qdf_mem_free(cur_chan_list);
 }
@@ -124,6 +131,7 @@ static void reg_alloc_and_fill_payload(struct wlan_objmgr_psoc *psoc,
 				       struct reg_sched_payload **payload)
 {
 	struct wlan_regulatory_psoc_priv_obj *psoc_priv_obj;
+	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
 
 	psoc_priv_obj = reg_get_psoc_obj(psoc);
 	if (!psoc_priv_obj) {
@@ -150,9 +158,38 @@ static void reg_alloc_and_fill_payload(struct wlan_objmgr_psoc *psoc,
 		qdf_mem_copy(&(*payload)->avoid_info.chan_list,
 			     &psoc_priv_obj->unsafe_chan_list,
 			     sizeof(psoc_priv_obj->unsafe_chan_list));
+
+		pdev_priv_obj = reg_get_pdev_obj(pdev);
+		(*payload)->delta = pdev_priv_obj->chan_delta;
+		qdf_mem_zero(&pdev_priv_obj->chan_delta,
+			     sizeof(pdev_priv_obj->chan_delta));
 	}
 }
 
+/**
+ * reg_set_full_chan_delta() - Mark every channel as changed
+ * @pdev: Pointer to pdev
+ *
+ * Used when a channel change notification could not be posted or was
+ * flushed. Its delta is lost with the payload, so the next notification
+ * reports every channel and the listeners do a full update.
+ */
+static void reg_set_full_chan_delta(struct wlan_objmgr_pdev *pdev)
+{
+	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
+	struct reg_chan_delta *delta;
+	enum channel_enum chan_enum;
+
+	pdev_priv_obj = reg_get_pdev_obj(pdev);
+	if (!IS_VALID_PDEV_REG_OBJ(pdev_priv_obj))
+		return;
+
+	delta = &pdev_priv_obj->chan_delta;
+	for (chan_enum = 0; chan_enum < NUM_CHANNELS; chan_enum++)
+		qdf_set_bit(chan_enum, delta->chan_bitmap);
+	delta->num_changed = NUM_CHANNELS;
+}
+
 /**
  * reg_chan_change_flush_cbk_sb() - Flush south bound channel change callbacks.
  * @msg: Pointer to scheduler msg structure.
@@ -163,6 +200,7 @@ static QDF_STATUS reg_chan_change_flush_cbk_sb(struct scheduler_msg *msg)
 	struct wlan_objmgr_psoc *psoc = load->psoc;
 	struct wlan_objmgr_pdev *pdev = load->pdev;
 
+	reg_set_full_chan_delta(pdev);
 	wlan_objmgr_pdev_release_ref(pdev, WLAN_REGULATORY_SB_ID);
 	wlan_objmgr_psoc_release_ref(psoc, WLAN_REGULATORY_SB_ID);
 	qdf_mem_free(load);
@@ -182,7 +220,7 @@ static QDF_STATUS reg_sched_chan_change_cbks_sb(struct scheduler_msg *msg)
 	struct wlan_objmgr_pdev *pdev = load->pdev;
 
 	reg_call_chan_change_cbks(psoc, pdev, load->ch_avoid_ind,
-				  &load->avoid_info);
+				  &load->avoid_info, &load->delta);
 
 	wlan_objmgr_pdev_release_ref(pdev, WLAN_REGULATORY_SB_ID);
 	wlan_objmgr_psoc_release_ref(psoc, WLAN_REGULATORY_SB_ID);
@@ -201,6 +239,7 @@ static QDF_STATUS reg_chan_change_flush_cbk_nb(struct scheduler_msg *msg)
 	struct wlan_objmgr_psoc *psoc = load->psoc;
 	struct wlan_objmgr_pdev *pdev = load->pdev;
 
+	reg_set_full_chan_delta(pdev);
 	wlan_objmgr_pdev_release_ref(pdev, WLAN_REGULATORY_NB_ID);
 	wlan_objmgr_psoc_release_ref(psoc, WLAN_REGULATORY_NB_ID);
 	qdf_mem_free(load);
@@ -220,7 +259,7 @@ static QDF_STATUS reg_sched_chan_change_cbks_nb(struct scheduler_msg *msg)
 	struct wlan_objmgr_pdev *pdev = load->pdev;
 
 	reg_call_chan_change_cbks(psoc, pdev, load->ch_avoid_ind,
-				  &load->avoid_info);
+				  &load->avoid_info, &load->delta);
 
 	wlan_objmgr_pdev_release_ref(pdev, WLAN_REGULATORY_NB_ID);
 	wlan_objmgr_psoc_release_ref(psoc, WLAN_REGULATORY_NB_ID);
@@ -282,6 +321,7 @@ QDF_STATUS reg_send_scheduler_msg_sb(struct wlan_objmgr_psoc *psoc,
 					QDF_MODULE_ID_REGULATORY,
 					QDF_MODULE_ID_TARGET_IF, &msg);
 	if (QDF_IS_STATUS_ERROR(status)) {
+		reg_set_full_chan_delta(pdev);
 		wlan_objmgr_pdev_release_ref(pdev, WLAN_REGULATORY_SB_ID);
 		wlan_objmgr_psoc_release_ref(psoc, WLAN_REGULATORY_SB_ID);
 		qdf_mem_free(payload);
@@ -342,6 +382,7 @@ QDF_STATUS reg_send_scheduler_msg_nb(struct wlan_objmgr_psoc *psoc,
 					QDF_MODULE_ID_REGULATORY,
 					QDF_MODULE_ID_OS_IF, &msg);
 	if (QDF_IS_STATUS_ERROR(status)) {
+		reg_set_full_chan_delta(pdev);
 		wlan_objmgr_pdev_release_ref(pdev, WLAN_REGULATORY_NB_ID);
 		wlan_objmgr_psoc_release_ref(psoc, WLAN_REGULATORY_NB_ID);
 		qdf_mem_free(payload);
@@ -404,7 +445,8 @@ void reg_register_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 
 	qdf_spin_lock_bh(&psoc_priv_obj->cbk_list_lock);
 	for (count = 0; count < REG_MAX_CHAN_CHANGE_CBKS; count++)
-		if (!psoc_priv_obj->cbk_list[count].cbk) {
+		if (!psoc_priv_obj->cbk_list[count].cbk &&
+		    !psoc_priv_obj->cbk_list[count].delta_cbk) {
 			psoc_priv_obj->cbk_list[count].cbk = cbk;
 			psoc_priv_obj->cbk_list[count].arg = arg;
 			psoc_priv_obj->num_chan_change_cbks++;
@@ -441,3 +483,55 @@ void reg_unregister_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 		reg_err("callback not found in the list");
 }
 
+void reg_register_chan_delta_callback(struct wlan_objmgr_psoc *psoc,
+				      reg_chan_delta_callback cbk, void *arg)
+{
+	struct wlan_regulatory_psoc_priv_obj *psoc_priv_obj;
+	uint32_t count;
+
+	psoc_priv_obj = reg_get_psoc_obj(psoc);
+	if (!psoc_priv_obj) {
+		reg_err("reg psoc private obj is NULL");
+		return;
+	}
+
+	qdf_spin_lock_bh(&psoc_priv_obj->cbk_list_lock);
+	for (count = 0; count < REG_MAX_CHAN_CHANGE_CBKS; count++)
+		if (!psoc_priv_obj->cbk_list[count].cbk &&
+		    !psoc_priv_obj->cbk_list[count].delta_cbk) {
+			psoc_priv_obj->cbk_list[count].delta_cbk = cbk;
+			psoc_priv_obj->cbk_list[count].arg = arg;
+			psoc_priv_obj->num_chan_change_cbks++;
+			break;
+		}
+	qdf_spin_unlock_bh(&psoc_priv_obj->cbk_list_lock);
+
+	if (count == REG_MAX_CHAN_CHANGE_CBKS)
+		reg_err("callback list is full");
+}
+
+void reg_unregister_chan_delta_callback(struct wlan_objmgr_psoc *psoc,
+					reg_chan_delta_callback cbk)
+{
+	struct wlan_regulatory_psoc_priv_obj *psoc_priv_obj;
+	uint32_t count;
+
+	psoc_priv_obj = reg_get_psoc_obj(psoc);
+	if (!psoc_priv_obj) {
+		reg_err("reg psoc private obj is NULL");
+		return;
+	}
+
+	qdf_spin_lock_bh(&psoc_priv_obj->cbk_list_lock);
+	for (count = 0; count < REG_MAX_CHAN_CHANGE_CBKS; count++)
+		if (psoc_priv_obj->cbk_list[count].delta_cbk == cbk) {
+			psoc_priv_obj->cbk_list[count].delta_cbk = NULL;
+			psoc_priv_obj->num_chan_change_cbks--;
+			break;
+		}
+	qdf_spin_unlock_bh(&psoc_priv_obj->cbk_list_lock);
+
+	if (count == REG_MAX_CHAN_CHANGE_CBKS)
+		reg_err("callback not found in the list");
+}
+
@@ -43,6 +43,24 @@ void reg_register_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 void reg_unregister_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 					 reg_chan_change_callback cbk);
 
+/**
+ * reg_register_chan_delta_callback() - Register channel change callbacks
+ * which get the channels changed since their previous call
+ * @psoc: Pointer to psoc
+ * @cbk: Pointer to callback function
+ * @arg: List of arguments
+ */
+void reg_register_chan_delta_callback(struct wlan_objmgr_psoc *psoc,
+				      reg_chan_delta_callback cbk, void *arg);
+
+/**
+ * reg_unregister_chan_delta_callback() - Unregister channel delta callbacks
+ * @psoc: Pointer to psoc
+ * @cbk: Pointer to callback function
+ */
+void reg_unregister_chan_delta_callback(struct wlan_objmgr_psoc *psoc,
+					reg_chan_delta_callback cbk);
+
 /**
  * reg_notify_sap_event() - Notify regulatory domain for sap event
  * @pdev: The physical dev to set the band for
@@ -83,6 +101,17 @@ static inline void reg_unregister_chan_change_callback(
 {
 }
 
+static inline void reg_register_chan_delta_callback(
+		struct wlan_objmgr_psoc *psoc, reg_chan_delta_callback cbk,
+		void *arg)
+{
+}
+
+static inline void reg_unregister_chan_delta_callback(
+		struct wlan_objmgr_psoc *psoc, reg_chan_delta_callback cbk)
+{
+}
+
 static inline QDF_STATUS reg_send_scheduler_msg_sb(
 		struct wlan_objmgr_psoc *psoc, struct wlan_objmgr_pdev *pdev)
 {
@@ -74,13 +74,30 @@ typedef void (*reg_chan_change_callback)(
 		struct avoid_freq_ind_data *avoid_freq_ind,
 		void *arg);
 
+/**
+ * typedef reg_chan_delta_callback() - Regulatory channel delta callback
+ * @psoc: Pointer to psoc
+ * @pdev: Pointer to pdev
+ * @chan_list: Pointer to regulatory channel list
+ * @delta: channels of @chan_list changed since the previous callback
+ * @arg: list of arguments
+ */
+typedef void (*reg_chan_delta_callback)(
+		struct wlan_objmgr_psoc *psoc,
+		struct wlan_objmgr_pdev *pdev,
+		struct regulatory_channel *chan_list,
+		struct reg_chan_delta *delta,
+		void *arg);
+
 /**
  * struct chan_change_cbk_entry - Channel change callback entry
  * @cbk: Callback
+ * @delta_cbk: Callback taking the changed channels, used when @cbk is NULL
  * @arg: Arguments
  */
 struct chan_change_cbk_entry {
 	reg_chan_change_callback cbk;
+	reg_chan_delta_callback delta_cbk;
 	void *arg;
 };
 
@@ -212,6 +229,11 @@ struct wlan_regulatory_psoc_priv_obj {
  * situations
  * @mas_chan_list: master channel list
  * from the firmware.
+ * @base_chan_list: current channel list before the NOL, concurrency and
+ *	bandwidth passes, cached to recompute the list on NOL updates
+ * @base_chan_list_valid: @base_chan_list has been computed
+ * @prev_chan_list: current channel list as of the previous computation
+ * @chan_delta: channels changed since the last channel change notification
  * @is_6g_channel_list_populated: indicates the channel lists are populated
  * @mas_chan_list_6g_ap: master channel list for 6G AP, includes all power types
  * @mas_chan_list_6g_client: master channel list for 6G client, includes
@@ -252,6 +274,10 @@ struct wlan_regulatory_pdev_priv_obj {
 	struct regulatory_channel secondary_cur_chan_list[NUM_CHANNELS];
 #endif
 	struct regulatory_channel mas_chan_list[NUM_CHANNELS];
+	struct regulatory_channel base_chan_list[NUM_CHANNELS];
+	bool base_chan_list_valid;
+	struct regulatory_channel prev_chan_list[NUM_CHANNELS];
+	struct reg_chan_delta chan_delta;
 #ifdef CONFIG_BAND_6GHZ
 	bool is_6g_channel_list_populated;
 	struct regulatory_channel mas_chan_list_6g_ap[REG_CURRENT_MAX_AP_TYPE][NUM_6GHZ_CHANNELS];
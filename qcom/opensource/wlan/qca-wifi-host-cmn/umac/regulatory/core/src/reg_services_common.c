@@ -4678,7 +4678,8 @@ void reg_update_nol_ch_for_freq(struct wlan_objmgr_pdev *pdev,
 		return;
 	}
 
-	reg_compute_pdev_current_chan_list(pdev_priv_obj);
+	if (!reg_update_pdev_chan_list_for_nol(pdev_priv_obj))
+		return;
 
 	reg_send_scheduler_msg_sb(psoc, pdev);
 }
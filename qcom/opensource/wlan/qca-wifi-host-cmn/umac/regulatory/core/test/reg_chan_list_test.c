@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include <wlan_objmgr_pdev_obj.h>
+#include <reg_services_public_struct.h>
+#include "../src/reg_priv_objs.h"
+#include "../src/reg_build_chan_list.h"
+#include "reg_chan_list_test.h"
+
+#define ut_reg_rounds 4
+
+/**
+ * struct ut_reg_ctx - test state
+ * @pdev_priv_obj: private copy of the regulatory pdev object under test
+ * @chan_list: current channel list of the incremental recomputation
+ * @sec_chan_list: secondary current channel list of the incremental
+ *	recomputation
+ * @incr_ns: time spent in incremental recomputations
+ * @full_ns: time spent in full rebuilds
+ */
+struct ut_reg_ctx {
+	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
+	struct regulatory_channel chan_list[NUM_CHANNELS];
+#ifdef CONFIG_REG_CLIENT
+	struct regulatory_channel sec_chan_list[NUM_CHANNELS];
+#endif
+	uint64_t incr_ns;
+	uint64_t full_ns;
+};
+
+#ifdef CONFIG_REG_CLIENT
+static void ut_reg_save_secondary(struct ut_reg_ctx *ctx)
+{
+	qdf_mem_copy(ctx->sec_chan_list,
+		     ctx->pdev_priv_obj->secondary_cur_chan_list,
+		     sizeof(ctx->sec_chan_list));
+}
+
+static bool ut_reg_secondary_eq(struct ut_reg_ctx *ctx)
+{
+	return !qdf_mem_cmp(ctx->sec_chan_list,
+			    ctx->pdev_priv_obj->secondary_cur_chan_list,
+			    sizeof(ctx->sec_chan_list));
+}
+#else
+static void ut_reg_save_secondary(struct ut_reg_ctx *ctx)
+{
+}
+
+static bool ut_reg_secondary_eq(struct ut_reg_ctx *ctx)
+{
+	return true;
+}
+#endif
+
+/* recompute incrementally, then check against a full rebuild */
+static uint32_t ut_reg_check(struct ut_reg_ctx *ctx, const char *name,
+			     bool changed)
+{
+	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj =
+							ctx->pdev_priv_obj;
+	uint32_t errors = 0;
+	uint16_t num_changed;
+	uint64_t ts;
+
+	ts = qdf_sched_clock();
+	num_changed = reg_update_pdev_chan_list_for_nol(pdev_priv_obj);
+	ctx->incr_ns += qdf_sched_clock() - ts;
+
+	qdf_mem_copy(ctx->chan_list, pdev_priv_obj->cur_chan_list,
+		     sizeof(ctx->chan_list));
+	ut_reg_save_secondary(ctx);
+
+	ts = qdf_sched_clock();
+	reg_compute_pdev_current_chan_list(pdev_priv_obj);
+	ctx->full_ns += qdf_sched_clock() - ts;
+
+	if (qdf_mem_cmp(ctx->chan_list, pdev_priv_obj->cur_chan_list,
+			sizeof(ctx->chan_list))) {
+		qdf_nofl_alert("FAIL: %s current channel list differs from full rebuild",
+			       name);
+		errors++;
+	}
+
+	if (!ut_reg_secondary_eq(ctx)) {
+		qdf_nofl_alert("FAIL: %s secondary channel list differs from full rebuild",
+			       name);
+		errors++;
+	}
+
+	if (changed != !!num_changed) {
+		qdf_nofl_alert("FAIL: %s %u channels changed", name,
+			       num_changed);
+		errors++;
+	}
+
+	return errors;
+}
+
+static uint32_t ut_reg_nol_rounds(struct ut_reg_ctx *ctx)
+{
+	struct regulatory_channel *mas_chan_list =
+				ctx->pdev_priv_obj->mas_chan_list;
+	enum channel_enum chan_enum;
+	uint32_t errors = 0;
+	uint32_t num_dfs = 0;
+	uint32_t num_toggled;
+	uint8_t round;
+
+	for (round = 0; round < ut_reg_rounds; round++) {
+		num_dfs = 0;
+		num_toggled = 0;
+		for (chan_enum = 0; chan_enum < NUM_CHANNELS; chan_enum++) {
+			if (!(mas_chan_list[chan_enum].chan_flags &
+			      REGULATORY_CHAN_RADAR))
+				continue;
+
+			/* a different, overlapping, subset each round */
+			if ((num_dfs++ + round) % ut_reg_rounds >= 2)
+				continue;
+
+			mas_chan_list[chan_enum].nol_chan =
+				!mas_chan_list[chan_enum].nol_chan;
+			num_toggled++;
+		}
+
+		if (!num_dfs) {
+			qdf_nofl_info("reg_chan_list: no DFS channels, skipping NOL rounds");
+			return 0;
+		}
+
+		errors += ut_reg_check(ctx, "nol", num_toggled);
+		/* nothing changed since the last computation */
+		errors += ut_reg_check(ctx, "nol repeat", false);
+	}
+
+	return errors;
+}
+
+uint32_t reg_chan_list_unit_test(struct wlan_objmgr_pdev *pdev)
+{
+	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
+	struct ut_reg_ctx *ctx;
+	uint32_t errors;
+
+	pdev_priv_obj = reg_get_pdev_obj(pdev);
+	if (!IS_VALID_PDEV_REG_OBJ(pdev_priv_obj)) {
+		qdf_nofl_alert("FAIL: pdev reg component is NULL");
+		return 1;
+	}
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	/*
+	 * The rounds run on a snapshot of the pdev object, so the live
+	 * channel lists, NOL state and pending delta are never touched and
+	 * no regulatory update can race with the test.
+	 */
+	ctx->pdev_priv_obj = qdf_mem_malloc(sizeof(*ctx->pdev_priv_obj));
+	if (!ctx->pdev_priv_obj) {
+		qdf_mem_free(ctx);
+		return 1;
+	}
+	qdf_mem_copy(ctx->pdev_priv_obj, pdev_priv_obj,
+		     sizeof(*ctx->pdev_priv_obj));
+
+	/* nothing changes on top of a full build */
+	reg_compute_pdev_current_chan_list(ctx->pdev_priv_obj);
+	errors = ut_reg_check(ctx, "initial", false);
+	errors += ut_reg_nol_rounds(ctx);
+
+	qdf_nofl_info("reg_chan_list: incremental %llu ns, full %llu ns",
+		      ctx->incr_ns, ctx->full_ns);
+
+	qdf_mem_free(ctx->pdev_priv_obj);
+	qdf_mem_free(ctx);
+
+	return errors;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __REG_CHAN_LIST_TEST
+#define __REG_CHAN_LIST_TEST
+
+#include "qdf_types.h"
+
+struct wlan_objmgr_pdev;
+
+#ifdef WLAN_REG_CHAN_LIST_TEST
+/**
+ * reg_chan_list_unit_test() - run the regulatory channel list unit test suite
+ * @pdev: pdev whose current channel list is recomputed
+ *
+ * Toggles the NOL state of the DFS channels of a private copy of the
+ * regulatory object of @pdev and checks that the incremental recomputation
+ * of the current channel list matches a full rebuild. @pdev itself is not
+ * modified.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t reg_chan_list_unit_test(struct wlan_objmgr_pdev *pdev);
+#else
+static inline uint32_t reg_chan_list_unit_test(struct wlan_objmgr_pdev *pdev)
+{
+	return 0;
+}
+#endif /* WLAN_REG_CHAN_LIST_TEST */
+
+#endif /* __REG_CHAN_LIST_TEST */
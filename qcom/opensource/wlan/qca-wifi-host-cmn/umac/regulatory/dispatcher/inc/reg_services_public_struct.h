@@ -25,6 +25,7 @@
 #ifndef __REG_SERVICES_PUBLIC_STRUCT_H_
 #define __REG_SERVICES_PUBLIC_STRUCT_H_
 
+#include <qdf_util.h>
 #ifdef CONFIG_AFC_SUPPORT
 #include <wlan_reg_afc.h>
 #endif
@@ -1593,18 +1594,30 @@ struct avoid_freq_ind_data {
 	struct unsafe_ch_list chan_list;
 };
 
+/**
+ * struct reg_chan_delta - channels of the current channel list which changed
+ * @num_changed: number of channels set in @chan_bitmap
+ * @chan_bitmap: changed channels, indexed by enum channel_enum
+ */
+struct reg_chan_delta {
+	uint16_t num_changed;
+	qdf_bitmap(chan_bitmap, NUM_CHANNELS);
+};
+
 /**
  * struct reg_sched_payload
  * @psoc: psoc ptr
  * @pdev: pdev ptr
  * @ch_avoid_ind: if avoidance event indicated
  * @avoid_info: chan avoid info if @ch_avoid_ind is true
+ * @delta: channels changed since the previous notification
  */
 struct reg_sched_payload {
 	struct wlan_objmgr_psoc *psoc;
 	struct wlan_objmgr_pdev *pdev;
 	bool ch_avoid_ind;
 	struct avoid_freq_ind_data avoid_info;
+	struct reg_chan_delta delta;
 };
 
 #define FIVEG_STARTING_FREQ        5000
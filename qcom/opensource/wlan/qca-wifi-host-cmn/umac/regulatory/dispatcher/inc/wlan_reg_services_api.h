@@ -990,6 +990,28 @@ void wlan_reg_register_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 void wlan_reg_unregister_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 					      void *cbk);
 
+/**
+ * wlan_reg_register_chan_delta_callback() - add chan change cbk which gets
+ * the channels changed since its previous call
+ * @psoc: psoc ptr
+ * @cbk: callback of type reg_chan_delta_callback
+ * @arg: argument
+ *
+ * Return: None
+ */
+void wlan_reg_register_chan_delta_callback(struct wlan_objmgr_psoc *psoc,
+					   void *cbk, void *arg);
+
+/**
+ * wlan_reg_unregister_chan_delta_callback() - remove chan delta cbk
+ * @psoc: psoc ptr
+ * @cbk: callback
+ *
+ * Return: None
+ */
+void wlan_reg_unregister_chan_delta_callback(struct wlan_objmgr_psoc *psoc,
+					     void *cbk);
+
 /**
  * wlan_reg_is_11d_offloaded() - 11d offloaded supported
  * @psoc: psoc ptr
@@ -658,6 +658,20 @@ void wlan_reg_unregister_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 					    (reg_chan_change_callback)cbk);
 }
 
+void wlan_reg_register_chan_delta_callback(struct wlan_objmgr_psoc *psoc,
+					   void *cbk, void *arg)
+{
+	reg_register_chan_delta_callback(psoc, (reg_chan_delta_callback)cbk,
+					 arg);
+}
+
+void wlan_reg_unregister_chan_delta_callback(struct wlan_objmgr_psoc *psoc,
+					     void *cbk)
+{
+	reg_unregister_chan_delta_callback(psoc,
+					   (reg_chan_delta_callback)cbk);
+}
+
 bool wlan_reg_is_11d_offloaded(struct wlan_objmgr_psoc *psoc)
 {
 	return reg_is_11d_offloaded(psoc);
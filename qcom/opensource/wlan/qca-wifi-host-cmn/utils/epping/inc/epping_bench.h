@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: epping_bench.h
+ *
+ * Closed loop throughput and latency benchmark on top of endpoint ping.
+ *
+ * A run sweeps packet sizes and burst depths over one or more epping
+ * streams. Each burst is sent as a whole and the next one is only sent
+ * once every packet of the burst has completed, either by its tx completion
+ * (tx only) or by its echo from the target (bidirectional). The packets
+ * can be carried by HTC or by a loopback stand-in of HIF/HTC which
+ * completes and echoes them on the host, so that the suite also runs
+ * without a target.
+ */
+
+#ifndef EPPING_BENCH_H
+#define EPPING_BENCH_H
+
+#include <qdf_types.h>
+
+/* one stream per access category, as EPPING_MAX_NUM_EPIDS */
+#define EPPING_BENCH_MAX_EPS 4
+/* epping_tx_send() maps streams 0 and 1 to the mboxping service only */
+#define EPPING_BENCH_HTC_MAX_EPS 2
+#define EPPING_BENCH_MAX_BURST 256
+#define EPPING_BENCH_MAX_RESULTS 64
+
+/**
+ * enum epping_bench_transport - carrier of the benchmark packets
+ * @EPPING_BENCH_HTC: HTC endpoints of the epping adapter
+ * @EPPING_BENCH_LOOPBACK: host loopback stand-in of HIF/HTC
+ */
+enum epping_bench_transport {
+	EPPING_BENCH_HTC,
+	EPPING_BENCH_LOOPBACK,
+};
+
+/**
+ * struct epping_bench_params - benchmark scenario
+ * @transport: carrier of the packets
+ * @size_min: smallest packet size of the sweep, including the epping header
+ * @size_max: largest packet size of the sweep
+ * @size_step: packet size increment of the sweep
+ * @burst_min: smallest burst depth of the sweep
+ * @burst_max: largest burst depth of the sweep, doubled from @burst_min
+ * @count: packets sent for each size and burst depth
+ * @num_eps: number of epping streams the packets are spread over, at most
+ *	     EPPING_BENCH_HTC_MAX_EPS over HTC
+ * @bidir: request the target to echo every packet
+ */
+struct epping_bench_params {
+	enum epping_bench_transport transport;
+	uint16_t size_min;
+	uint16_t size_max;
+	uint16_t size_step;
+	uint16_t burst_min;
+	uint16_t burst_max;
+	uint32_t count;
+	uint8_t num_eps;
+	bool bidir;
+};
+
+/**
+ * struct epping_bench_result - result of one size and burst depth
+ * @size: packet size
+ * @burst: burst depth
+ * @sent: packets handed to the transport
+ * @done: packets completed
+ * @lost: packets which failed to send or timed out
+ * @ep_done: packets completed per epping stream
+ * @elapsed_us: duration of the step
+ * @kbps: goodput of completed packets, in kbps
+ * @pps: completed packets per second
+ * @lat_min: minimum latency, in ns
+ * @lat_p50: median latency, in ns
+ * @lat_p90: 90th percentile latency, in ns
+ * @lat_p99: 99th percentile latency, in ns
+ * @lat_p999: 99.9th percentile latency, in ns
+ * @lat_max: maximum latency, in ns
+ */
+struct epping_bench_result {
+	uint16_t size;
+	uint16_t burst;
+	uint32_t sent;
+	uint32_t done;
+	uint32_t lost;
+	uint32_t ep_done[EPPING_BENCH_MAX_EPS];
+	uint64_t elapsed_us;
+	uint64_t kbps;
+	uint64_t pps;
+	uint32_t lat_min;
+	uint32_t lat_p50;
+	uint32_t lat_p90;
+	uint32_t lat_p99;
+	uint32_t lat_p999;
+	uint32_t lat_max;
+};
+
+#ifdef WLAN_EPPING_BENCH
+/**
+ * epping_bench_init() - Initialize the benchmark and its debugfs entry
+ * @epping_ctx: epping context, NULL when only the loopback transport is used
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS epping_bench_init(void *epping_ctx);
+
+/**
+ * epping_bench_deinit() - De-initialize the benchmark
+ *
+ * Return: None
+ */
+void epping_bench_deinit(void);
+
+/**
+ * epping_bench_run() - Run a benchmark scenario
+ * @params: scenario
+ * @results: results, one per size and burst depth of the sweep
+ * @max_results: number of entries in @results
+ * @num_results: number of results filled in
+ *
+ * Blocks until the whole sweep has run, the debugfs entry runs its sweeps
+ * from a work item instead.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS epping_bench_run(struct epping_bench_params *params,
+			    struct epping_bench_result *results,
+			    uint32_t max_results, uint32_t *num_results);
+#else
+static inline QDF_STATUS epping_bench_init(void *epping_ctx)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline void epping_bench_deinit(void)
+{
+}
+
+static inline
+QDF_STATUS epping_bench_run(struct epping_bench_params *params,
+			    struct epping_bench_result *results,
+			    uint32_t max_results, uint32_t *num_results)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif /* WLAN_EPPING_BENCH */
+#endif /* EPPING_BENCH_H */
@@ -174,6 +174,40 @@ void epping_tx_dup_pkt(epping_adapter_t *adapter,
 /* epping_rx signatures */
 void epping_rx(void *Context, HTC_PACKET *pPacket);
 
+/* epping_bench signatures */
+#ifdef WLAN_EPPING_BENCH
+/**
+ * epping_bench_rx() - Consume a received benchmark echo
+ * @adapter: adapter the packet was received on, NULL if none
+ * @nbuf: received packet, header at the data pointer
+ *
+ * Consumed packets are accounted in the rx stats of @adapter as they do not
+ * reach the network stack.
+ *
+ * Return: true if @nbuf belongs to the running benchmark and was freed
+ */
+bool epping_bench_rx(epping_adapter_t *adapter, qdf_nbuf_t nbuf);
+
+/**
+ * epping_bench_tx_comp() - Account the tx completion of a benchmark packet
+ * @nbuf: completed packet, header after the HTC alignment pad
+ * @ok: packet was delivered to the target
+ *
+ * Return: None
+ */
+void epping_bench_tx_comp(qdf_nbuf_t nbuf, bool ok);
+#else
+static inline bool epping_bench_rx(epping_adapter_t *adapter,
+				   qdf_nbuf_t nbuf)
+{
+	return false;
+}
+
+static inline void epping_bench_tx_comp(qdf_nbuf_t nbuf, bool ok)
+{
+}
+#endif /* WLAN_EPPING_BENCH */
+
 #ifdef HIF_SDIO
 void epping_refill(void *ctx, HTC_ENDPOINT_ID Endpoint);
 #endif
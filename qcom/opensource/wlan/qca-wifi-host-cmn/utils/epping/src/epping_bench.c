@@ -0,0 +1,888 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*========================================================================
+
+   \file  epping_bench.c
+
+   \brief WLAN End Point Ping benchmark implementation
+
+   ========================================================================*/
+
+/*--------------------------------------------------------------------------
+   Include Files
+   ------------------------------------------------------------------------*/
+#include <linux/sort.h>
+#include <qdf_debugfs.h>
+#include <qdf_defer.h>
+#include <qdf_event.h>
+#include <qdf_lock.h>
+#include <qdf_mem.h>
+#include <qdf_nbuf.h>
+#include <qdf_str.h>
+#include <qdf_time.h>
+#include "epping_bench.h"
+#include "epping_internal.h"
+#include "epping_test.h"
+
+#define EPPING_BENCH_MAX_SAMPLES 8192
+#define EPPING_BENCH_HEADROOM 64
+#define EPPING_BENCH_TIMEOUT_MS 1000
+#define EPPING_BENCH_CMD_LEN 256
+#define EPPING_BENCH_DEBUGFS_PERMS (QDF_FILE_USR_READ | \
+				    QDF_FILE_USR_WRITE | \
+				    QDF_FILE_GRP_READ | \
+				    QDF_FILE_OTH_READ)
+
+QDF_COMPILE_TIME_ASSERT(epping_bench_max_eps_check,
+			EPPING_BENCH_MAX_EPS <= EPPING_MAX_NUM_EPIDS);
+
+/* host context of a benchmark packet: generation << 16 | burst slot */
+#define EPPING_BENCH_CONTEXT(gen, slot) (((uint32_t)(gen) << 16) | (slot))
+#define EPPING_BENCH_CONTEXT_GEN(ctx) ((uint16_t)((ctx) >> 16))
+#define EPPING_BENCH_CONTEXT_SLOT(ctx) ((ctx) & 0xffff)
+
+/**
+ * struct epping_bench - benchmark context
+ * @epping_ctx: epping context, NULL when only loopback is available
+ * @lock: protects the per burst accounting against completions
+ * @run_lock: serializes benchmark runs
+ * @burst_done: set once every packet of the burst has completed
+ * @params: scenario of the current run
+ * @running: a run is in progress
+ * @gen: generation of the current burst, stale completions are ignored
+ * @outstanding: packets of the current burst not completed yet
+ * @done: packets completed in the current step
+ * @lost: packets failed or timed out in the current step
+ * @ep_done: packets completed per stream in the current step
+ * @send_ts: send time of each slot of the current burst, 0 once completed
+ * @num_samples: latency samples taken in the current step
+ * @samples: latency samples of the current step, in ns
+ * @lb_queue: packets handed to the loopback transport
+ * @lb_work: loopback transport work completing and echoing packets
+ * @run_work: work running the sweeps requested through debugfs
+ * @run_results: results of the debugfs sweep in progress
+ * @dbgfs_lock: protects the debugfs state against @run_work
+ * @dbgfs_running: a debugfs sweep is queued or in progress
+ * @dbgfs_params: scenario of the last debugfs run
+ * @dbgfs_status: status of the last debugfs run
+ * @dbgfs_num_results: results of the last debugfs run
+ * @dbgfs_results: results of the last debugfs run
+ * @dentry: debugfs entry
+ * @fops: debugfs file operations
+ */
+struct epping_bench {
+	epping_context_t *epping_ctx;
+	qdf_spinlock_t lock;
+	qdf_mutex_t run_lock;
+	qdf_event_t burst_done;
+	struct epping_bench_params params;
+	bool running;
+	uint16_t gen;
+	uint32_t outstanding;
+	uint32_t done;
+	uint32_t lost;
+	uint32_t ep_done[EPPING_BENCH_MAX_EPS];
+	uint64_t send_ts[EPPING_BENCH_MAX_BURST];
+	uint32_t num_samples;
+	uint32_t *samples;
+	qdf_nbuf_queue_t lb_queue;
+	qdf_work_t lb_work;
+	qdf_work_t run_work;
+	struct epping_bench_result run_results[EPPING_BENCH_MAX_RESULTS];
+	qdf_mutex_t dbgfs_lock;
+	bool dbgfs_running;
+	struct epping_bench_params dbgfs_params;
+	QDF_STATUS dbgfs_status;
+	uint32_t dbgfs_num_results;
+	struct epping_bench_result dbgfs_results[EPPING_BENCH_MAX_RESULTS];
+	qdf_dentry_t dentry;
+	struct qdf_debugfs_fops fops;
+};
+
+static struct epping_bench *g_epping_bench;
+
+static inline uint64_t epping_bench_now_ns(void)
+{
+	return qdf_ktime_to_ns(qdf_ktime_get());
+}
+
+/**
+ * epping_bench_account() - Account the completion of a burst slot
+ * @bench: benchmark context
+ * @ctx: host context carried by the packet
+ * @stream: stream the packet was sent on
+ * @ok: packet was delivered
+ *
+ * Return: true if the packet belongs to the current burst
+ */
+static bool epping_bench_account(struct epping_bench *bench, uint32_t ctx,
+				 uint8_t stream, bool ok)
+{
+	uint32_t slot = EPPING_BENCH_CONTEXT_SLOT(ctx);
+	uint64_t now = epping_bench_now_ns();
+	uint64_t lat;
+
+	qdf_spin_lock_bh(&bench->lock);
+	if (!bench->running || EPPING_BENCH_CONTEXT_GEN(ctx) != bench->gen ||
+	    slot >= EPPING_BENCH_MAX_BURST) {
+		qdf_spin_unlock_bh(&bench->lock);
+		return false;
+	}
+
+	/* duplicate or already failed */
+	if (!bench->send_ts[slot])
+		goto unlock;
+
+	if (ok) {
+		lat = now - bench->send_ts[slot];
+		if (bench->num_samples < EPPING_BENCH_MAX_SAMPLES)
+			bench->samples[bench->num_samples++] =
+				qdf_min(lat, (uint64_t)U32_MAX);
+		bench->done++;
+		if (stream < EPPING_BENCH_MAX_EPS)
+			bench->ep_done[stream]++;
+	} else {
+		bench->lost++;
+	}
+
+	bench->send_ts[slot] = 0;
+	if (!--bench->outstanding)
+		qdf_event_set(&bench->burst_done);
+
+unlock:
+	qdf_spin_unlock_bh(&bench->lock);
+
+	return true;
+}
+
+/**
+ * epping_bench_get_hdr() - Get the epping header of a packet
+ * @nbuf: packet
+ * @offset: offset of the header in the packet
+ *
+ * Return: epping header, NULL if @nbuf is not an epping packet
+ */
+static EPPING_HEADER *epping_bench_get_hdr(qdf_nbuf_t nbuf, uint32_t offset)
+{
+	EPPING_HEADER *hdr;
+
+	if (qdf_nbuf_len(nbuf) < offset + sizeof(*hdr))
+		return NULL;
+
+	hdr = (EPPING_HEADER *)(qdf_nbuf_data(nbuf) + offset);
+	if (!IS_EPPING_PACKET(hdr))
+		return NULL;
+
+	return hdr;
+}
+
+bool epping_bench_rx(epping_adapter_t *adapter, qdf_nbuf_t nbuf)
+{
+	struct epping_bench *bench = g_epping_bench;
+	EPPING_HEADER *hdr;
+
+	if (!bench || !bench->running)
+		return false;
+
+	hdr = epping_bench_get_hdr(nbuf, 0);
+	if (!hdr || !epping_bench_account(bench, hdr->HostContext_h,
+					  hdr->StreamNo_h, true))
+		return false;
+
+	if (adapter) {
+		++adapter->stats.rx_packets;
+		adapter->stats.rx_bytes += qdf_nbuf_len(nbuf);
+	}
+	qdf_nbuf_free(nbuf);
+
+	return true;
+}
+
+void epping_bench_tx_comp(qdf_nbuf_t nbuf, bool ok)
+{
+	struct epping_bench *bench = g_epping_bench;
+	EPPING_HEADER *hdr;
+
+	if (!bench || !bench->running)
+		return;
+
+	hdr = epping_bench_get_hdr(nbuf, EPPING_ALIGNMENT_PAD);
+	if (!hdr)
+		return;
+
+	/* echoed packets complete when the echo is received */
+	if (ok && hdr->Cmd_h == EPPING_CMD_ECHO_PACKET)
+		return;
+
+	epping_bench_account(bench, hdr->HostContext_h, hdr->StreamNo_h, ok);
+}
+
+/**
+ * epping_bench_lb_work() - Loopback stand-in of HIF/HTC
+ * @arg: benchmark context
+ *
+ * Completes every queued packet as the target would: tx only packets are
+ * completed right away, echo packets are copied into a new receive buffer,
+ * completed on the tx side and delivered on the rx side of the epping
+ * adapter, if any.
+ *
+ * Return: None
+ */
+static void epping_bench_lb_work(void *arg)
+{
+	struct epping_bench *bench = arg;
+	epping_adapter_t *adapter = NULL;
+	EPPING_HEADER *hdr;
+	qdf_nbuf_t nbuf;
+	qdf_nbuf_t echo;
+
+	if (bench->epping_ctx)
+		adapter = bench->epping_ctx->epping_adapter;
+
+	while (true) {
+		qdf_spin_lock_bh(&bench->lock);
+		nbuf = qdf_nbuf_queue_remove(&bench->lb_queue);
+		qdf_spin_unlock_bh(&bench->lock);
+		if (!nbuf)
+			break;
+
+		hdr = epping_bench_get_hdr(nbuf, 0);
+		if (!hdr) {
+			qdf_nbuf_free(nbuf);
+			continue;
+		}
+
+		if (hdr->Cmd_h != EPPING_CMD_ECHO_PACKET) {
+			epping_bench_account(bench, hdr->HostContext_h,
+					     hdr->StreamNo_h, true);
+			qdf_nbuf_free(nbuf);
+			continue;
+		}
+
+		echo = qdf_nbuf_copy(nbuf);
+		if (!echo) {
+			epping_bench_account(bench, hdr->HostContext_h,
+					     hdr->StreamNo_h, false);
+			qdf_nbuf_free(nbuf);
+			continue;
+		}
+		qdf_nbuf_free(nbuf);
+
+		hdr = (EPPING_HEADER *)qdf_nbuf_data(echo);
+		hdr->StreamEchoSent_t = hdr->StreamEcho_h;
+		hdr->StreamRecv_t = hdr->StreamNo_h;
+		if (!epping_bench_rx(adapter, echo))
+			qdf_nbuf_free(echo);
+	}
+}
+
+/**
+ * epping_bench_alloc() - Build a benchmark packet
+ * @bench: benchmark context
+ * @size: packet size, including the epping header
+ * @stream: stream to send the packet on
+ * @slot: slot of the packet in the burst
+ *
+ * Return: packet, NULL on allocation failure
+ */
+static qdf_nbuf_t epping_bench_alloc(struct epping_bench *bench,
+				     uint16_t size, uint8_t stream,
+				     uint16_t slot)
+{
+	EPPING_HEADER *hdr;
+	qdf_nbuf_t nbuf;
+
+	nbuf = qdf_nbuf_alloc(NULL, size + EPPING_BENCH_HEADROOM,
+			      EPPING_BENCH_HEADROOM, 4, false);
+	if (!nbuf)
+		return NULL;
+
+	qdf_nbuf_put_tail(nbuf, size);
+	hdr = (EPPING_HEADER *)qdf_nbuf_data(nbuf);
+	qdf_mem_zero(hdr, sizeof(*hdr));
+	qdf_mem_set(hdr->_HCIRsvd, sizeof(hdr->_HCIRsvd), EPPING_RSVD_FILL);
+	qdf_mem_set(hdr->_rsvd, sizeof(hdr->_rsvd), EPPING_RSVD_FILL);
+	SET_EPPING_PACKET_MAGIC(hdr);
+	hdr->StreamNo_h = stream;
+	hdr->StreamEcho_h = stream;
+	hdr->Cmd_h = bench->params.bidir ? EPPING_CMD_ECHO_PACKET :
+					   EPPING_CMD_NO_ECHO;
+	hdr->HostContext_h = EPPING_BENCH_CONTEXT(bench->gen, slot);
+	hdr->SeqNo = slot;
+	hdr->DataLength = size - sizeof(*hdr);
+
+	return nbuf;
+}
+
+/**
+ * epping_bench_send() - Hand a packet to the transport of the run
+ * @bench: benchmark context
+ * @nbuf: packet, consumed in all cases
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS epping_bench_send(struct epping_bench *bench,
+				    qdf_nbuf_t nbuf)
+{
+	epping_adapter_t *adapter = NULL;
+
+	if (bench->params.transport == EPPING_BENCH_LOOPBACK) {
+		qdf_spin_lock_bh(&bench->lock);
+		qdf_nbuf_queue_add(&bench->lb_queue, nbuf);
+		qdf_spin_unlock_bh(&bench->lock);
+		qdf_sched_work(0, &bench->lb_work);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	if (bench->epping_ctx)
+		adapter = bench->epping_ctx->epping_adapter;
+
+	if (!adapter) {
+		qdf_nbuf_free(nbuf);
+		return QDF_STATUS_E_NOSUPPORT;
+	}
+
+	if (epping_tx_send(nbuf, adapter))
+		return QDF_STATUS_E_FAILURE;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static int epping_bench_cmp(const void *a, const void *b)
+{
+	uint32_t left = *(const uint32_t *)a;
+	uint32_t right = *(const uint32_t *)b;
+
+	return (left > right) - (left < right);
+}
+
+static uint32_t epping_bench_percentile(uint32_t *samples, uint32_t num,
+					uint32_t permille)
+{
+	uint32_t idx = qdf_do_div((uint64_t)num * permille, 1000);
+
+	if (idx >= num)
+		idx = num - 1;
+
+	return samples[idx];
+}
+
+/**
+ * epping_bench_report() - Fill in the throughput and latency of a step
+ * @bench: benchmark context
+ * @result: result of the step
+ *
+ * Return: None
+ */
+static void epping_bench_report(struct epping_bench *bench,
+				struct epping_bench_result *result)
+{
+	uint32_t elapsed_us = qdf_min(result->elapsed_us, (uint64_t)U32_MAX);
+	uint32_t num = bench->num_samples;
+	uint32_t *samples = bench->samples;
+
+	if (!elapsed_us)
+		elapsed_us = 1;
+
+	result->kbps = qdf_do_div((uint64_t)result->done * result->size * 8000,
+				  elapsed_us);
+	result->pps = qdf_do_div((uint64_t)result->done * 1000000, elapsed_us);
+
+	if (!num)
+		return;
+
+	sort(samples, num, sizeof(*samples), epping_bench_cmp, NULL);
+	result->lat_min = samples[0];
+	result->lat_p50 = epping_bench_percentile(samples, num, 500);
+	result->lat_p90 = epping_bench_percentile(samples, num, 900);
+	result->lat_p99 = epping_bench_percentile(samples, num, 990);
+	result->lat_p999 = epping_bench_percentile(samples, num, 999);
+	result->lat_max = samples[num - 1];
+}
+
+/**
+ * epping_bench_step() - Run one packet size and burst depth of the sweep
+ * @bench: benchmark context
+ * @size: packet size
+ * @burst: burst depth
+ * @result: result of the step
+ *
+ * Return: None
+ */
+static void epping_bench_step(struct epping_bench *bench, uint16_t size,
+			      uint16_t burst,
+			      struct epping_bench_result *result)
+{
+	struct epping_bench_params *params = &bench->params;
+	uint32_t sent = 0;
+	uint64_t start;
+	uint16_t slot;
+	uint32_t num;
+	qdf_nbuf_t nbuf;
+	QDF_STATUS status;
+
+	qdf_mem_zero(result, sizeof(*result));
+	result->size = size;
+	result->burst = burst;
+
+	qdf_spin_lock_bh(&bench->lock);
+	bench->done = 0;
+	bench->lost = 0;
+	bench->num_samples = 0;
+	qdf_mem_zero(bench->ep_done, sizeof(bench->ep_done));
+	qdf_spin_unlock_bh(&bench->lock);
+
+	start = qdf_get_log_timestamp();
+	while (sent < params->count) {
+		num = qdf_min((uint32_t)burst, params->count - sent);
+
+		qdf_event_reset(&bench->burst_done);
+		qdf_spin_lock_bh(&bench->lock);
+		bench->gen++;
+		bench->outstanding = num;
+		qdf_spin_unlock_bh(&bench->lock);
+
+		for (slot = 0; slot < num; slot++, sent++) {
+			nbuf = epping_bench_alloc(bench, size,
+						  sent % params->num_eps, slot);
+			bench->send_ts[slot] = epping_bench_now_ns();
+			if (nbuf)
+				status = epping_bench_send(bench, nbuf);
+			else
+				status = QDF_STATUS_E_NOMEM;
+
+			if (QDF_IS_STATUS_ERROR(status))
+				epping_bench_account(bench,
+					EPPING_BENCH_CONTEXT(bench->gen, slot),
+					0, false);
+		}
+
+		status = qdf_wait_single_event(&bench->burst_done,
+					       EPPING_BENCH_TIMEOUT_MS);
+		if (QDF_IS_STATUS_ERROR(status)) {
+			EPPING_LOG(QDF_TRACE_LEVEL_ERROR,
+				   "%s: size %u burst %u: %u packets timed out",
+				   __func__, size, burst, bench->outstanding);
+			break;
+		}
+	}
+	result->elapsed_us = qdf_log_timestamp_to_usecs(
+					qdf_get_log_timestamp() - start);
+
+	/* retire the last burst, late completions are ignored from here */
+	qdf_spin_lock_bh(&bench->lock);
+	bench->lost += bench->outstanding;
+	bench->outstanding = 0;
+	bench->gen++;
+	result->sent = sent;
+	result->done = bench->done;
+	result->lost = bench->lost;
+	qdf_mem_copy(result->ep_done, bench->ep_done, sizeof(result->ep_done));
+	qdf_spin_unlock_bh(&bench->lock);
+
+	epping_bench_report(bench, result);
+
+	EPPING_LOG(QDF_TRACE_LEVEL_INFO_HIGH,
+		   "%s: size %u burst %u sent %u done %u lost %u %llu kbps %llu pps lat(ns) min %u p50 %u p90 %u p99 %u p99.9 %u max %u",
+		   __func__, result->size, result->burst, result->sent,
+		   result->done, result->lost, result->kbps, result->pps,
+		   result->lat_min, result->lat_p50, result->lat_p90,
+		   result->lat_p99, result->lat_p999, result->lat_max);
+}
+
+/**
+ * epping_bench_drain() - Drop the packets left in the loopback transport
+ * @bench: benchmark context
+ *
+ * Return: None
+ */
+static void epping_bench_drain(struct epping_bench *bench)
+{
+	qdf_nbuf_t nbuf;
+
+	qdf_flush_work(&bench->lb_work);
+
+	qdf_spin_lock_bh(&bench->lock);
+	while ((nbuf = qdf_nbuf_queue_remove(&bench->lb_queue)))
+		qdf_nbuf_free(nbuf);
+	qdf_spin_unlock_bh(&bench->lock);
+}
+
+/**
+ * epping_bench_validate() - Validate a benchmark scenario
+ * @bench: benchmark context
+ * @params: scenario
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS epping_bench_validate(struct epping_bench *bench,
+					struct epping_bench_params *params)
+{
+	if (params->transport == EPPING_BENCH_HTC && !bench->epping_ctx)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	if (params->transport != EPPING_BENCH_HTC &&
+	    params->transport != EPPING_BENCH_LOOPBACK)
+		return QDF_STATUS_E_INVAL;
+
+	if (params->size_min < sizeof(EPPING_HEADER) ||
+	    params->size_max < params->size_min)
+		return QDF_STATUS_E_INVAL;
+
+	if (!params->burst_min || params->burst_max < params->burst_min ||
+	    params->burst_max > EPPING_BENCH_MAX_BURST)
+		return QDF_STATUS_E_INVAL;
+
+	if (!params->count || params->count > EPPING_BENCH_MAX_SAMPLES)
+		return QDF_STATUS_E_INVAL;
+
+	if (!params->num_eps || params->num_eps > EPPING_BENCH_MAX_EPS)
+		return QDF_STATUS_E_INVAL;
+
+	if (params->transport == EPPING_BENCH_HTC &&
+	    params->num_eps > EPPING_BENCH_HTC_MAX_EPS)
+		return QDF_STATUS_E_INVAL;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS epping_bench_run(struct epping_bench_params *params,
+			    struct epping_bench_result *results,
+			    uint32_t max_results, uint32_t *num_results)
+{
+	struct epping_bench *bench = g_epping_bench;
+	uint32_t size, burst;
+	QDF_STATUS status;
+
+	*num_results = 0;
+
+	if (!bench)
+		return QDF_STATUS_E_INVAL;
+
+	status = epping_bench_validate(bench, params);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	qdf_mutex_acquire(&bench->run_lock);
+
+	qdf_spin_lock_bh(&bench->lock);
+	bench->params = *params;
+	bench->running = true;
+	qdf_spin_unlock_bh(&bench->lock);
+
+	for (size = params->size_min; size <= params->size_max;
+	     size += params->size_step) {
+		for (burst = params->burst_min; burst <= params->burst_max;
+		     burst *= 2) {
+			if (*num_results >= max_results)
+				goto done;
+
+			epping_bench_step(bench, size, burst,
+					  &results[(*num_results)++]);
+		}
+
+		if (!params->size_step)
+			break;
+	}
+
+done:
+	qdf_spin_lock_bh(&bench->lock);
+	bench->running = false;
+	qdf_spin_unlock_bh(&bench->lock);
+
+	epping_bench_drain(bench);
+
+	qdf_mutex_release(&bench->run_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * epping_bench_parse() - Parse a debugfs benchmark command
+ * @cmd: "key=value" pairs separated by blanks
+ * @params: scenario to update
+ *
+ * Keys: transport (htc|loopback), size_min, size_max, size_step,
+ * burst_min, burst_max, count, eps and bidir.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS epping_bench_parse(char *cmd,
+				     struct epping_bench_params *params)
+{
+	char *token;
+	char *key;
+	uint32_t value;
+
+	while ((token = qdf_str_sep(&cmd, " \t\n"))) {
+		if (!*token)
+			continue;
+
+		key = qdf_str_sep(&token, "=");
+		if (!token)
+			return QDF_STATUS_E_INVAL;
+
+		if (qdf_str_eq(key, "transport")) {
+			if (qdf_str_eq(token, "htc"))
+				params->transport = EPPING_BENCH_HTC;
+			else if (qdf_str_eq(token, "loopback"))
+				params->transport = EPPING_BENCH_LOOPBACK;
+			else
+				return QDF_STATUS_E_INVAL;
+			continue;
+		}
+
+		if (qdf_kstrtouint(token, 0, &value))
+			return QDF_STATUS_E_INVAL;
+
+		if (qdf_str_eq(key, "size_min"))
+			params->size_min = value;
+		else if (qdf_str_eq(key, "size_max"))
+			params->size_max = value;
+		else if (qdf_str_eq(key, "size_step"))
+			params->size_step = value;
+		else if (qdf_str_eq(key, "burst_min"))
+			params->burst_min = value;
+		else if (qdf_str_eq(key, "burst_max"))
+			params->burst_max = value;
+		else if (qdf_str_eq(key, "count"))
+			params->count = value;
+		else if (qdf_str_eq(key, "eps"))
+			params->num_eps = value;
+		else if (qdf_str_eq(key, "bidir"))
+			params->bidir = !!value;
+		else
+			return QDF_STATUS_E_INVAL;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * epping_bench_run_work() - Run the sweep requested through debugfs
+ * @arg: benchmark context
+ *
+ * Return: None
+ */
+static void epping_bench_run_work(void *arg)
+{
+	struct epping_bench *bench = arg;
+	struct epping_bench_params params;
+	uint32_t num_results;
+	QDF_STATUS status;
+
+	qdf_mutex_acquire(&bench->dbgfs_lock);
+	params = bench->dbgfs_params;
+	qdf_mutex_release(&bench->dbgfs_lock);
+
+	status = epping_bench_run(&params, bench->run_results,
+				  EPPING_BENCH_MAX_RESULTS, &num_results);
+
+	qdf_mutex_acquire(&bench->dbgfs_lock);
+	qdf_mem_copy(bench->dbgfs_results, bench->run_results,
+		     num_results * sizeof(*bench->run_results));
+	bench->dbgfs_num_results = num_results;
+	bench->dbgfs_status = status;
+	bench->dbgfs_running = false;
+	qdf_mutex_release(&bench->dbgfs_lock);
+}
+
+static QDF_STATUS epping_bench_debugfs_write(void *priv, const char *buf,
+					     qdf_size_t len)
+{
+	struct epping_bench *bench = priv;
+	struct epping_bench_params params;
+	char cmd[EPPING_BENCH_CMD_LEN];
+	QDF_STATUS status;
+
+	if (!len || len >= sizeof(cmd))
+		return QDF_STATUS_E_INVAL;
+
+	qdf_mem_copy(cmd, buf, len);
+	cmd[len] = '\0';
+
+	qdf_mutex_acquire(&bench->dbgfs_lock);
+	if (bench->dbgfs_running) {
+		status = QDF_STATUS_E_BUSY;
+		goto unlock;
+	}
+
+	params = bench->dbgfs_params;
+	status = epping_bench_parse(cmd, &params);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto unlock;
+
+	status = epping_bench_validate(bench, &params);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto unlock;
+
+	/* the sweep takes seconds, run it outside of the write */
+	bench->dbgfs_params = params;
+	bench->dbgfs_status = QDF_STATUS_E_PENDING;
+	bench->dbgfs_num_results = 0;
+	bench->dbgfs_running = true;
+	qdf_sched_work(0, &bench->run_work);
+
+unlock:
+	qdf_mutex_release(&bench->dbgfs_lock);
+
+	return status;
+}
+
+static QDF_STATUS epping_bench_debugfs_show(qdf_debugfs_file_t file,
+					    void *arg)
+{
+	struct epping_bench *bench = arg;
+	struct epping_bench_params *params = &bench->dbgfs_params;
+	struct epping_bench_result *result;
+	uint32_t i, ep;
+
+	qdf_mutex_acquire(&bench->dbgfs_lock);
+	qdf_debugfs_printf(file,
+			   "transport=%s size_min=%u size_max=%u size_step=%u burst_min=%u burst_max=%u count=%u eps=%u bidir=%u status=%d running=%u\n",
+			   params->transport == EPPING_BENCH_HTC ?
+			   "htc" : "loopback",
+			   params->size_min, params->size_max,
+			   params->size_step, params->burst_min,
+			   params->burst_max, params->count, params->num_eps,
+			   params->bidir, bench->dbgfs_status,
+			   bench->dbgfs_running);
+	qdf_debugfs_printf(file,
+			   "size burst sent done lost elapsed_us kbps pps lat_ns(min p50 p90 p99 p99.9 max) ep_done\n");
+
+	for (i = 0; i < bench->dbgfs_num_results; i++) {
+		result = &bench->dbgfs_results[i];
+		qdf_debugfs_printf(file,
+				   "%u %u %u %u %u %llu %llu %llu %u %u %u %u %u %u %u",
+				   result->size, result->burst, result->sent,
+				   result->done, result->lost,
+				   result->elapsed_us, result->kbps,
+				   result->pps, result->lat_min,
+				   result->lat_p50, result->lat_p90,
+				   result->lat_p99, result->lat_p999,
+				   result->lat_max, result->ep_done[0]);
+		for (ep = 1; ep < params->num_eps; ep++)
+			qdf_debugfs_printf(file, "/%u", result->ep_done[ep]);
+		qdf_debugfs_printf(file, "\n");
+	}
+	qdf_mutex_release(&bench->dbgfs_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS epping_bench_init(void *epping_ctx)
+{
+	struct epping_bench *bench;
+	QDF_STATUS status;
+
+	if (g_epping_bench)
+		return QDF_STATUS_E_ALREADY;
+
+	bench = qdf_mem_malloc(sizeof(*bench));
+	if (!bench)
+		return QDF_STATUS_E_NOMEM;
+
+	bench->samples = qdf_mem_malloc(EPPING_BENCH_MAX_SAMPLES *
+					sizeof(*bench->samples));
+	if (!bench->samples) {
+		status = QDF_STATUS_E_NOMEM;
+		goto free_bench;
+	}
+
+	status = qdf_create_work(0, &bench->lb_work, epping_bench_lb_work,
+				 bench);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto free_samples;
+
+	status = qdf_create_work(0, &bench->run_work, epping_bench_run_work,
+				 bench);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto destroy_lb_work;
+
+	status = qdf_event_create(&bench->burst_done);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto destroy_run_work;
+
+	qdf_spinlock_create(&bench->lock);
+	qdf_mutex_create(&bench->run_lock);
+	qdf_mutex_create(&bench->dbgfs_lock);
+	qdf_nbuf_queue_init(&bench->lb_queue);
+
+	bench->epping_ctx = epping_ctx;
+	bench->dbgfs_params.transport = epping_ctx ? EPPING_BENCH_HTC :
+						     EPPING_BENCH_LOOPBACK;
+	bench->dbgfs_params.size_min = 128;
+	bench->dbgfs_params.size_max = 1536;
+	bench->dbgfs_params.size_step = 352;
+	bench->dbgfs_params.burst_min = 1;
+	bench->dbgfs_params.burst_max = 64;
+	bench->dbgfs_params.count = 1024;
+	bench->dbgfs_params.num_eps = 1;
+
+	bench->fops.show = epping_bench_debugfs_show;
+	bench->fops.write = epping_bench_debugfs_write;
+	bench->fops.priv = bench;
+	bench->dentry = qdf_debugfs_create_file("epping_bench",
+						EPPING_BENCH_DEBUGFS_PERMS,
+						NULL, &bench->fops);
+	if (!bench->dentry)
+		EPPING_LOG(QDF_TRACE_LEVEL_ERROR,
+			   "%s: epping_bench debugfs entry not created",
+			   __func__);
+
+	g_epping_bench = bench;
+
+	return QDF_STATUS_SUCCESS;
+
+destroy_run_work:
+	qdf_destroy_work(0, &bench->run_work);
+destroy_lb_work:
+	qdf_destroy_work(0, &bench->lb_work);
+free_samples:
+	qdf_mem_free(bench->samples);
+free_bench:
+	qdf_mem_free(bench);
+
+	return status;
+}
+
+void epping_bench_deinit(void)
+{
+	struct epping_bench *bench = g_epping_bench;
+
+	if (!bench)
+		return;
+
+	if (bench->dentry)
+		qdf_debugfs_remove_file(bench->dentry);
+
+	/* let a debugfs sweep in progress complete while rx is accounted */
+	qdf_destroy_work(0, &bench->run_work);
+
+	g_epping_bench = NULL;
+
+	qdf_destroy_work(0, &bench->lb_work);
+	epping_bench_drain(bench);
+	qdf_event_destroy(&bench->burst_done);
+	qdf_mutex_destroy(&bench->dbgfs_lock);
+	qdf_mutex_destroy(&bench->run_lock);
+	qdf_spinlock_destroy(&bench->lock);
+	qdf_mem_free(bench->samples);
+	qdf_mem_free(bench);
+}
@@ -44,6 +44,7 @@
 #include "hif.h"
 #include "epping_main.h"
 #include "epping_internal.h"
+#include "epping_bench.h"
 #include "wlan_policy_mgr_api.h"
 
 #ifdef TIMER_MANAGER
@@ -85,6 +86,11 @@ int epping_open(void)
 		return -ENOMEM;
 
 	g_epping_ctx->con_mode = cds_get_conparam();
+
+	if (QDF_IS_STATUS_ERROR(epping_bench_init(g_epping_ctx)))
+		EPPING_LOG(QDF_TRACE_LEVEL_ERROR,
+			   "%s: benchmark not available", __func__);
+
 	return 0;
 }
 
@@ -151,6 +157,8 @@ void epping_close(void)
 		return;
 	}
 
+	epping_bench_deinit();
+
 	to_free = g_epping_ctx;
 	g_epping_ctx = NULL;
 	qdf_mem_free(to_free);
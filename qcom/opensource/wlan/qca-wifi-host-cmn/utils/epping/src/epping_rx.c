@@ -129,6 +129,8 @@ void epping_rx(void *ctx, HTC_PACKET *pPacket)
 		if (enb_rx_dump)
 			epping_hex_dump((void *)qdf_nbuf_data(pktSkb),
 					pktSkb->len, __func__);
+		if (epping_bench_rx(adapter, pktSkb))
+			return;
 		pktSkb->dev = dev;
 		if ((pktSkb->dev->flags & IFF_UP) == IFF_UP) {
 			pktSkb->protocol = eth_type_trans(pktSkb, pktSkb->dev);
@@ -384,6 +384,7 @@ void epping_tx_complete(void *ctx, HTC_PACKET *htc_pkt)
 		pktSkb = qdf_nbuf_queue_remove(&skb_queue);
 		if (!pktSkb)
 			break;
+		epping_bench_tx_comp(pktSkb, QDF_IS_STATUS_SUCCESS(status));
 		qdf_nbuf_tx_free(pktSkb, QDF_NBUF_PKT_ERROR);
 		pEpping_ctx->total_tx_acks++;
 	}
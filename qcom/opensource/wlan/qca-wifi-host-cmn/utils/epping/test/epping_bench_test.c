@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "epping_bench.h"
+#include "epping_bench_test.h"
+#include "epping_internal.h"
+
+#define ut_bench_size_min 128
+#define ut_bench_size_max 1536
+#define ut_bench_size_step 704
+#define ut_bench_burst_max 32
+#define ut_bench_count 256
+
+static uint32_t epping_bench_ut_check(struct epping_bench_params *params,
+				      struct epping_bench_result *result)
+{
+	uint32_t expected;
+	uint32_t errors = 0;
+	uint8_t ep;
+
+	if (result->sent != params->count || result->done != result->sent ||
+	    result->lost) {
+		qdf_nofl_alert("FAIL: size %u burst %u sent %u done %u lost %u",
+			       result->size, result->burst, result->sent,
+			       result->done, result->lost);
+		errors++;
+	}
+
+	/* packets are spread round robin over the streams */
+	for (ep = 0; ep < EPPING_BENCH_MAX_EPS; ep++) {
+		expected = 0;
+		if (ep < params->num_eps)
+			expected = result->done / params->num_eps +
+				   (ep < result->done % params->num_eps);
+
+		if (result->ep_done[ep] != expected) {
+			qdf_nofl_alert("FAIL: size %u burst %u stream %u done %u of %u",
+				       result->size, result->burst, ep,
+				       result->ep_done[ep], result->done);
+			errors++;
+		}
+	}
+
+	if (result->lat_min > result->lat_p50 ||
+	    result->lat_p50 > result->lat_p90 ||
+	    result->lat_p90 > result->lat_p99 ||
+	    result->lat_p99 > result->lat_p999 ||
+	    result->lat_p999 > result->lat_max) {
+		qdf_nofl_alert("FAIL: size %u burst %u percentiles %u %u %u %u %u %u",
+			       result->size, result->burst, result->lat_min,
+			       result->lat_p50, result->lat_p90,
+			       result->lat_p99, result->lat_p999,
+			       result->lat_max);
+		errors++;
+	}
+
+	if (!result->pps) {
+		qdf_nofl_alert("FAIL: size %u burst %u no throughput",
+			       result->size, result->burst);
+		errors++;
+	}
+
+	return errors;
+}
+
+static uint32_t epping_bench_ut_sweep(epping_adapter_t *adapter, bool bidir,
+				      uint8_t num_eps)
+{
+	struct epping_bench_params params = {
+		.transport = EPPING_BENCH_LOOPBACK,
+		.size_min = ut_bench_size_min,
+		.size_max = ut_bench_size_max,
+		.size_step = ut_bench_size_step,
+		.burst_min = 1,
+		.burst_max = ut_bench_burst_max,
+		.count = ut_bench_count,
+		.num_eps = num_eps,
+		.bidir = bidir,
+	};
+	struct epping_bench_result *results;
+	unsigned long rx_packets = 0;
+	unsigned long rx_bytes = 0;
+	uint32_t num_results;
+	uint32_t expected;
+	uint32_t errors = 0;
+	uint32_t i;
+	QDF_STATUS status;
+
+	results = qdf_mem_malloc(EPPING_BENCH_MAX_RESULTS * sizeof(*results));
+	if (!results)
+		return 1;
+
+	if (adapter)
+		qdf_mem_zero(&adapter->stats, sizeof(adapter->stats));
+
+	status = epping_bench_run(&params, results, EPPING_BENCH_MAX_RESULTS,
+				  &num_results);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_nofl_alert("FAIL: bidir %u eps %u run status %d",
+			       bidir, num_eps, status);
+		errors++;
+		goto free;
+	}
+
+	/* 3 sizes x bursts 1, 2, 4, 8, 16 and 32 */
+	expected = 3 * 6;
+	if (num_results != expected) {
+		qdf_nofl_alert("FAIL: bidir %u eps %u %u results, expected %u",
+			       bidir, num_eps, num_results, expected);
+		errors++;
+	}
+
+	for (i = 0; i < num_results; i++) {
+		errors += epping_bench_ut_check(&params, &results[i]);
+		qdf_nofl_info("epping_bench: bidir %u eps %u size %u burst %u %llu pps p50 %u ns p99 %u ns",
+			      bidir, num_eps, results[i].size,
+			      results[i].burst, results[i].pps,
+			      results[i].lat_p50, results[i].lat_p99);
+		if (bidir) {
+			rx_packets += results[i].done;
+			rx_bytes += results[i].done * results[i].size;
+		}
+	}
+
+	/* echoes consumed by the benchmark still count as received */
+	if (adapter && (adapter->stats.rx_packets != rx_packets ||
+			adapter->stats.rx_bytes != rx_bytes)) {
+		qdf_nofl_alert("FAIL: bidir %u eps %u rx %lu packets %lu bytes, expected %lu %lu",
+			       bidir, num_eps, adapter->stats.rx_packets,
+			       adapter->stats.rx_bytes, rx_packets, rx_bytes);
+		errors++;
+	}
+
+free:
+	qdf_mem_free(results);
+
+	return errors;
+}
+
+static uint32_t epping_bench_ut_invalid(void)
+{
+	struct epping_bench_params params = {
+		.transport = EPPING_BENCH_LOOPBACK,
+		.size_min = ut_bench_size_min,
+		.size_max = ut_bench_size_min,
+		.burst_min = 1,
+		.burst_max = 1,
+		.count = 1,
+		.num_eps = EPPING_BENCH_MAX_EPS + 1,
+	};
+	struct epping_bench_result result;
+	uint32_t num_results;
+	uint32_t errors = 0;
+
+	if (epping_bench_run(&params, &result, 1, &num_results) !=
+	    QDF_STATUS_E_INVAL) {
+		qdf_nofl_alert("FAIL: %u streams accepted", params.num_eps);
+		errors++;
+	}
+
+	/* only two streams are mapped to HTC endpoints */
+	params.transport = EPPING_BENCH_HTC;
+	params.num_eps = EPPING_BENCH_HTC_MAX_EPS + 1;
+	if (epping_bench_run(&params, &result, 1, &num_results) !=
+	    QDF_STATUS_E_INVAL) {
+		qdf_nofl_alert("FAIL: %u HTC streams accepted",
+			       params.num_eps);
+		errors++;
+	}
+
+	params.transport = EPPING_BENCH_LOOPBACK;
+	params.num_eps = 1;
+	params.burst_max = EPPING_BENCH_MAX_BURST + 1;
+	if (epping_bench_run(&params, &result, 1, &num_results) !=
+	    QDF_STATUS_E_INVAL) {
+		qdf_nofl_alert("FAIL: burst %u accepted", params.burst_max);
+		errors++;
+	}
+
+	params.burst_max = 1;
+	params.size_min = 1;
+	if (epping_bench_run(&params, &result, 1, &num_results) !=
+	    QDF_STATUS_E_INVAL) {
+		qdf_nofl_alert("FAIL: size %u accepted", params.size_min);
+		errors++;
+	}
+
+	return errors;
+}
+
+uint32_t epping_bench_unit_test(void)
+{
+	epping_context_t *epping_ctx;
+	epping_adapter_t *adapter = NULL;
+	uint32_t errors = 0;
+	uint8_t num_eps;
+	QDF_STATUS status;
+
+	epping_ctx = qdf_mem_malloc(sizeof(*epping_ctx));
+	if (!epping_ctx)
+		return 1;
+
+	/*
+	 * Reuse the benchmark of the epping driver when it is loaded, the rx
+	 * stats of its adapter are not checked then.
+	 */
+	status = epping_bench_init(epping_ctx);
+	if (QDF_IS_STATUS_SUCCESS(status)) {
+		adapter = qdf_mem_malloc(sizeof(*adapter));
+		if (!adapter) {
+			errors++;
+			goto deinit;
+		}
+		epping_ctx->epping_adapter = adapter;
+	} else if (status != QDF_STATUS_E_ALREADY) {
+		qdf_nofl_alert("FAIL: epping bench init status %d", status);
+		errors++;
+		goto free_ctx;
+	}
+
+	errors += epping_bench_ut_invalid();
+	for (num_eps = 1; num_eps <= EPPING_BENCH_MAX_EPS; num_eps++) {
+		errors += epping_bench_ut_sweep(adapter, false, num_eps);
+		errors += epping_bench_ut_sweep(adapter, true, num_eps);
+	}
+
+deinit:
+	if (QDF_IS_STATUS_SUCCESS(status))
+		epping_bench_deinit();
+	qdf_mem_free(adapter);
+free_ctx:
+	qdf_mem_free(epping_ctx);
+
+	return errors;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __EPPING_BENCH_TEST
+#define __EPPING_BENCH_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_EPPING_BENCH_TEST
+/**
+ * epping_bench_unit_test() - run the epping benchmark unit test suite
+ *
+ * Runs size, burst depth and bidirectional sweeps over one up to every
+ * epping stream of the loopback transport and checks the accounting, the
+ * stream split and latency percentiles of every step, as well as the rx
+ * stats of the echoes consumed by the benchmark.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t epping_bench_unit_test(void);
+#else
+static inline uint32_t epping_bench_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_EPPING_BENCH_TEST */
+
+#endif /* __EPPING_BENCH_TEST */
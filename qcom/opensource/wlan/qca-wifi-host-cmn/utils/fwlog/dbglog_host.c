@@ -36,6 +36,10 @@
 #include <linux/debugfs.h>
 #endif /* WLAN_OPEN_SOURCE */
 #include "wmi_unified_priv.h"
+#ifdef WLAN_FWLOG_STREAM
+#include "qdf_debugfs.h"
+#include "qdf_streamfs.h"
+#endif
 
 #ifdef CNSS_GENL
 #ifdef CONFIG_CNSS_OUT_OF_TREE
@@ -1859,6 +1863,237 @@ dbglog_process_netlink_data(wmi_unified_t wmi_handle, const uint8_t *buffer,
 	return res;
 }
 
+#ifdef WLAN_FWLOG_STREAM
+#define DBGLOG_STREAM_DIR           "fwlog"
+#define DBGLOG_STREAM_STATS_FILE    "stats"
+#define DBGLOG_STREAM_SUBBUF_SIZE   8192
+#define DBGLOG_STREAM_NUM_SUBBUFS   8
+#define DBGLOG_STREAM_COALESCE      16
+
+/* the uapi record header describes the streamfs one to user space */
+QDF_COMPILE_TIME_ASSERT(dbglog_stream_rec_hdr_size,
+			sizeof(struct dbglog_stream_rec_hdr) ==
+			sizeof(struct qdf_streamfs_rec_hdr));
+QDF_COMPILE_TIME_ASSERT(dbglog_stream_rec_hdr_seq,
+			offsetof(struct dbglog_stream_rec_hdr, seq) ==
+			offsetof(struct qdf_streamfs_rec_hdr, seq));
+QDF_COMPILE_TIME_ASSERT(dbglog_stream_rec_hdr_lost,
+			offsetof(struct dbglog_stream_rec_hdr, lost) ==
+			offsetof(struct qdf_streamfs_rec_hdr, lost));
+QDF_COMPILE_TIME_ASSERT(dbglog_stream_rec_magic,
+			DBGLOG_STREAM_REC_MAGIC == QDF_STREAMFS_REC_MAGIC);
+
+/**
+ * struct dbglog_stream_chan - streamfs channel of one firmware log event
+ * @name: base name of the per CPU files of the channel
+ * @batch: batched streamfs channel, NULL until the first switch to
+ *  DBGLOG_PROCESS_STREAM_RAW and after dbglog_deinit()
+ * @fw_dropped: log buffers the firmware reported as dropped
+ */
+struct dbglog_stream_chan {
+	const char *name;
+	qdf_streamfs_batch_t batch;
+	qdf_atomic_t fw_dropped;
+};
+
+/**
+ * struct dbglog_stream - raw firmware log streaming
+ * @dir: debugfs directory of the channels
+ * @chan: channels, indexed by enum dbglog_stream_rec_type
+ * @stats_fops: ops of the stats file
+ *
+ * The channels are kept open until dbglog_deinit() once streaming was
+ * enabled. The event handlers may still run while dbglog_deinit() closes
+ * them, so they only write to a channel in a qdf_rcu_read_lock_bh()
+ * section, which dbglog_stream_close() waits for before closing it.
+ */
+static struct dbglog_stream {
+	qdf_dentry_t dir;
+	struct dbglog_stream_chan chan[DBGLOG_STREAM_REC_MAX];
+	struct qdf_debugfs_fops stats_fops;
+} dbglog_stream = {
+	.chan = {
+		[DBGLOG_STREAM_REC_DBGLOG] = { .name = "dbglog" },
+		[DBGLOG_STREAM_REC_DIAG] = { .name = "diag" },
+		[DBGLOG_STREAM_REC_DIAG_DATA] = { .name = "diag_data" },
+	},
+};
+
+/**
+ * dbglog_stream_write() - relay a raw firmware log buffer
+ * @type: channel of the buffer
+ * @buf: WMI event buffer
+ * @len: length of @buf
+ * @fw_dropped: log buffers the firmware dropped before this one
+ *
+ * The buffer is copied once, into the relay sub-buffer of the current CPU.
+ * It is dropped, and counted as such by the channel, if the reader lags,
+ * and silently once the channel is closed.
+ *
+ * Relay buffers are per CPU and qdf_streamfs_batch_write() keeps interrupts
+ * off while it fills one, so handlers on different CPUs write without a
+ * shared lock.
+ *
+ * Return: A_OK
+ */
+static int dbglog_stream_write(enum dbglog_stream_rec_type type,
+			       const uint8_t *buf, uint32_t len,
+			       uint32_t fw_dropped)
+{
+	struct dbglog_stream_chan *chan = &dbglog_stream.chan[type];
+	struct qdf_streamfs_iov iov = { buf, len };
+	qdf_streamfs_batch_t batch;
+
+	qdf_rcu_read_lock_bh();
+	batch = READ_ONCE(chan->batch);
+	if (batch) {
+		if (fw_dropped)
+			qdf_atomic_add(fw_dropped, &chan->fw_dropped);
+		qdf_streamfs_batch_write(batch, type, &iov, 1);
+	}
+	qdf_rcu_read_unlock_bh();
+
+	return A_OK;
+}
+
+static void dbglog_stream_backpressure_cb(void *cb_ctx, bool congested)
+{
+	struct dbglog_stream_chan *chan = cb_ctx;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC,
+			("%s: fwlog %s reader %s\n", __func__, chan->name,
+			 congested ? "lagging, dropping buffers" :
+				     "caught up"));
+}
+
+static QDF_STATUS dbglog_stream_stats_show(qdf_debugfs_file_t file,
+					   void *arg)
+{
+	struct qdf_streamfs_batch_stats stats;
+	struct dbglog_stream_chan *chan;
+	int i;
+
+	for (i = 0; i < DBGLOG_STREAM_REC_MAX; i++) {
+		chan = &dbglog_stream.chan[i];
+		qdf_mem_zero(&stats, sizeof(stats));
+		qdf_rcu_read_lock_bh();
+		qdf_streamfs_batch_get_stats(READ_ONCE(chan->batch), &stats);
+		qdf_rcu_read_unlock_bh();
+		qdf_debugfs_printf(file,
+				   "%s: written %u dropped %u fw_dropped %u congestions %u\n",
+				   chan->name, stats.written, stats.dropped,
+				   qdf_atomic_read(&chan->fw_dropped),
+				   stats.congestions);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dbglog_stream_close() - close the raw firmware log channels
+ *
+ * The channels are detached first, and closed only once the handlers
+ * still writing to them, after their events were unregistered, are done.
+ *
+ * Return: None
+ */
+static void dbglog_stream_close(void)
+{
+	qdf_streamfs_batch_t batch[DBGLOG_STREAM_REC_MAX];
+	int i;
+
+	if (!dbglog_stream.dir)
+		return;
+
+	for (i = 0; i < DBGLOG_STREAM_REC_MAX; i++) {
+		batch[i] = dbglog_stream.chan[i].batch;
+		WRITE_ONCE(dbglog_stream.chan[i].batch, NULL);
+	}
+
+	qdf_synchronize_rcu_bh();
+
+	for (i = 0; i < DBGLOG_STREAM_REC_MAX; i++) {
+		qdf_atomic_set(&dbglog_stream.chan[i].fw_dropped, 0);
+		if (batch[i])
+			qdf_streamfs_batch_close(batch[i]);
+	}
+
+	qdf_streamfs_remove_dir_recursive(dbglog_stream.dir);
+	dbglog_stream.dir = NULL;
+}
+
+/**
+ * dbglog_stream_open() - open the raw firmware log channels
+ *
+ * Return: A_OK if the channels are open, A_ERROR otherwise
+ */
+static int dbglog_stream_open(void)
+{
+	struct qdf_streamfs_batch_cfg cfg = {0};
+	struct dbglog_stream_chan *chan;
+	qdf_streamfs_batch_t batch;
+	int i;
+
+	if (dbglog_stream.dir)
+		return A_OK;
+
+	dbglog_stream.dir = qdf_streamfs_create_dir(DBGLOG_STREAM_DIR, NULL);
+	if (!dbglog_stream.dir) {
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("Failed to create fwlog stream dir\n"));
+		return A_ERROR;
+	}
+
+	cfg.subbuf_size = DBGLOG_STREAM_SUBBUF_SIZE;
+	cfg.n_subbufs = DBGLOG_STREAM_NUM_SUBBUFS;
+	cfg.coalesce = DBGLOG_STREAM_COALESCE;
+	cfg.backpressure_cb = dbglog_stream_backpressure_cb;
+
+	for (i = 0; i < DBGLOG_STREAM_REC_MAX; i++) {
+		chan = &dbglog_stream.chan[i];
+		cfg.cb_ctx = chan;
+		batch = qdf_streamfs_batch_open(chan->name, dbglog_stream.dir,
+						&cfg);
+		if (!batch) {
+			AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+					("Failed to open fwlog %s stream\n",
+					 chan->name));
+			dbglog_stream_close();
+			return A_ERROR;
+		}
+
+		/* the handlers see the channel only once it is set up */
+		smp_store_release(&chan->batch, batch);
+	}
+
+	dbglog_stream.stats_fops.show = dbglog_stream_stats_show;
+	if (!qdf_debugfs_create_file(DBGLOG_STREAM_STATS_FILE,
+				     QDF_FILE_USR_READ, dbglog_stream.dir,
+				     &dbglog_stream.stats_fops))
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("Failed to create fwlog stream stats\n"));
+
+	return A_OK;
+}
+#else
+static inline int dbglog_stream_write(enum dbglog_stream_rec_type type,
+				      const uint8_t *buf, uint32_t len,
+				      uint32_t fw_dropped)
+{
+	return A_OK;
+}
+
+static inline void dbglog_stream_close(void)
+{
+}
+
+static inline int dbglog_stream_open(void)
+{
+	AR_DEBUG_PRINTF(ATH_DEBUG_ERR, ("fwlog streaming not supported\n"));
+	return A_ERROR;
+}
+#endif /* WLAN_FWLOG_STREAM */
+
 /*
  * WMI diag data event handler, this function invoked as a CB
  * when there DIAG_EVENT, DIAG_MSG, DIAG_DBG to be
@@ -1923,6 +2158,10 @@ static int diag_fw_handler(ol_scn_t scn, uint8_t *data, uint32_t datalen)
 			}
 		}
 	}
+	if (dbglog_process_type == DBGLOG_PROCESS_STREAM_RAW)
+		return dbglog_stream_write(DBGLOG_STREAM_REC_DIAG, datap, len,
+					   0);
+
 	if (dbglog_process_type == DBGLOG_PROCESS_PRINT_RAW) {
 		if (!gprint_limiter) {
 			AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
@@ -1978,6 +2217,10 @@ fw_diag_data_event_handler(ol_scn_t scn, uint8_t *data, uint32_t datalen)
 
 	datap = (uint8_t *) param_buf->bufp;
 
+	if (dbglog_process_type == DBGLOG_PROCESS_STREAM_RAW)
+		return dbglog_stream_write(DBGLOG_STREAM_REC_DIAG_DATA, datap,
+					   num_data, 0);
+
 	return process_fw_diag_event_data(datap, num_data);
 }
 
@@ -2024,6 +2267,10 @@ int dbglog_parse_debug_logs(ol_scn_t scn, uint8_t *data, uint32_t datalen)
 	}
 
 	dropped = *((uint32_t *) datap);
+	if (dbglog_process_type == DBGLOG_PROCESS_STREAM_RAW)
+		return dbglog_stream_write(DBGLOG_STREAM_REC_DBGLOG, datap, len,
+					   dropped);
+
 	if (dropped > 0) {
 		AR_DEBUG_PRINTF(ATH_DEBUG_TRC,
 				("%d log buffers are dropped\n", dropped));
@@ -4475,6 +4722,9 @@ int dbglog_parser_type_init(wmi_unified_t wmi_handle, int type)
 	if (type >= DBGLOG_PROCESS_MAX)
 		return A_ERROR;
 
+	if (type == DBGLOG_PROCESS_STREAM_RAW && dbglog_stream_open())
+		return A_ERROR;
+
 	dbglog_process_type = type;
 	gprint_limiter = false;
 
@@ -4563,5 +4813,19 @@ int dbglog_deinit(wmi_unified_t wmi_handle)
 	if (QDF_IS_STATUS_ERROR(res))
 		return A_ERROR;
 
+	res = wmi_unified_unregister_event_handler(wmi_handle,
+						   wmi_diag_container_event_id);
+	if (QDF_IS_STATUS_ERROR(res))
+		return A_ERROR;
+
+	res = wmi_unified_unregister_event_handler(wmi_handle,
+						   wmi_diag_event_id);
+	if (QDF_IS_STATUS_ERROR(res))
+		return A_ERROR;
+
+	if (dbglog_process_type == DBGLOG_PROCESS_STREAM_RAW)
+		dbglog_process_type = DBGLOG_PROCESS_NET_RAW;
+	dbglog_stream_close();
+
 	return A_OK;
 }
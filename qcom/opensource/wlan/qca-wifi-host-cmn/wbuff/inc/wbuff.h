@@ -86,6 +86,8 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num,
  * wbuff_module_deregister() - De-registers a module with wbuff
  * @hdl: wbuff_handle corresponding to the module
  *
+ * May sleep, as it waits for the per CPU cache accesses in progress.
+ *
  * Return: QDF_STATUS_SUCCESS - deregistration success
  *         QDF_STATUS_E_INVAL - deregistration failure
  */
@@ -114,6 +116,20 @@ qdf_nbuf_t wbuff_buff_get(struct wbuff_mod_handle *hdl, uint32_t len,
  */
 qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf);
 
+/**
+ * wbuff_display_stats() - print the pool statistics of registered modules
+ *
+ * Return: None
+ */
+void wbuff_display_stats(void);
+
+/**
+ * wbuff_clear_stats() - clear the pool statistics of all modules
+ *
+ * Return: None
+ */
+void wbuff_clear_stats(void);
+
 #else
 
 static inline QDF_STATUS wbuff_module_init(void)
@@ -151,5 +167,13 @@ wbuff_buff_put(qdf_nbuf_t buf)
 	return buf;
 }
 
+static inline void wbuff_display_stats(void)
+{
+}
+
+static inline void wbuff_clear_stats(void)
+{
+}
+
 #endif
 #endif /* _WBUFF_H */
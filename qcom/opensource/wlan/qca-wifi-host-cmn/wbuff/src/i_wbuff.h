@@ -24,7 +24,10 @@
 #ifndef _I_WBUFF_H
 #define _I_WBUFF_H
 
+#include <qdf_atomic.h>
+#include <qdf_mem.h>
 #include <qdf_nbuf.h>
+#include <qdf_util.h>
 
 /* Number of modules supported by wbuff */
 #define WBUFF_MAX_MODULES 4
@@ -63,6 +66,64 @@ uint16_t wbuff_alloc_max[WBUFF_MAX_POOLS] = {WBUFF_POOL_0_MAX,
 					     WBUFF_POOL_2_MAX,
 					     WBUFF_POOL_3_MAX};
 
+/* wbuff pool buffer lengths indexed by pool slot */
+static const uint16_t wbuff_pool_len[WBUFF_MAX_POOLS] = {WBUFF_LEN_POOL0,
+							 WBUFF_LEN_POOL1,
+							 WBUFF_LEN_POOL2,
+							 WBUFF_LEN_POOL3};
+
+#ifdef WLAN_FEATURE_WBUFF_PCPU
+/* Max buffers cached per CPU for each pool */
+#define WBUFF_PCPU_CACHE_MAX 4
+
+/* Shared pool operations between two updates of the pool target */
+#define WBUFF_ADAPT_WINDOW 64
+
+/**
+ * struct wbuff_pcpu_cache - per CPU cache in front of a module pool
+ * @head: cached buffers
+ * @count: number of buffers in @head
+ * @hit: number of requests served from the cache
+ */
+struct wbuff_pcpu_cache {
+	qdf_nbuf_t head;
+	uint16_t count;
+	uint32_t hit;
+};
+
+/**
+ * struct wbuff_pool_ctl - demand driven size control of a module pool
+ * @outstanding: buffers given to the module and not yet returned
+ * @total: buffers owned by the pool, cached or outstanding
+ * @base: number of buffers requested at registration
+ * @target: number of buffers the pool is allowed to own
+ * @window_peak: highest @outstanding seen in the current window
+ * @window_ops: shared pool operations in the current window
+ */
+struct wbuff_pool_ctl {
+	qdf_atomic_t outstanding;
+	uint16_t total;
+	uint16_t base;
+	uint16_t target;
+	uint16_t window_peak;
+	uint16_t window_ops;
+};
+#endif
+
+/**
+ * struct wbuff_pool_stats - statistics of a module pool
+ * @hit: number of requests served from the shared pool
+ * @miss: number of requests the pool could not serve
+ * @grow: number of buffers added to the pool on demand
+ * @shrink: number of buffers released on return as the pool was too large
+ */
+struct wbuff_pool_stats {
+	uint32_t hit;
+	uint32_t miss;
+	uint32_t grow;
+	uint32_t shrink;
+};
+
 /**
  * struct wbuff_handle - wbuff handle to the registered module
  * @id: the identifier for the registered module.
@@ -74,22 +135,33 @@ struct wbuff_handle {
 /**
  * struct wbuff_module - allocation holder for wbuff registered module
  * @registered: To identify whether module is registered
- * @pending_returns: Number of buffers pending to be returned to
- * wbuff by the module
+ * @draining: the per CPU caches are being emptied after a deregistration,
+ *  the slot is not to be reused yet
+ * @pending_returns: Number of buffers pending to be returned to the
+ * module pools, those held in the per CPU caches included
  * @lock: Lock for accessing per module buffer slots
  * @handle: wbuff handle for the registered module
  * @reserve: nbuf headroom to start with
  * @align: alignment for the nbuf
  * @pool[]: pools for all available buffers for the module
+ * @stats: per pool statistics
+ * @ctl: per pool size control
+ * @pcpu: per CPU caches of each pool
  */
 struct wbuff_module {
 	bool registered;
+	bool draining;
 	uint16_t pending_returns;
 	qdf_spinlock_t lock;
 	struct wbuff_handle handle;
 	int reserve;
 	int align;
 	qdf_nbuf_t pool[WBUFF_MAX_POOLS];
+	struct wbuff_pool_stats stats[WBUFF_MAX_POOLS];
+#ifdef WLAN_FEATURE_WBUFF_PCPU
+	struct wbuff_pool_ctl ctl[WBUFF_MAX_POOLS];
+	struct wbuff_pcpu_cache pcpu[QDF_MAX_AVAILABLE_CPU][WBUFF_MAX_POOLS];
+#endif
 };
 
 /**
@@ -38,14 +38,14 @@ struct wbuff_holder wbuff;
  */
 static uint8_t wbuff_get_pool_slot_from_len(uint16_t len)
 {
-	if ((len > 0) && (len <= WBUFF_LEN_POOL0))
-		return WBUFF_POOL_0;
-	else if ((len > WBUFF_LEN_POOL0) && (len <= WBUFF_LEN_POOL1))
-		return WBUFF_POOL_1;
-	else if ((len > WBUFF_LEN_POOL1) && (len <= WBUFF_LEN_POOL2))
-		return WBUFF_POOL_2;
-	else
-		return WBUFF_POOL_3;
+	uint8_t pslot;
+
+	for (pslot = 0; pslot < WBUFF_MAX_POOLS - 1; pslot++) {
+		if (len <= wbuff_pool_len[pslot])
+			break;
+	}
+
+	return pslot;
 }
 
 /**
@@ -56,26 +56,10 @@ static uint8_t wbuff_get_pool_slot_from_len(uint16_t len)
  */
 static uint32_t wbuff_get_len_from_pool_slot(uint16_t pool_slot)
 {
-	uint32_t len = 0;
-
-	switch (pool_slot) {
-	case 0:
-		len = WBUFF_LEN_POOL0;
-		break;
-	case 1:
-		len = WBUFF_LEN_POOL1;
-		break;
-	case 2:
-		len = WBUFF_LEN_POOL2;
-		break;
-	case 3:
-		len = WBUFF_LEN_POOL3;
-		break;
-	default:
-		len = 0;
-	}
+	if (pool_slot >= WBUFF_MAX_POOLS)
+		return 0;
 
-	return len;
+	return wbuff_pool_len[pool_slot];
 }
 
 /**
@@ -89,7 +73,8 @@ static uint8_t wbuff_get_free_mod_slot(void)
 
 	for (mslot = 0; mslot < WBUFF_MAX_MODULES; mslot++) {
 		qdf_spin_lock_bh(&wbuff.mod[mslot].lock);
-		if (!wbuff.mod[mslot].registered) {
+		if (!wbuff.mod[mslot].registered &&
+		    !wbuff.mod[mslot].draining) {
 			wbuff.mod[mslot].registered = true;
 			qdf_spin_unlock_bh(&wbuff.mod[mslot].lock);
 			break;
@@ -154,6 +139,420 @@ static qdf_nbuf_t wbuff_prepare_nbuf(uint8_t mslot, uint8_t pslot,
 	return buf;
 }
 
+#ifdef WLAN_FEATURE_WBUFF_PCPU
+/**
+ * wbuff_pcpu_cache() - get the cache of a pool for the current CPU
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Buffers are taken and returned from process and bottom half context
+ * only, so a cache is used without a lock in a qdf_rcu_read_lock_bh()
+ * section, which keeps the caller on the CPU and the bottom halves of the
+ * CPU off the cache. Deregistration waits for these sections to finish
+ * before it empties the caches.
+ *
+ * Only the first QDF_MAX_AVAILABLE_CPU CPUs have a cache, a CPU past them
+ * would have to share one with another CPU, so it goes straight to the
+ * locked pool instead.
+ *
+ * Return: per CPU cache, NULL if the current CPU has none
+ */
+static inline struct wbuff_pcpu_cache *
+wbuff_pcpu_cache(struct wbuff_module *mod, uint8_t pslot)
+{
+	int cpu = qdf_get_cpu();
+
+	if (qdf_unlikely(cpu >= QDF_MAX_AVAILABLE_CPU))
+		return NULL;
+
+	return &mod->pcpu[cpu][pslot];
+}
+
+/**
+ * wbuff_pcpu_init() - initialize the per CPU caches
+ * @mod: wbuff module
+ *
+ * Return: None
+ */
+static void wbuff_pcpu_init(struct wbuff_module *mod)
+{
+	qdf_mem_zero(mod->pcpu, sizeof(mod->pcpu));
+}
+
+/**
+ * wbuff_pcpu_pop() - take a buffer from the cache of the current CPU
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Return: nbuf if the cache was not empty
+ *         NULL otherwise
+ */
+static qdf_nbuf_t wbuff_pcpu_pop(struct wbuff_module *mod, uint8_t pslot)
+{
+	struct wbuff_pcpu_cache *cache;
+	qdf_nbuf_t buf = NULL;
+
+	qdf_rcu_read_lock_bh();
+	cache = wbuff_pcpu_cache(mod, pslot);
+	if (cache && mod->registered && cache->head) {
+		buf = cache->head;
+		cache->head = qdf_nbuf_next(buf);
+		cache->count--;
+		cache->hit++;
+	}
+	qdf_rcu_read_unlock_bh();
+
+	return buf;
+}
+
+/**
+ * wbuff_pcpu_push() - put a buffer in the cache of the current CPU
+ * @mod: registered module
+ * @pslot: pool slot
+ * @buf: buffer being returned
+ *
+ * Return: true if the buffer was consumed by the cache
+ */
+static bool wbuff_pcpu_push(struct wbuff_module *mod, uint8_t pslot,
+			    qdf_nbuf_t buf)
+{
+	struct wbuff_pcpu_cache *cache;
+	bool cached = false;
+
+	qdf_rcu_read_lock_bh();
+	cache = wbuff_pcpu_cache(mod, pslot);
+	if (cache && mod->registered && cache->count < WBUFF_PCPU_CACHE_MAX) {
+		qdf_nbuf_set_next(buf, cache->head);
+		cache->head = buf;
+		cache->count++;
+		cached = true;
+	}
+	qdf_rcu_read_unlock_bh();
+
+	return cached;
+}
+
+/**
+ * wbuff_pcpu_drain() - free the buffers held in the per CPU caches
+ * @mod: module being deregistered
+ *
+ * Called once @mod is no longer registered. A buffer taken or returned
+ * on another CPU may still be going through a cache at that point, so the
+ * caches are emptied, under the module lock, only once all the cache
+ * accesses in progress are over.
+ *
+ * Return: None
+ */
+static void wbuff_pcpu_drain(struct wbuff_module *mod)
+{
+	struct wbuff_pcpu_cache *cache;
+	qdf_nbuf_t first = NULL, buf;
+	uint8_t cpu, pslot;
+
+	qdf_synchronize_rcu_bh();
+
+	qdf_spin_lock_bh(&mod->lock);
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++) {
+			cache = &mod->pcpu[cpu][pslot];
+			if (!cache->head)
+				continue;
+
+			for (buf = cache->head; qdf_nbuf_next(buf);
+			     buf = qdf_nbuf_next(buf))
+				;
+			qdf_nbuf_set_next(buf, first);
+			first = cache->head;
+			cache->head = NULL;
+			cache->count = 0;
+		}
+	}
+	qdf_spin_unlock_bh(&mod->lock);
+
+	while (first) {
+		buf = first;
+		first = qdf_nbuf_next(buf);
+		qdf_nbuf_free(buf);
+	}
+}
+
+/**
+ * wbuff_pcpu_hits() - number of requests served by the per CPU caches
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Return: sum of the cache hits over all CPUs
+ */
+static uint32_t wbuff_pcpu_hits(struct wbuff_module *mod, uint8_t pslot)
+{
+	uint32_t hits = 0;
+	uint8_t cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		hits += mod->pcpu[cpu][pslot].hit;
+
+	return hits;
+}
+
+/**
+ * wbuff_pcpu_clear_hits() - reset the hit counters of the per CPU caches
+ * @mod: wbuff module
+ *
+ * Return: None
+ */
+static void wbuff_pcpu_clear_hits(struct wbuff_module *mod)
+{
+	uint8_t cpu, pslot;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++)
+			mod->pcpu[cpu][pslot].hit = 0;
+}
+
+/**
+ * wbuff_pool_ctl_init() - initialize the size control of a pool
+ * @mod: registered module
+ * @pslot: pool slot
+ * @base: number of buffers requested for the pool
+ * @total: number of buffers allocated for the pool
+ *
+ * Return: None
+ */
+static void wbuff_pool_ctl_init(struct wbuff_module *mod, uint8_t pslot,
+				uint16_t base, uint16_t total)
+{
+	struct wbuff_pool_ctl *ctl = &mod->ctl[pslot];
+
+	qdf_atomic_init(&ctl->outstanding);
+	ctl->base = base;
+	ctl->target = base;
+	ctl->total = total;
+	ctl->window_peak = 0;
+	ctl->window_ops = 0;
+}
+
+/**
+ * wbuff_pool_adapt() - update the pool target from the observed demand
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Called with the module lock held on every shared pool operation. Once
+ * per WBUFF_ADAPT_WINDOW operations the target is set to the peak number
+ * of outstanding buffers of the window plus a quarter, bounded by the
+ * registered pool size and the pool max.
+ *
+ * Return: None
+ */
+static void wbuff_pool_adapt(struct wbuff_module *mod, uint8_t pslot)
+{
+	struct wbuff_pool_ctl *ctl = &mod->ctl[pslot];
+	uint16_t target;
+
+	if (++ctl->window_ops < WBUFF_ADAPT_WINDOW)
+		return;
+
+	target = ctl->window_peak + (ctl->window_peak >> 2);
+	if (target < ctl->base)
+		target = ctl->base;
+	ctl->target = qdf_min(target, wbuff_alloc_max[pslot]);
+	ctl->window_peak = qdf_atomic_read(&ctl->outstanding);
+	ctl->window_ops = 0;
+}
+
+/**
+ * wbuff_pool_track_get() - account a buffer given to the module
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Return: None
+ */
+static inline void wbuff_pool_track_get(struct wbuff_module *mod,
+					uint8_t pslot)
+{
+	struct wbuff_pool_ctl *ctl = &mod->ctl[pslot];
+	int32_t outstanding = qdf_atomic_inc_return(&ctl->outstanding);
+
+	if (outstanding > ctl->window_peak)
+		ctl->window_peak = outstanding;
+}
+
+/**
+ * wbuff_pool_track_put() - account a buffer returned by the module
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Return: None
+ */
+static inline void wbuff_pool_track_put(struct wbuff_module *mod,
+					uint8_t pslot)
+{
+	qdf_atomic_dec(&mod->ctl[pslot].outstanding);
+}
+
+/**
+ * wbuff_pool_grow_reserve() - reserve a new buffer for an empty pool
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Called with the module lock held.
+ *
+ * Return: true if the pool is below its target and may grow
+ */
+static bool wbuff_pool_grow_reserve(struct wbuff_module *mod, uint8_t pslot)
+{
+	struct wbuff_pool_ctl *ctl = &mod->ctl[pslot];
+
+	if (ctl->total >= ctl->target)
+		return false;
+
+	ctl->total++;
+	mod->pending_returns++;
+
+	return true;
+}
+
+/**
+ * wbuff_pool_grow() - allocate the buffer reserved by wbuff_pool_grow_reserve
+ * @mod: registered module
+ * @mslot: module slot
+ * @pslot: pool slot
+ *
+ * Return: nbuf if success
+ *         NULL if failure
+ */
+static qdf_nbuf_t wbuff_pool_grow(struct wbuff_module *mod, uint8_t mslot,
+				  uint8_t pslot)
+{
+	qdf_nbuf_t buf;
+
+	buf = wbuff_prepare_nbuf(mslot, pslot,
+				 wbuff_get_len_from_pool_slot(pslot),
+				 mod->reserve, mod->align);
+
+	qdf_spin_lock_bh(&mod->lock);
+	if (buf) {
+		mod->stats[pslot].grow++;
+	} else {
+		mod->ctl[pslot].total--;
+		mod->pending_returns--;
+		mod->stats[pslot].miss++;
+	}
+	qdf_spin_unlock_bh(&mod->lock);
+
+	return buf;
+}
+
+/**
+ * wbuff_pool_shrink() - check if a returned buffer is to be released
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Called with the module lock held.
+ *
+ * Return: true if the pool is above its target and the buffer is to be freed
+ */
+static bool wbuff_pool_shrink(struct wbuff_module *mod, uint8_t pslot)
+{
+	struct wbuff_pool_ctl *ctl = &mod->ctl[pslot];
+
+	if (ctl->total <= ctl->target)
+		return false;
+
+	ctl->total--;
+	mod->stats[pslot].shrink++;
+
+	return true;
+}
+
+/**
+ * wbuff_display_pool_ctl() - print the size control of a pool
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Return: None
+ */
+static void wbuff_display_pool_ctl(struct wbuff_module *mod, uint8_t pslot)
+{
+	struct wbuff_pool_ctl *ctl = &mod->ctl[pslot];
+
+	qdf_nofl_info("    base %u target %u total %u outstanding %d peak %u",
+		      ctl->base, ctl->target, ctl->total,
+		      qdf_atomic_read(&ctl->outstanding), ctl->window_peak);
+}
+#else
+static inline void wbuff_pcpu_init(struct wbuff_module *mod)
+{
+}
+
+static inline qdf_nbuf_t wbuff_pcpu_pop(struct wbuff_module *mod,
+					uint8_t pslot)
+{
+	return NULL;
+}
+
+static inline bool wbuff_pcpu_push(struct wbuff_module *mod, uint8_t pslot,
+				   qdf_nbuf_t buf)
+{
+	return false;
+}
+
+static inline void wbuff_pcpu_drain(struct wbuff_module *mod)
+{
+}
+
+static inline uint32_t wbuff_pcpu_hits(struct wbuff_module *mod,
+				       uint8_t pslot)
+{
+	return 0;
+}
+
+static inline void wbuff_pcpu_clear_hits(struct wbuff_module *mod)
+{
+}
+
+static inline void wbuff_pool_ctl_init(struct wbuff_module *mod,
+				       uint8_t pslot, uint16_t base,
+				       uint16_t total)
+{
+}
+
+static inline void wbuff_pool_adapt(struct wbuff_module *mod, uint8_t pslot)
+{
+}
+
+static inline void wbuff_pool_track_get(struct wbuff_module *mod,
+					uint8_t pslot)
+{
+}
+
+static inline void wbuff_pool_track_put(struct wbuff_module *mod,
+					uint8_t pslot)
+{
+}
+
+static inline bool wbuff_pool_grow_reserve(struct wbuff_module *mod,
+					   uint8_t pslot)
+{
+	return false;
+}
+
+static inline qdf_nbuf_t wbuff_pool_grow(struct wbuff_module *mod,
+					 uint8_t mslot, uint8_t pslot)
+{
+	return NULL;
+}
+
+static inline bool wbuff_pool_shrink(struct wbuff_module *mod, uint8_t pslot)
+{
+	return false;
+}
+
+static inline void wbuff_display_pool_ctl(struct wbuff_module *mod,
+					  uint8_t pslot)
+{
+}
+#endif /* WLAN_FEATURE_WBUFF_PCPU */
+
 /**
  * wbuff_is_valid_handle() - validate wbuff handle
  * @handle: wbuff handle passed by module
@@ -185,7 +584,9 @@ QDF_STATUS wbuff_module_init(void)
 		qdf_spinlock_create(&mod->lock);
 		for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++)
 			mod->pool[pslot] = NULL;
+		wbuff_pcpu_init(mod);
 		mod->registered = false;
+		mod->draining = false;
 	}
 	wbuff.initialized = true;
 
@@ -219,7 +620,7 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num,
 	struct wbuff_module *mod = NULL;
 	qdf_nbuf_t buf = NULL;
 	uint32_t len = 0;
-	uint16_t idx = 0, psize = 0;
+	uint16_t idx = 0, psize = 0, count = 0;
 	uint8_t alloc = 0, mslot = 0, pslot = 0;
 
 	if (!wbuff.initialized)
@@ -238,6 +639,8 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num,
 	mod = &wbuff.mod[mslot];
 
 	mod->handle.id = mslot;
+	mod->pending_returns = 0;
+	qdf_mem_zero(mod->stats, sizeof(mod->stats));
 
 	for (alloc = 0; alloc < num; alloc++) {
 		pslot = req[alloc].slot;
@@ -247,7 +650,7 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num,
 		 * Allocate pool_cnt number of buffers for
 		 * the pool given by pslot
 		 */
-		for (idx = 0; idx < psize; idx++) {
+		for (idx = 0, count = 0; idx < psize; idx++) {
 			buf = wbuff_prepare_nbuf(mslot, pslot, len, reserve,
 						 align);
 			if (!buf)
@@ -259,7 +662,9 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num,
 				qdf_nbuf_set_next(buf, mod->pool[pslot]);
 				mod->pool[pslot] = buf;
 			}
+			count++;
 		}
+		wbuff_pool_ctl_init(mod, pslot, psize, count);
 	}
 	mod->reserve = reserve;
 	mod->align = align;
@@ -290,8 +695,16 @@ QDF_STATUS wbuff_module_deregister(struct wbuff_mod_handle *hdl)
 			first = qdf_nbuf_next(buf);
 			qdf_nbuf_free(buf);
 		}
+		mod->pool[pslot] = NULL;
 	}
 	mod->registered = false;
+	mod->draining = true;
+	qdf_spin_unlock_bh(&mod->lock);
+
+	wbuff_pcpu_drain(mod);
+
+	qdf_spin_lock_bh(&mod->lock);
+	mod->draining = false;
 	qdf_spin_unlock_bh(&mod->lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -305,6 +718,7 @@ qdf_nbuf_t wbuff_buff_get(struct wbuff_mod_handle *hdl, uint32_t len,
 	uint8_t mslot = 0;
 	uint8_t pslot = 0;
 	qdf_nbuf_t buf = NULL;
+	bool grow = false;
 
 	handle = (struct wbuff_handle *)hdl;
 
@@ -316,14 +730,28 @@ qdf_nbuf_t wbuff_buff_get(struct wbuff_mod_handle *hdl, uint32_t len,
 	pslot = wbuff_get_pool_slot_from_len(len);
 	mod = &wbuff.mod[mslot];
 
-	qdf_spin_lock_bh(&mod->lock);
-	if (mod->pool[pslot]) {
-		buf = mod->pool[pslot];
-		mod->pool[pslot] = qdf_nbuf_next(buf);
-		mod->pending_returns++;
+	buf = wbuff_pcpu_pop(mod, pslot);
+	if (!buf) {
+		qdf_spin_lock_bh(&mod->lock);
+		if (mod->pool[pslot]) {
+			buf = mod->pool[pslot];
+			mod->pool[pslot] = qdf_nbuf_next(buf);
+			mod->pending_returns++;
+			mod->stats[pslot].hit++;
+		} else if (wbuff_pool_grow_reserve(mod, pslot)) {
+			grow = true;
+		} else {
+			mod->stats[pslot].miss++;
+		}
+		wbuff_pool_adapt(mod, pslot);
+		qdf_spin_unlock_bh(&mod->lock);
+
+		if (grow)
+			buf = wbuff_pool_grow(mod, mslot, pslot);
 	}
-	qdf_spin_unlock_bh(&mod->lock);
+
 	if (buf) {
+		wbuff_pool_track_get(mod, pslot);
 		qdf_nbuf_set_next(buf, NULL);
 		qdf_net_buf_debug_update_node(buf, func_name, line_num);
 	}
@@ -333,9 +761,11 @@ qdf_nbuf_t wbuff_buff_get(struct wbuff_mod_handle *hdl, uint32_t len,
 
 qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf)
 {
+	struct wbuff_module *mod;
 	qdf_nbuf_t buffer = buf;
 	unsigned long slot_info = 0;
 	uint8_t mslot = 0, pslot = 0;
+	bool release = false;
 
 	if (!wbuff.initialized)
 		return buffer;
@@ -350,16 +780,72 @@ qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf)
 	if (mslot >= WBUFF_MAX_MODULES || pslot >= WBUFF_MAX_POOLS)
 		return NULL;
 
-	qdf_nbuf_reset(buffer, wbuff.mod[mslot].reserve, wbuff.mod[mslot].
-		       align);
-	qdf_spin_lock_bh(&wbuff.mod[mslot].lock);
-	if (wbuff.mod[mslot].registered) {
-		qdf_nbuf_set_next(buffer, wbuff.mod[mslot].pool[pslot]);
-		wbuff.mod[mslot].pool[pslot] = buffer;
-		wbuff.mod[mslot].pending_returns--;
+	mod = &wbuff.mod[mslot];
+	qdf_nbuf_reset(buffer, mod->reserve, mod->align);
+	wbuff_pool_track_put(mod, pslot);
+	if (wbuff_pcpu_push(mod, pslot, buffer))
+		return NULL;
+
+	qdf_spin_lock_bh(&mod->lock);
+	if (mod->registered) {
+		mod->pending_returns--;
+		if (wbuff_pool_shrink(mod, pslot)) {
+			release = true;
+		} else {
+			qdf_nbuf_set_next(buffer, mod->pool[pslot]);
+			mod->pool[pslot] = buffer;
+		}
+		wbuff_pool_adapt(mod, pslot);
 		buffer = NULL;
 	}
-	qdf_spin_unlock_bh(&wbuff.mod[mslot].lock);
+	qdf_spin_unlock_bh(&mod->lock);
+
+	if (release)
+		qdf_nbuf_free(buf);
 
 	return buffer;
 }
+
+void wbuff_display_stats(void)
+{
+	struct wbuff_module *mod;
+	struct wbuff_pool_stats *stats;
+	uint8_t mslot, pslot;
+
+	if (!wbuff.initialized)
+		return;
+
+	for (mslot = 0; mslot < WBUFF_MAX_MODULES; mslot++) {
+		mod = &wbuff.mod[mslot];
+		if (!mod->registered)
+			continue;
+
+		qdf_nofl_info("wbuff module %u: pending_returns %u",
+			      mslot, mod->pending_returns);
+		for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++) {
+			stats = &mod->stats[pslot];
+			qdf_nofl_info("  pool %u (%u B): hit %u pcpu_hit %u miss %u grow %u shrink %u",
+				      pslot, wbuff_get_len_from_pool_slot(pslot),
+				      stats->hit, wbuff_pcpu_hits(mod, pslot),
+				      stats->miss, stats->grow, stats->shrink);
+			wbuff_display_pool_ctl(mod, pslot);
+		}
+	}
+}
+
+void wbuff_clear_stats(void)
+{
+	struct wbuff_module *mod;
+	uint8_t mslot;
+
+	if (!wbuff.initialized)
+		return;
+
+	for (mslot = 0; mslot < WBUFF_MAX_MODULES; mslot++) {
+		mod = &wbuff.mod[mslot];
+		qdf_spin_lock_bh(&mod->lock);
+		qdf_mem_zero(mod->stats, sizeof(mod->stats));
+		qdf_spin_unlock_bh(&mod->lock);
+		wbuff_pcpu_clear_hits(mod);
+	}
+}
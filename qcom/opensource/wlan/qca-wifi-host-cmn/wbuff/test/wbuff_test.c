@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_nbuf.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_util.h"
+#include "wbuff.h"
+#include "wbuff_test.h"
+
+#define ut_wbuff_small_len 200
+#define ut_wbuff_small_cnt 16
+#define ut_wbuff_large_len 2000
+#define ut_wbuff_large_cnt 4
+#define ut_wbuff_headroom 64
+#define ut_wbuff_batch 8
+#define ut_wbuff_iterations 4096
+
+static uint32_t wbuff_ut_contract(struct wbuff_mod_handle *hdl)
+{
+	qdf_nbuf_t bufs[ut_wbuff_large_cnt * 4];
+	uint32_t errors = 0;
+	uint32_t num = 0;
+	qdf_nbuf_t buf;
+
+	buf = wbuff_buff_get(hdl, ut_wbuff_small_len, __func__, __LINE__);
+	if (!buf) {
+		qdf_nofl_alert("FAIL: no buffer for %u bytes",
+			       ut_wbuff_small_len);
+		return 1;
+	}
+
+	if (qdf_nbuf_headroom(buf) < ut_wbuff_headroom) {
+		qdf_nofl_alert("FAIL: headroom %u", qdf_nbuf_headroom(buf));
+		errors++;
+	}
+
+	buf = wbuff_buff_put(buf);
+	if (buf) {
+		qdf_nofl_alert("FAIL: buffer not taken back");
+		qdf_nbuf_free(buf);
+		errors++;
+	}
+
+	buf = wbuff_buff_get(hdl, 0, __func__, __LINE__);
+	if (buf) {
+		qdf_nofl_alert("FAIL: buffer for 0 bytes");
+		wbuff_buff_put(buf);
+		errors++;
+	}
+
+	/* drain the large pool; it may grow but never beyond its max */
+	while (num < QDF_ARRAY_SIZE(bufs)) {
+		bufs[num] = wbuff_buff_get(hdl, ut_wbuff_large_len, __func__,
+					   __LINE__);
+		if (!bufs[num])
+			break;
+		num++;
+	}
+
+	if (num < ut_wbuff_large_cnt || num == QDF_ARRAY_SIZE(bufs)) {
+		qdf_nofl_alert("FAIL: %u large buffers handed out", num);
+		errors++;
+	}
+
+	while (num--) {
+		buf = wbuff_buff_put(bufs[num]);
+		if (buf) {
+			qdf_nofl_alert("FAIL: large buffer not taken back");
+			qdf_nbuf_free(buf);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+static uint32_t wbuff_ut_stress(struct wbuff_mod_handle *hdl)
+{
+	qdf_nbuf_t bufs[ut_wbuff_batch];
+	uint64_t start, wbuff_ticks, nbuf_ticks;
+	uint32_t fallback = 0;
+	uint32_t i, j;
+
+	start = qdf_get_log_timestamp();
+	for (i = 0; i < ut_wbuff_iterations; i++) {
+		for (j = 0; j < ut_wbuff_batch; j++) {
+			bufs[j] = wbuff_buff_get(hdl, ut_wbuff_small_len,
+						 __func__, __LINE__);
+			if (!bufs[j]) {
+				bufs[j] = qdf_nbuf_alloc(NULL,
+							 ut_wbuff_small_len +
+							 ut_wbuff_headroom,
+							 ut_wbuff_headroom, 4,
+							 false);
+				fallback++;
+			}
+		}
+		for (j = 0; j < ut_wbuff_batch; j++) {
+			if (bufs[j] && wbuff_buff_put(bufs[j]))
+				qdf_nbuf_free(bufs[j]);
+		}
+	}
+	wbuff_ticks = qdf_get_log_timestamp() - start;
+
+	start = qdf_get_log_timestamp();
+	for (i = 0; i < ut_wbuff_iterations; i++) {
+		for (j = 0; j < ut_wbuff_batch; j++)
+			bufs[j] = qdf_nbuf_alloc(NULL, ut_wbuff_small_len +
+						 ut_wbuff_headroom,
+						 ut_wbuff_headroom, 4, false);
+		for (j = 0; j < ut_wbuff_batch; j++) {
+			if (bufs[j])
+				qdf_nbuf_free(bufs[j]);
+		}
+	}
+	nbuf_ticks = qdf_get_log_timestamp() - start;
+
+	qdf_nofl_info("wbuff: %u x %u allocs, wbuff %llu ns/alloc (%u fallback), nbuf %llu ns/alloc",
+		      ut_wbuff_iterations, ut_wbuff_batch,
+		      qdf_do_div(qdf_log_timestamp_to_usecs(wbuff_ticks) * 1000,
+				 ut_wbuff_iterations * ut_wbuff_batch),
+		      fallback,
+		      qdf_do_div(qdf_log_timestamp_to_usecs(nbuf_ticks) * 1000,
+				 ut_wbuff_iterations * ut_wbuff_batch));
+
+	if (fallback) {
+		qdf_nofl_alert("FAIL: %u allocations missed the pool",
+			       fallback);
+		return 1;
+	}
+
+	return 0;
+}
+
+uint32_t wbuff_unit_test(void)
+{
+	struct wbuff_alloc_request req[2] = {
+		{ .slot = WBUFF_POOL_0, .size = ut_wbuff_small_cnt },
+		{ .slot = WBUFF_POOL_3, .size = ut_wbuff_large_cnt },
+	};
+	struct wbuff_mod_handle *hdl;
+	uint32_t errors = 0;
+
+	hdl = wbuff_module_register(req, QDF_ARRAY_SIZE(req),
+				    ut_wbuff_headroom, 4);
+	if (!hdl) {
+		qdf_nofl_alert("FAIL: wbuff module registration");
+		return 1;
+	}
+
+	errors += wbuff_ut_contract(hdl);
+	errors += wbuff_ut_stress(hdl);
+	wbuff_display_stats();
+
+	if (QDF_IS_STATUS_ERROR(wbuff_module_deregister(hdl))) {
+		qdf_nofl_alert("FAIL: wbuff module deregistration");
+		errors++;
+	}
+
+	return errors;
+}
@@ -450,6 +450,14 @@
 #define WLAN_CFG_MLO_RX_RING_MAP_MAX 0xFF
 #endif
 
+#define WLAN_CFG_SWLM_LATENCY_SLO 1000
+#define WLAN_CFG_SWLM_LATENCY_SLO_MIN 100
+#define WLAN_CFG_SWLM_LATENCY_SLO_MAX 10000
+
+#define WLAN_CFG_LAT_TRACE_SAMPLE_RATE 0
+#define WLAN_CFG_LAT_TRACE_SAMPLE_RATE_MIN 0
+#define WLAN_CFG_LAT_TRACE_SAMPLE_RATE_MAX 65535
+
 #define CFG_DP_MPDU_RETRY_THRESHOLD_MIN 0
 #define CFG_DP_MPDU_RETRY_THRESHOLD_MAX 255
 #define CFG_DP_MPDU_RETRY_THRESHOLD 0
@@ -1200,6 +1208,54 @@
 #define CFG_DP_SWLM_ENABLE \
 	CFG_INI_BOOL("gEnableSWLM", false, \
 		     "Enable/Disable DP SWLM")
+
+/*
+ * <ini>
+ * dp_swlm_latency_slo - Max latency in us SWLM may add to a TX frame
+ * @Min: 100
+ * @Max: 10000
+ * @Default: 1000
+ *
+ * This ini bounds the TCL register write coalescing window chosen by the
+ * adaptive DP Software latency manager.
+ *
+ * Supported Feature: STA,P2P and SAP IPA disabled terminating
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_SWLM_LATENCY_SLO \
+		CFG_INI_UINT("dp_swlm_latency_slo", \
+		WLAN_CFG_SWLM_LATENCY_SLO_MIN, \
+		WLAN_CFG_SWLM_LATENCY_SLO_MAX, \
+		WLAN_CFG_SWLM_LATENCY_SLO, \
+		CFG_VALUE_OR_DEFAULT, "DP SWLM latency SLO")
+
+/*
+ * <ini>
+ * dp_lat_trace_sample_rate - Sample rate of DP stage latency tracing
+ * @Min: 0
+ * @Max: 65535
+ * @Default: 0
+ *
+ * One out of every this many packets is time stamped at each data path
+ * stage from HDD to the TX completion and from the REO ring to the
+ * network stack, feeding per stage latency histograms. 0 disables the
+ * tracing.
+ *
+ * Supported Feature: STA,P2P and SAP IPA disabled terminating
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_LAT_TRACE_SAMPLE_RATE \
+		CFG_INI_UINT("dp_lat_trace_sample_rate", \
+		WLAN_CFG_LAT_TRACE_SAMPLE_RATE_MIN, \
+		WLAN_CFG_LAT_TRACE_SAMPLE_RATE_MAX, \
+		WLAN_CFG_LAT_TRACE_SAMPLE_RATE, \
+		CFG_VALUE_OR_DEFAULT, "DP stage latency trace sample rate")
 /*
  * <ini>
  * wow_check_rx_pending_enable - control to check RX frames pending in Wow
@@ -1613,6 +1669,8 @@
 		CFG(CFG_DP_LEGACY_MODE_CSUM_DISABLE) \
 		CFG(CFG_DP_POLL_MODE_ENABLE) \
 		CFG(CFG_DP_SWLM_ENABLE) \
+		CFG(CFG_DP_SWLM_LATENCY_SLO) \
+		CFG(CFG_DP_LAT_TRACE_SAMPLE_RATE) \
 		CFG(CFG_DP_TX_PER_PKT_VDEV_ID_CHECK) \
 		CFG(CFG_DP_RX_FST_IN_CMEM) \
 		CFG(CFG_DP_RX_RADIO_0_DEFAULT_REO) \
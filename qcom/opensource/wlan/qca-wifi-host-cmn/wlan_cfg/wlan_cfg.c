@@ -1991,6 +1991,9 @@ wlan_cfg_soc_attach(struct cdp_ctrl_objmgr_psoc *psoc)
 	wlan_cfg_ctx->is_poll_mode_enabled =
 			cfg_get(psoc, CFG_DP_POLL_MODE_ENABLE);
 	wlan_cfg_ctx->is_swlm_enabled = cfg_get(psoc, CFG_DP_SWLM_ENABLE);
+	wlan_cfg_ctx->swlm_latency_slo = cfg_get(psoc, CFG_DP_SWLM_LATENCY_SLO);
+	wlan_cfg_ctx->lat_trace_sample_rate =
+			cfg_get(psoc, CFG_DP_LAT_TRACE_SAMPLE_RATE);
 	wlan_cfg_ctx->fst_in_cmem = cfg_get(psoc, CFG_DP_RX_FST_IN_CMEM);
 	wlan_cfg_ctx->tx_per_pkt_vdev_id_check =
 			cfg_get(psoc, CFG_DP_TX_PER_PKT_VDEV_ID_CHECK);
@@ -2963,12 +2966,29 @@ bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return (bool)(cfg->is_swlm_enabled);
 }
+
+uint32_t wlan_cfg_get_swlm_latency_slo(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->swlm_latency_slo;
+}
 #else
 bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return false;
 }
+
+uint32_t wlan_cfg_get_swlm_latency_slo(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return WLAN_CFG_SWLM_LATENCY_SLO;
+}
 #endif
+
+uint32_t
+wlan_cfg_get_lat_trace_sample_rate(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->lat_trace_sample_rate;
+}
+
 uint8_t wlan_cfg_radio0_default_reo_get(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return cfg->radio0_rx_default_reo;
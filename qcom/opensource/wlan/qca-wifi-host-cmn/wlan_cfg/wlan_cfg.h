@@ -229,6 +229,8 @@ struct wlan_srng_cfg {
  * @rx_pending_high_threshold: threshold of starting pkt drop
  * @rx_pending_low_threshold: threshold of stopping pkt drop
  * @is_swlm_enabled: flag to enable/disable SWLM
+ * @swlm_latency_slo: max latency in us SWLM may add to a TX frame
+ * @lat_trace_sample_rate: DP stage latency trace sample rate, 0 to disable
  * @tx_per_pkt_vdev_id_check: Enable tx perpkt vdev id check
  * @wow_check_rx_pending_enable: Enable RX frame pending check in WoW
  * @ipa_tx_ring_size: IPA tx ring size
@@ -370,6 +372,8 @@ struct wlan_cfg_dp_soc_ctxt {
 	uint32_t rx_pending_low_threshold;
 	bool is_poll_mode_enabled;
 	uint8_t is_swlm_enabled;
+	uint32_t swlm_latency_slo;
+	uint32_t lat_trace_sample_rate;
 	bool fst_in_cmem;
 	bool tx_per_pkt_vdev_id_check;
 	uint8_t radio0_rx_default_reo;
@@ -1737,6 +1741,24 @@ bool wlan_cfg_is_fst_in_cmem_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
  */
 bool wlan_cfg_is_swlm_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
 
+/**
+ * wlan_cfg_get_swlm_latency_slo() - Get SWLM latency SLO
+ * @cfg: soc configuration context
+ *
+ * Return: max latency in us SWLM may add to a TX frame
+ */
+uint32_t wlan_cfg_get_swlm_latency_slo(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_get_lat_trace_sample_rate() - Get DP stage latency trace sample
+ * rate
+ * @cfg: soc configuration context
+ *
+ * Return: one out of this many packets is traced, 0 if tracing is disabled
+ */
+uint32_t
+wlan_cfg_get_lat_trace_sample_rate(struct wlan_cfg_dp_soc_ctxt *cfg);
+
 #ifdef IPA_OFFLOAD
 /*
  * wlan_cfg_ipa_tx_ring_size - Get Tx DMA ring size (TCL Data Ring)
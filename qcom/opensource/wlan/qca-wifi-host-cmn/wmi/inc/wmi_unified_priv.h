@@ -289,6 +289,8 @@ struct wmi_command_header {
  * @ p_buf_tail_idx - refernce to buffer tail index. It is added to accommodate
  * unified design since MCL uses global variable for buffer tail index
  * @ size - the size of the buffer in number of entries
+ * @ record_idx - number of records reserved since the last reset, used to
+ * hand out slots without holding wmi_record_lock
  */
 struct wmi_log_buf_t {
 	void *buf;
@@ -296,6 +298,9 @@ struct wmi_log_buf_t {
 	uint32_t buf_tail_idx;
 	uint32_t *p_buf_tail_idx;
 	uint32_t size;
+#ifdef WMI_INTERFACE_LOCKLESS_LOGGING
+	qdf_atomic_t record_idx;
+#endif
 };
 
 /**
@@ -311,7 +316,8 @@ struct wmi_log_buf_t {
  * Command Tx completion log
  * @wmi_mgmt_event_log_buf_info - Buffer info for WMI Management event log
  * @wmi_diag_event_log_buf_info - Buffer info for WMI diag event log
- * @wmi_record_lock - Lock WMI recording
+ * @wmi_record_lock - Lock WMI recording, not taken by the record paths
+ * with WMI_INTERFACE_LOCKLESS_LOGGING
  * @wmi_logging_enable - Enable/Disable state for WMI logging
  * @wmi_id_to_name - Function refernce to API to convert Command id to
  * string name
@@ -351,6 +357,147 @@ struct wmi_debug_log_info {
 #endif
 };
 
+#ifdef WMI_INTERFACE_LOCKLESS_LOGGING
+/**
+ * wmi_log_buf_reserve() - reserve the next slot of a WMI log buffer
+ * @log_buf: log buffer to record into
+ * @max_entry: number of entries in the log buffer
+ *
+ * The slot is handed out by an atomic increment so that concurrent command,
+ * completion and event paths never serialize on wmi_record_lock. The tail
+ * index and length are only published for the readers, which may observe
+ * a record while it is being written.
+ *
+ * Return: index of the slot to fill
+ */
+static inline uint32_t wmi_log_buf_reserve(struct wmi_log_buf_t *log_buf,
+					   uint32_t max_entry)
+{
+	uint32_t count = qdf_atomic_inc_return(&log_buf->record_idx);
+	uint32_t idx = (count - 1) % max_entry;
+
+	*log_buf->p_buf_tail_idx = idx + 1;
+	log_buf->length = count;
+
+	return idx;
+}
+
+/**
+ * wmi_log_buf_reset() - drop all the records of a WMI log buffer
+ * @log_buf: log buffer to reset
+ *
+ * Return: None
+ */
+static inline void wmi_log_buf_reset(struct wmi_log_buf_t *log_buf)
+{
+	qdf_atomic_set(&log_buf->record_idx, 0);
+	log_buf->length = 0;
+	*log_buf->p_buf_tail_idx = 0;
+}
+
+static inline void wmi_log_record_lock(struct wmi_debug_log_info *log_info)
+{
+}
+
+static inline void wmi_log_record_unlock(struct wmi_debug_log_info *log_info)
+{
+}
+#else
+/**
+ * wmi_log_buf_reserve() - reserve the next slot of a WMI log buffer
+ * @log_buf: log buffer to record into
+ * @max_entry: number of entries in the log buffer
+ *
+ * Caller must hold wmi_record_lock.
+ *
+ * Return: index of the slot to fill
+ */
+static inline uint32_t wmi_log_buf_reserve(struct wmi_log_buf_t *log_buf,
+					   uint32_t max_entry)
+{
+	if (max_entry <= *log_buf->p_buf_tail_idx)
+		*log_buf->p_buf_tail_idx = 0;
+
+	log_buf->length++;
+
+	return (*log_buf->p_buf_tail_idx)++;
+}
+
+/**
+ * wmi_log_buf_reset() - drop all the records of a WMI log buffer
+ * @log_buf: log buffer to reset
+ *
+ * Caller must hold wmi_record_lock.
+ *
+ * Return: None
+ */
+static inline void wmi_log_buf_reset(struct wmi_log_buf_t *log_buf)
+{
+	log_buf->length = 0;
+	*log_buf->p_buf_tail_idx = 0;
+}
+
+/**
+ * wmi_log_record_lock() - serialize access to the WMI log buffers
+ * @log_info: WMI log buffers
+ *
+ * Return: None
+ */
+static inline void wmi_log_record_lock(struct wmi_debug_log_info *log_info)
+{
+	qdf_spin_lock_bh(&log_info->wmi_record_lock);
+}
+
+/**
+ * wmi_log_record_unlock() - release the WMI log buffers
+ * @log_info: WMI log buffers
+ *
+ * Return: None
+ */
+static inline void wmi_log_record_unlock(struct wmi_debug_log_info *log_info)
+{
+	qdf_spin_unlock_bh(&log_info->wmi_record_lock);
+}
+#endif /* WMI_INTERFACE_LOCKLESS_LOGGING */
+
+#define WMI_LOG_BIN_MAGIC 0x474c4d57
+#define WMI_LOG_BIN_VERSION 1
+
+/**
+ * struct wmi_log_bin_hdr - header of the binary WMI history export
+ * @magic: WMI_LOG_BIN_MAGIC
+ * @version: WMI_LOG_BIN_VERSION
+ * @num_bufs: number of log buffers following the header
+ * @ts_now: log timestamp when the export was taken
+ * @ts_now_usecs: @ts_now converted to microseconds, to scale record times
+ */
+struct wmi_log_bin_hdr {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t num_bufs;
+	uint64_t ts_now;
+	uint64_t ts_now_usecs;
+} qdf_packed;
+
+/**
+ * struct wmi_log_bin_buf_hdr - header of one log buffer in the binary export
+ * @id: position of the buffer in struct wmi_debug_log_info
+ * @entry_size: size of one record of the buffer
+ * @size: number of records following the header
+ * @tail: index the next record will be written to
+ * @length: number of records written since the last reset
+ *
+ * The records are dumped raw in ring order, struct wmi_command_debug,
+ * struct wmi_command_cmp_debug or struct wmi_event_debug by @entry_size.
+ */
+struct wmi_log_bin_buf_hdr {
+	uint32_t id;
+	uint32_t entry_size;
+	uint32_t size;
+	uint32_t tail;
+	uint32_t length;
+} qdf_packed;
+
 /**
  * enum WMI_RECORD_TYPE - User specified WMI logging types
  * @ WMI_CMD - wmi command id
@@ -2936,9 +3083,9 @@ struct wmi_host_abi_version {
 /* number of debugfs entries used */
 #ifdef WMI_INTERFACE_FILTERED_EVENT_LOGGING
 /* filtered logging added 4 more entries */
-#define NUM_DEBUG_INFOS 13
+#define NUM_DEBUG_INFOS 14
 #else
-#define NUM_DEBUG_INFOS 9
+#define NUM_DEBUG_INFOS 10
 #endif
 
 struct wmi_unified {
@@ -122,10 +122,9 @@ static int wmi_reset_filtered_buffers(wmi_unified_t wmi_handle,
 	if (!cmd_log_buf)
 		return 0;
 
-	cmd_log_buf->length = 0;
-	cmd_log_buf->buf_tail_idx = 0;
 	cmd_log_buf->size = WMI_FILTERED_CMD_EVT_MAX_NUM_ENTRY;
 	cmd_log_buf->p_buf_tail_idx = &cmd_log_buf->buf_tail_idx;
+	wmi_log_buf_reset(cmd_log_buf);
 	qdf_mem_zero(cmd_log_buf->buf, buf_size);
 	return 0;
 }
@@ -190,20 +189,16 @@ static int wmi_add_to_record_list(wmi_unified_t wmi_handle,
 static void wmi_specific_cmd_evt_record(uint32_t id, uint8_t *buf,
 					struct wmi_log_buf_t *log_buffer)
 {
-	int idx;
+	uint32_t idx;
 	struct wmi_command_debug *tmpbuf =
 		(struct wmi_command_debug *)log_buffer->buf;
 
-	if (*log_buffer->p_buf_tail_idx >= WMI_FILTERED_CMD_EVT_MAX_NUM_ENTRY)
-		*log_buffer->p_buf_tail_idx = 0;
-
-	idx = *log_buffer->p_buf_tail_idx;
+	idx = wmi_log_buf_reserve(log_buffer,
+				  WMI_FILTERED_CMD_EVT_MAX_NUM_ENTRY);
 	tmpbuf[idx].command = id;
 	qdf_mem_copy(tmpbuf[idx].data, buf,
 		     WMI_DEBUG_ENTRY_MAX_LENGTH);
 	tmpbuf[idx].time = qdf_get_log_timestamp();
-	(*log_buffer->p_buf_tail_idx)++;
-	log_buffer->length++;
 }
 
 void wmi_specific_cmd_record(wmi_unified_t wmi_handle,
@@ -313,9 +308,9 @@ static int wmi_log_show(wmi_unified_t wmi_handle, void *buf,
 	uint64_t secs, usecs;
 	int wmi_ring_size = 100;
 
-	qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+	wmi_log_record_lock(&wmi_handle->log_info);
 	if (!wmi_log->length) {
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+		wmi_log_record_unlock(&wmi_handle->log_info);
 		return wmi_filtered_seq_printf(m,
 					       "Nothing to read!\n");
 	}
@@ -331,7 +326,7 @@ static int wmi_log_show(wmi_unified_t wmi_handle, void *buf,
 		pos = *wmi_log->p_buf_tail_idx - 1;
 
 	outlen = wmi_filtered_seq_printf(m, "Length = %d\n", wmi_log->length);
-	qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+	wmi_log_record_unlock(&wmi_handle->log_info);
 	while (nread--) {
 		struct wmi_event_debug *wmi_record;
 
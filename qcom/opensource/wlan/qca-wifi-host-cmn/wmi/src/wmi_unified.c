@@ -167,92 +167,56 @@ static void wmi_minidump_attach(struct wmi_unified *wmi_handle)
 	qdf_minidump_log(info->buf, buf_size, "wmi_tx_cmp");
 }
 
+/*
+ * WMI_LOG_RECORD() - reserve the next record of a log buffer
+ * @rec_type: record type of the buffer
+ * @log_buf: log buffer to record into
+ * @max_entry: number of entries in the log buffer
+ */
+#define WMI_LOG_RECORD(rec_type, log_buf, max_entry)			\
+	((struct rec_type *)(log_buf)->buf +				\
+	 wmi_log_buf_reserve(log_buf, max_entry))
+
 #define WMI_COMMAND_RECORD(h, a, b) {					\
-	if (wmi_cmd_log_max_entry <=					\
-		*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx))	\
-		*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx) = 0;\
-	((struct wmi_command_debug *)h->log_info.wmi_command_log_buf_info.buf)\
-		[*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx)]\
-						.command = a;		\
-	qdf_mem_copy(((struct wmi_command_debug *)h->log_info.		\
-				wmi_command_log_buf_info.buf)		\
-		[*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx)].data,\
-			b, wmi_record_max_length);			\
-	((struct wmi_command_debug *)h->log_info.wmi_command_log_buf_info.buf)\
-		[*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx)].\
-		time = qdf_get_log_timestamp();			\
-	(*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx))++;	\
-	h->log_info.wmi_command_log_buf_info.length++;			\
+	struct wmi_command_debug *rec =					\
+		WMI_LOG_RECORD(wmi_command_debug,			\
+			       &h->log_info.wmi_command_log_buf_info,	\
+			       wmi_cmd_log_max_entry);			\
+	rec->command = a;						\
+	qdf_mem_copy(rec->data, b, wmi_record_max_length);		\
+	rec->time = qdf_get_log_timestamp();				\
 }
 
 #define WMI_COMMAND_TX_CMP_RECORD(h, a, b, da, pa) {			\
-	if (wmi_cmd_cmpl_log_max_entry <=				\
-		*(h->log_info.wmi_command_tx_cmp_log_buf_info.p_buf_tail_idx))\
-		*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
-				p_buf_tail_idx) = 0;			\
-	((struct wmi_command_cmp_debug *)h->log_info.			\
-		wmi_command_tx_cmp_log_buf_info.buf)			\
-		[*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
-				p_buf_tail_idx)].			\
-							command	= a;	\
-	qdf_mem_copy(((struct wmi_command_cmp_debug *)h->log_info.	\
-				wmi_command_tx_cmp_log_buf_info.buf)	\
-		[*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
-			p_buf_tail_idx)].				\
-		data, b, wmi_record_max_length);			\
-	((struct wmi_command_cmp_debug *)h->log_info.			\
-		wmi_command_tx_cmp_log_buf_info.buf)			\
-		[*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
-				p_buf_tail_idx)].			\
-		time = qdf_get_log_timestamp();				\
-	((struct wmi_command_cmp_debug *)h->log_info.			\
-		wmi_command_tx_cmp_log_buf_info.buf)			\
-		[*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
-				p_buf_tail_idx)].			\
-		dma_addr = da;						\
-	((struct wmi_command_cmp_debug *)h->log_info.			\
-		wmi_command_tx_cmp_log_buf_info.buf)			\
-		[*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
-				p_buf_tail_idx)].			\
-		phy_addr = pa;						\
-	(*(h->log_info.wmi_command_tx_cmp_log_buf_info.p_buf_tail_idx))++;\
-	h->log_info.wmi_command_tx_cmp_log_buf_info.length++;		\
+	struct wmi_command_cmp_debug *rec =				\
+		WMI_LOG_RECORD(wmi_command_cmp_debug,			\
+			&h->log_info.wmi_command_tx_cmp_log_buf_info,	\
+			wmi_cmd_cmpl_log_max_entry);			\
+	rec->command = a;						\
+	qdf_mem_copy(rec->data, b, wmi_record_max_length);		\
+	rec->time = qdf_get_log_timestamp();				\
+	rec->dma_addr = da;						\
+	rec->phy_addr = pa;						\
 }
 
 #define WMI_EVENT_RECORD(h, a, b) {					\
-	if (wmi_event_log_max_entry <=					\
-		*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx))	\
-		*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx) = 0;\
-	((struct wmi_event_debug *)h->log_info.wmi_event_log_buf_info.buf)\
-		[*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx)].	\
-		event = a;						\
-	qdf_mem_copy(((struct wmi_event_debug *)h->log_info.		\
-				wmi_event_log_buf_info.buf)		\
-		[*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx)].data, b,\
-		wmi_record_max_length);					\
-	((struct wmi_event_debug *)h->log_info.wmi_event_log_buf_info.buf)\
-		[*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx)].time =\
-		qdf_get_log_timestamp();				\
-	(*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx))++;	\
-	h->log_info.wmi_event_log_buf_info.length++;			\
+	struct wmi_event_debug *rec =					\
+		WMI_LOG_RECORD(wmi_event_debug,				\
+			       &h->log_info.wmi_event_log_buf_info,	\
+			       wmi_event_log_max_entry);		\
+	rec->event = a;							\
+	qdf_mem_copy(rec->data, b, wmi_record_max_length);		\
+	rec->time = qdf_get_log_timestamp();				\
 }
 
 #define WMI_RX_EVENT_RECORD(h, a, b) {					\
-	if (wmi_event_log_max_entry <=					\
-		*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx))\
-		*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx) = 0;\
-	((struct wmi_event_debug *)h->log_info.wmi_rx_event_log_buf_info.buf)\
-		[*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx)].\
-		event = a;						\
-	qdf_mem_copy(((struct wmi_event_debug *)h->log_info.		\
-				wmi_rx_event_log_buf_info.buf)		\
-		[*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx)].\
-			data, b, wmi_record_max_length);		\
-	((struct wmi_event_debug *)h->log_info.wmi_rx_event_log_buf_info.buf)\
-		[*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx)].\
-		time =	qdf_get_log_timestamp();			\
-	(*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx))++;	\
-	h->log_info.wmi_rx_event_log_buf_info.length++;			\
+	struct wmi_event_debug *rec =					\
+		WMI_LOG_RECORD(wmi_event_debug,				\
+			       &h->log_info.wmi_rx_event_log_buf_info,	\
+			       wmi_event_log_max_entry);		\
+	rec->event = a;							\
+	qdf_mem_copy(rec->data, b, wmi_record_max_length);		\
+	rec->time = qdf_get_log_timestamp();				\
 }
 
 #ifndef WMI_INTERFACE_EVENT_LOGGING_DYNAMIC_ALLOC
@@ -276,87 +240,44 @@ struct wmi_event_debug
 wmi_diag_rx_event_log_buffer[WMI_DIAG_RX_EVENT_DEBUG_MAX_ENTRY];
 #endif
 
-#define WMI_MGMT_COMMAND_RECORD(h, a, b) {                              \
-	if (wmi_mgmt_tx_log_max_entry <=                                   \
-		*(h->log_info.wmi_mgmt_command_log_buf_info.p_buf_tail_idx)) \
-		*(h->log_info.wmi_mgmt_command_log_buf_info.		\
-				p_buf_tail_idx) = 0;			\
-	((struct wmi_command_debug *)h->log_info.                       \
-		 wmi_mgmt_command_log_buf_info.buf)                     \
-		[*(h->log_info.wmi_mgmt_command_log_buf_info.p_buf_tail_idx)].\
-			command = a;                                    \
-	qdf_mem_copy(((struct wmi_command_debug *)h->log_info.          \
-				wmi_mgmt_command_log_buf_info.buf)      \
-		[*(h->log_info.wmi_mgmt_command_log_buf_info.p_buf_tail_idx)].\
-		data, b,                                                \
-		wmi_record_max_length);                                	\
-	((struct wmi_command_debug *)h->log_info.                       \
-		 wmi_mgmt_command_log_buf_info.buf)                     \
-		[*(h->log_info.wmi_mgmt_command_log_buf_info.p_buf_tail_idx)].\
-			time =        qdf_get_log_timestamp();          \
-	(*(h->log_info.wmi_mgmt_command_log_buf_info.p_buf_tail_idx))++;\
-	h->log_info.wmi_mgmt_command_log_buf_info.length++;             \
+#define WMI_MGMT_COMMAND_RECORD(h, a, b) {				\
+	struct wmi_command_debug *rec =					\
+		WMI_LOG_RECORD(wmi_command_debug,			\
+			&h->log_info.wmi_mgmt_command_log_buf_info,	\
+			wmi_mgmt_tx_log_max_entry);			\
+	rec->command = a;						\
+	qdf_mem_copy(rec->data, b, wmi_record_max_length);		\
+	rec->time = qdf_get_log_timestamp();				\
 }
 
 #define WMI_MGMT_COMMAND_TX_CMP_RECORD(h, a, b) {			\
-	if (wmi_mgmt_tx_cmpl_log_max_entry <=				\
-		*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
-			p_buf_tail_idx))				\
-		*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
-			p_buf_tail_idx) = 0;				\
-	((struct wmi_command_debug *)h->log_info.			\
-			wmi_mgmt_command_tx_cmp_log_buf_info.buf)	\
-		[*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
-				p_buf_tail_idx)].command = a;		\
-	qdf_mem_copy(((struct wmi_command_debug *)h->log_info.		\
-				wmi_mgmt_command_tx_cmp_log_buf_info.buf)\
-		[*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
-			p_buf_tail_idx)].data, b,			\
-			wmi_record_max_length);				\
-	((struct wmi_command_debug *)h->log_info.			\
-			wmi_mgmt_command_tx_cmp_log_buf_info.buf)	\
-		[*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
-				p_buf_tail_idx)].time =			\
-		qdf_get_log_timestamp();				\
-	(*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.		\
-			p_buf_tail_idx))++;				\
-	h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.length++;	\
+	struct wmi_command_debug *rec =					\
+		WMI_LOG_RECORD(wmi_command_debug,			\
+			&h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info,\
+			wmi_mgmt_tx_cmpl_log_max_entry);		\
+	rec->command = a;						\
+	qdf_mem_copy(rec->data, b, wmi_record_max_length);		\
+	rec->time = qdf_get_log_timestamp();				\
 }
 
 #define WMI_MGMT_RX_EVENT_RECORD(h, a, b) do {				\
-	if (wmi_mgmt_rx_log_max_entry <=				\
-		*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx))\
-		*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx) = 0;\
-	((struct wmi_event_debug *)h->log_info.wmi_mgmt_event_log_buf_info.buf)\
-		[*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx)]\
-					.event = a;			\
-	qdf_mem_copy(((struct wmi_event_debug *)h->log_info.		\
-				wmi_mgmt_event_log_buf_info.buf)	\
-		[*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx)].\
-			data, b, wmi_record_max_length);		\
-	((struct wmi_event_debug *)h->log_info.wmi_mgmt_event_log_buf_info.buf)\
-		[*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx)].\
-			time = qdf_get_log_timestamp();			\
-	(*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx))++;	\
-	h->log_info.wmi_mgmt_event_log_buf_info.length++;		\
+	struct wmi_event_debug *rec =					\
+		WMI_LOG_RECORD(wmi_event_debug,				\
+			       &h->log_info.wmi_mgmt_event_log_buf_info,\
+			       wmi_mgmt_rx_log_max_entry);		\
+	rec->event = a;							\
+	qdf_mem_copy(rec->data, b, wmi_record_max_length);		\
+	rec->time = qdf_get_log_timestamp();				\
 } while (0);
 
-#define WMI_DIAG_RX_EVENT_RECORD(h, a, b) do {                             \
-	if (wmi_diag_log_max_entry <=                                   \
-		*(h->log_info.wmi_diag_event_log_buf_info.p_buf_tail_idx))\
-		*(h->log_info.wmi_diag_event_log_buf_info.p_buf_tail_idx) = 0;\
-	((struct wmi_event_debug *)h->log_info.wmi_diag_event_log_buf_info.buf)\
-		[*(h->log_info.wmi_diag_event_log_buf_info.p_buf_tail_idx)]\
-					.event = a;                     \
-	qdf_mem_copy(((struct wmi_event_debug *)h->log_info.            \
-				wmi_diag_event_log_buf_info.buf)        \
-		[*(h->log_info.wmi_diag_event_log_buf_info.p_buf_tail_idx)].\
-			data, b, wmi_record_max_length);                \
-	((struct wmi_event_debug *)h->log_info.wmi_diag_event_log_buf_info.buf)\
-		[*(h->log_info.wmi_diag_event_log_buf_info.p_buf_tail_idx)].\
-			time = qdf_get_log_timestamp();                 \
-	(*(h->log_info.wmi_diag_event_log_buf_info.p_buf_tail_idx))++;  \
-	h->log_info.wmi_diag_event_log_buf_info.length++;               \
+#define WMI_DIAG_RX_EVENT_RECORD(h, a, b) do {				\
+	struct wmi_event_debug *rec =					\
+		WMI_LOG_RECORD(wmi_event_debug,				\
+			       &h->log_info.wmi_diag_event_log_buf_info,\
+			       wmi_diag_log_max_entry);			\
+	rec->event = a;							\
+	qdf_mem_copy(rec->data, b, wmi_record_max_length);		\
+	rec->time = qdf_get_log_timestamp();				\
 } while (0);
 
 /* These are defined to made it as module param, which can be configured */
@@ -897,9 +818,9 @@ wmi_print_mgmt_event_log(wmi_unified_t wmi, uint32_t count,
 		int i;							\
 		uint64_t secs, usecs;					\
 									\
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);\
+		wmi_log_record_lock(&wmi_handle->log_info);		\
 		if (!wmi_log->length) {					\
-			qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);\
+			wmi_log_record_unlock(&wmi_handle->log_info);	\
 			return wmi_bp_seq_printf(m,			\
 			"no elements to read from ring buffer!\n");	\
 		}							\
@@ -916,7 +837,7 @@ wmi_print_mgmt_event_log(wmi_unified_t wmi, uint32_t count,
 			pos = *(wmi_log->p_buf_tail_idx) - 1;		\
 									\
 		outlen = wmi_bp_seq_printf(m, "Length = %d\n", wmi_log->length);\
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);\
+		wmi_log_record_unlock(&wmi_handle->log_info);		\
 		while (nread--) {					\
 			struct wmi_record_type *wmi_record;		\
 									\
@@ -955,9 +876,9 @@ wmi_print_mgmt_event_log(wmi_unified_t wmi, uint32_t count,
 		int i;							\
 		uint64_t secs, usecs;					\
 									\
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);\
+		wmi_log_record_lock(&wmi_handle->log_info);		\
 		if (!wmi_log->length) {					\
-			qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);\
+			wmi_log_record_unlock(&wmi_handle->log_info);	\
 			return wmi_bp_seq_printf(m,			\
 			"no elements to read from ring buffer!\n");	\
 		}							\
@@ -974,7 +895,7 @@ wmi_print_mgmt_event_log(wmi_unified_t wmi, uint32_t count,
 			pos = *(wmi_log->p_buf_tail_idx) - 1;		\
 									\
 		outlen = wmi_bp_seq_printf(m, "Length = %d\n", wmi_log->length);\
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);\
+		wmi_log_record_unlock(&wmi_handle->log_info);		\
 		while (nread--) {					\
 			struct wmi_event_debug *wmi_record;		\
 									\
@@ -1093,12 +1014,11 @@ static int debug_wmi_log_size_show(struct seq_file *m, void *v)
 			return -EINVAL;					\
 		}							\
 									\
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);\
+		wmi_log_record_lock(&wmi_handle->log_info);		\
 		qdf_mem_zero(wmi_log->buf, wmi_ring_size *		\
 				sizeof(struct wmi_record_type));	\
-		wmi_log->length = 0;					\
-		*(wmi_log->p_buf_tail_idx) = 0;				\
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);\
+		wmi_log_buf_reset(wmi_log);				\
+		wmi_log_record_unlock(&wmi_handle->log_info);		\
 									\
 		return count;						\
 	}
@@ -1167,6 +1087,107 @@ static ssize_t debug_wmi_log_size_write(struct file *file,
 	return -EINVAL;
 }
 
+/* number of log buffers in the binary export */
+#define WMI_LOG_BIN_NUM_BUFS 8
+
+/**
+ * wmi_log_bin_buf_write() - append one log buffer to the binary export
+ * @m: debugfs handler
+ * @log_info: WMI log buffers
+ * @id: position of the buffer in struct wmi_debug_log_info
+ * @log_buf: log buffer to export
+ * @entry_size: size of one record of the buffer
+ *
+ * Return: None
+ */
+static void wmi_log_bin_buf_write(struct seq_file *m,
+				  struct wmi_debug_log_info *log_info,
+				  uint32_t id, struct wmi_log_buf_t *log_buf,
+				  uint32_t entry_size)
+{
+	struct wmi_log_bin_buf_hdr hdr;
+
+	hdr.id = id;
+	hdr.entry_size = entry_size;
+	hdr.size = log_buf->size;
+
+	wmi_log_record_lock(log_info);
+	hdr.tail = *log_buf->p_buf_tail_idx;
+	hdr.length = log_buf->length;
+	seq_write(m, &hdr, sizeof(hdr));
+	seq_write(m, log_buf->buf, hdr.size * entry_size);
+	wmi_log_record_unlock(log_info);
+}
+
+/**
+ * debug_wmi_log_bin_show() - debugfs function to export all the WMI log
+ * buffers in binary form, for offline decoding.
+ *
+ * @m: debugfs handler to access wmi_handle
+ * @v: Variable arguments (not used)
+ *
+ * Return: 0
+ */
+static int debug_wmi_log_bin_show(struct seq_file *m, void *v)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t)m->private;
+	struct wmi_debug_log_info *log_info = &wmi_handle->log_info;
+	struct wmi_log_bin_hdr hdr;
+	uint32_t id = 0;
+
+	hdr.magic = WMI_LOG_BIN_MAGIC;
+	hdr.version = WMI_LOG_BIN_VERSION;
+	hdr.num_bufs = WMI_LOG_BIN_NUM_BUFS;
+	hdr.ts_now = qdf_get_log_timestamp();
+	hdr.ts_now_usecs = qdf_log_timestamp_to_usecs(hdr.ts_now);
+	seq_write(m, &hdr, sizeof(hdr));
+
+	wmi_log_bin_buf_write(m, log_info, id++,
+			      &log_info->wmi_command_log_buf_info,
+			      sizeof(struct wmi_command_debug));
+	wmi_log_bin_buf_write(m, log_info, id++,
+			      &log_info->wmi_command_tx_cmp_log_buf_info,
+			      sizeof(struct wmi_command_cmp_debug));
+	wmi_log_bin_buf_write(m, log_info, id++,
+			      &log_info->wmi_event_log_buf_info,
+			      sizeof(struct wmi_event_debug));
+	wmi_log_bin_buf_write(m, log_info, id++,
+			      &log_info->wmi_rx_event_log_buf_info,
+			      sizeof(struct wmi_event_debug));
+	wmi_log_bin_buf_write(m, log_info, id++,
+			      &log_info->wmi_mgmt_command_log_buf_info,
+			      sizeof(struct wmi_command_debug));
+	wmi_log_bin_buf_write(m, log_info, id++,
+			      &log_info->wmi_mgmt_command_tx_cmp_log_buf_info,
+			      sizeof(struct wmi_command_debug));
+	wmi_log_bin_buf_write(m, log_info, id++,
+			      &log_info->wmi_mgmt_event_log_buf_info,
+			      sizeof(struct wmi_event_debug));
+	wmi_log_bin_buf_write(m, log_info, id++,
+			      &log_info->wmi_diag_event_log_buf_info,
+			      sizeof(struct wmi_event_debug));
+	QDF_BUG(id == WMI_LOG_BIN_NUM_BUFS);
+
+	return 0;
+}
+
+/**
+ * debug_wmi_log_bin_write() - reserved.
+ *
+ * @file: file handler to access wmi_handle
+ * @buf: received data buffer
+ * @count: length of received buffer
+ * @ppos: Not used
+ *
+ * Return: -EINVAL
+ */
+static ssize_t debug_wmi_log_bin_write(struct file *file,
+				       const char __user *buf, size_t count,
+				       loff_t *ppos)
+{
+	return -EINVAL;
+}
+
 /* Structure to maintain debug information */
 struct wmi_debugfs_info {
 	const char *name;
@@ -1211,6 +1232,7 @@ GENERATE_DEBUG_STRUCTS(wmi_mgmt_command_tx_cmp_log);
 GENERATE_DEBUG_STRUCTS(wmi_mgmt_event_log);
 GENERATE_DEBUG_STRUCTS(wmi_enable);
 GENERATE_DEBUG_STRUCTS(wmi_log_size);
+GENERATE_DEBUG_STRUCTS(wmi_log_bin);
 #ifdef WMI_INTERFACE_FILTERED_EVENT_LOGGING
 GENERATE_DEBUG_STRUCTS(filtered_wmi_cmds);
 GENERATE_DEBUG_STRUCTS(filtered_wmi_evts);
@@ -1228,6 +1250,7 @@ struct wmi_debugfs_info wmi_debugfs_infos[NUM_DEBUG_INFOS] = {
 	DEBUG_FOO(wmi_mgmt_event_log),
 	DEBUG_FOO(wmi_enable),
 	DEBUG_FOO(wmi_log_size),
+	DEBUG_FOO(wmi_log_bin),
 #ifdef WMI_INTERFACE_FILTERED_EVENT_LOGGING
 	DEBUG_FOO(filtered_wmi_cmds),
 	DEBUG_FOO(filtered_wmi_evts),
@@ -1349,11 +1372,11 @@ void wmi_mgmt_cmd_record(wmi_unified_t wmi_handle, uint32_t cmd,
 	data[2] = vdev_id;
 	data[3] = chanfreq;
 
-	qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+	wmi_log_record_lock(&wmi_handle->log_info);
 
 	WMI_MGMT_COMMAND_RECORD(wmi_handle, cmd, (uint8_t *)data);
 	wmi_specific_cmd_record(wmi_handle, cmd, (uint8_t *)data);
-	qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+	wmi_log_record_unlock(&wmi_handle->log_info);
 }
 #else
 /**
@@ -2091,7 +2114,7 @@ QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
 				   qdf_nbuf_data(buf), qdf_nbuf_len(buf));
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 	if (wmi_handle->log_info.wmi_logging_enable) {
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+		wmi_log_record_lock(&wmi_handle->log_info);
 		/*
 		 * Record 16 bytes of WMI cmd data -
 		 * exclude TLV and WMI headers
@@ -2106,7 +2129,7 @@ QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
 			wmi_specific_cmd_record(wmi_handle, cmd_id, tmpbuf);
 		}
 
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+		wmi_log_record_unlock(&wmi_handle->log_info);
 	}
 #endif
 	return wmi_htc_send_pkt(wmi_handle, pkt, func, line);
@@ -2556,7 +2579,7 @@ static void wmi_process_control_rx(struct wmi_unified *wmi_handle,
 		uint8_t *data;
 		data = qdf_nbuf_data(evt_buf);
 
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+		wmi_log_record_lock(&wmi_handle->log_info);
 		/* Exclude 4 bytes of TLV header */
 		if (wmi_handle->ops->is_diag_event(id)) {
 			WMI_DIAG_RX_EVENT_RECORD(wmi_handle, id,
@@ -2570,7 +2593,7 @@ static void wmi_process_control_rx(struct wmi_unified *wmi_handle,
 			WMI_RX_EVENT_RECORD(wmi_handle, id, ((uint8_t *) data +
 				wmi_handle->soc->buf_offset_event));
 		}
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+		wmi_log_record_unlock(&wmi_handle->log_info);
 	}
 #endif
 
@@ -2805,7 +2828,7 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 	}
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 	if (wmi_handle->log_info.wmi_logging_enable) {
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+		wmi_log_record_lock(&wmi_handle->log_info);
 		/* Exclude 4 bytes of TLV header */
 		if (wmi_handle->ops->is_diag_event(id)) {
 			/*
@@ -2824,7 +2847,7 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 			WMI_EVENT_RECORD(wmi_handle, id, tmpbuf);
 			wmi_specific_evt_record(wmi_handle, id, tmpbuf);
 		}
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+		wmi_log_record_unlock(&wmi_handle->log_info);
 	}
 #endif
 	/* Call the WMI registered event handler */
@@ -3443,7 +3466,7 @@ static void wmi_htc_tx_complete(void *ctx, HTC_PACKET *htc_pkt)
 		dma_addr = QDF_NBUF_CB_PADDR(wmi_cmd_buf);
 		phy_addr = qdf_mem_virt_to_phys(qdf_nbuf_data(wmi_cmd_buf));
 
-		qdf_spin_lock_bh(&log_info->wmi_record_lock);
+		wmi_log_record_lock(log_info);
 		/* Record 16 bytes of WMI cmd tx complete data
 		 * - exclude TLV and WMI headers
 		 */
@@ -3457,7 +3480,7 @@ static void wmi_htc_tx_complete(void *ctx, HTC_PACKET *htc_pkt)
 						  phy_addr);
 		}
 
-		qdf_spin_unlock_bh(&log_info->wmi_record_lock);
+		wmi_log_record_unlock(log_info);
 	}
 #endif
 
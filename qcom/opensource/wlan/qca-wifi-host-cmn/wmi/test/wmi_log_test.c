@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_util.h"
+#include "wmi_log_test.h"
+#include "wmi_unified_priv.h"
+
+#define ut_wmi_log_cmd_base 0x1000
+#define ut_wmi_log_chan_freq 2412
+#define ut_wmi_log_laps 3
+
+extern uint32_t wmi_mgmt_tx_log_max_entry;
+
+static uint32_t wmi_log_ut_check(struct wmi_log_buf_t *log_buf,
+				 uint32_t num)
+{
+	struct wmi_command_debug *rec;
+	uint32_t errors = 0;
+	uint32_t idx;
+
+	if (log_buf->length != num) {
+		qdf_nofl_alert("FAIL: length %u; expected %u",
+			       log_buf->length, num);
+		errors++;
+	}
+
+	if (*log_buf->p_buf_tail_idx != (num - 1) % log_buf->size + 1) {
+		qdf_nofl_alert("FAIL: tail %u after %u records",
+			       *log_buf->p_buf_tail_idx, num);
+		errors++;
+	}
+
+	idx = (num - 1) % log_buf->size;
+	rec = &((struct wmi_command_debug *)log_buf->buf)[idx];
+	if (rec->command != ut_wmi_log_cmd_base + num - 1 ||
+	    rec->data[2] != num - 1 ||
+	    rec->data[3] != ut_wmi_log_chan_freq) {
+		qdf_nofl_alert("FAIL: last record cmd 0x%x vdev %u freq %u",
+			       rec->command, rec->data[2], rec->data[3]);
+		errors++;
+	}
+
+	return errors;
+}
+
+static uint64_t wmi_log_ut_run(wmi_unified_t wmi, uint32_t num)
+{
+	uint32_t header = 0;
+	uint64_t start;
+	uint32_t i;
+
+	start = qdf_get_log_timestamp();
+	for (i = 0; i < num; i++)
+		wmi_mgmt_cmd_record(wmi, ut_wmi_log_cmd_base + i, &header, i,
+				    ut_wmi_log_chan_freq);
+
+	return qdf_get_log_timestamp() - start;
+}
+
+uint32_t wmi_log_unit_test(void)
+{
+	struct wmi_log_buf_t *log_buf;
+	struct wmi_unified *wmi;
+	uint32_t errors = 0;
+	uint64_t elapsed;
+	uint32_t num;
+
+	wmi = qdf_mem_malloc(sizeof(*wmi));
+	if (!wmi)
+		return 1;
+
+	log_buf = &wmi->log_info.wmi_mgmt_command_log_buf_info;
+	log_buf->size = wmi_mgmt_tx_log_max_entry;
+	log_buf->p_buf_tail_idx = &log_buf->buf_tail_idx;
+	log_buf->buf = qdf_mem_malloc(log_buf->size *
+				      sizeof(struct wmi_command_debug));
+	if (!log_buf->buf) {
+		qdf_mem_free(wmi);
+		return 1;
+	}
+
+	qdf_spinlock_create(&wmi->log_info.wmi_record_lock);
+	wmi->log_info.wmi_logging_enable = 1;
+
+	/* wrap the ring a few times and stop mid lap */
+	num = log_buf->size * ut_wmi_log_laps + log_buf->size / 2;
+	elapsed = wmi_log_ut_run(wmi, num);
+	errors += wmi_log_ut_check(log_buf, num);
+
+	wmi_log_buf_reset(log_buf);
+	wmi_log_ut_run(wmi, 1);
+	errors += wmi_log_ut_check(log_buf, 1);
+
+	qdf_nofl_info("WMI log: %u records, %llu ns/record",
+		      num,
+		      qdf_do_div(qdf_log_timestamp_to_usecs(elapsed) * 1000,
+				 num));
+
+	qdf_spinlock_destroy(&wmi->log_info.wmi_record_lock);
+	qdf_mem_free(log_buf->buf);
+	qdf_mem_free(wmi);
+
+	return errors;
+}
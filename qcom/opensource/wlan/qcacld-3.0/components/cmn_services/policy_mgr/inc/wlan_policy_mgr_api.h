@@ -958,6 +958,44 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 			      uint32_t *pcl_channels, uint32_t *len,
 			      uint8_t *pcl_weight, uint32_t weight_len);
 
+#ifdef FEATURE_POLICY_MGR_PCL_CACHE
+/**
+ * policy_mgr_invalidate_pcl_cache() - drop the cached PCLs
+ * @psoc: PSOC object information
+ *
+ * The cached PCLs are keyed on the connection table, the HW mode and the
+ * system preference, and are dropped on regulatory and channel avoidance
+ * updates. Components owning other inputs of the PCL, like the SRD or
+ * indoor channel configuration, call this when those change.
+ *
+ * Return: None
+ */
+void policy_mgr_invalidate_pcl_cache(struct wlan_objmgr_psoc *psoc);
+
+/**
+ * policy_mgr_get_pcl_cache_stats() - get the PCL cache statistics
+ * @psoc: PSOC object information
+ * @stats: statistics to fill
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+policy_mgr_get_pcl_cache_stats(struct wlan_objmgr_psoc *psoc,
+			       struct policy_mgr_pcl_cache_stats *stats);
+#else
+static inline
+void policy_mgr_invalidate_pcl_cache(struct wlan_objmgr_psoc *psoc)
+{
+}
+
+static inline QDF_STATUS
+policy_mgr_get_pcl_cache_stats(struct wlan_objmgr_psoc *psoc,
+			       struct policy_mgr_pcl_cache_stats *stats)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif
+
 /**
  * policy_mgr_init_chan_avoidance() - init channel avoidance in policy manager.
  * @psoc: PSOC object information
@@ -1445,4 +1445,23 @@ enum indoor_conc_update_type {
 	SWITCH_WITH_CONCURRENCY,
 };
 
+/**
+ * struct policy_mgr_pcl_cache_stats - PCL cache statistics
+ * @hits: PCL requests served from the cache
+ * @misses: PCL requests computed
+ * @invalidations: cache invalidations by regulatory, connection or
+ *	configuration updates
+ * @expired: cached PCLs found older than the max age
+ * @compute_ns: total time spent computing PCLs, in ns
+ * @compute_max_ns: longest PCL computation, in ns
+ */
+struct policy_mgr_pcl_cache_stats {
+	uint64_t hits;
+	uint64_t misses;
+	uint32_t invalidations;
+	uint32_t expired;
+	uint64_t compute_ns;
+	uint64_t compute_max_ns;
+};
+
 #endif /* __WLAN_POLICY_MGR_PUBLIC_STRUCT_H */
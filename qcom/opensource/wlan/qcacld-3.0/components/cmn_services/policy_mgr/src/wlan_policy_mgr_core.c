@@ -619,6 +619,8 @@ void policy_mgr_update_conc_list(struct wlan_objmgr_psoc *psoc,
 	pm_conc_connection_list[conn_index].in_use = in_use;
 	pm_conc_connection_list[conn_index].ch_flagext = ch_flagext;
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+	/* the PCL also depends on the vdev state of the connections */
+	policy_mgr_pcl_cache_flush(pm_ctx);
 
 	/*
 	 * For STA and P2P client mode, the mode change event sent as part
@@ -4403,6 +4405,7 @@ QDF_STATUS policy_mgr_reset_sap_mandatory_channels(
 	qdf_mem_zero(pm_ctx->sap_mandatory_channels,
 		     QDF_ARRAY_SIZE(pm_ctx->sap_mandatory_channels) *
 		     sizeof(*pm_ctx->sap_mandatory_channels));
+	policy_mgr_pcl_cache_flush(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -4432,6 +4435,7 @@ void policy_mgr_add_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
 
 	pm_ctx->sap_mandatory_channels[pm_ctx->sap_mandatory_channels_len++]
 		= ch_freq;
+	policy_mgr_pcl_cache_flush(pm_ctx);
 }
 
 uint32_t policy_mgr_get_sap_mandatory_chan_list_len(
@@ -4500,6 +4504,7 @@ void  policy_mgr_add_sap_mandatory_6ghz_chan(struct wlan_objmgr_psoc *psoc)
 				ch_freq_list[i];
 		}
 	}
+	policy_mgr_pcl_cache_flush(pm_ctx);
 }
 #else
 static inline
@@ -4555,6 +4560,7 @@ policy_mgr_init_sap_mandatory_chan_by_band(struct wlan_objmgr_psoc *psoc,
 				psoc, sap_mand_5g_freq_list[i]);
 	if (band_bitmap & BIT(REG_BAND_6G))
 		policy_mgr_add_sap_mandatory_6ghz_chan(psoc);
+	policy_mgr_pcl_cache_flush(pm_ctx);
 }
 
 void  policy_mgr_init_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
@@ -4610,4 +4616,5 @@ void policy_mgr_remove_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
 	qdf_mem_copy(pm_ctx->sap_mandatory_channels, ch_freq_list,
 		     num_chan * sizeof(*pm_ctx->sap_mandatory_channels));
 	pm_ctx->sap_mandatory_channels_len = num_chan;
+	policy_mgr_pcl_cache_flush(pm_ctx);
 }
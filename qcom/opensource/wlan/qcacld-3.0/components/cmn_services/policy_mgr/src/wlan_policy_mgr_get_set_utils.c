@@ -1248,6 +1248,7 @@ QDF_STATUS policy_mgr_update_hw_mode_list(struct wlan_objmgr_psoc *psoc,
 	 */
 	policy_mgr_fill_curr_mac_freq_by_hwmode(pm_ctx, MODE_SMM);
 	policy_mgr_dump_freq_range(pm_ctx);
+	policy_mgr_pcl_cache_flush(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -5511,6 +5512,7 @@ void policy_mgr_dump_connection_status_info(struct wlan_objmgr_psoc *psoc)
 
 	policy_mgr_dump_freq_range(pm_ctx);
 	policy_mgr_validate_conn_info(psoc);
+	policy_mgr_pcl_cache_dump_stats(pm_ctx);
 }
 
 bool policy_mgr_is_any_mode_active_on_band_along_with_session(
@@ -280,6 +280,72 @@ struct policy_mgr_cfg {
 	bool sbs_enable;
 };
 
+#ifdef FEATURE_POLICY_MGR_PCL_CACHE
+#define PM_PCL_CACHE_NUM_ENTRIES 8
+/*
+ * Bounds the staleness of a cached PCL on inputs owned by other components
+ * which do not invalidate the cache
+ */
+#define PM_PCL_CACHE_MAX_AGE_MS 1000
+
+/**
+ * struct policy_mgr_pcl_cache_key - concurrency state a PCL is computed from
+ * @generation: cache generation, advanced by each invalidation
+ * @mode: connection mode the PCL is requested for
+ * @weight_len: max length of the PCL
+ * @sys_pref: current concurrency system preference
+ * @old_hw_mode_index: previous HW mode index
+ * @new_hw_mode_index: current HW mode index
+ * @conn: connection table, with the entries not in use zeroed
+ */
+struct policy_mgr_pcl_cache_key {
+	uint32_t generation;
+	enum policy_mgr_con_mode mode;
+	uint32_t weight_len;
+	uint8_t sys_pref;
+	uint32_t old_hw_mode_index;
+	uint32_t new_hw_mode_index;
+	struct policy_mgr_conc_connection_info
+				conn[MAX_NUMBER_OF_CONC_CONNECTIONS];
+};
+
+/**
+ * struct policy_mgr_pcl_cache_entry - cached PCL
+ * @key: concurrency state the PCL was computed from
+ * @valid: entry holds a PCL
+ * @timestamp: system ticks when the PCL was computed
+ * @last_used: cache use count when the entry was last used
+ * @len: length of the PCL
+ * @pcl_channels: PCL channel frequencies
+ * @pcl_weight: PCL weights
+ */
+struct policy_mgr_pcl_cache_entry {
+	struct policy_mgr_pcl_cache_key key;
+	bool valid;
+	unsigned long timestamp;
+	uint32_t last_used;
+	uint32_t len;
+	uint32_t pcl_channels[NUM_CHANNELS];
+	uint8_t pcl_weight[NUM_CHANNELS];
+};
+
+/**
+ * struct policy_mgr_pcl_cache - PCLs memoized per concurrency state
+ * @lock: protects the cache
+ * @generation: current generation, entries of older ones are stale
+ * @use_count: lookups so far, orders the entries for replacement
+ * @entry: cached PCLs
+ * @stats: cache statistics
+ */
+struct policy_mgr_pcl_cache {
+	qdf_spinlock_t lock;
+	uint32_t generation;
+	uint32_t use_count;
+	struct policy_mgr_pcl_cache_entry entry[PM_PCL_CACHE_NUM_ENTRIES];
+	struct policy_mgr_pcl_cache_stats stats;
+};
+#endif
+
 /**
  * struct policy_mgr_psoc_priv_obj - Policy manager private data
  * @psoc: pointer to PSOC object information
@@ -335,6 +401,7 @@ struct policy_mgr_cfg {
  * @cfg: Policy manager config data
  * @dynamic_mcc_adaptive_sched: disable/enable mcc adaptive scheduler feature
  * @dynamic_dfs_master_disabled: current state of dynamic dfs master
+ * @pcl_cache: PCLs memoized per concurrency state
  */
 struct policy_mgr_psoc_priv_obj {
 	struct wlan_objmgr_psoc *psoc;
@@ -379,6 +446,9 @@ struct policy_mgr_psoc_priv_obj {
 #ifdef FEATURE_WLAN_CH_AVOID_EXT
 	uint32_t restriction_mask;
 #endif
+#ifdef FEATURE_POLICY_MGR_PCL_CACHE
+	struct policy_mgr_pcl_cache pcl_cache;
+#endif
 };
 
 /**
@@ -880,4 +950,61 @@ policy_mgr_set_freq_restriction_mask(struct policy_mgr_psoc_priv_obj *pm_ctx,
 {
 }
 #endif
+
+#ifdef FEATURE_POLICY_MGR_PCL_CACHE
+/**
+ * policy_mgr_pcl_cache_init() - initialize the PCL cache
+ * @pm_ctx: policy mgr psoc priv object
+ *
+ * Return: None
+ */
+void policy_mgr_pcl_cache_init(struct policy_mgr_psoc_priv_obj *pm_ctx);
+
+/**
+ * policy_mgr_pcl_cache_deinit() - deinitialize the PCL cache
+ * @pm_ctx: policy mgr psoc priv object
+ *
+ * Return: None
+ */
+void policy_mgr_pcl_cache_deinit(struct policy_mgr_psoc_priv_obj *pm_ctx);
+
+/**
+ * policy_mgr_pcl_cache_flush() - drop the cached PCLs
+ * @pm_ctx: policy mgr psoc priv object
+ *
+ * Called when an input of the PCL which is not part of the cache key
+ * changes.
+ *
+ * Return: None
+ */
+void policy_mgr_pcl_cache_flush(struct policy_mgr_psoc_priv_obj *pm_ctx);
+
+/**
+ * policy_mgr_pcl_cache_dump_stats() - log the PCL cache statistics
+ * @pm_ctx: policy mgr psoc priv object
+ *
+ * Return: None
+ */
+void policy_mgr_pcl_cache_dump_stats(struct policy_mgr_psoc_priv_obj *pm_ctx);
+#else
+static inline void
+policy_mgr_pcl_cache_init(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+}
+
+static inline void
+policy_mgr_pcl_cache_deinit(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+}
+
+static inline void
+policy_mgr_pcl_cache_flush(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+}
+
+static inline void
+policy_mgr_pcl_cache_dump_stats(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+}
+#endif
 #endif
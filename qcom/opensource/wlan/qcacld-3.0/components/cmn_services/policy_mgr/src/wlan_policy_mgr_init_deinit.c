@@ -52,6 +52,7 @@ static QDF_STATUS policy_mgr_psoc_obj_create_cb(struct wlan_objmgr_psoc *psoc,
 	policy_mgr_ctx->psoc = psoc;
 	policy_mgr_ctx->old_hw_mode_index = POLICY_MGR_DEFAULT_HW_MODE_INDEX;
 	policy_mgr_ctx->new_hw_mode_index = POLICY_MGR_DEFAULT_HW_MODE_INDEX;
+	policy_mgr_pcl_cache_init(policy_mgr_ctx);
 
 	wlan_objmgr_psoc_component_obj_attach(psoc,
 			WLAN_UMAC_COMP_POLICY_MGR,
@@ -70,6 +71,7 @@ static QDF_STATUS policy_mgr_psoc_obj_destroy_cb(struct wlan_objmgr_psoc *psoc,
 	wlan_objmgr_psoc_component_obj_detach(psoc,
 					WLAN_UMAC_COMP_POLICY_MGR,
 					policy_mgr_ctx);
+	policy_mgr_pcl_cache_deinit(policy_mgr_ctx);
 	qdf_mem_free(policy_mgr_ctx);
 
 	return QDF_STATUS_SUCCESS;
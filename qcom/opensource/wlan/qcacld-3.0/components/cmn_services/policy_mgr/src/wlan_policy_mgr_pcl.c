@@ -31,6 +31,7 @@
 #include "qdf_types.h"
 #include "qdf_trace.h"
 #include "qdf_str.h"
+#include "qdf_time.h"
 #include "wlan_objmgr_global_obj.h"
 #include "wlan_utility.h"
 #include "wlan_mlme_ucfg_api.h"
@@ -468,6 +469,7 @@ policy_mgr_reg_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 
 	if (!avoid_freq_ind) {
 		policy_mgr_debug("avoid_freq_ind NULL");
+		policy_mgr_pcl_cache_flush(pm_ctx);
 		return;
 	}
 
@@ -486,6 +488,7 @@ policy_mgr_reg_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 	for (i = 0; i < pm_ctx->unsafe_channel_count; i++)
 		pm_ctx->unsafe_channel_list[i] =
 			avoid_freq_ind->chan_list.chan_freq_list[i];
+	policy_mgr_pcl_cache_flush(pm_ctx);
 
 	policy_mgr_debug("Channel list update, received %d avoided channels",
 			 pm_ctx->unsafe_channel_count);
@@ -509,6 +512,7 @@ QDF_STATUS policy_mgr_init_chan_avoidance(struct wlan_objmgr_psoc *psoc,
 
 	for (i = 0; i < pm_ctx->unsafe_channel_count; i++)
 		pm_ctx->unsafe_channel_list[i] = chan_freq_list[i];
+	policy_mgr_pcl_cache_flush(pm_ctx);
 
 	policy_mgr_debug("Channel list init, received %d avoided channels",
 			 pm_ctx->unsafe_channel_count);
@@ -1240,10 +1244,11 @@ static inline enum policy_mgr_pcl_type policy_mgr_get_pcl_4_port(
 {return PM_MAX_PCL_TYPE; }
 #endif
 
-QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
-			      enum policy_mgr_con_mode mode,
-			      uint32_t *pcl_channels, uint32_t *len,
-			      uint8_t *pcl_weight, uint32_t weight_len)
+static QDF_STATUS policy_mgr_compute_pcl(struct wlan_objmgr_psoc *psoc,
+					 enum policy_mgr_con_mode mode,
+					 uint32_t *pcl_channels, uint32_t *len,
+					 uint8_t *pcl_weight,
+					 uint32_t weight_len)
 {
 	QDF_STATUS status = QDF_STATUS_E_FAILURE;
 	uint32_t num_connections = 0;
@@ -1368,6 +1373,292 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef FEATURE_POLICY_MGR_PCL_CACHE
+void policy_mgr_pcl_cache_init(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	struct policy_mgr_pcl_cache *cache = &pm_ctx->pcl_cache;
+
+	qdf_spinlock_create(&cache->lock);
+	cache->generation = 0;
+	cache->use_count = 0;
+	qdf_mem_zero(cache->entry, sizeof(cache->entry));
+	qdf_mem_zero(&cache->stats, sizeof(cache->stats));
+}
+
+void policy_mgr_pcl_cache_deinit(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	qdf_spinlock_destroy(&pm_ctx->pcl_cache.lock);
+}
+
+void policy_mgr_pcl_cache_flush(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	struct policy_mgr_pcl_cache *cache = &pm_ctx->pcl_cache;
+	uint8_t i;
+
+	qdf_spin_lock_bh(&cache->lock);
+	/* PCLs being computed against the old generation are not cached */
+	cache->generation++;
+	for (i = 0; i < PM_PCL_CACHE_NUM_ENTRIES; i++)
+		cache->entry[i].valid = false;
+	cache->stats.invalidations++;
+	qdf_spin_unlock_bh(&cache->lock);
+}
+
+void policy_mgr_pcl_cache_dump_stats(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	struct policy_mgr_pcl_cache_stats stats;
+	uint64_t lookups;
+
+	qdf_spin_lock_bh(&pm_ctx->pcl_cache.lock);
+	stats = pm_ctx->pcl_cache.stats;
+	qdf_spin_unlock_bh(&pm_ctx->pcl_cache.lock);
+
+	lookups = stats.hits + stats.misses;
+	policy_mgr_debug("PCL cache: hits %llu misses %llu (%llu%% hit) invalidations %u expired %u compute avg %llu max %llu ns",
+			 stats.hits, stats.misses,
+			 lookups ? qdf_do_div(stats.hits * 100, lookups) : 0,
+			 stats.invalidations, stats.expired,
+			 stats.misses ?
+			 qdf_do_div(stats.compute_ns, stats.misses) : 0,
+			 stats.compute_max_ns);
+}
+
+/**
+ * policy_mgr_pcl_cache_fill_key() - snapshot the concurrency state
+ * @pm_ctx: policy mgr psoc priv object
+ * @mode: connection mode the PCL is requested for
+ * @weight_len: max length of the PCL
+ * @key: key to fill
+ *
+ * Return: None
+ */
+static void
+policy_mgr_pcl_cache_fill_key(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			      enum policy_mgr_con_mode mode,
+			      uint32_t weight_len,
+			      struct policy_mgr_pcl_cache_key *key)
+{
+	struct policy_mgr_conc_connection_info *conn;
+	uint32_t i;
+
+	/* compared with qdf_mem_cmp(), keep the padding zeroed */
+	qdf_mem_zero(key, sizeof(*key));
+
+	qdf_spin_lock_bh(&pm_ctx->pcl_cache.lock);
+	key->generation = pm_ctx->pcl_cache.generation;
+	qdf_spin_unlock_bh(&pm_ctx->pcl_cache.lock);
+
+	key->mode = mode;
+	key->weight_len = weight_len;
+	key->sys_pref = pm_ctx->cur_conc_system_pref;
+	key->old_hw_mode_index = pm_ctx->old_hw_mode_index;
+	key->new_hw_mode_index = pm_ctx->new_hw_mode_index;
+
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
+	for (i = 0; i < MAX_NUMBER_OF_CONC_CONNECTIONS; i++) {
+		if (!pm_conc_connection_list[i].in_use)
+			continue;
+
+		conn = &key->conn[i];
+		conn->mode = pm_conc_connection_list[i].mode;
+		conn->freq = pm_conc_connection_list[i].freq;
+		conn->bw = pm_conc_connection_list[i].bw;
+		conn->mac = pm_conc_connection_list[i].mac;
+		conn->chain_mask = pm_conc_connection_list[i].chain_mask;
+		conn->original_nss = pm_conc_connection_list[i].original_nss;
+		conn->vdev_id = pm_conc_connection_list[i].vdev_id;
+		conn->in_use = true;
+		conn->ch_flagext = pm_conc_connection_list[i].ch_flagext;
+		conn->conn_6ghz_flag =
+			pm_conc_connection_list[i].conn_6ghz_flag;
+	}
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+}
+
+/**
+ * policy_mgr_pcl_cache_lookup() - get a cached PCL
+ * @pm_ctx: policy mgr psoc priv object
+ * @key: concurrency state the PCL is requested for
+ * @pcl_channels: PCL channel frequencies to fill
+ * @len: length of the PCL to fill
+ * @pcl_weight: PCL weights to fill
+ *
+ * Return: true if the PCL was cached
+ */
+static bool
+policy_mgr_pcl_cache_lookup(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			    struct policy_mgr_pcl_cache_key *key,
+			    uint32_t *pcl_channels, uint32_t *len,
+			    uint8_t *pcl_weight)
+{
+	struct policy_mgr_pcl_cache *cache = &pm_ctx->pcl_cache;
+	struct policy_mgr_pcl_cache_entry *entry;
+	unsigned long max_age;
+	uint8_t i;
+
+	max_age = qdf_system_msecs_to_ticks(PM_PCL_CACHE_MAX_AGE_MS);
+
+	qdf_spin_lock_bh(&cache->lock);
+	cache->use_count++;
+	for (i = 0; i < PM_PCL_CACHE_NUM_ENTRIES; i++) {
+		entry = &cache->entry[i];
+		if (!entry->valid ||
+		    qdf_mem_cmp(&entry->key, key, sizeof(*key)))
+			continue;
+
+		if (qdf_system_time_after(qdf_system_ticks(),
+					  entry->timestamp + max_age)) {
+			entry->valid = false;
+			cache->stats.expired++;
+			break;
+		}
+
+		entry->last_used = cache->use_count;
+		*len = entry->len;
+		qdf_mem_copy(pcl_channels, entry->pcl_channels,
+			     entry->len * sizeof(*pcl_channels));
+		qdf_mem_copy(pcl_weight, entry->pcl_weight, entry->len);
+		cache->stats.hits++;
+		qdf_spin_unlock_bh(&cache->lock);
+
+		return true;
+	}
+	cache->stats.misses++;
+	qdf_spin_unlock_bh(&cache->lock);
+
+	return false;
+}
+
+/**
+ * policy_mgr_pcl_cache_insert() - cache a computed PCL
+ * @pm_ctx: policy mgr psoc priv object
+ * @key: concurrency state the PCL was computed from
+ * @pcl_channels: PCL channel frequencies
+ * @len: length of the PCL
+ * @pcl_weight: PCL weights
+ * @compute_ns: time spent computing the PCL
+ *
+ * The least recently used entry is replaced.
+ *
+ * Return: None
+ */
+static void
+policy_mgr_pcl_cache_insert(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			    struct policy_mgr_pcl_cache_key *key,
+			    uint32_t *pcl_channels, uint32_t len,
+			    uint8_t *pcl_weight, uint64_t compute_ns)
+{
+	struct policy_mgr_pcl_cache *cache = &pm_ctx->pcl_cache;
+	struct policy_mgr_pcl_cache_entry *entry, *victim = NULL;
+	uint8_t i;
+
+	qdf_spin_lock_bh(&cache->lock);
+	cache->stats.compute_ns += compute_ns;
+	if (compute_ns > cache->stats.compute_max_ns)
+		cache->stats.compute_max_ns = compute_ns;
+
+	if (len > NUM_CHANNELS || key->generation != cache->generation)
+		goto unlock;
+
+	for (i = 0; i < PM_PCL_CACHE_NUM_ENTRIES; i++) {
+		entry = &cache->entry[i];
+		if (!entry->valid) {
+			victim = entry;
+			break;
+		}
+		if (!victim || entry->last_used < victim->last_used)
+			victim = entry;
+	}
+
+	victim->key = *key;
+	victim->valid = true;
+	victim->timestamp = qdf_system_ticks();
+	victim->last_used = cache->use_count;
+	victim->len = len;
+	qdf_mem_copy(victim->pcl_channels, pcl_channels,
+		     len * sizeof(*pcl_channels));
+	qdf_mem_copy(victim->pcl_weight, pcl_weight, len);
+
+unlock:
+	qdf_spin_unlock_bh(&cache->lock);
+}
+
+void policy_mgr_invalidate_pcl_cache(struct wlan_objmgr_psoc *psoc)
+{
+	struct policy_mgr_psoc_priv_obj *pm_ctx;
+
+	pm_ctx = policy_mgr_get_context(psoc);
+	if (!pm_ctx) {
+		policy_mgr_err("context is NULL");
+		return;
+	}
+
+	policy_mgr_pcl_cache_flush(pm_ctx);
+}
+
+QDF_STATUS
+policy_mgr_get_pcl_cache_stats(struct wlan_objmgr_psoc *psoc,
+			       struct policy_mgr_pcl_cache_stats *stats)
+{
+	struct policy_mgr_psoc_priv_obj *pm_ctx;
+
+	pm_ctx = policy_mgr_get_context(psoc);
+	if (!pm_ctx) {
+		policy_mgr_err("context is NULL");
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	qdf_spin_lock_bh(&pm_ctx->pcl_cache.lock);
+	*stats = pm_ctx->pcl_cache.stats;
+	qdf_spin_unlock_bh(&pm_ctx->pcl_cache.lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
+			      enum policy_mgr_con_mode mode,
+			      uint32_t *pcl_channels, uint32_t *len,
+			      uint8_t *pcl_weight, uint32_t weight_len)
+{
+	struct policy_mgr_psoc_priv_obj *pm_ctx;
+	struct policy_mgr_pcl_cache_key key;
+	uint64_t ts;
+	QDF_STATUS status;
+
+	pm_ctx = policy_mgr_get_context(psoc);
+	if (!pm_ctx || !pcl_channels || !len || !pcl_weight)
+		return policy_mgr_compute_pcl(psoc, mode, pcl_channels, len,
+					      pcl_weight, weight_len);
+
+	policy_mgr_pcl_cache_fill_key(pm_ctx, mode, weight_len, &key);
+	if (policy_mgr_pcl_cache_lookup(pm_ctx, &key, pcl_channels, len,
+					pcl_weight)) {
+		policy_mgr_debug("PCL for mode %d from cache", mode);
+		policy_mgr_dump_channel_list(*len, pcl_channels, pcl_weight);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	ts = qdf_sched_clock();
+	status = policy_mgr_compute_pcl(psoc, mode, pcl_channels, len,
+					pcl_weight, weight_len);
+	if (QDF_IS_STATUS_SUCCESS(status))
+		policy_mgr_pcl_cache_insert(pm_ctx, &key, pcl_channels, *len,
+					    pcl_weight,
+					    qdf_sched_clock() - ts);
+
+	return status;
+}
+#else
+QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
+			      enum policy_mgr_con_mode mode,
+			      uint32_t *pcl_channels, uint32_t *len,
+			      uint8_t *pcl_weight, uint32_t weight_len)
+{
+	return policy_mgr_compute_pcl(psoc, mode, pcl_channels, len,
+				      pcl_weight, weight_len);
+}
+#endif
+
 enum policy_mgr_conc_priority_mode
 		policy_mgr_get_first_connection_pcl_table_index(
 		struct wlan_objmgr_psoc *psoc)
@@ -2584,6 +2875,7 @@ policy_mgr_set_sap_mandatory_channels(struct wlan_objmgr_psoc *psoc,
 	}
 
 	pm_ctx->sap_mandatory_channels_len = len;
+	policy_mgr_pcl_cache_flush(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
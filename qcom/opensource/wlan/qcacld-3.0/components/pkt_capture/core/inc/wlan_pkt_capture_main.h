@@ -230,6 +230,28 @@ void pkt_capture_mon(struct pkt_capture_cb_context *cb_ctx, qdf_nbuf_t msdu,
 QDF_STATUS pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 				  struct wlan_objmgr_vdev *vdev);
 
+/**
+ * pkt_capture_set_filter_prog() - Install rx data capture pre-filter
+ * @vdev: pointer to vdev
+ * @prog: filter program, a program without rules captures every frame
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+pkt_capture_set_filter_prog(struct wlan_objmgr_vdev *vdev,
+			    const struct pkt_capture_filter_prog *prog);
+
+/**
+ * pkt_capture_get_data_stats() - Get data capture path counters
+ * @vdev: pointer to vdev
+ * @stats: buffer to fill with the counters
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+pkt_capture_get_data_stats(struct wlan_objmgr_vdev *vdev,
+			   struct pkt_capture_data_stats *stats);
+
 /**
  * pkt_capture_is_tx_mgmt_enable - Check if tx mgmt frames enabled
  * @pdev: pointer to pdev
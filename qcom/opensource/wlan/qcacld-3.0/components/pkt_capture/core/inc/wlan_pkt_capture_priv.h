@@ -36,10 +36,12 @@
  * struct pkt_capture_cfg - struct to store config values
  * @pkt_capture_mode: packet capture mode
  * @pkt_capture_config: config for trigger, qos and beacon frames
+ * @snaplen: max bytes of each rx data frame to capture, 0 for no limit
  */
 struct pkt_capture_cfg {
 	enum pkt_capture_mode pkt_capture_mode;
 	enum pkt_capture_config pkt_capture_config;
+	uint32_t snaplen;
 };
 
 /**
@@ -52,6 +54,29 @@ struct pkt_capture_cb_context {
 	void *mon_ctx;
 };
 
+/**
+ * struct pkt_capture_data_counters - data capture path counters
+ * @rx_filtered: rx msdus rejected by the filter program
+ * @rx_truncated: rx msdus cut down to the configured snaplen
+ * @rx_stolen: rx msdus handed over as is, without clone or copy
+ * @rx_cloned: rx msdus captured by reference to the original payload
+ * @rx_copied: rx msdus captured with a full payload copy
+ * @rx_alloc_fail: rx msdus lost to clone/copy allocation failures
+ * @mon_pkt_drop: msdu lists dropped for lack of a free mon packet
+ *
+ * The rx counters are updated from every rx context that captures data, so
+ * they are atomics. They are reported as struct pkt_capture_data_stats.
+ */
+struct pkt_capture_data_counters {
+	qdf_atomic_t rx_filtered;
+	qdf_atomic_t rx_truncated;
+	qdf_atomic_t rx_stolen;
+	qdf_atomic_t rx_cloned;
+	qdf_atomic_t rx_copied;
+	qdf_atomic_t rx_alloc_fail;
+	qdf_atomic_t mon_pkt_drop;
+};
+
 /**
  * struct pkt_capture_vdev_priv - Private object to be stored in vdev
  * @vdev: pointer to vdev object
@@ -65,6 +90,11 @@ struct pkt_capture_cb_context {
  * @tx_nss: nss of tx data packets received from ppdu stats
  * @last_freq: Last connected freq
  * @curr_freq: current connected freq
+ * @filter_prog: rx data pre-filter run before any clone or copy, NULL to
+ *	capture every frame. Read under RCU by the rx path and replaced as
+ *	a whole by pkt_capture_set_filter_prog().
+ * @filter_prog_lock: serializes filter program updates
+ * @data_stats: data capture path counters
  */
 struct pkt_capture_vdev_priv {
 	struct wlan_objmgr_vdev *vdev;
@@ -78,6 +108,9 @@ struct pkt_capture_vdev_priv {
 	uint8_t tx_nss;
 	qdf_freq_t last_freq;
 	qdf_freq_t curr_freq;
+	struct pkt_capture_filter_prog __rcu *filter_prog;
+	qdf_mutex_t filter_prog_lock;
+	struct pkt_capture_data_counters data_stats;
 };
 
 /**
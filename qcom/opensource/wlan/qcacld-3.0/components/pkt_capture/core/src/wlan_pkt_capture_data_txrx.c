@@ -30,6 +30,7 @@
 #include <ol_txrx_htt_api.h>
 #include "wlan_policy_mgr_ucfg.h"
 #include "hal_rx.h"
+#include <linux/rcupdate.h>
 #ifdef WLAN_FEATURE_PKT_CAPTURE_V2
 #include "dp_internal.h"
 #include "cds_utils.h"
@@ -564,19 +565,239 @@ bool pkt_capture_rx_in_order_offloaded_pkt(qdf_nbuf_t rx_ind_msg)
 					(*(msg_word + 1));
 }
 
+/**
+ * pkt_capture_rx_filter_match() - Run the rx data pre-filter on an msdu
+ * @vdev_priv: packet capture vdev priv
+ * @msdu: original msdu, data pointing at the 802.3 header
+ *
+ * Return: true if the msdu is to be captured
+ */
+static bool
+pkt_capture_rx_filter_match(struct pkt_capture_vdev_priv *vdev_priv,
+			    qdf_nbuf_t msdu)
+{
+	struct pkt_capture_filter_prog *prog;
+	struct pkt_capture_filter_rule *rule;
+	uint8_t *data = qdf_nbuf_data(msdu);
+	uint32_t len = qdf_nbuf_headlen(msdu);
+	bool match = true;
+	uint32_t field;
+	uint8_t i, j;
+
+	rcu_read_lock();
+	prog = rcu_dereference(vdev_priv->filter_prog);
+	if (!prog)
+		goto out;
+
+	for (i = 0; i < prog->num_rules; i++) {
+		rule = &prog->rules[i];
+		if (rule->offset + rule->size > len) {
+			match = false;
+			break;
+		}
+
+		field = 0;
+		for (j = 0; j < rule->size; j++)
+			field = (field << 8) | data[rule->offset + j];
+
+		if (((field & rule->mask) == rule->value) == rule->negate) {
+			match = false;
+			break;
+		}
+	}
+
+out:
+	rcu_read_unlock();
+
+	return match;
+}
+
+/**
+ * pkt_capture_rx_copy_msdu() - Capture an rx msdu by copying it
+ * @vdev_priv: packet capture vdev priv
+ * @msdu: original msdu
+ * @cap_len: bytes to capture from the start of the 802.3 header
+ *
+ * Return: capture buffer, NULL on allocation failure
+ */
+static qdf_nbuf_t
+pkt_capture_rx_copy_msdu(struct pkt_capture_vdev_priv *vdev_priv,
+			 qdf_nbuf_t msdu, uint32_t cap_len)
+{
+	qdf_nbuf_t cap;
+
+	cap = qdf_nbuf_copy(msdu);
+	if (!cap)
+		return NULL;
+
+	if (qdf_nbuf_len(cap) > cap_len)
+		qdf_nbuf_trim_tail(cap, qdf_nbuf_len(cap) - cap_len);
+
+	qdf_atomic_inc(&vdev_priv->data_stats.rx_copied);
+
+	return cap;
+}
+
+#ifdef WLAN_PKT_CAPTURE_ZERO_COPY
+#ifdef WLAN_FEATURE_PKT_CAPTURE_V2
+/**
+ * pkt_capture_rx_copy_cb() - Copy rx nbuf cb fields used by the capture path
+ * @head: capture head buffer
+ * @msdu: original msdu
+ *
+ * Return: None
+ */
+static inline void pkt_capture_rx_copy_cb(qdf_nbuf_t head, qdf_nbuf_t msdu)
+{
+	QDF_NBUF_CB_RX_PACKET_L3_HDR_PAD(head) =
+				QDF_NBUF_CB_RX_PACKET_L3_HDR_PAD(msdu);
+	qdf_nbuf_set_rx_chfrag_start(head, qdf_nbuf_is_rx_chfrag_start(msdu));
+	qdf_nbuf_set_rx_chfrag_end(head, qdf_nbuf_is_rx_chfrag_end(msdu));
+}
+#else
+static inline void pkt_capture_rx_copy_cb(qdf_nbuf_t head, qdf_nbuf_t msdu)
+{
+}
+#endif
+
+/**
+ * pkt_capture_rx_clone_msdu() - Capture an rx msdu by reference
+ * @vdev_priv: packet capture vdev priv
+ * @msdu: original msdu
+ * @cap_len: bytes to capture from the start of the 802.3 header
+ *
+ * The capture path reads the rx descriptor/TLVs kept in the headroom,
+ * rewrites the 802.3 header into an 802.11 one and pushes radiotap in
+ * front of it, so only those bytes need a private copy. They are copied
+ * into a small head buffer at the same offsets, and a clone of @msdu pulled
+ * past the 802.3 header is chained to it as the payload, which is shared
+ * with the original msdu instead of being copied.
+ *
+ * Return: capture buffer, NULL on allocation failure
+ */
+static qdf_nbuf_t
+pkt_capture_rx_clone_msdu(struct pkt_capture_vdev_priv *vdev_priv,
+			  qdf_nbuf_t msdu, uint32_t cap_len)
+{
+	uint32_t hdr_len = sizeof(struct ethernet_hdr_t);
+	uint32_t headroom = qdf_nbuf_headroom(msdu);
+	qdf_nbuf_t head, payload;
+
+	if (qdf_nbuf_is_nonlinear(msdu) || cap_len <= hdr_len)
+		return pkt_capture_rx_copy_msdu(vdev_priv, msdu, cap_len);
+
+	head = qdf_nbuf_alloc(NULL, headroom + hdr_len, headroom, 0, false);
+	if (!head)
+		return NULL;
+
+	/* rx descriptor has to sit at the same offset from the buffer head */
+	if (qdf_nbuf_headroom(head) != headroom) {
+		qdf_nbuf_free(head);
+		return pkt_capture_rx_copy_msdu(vdev_priv, msdu, cap_len);
+	}
+
+	payload = qdf_nbuf_clone(msdu);
+	if (!payload) {
+		qdf_nbuf_free(head);
+		return NULL;
+	}
+
+	qdf_nbuf_put_tail(head, hdr_len);
+	qdf_mem_copy(qdf_nbuf_head(head), qdf_nbuf_head(msdu),
+		     headroom + hdr_len);
+	pkt_capture_rx_copy_cb(head, msdu);
+
+	qdf_nbuf_pull_head(payload, hdr_len);
+	if (qdf_nbuf_len(payload) > cap_len - hdr_len)
+		qdf_nbuf_trim_tail(payload,
+				   qdf_nbuf_len(payload) - (cap_len - hdr_len));
+
+	/* payload is tracked and released as part of the head buffer */
+	qdf_net_buf_debug_release_skb(payload);
+	qdf_nbuf_append_ext_list(head, payload, qdf_nbuf_len(payload));
+	qdf_atomic_inc(&vdev_priv->data_stats.rx_cloned);
+
+	return head;
+}
+#else
+static inline qdf_nbuf_t
+pkt_capture_rx_clone_msdu(struct pkt_capture_vdev_priv *vdev_priv,
+			  qdf_nbuf_t msdu, uint32_t cap_len)
+{
+	return pkt_capture_rx_copy_msdu(vdev_priv, msdu, cap_len);
+}
+#endif
+
+/**
+ * pkt_capture_rx_capture_msdu() - Get the buffer to capture for an rx msdu
+ * @vdev_priv: packet capture vdev priv
+ * @msdu: original msdu, data pointing at the 802.3 header
+ * @steal: @msdu is not used once captured and can be handed over as is
+ *
+ * The filter program and snaplen are applied to @msdu before anything is
+ * cloned or copied. When @steal is set and the msdu is captured, the
+ * returned buffer is @msdu itself and the caller must not free it.
+ *
+ * Return: capture buffer, NULL if the msdu is filtered out or on
+ * allocation failure
+ */
+static qdf_nbuf_t
+pkt_capture_rx_capture_msdu(struct pkt_capture_vdev_priv *vdev_priv,
+			    qdf_nbuf_t msdu, bool steal)
+{
+	uint32_t snaplen = vdev_priv->cfg_params.snaplen;
+	uint32_t cap_len = qdf_nbuf_len(msdu);
+	qdf_nbuf_t cap;
+
+	if (!pkt_capture_rx_filter_match(vdev_priv, msdu)) {
+		qdf_atomic_inc(&vdev_priv->data_stats.rx_filtered);
+		return NULL;
+	}
+
+	if (snaplen && cap_len > snaplen) {
+		cap_len = snaplen;
+		qdf_atomic_inc(&vdev_priv->data_stats.rx_truncated);
+	}
+
+	if (steal && !qdf_nbuf_is_nonlinear(msdu)) {
+		if (qdf_nbuf_len(msdu) > cap_len)
+			qdf_nbuf_trim_tail(msdu, qdf_nbuf_len(msdu) - cap_len);
+		qdf_atomic_inc(&vdev_priv->data_stats.rx_stolen);
+		return msdu;
+	}
+
+	cap = pkt_capture_rx_clone_msdu(vdev_priv, msdu, cap_len);
+	if (!cap)
+		qdf_atomic_inc(&vdev_priv->data_stats.rx_alloc_fail);
+
+	return cap;
+}
+
 #ifndef WLAN_FEATURE_PKT_CAPTURE_V2
 void pkt_capture_msdu_process_pkts(
 				uint8_t *bssid,
 				qdf_nbuf_t head_msdu, uint8_t vdev_id,
 				htt_pdev_handle pdev, uint16_t status)
 {
+	struct pkt_capture_vdev_priv *vdev_priv;
+	struct wlan_objmgr_vdev *vdev;
 	qdf_nbuf_t loop_msdu, pktcapture_msdu;
 	qdf_nbuf_t msdu, prev = NULL;
 
+	vdev = pkt_capture_get_vdev();
+	if (QDF_IS_STATUS_ERROR(pkt_capture_vdev_get_ref(vdev)))
+		return;
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv) {
+		pkt_capture_vdev_put_ref(vdev);
+		return;
+	}
+
 	pktcapture_msdu = NULL;
 	loop_msdu = head_msdu;
 	while (loop_msdu) {
-		msdu = qdf_nbuf_copy(loop_msdu);
+		msdu = pkt_capture_rx_capture_msdu(vdev_priv, loop_msdu, false);
 
 		if (msdu) {
 			qdf_nbuf_push_head(msdu,
@@ -593,6 +814,7 @@ void pkt_capture_msdu_process_pkts(
 		}
 		loop_msdu = qdf_nbuf_next(loop_msdu);
 	}
+	pkt_capture_vdev_put_ref(vdev);
 
 	if (!pktcapture_msdu)
 		return;
@@ -609,13 +831,32 @@ void pkt_capture_msdu_process_pkts(
 				uint8_t *bssid, qdf_nbuf_t head_msdu,
 				uint8_t vdev_id, void *psoc, uint16_t status)
 {
+	struct pkt_capture_vdev_priv *vdev_priv = NULL;
+	struct wlan_objmgr_vdev *vdev;
 	qdf_nbuf_t loop_msdu, pktcapture_msdu, offload_msdu = NULL;
 	qdf_nbuf_t msdu, prev = NULL;
 
+	vdev = pkt_capture_get_vdev();
+	if (QDF_IS_STATUS_SUCCESS(pkt_capture_vdev_get_ref(vdev))) {
+		vdev_priv = pkt_capture_vdev_get_priv(vdev);
+		if (!vdev_priv)
+			pkt_capture_vdev_put_ref(vdev);
+	}
+
 	pktcapture_msdu = NULL;
 	loop_msdu = head_msdu;
 	while (loop_msdu) {
-		msdu = qdf_nbuf_copy(loop_msdu);
+		/*
+		 * Offload msdus are delivered only to pkt capture, so they
+		 * are handed over as is instead of being copied and freed.
+		 */
+		if (status == RX_OFFLOAD_PKT)
+			offload_msdu = loop_msdu;
+		msdu = NULL;
+		if (vdev_priv)
+			msdu = pkt_capture_rx_capture_msdu(vdev_priv, loop_msdu,
+							   !!offload_msdu);
+		loop_msdu = qdf_nbuf_next(loop_msdu);
 
 		if (msdu) {
 			qdf_nbuf_set_next(msdu, NULL);
@@ -628,17 +869,16 @@ void pkt_capture_msdu_process_pkts(
 				prev = msdu;
 			}
 		}
-		if (status == RX_OFFLOAD_PKT)
-			offload_msdu = loop_msdu;
-		loop_msdu = qdf_nbuf_next(loop_msdu);
 
 		/* Free offload msdu as it is delivered only to pkt capture */
-		if (offload_msdu) {
+		if (offload_msdu && offload_msdu != msdu)
 			qdf_nbuf_free(offload_msdu);
-			offload_msdu = NULL;
-		}
+		offload_msdu = NULL;
 	}
 
+	if (vdev_priv)
+		pkt_capture_vdev_put_ref(vdev);
+
 	if (!pktcapture_msdu)
 		return;
 
@@ -1461,6 +1701,7 @@ void pkt_capture_datapkt_process(
 		uint8_t tx_retry_cnt)
 {
 	uint8_t drop_count;
+	struct pkt_capture_vdev_priv *vdev_priv;
 	struct pkt_capture_mon_pkt *pkt;
 	pkt_capture_mon_thread_cb callback = NULL;
 	struct wlan_objmgr_vdev *vdev;
@@ -1487,6 +1728,9 @@ void pkt_capture_datapkt_process(
 
 	pkt = pkt_capture_alloc_mon_pkt(vdev);
 	if (!pkt) {
+		vdev_priv = pkt_capture_vdev_get_priv(vdev);
+		if (vdev_priv)
+			qdf_atomic_inc(&vdev_priv->data_stats.mon_pkt_drop);
 		pkt_capture_vdev_put_ref(vdev);
 		goto drop_rx_buf;
 	}
@@ -35,6 +35,7 @@
 #include "wlan_pkt_capture_tgt_api.h"
 #include <cds_ieee80211_common.h>
 #include "wlan_vdev_mgr_utils_api.h"
+#include <linux/rcupdate.h>
 
 static struct wlan_objmgr_vdev *gp_pkt_capture_vdev;
 
@@ -1041,6 +1042,8 @@ pkt_capture_cfg_init(struct pkt_psoc_priv *psoc_priv)
 
 	cfg_param->pkt_capture_mode = cfg_get(psoc_priv->psoc,
 					      CFG_PKT_CAPTURE_MODE);
+	cfg_param->snaplen = cfg_get(psoc_priv->psoc,
+				     CFG_PKT_CAPTURE_SNAPLEN);
 }
 
 QDF_STATUS
@@ -1048,6 +1051,7 @@ pkt_capture_vdev_create_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 {
 	struct pkt_capture_mon_context *mon_ctx;
 	struct pkt_capture_vdev_priv *vdev_priv;
+	struct pkt_psoc_priv *psoc_priv;
 	QDF_STATUS status;
 
 	if ((wlan_vdev_mlme_get_opmode(vdev) != QDF_STA_MODE) ||
@@ -1070,6 +1074,10 @@ pkt_capture_vdev_create_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 	vdev_priv->vdev = vdev;
 	gp_pkt_capture_vdev = vdev;
 
+	psoc_priv = pkt_capture_psoc_get_priv(wlan_vdev_get_psoc(vdev));
+	if (psoc_priv)
+		vdev_priv->cfg_params.snaplen = psoc_priv->cfg_param.snaplen;
+
 	status = pkt_capture_callback_ctx_create(vdev_priv);
 	if (!QDF_IS_STATUS_SUCCESS(status)) {
 		pkt_capture_err("Failed to create callback context");
@@ -1097,6 +1105,7 @@ pkt_capture_vdev_create_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 	}
 	qdf_spinlock_create(&vdev_priv->lock_q);
 	qdf_list_create(&vdev_priv->ppdu_stats_q, PPDU_STATS_Q_MAX_SIZE);
+	qdf_mutex_create(&vdev_priv->filter_prog_lock);
 
 	return status;
 
@@ -1120,6 +1129,7 @@ pkt_capture_vdev_destroy_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 {
 	struct pkt_capture_vdev_priv *vdev_priv;
 	struct pkt_capture_ppdu_stats_q_node *stats_node;
+	struct pkt_capture_filter_prog *filter_prog;
 	qdf_list_node_t *node;
 	QDF_STATUS status;
 
@@ -1142,6 +1152,14 @@ pkt_capture_vdev_destroy_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 	qdf_list_destroy(&vdev_priv->ppdu_stats_q);
 	qdf_spinlock_destroy(&vdev_priv->lock_q);
 
+	filter_prog = rcu_dereference_protected(vdev_priv->filter_prog, true);
+	if (filter_prog) {
+		RCU_INIT_POINTER(vdev_priv->filter_prog, NULL);
+		synchronize_rcu();
+		qdf_mem_free(filter_prog);
+	}
+	qdf_mutex_destroy(&vdev_priv->filter_prog_lock);
+
 	status = wlan_objmgr_vdev_component_obj_detach(
 					vdev,
 					WLAN_UMAC_COMP_PKT_CAPTURE,
@@ -1408,3 +1426,92 @@ QDF_STATUS pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 	}
 	return QDF_STATUS_SUCCESS;
 }
+
+QDF_STATUS
+pkt_capture_set_filter_prog(struct wlan_objmgr_vdev *vdev,
+			    const struct pkt_capture_filter_prog *prog)
+{
+	struct pkt_capture_filter_prog *new_prog = NULL, *old_prog;
+	struct pkt_capture_vdev_priv *vdev_priv;
+	uint8_t i;
+
+	if (!vdev || !prog) {
+		pkt_capture_err("vdev or filter prog is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv) {
+		pkt_capture_err("vdev_priv is NULL");
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	if (prog->num_rules > PKT_CAPTURE_FILTER_MAX_RULES) {
+		pkt_capture_err("Too many filter rules %d", prog->num_rules);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	for (i = 0; i < prog->num_rules; i++) {
+		if (prog->rules[i].size != 1 && prog->rules[i].size != 2 &&
+		    prog->rules[i].size != 4) {
+			pkt_capture_err("Invalid size %d for filter rule %d",
+					prog->rules[i].size, i);
+			return QDF_STATUS_E_INVAL;
+		}
+	}
+
+	if (prog->num_rules) {
+		new_prog = qdf_mem_malloc(sizeof(*new_prog));
+		if (!new_prog)
+			return QDF_STATUS_E_NOMEM;
+
+		qdf_mem_copy(new_prog, prog, sizeof(*new_prog));
+	}
+
+	/*
+	 * The rx path reads the program under RCU, so a new program is
+	 * published as a whole and the old one is freed only once every
+	 * reader that may still see it is done.
+	 */
+	qdf_mutex_acquire(&vdev_priv->filter_prog_lock);
+	old_prog = rcu_dereference_protected(vdev_priv->filter_prog, true);
+	rcu_assign_pointer(vdev_priv->filter_prog, new_prog);
+	qdf_mutex_release(&vdev_priv->filter_prog_lock);
+
+	if (old_prog) {
+		synchronize_rcu();
+		qdf_mem_free(old_prog);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS
+pkt_capture_get_data_stats(struct wlan_objmgr_vdev *vdev,
+			   struct pkt_capture_data_stats *stats)
+{
+	struct pkt_capture_data_counters *counters;
+	struct pkt_capture_vdev_priv *vdev_priv;
+
+	if (!vdev || !stats) {
+		pkt_capture_err("vdev or stats is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv) {
+		pkt_capture_err("vdev_priv is NULL");
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	counters = &vdev_priv->data_stats;
+	stats->rx_filtered = qdf_atomic_read(&counters->rx_filtered);
+	stats->rx_truncated = qdf_atomic_read(&counters->rx_truncated);
+	stats->rx_stolen = qdf_atomic_read(&counters->rx_stolen);
+	stats->rx_cloned = qdf_atomic_read(&counters->rx_cloned);
+	stats->rx_copied = qdf_atomic_read(&counters->rx_copied);
+	stats->rx_alloc_fail = qdf_atomic_read(&counters->rx_alloc_fail);
+	stats->mon_pkt_drop = qdf_atomic_read(&counters->mon_pkt_drop);
+
+	return QDF_STATUS_SUCCESS;
+}
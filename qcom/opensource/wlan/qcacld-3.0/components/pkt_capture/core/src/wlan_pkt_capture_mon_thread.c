@@ -148,6 +148,9 @@ pkt_capture_alloc_mon_pkt(struct wlan_objmgr_vdev *vdev)
 	list_del(&pkt->list);
 	spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
 
+	/* Packets returned in a batch by the mon thread are not cleared */
+	memset(pkt, 0, sizeof(*pkt));
+
 	return pkt;
 }
 
@@ -172,8 +175,15 @@ void pkt_capture_indicate_monpkt(struct wlan_objmgr_vdev *vdev,
 	spin_lock_bh(&mon_ctx->mon_queue_lock);
 	list_add_tail(&pkt->list, &mon_ctx->mon_thread_queue);
 	spin_unlock_bh(&mon_ctx->mon_queue_lock);
-	set_bit(PKT_CAPTURE_RX_POST_EVENT, &mon_ctx->mon_event_flag);
-	wake_up_interruptible(&mon_ctx->mon_wait_queue);
+
+	/*
+	 * The thread clears the post event before it drains the queue, so
+	 * if the event is still pending this packet is picked up by the
+	 * batch already scheduled and another wakeup is not needed.
+	 */
+	if (!test_and_set_bit(PKT_CAPTURE_RX_POST_EVENT,
+			      &mon_ctx->mon_event_flag))
+		wake_up_interruptible(&mon_ctx->mon_wait_queue);
 }
 
 void pkt_capture_wakeup_mon_thread(struct wlan_objmgr_vdev *vdev)
@@ -201,8 +211,11 @@ void pkt_capture_wakeup_mon_thread(struct wlan_objmgr_vdev *vdev)
  * pkt_capture_process_from_queue() - function to process pending mon packets
  * @mon_ctx: Pointer to packet capture mon context
  *
- * This api traverses the pending buffer list and calling the callback.
- * This callback would essentially send the packet to HDD.
+ * This api takes the whole pending buffer list in one go and calls the
+ * callback for each packet. This callback would essentially send the
+ * packet to HDD. The processed packets are handed back to the free queue
+ * as one batch, so each queue lock is taken once per batch rather than
+ * once per packet.
  *
  * Return: None
  */
@@ -210,24 +223,30 @@ static void
 pkt_capture_process_from_queue(struct pkt_capture_mon_context *mon_ctx)
 {
 	struct pkt_capture_mon_pkt *pkt;
+	struct list_head batch;
 	uint8_t vdev_id;
 	uint8_t tid;
 
+	INIT_LIST_HEAD(&batch);
+
 	spin_lock_bh(&mon_ctx->mon_queue_lock);
-	while (!list_empty(&mon_ctx->mon_thread_queue)) {
-		pkt = list_first_entry(&mon_ctx->mon_thread_queue,
-				       struct pkt_capture_mon_pkt, list);
-		list_del(&pkt->list);
-		spin_unlock_bh(&mon_ctx->mon_queue_lock);
+	list_splice_init(&mon_ctx->mon_thread_queue, &batch);
+	spin_unlock_bh(&mon_ctx->mon_queue_lock);
+
+	if (list_empty(&batch))
+		return;
+
+	list_for_each_entry(pkt, &batch, list) {
 		vdev_id = pkt->vdev_id;
 		tid = pkt->tid;
 		pkt->callback(pkt->context, pkt->pdev, pkt->monpkt, vdev_id,
 			      tid, pkt->status, pkt->pkt_format, pkt->bssid,
 			      pkt->tx_retry_cnt);
-		pkt_capture_free_mon_pkt(mon_ctx, pkt);
-		spin_lock_bh(&mon_ctx->mon_queue_lock);
 	}
-	spin_unlock_bh(&mon_ctx->mon_queue_lock);
+
+	spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
+	list_splice_tail_init(&batch, &mon_ctx->mon_pkt_freeq);
+	spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
 }
 
 /**
@@ -55,8 +55,35 @@
 			CFG_VALUE_OR_DEFAULT, \
 			"Value for packet capture mode")
 
+/*
+ * <ini>
+ * packet_capture_snaplen - Max bytes captured per rx data frame
+ * @Min: 0
+ * @Max: 65535
+ * Default: 0 - Capture whole frames
+ *
+ * This ini is used to limit how much of each rx data frame, counted from
+ * the start of the 802.3 header, is delivered on the monitor interface.
+ * Frames are cut before they are copied or cloned, so a small snaplen
+ * also bounds the per-frame capture cost.
+ *
+ * Supported Feature: packet capture
+ *
+ * Usage: External
+ *
+ * </ini>
+ */
+#define CFG_PKT_CAPTURE_SNAPLEN \
+			CFG_INI_UINT("packet_capture_snaplen", \
+			0, \
+			65535, \
+			0, \
+			CFG_VALUE_OR_DEFAULT, \
+			"Max bytes captured per rx data frame")
+
 #define CFG_PKT_CAPTURE_MODE_ALL \
-	CFG(CFG_PKT_CAPTURE_MODE)
+	CFG(CFG_PKT_CAPTURE_MODE) \
+	CFG(CFG_PKT_CAPTURE_SNAPLEN)
 #else
 #define CFG_PKT_CAPTURE_MODE_ALL
 #endif /* WLAN_FEATURE_PKT_CAPTURE */
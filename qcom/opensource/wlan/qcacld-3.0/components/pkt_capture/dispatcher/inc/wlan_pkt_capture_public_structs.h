@@ -254,4 +254,56 @@ struct pkt_capture_frame_filter {
 	uint32_t connected_beacon_interval;
 	uint8_t vendor_attr_to_set;
 };
+
+#define PKT_CAPTURE_FILTER_MAX_RULES 8
+
+/**
+ * struct pkt_capture_filter_rule - one match rule of a capture filter
+ * @offset: byte offset of the field from the start of the 802.3 header
+ * @size: size of the field in bytes, one of 1, 2 or 4 (network order)
+ * @negate: rule matches when the masked field differs from @value
+ * @mask: mask applied to the field before comparing
+ * @value: value the masked field is compared against
+ */
+struct pkt_capture_filter_rule {
+	uint16_t offset;
+	uint8_t size;
+	bool negate;
+	uint32_t mask;
+	uint32_t value;
+};
+
+/**
+ * struct pkt_capture_filter_prog - rx data capture pre-filter
+ * @num_rules: number of valid entries in @rules, 0 accepts every frame
+ * @rules: rules which all have to match for a frame to be captured
+ *
+ * The program is run against the original msdu before it is cloned or
+ * copied, so rejected frames cost no allocation at all.
+ */
+struct pkt_capture_filter_prog {
+	uint8_t num_rules;
+	struct pkt_capture_filter_rule rules[PKT_CAPTURE_FILTER_MAX_RULES];
+};
+
+/**
+ * struct pkt_capture_data_stats - data capture path counters
+ * @rx_filtered: rx msdus rejected by the filter program
+ * @rx_truncated: rx msdus cut down to the configured snaplen
+ * @rx_stolen: rx msdus delivered only to packet capture and handed over
+ *	as is, without clone or copy
+ * @rx_cloned: rx msdus captured by reference to the original payload
+ * @rx_copied: rx msdus captured with a full payload copy
+ * @rx_alloc_fail: rx msdus lost to clone/copy allocation failures
+ * @mon_pkt_drop: msdu lists dropped for lack of a free mon packet
+ */
+struct pkt_capture_data_stats {
+	uint32_t rx_filtered;
+	uint32_t rx_truncated;
+	uint32_t rx_stolen;
+	uint32_t rx_cloned;
+	uint32_t rx_copied;
+	uint32_t rx_alloc_fail;
+	uint32_t mon_pkt_drop;
+};
 #endif /* _WLAN_PKT_CAPTURE_PUBLIC_STRUCTS_H_ */
@@ -297,6 +297,28 @@ QDF_STATUS
 ucfg_pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 			    struct wlan_objmgr_vdev *vdev);
 
+/**
+ * ucfg_pkt_capture_set_filter_prog() - ucfg API to set rx data pre-filter
+ * @vdev: pointer to vdev
+ * @prog: filter program evaluated before a frame is cloned or copied
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+ucfg_pkt_capture_set_filter_prog(struct wlan_objmgr_vdev *vdev,
+				 const struct pkt_capture_filter_prog *prog);
+
+/**
+ * ucfg_pkt_capture_get_data_stats() - ucfg API to get data capture counters
+ * @vdev: pointer to vdev
+ * @stats: buffer to fill with the counters
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+ucfg_pkt_capture_get_data_stats(struct wlan_objmgr_vdev *vdev,
+				struct pkt_capture_data_stats *stats);
+
 #else
 static inline
 QDF_STATUS ucfg_pkt_capture_init(void)
@@ -446,5 +468,19 @@ ucfg_pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 	return QDF_STATUS_SUCCESS;
 }
 
+static inline QDF_STATUS
+ucfg_pkt_capture_set_filter_prog(struct wlan_objmgr_vdev *vdev,
+				 const struct pkt_capture_filter_prog *prog)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline QDF_STATUS
+ucfg_pkt_capture_get_data_stats(struct wlan_objmgr_vdev *vdev,
+				struct pkt_capture_data_stats *stats)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
 #endif /* WLAN_FEATURE_PKT_CAPTURE */
 #endif /* _WLAN_PKT_CAPTURE_UCFG_API_H_ */
@@ -342,3 +342,17 @@ ucfg_pkt_capture_set_filter(struct pkt_capture_frame_filter frame_filter,
 {
 	return pkt_capture_set_filter(frame_filter, vdev);
 }
+
+QDF_STATUS
+ucfg_pkt_capture_set_filter_prog(struct wlan_objmgr_vdev *vdev,
+				 const struct pkt_capture_filter_prog *prog)
+{
+	return pkt_capture_set_filter_prog(vdev, prog);
+}
+
+QDF_STATUS
+ucfg_pkt_capture_get_data_stats(struct wlan_objmgr_vdev *vdev,
+				struct pkt_capture_data_stats *stats)
+{
+	return pkt_capture_get_data_stats(vdev, stats);
+}
@@ -139,6 +139,9 @@ static struct ol_if_ops  dp_ol_if_ops = {
 #endif
 	.dp_get_tx_inqueue = dp_get_tx_inqueue,
 	.dp_send_unit_test_cmd = wma_form_unit_test_cmd_and_send,
+#if defined(FEATURE_BUS_BANDWIDTH_MGR) && defined(WLAN_FEATURE_BUS_BW_PREDICT)
+	.dp_bus_bw_demand_ind = hdd_bbm_predict_demand_ind,
+#endif
     /* TODO: Add any other control path calls required to OL_IF/WMA layer */
 };
 #else
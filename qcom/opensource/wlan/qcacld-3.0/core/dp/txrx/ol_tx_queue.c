@@ -474,9 +474,13 @@ ol_txrx_peer_pause_base(
  * @peer: peer device object
  * @tid: tid for which queue needs to be unpaused
  *
- * Return: None
+ * The scheduler is not invoked from here, since the caller holds the tx
+ * queue lock and may unpause many queues at once. The caller runs the
+ * scheduler once after releasing the lock if any queue became ready.
+ *
+ * Return: true if the queue was unpaused and has frames to download
  */
-static void
+static bool
 ol_txrx_peer_tid_unpause_base(
 	struct ol_txrx_pdev_t *pdev,
 	struct ol_txrx_peer_t *peer,
@@ -490,7 +494,7 @@ ol_txrx_peer_tid_unpause_base(
 	TXRX_ASSERT2(txq->paused_count.total > 0);
 	/* return, if not already paused */
 	if (txq->paused_count.total == 0)
-		return;
+		return false;
 
 	if (--txq->paused_count.total == 0) {
 		struct ol_tx_sched_notify_ctx_t notify_ctx;
@@ -504,19 +508,11 @@ ol_txrx_peer_tid_unpause_base(
 			txq->flag = ol_tx_queue_empty;
 		} else {
 			txq->flag = ol_tx_queue_active;
-			/*
-			 * Now that the are new tx frames available to download,
-			 * invoke the scheduling function, to see if it wants to
-			 * download the new frames.
-			 * Since the queue lock is currently held, and since
-			 * the scheduler function takes the lock, temporarily
-			 * release the lock.
-			 */
-			qdf_spin_unlock_bh(&pdev->tx_queue_spinlock);
-			ol_tx_sched(pdev);
-			qdf_spin_lock_bh(&pdev->tx_queue_spinlock);
+			return true;
 		}
 	}
+
+	return false;
 }
 
 /**
@@ -524,17 +520,20 @@ ol_txrx_peer_tid_unpause_base(
  * @pdev: the physical device object
  * @peer: peer device object
  *
- * Return: None
+ * Return: true if any queue was unpaused and has frames to download
  */
-static void
+static bool
 ol_txrx_peer_unpause_base(
 	struct ol_txrx_pdev_t *pdev,
 	struct ol_txrx_peer_t *peer)
 {
+	bool sched = false;
 	int i;
 
 	for (i = 0; i < QDF_ARRAY_SIZE(peer->txqs); i++)
-		ol_txrx_peer_tid_unpause_base(pdev, peer, i);
+		sched |= ol_txrx_peer_tid_unpause_base(pdev, peer, i);
+
+	return sched;
 }
 
 #ifdef QCA_BAD_PEER_TX_FLOW_CL
@@ -544,17 +543,20 @@ ol_txrx_peer_unpause_base(
  * @pdev: the physical device object
  * @peer: peer device object
  *
- * Return: None
+ * Return: true if any queue was unpaused and has frames to download
  */
-static void
+static bool
 ol_txrx_peer_unpause_but_no_mgmt_q_base(
 	struct ol_txrx_pdev_t *pdev,
 	struct ol_txrx_peer_t *peer)
 {
+	bool sched = false;
 	int i;
 
 	for (i = 0; i < OL_TX_MGMT_TID; i++)
-		ol_txrx_peer_tid_unpause_base(pdev, peer, i);
+		sched |= ol_txrx_peer_tid_unpause_base(pdev, peer, i);
+
+	return sched;
 }
 #endif
 
@@ -562,6 +564,7 @@ void
 ol_txrx_peer_tid_unpause(ol_txrx_peer_handle peer, int tid)
 {
 	struct ol_txrx_pdev_t *pdev = peer->vdev->pdev;
+	bool sched;
 
 	/* TO DO: log the queue unpause */
 
@@ -569,17 +572,19 @@ ol_txrx_peer_tid_unpause(ol_txrx_peer_handle peer, int tid)
 	TX_SCHED_DEBUG_PRINT("Enter");
 	qdf_spin_lock_bh(&pdev->tx_queue_spinlock);
 
-	if (tid == -1) {
-		int i;
-
-		for (i = 0; i < QDF_ARRAY_SIZE(peer->txqs); i++)
-			ol_txrx_peer_tid_unpause_base(pdev, peer, i);
-
-	} else {
-		ol_txrx_peer_tid_unpause_base(pdev, peer, tid);
-	}
+	if (tid == -1)
+		sched = ol_txrx_peer_unpause_base(pdev, peer);
+	else
+		sched = ol_txrx_peer_tid_unpause_base(pdev, peer, tid);
 
 	qdf_spin_unlock_bh(&pdev->tx_queue_spinlock);
+
+	/*
+	 * Now that there are new tx frames available to download, invoke
+	 * the scheduling function, to see if it wants to download them.
+	 */
+	if (sched)
+		ol_tx_sched(pdev);
 	TX_SCHED_DEBUG_PRINT("Leave");
 }
 
@@ -629,6 +634,7 @@ void ol_txrx_vdev_unpause(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		(struct ol_txrx_vdev_t *)ol_txrx_get_vdev_from_vdev_id(vdev_id);
 	struct ol_txrx_pdev_t *pdev;
 	struct ol_txrx_peer_t *peer;
+	bool sched = false;
 
 	/* TO DO: log the queue unpause */
 	/* acquire the mutex lock, since we'll be modifying the queues */
@@ -648,17 +654,21 @@ void ol_txrx_vdev_unpause(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	TAILQ_FOREACH(peer, &vdev->peer_list, peer_list_elem) {
 		if (pause_type == PAUSE_TYPE_CHOP) {
 			if (!(peer->is_tdls_peer && peer->tdls_offchan_enabled))
-				ol_txrx_peer_unpause_base(pdev, peer);
+				sched |= ol_txrx_peer_unpause_base(pdev, peer);
 		} else if (pause_type == PAUSE_TYPE_CHOP_TDLS_OFFCHAN) {
 			if (peer->is_tdls_peer && peer->tdls_offchan_enabled)
-				ol_txrx_peer_unpause_base(pdev, peer);
+				sched |= ol_txrx_peer_unpause_base(pdev, peer);
 		} else {
-			ol_txrx_peer_unpause_base(pdev, peer);
+			sched |= ol_txrx_peer_unpause_base(pdev, peer);
 		}
 	}
 	qdf_spin_unlock_bh(&pdev->tx_queue_spinlock);
 	qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
 
+	/* run the scheduler once for all the peers of the vdev */
+	if (sched)
+		ol_tx_sched(pdev);
+
 	TX_SCHED_DEBUG_PRINT("Leave");
 }
 
@@ -807,6 +817,7 @@ void
 ol_txrx_peer_unpause_but_no_mgmt_q(ol_txrx_peer_handle peer)
 {
 	struct ol_txrx_pdev_t *pdev = peer->vdev->pdev;
+	bool sched;
 
 	/* TO DO: log the queue pause */
 
@@ -814,9 +825,11 @@ ol_txrx_peer_unpause_but_no_mgmt_q(ol_txrx_peer_handle peer)
 	TX_SCHED_DEBUG_PRINT("Enter");
 	qdf_spin_lock_bh(&pdev->tx_queue_spinlock);
 
-	ol_txrx_peer_unpause_but_no_mgmt_q_base(pdev, peer);
+	sched = ol_txrx_peer_unpause_but_no_mgmt_q_base(pdev, peer);
 
 	qdf_spin_unlock_bh(&pdev->tx_queue_spinlock);
+	if (sched)
+		ol_tx_sched(pdev);
 	TX_SCHED_DEBUG_PRINT("Leave");
 }
 
@@ -30,6 +30,7 @@
 #include <ol_txrx.h>
 #include <qdf_types.h>
 #include <qdf_mem.h>         /* qdf_os_mem_alloc_consistent et al */
+#include <qdf_util.h>        /* qdf_find_first_bit */
 #include <cdp_txrx_handle.h>
 #if defined(CONFIG_HL_SUPPORT)
 
@@ -93,14 +94,30 @@ typedef TAILQ_HEAD(ol_tx_frms_queue_list_s, ol_tx_frms_queue_t)
 	 *    Move the tx queue to the back of the list of tx queues for this
 	 *    TID.
 	 *    Send no more frames than the limit specified for the TID.
+	 * 3. Deficit-round-robin scheduler:
+	 *    Keep a bitmap of the categories which have tx queues, and
+	 *    find the next one to serve with a single find first bit.
+	 *    Each turn grants the category its quantum of credits on top of
+	 *    what it did not use in its previous turns.
+	 *    The category keeps the turn until its deficit is used up or it
+	 *    cannot send, so each backlogged category gets a share of the
+	 *    credit proportional to its quantum.
+	 *    Within a category, serve the head tx queue and move it to the
+	 *    back of the list, as the WRR scheduler does.
+	 *    Hand out all the available credit in one selection.
 	 */
 #define OL_TX_SCHED_RR  1
 #define OL_TX_SCHED_WRR_ADV 2
+#define OL_TX_SCHED_DRR 3
 
 #ifndef OL_TX_SCHED
+#ifdef WLAN_HL_TX_SCHED_DRR
+#define OL_TX_SCHED OL_TX_SCHED_DRR
+#else
 	/*#define OL_TX_SCHED OL_TX_SCHED_RR*/
 #define OL_TX_SCHED OL_TX_SCHED_WRR_ADV /* default */
 #endif
+#endif
 
 
 #if OL_TX_SCHED == OL_TX_SCHED_RR
@@ -142,6 +159,23 @@ typedef TAILQ_HEAD(ol_tx_frms_queue_list_s, ol_tx_frms_queue_t)
 #define ol_tx_sched_discard_select_category \
 		ol_tx_sched_discard_select_category_wrr_adv
 
+#elif OL_TX_SCHED == OL_TX_SCHED_DRR
+
+#define ol_tx_sched_drr_t ol_tx_sched_t
+
+#define OL_TX_SCHED_NUM_CATEGORIES OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES
+
+#define ol_tx_sched_init                ol_tx_sched_init_drr
+#define ol_tx_sched_select_init(pdev)   /* no-op */
+#define ol_tx_sched_select_batch        ol_tx_sched_select_batch_drr
+#define ol_tx_sched_txq_enqueue         ol_tx_sched_txq_enqueue_drr
+#define ol_tx_sched_txq_deactivate      ol_tx_sched_txq_deactivate_drr
+#define ol_tx_sched_category_tx_queues  ol_tx_sched_category_tx_queues_drr
+#define ol_tx_sched_txq_discard         ol_tx_sched_txq_discard_drr
+#define ol_tx_sched_category_info       ol_tx_sched_category_info_drr
+#define ol_tx_sched_discard_select_category \
+		ol_tx_sched_discard_select_category_drr
+
 #else
 
 #error Unknown OL TX SCHED specification
@@ -1207,6 +1241,706 @@ void ol_tx_sched_stats_clear(struct ol_txrx_pdev_t *pdev)
 
 #endif /* OL_TX_SCHED == OL_TX_SCHED_WRR_ADV */
 
+/*--- deficit round robin scheduler -----------------------------------------*/
+#ifdef WLAN_HL_TX_SCHED_DRR
+
+void ol_tx_sched_drr_init(struct ol_tx_sched_drr_round *round, u_int8_t num,
+			  const u_int32_t *quantum)
+{
+	qdf_mem_zero(round, sizeof(*round));
+	round->num = QDF_MIN(num, (u_int8_t)OL_TX_SCHED_DRR_MAX_CATEGORIES);
+	qdf_mem_copy(round->quantum, quantum,
+		     round->num * sizeof(*quantum));
+}
+
+/**
+ * ol_tx_sched_drr_find() - find the first active category from a position
+ * @round: round robin state
+ * @from: category to start the search from, wrapping around at the end
+ *
+ * Return: category index, round->num if no category is active
+ */
+static u_int8_t
+ol_tx_sched_drr_find(struct ol_tx_sched_drr_round *round, u_int8_t from)
+{
+	unsigned long bits;
+
+	if (from >= round->num)
+		from = 0;
+
+	bits = round->active & ~((1UL << from) - 1);
+	if (!bits)
+		bits = round->active;
+
+	return qdf_find_first_bit(&bits, round->num);
+}
+
+int ol_tx_sched_drr_next(struct ol_tx_sched_drr_round *round)
+{
+	if (!round->active)
+		return -1;
+
+	if (!(round->active & (1UL << round->cur))) {
+		round->cur = ol_tx_sched_drr_find(round, round->cur);
+		round->charged = false;
+	} else if (round->charged && round->deficit[round->cur] <= 0) {
+		round->cur = ol_tx_sched_drr_find(round, round->cur + 1);
+		round->charged = false;
+	}
+
+	if (!round->charged) {
+		round->deficit[round->cur] += round->quantum[round->cur];
+		round->charged = true;
+	}
+
+	return round->cur;
+}
+
+void ol_tx_sched_drr_charge(struct ol_tx_sched_drr_round *round, int cat,
+			    u_int32_t used, bool backlogged)
+{
+	if (!backlogged) {
+		ol_tx_sched_drr_deactivate(round, cat);
+		return;
+	}
+
+	round->deficit[cat] -= used;
+	if (!used || round->deficit[cat] <= 0) {
+		/* pass the turn, the next call looks from the next category */
+		round->cur = cat + 1;
+		round->charged = false;
+	}
+}
+
+#endif /* WLAN_HL_TX_SCHED_DRR */
+
+#if OL_TX_SCHED == OL_TX_SCHED_DRR
+
+/*--- definitions ---*/
+
+struct ol_tx_sched_drr_category_info_t {
+	struct {
+		u_int32_t credit_threshold;
+		u_int16_t send_limit;
+		int credit_reserve;
+		int discard_weight;
+	} specs;
+	struct {
+		int frms;
+		int bytes;
+		ol_tx_frms_queue_list head;
+	} state;
+#ifdef DEBUG_HL_LOGGING
+	struct {
+		char *cat_name;
+		unsigned int queued;
+		unsigned int dispatched;
+		unsigned int discard;
+	} stat;
+#endif
+};
+
+#define OL_TX_SCHED_DRR_CAT_CFG_SPEC(cat, \
+		quantum, \
+		credit_threshold, \
+		send_limit, \
+		credit_reserve, \
+		discard_weights) \
+		enum { OL_TX_SCHED_DRR_ ## cat ## _QUANTUM = \
+			(quantum) }; \
+		enum { OL_TX_SCHED_DRR_ ## cat ## _CREDIT_THRESHOLD = \
+			(credit_threshold) }; \
+		enum { OL_TX_SCHED_DRR_ ## cat ## _SEND_LIMIT = \
+			(send_limit) }; \
+		enum { OL_TX_SCHED_DRR_ ## cat ## _CREDIT_RESERVE = \
+			(credit_reserve) }; \
+		enum { OL_TX_SCHED_DRR_ ## cat ## _DISCARD_WEIGHT = \
+			(discard_weights) };
+/*
+ * The quantum is the number of credits a category may use per turn, so
+ * the long term share of each backlogged category is its quantum over the
+ * sum of the quanta of the backlogged categories. The credit threshold,
+ * send limit, credit reserve and discard weights are the same as for the
+ * advanced WRR scheduler.
+ */
+/*                                                   send
+ *                                          credit  limit credit disc
+ *                                  quantum thresh (frms) reserv  wts
+ */
+#ifdef HIF_SDIO
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(VO,           64,     17,    24,     0,  1);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(VI,           32,     17,    16,     1,  4);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(BE,           16,     17,    16,     1,  8);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(BK,            8,      6,     6,     1,  8);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(NON_QOS_DATA, 16,     17,    16,     1,  8);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(UCAST_MGMT,   16,      1,     4,     0,  1);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(MCAST_DATA,    8,     17,     4,     1,  4);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(MCAST_MGMT,   16,      1,     4,     0,  1);
+#else
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(VO,           64,     16,    24,     0,  1);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(VI,           32,     16,    16,     1,  4);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(BE,           16,     12,    12,     1,  8);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(BK,            8,      6,     6,     1,  8);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(NON_QOS_DATA,  8,      6,     4,     1,  8);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(UCAST_MGMT,   16,      1,     4,     0,  1);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(MCAST_DATA,    8,     16,     4,     1,  4);
+OL_TX_SCHED_DRR_CAT_CFG_SPEC(MCAST_MGMT,   16,      1,     4,     0,  1);
+#endif
+
+#ifdef DEBUG_HL_LOGGING
+
+#define OL_TX_SCHED_DRR_CAT_STAT_INIT(category, scheduler)                  \
+	do {                                                                 \
+		scheduler->categories[OL_TX_SCHED_WRR_ADV_CAT_ ## category]  \
+		.stat.queued = 0;					\
+		scheduler->categories[OL_TX_SCHED_WRR_ADV_CAT_ ## category]  \
+		.stat.discard = 0;					\
+		scheduler->categories[OL_TX_SCHED_WRR_ADV_CAT_ ## category]  \
+		.stat.dispatched = 0;					\
+		scheduler->categories[OL_TX_SCHED_WRR_ADV_CAT_ ## category]  \
+		.stat.cat_name = #category;				\
+	} while (0)
+#define OL_TX_SCHED_DRR_CAT_STAT_INC_QUEUED(category, frms)                 \
+	category->stat.queued += frms;
+#define OL_TX_SCHED_DRR_CAT_STAT_INC_DISCARD(category, frms)                \
+	category->stat.discard += frms;
+#define OL_TX_SCHED_DRR_CAT_STAT_INC_DISPATCHED(category, frms)             \
+	category->stat.dispatched += frms;
+#define OL_TX_SCHED_DRR_CAT_STAT_DUMP(scheduler)                            \
+	ol_tx_sched_drr_cat_stat_dump(scheduler)
+#define OL_TX_SCHED_DRR_CAT_CUR_STATE_DUMP(scheduler)                       \
+	ol_tx_sched_drr_cat_cur_state_dump(scheduler)
+#define OL_TX_SCHED_DRR_CAT_STAT_CLEAR(scheduler)                           \
+	ol_tx_sched_drr_cat_stat_clear(scheduler)
+
+#else   /* DEBUG_HL_LOGGING */
+
+#define OL_TX_SCHED_DRR_CAT_STAT_INIT(category, scheduler)
+#define OL_TX_SCHED_DRR_CAT_STAT_INC_QUEUED(category, frms)
+#define OL_TX_SCHED_DRR_CAT_STAT_INC_DISCARD(category, frms)
+#define OL_TX_SCHED_DRR_CAT_STAT_INC_DISPATCHED(category, frms)
+#define OL_TX_SCHED_DRR_CAT_STAT_DUMP(scheduler)
+#define OL_TX_SCHED_DRR_CAT_CUR_STATE_DUMP(scheduler)
+#define OL_TX_SCHED_DRR_CAT_STAT_CLEAR(scheduler)
+
+#endif  /* DEBUG_HL_LOGGING */
+
+#define OL_TX_SCHED_DRR_CAT_CFG_STORE(category, scheduler, quanta) \
+	do { \
+		quanta[OL_TX_SCHED_WRR_ADV_CAT_ ## category] = \
+		OL_TX_SCHED_DRR_ ## category ## _QUANTUM; \
+		scheduler->categories[OL_TX_SCHED_WRR_ADV_CAT_ ## category] \
+		.specs.credit_threshold = \
+		OL_TX_SCHED_DRR_ ## category ## _CREDIT_THRESHOLD; \
+		scheduler->categories[OL_TX_SCHED_WRR_ADV_CAT_ ## category] \
+		.specs.send_limit = \
+		OL_TX_SCHED_DRR_ ## category ## _SEND_LIMIT; \
+		scheduler->categories[OL_TX_SCHED_WRR_ADV_CAT_ ## category] \
+		.specs.credit_reserve = \
+		OL_TX_SCHED_DRR_ ## category ## _CREDIT_RESERVE; \
+		scheduler->categories[OL_TX_SCHED_WRR_ADV_CAT_ ## category] \
+		.specs.discard_weight = \
+		OL_TX_SCHED_DRR_ ## category ## _DISCARD_WEIGHT; \
+		OL_TX_SCHED_DRR_CAT_STAT_INIT(category, scheduler); \
+	} while (0)
+
+QDF_COMPILE_TIME_ASSERT(ol_tx_sched_drr_num_categories,
+			OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES <=
+			OL_TX_SCHED_DRR_MAX_CATEGORIES);
+
+struct ol_tx_sched_drr_t {
+	struct ol_tx_sched_drr_round round;
+	struct ol_tx_sched_drr_category_info_t
+		categories[OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES];
+};
+
+#define OL_TX_AIFS_DEFAULT_VO   2
+#define OL_TX_AIFS_DEFAULT_VI   2
+#define OL_TX_AIFS_DEFAULT_BE   3
+#define OL_TX_AIFS_DEFAULT_BK   7
+#define OL_TX_CW_MIN_DEFAULT_VO   3
+#define OL_TX_CW_MIN_DEFAULT_VI   7
+#define OL_TX_CW_MIN_DEFAULT_BE   15
+#define OL_TX_CW_MIN_DEFAULT_BK   15
+
+/*--- functions ---*/
+
+#ifdef DEBUG_HL_LOGGING
+static void ol_tx_sched_drr_cat_stat_dump(struct ol_tx_sched_drr_t *scheduler)
+{
+	int i;
+
+	txrx_nofl_info("Scheduler Stats:");
+	txrx_nofl_info("====category(CRR,CRT,QTM): Queued  Discard  Dequeued  frms  deficit===");
+	for (i = 0; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; ++i) {
+		txrx_nofl_info("%12s(%2d, %2d, %2u):  %6d  %7d  %8d  %4d  %7d",
+			       scheduler->categories[i].stat.cat_name,
+			       scheduler->categories[i].specs.credit_reserve,
+			       scheduler->categories[i].specs.
+					credit_threshold,
+			       scheduler->round.quantum[i],
+			       scheduler->categories[i].stat.queued,
+			       scheduler->categories[i].stat.discard,
+			       scheduler->categories[i].stat.dispatched,
+			       scheduler->categories[i].state.frms,
+			       scheduler->round.deficit[i]);
+	}
+}
+
+static void
+ol_tx_sched_drr_cat_cur_state_dump(struct ol_tx_sched_drr_t *scheduler)
+{
+	int i;
+
+	txrx_nofl_info("Scheduler State Snapshot: turn %d",
+		       scheduler->round.cur);
+	txrx_nofl_info("====category(CRR,CRT,QTM): IS_Active  Pend_Frames  Pend_bytes  deficit===");
+	for (i = 0; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; ++i) {
+		txrx_nofl_info("%12s(%2d, %2d, %2u):  %9d  %11d  %10d  %7d",
+			       scheduler->categories[i].stat.cat_name,
+			       scheduler->categories[i].specs.credit_reserve,
+			       scheduler->categories[i].specs.
+					credit_threshold,
+			       scheduler->round.quantum[i],
+			       !!(scheduler->round.active & (1UL << i)),
+			       scheduler->categories[i].state.frms,
+			       scheduler->categories[i].state.bytes,
+			       scheduler->round.deficit[i]);
+	}
+}
+
+static void
+ol_tx_sched_drr_cat_stat_clear(struct ol_tx_sched_drr_t *scheduler)
+{
+	int i;
+
+	for (i = 0; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; ++i) {
+		scheduler->categories[i].stat.queued = 0;
+		scheduler->categories[i].stat.discard = 0;
+		scheduler->categories[i].stat.dispatched = 0;
+	}
+}
+
+#endif
+
+/**
+ * ol_tx_sched_drr_select_txq() - take a tx queue whose group has credit
+ * @pdev: Pointer to PDEV structure.
+ * @category: category to take the tx queue from
+ * @credit: credit available
+ * @txq_credit: credit available to the tx queue group
+ *
+ * The tx queue is removed from the category list. If no tx queue group of
+ * the category has more credit than the category reserve, the list is left
+ * as it was.
+ *
+ * Return: tx queue, or NULL if no tx queue can be served
+ */
+static struct ol_tx_frms_queue_t *
+ol_tx_sched_drr_select_txq(struct ol_txrx_pdev_t *pdev,
+			   struct ol_tx_sched_drr_category_info_t *category,
+			   u_int32_t credit, u_int32_t *txq_credit)
+{
+	struct ol_tx_frms_queue_t *txq, *first_txq = NULL;
+
+	txq = TAILQ_FIRST(&category->state.head);
+	while (txq) {
+		TAILQ_REMOVE(&category->state.head, txq, list_elem);
+		*txq_credit = ol_tx_txq_group_credit_limit(pdev, txq, credit);
+		if (*txq_credit > category->specs.credit_reserve)
+			return txq;
+
+		/*
+		 * Current txq belongs to a group which does not have enough
+		 * credits, try the next txq of the category.
+		 */
+		if (!ol_tx_if_iterate_next_txq(first_txq, txq)) {
+			TAILQ_INSERT_HEAD(&category->state.head, txq,
+					  list_elem);
+			break;
+		}
+		if (!first_txq)
+			first_txq = txq;
+		TAILQ_INSERT_TAIL(&category->state.head, txq, list_elem);
+		txq = TAILQ_FIRST(&category->state.head);
+	}
+
+	return NULL;
+}
+
+/*
+ * The scheduler sync spinlock has been acquired outside this function,
+ * so there is no need to worry about mutex within this function.
+ *
+ * Unlike the WRR scheduler, a single call hands out all the credit it is
+ * given, turn after turn, until no category can use it. The round robin
+ * state is kept across calls, so a turn that ran out of credit is resumed
+ * when more credit arrives.
+ */
+static int
+ol_tx_sched_select_batch_drr(
+	struct ol_txrx_pdev_t *pdev,
+	struct ol_tx_sched_ctx *sctx,
+	u_int32_t credit)
+{
+	struct ol_tx_sched_drr_t *scheduler = pdev->tx_sched.scheduler;
+	struct ol_tx_sched_drr_round *round = &scheduler->round;
+	struct ol_tx_sched_drr_category_info_t *category;
+	struct ol_tx_frms_queue_t *txq;
+	u_int32_t used_credits = 0, txq_credit;
+	int cat, frames, bytes, tx_limit, idle_turns = 0;
+	u_int16_t tx_limit_flag;
+	bool deficit_limited;
+
+	while (used_credits < credit && idle_turns <= round->num) {
+		cat = ol_tx_sched_drr_next(round);
+		if (cat < 0)
+			break;
+
+		category = &scheduler->categories[cat];
+		/* keep the turn until enough credit is available */
+		if (credit - used_credits < category->specs.credit_threshold)
+			break;
+
+		txq = ol_tx_sched_drr_select_txq(pdev, category,
+						 credit - used_credits,
+						 &txq_credit);
+		if (!txq) {
+			ol_tx_sched_drr_charge(round, cat, 0, true);
+			idle_turns++;
+			continue;
+		}
+
+		txq_credit -= category->specs.credit_reserve;
+		deficit_limited = (u_int32_t)round->deficit[cat] < txq_credit;
+		txq_credit = QDF_MIN(txq_credit, (u_int32_t)round->deficit[cat]);
+		tx_limit = ol_tx_bad_peer_dequeue_check(
+				txq, category->specs.send_limit,
+				&tx_limit_flag);
+		frames = ol_tx_dequeue(pdev, txq, &sctx->head,
+				       tx_limit, &txq_credit, &bytes);
+		ol_tx_bad_peer_update_tx_limit(pdev, txq, frames,
+					       tx_limit_flag);
+		OL_TX_SCHED_DRR_CAT_STAT_INC_DISPATCHED(category, frames);
+
+		/* Update used global credits */
+		used_credits += txq_credit;
+		category->state.frms -= frames;
+		category->state.bytes -= bytes;
+		if (txq->frms > 0)
+			TAILQ_INSERT_TAIL(&category->state.head, txq,
+					  list_elem);
+		sctx->frms += frames;
+		ol_tx_txq_group_credit_update(
+			pdev, txq,
+			-ol_tx_txq_update_borrowed_group_credits(pdev, txq,
+								 txq_credit),
+			0);
+
+		/*
+		 * The head frame needs more credit than is available: keep
+		 * the turn, so the category is not skipped every time its
+		 * turn comes up right after the credit ran low.
+		 */
+		if (!frames && tx_limit && !deficit_limited)
+			break;
+
+		ol_tx_sched_drr_charge(round, cat, txq_credit,
+				       !TAILQ_EMPTY(&category->state.head));
+		idle_turns = frames ? 0 : idle_turns + 1;
+	}
+
+	return used_credits;
+}
+
+static inline void
+ol_tx_sched_txq_enqueue_drr(
+	struct ol_txrx_pdev_t *pdev,
+	struct ol_tx_frms_queue_t *txq,
+	int tid,
+	int frms,
+	int bytes)
+{
+	struct ol_tx_sched_drr_t *scheduler = pdev->tx_sched.scheduler;
+	struct ol_tx_sched_drr_category_info_t *category;
+	int cat = pdev->tid_to_ac[tid];
+
+	category = &scheduler->categories[cat];
+	category->state.frms += frms;
+	category->state.bytes += bytes;
+	OL_TX_SCHED_DRR_CAT_STAT_INC_QUEUED(category, frms);
+	if (txq->flag != ol_tx_queue_active) {
+		TAILQ_INSERT_TAIL(&category->state.head, txq, list_elem);
+		ol_tx_sched_drr_activate(&scheduler->round, cat);
+	}
+}
+
+static inline void
+ol_tx_sched_txq_deactivate_drr(
+	struct ol_txrx_pdev_t *pdev,
+	struct ol_tx_frms_queue_t *txq,
+	int tid)
+{
+	struct ol_tx_sched_drr_t *scheduler = pdev->tx_sched.scheduler;
+	struct ol_tx_sched_drr_category_info_t *category;
+	int cat = pdev->tid_to_ac[tid];
+
+	category = &scheduler->categories[cat];
+	category->state.frms -= txq->frms;
+	category->state.bytes -= txq->bytes;
+
+	TAILQ_REMOVE(&category->state.head, txq, list_elem);
+
+	if (TAILQ_EMPTY(&category->state.head))
+		ol_tx_sched_drr_deactivate(&scheduler->round, cat);
+}
+
+static ol_tx_frms_queue_list *
+ol_tx_sched_category_tx_queues_drr(struct ol_txrx_pdev_t *pdev, int cat)
+{
+	struct ol_tx_sched_drr_t *scheduler = pdev->tx_sched.scheduler;
+
+	return &scheduler->categories[cat].state.head;
+}
+
+static int
+ol_tx_sched_discard_select_category_drr(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_sched_drr_t *scheduler = pdev->tx_sched.scheduler;
+	u_int8_t i, cat = 0;
+	int max_score = 0;
+
+	/*
+	 * Drop from the category with the most tx frames present, weighted
+	 * by its priority, as the WRR scheduler does.
+	 */
+	for (i = 0; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; i++) {
+		int score;
+
+		score =
+			scheduler->categories[i].state.frms *
+			scheduler->categories[i].specs.discard_weight;
+		if (max_score == 0 || score > max_score) {
+			max_score = score;
+			cat = i;
+		}
+	}
+	return cat;
+}
+
+static void
+ol_tx_sched_txq_discard_drr(
+	struct ol_txrx_pdev_t *pdev,
+	struct ol_tx_frms_queue_t *txq,
+	int cat, int frames, int bytes)
+{
+	struct ol_tx_sched_drr_t *scheduler = pdev->tx_sched.scheduler;
+	struct ol_tx_sched_drr_category_info_t *category;
+
+	category = &scheduler->categories[cat];
+
+	if (0 == txq->frms)
+		TAILQ_REMOVE(&category->state.head, txq, list_elem);
+
+	category->state.frms -= frames;
+	category->state.bytes -= bytes;
+	OL_TX_SCHED_DRR_CAT_STAT_INC_DISCARD(category, frames);
+	if (TAILQ_EMPTY(&category->state.head))
+		ol_tx_sched_drr_deactivate(&scheduler->round, cat);
+}
+
+static void
+ol_tx_sched_category_info_drr(
+	struct ol_txrx_pdev_t *pdev,
+	int cat, int *active,
+	int *frms, int *bytes)
+{
+	struct ol_tx_sched_drr_t *scheduler = pdev->tx_sched.scheduler;
+	struct ol_tx_sched_drr_category_info_t *category;
+
+	category = &scheduler->categories[cat];
+	*active = !!(scheduler->round.active & (1UL << cat));
+	*frms = category->state.frms;
+	*bytes = category->state.bytes;
+}
+
+/**
+ * ol_tx_sched_drr_param_update() - update the DRR TX sched params
+ * @pdev: Pointer to PDEV structure.
+ * @scheduler: Pointer to tx scheduler.
+ *
+ * Update the credit threshold, send limit, credit reserve and discard
+ * weight of each category if they are specified in the ini file by user.
+ * The WRR skip weight has no DRR equivalent and only tells whether the
+ * category is tuned.
+ *
+ * Return: none
+ */
+static void ol_tx_sched_drr_param_update(struct ol_txrx_pdev_t *pdev,
+					 struct ol_tx_sched_drr_t *scheduler)
+{
+	int i;
+
+	for (i = OL_TX_SCHED_WRR_ADV_CAT_BE;
+		i <= OL_TX_SCHED_WRR_ADV_CAT_VO; i++) {
+		if (!ol_cfg_get_wrr_skip_weight(pdev->ctrl_pdev, i))
+			continue;
+
+		scheduler->categories[i].specs.credit_threshold =
+			ol_cfg_get_credit_threshold(pdev->ctrl_pdev, i);
+		scheduler->categories[i].specs.send_limit =
+			ol_cfg_get_send_limit(pdev->ctrl_pdev, i);
+		scheduler->categories[i].specs.credit_reserve =
+			ol_cfg_get_credit_reserve(pdev->ctrl_pdev, i);
+		scheduler->categories[i].specs.discard_weight =
+			ol_cfg_get_discard_weight(pdev->ctrl_pdev, i);
+
+		QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_INFO,
+			  "cat %d update: %d, %d, %d, %d", i,
+			  scheduler->categories[i].specs.credit_threshold,
+			  scheduler->categories[i].specs.send_limit,
+			  scheduler->categories[i].specs.credit_reserve,
+			  scheduler->categories[i].specs.discard_weight);
+	}
+}
+
+static void *
+ol_tx_sched_init_drr(
+		struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_sched_drr_t *scheduler;
+	u_int32_t quantum[OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES];
+	int i;
+
+	scheduler = qdf_mem_malloc(sizeof(struct ol_tx_sched_drr_t));
+	if (!scheduler)
+		return scheduler;
+
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(VO, scheduler, quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(VI, scheduler, quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(BE, scheduler, quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(BK, scheduler, quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(NON_QOS_DATA, scheduler, quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(UCAST_MGMT, scheduler, quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(MCAST_DATA, scheduler, quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(MCAST_MGMT, scheduler, quantum);
+
+	ol_tx_sched_drr_param_update(pdev, scheduler);
+
+	for (i = 0; i < OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES; i++)
+		TAILQ_INIT(&scheduler->categories[i].state.head);
+
+	ol_tx_sched_drr_init(&scheduler->round,
+			     OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES, quantum);
+
+	return scheduler;
+}
+
+/* WMM parameters are suppposed to be passed when associate with AP.
+ * According to AIFS+CWMin, the function maps each queue to one of four default
+ * settings of the scheduler, ie. VO, VI, BE, or BK.
+ */
+void
+ol_txrx_set_wmm_param(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
+		      struct ol_tx_wmm_param_t wmm_param)
+{
+	struct ol_txrx_soc_t *soc = cdp_soc_t_to_ol_txrx_soc_t(soc_hdl);
+	ol_txrx_pdev_handle data_pdev =
+				ol_txrx_get_pdev_from_pdev_id(soc, pdev_id);
+	struct ol_tx_sched_drr_t def_cfg;
+	struct ol_tx_sched_drr_t *scheduler =
+					data_pdev->tx_sched.scheduler;
+	u_int32_t i, ac_selected;
+	u_int32_t  weight[QCA_WLAN_AC_ALL], default_edca[QCA_WLAN_AC_ALL];
+	u_int32_t quantum[OL_TX_SCHED_WRR_ADV_NUM_CATEGORIES];
+
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(VO, (&def_cfg), quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(VI, (&def_cfg), quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(BE, (&def_cfg), quantum);
+	OL_TX_SCHED_DRR_CAT_CFG_STORE(BK, (&def_cfg), quantum);
+
+	/* default_eca = AIFS + CWMin */
+	default_edca[OL_TX_SCHED_WRR_ADV_CAT_VO] =
+		OL_TX_AIFS_DEFAULT_VO + OL_TX_CW_MIN_DEFAULT_VO;
+	default_edca[OL_TX_SCHED_WRR_ADV_CAT_VI] =
+		OL_TX_AIFS_DEFAULT_VI + OL_TX_CW_MIN_DEFAULT_VI;
+	default_edca[OL_TX_SCHED_WRR_ADV_CAT_BE] =
+		OL_TX_AIFS_DEFAULT_BE + OL_TX_CW_MIN_DEFAULT_BE;
+	default_edca[OL_TX_SCHED_WRR_ADV_CAT_BK] =
+		OL_TX_AIFS_DEFAULT_BK + OL_TX_CW_MIN_DEFAULT_BK;
+
+	weight[OL_TX_SCHED_WRR_ADV_CAT_VO] =
+		wmm_param.ac[QCA_WLAN_AC_VO].aifs +
+				wmm_param.ac[QCA_WLAN_AC_VO].cwmin;
+	weight[OL_TX_SCHED_WRR_ADV_CAT_VI] =
+		wmm_param.ac[QCA_WLAN_AC_VI].aifs +
+				wmm_param.ac[QCA_WLAN_AC_VI].cwmin;
+	weight[OL_TX_SCHED_WRR_ADV_CAT_BK] =
+		wmm_param.ac[QCA_WLAN_AC_BK].aifs +
+				wmm_param.ac[QCA_WLAN_AC_BK].cwmin;
+	weight[OL_TX_SCHED_WRR_ADV_CAT_BE] =
+		wmm_param.ac[QCA_WLAN_AC_BE].aifs +
+				wmm_param.ac[QCA_WLAN_AC_BE].cwmin;
+
+	qdf_spin_lock_bh(&data_pdev->tx_queue_spinlock);
+	for (i = 0; i < QCA_WLAN_AC_ALL; i++) {
+		if (default_edca[OL_TX_SCHED_WRR_ADV_CAT_VO] >= weight[i])
+			ac_selected = OL_TX_SCHED_WRR_ADV_CAT_VO;
+		else if (default_edca[OL_TX_SCHED_WRR_ADV_CAT_VI] >= weight[i])
+			ac_selected = OL_TX_SCHED_WRR_ADV_CAT_VI;
+		else if (default_edca[OL_TX_SCHED_WRR_ADV_CAT_BE] >= weight[i])
+			ac_selected = OL_TX_SCHED_WRR_ADV_CAT_BE;
+		else
+			ac_selected = OL_TX_SCHED_WRR_ADV_CAT_BK;
+
+		scheduler->round.quantum[i] = quantum[ac_selected];
+		scheduler->categories[i].specs.credit_threshold =
+			def_cfg.categories[ac_selected].specs.credit_threshold;
+		scheduler->categories[i].specs.send_limit =
+			def_cfg.categories[ac_selected].specs.send_limit;
+		scheduler->categories[i].specs.credit_reserve =
+			def_cfg.categories[ac_selected].specs.credit_reserve;
+		scheduler->categories[i].specs.discard_weight =
+			def_cfg.categories[ac_selected].specs.discard_weight;
+	}
+	qdf_spin_unlock_bh(&data_pdev->tx_queue_spinlock);
+}
+
+/**
+ * ol_tx_sched_stats_display() - tx sched stats display
+ * @pdev: Pointer to the PDEV structure.
+ *
+ * Return: none.
+ */
+void ol_tx_sched_stats_display(struct ol_txrx_pdev_t *pdev)
+{
+	OL_TX_SCHED_DRR_CAT_STAT_DUMP(pdev->tx_sched.scheduler);
+}
+
+/**
+ * ol_tx_sched_cur_state_display() - tx sched cur stat display
+ * @pdev: Pointer to the PDEV structure.
+ *
+ * Return: none.
+ */
+void ol_tx_sched_cur_state_display(struct ol_txrx_pdev_t *pdev)
+{
+	OL_TX_SCHED_DRR_CAT_CUR_STATE_DUMP(pdev->tx_sched.scheduler);
+}
+
+/**
+ * ol_tx_sched_stats_clear() - reset tx sched stats
+ * @pdev: Pointer to the PDEV structure.
+ *
+ * Return: none.
+ */
+void ol_tx_sched_stats_clear(struct ol_txrx_pdev_t *pdev)
+{
+	OL_TX_SCHED_DRR_CAT_STAT_CLEAR(pdev->tx_sched.scheduler);
+}
+
+#endif /* OL_TX_SCHED == OL_TX_SCHED_DRR */
+
 /*--- congestion control discard --------------------------------------------*/
 
 static struct ol_tx_frms_queue_t *
@@ -1553,6 +2287,28 @@ ol_tx_sched(struct ol_txrx_pdev_t *pdev)
 	TX_SCHED_DEBUG_PRINT("Leave");
 }
 
+#ifdef WLAN_HL_TX_SCHED_DRR_TEST
+u_int32_t
+ol_tx_sched_select(struct ol_txrx_pdev_t *pdev, ol_tx_desc_list *head,
+		   u_int32_t credit)
+{
+	struct ol_tx_sched_ctx sctx;
+	int num_credits;
+
+	TAILQ_INIT(&sctx.head);
+	sctx.frms = 0;
+
+	ol_tx_sched_select_init(pdev);
+	qdf_spin_lock_bh(&pdev->tx_queue_spinlock);
+	num_credits = ol_tx_sched_select_batch(pdev, &sctx, credit);
+	qdf_spin_unlock_bh(&pdev->tx_queue_spinlock);
+
+	TAILQ_CONCAT(head, &sctx.head, tx_desc_list_elem);
+
+	return num_credits;
+}
+#endif /* WLAN_HL_TX_SCHED_DRR_TEST */
+
 void *
 ol_tx_sched_attach(
 	struct ol_txrx_pdev_t *pdev)
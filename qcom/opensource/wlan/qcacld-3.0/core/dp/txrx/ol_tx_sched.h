@@ -54,6 +54,23 @@ ol_tx_sched_notify(
 void
 ol_tx_sched(struct ol_txrx_pdev_t *pdev);
 
+#ifdef WLAN_HL_TX_SCHED_DRR_TEST
+/**
+ * ol_tx_sched_select() - run one selection of the tx scheduler
+ * @pdev: Pointer to PDEV structure.
+ * @head: list the tx descriptors selected are appended to
+ * @credit: credit available
+ *
+ * Unlike ol_tx_sched(), the frames selected are not downloaded to the
+ * target and the target credit is left as it is.
+ *
+ * Return: credit used by the frames selected
+ */
+u_int32_t
+ol_tx_sched_select(struct ol_txrx_pdev_t *pdev, ol_tx_desc_list *head,
+		   u_int32_t credit);
+#endif
+
 u_int16_t
 ol_tx_sched_discard_select(
 		struct ol_txrx_pdev_t *pdev,
@@ -77,6 +94,102 @@ void
 ol_txrx_set_wmm_param(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 		      struct ol_tx_wmm_param_t wmm_param);
 
+#ifdef WLAN_HL_TX_SCHED_DRR
+#define OL_TX_SCHED_DRR_MAX_CATEGORIES 8
+
+/**
+ * struct ol_tx_sched_drr_round - deficit round robin state
+ * @active: bitmap of categories which have tx queues to download
+ * @num: number of categories
+ * @cur: category holding the current turn
+ * @charged: the quantum of the current turn was already granted
+ * @quantum: credits granted to each category per turn
+ * @deficit: credits each category may still use in its turn
+ *
+ * The next category to serve is found with one find first bit on the
+ * active bitmap, so selection does not depend on the number of categories
+ * or tx queues.
+ */
+struct ol_tx_sched_drr_round {
+	unsigned long active;
+	u_int8_t num;
+	u_int8_t cur;
+	bool charged;
+	u_int32_t quantum[OL_TX_SCHED_DRR_MAX_CATEGORIES];
+	int32_t deficit[OL_TX_SCHED_DRR_MAX_CATEGORIES];
+};
+
+/**
+ * ol_tx_sched_drr_init() - initialize a deficit round robin state
+ * @round: round robin state
+ * @num: number of categories, at most OL_TX_SCHED_DRR_MAX_CATEGORIES
+ * @quantum: credits granted to each category per turn
+ *
+ * Return: None
+ */
+void ol_tx_sched_drr_init(struct ol_tx_sched_drr_round *round, u_int8_t num,
+			  const u_int32_t *quantum);
+
+/**
+ * ol_tx_sched_drr_next() - pick the category to serve
+ * @round: round robin state
+ *
+ * The current category keeps the turn until its deficit is used up. The
+ * turn then passes to the next active category, which is granted its
+ * quantum.
+ *
+ * Return: category index, or -1 if no category is active
+ */
+int ol_tx_sched_drr_next(struct ol_tx_sched_drr_round *round);
+
+/**
+ * ol_tx_sched_drr_charge() - charge a category for the credits it used
+ * @round: round robin state
+ * @cat: category which was served
+ * @used: credits used
+ * @backlogged: the category still has tx queues to download
+ *
+ * A category which could not use any credit passes the turn, keeping its
+ * deficit, so a frame larger than the deficit is sent after the deficit
+ * grew over enough turns.
+ *
+ * Return: None
+ */
+void ol_tx_sched_drr_charge(struct ol_tx_sched_drr_round *round, int cat,
+			    u_int32_t used, bool backlogged);
+
+/**
+ * ol_tx_sched_drr_activate() - mark a category as having tx queues
+ * @round: round robin state
+ * @cat: category
+ *
+ * Return: None
+ */
+static inline void
+ol_tx_sched_drr_activate(struct ol_tx_sched_drr_round *round, int cat)
+{
+	round->active |= 1UL << cat;
+}
+
+/**
+ * ol_tx_sched_drr_deactivate() - mark a category as having no tx queues
+ * @round: round robin state
+ * @cat: category
+ *
+ * An idle category does not accumulate deficit.
+ *
+ * Return: None
+ */
+static inline void
+ol_tx_sched_drr_deactivate(struct ol_tx_sched_drr_round *round, int cat)
+{
+	round->active &= ~(1UL << cat);
+	round->deficit[cat] = 0;
+	if (round->cur == cat)
+		round->charged = false;
+}
+#endif /* WLAN_HL_TX_SCHED_DRR */
+
 #else
 
 static inline void
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_trace.h"
+#include "ol_cfg.h"
+#include "ol_txrx_types.h"
+#include "ol_txrx.h"
+#include "ol_tx_queue.h"
+#include "ol_tx_sched.h"
+#include "ol_tx_sched_test.h"
+
+/* the VO, VI, BE and BK categories, tid n goes to category n */
+#define ut_drr_num_cat 4
+#define ut_drr_depth 64
+#define ut_drr_ticks 1000
+#define ut_drr_infinite 0xffffffff
+/* largest credit threshold of the four categories */
+#define ut_drr_max_threshold 17
+
+#define ut_drr_assert(cond) \
+	do { \
+		if (!(cond)) { \
+			qdf_nofl_alert("FAIL: %s (%s:%d)", #cond, \
+				       __func__, __LINE__); \
+			errors++; \
+		} \
+	} while (0)
+
+/**
+ * struct ut_drr_sim - tx queues of a stub pdev fed by credit arrivals
+ * @pdev: stub pdev the scheduler is attached to
+ * @cfg: configuration of the pdev, no ini tuning
+ * @txq: one tx queue per category
+ * @msdu_info: tid of the frames of each tx queue
+ * @nbuf: frame of each category, shared by its tx descriptors
+ * @desc: tx descriptors of each category
+ * @backlog: frames still to queue per category, ut_drr_infinite if the
+ *	frames sent are queued again
+ * @served: credits used per category
+ * @credit: credit not used yet
+ */
+struct ut_drr_sim {
+	struct ol_txrx_pdev_t *pdev;
+	struct txrx_pdev_cfg_t cfg;
+	struct ol_tx_frms_queue_t txq[ut_drr_num_cat];
+	struct ol_txrx_msdu_info_t msdu_info[ut_drr_num_cat];
+	qdf_nbuf_t nbuf[ut_drr_num_cat];
+	struct ol_tx_desc_t desc[ut_drr_num_cat][ut_drr_depth];
+	uint32_t backlog[ut_drr_num_cat];
+	uint32_t served[ut_drr_num_cat];
+	uint32_t credit;
+};
+
+/* queue a frame to the tx queue of a category, as ol_tx_enqueue() does */
+static void ut_drr_sim_enqueue(struct ut_drr_sim *sim, int cat,
+			       struct ol_tx_desc_t *tx_desc)
+{
+	struct ol_txrx_pdev_t *pdev = sim->pdev;
+	struct ol_tx_frms_queue_t *txq = &sim->txq[cat];
+	struct ol_tx_sched_notify_ctx_t notify_ctx;
+
+	if (sim->backlog[cat] != ut_drr_infinite)
+		sim->backlog[cat]--;
+
+	qdf_spin_lock_bh(&pdev->tx_queue_spinlock);
+	TAILQ_INSERT_TAIL(&txq->head, tx_desc, tx_desc_list_elem);
+	txq->frms++;
+	txq->bytes += qdf_nbuf_len(tx_desc->netbuf);
+
+	notify_ctx.event = OL_TX_ENQUEUE_FRAME;
+	notify_ctx.frames = 1;
+	notify_ctx.bytes = qdf_nbuf_len(tx_desc->netbuf);
+	notify_ctx.txq = txq;
+	notify_ctx.info.tx_msdu_info = &sim->msdu_info[cat];
+	ol_tx_sched_notify(pdev, &notify_ctx);
+	txq->flag = ol_tx_queue_active;
+	qdf_spin_unlock_bh(&pdev->tx_queue_spinlock);
+}
+
+static void ut_drr_sim_destroy(struct ut_drr_sim *sim)
+{
+	struct ol_txrx_pdev_t *pdev = sim->pdev;
+	int cat;
+
+	ol_tx_sched_detach(pdev);
+	ol_tx_badpeer_flow_cl_deinit(pdev);
+	ol_txrx_pdev_grp_stat_destroy(pdev);
+	ol_txrx_pdev_txq_log_destroy(pdev);
+	qdf_spinlock_destroy(&pdev->tx_queue_spinlock);
+	qdf_mem_free(pdev);
+
+	for (cat = 0; cat < ut_drr_num_cat; cat++)
+		if (sim->nbuf[cat])
+			qdf_nbuf_free(sim->nbuf[cat]);
+
+	qdf_mem_free(sim);
+}
+
+static struct ut_drr_sim *ut_drr_sim_create(const uint32_t *backlog)
+{
+	struct ol_txrx_pdev_t *pdev;
+	struct ut_drr_sim *sim;
+	int cat, i;
+
+	sim = qdf_mem_malloc(sizeof(*sim));
+	if (!sim)
+		return NULL;
+
+	pdev = qdf_mem_malloc(sizeof(*pdev));
+	if (!pdev) {
+		qdf_mem_free(sim);
+		return NULL;
+	}
+
+	sim->pdev = pdev;
+	pdev->ctrl_pdev = (struct cdp_cfg *)&sim->cfg;
+	qdf_spinlock_create(&pdev->tx_queue_spinlock);
+	ol_txrx_pdev_txq_log_init(pdev);
+	ol_txrx_pdev_grp_stats_init(pdev);
+	ol_tx_badpeer_flow_cl_init(pdev);
+	pdev->tx_sched.scheduler = ol_tx_sched_attach(pdev);
+	if (!pdev->tx_sched.scheduler) {
+		ut_drr_sim_destroy(sim);
+		return NULL;
+	}
+
+	for (cat = 0; cat < ut_drr_num_cat; cat++) {
+		sim->nbuf[cat] = qdf_nbuf_alloc(NULL, 64, 0, 4, false);
+		if (!sim->nbuf[cat]) {
+			ut_drr_sim_destroy(sim);
+			return NULL;
+		}
+		qdf_nbuf_put_tail(sim->nbuf[cat], 64);
+
+		pdev->tid_to_ac[cat] = cat;
+		sim->msdu_info[cat].htt.info.ext_tid = cat;
+		TAILQ_INIT(&sim->txq[cat].head);
+		sim->txq[cat].flag = ol_tx_queue_empty;
+		/* a vdev queue, so that the queue log looks up no peer */
+		sim->txq[cat].ext_tid = OL_TX_NUM_TIDS;
+
+		sim->backlog[cat] = backlog[cat];
+		for (i = 0; i < ut_drr_depth && sim->backlog[cat]; i++) {
+			sim->desc[cat][i].netbuf = sim->nbuf[cat];
+			ut_drr_sim_enqueue(sim, cat, &sim->desc[cat][i]);
+		}
+	}
+
+	return sim;
+}
+
+static int ut_drr_sim_cat(struct ut_drr_sim *sim, struct ol_tx_desc_t *desc)
+{
+	int cat;
+
+	for (cat = 0; cat < ut_drr_num_cat; cat++)
+		if (desc->netbuf == sim->nbuf[cat])
+			return cat;
+
+	return -1;
+}
+
+/*
+ * hand the credit to ol_tx_sched_select_batch_drr(), then account the
+ * frames selected per category and queue them again while backlogged
+ */
+static uint32_t ut_drr_sim_tick(struct ut_drr_sim *sim, uint32_t arrival)
+{
+	ol_tx_desc_list head;
+	struct ol_tx_desc_t *desc;
+	uint32_t used;
+	int cat;
+
+	TAILQ_INIT(&head);
+	sim->credit += arrival;
+	used = ol_tx_sched_select(sim->pdev, &head, sim->credit);
+	sim->credit -= used;
+
+	while ((desc = TAILQ_FIRST(&head))) {
+		TAILQ_REMOVE(&head, desc, tx_desc_list_elem);
+		cat = ut_drr_sim_cat(sim, desc);
+		if (cat < 0)
+			continue;
+
+		sim->served[cat]++;
+		if (sim->backlog[cat])
+			ut_drr_sim_enqueue(sim, cat, desc);
+	}
+
+	return used;
+}
+
+static uint32_t ut_drr_sim_total(struct ut_drr_sim *sim)
+{
+	uint32_t total = 0;
+	int cat;
+
+	for (cat = 0; cat < ut_drr_num_cat; cat++)
+		total += sim->served[cat];
+
+	return total;
+}
+
+/* share of a category within 5% of its quantum over the quanta given */
+static uint32_t ut_drr_check_share(struct ut_drr_sim *sim, int cat,
+				   uint32_t quantum, uint32_t quanta,
+				   uint32_t total)
+{
+	uint32_t errors = 0, share, expected;
+
+	share = sim->served[cat] * 1000 / total;
+	expected = quantum * 1000 / quanta;
+	qdf_nofl_info("ol_tx_sched_drr cat %d share %u expected %u",
+		      cat, share, expected);
+	ut_drr_assert(share * 100 >= expected * 95 &&
+		      share * 100 <= expected * 105);
+
+	return errors;
+}
+
+static uint32_t ol_tx_sched_drr_test_fairness(void)
+{
+	static const uint32_t backlog[ut_drr_num_cat] = {
+		ut_drr_infinite, ut_drr_infinite,
+		ut_drr_infinite, ut_drr_infinite };
+	uint32_t errors = 0, arrived = 0, total, quanta;
+	struct ut_drr_sim *sim;
+	int tick;
+
+	sim = ut_drr_sim_create(backlog);
+	if (!sim)
+		return 1;
+
+	/* credit trickles in, as from tx completions */
+	for (tick = 0; tick < ut_drr_ticks; tick++) {
+		ut_drr_sim_tick(sim, 5 + tick % 23);
+		arrived += 5 + tick % 23;
+	}
+
+	/* work conserving, only credit short of a threshold may be left */
+	ut_drr_assert(sim->credit < ut_drr_max_threshold);
+
+	total = ut_drr_sim_total(sim);
+	ut_drr_assert(total + sim->credit == arrived);
+
+	/* long term share of the default quanta, VO 64 VI 32 BE 16 BK 8 */
+	quanta = 64 + 32 + 16 + 8;
+	errors += ut_drr_check_share(sim, OL_TX_SCHED_WRR_ADV_CAT_VO, 64,
+				     quanta, total);
+	errors += ut_drr_check_share(sim, OL_TX_SCHED_WRR_ADV_CAT_VI, 32,
+				     quanta, total);
+	errors += ut_drr_check_share(sim, OL_TX_SCHED_WRR_ADV_CAT_BE, 16,
+				     quanta, total);
+	errors += ut_drr_check_share(sim, OL_TX_SCHED_WRR_ADV_CAT_BK, 8,
+				     quanta, total);
+
+	ut_drr_sim_destroy(sim);
+
+	return errors;
+}
+
+static uint32_t ol_tx_sched_drr_test_short_credit(void)
+{
+	uint32_t backlog[ut_drr_num_cat] = { 0 };
+	uint32_t errors = 0, total;
+	struct ut_drr_sim *sim;
+	int tick;
+
+	backlog[OL_TX_SCHED_WRR_ADV_CAT_VO] = ut_drr_infinite;
+	backlog[OL_TX_SCHED_WRR_ADV_CAT_BK] = ut_drr_infinite;
+	sim = ut_drr_sim_create(backlog);
+	if (!sim)
+		return 1;
+
+	/*
+	 * each arrival is below the VO credit threshold but above the BK
+	 * one: VO keeps its turn until enough credit has come in, instead
+	 * of leaving every arrival to BK
+	 */
+	for (tick = 0; tick < ut_drr_ticks; tick++)
+		ut_drr_sim_tick(sim, 10);
+
+	total = ut_drr_sim_total(sim);
+	errors += ut_drr_check_share(sim, OL_TX_SCHED_WRR_ADV_CAT_VO, 64,
+				     64 + 8, total);
+	errors += ut_drr_check_share(sim, OL_TX_SCHED_WRR_ADV_CAT_BK, 8,
+				     64 + 8, total);
+
+	ut_drr_sim_destroy(sim);
+
+	return errors;
+}
+
+static uint32_t ol_tx_sched_drr_test_drain(void)
+{
+	uint32_t backlog[ut_drr_num_cat] = { 0 };
+	ol_tx_desc_list head;
+	uint32_t errors = 0, vo, bk;
+	struct ut_drr_sim *sim;
+	int tick, cat;
+
+	backlog[OL_TX_SCHED_WRR_ADV_CAT_VO] = ut_drr_infinite;
+	backlog[OL_TX_SCHED_WRR_ADV_CAT_BE] = 100;
+	backlog[OL_TX_SCHED_WRR_ADV_CAT_BK] = ut_drr_infinite;
+	sim = ut_drr_sim_create(backlog);
+	if (!sim)
+		return 1;
+
+	for (tick = 0; tick < ut_drr_ticks; tick++)
+		ut_drr_sim_tick(sim, 24);
+
+	vo = sim->served[OL_TX_SCHED_WRR_ADV_CAT_VO];
+	bk = sim->served[OL_TX_SCHED_WRR_ADV_CAT_BK];
+
+	/* the finite backlog drained and its share went to the others */
+	ut_drr_assert(sim->served[OL_TX_SCHED_WRR_ADV_CAT_BE] == 100);
+	ut_drr_assert(!sim->served[OL_TX_SCHED_WRR_ADV_CAT_VI]);
+	ut_drr_assert(vo + bk + sim->credit == ut_drr_ticks * 24 - 100);
+	ut_drr_assert(vo * 100 >= bk * 8 * 95 && vo * 100 <= bk * 8 * 105);
+
+	/* stop queueing, the categories leave the round once drained */
+	for (cat = 0; cat < ut_drr_num_cat; cat++)
+		sim->backlog[cat] = 0;
+	for (tick = 0; tick < ut_drr_depth; tick++)
+		ut_drr_sim_tick(sim, 24);
+
+	ut_drr_assert(!sim->txq[OL_TX_SCHED_WRR_ADV_CAT_VO].frms);
+	ut_drr_assert(!sim->txq[OL_TX_SCHED_WRR_ADV_CAT_BK].frms);
+
+	/* nothing left to serve once every category is drained */
+	TAILQ_INIT(&head);
+	ut_drr_assert(!ol_tx_sched_select(sim->pdev, &head, 1000));
+	ut_drr_assert(TAILQ_EMPTY(&head));
+
+	ut_drr_sim_destroy(sim);
+
+	return errors;
+}
+
+uint32_t ol_tx_sched_drr_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += ol_tx_sched_drr_test_fairness();
+	errors += ol_tx_sched_drr_test_short_credit();
+	errors += ol_tx_sched_drr_test_drain();
+
+	return errors;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __OL_TX_SCHED_TEST
+#define __OL_TX_SCHED_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_HL_TX_SCHED_DRR_TEST
+/**
+ * ol_tx_sched_drr_unit_test() - run the DRR tx scheduler unit test suite
+ *
+ * Attaches the scheduler to a stub pdev, queues frames to one tx queue
+ * per category and feeds simulated credit arrivals to the selection of
+ * ol_tx_sched(). Checks that backlogged categories share the credit in
+ * proportion to their quanta, that no credit is left unused while frames
+ * are queued, that a category short of its credit threshold keeps its
+ * turn, and that drained categories leave the round.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t ol_tx_sched_drr_unit_test(void);
+#else
+static inline uint32_t ol_tx_sched_drr_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_HL_TX_SCHED_DRR_TEST */
+
+#endif /* __OL_TX_SCHED_TEST */
@@ -22,6 +22,367 @@
 #include <wlan_cfg.h>
 #include "dp_swlm.h"
 
+#ifdef WLAN_DP_SWLM_ADAPTIVE
+/**
+ * dp_swlm_ewma() - fold a sample into a Q4 EWMA
+ * @avg: current average, Q4
+ * @sample: new sample
+ *
+ * Returns: new average, Q4
+ */
+static inline uint32_t dp_swlm_ewma(uint32_t avg, uint32_t sample)
+{
+	return avg - (avg >> DP_SWLM_EWMA_SHIFT) +
+		((sample << 4) >> DP_SWLM_EWMA_SHIFT);
+}
+
+void dp_swlm_model_init(struct dp_swlm_model *model)
+{
+	qdf_mem_zero(model, sizeof(*model));
+	model->gap_ewma = DP_SWLM_GAP_MAX << 4;
+	model->burst_ewma = 1 << 4;
+	model->burst_len = 1;
+}
+
+void dp_swlm_model_end_session(struct dp_swlm_model *model)
+{
+	model->session_pkts = 0;
+	model->target_pkts = 0;
+}
+
+void dp_swlm_model_ll_frame(struct dp_swlm_model *model, uint64_t now,
+			    uint32_t slo)
+{
+	dp_swlm_model_end_session(model);
+	model->ll_holdoff_end = now + slo;
+}
+
+enum dp_swlm_decision
+dp_swlm_model_update(struct dp_swlm_model *model, uint64_t now, uint32_t slo)
+{
+	uint32_t gap = DP_SWLM_GAP_MAX;
+	uint32_t expected, target, window;
+
+	if (model->last_ts && now - model->last_ts < DP_SWLM_GAP_MAX)
+		gap = now - model->last_ts;
+	model->last_ts = now;
+	model->gap_ewma = dp_swlm_ewma(model->gap_ewma, gap);
+
+	if (gap <= DP_SWLM_BURST_GAP && model->burst_len < DP_SWLM_MAX_BURST) {
+		model->burst_len++;
+	} else {
+		model->burst_ewma = dp_swlm_ewma(model->burst_ewma,
+						 model->burst_len);
+		model->burst_len = 1;
+	}
+
+	if (now < model->ll_holdoff_end) {
+		dp_swlm_model_end_session(model);
+		return DP_SWLM_FLUSH_HOLDOFF;
+	}
+
+	if (model->session_pkts) {
+		model->session_pkts++;
+		if (now >= model->session_end) {
+			dp_swlm_model_end_session(model);
+			return DP_SWLM_FLUSH_TIME;
+		}
+		if (model->session_pkts >= model->target_pkts) {
+			dp_swlm_model_end_session(model);
+			return DP_SWLM_FLUSH_PKTS;
+		}
+		return DP_SWLM_COALESCE;
+	}
+
+	/* frames expected within the SLO, including the current one */
+	expected = (slo << 4) / (model->gap_ewma ? model->gap_ewma : 1);
+	target = qdf_min(expected, model->burst_ewma >> 4);
+	target = qdf_min(target, (uint32_t)DP_SWLM_MAX_BURST);
+	if (target < 2)
+		return DP_SWLM_FLUSH_SPARSE;
+
+	window = qdf_min(slo, (target * model->gap_ewma) >> 4);
+	model->session_end = now + window;
+	model->session_pkts = 1;
+	model->target_pkts = target;
+
+	return DP_SWLM_COALESCE;
+}
+
+/**
+ * struct dp_swlm_replay_state - frames pending a TCL HP write in a replay
+ * @pending: number of pending frames
+ * @first_ts: timestamp of the oldest pending frame
+ * @sum_ts: sum of the timestamps of the pending frames
+ */
+struct dp_swlm_replay_state {
+	uint32_t pending;
+	uint64_t first_ts;
+	uint64_t sum_ts;
+};
+
+/**
+ * dp_swlm_replay_flush() - account a TCL HP write in a replay
+ * @state: replay state
+ * @now: time of the HP write in us
+ * @res: replay result
+ *
+ * Returns: None
+ */
+static void dp_swlm_replay_flush(struct dp_swlm_replay_state *state,
+				 uint64_t now,
+				 struct dp_swlm_replay_result *res)
+{
+	uint32_t delay = now - state->first_ts;
+
+	res->doorbells++;
+	res->total_delay += state->pending * now - state->sum_ts;
+	if (delay > res->max_delay)
+		res->max_delay = delay;
+
+	state->pending = 0;
+	state->sum_ts = 0;
+}
+
+void dp_swlm_replay(const uint64_t *ts, const uint8_t *ll, uint32_t num,
+		    uint32_t slo, struct dp_swlm_replay_result *res)
+{
+	struct dp_swlm_replay_state state = {0};
+	struct dp_swlm_model model;
+	enum dp_swlm_decision decision;
+	uint64_t timer_end = 0;
+	uint32_t i;
+
+	qdf_mem_zero(res, sizeof(*res));
+	dp_swlm_model_init(&model);
+
+	for (i = 0; i < num; i++) {
+		if (state.pending && ts[i] >= timer_end) {
+			dp_swlm_replay_flush(&state, timer_end, res);
+			dp_swlm_model_end_session(&model);
+		}
+
+		if (ll && ll[i]) {
+			dp_swlm_model_ll_frame(&model, ts[i], slo);
+			decision = DP_SWLM_FLUSH_LL;
+		} else {
+			decision = dp_swlm_model_update(&model, ts[i], slo);
+		}
+
+		if (!state.pending)
+			state.first_ts = ts[i];
+		state.pending++;
+		state.sum_ts += ts[i];
+
+		if (decision == DP_SWLM_COALESCE)
+			timer_end = ts[i] + DP_SWLM_TIMER_US;
+		else
+			dp_swlm_replay_flush(&state, ts[i], res);
+	}
+
+	if (state.pending)
+		dp_swlm_replay_flush(&state, timer_end, res);
+
+	res->pkts = num;
+}
+
+/**
+ * dp_swlm_trace_record() - record a SWLM decision in the ring trace
+ * @tcl: TCL ring params
+ * @now: frame timestamp in us
+ * @decision: enum dp_swlm_decision
+ *
+ * Returns: None
+ */
+static inline void dp_swlm_trace_record(struct dp_swlm_tcl_params *tcl,
+					uint64_t now,
+					enum dp_swlm_decision decision)
+{
+	struct dp_swlm_trace_entry *entry;
+
+	if (!tcl->trace)
+		return;
+
+	entry = &tcl->trace[tcl->trace_idx++ & (DP_SWLM_TRACE_SIZE - 1)];
+	entry->ts = now;
+	entry->gap = qdf_min(tcl->model.gap_ewma >> 4, (uint32_t)0xffff);
+	entry->burst = qdf_min(tcl->model.burst_ewma >> 4, (uint32_t)0xff);
+	entry->decision = decision;
+}
+
+void dp_swlm_tcl_ll_frame(struct dp_soc *soc, uint8_t ring_id)
+{
+	struct dp_swlm_params *params = &soc->swlm.params;
+	struct dp_swlm_tcl_params *tcl = &params->tcl[ring_id];
+	uint64_t now = qdf_get_log_timestamp_usecs();
+
+	dp_swlm_model_ll_frame(&tcl->model, now, params->latency_slo);
+	dp_swlm_trace_record(tcl, now, DP_SWLM_FLUSH_LL);
+	qdf_timer_sync_cancel(&tcl->flush_timer);
+}
+
+/**
+ * dp_swlm_can_tcl_wr_coalesce() - To check if current TCL reg write can be
+ *				   coalesced or not.
+ * @soc: Datapath global soc handle
+ * @tcl_data: priv data for tcl coalescing
+ *
+ * The decision is taken by the arrival model of the TCL ring, see
+ * dp_swlm_model_update().
+ *
+ * Returns: 1 if the current TCL write is to be coalesced
+ *	    0, if the current TCL write is to be processed.
+ */
+static int
+dp_swlm_can_tcl_wr_coalesce(struct dp_soc *soc,
+			    struct dp_swlm_tcl_data *tcl_data)
+{
+	uint64_t curr_time = qdf_get_log_timestamp_usecs();
+	struct dp_swlm *swlm = &soc->swlm;
+	uint8_t rid = tcl_data->ring_id;
+	struct dp_swlm_params *params = &soc->swlm.params;
+	struct dp_swlm_tcl_params *tcl = &params->tcl[rid];
+	enum dp_swlm_decision decision;
+
+	/* the HP of the open window has already been written by the timer */
+	if (tcl->timer_flushed) {
+		tcl->timer_flushed = false;
+		dp_swlm_model_end_session(&tcl->model);
+	}
+
+	decision = dp_swlm_model_update(&tcl->model, curr_time,
+					params->latency_slo);
+	dp_swlm_trace_record(tcl, curr_time, decision);
+
+	switch (decision) {
+	case DP_SWLM_COALESCE:
+		qdf_timer_mod(&tcl->flush_timer, 1);
+		return 1;
+	case DP_SWLM_FLUSH_SPARSE:
+		DP_STATS_INC(swlm, tcl[rid].tput_criteria_fail, 1);
+		break;
+	case DP_SWLM_FLUSH_PKTS:
+		DP_STATS_INC(swlm, tcl[rid].pkts_thresh_reached, 1);
+		break;
+	case DP_SWLM_FLUSH_TIME:
+		DP_STATS_INC(swlm, tcl[rid].time_thresh_reached, 1);
+		break;
+	default:
+		break;
+	}
+
+	qdf_timer_sync_cancel(&tcl->flush_timer);
+
+	return 0;
+}
+
+/**
+ * dp_swlm_print_replay() - print the replay of the traced frames of a ring
+ * @tcl: TCL ring params
+ * @slo: latency SLO in us to replay the frames with
+ * @ts: scratch array for the frame timestamps
+ * @ll: scratch array for the latency sensitive flags
+ *
+ * Returns: None
+ */
+static void dp_swlm_print_replay(struct dp_swlm_tcl_params *tcl, uint32_t slo,
+				 uint64_t *ts, uint8_t *ll)
+{
+	struct dp_swlm_replay_result res;
+	struct dp_swlm_trace_entry *entry;
+	uint32_t num, start, i;
+
+	num = qdf_min(tcl->trace_idx, (uint32_t)DP_SWLM_TRACE_SIZE);
+	start = tcl->trace_idx - num;
+	for (i = 0; i < num; i++) {
+		entry = &tcl->trace[(start + i) & (DP_SWLM_TRACE_SIZE - 1)];
+		ts[i] = entry->ts;
+		ll[i] = entry->decision == DP_SWLM_FLUSH_LL;
+	}
+
+	dp_swlm_replay(ts, ll, num, slo, &res);
+	dp_info("Replay SLO %u us: %u frames, %u HP writes, avg delay %llu us, max delay %u us",
+		slo, res.pkts, res.doorbells,
+		num ? qdf_do_div(res.total_delay, num) : 0, res.max_delay);
+}
+
+/**
+ * dp_print_swlm_model() - Print the SWLM model state and trace replay
+ * @soc: Datapath soc handle
+ * @rid: TCL ring id
+ *
+ * The traced frames are replayed with the configured SLO and with half and
+ * twice of it, to show the doorbell/latency trade-off of the last frames.
+ *
+ * Returns: None
+ */
+static void dp_print_swlm_model(struct dp_soc *soc, uint8_t rid)
+{
+	struct dp_swlm_params *params = &soc->swlm.params;
+	struct dp_swlm_tcl_params *tcl = &params->tcl[rid];
+	uint64_t *ts;
+	uint8_t *ll;
+
+	dp_info("Model: gap %u us, burst %u, SLO %u us",
+		tcl->model.gap_ewma >> 4, tcl->model.burst_ewma >> 4,
+		params->latency_slo);
+
+	if (!tcl->trace)
+		return;
+
+	ts = qdf_mem_malloc(DP_SWLM_TRACE_SIZE * sizeof(*ts));
+	ll = qdf_mem_malloc(DP_SWLM_TRACE_SIZE * sizeof(*ll));
+	if (ts && ll) {
+		dp_swlm_print_replay(tcl, params->latency_slo / 2, ts, ll);
+		dp_swlm_print_replay(tcl, params->latency_slo, ts, ll);
+		dp_swlm_print_replay(tcl, params->latency_slo * 2, ts, ll);
+	}
+
+	qdf_mem_free(ll);
+	qdf_mem_free(ts);
+}
+
+/**
+ * dp_swlm_tcl_model_attach() - attach the SWLM model of a TCL ring
+ * @soc: Datapath global soc handle
+ * @rid: TCL ring id
+ *
+ * Returns: None
+ */
+static void dp_swlm_tcl_model_attach(struct dp_soc *soc, uint8_t rid)
+{
+	struct dp_swlm_tcl_params *tcl = &soc->swlm.params.tcl[rid];
+
+	dp_swlm_model_init(&tcl->model);
+	tcl->timer_flushed = false;
+	tcl->trace_idx = 0;
+	tcl->trace = qdf_mem_malloc(DP_SWLM_TRACE_SIZE * sizeof(*tcl->trace));
+}
+
+/**
+ * dp_swlm_tcl_model_detach() - detach the SWLM model of a TCL ring
+ * @swlm: SWLM data pointer
+ * @rid: TCL ring id
+ *
+ * Returns: None
+ */
+static void dp_swlm_tcl_model_detach(struct dp_swlm *swlm, uint8_t rid)
+{
+	qdf_mem_free(swlm->params.tcl[rid].trace);
+	swlm->params.tcl[rid].trace = NULL;
+}
+
+/**
+ * dp_swlm_tcl_timer_flushed() - note that the timer wrote the TCL HP
+ * @tcl: TCL ring params
+ *
+ * Returns: None
+ */
+static inline void dp_swlm_tcl_timer_flushed(struct dp_swlm_tcl_params *tcl)
+{
+	tcl->timer_flushed = true;
+}
+#else
 /**
  * dp_swlm_is_tput_thresh_reached() - Calculate the current tx and rx TPUT
  *				      and check if it passes the pre-set
@@ -128,6 +489,24 @@ coalescing_fail:
 	return 1;
 }
 
+static inline void dp_print_swlm_model(struct dp_soc *soc, uint8_t rid)
+{
+}
+
+static inline void dp_swlm_tcl_model_attach(struct dp_soc *soc, uint8_t rid)
+{
+}
+
+static inline void dp_swlm_tcl_model_detach(struct dp_swlm *swlm,
+					    uint8_t rid)
+{
+}
+
+static inline void dp_swlm_tcl_timer_flushed(struct dp_swlm_tcl_params *tcl)
+{
+}
+#endif /* WLAN_DP_SWLM_ADAPTIVE */
+
 QDF_STATUS dp_print_swlm_stats(struct dp_soc *soc)
 {
 	struct dp_swlm *swlm = &soc->swlm;
@@ -155,6 +534,11 @@ QDF_STATUS dp_print_swlm_stats(struct dp_soc *soc)
 			swlm->stats.tcl[i].time_thresh_reached);
 		dp_info("Coalesce fail (TPUT sampling fail): %d",
 			swlm->stats.tcl[i].tput_criteria_fail);
+		dp_info("Coalesce fail (latency sensitive DSCP): %d",
+			swlm->stats.tcl[i].ll_dscp);
+		dp_info("Coalesce fail (burst coalesced): %d",
+			swlm->stats.tcl[i].pkts_thresh_reached);
+		dp_print_swlm_model(soc, i);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -191,6 +575,7 @@ static void dp_swlm_tcl_flush_timer(void *arg)
 
 	DP_STATS_INC(swlm, tcl[tcl->ring_id].timer_flush_success, 1);
 	hal_srng_access_end(soc->hal_soc, hal_ring_hdl);
+	dp_swlm_tcl_timer_flushed(tcl);
 	hif_pm_runtime_put(soc->hif_handle, RTPM_ID_DW_TX_HW_ENQUEUE);
 
 	return;
@@ -219,6 +604,8 @@ static inline QDF_STATUS dp_soc_swlm_tcl_attach(struct dp_soc *soc)
 	swlm->params.time_flush_thresh = DP_SWLM_TCL_TIME_FLUSH_THRESH;
 	swlm->params.tx_thresh_multiplier = DP_SWLM_TCL_TX_THRESH_MULTIPLIER;
 	swlm->params.tx_pkt_thresh = DP_SWLM_TCL_TX_PKT_THRESH;
+	swlm->params.latency_slo =
+		wlan_cfg_get_swlm_latency_slo(soc->wlan_cfg_ctx);
 
 	for (i = 0; i < soc->num_tcl_data_rings; i++) {
 		swlm->params.tcl[i].soc = soc;
@@ -229,6 +616,7 @@ static inline QDF_STATUS dp_soc_swlm_tcl_attach(struct dp_soc *soc)
 			       dp_swlm_tcl_flush_timer,
 			       (void *)&swlm->params.tcl[i],
 			       QDF_TIMER_TYPE_WAKE_APPS);
+		dp_swlm_tcl_model_attach(soc, i);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -247,6 +635,7 @@ static inline QDF_STATUS dp_soc_swlm_tcl_detach(struct dp_swlm *swlm,
 {
 	qdf_timer_stop(&swlm->params.tcl[ring_id].flush_timer);
 	qdf_timer_free(&swlm->params.tcl[ring_id].flush_timer);
+	dp_swlm_tcl_model_detach(swlm, ring_id);
 
 	return QDF_STATUS_SUCCESS;
 }
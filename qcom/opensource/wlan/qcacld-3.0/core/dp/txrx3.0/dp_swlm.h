@@ -26,11 +26,30 @@
 #define DP_SWLM_TCL_TX_TRAFFIC_THRESH	50
 #define DP_SWLM_TCL_TX_PKT_THRESH	2
 
-/* Traffic test time is in us */
+/* Throughput sampling period, in us like all the SWLM times */
 #define DP_SWLM_TCL_TRAFFIC_SAMPLING_TIME 250
 #define DP_SWLM_TCL_TIME_FLUSH_THRESH 1000
 #define DP_SWLM_TCL_TX_THRESH_MULTIPLIER 2
 
+#ifdef WLAN_DP_SWLM_ADAPTIVE
+/* EWMA weight of a new sample is 1 / (1 << DP_SWLM_EWMA_SHIFT) */
+#define DP_SWLM_EWMA_SHIFT 3
+/* Frames closer than this (us) belong to the same burst */
+#define DP_SWLM_BURST_GAP 100
+/* Max frames coalesced in one window */
+#define DP_SWLM_MAX_BURST 64
+/* Inter-frame gaps (us) are clamped to this value */
+#define DP_SWLM_GAP_MAX 20000
+/* Flush timer period (us) armed for every coalesced frame */
+#define DP_SWLM_TIMER_US 1000
+/* Number of decisions traced per TCL ring, power of 2 */
+#define DP_SWLM_TRACE_SIZE 256
+/* DSCP values from CS5 upwards are treated as latency sensitive */
+#define DP_SWLM_LL_DSCP_MIN 40
+/* Type/length values below this are 802.3 lengths, not ethertypes */
+#define DP_SWLM_ETH_TYPE_MIN 0x600
+#endif
+
 /* Inline Functions */
 
 /**
@@ -59,6 +78,107 @@ bool dp_tx_is_special_frame(qdf_nbuf_t nbuf, uint32_t frame_mask)
 	return false;
 }
 
+#ifdef WLAN_DP_SWLM_ADAPTIVE
+/**
+ * dp_swlm_is_ll_dscp() - check if a TX frame carries a latency sensitive DSCP
+ * @nbuf: TX skb pointer
+ *
+ * Ethernet II and 802.3 LLC/SNAP encapsulated IP frames are parsed, VLAN
+ * tagged frames are not and are never treated as latency sensitive.
+ *
+ * Returns: true, if the DSCP of the frame is latency sensitive
+ *	    false, otherwise
+ */
+static inline bool dp_swlm_is_ll_dscp(qdf_nbuf_t nbuf)
+{
+	qdf_ether_header_t *eh = (qdf_ether_header_t *)qdf_nbuf_data(nbuf);
+	uint8_t *l3 = (uint8_t *)(eh + 1);
+	uint32_t hdr_len = sizeof(*eh);
+	uint16_t ether_type = qdf_ntohs(eh->ether_type);
+	qdf_llc_t *llc;
+	uint8_t dscp;
+
+	if (ether_type < DP_SWLM_ETH_TYPE_MIN) {
+		llc = (qdf_llc_t *)l3;
+		hdr_len += sizeof(*llc);
+		if (qdf_nbuf_headlen(nbuf) < hdr_len || !DP_FRAME_IS_SNAP(llc))
+			return false;
+
+		ether_type = qdf_ntohs(llc->llc_un.type_snap.ether_type);
+		l3 += sizeof(*llc);
+	}
+
+	/* enough for the IPv4 TOS and the IPv6 traffic class */
+	if (qdf_nbuf_headlen(nbuf) < hdr_len + 2)
+		return false;
+
+	if (ether_type == QDF_ETH_TYPE_IPV4)
+		dscp = ((qdf_net_iphdr_t *)l3)->ip_tos >> DP_IP_DSCP_SHIFT;
+	else if (ether_type == QDF_ETH_TYPE_IPV6)
+		dscp = ((l3[0] << 4 | l3[1] >> 4) & 0xff) >> DP_IP_DSCP_SHIFT;
+	else
+		return false;
+
+	return dscp >= DP_SWLM_LL_DSCP_MIN;
+}
+
+/**
+ * dp_swlm_tcl_ll_frame() - account a frame which must not be delayed
+ * @soc: DP soc handle
+ * @ring_id: TCL ring id
+ *
+ * Returns: None
+ */
+void dp_swlm_tcl_ll_frame(struct dp_soc *soc, uint8_t ring_id);
+
+/**
+ * dp_swlm_tcl_reset_session_data() -  Reset the TCL coalescing session data
+ * @soc: DP soc handle
+ * @ring_id: TCL ring id
+ *
+ * Called for frames which failed the coalescing pre-checks. The adaptive
+ * model closes the open window and holds off coalescing for one latency
+ * SLO, so that the flow of such a frame is not delayed either.
+ *
+ * Returns QDF_STATUS
+ */
+static inline QDF_STATUS
+dp_swlm_tcl_reset_session_data(struct dp_soc *soc, uint8_t ring_id)
+{
+	dp_swlm_tcl_ll_frame(soc, ring_id);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_swlm_tcl_pre_check_dscp() - DSCP pre-check for the current TX frame
+ * @soc: Datapath soc handle
+ * @tcl_data: tcl swlm data
+ *
+ * Returns: true, if the frame is not to be coalesced due to its DSCP
+ *	    false, otherwise
+ */
+static inline bool
+dp_swlm_tcl_pre_check_dscp(struct dp_soc *soc,
+			   struct dp_swlm_tcl_data *tcl_data)
+{
+	struct dp_swlm *swlm = &soc->swlm;
+
+	if (!dp_swlm_is_ll_dscp(tcl_data->nbuf))
+		return false;
+
+	DP_STATS_INC(swlm, tcl[tcl_data->ring_id].ll_dscp, 1);
+
+	return true;
+}
+#else
+static inline bool
+dp_swlm_tcl_pre_check_dscp(struct dp_soc *soc,
+			   struct dp_swlm_tcl_data *tcl_data)
+{
+	return false;
+}
+
 /**
  * dp_swlm_tcl_reset_session_data() -  Reset the TCL coalescing session data
  * @soc: DP soc handle
@@ -81,6 +201,7 @@ dp_swlm_tcl_reset_session_data(struct dp_soc *soc, uint8_t ring_id)
 
 	return QDF_STATUS_SUCCESS;
 }
+#endif /* WLAN_DP_SWLM_ADAPTIVE */
 
 /**
  * dp_swlm_tcl_pre_check() - Pre checks for current packet to be transmitted
@@ -113,6 +234,9 @@ dp_swlm_tcl_pre_check(struct dp_soc *soc,
 		goto fail;
 	}
 
+	if (dp_swlm_tcl_pre_check_dscp(soc, tcl_data))
+		goto fail;
+
 	return QDF_STATUS_SUCCESS;
 
 fail:
@@ -172,6 +296,71 @@ QDF_STATUS dp_soc_swlm_detach(struct dp_soc *soc);
  */
 QDF_STATUS dp_print_swlm_stats(struct dp_soc *soc);
 
+#ifdef WLAN_DP_SWLM_ADAPTIVE
+/**
+ * dp_swlm_model_init() - initialize the arrival model of a TCL ring
+ * @model: SWLM arrival model
+ *
+ * Returns: None
+ */
+void dp_swlm_model_init(struct dp_swlm_model *model);
+
+/**
+ * dp_swlm_model_update() - account a frame and decide on its TCL HP write
+ * @model: SWLM arrival model
+ * @now: frame timestamp in us
+ * @slo: max latency in us the coalescing may add to a frame
+ *
+ * The model keeps EWMAs of the inter-frame gap and of the burst length.
+ * A coalescing window is only opened if at least one more frame is
+ * expected within @slo; it is flushed once the expected burst has been
+ * coalesced, or after the time that burst is expected to take, whichever
+ * comes first, and never later than @slo.
+ *
+ * Returns: enum dp_swlm_decision
+ */
+enum dp_swlm_decision
+dp_swlm_model_update(struct dp_swlm_model *model, uint64_t now, uint32_t slo);
+
+/**
+ * dp_swlm_model_ll_frame() - account a frame which must not be delayed
+ * @model: SWLM arrival model
+ * @now: frame timestamp in us
+ * @slo: max latency in us the coalescing may add to a frame
+ *
+ * Returns: None
+ */
+void dp_swlm_model_ll_frame(struct dp_swlm_model *model, uint64_t now,
+			    uint32_t slo);
+
+/**
+ * dp_swlm_model_end_session() - close the open coalescing window
+ * @model: SWLM arrival model
+ *
+ * Returns: None
+ */
+void dp_swlm_model_end_session(struct dp_swlm_model *model);
+
+/**
+ * dp_swlm_replay() - replay TX timestamps through the SWLM model
+ * @ts: frame timestamps in us, in ascending order
+ * @ll: per frame latency sensitive flag, may be NULL
+ * @num: number of frames
+ * @slo: max latency in us the coalescing may add to a frame
+ * @res: replay result
+ *
+ * Runs the same model as the TX path, including the flush timer armed
+ * for every coalesced frame, and reports the TCL HP writes issued and
+ * the latency added to the frames. The window closes within @slo but its
+ * HP write may wait for the flush timer, so a frame is delayed at most
+ * @slo + DP_SWLM_TIMER_US.
+ *
+ * Returns: None
+ */
+void dp_swlm_replay(const uint64_t *ts, const uint8_t *ll, uint32_t num,
+		    uint32_t slo, struct dp_swlm_replay_result *res);
+#endif /* WLAN_DP_SWLM_ADAPTIVE */
+
 #endif /* WLAN_DP_FEATURE_SW_LATENCY_MGR */
 
 #endif
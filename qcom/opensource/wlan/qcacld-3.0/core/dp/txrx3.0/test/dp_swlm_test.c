@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2021, The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_trace.h"
+#include <dp_types.h>
+#include <dp_internal.h>
+#include "dp_swlm.h"
+#include "dp_swlm_test.h"
+
+#define ut_swlm_slo 1000
+#define ut_swlm_sparse_pkts 200
+#define ut_swlm_sparse_gap 5000
+#define ut_swlm_bursts 20
+#define ut_swlm_burst_len 32
+#define ut_swlm_burst_gap 10
+#define ut_swlm_burst_period 10000
+#define ut_swlm_max_pkts (ut_swlm_bursts * ut_swlm_burst_len)
+
+/**
+ * struct ut_swlm_ctx - replay input
+ * @ts: frame timestamps in us
+ * @ll: per frame latency sensitive flag
+ * @num: number of frames
+ */
+struct ut_swlm_ctx {
+	uint64_t ts[ut_swlm_max_pkts];
+	uint8_t ll[ut_swlm_max_pkts];
+	uint32_t num;
+};
+
+static void ut_swlm_sparse(struct ut_swlm_ctx *ctx)
+{
+	uint32_t i;
+
+	for (i = 0; i < ut_swlm_sparse_pkts; i++)
+		ctx->ts[i] = ut_swlm_sparse_gap * (uint64_t)(i + 1);
+	ctx->num = ut_swlm_sparse_pkts;
+	qdf_mem_zero(ctx->ll, sizeof(ctx->ll));
+}
+
+static void ut_swlm_bursty(struct ut_swlm_ctx *ctx)
+{
+	uint32_t burst, i;
+
+	ctx->num = 0;
+	for (burst = 0; burst < ut_swlm_bursts; burst++)
+		for (i = 0; i < ut_swlm_burst_len; i++)
+			ctx->ts[ctx->num++] = ut_swlm_burst_period *
+					      (uint64_t)(burst + 1) +
+					      i * ut_swlm_burst_gap;
+	qdf_mem_zero(ctx->ll, sizeof(ctx->ll));
+}
+
+static void ut_swlm_replay(struct ut_swlm_ctx *ctx, uint32_t slo,
+			   struct dp_swlm_replay_result *res,
+			   const char *name)
+{
+	dp_swlm_replay(ctx->ts, ctx->ll, ctx->num, slo, res);
+	qdf_nofl_info("dp_swlm %s SLO %u us: %u frames %u HP writes max delay %u us",
+		      name, slo, res->pkts, res->doorbells, res->max_delay);
+}
+
+/* the window is bounded by the SLO, the flush timer runs past it */
+static uint32_t ut_swlm_check_bound(struct dp_swlm_replay_result *res,
+				    uint32_t slo, const char *name)
+{
+	if (res->max_delay <= slo + DP_SWLM_TIMER_US)
+		return 0;
+
+	qdf_nofl_alert("FAIL: %s delayed a frame %u us with SLO %u us",
+		       name, res->max_delay, slo);
+	return 1;
+}
+
+static uint32_t ut_swlm_check_no_delay(struct ut_swlm_ctx *ctx,
+				       struct dp_swlm_replay_result *res,
+				       const char *name)
+{
+	if (res->pkts == ctx->num && res->doorbells == ctx->num &&
+	    !res->total_delay)
+		return 0;
+
+	qdf_nofl_alert("FAIL: %s %u HP writes for %u frames, delay %llu us",
+		       name, res->doorbells, ctx->num, res->total_delay);
+	return 1;
+}
+
+static uint32_t ut_swlm_replay_test(void)
+{
+	static const uint32_t slo[] = {100, 500, 1000, 2000};
+	struct dp_swlm_replay_result res, prev;
+	struct ut_swlm_ctx *ctx;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	dp_swlm_replay(ctx->ts, NULL, 0, ut_swlm_slo, &res);
+	if (res.pkts || res.doorbells || res.total_delay) {
+		qdf_nofl_alert("FAIL: empty replay wrote the HP");
+		errors++;
+	}
+
+	/* no further frame is expected within the SLO, nothing coalesces */
+	ut_swlm_sparse(ctx);
+	ut_swlm_replay(ctx, ut_swlm_slo, &res, "sparse");
+	errors += ut_swlm_check_no_delay(ctx, &res, "sparse");
+
+	/* a longer SLO coalesces more and never adds more than it allows */
+	ut_swlm_bursty(ctx);
+	for (i = 0; i < QDF_ARRAY_SIZE(slo); i++) {
+		ut_swlm_replay(ctx, slo[i], &res, "bursty");
+		errors += ut_swlm_check_bound(&res, slo[i], "bursty");
+		if (i && res.doorbells > prev.doorbells) {
+			qdf_nofl_alert("FAIL: SLO %u us %u HP writes, SLO %u us %u",
+				       slo[i], res.doorbells,
+				       slo[i - 1], prev.doorbells);
+			errors++;
+		}
+		prev = res;
+	}
+
+	ut_swlm_replay(ctx, ut_swlm_slo, &prev, "bursty");
+	if (prev.doorbells * 2 > ctx->num) {
+		qdf_nofl_alert("FAIL: bursts of %u frames %u us apart not coalesced, %u HP writes for %u frames",
+			       ut_swlm_burst_len, ut_swlm_burst_gap,
+			       prev.doorbells, ctx->num);
+		errors++;
+	}
+
+	/* latency sensitive frames are written at once */
+	qdf_mem_set(ctx->ll, ctx->num, 1);
+	ut_swlm_replay(ctx, ut_swlm_slo, &res, "latency sensitive");
+	errors += ut_swlm_check_no_delay(ctx, &res, "latency sensitive");
+
+	/* and hold off coalescing on the ring for an SLO */
+	qdf_mem_zero(ctx->ll, sizeof(ctx->ll));
+	ctx->ll[ctx->num / 2] = 1;
+	ut_swlm_replay(ctx, ut_swlm_slo, &res, "holdoff");
+	errors += ut_swlm_check_bound(&res, ut_swlm_slo, "holdoff");
+	if (res.doorbells <= prev.doorbells) {
+		qdf_nofl_alert("FAIL: no holdoff after a latency sensitive frame, %u HP writes, %u without it",
+			       res.doorbells, prev.doorbells);
+		errors++;
+	}
+
+	qdf_mem_free(ctx);
+
+	return errors;
+}
+
+/**
+ * ut_swlm_frame() - build an IP frame for the DSCP check
+ * @ether_type: ethertype of the IP header
+ * @dscp: DSCP of the IP header
+ * @snap: build a 802.3 frame with a LLC/SNAP header
+ * @vlan: insert a 802.1Q tag
+ *
+ * Return: frame, NULL on allocation failure
+ */
+static qdf_nbuf_t ut_swlm_frame(uint16_t ether_type, uint8_t dscp,
+				bool snap, bool vlan)
+{
+	static const uint8_t snap_hdr[] = {0xaa, 0xaa, 0x03, 0x00, 0x00, 0x00};
+	uint8_t tos = dscp << DP_IP_DSCP_SHIFT;
+	qdf_ether_header_t *eh;
+	qdf_nbuf_t nbuf;
+	uint8_t *hdr;
+	uint16_t len = 64;
+
+	nbuf = qdf_nbuf_alloc(NULL, len, 0, 4, false);
+	if (!nbuf)
+		return NULL;
+
+	eh = (qdf_ether_header_t *)qdf_nbuf_put_tail(nbuf, len);
+	qdf_mem_zero(eh, len);
+	hdr = (uint8_t *)(eh + 1);
+
+	if (vlan) {
+		eh->ether_type = qdf_htons(QDF_ETH_TYPE_8021Q);
+		hdr[2] = ether_type >> 8;
+		hdr[3] = ether_type & 0xff;
+		hdr += sizeof(qdf_net_vlanhdr_t);
+	} else if (snap) {
+		eh->ether_type = qdf_htons(len - sizeof(*eh));
+		qdf_mem_copy(hdr, snap_hdr, sizeof(snap_hdr));
+		hdr[6] = ether_type >> 8;
+		hdr[7] = ether_type & 0xff;
+		hdr += sizeof(qdf_llc_t);
+	} else {
+		eh->ether_type = qdf_htons(ether_type);
+	}
+
+	if (ether_type == QDF_ETH_TYPE_IPV4) {
+		hdr[0] = 0x45;
+		hdr[1] = tos;
+	} else {
+		hdr[0] = 0x60 | tos >> 4;
+		hdr[1] = tos << 4;
+	}
+
+	return nbuf;
+}
+
+static uint32_t ut_swlm_dscp_test(void)
+{
+	static const struct {
+		const char *name;
+		uint16_t ether_type;
+		uint8_t dscp;
+		bool snap;
+		bool vlan;
+		bool ll;
+	} cases[] = {
+		{"eth2 ipv4 EF", QDF_ETH_TYPE_IPV4, 46, false, false, true},
+		{"eth2 ipv4 BE", QDF_ETH_TYPE_IPV4, 0, false, false, false},
+		{"eth2 ipv6 CS6", QDF_ETH_TYPE_IPV6, 48, false, false, true},
+		{"eth2 ipv6 AF41", QDF_ETH_TYPE_IPV6, 34, false, false, false},
+		{"snap ipv4 CS5", QDF_ETH_TYPE_IPV4, 40, true, false, true},
+		{"snap ipv4 CS4", QDF_ETH_TYPE_IPV4, 32, true, false, false},
+		{"snap ipv6 EF", QDF_ETH_TYPE_IPV6, 46, true, false, true},
+		{"vlan ipv4 EF", QDF_ETH_TYPE_IPV4, 46, false, true, false},
+	};
+	qdf_nbuf_t nbuf;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(cases); i++) {
+		nbuf = ut_swlm_frame(cases[i].ether_type, cases[i].dscp,
+				     cases[i].snap, cases[i].vlan);
+		if (!nbuf)
+			return errors + 1;
+
+		if (dp_swlm_is_ll_dscp(nbuf) != cases[i].ll) {
+			qdf_nofl_alert("FAIL: %s latency sensitive %d",
+				       cases[i].name, !cases[i].ll);
+			errors++;
+		}
+		qdf_nbuf_free(nbuf);
+	}
+
+	return errors;
+}
+
+uint32_t dp_swlm_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += ut_swlm_replay_test();
+	errors += ut_swlm_dscp_test();
+
+	return errors;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021, The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __DP_SWLM_TEST
+#define __DP_SWLM_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_DP_SWLM_TEST
+/**
+ * dp_swlm_unit_test() - run the SWLM arrival model unit test suite
+ *
+ * Replays synthetic sparse, bursty and latency sensitive TX timestamps
+ * through dp_swlm_replay() and checks the HP writes issued and the
+ * latency added against the SLO, then checks which frames the latency
+ * sensitive DSCP check picks for ethernet II, LLC/SNAP and VLAN frames.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t dp_swlm_unit_test(void);
+#else
+static inline uint32_t dp_swlm_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_DP_SWLM_TEST */
+
+#endif /* __DP_SWLM_TEST */
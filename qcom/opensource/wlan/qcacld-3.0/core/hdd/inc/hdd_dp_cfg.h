@@ -596,6 +596,74 @@
 		CFG_VALUE_OR_DEFAULT, \
 		"Bus bandwidth compute interval")
 
+/*
+ * <ini>
+ * gBusBandwidthPredictEnable - Enable predictive bus bandwidth voting
+ * @Default: true
+ *
+ * This ini enables the bus bandwidth estimator fed by datapath ring
+ * occupancy and per NAPI packet counts. The estimator votes ahead of the
+ * periodic bus bandwidth computation when the demand ramps up.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BANDWIDTH_PREDICT_ENABLE \
+		CFG_INI_BOOL( \
+		"gBusBandwidthPredictEnable", \
+		true, \
+		"Enable predictive bus bandwidth voting")
+
+/*
+ * <ini>
+ * gBusBandwidthPredictHysteresis - predicted level down hysteresis
+ *
+ * @Min: 0
+ * @Max: 90
+ * @Default: 20
+ *
+ * This ini specifies, in percent of the current level threshold, how far
+ * the predicted packet rate has to fall below the threshold before the
+ * predicted throughput level is lowered.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BANDWIDTH_PREDICT_HYSTERESIS \
+		CFG_INI_UINT( \
+		"gBusBandwidthPredictHysteresis", \
+		0, \
+		90, \
+		20, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Predicted bus bandwidth down hysteresis")
+
+/*
+ * <ini>
+ * gBusBandwidthPredictHoldTime - predicted level down hold time
+ *
+ * @Min: 0
+ * @Max: 10000
+ * @Default: 300
+ *
+ * This ini specifies, in ms, for how long a lower throughput level has to
+ * be predicted before the predictive vote is lowered.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BANDWIDTH_PREDICT_HOLD_TIME \
+		CFG_INI_UINT( \
+		"gBusBandwidthPredictHoldTime", \
+		0, \
+		10000, \
+		300, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Predicted bus bandwidth down hold time")
+
 /*
  * <ini>
  * gTcpLimitOutputEnable - Control to enable TCP limit output byte
@@ -1507,6 +1575,32 @@
 		    CFG_VALUE_OR_DEFAULT, \
 		    "Interval to mark ICMP Request packets to be sent to FW")
 
+/*
+ * <ini>
+ * gTwtShaperMaxDelay - latency bound of the TWT tx shaper
+ *
+ * @Min: 1
+ * @Max: 1000
+ * @Default: 100
+ *
+ * This ini specifies, in ms, for how long the TWT tx shaper holds a BE or
+ * BK frame at most while it waits for the next TWT service period.
+ *
+ * Supported modes: STA, P2P client
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_TWT_SHAPER_MAX_DELAY \
+		CFG_INI_UINT( \
+		"gTwtShaperMaxDelay", \
+		1, \
+		1000, \
+		100, \
+		CFG_VALUE_OR_DEFAULT, \
+		"TWT tx shaper latency bound")
+
 #ifdef QCA_LL_LEGACY_TX_FLOW_CONTROL
 #define CFG_HDD_DP_LEGACY_TX_FLOW \
 	CFG(CFG_DP_LL_TX_FLOW_LWM) \
@@ -1522,6 +1616,15 @@
 #define CFG_HDD_DP_LEGACY_TX_FLOW
 #endif
 
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+#define CFG_HDD_DP_BUS_BW_PREDICT \
+	CFG(CFG_DP_BUS_BANDWIDTH_PREDICT_ENABLE) \
+	CFG(CFG_DP_BUS_BANDWIDTH_PREDICT_HYSTERESIS) \
+	CFG(CFG_DP_BUS_BANDWIDTH_PREDICT_HOLD_TIME)
+#else
+#define CFG_HDD_DP_BUS_BW_PREDICT
+#endif
+
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
 #define CFG_HDD_DP_BUS_BANDWIDTH \
 	CFG(CFG_DP_BUS_BANDWIDTH_SUPER_HIGH_THRESHOLD) \
@@ -1540,7 +1643,8 @@
 	CFG(CFG_DP_TCP_DELACK_TIMER_COUNT) \
 	CFG(CFG_DP_TCP_TX_HIGH_TPUT_THRESHOLD) \
 	CFG(CFG_DP_BUS_LOW_BW_CNT_THRESHOLD) \
-	CFG(CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS)
+	CFG(CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS) \
+	CFG_HDD_DP_BUS_BW_PREDICT
 
 #else
 #define CFG_HDD_DP_BUS_BANDWIDTH
@@ -1567,6 +1671,13 @@
 #define CFG_DP_HL_BUNDLE
 #endif
 
+#ifdef WLAN_HDD_TWT_SHAPER
+#define CFG_HDD_DP_TWT_SHAPER \
+	CFG(CFG_DP_TWT_SHAPER_MAX_DELAY)
+#else
+#define CFG_HDD_DP_TWT_SHAPER
+#endif
+
 #define CFG_HDD_DP_ALL \
 	CFG(CFG_DP_NAPI_CE_CPU_MASK) \
 	CFG(CFG_DP_RX_THREAD_CPU_MASK) \
@@ -1592,5 +1703,6 @@
 	CFG_HDD_DP_LEGACY_TX_FLOW \
 	CFG_DP_ENABLE_NUD_TRACKING_ALL \
 	CFG_DP_CONFIG_DP_TRACE_ALL \
-	CFG_DP_HL_BUNDLE
+	CFG_DP_HL_BUNDLE \
+	CFG_HDD_DP_TWT_SHAPER
 #endif
@@ -180,6 +180,11 @@ struct hdd_config {
 	bool     enable_tcp_param_update;
 	uint32_t bus_low_cnt_threshold;
 	bool enable_latency_crit_clients;
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+	bool bus_bw_predict_enable;
+	uint32_t bus_bw_predict_hyst_pct;
+	uint32_t bus_bw_predict_hold_ms;
+#endif
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 #ifdef WLAN_FEATURE_MSCS
@@ -218,6 +223,9 @@ struct hdd_config {
 	uint8_t dp_trace_config[DP_TRACE_CONFIG_STRING_LENGTH];
 #endif
 	uint8_t enable_nud_tracking;
+#ifdef WLAN_HDD_TWT_SHAPER
+	uint32_t twt_shaper_max_delay_ms;
+#endif
 	uint32_t operating_chan_freq;
 	uint8_t num_vdevs;
 	uint8_t enable_concurrent_sta[CFG_CONCURRENT_IFACE_MAX_LEN];
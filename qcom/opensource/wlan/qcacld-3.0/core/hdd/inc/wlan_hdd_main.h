@@ -73,6 +73,7 @@
 #include "wlan_hdd_cfg80211.h"
 #include "wlan_hdd_debugfs.h"
 #include <qdf_defer.h>
+#include <qdf_hrtimer.h>
 #include "sap_api.h"
 #include <wlan_hdd_lro.h>
 #include "cdp_txrx_flow_ctrl_legacy.h"
@@ -582,6 +583,27 @@ struct hdd_tx_rx_histogram {
 	uint64_t qtime;
 };
 
+#ifdef WLAN_HDD_RX_OL_ENGINE
+/**
+ * enum hdd_rx_ol_path - receive offload path picked for a frame
+ * @HDD_RX_OL_PATH_NONE: delivered to the stack without aggregation
+ * @HDD_RX_OL_PATH_FISA: already aggregated by FISA, delivered as is
+ * @HDD_RX_OL_PATH_LRO: aggregated by qdf_lro
+ * @HDD_RX_OL_PATH_HW_GRO: GRO keyed by the flow hash of the RX TLV
+ * @HDD_RX_OL_PATH_SW_GRO: GRO keyed by a flow hash computed by the stack,
+ *  for frames without a flow hash from the target
+ * @HDD_RX_OL_PATH_MAX: number of paths
+ */
+enum hdd_rx_ol_path {
+	HDD_RX_OL_PATH_NONE,
+	HDD_RX_OL_PATH_FISA,
+	HDD_RX_OL_PATH_LRO,
+	HDD_RX_OL_PATH_HW_GRO,
+	HDD_RX_OL_PATH_SW_GRO,
+	HDD_RX_OL_PATH_MAX,
+};
+#endif
+
 struct hdd_tx_rx_stats {
 	struct {
 		/* start_xmit stats */
@@ -599,6 +621,13 @@ struct hdd_tx_rx_stats {
 		uint32_t qselect_sk_tx_map;
 		/* skb->hash calculated in select queue */
 		uint32_t qselect_skb_hash_calc;
+#endif
+#ifdef WLAN_HDD_TX_FLOW_CACHE
+		/* select_queue/start_xmit served from the tx flow cache */
+		uint32_t qselect_flow_hit;
+		uint32_t qselect_flow_miss;
+		uint32_t tx_flow_hit;
+		uint32_t tx_flow_miss;
 #endif
 		/* rx stats */
 		__u32 rx_packets;
@@ -615,6 +644,10 @@ struct hdd_tx_rx_stats {
 	__u32 rx_non_aggregated;
 	__u32 rx_gro_flush_skip;
 	__u32 rx_gro_low_tput_flush;
+#ifdef WLAN_HDD_RX_OL_ENGINE
+	/* frames handed to the rx offload engine, per path picked */
+	__u32 rx_ol_path[HDD_RX_OL_PATH_MAX];
+#endif
 
 	/* txflow stats */
 	bool     is_txflow_paused;
@@ -628,6 +661,138 @@ struct hdd_tx_rx_stats {
 	u64 jiffies_last_txtimeout;
 };
 
+#ifdef WLAN_HDD_TX_FLOW_CACHE
+#define HDD_TX_FLOW_CACHE_SIZE 32
+#define HDD_TX_FLOW_CACHE_TTL_MS 500
+
+#define HDD_TX_FLOW_UP BIT(0)
+#define HDD_TX_FLOW_PLAIN BIT(1)
+
+/**
+ * struct hdd_tx_flow_entry - tx classification memoized for one flow
+ * @hash: skb L4 hash of the flow
+ * @gen: cache generation the entry was added in
+ * @sk: socket the flow is sent from, only compared and never dereferenced
+ * @expire: time in ticks after which the flow is classified again
+ * @flags: HDD_TX_FLOW_UP if @up is valid, HDD_TX_FLOW_PLAIN if the flow
+ *  carries unicast frames that are none of the frame types told apart by
+ *  wlan_hdd_classify_pkt()
+ * @up: user priority of the flow, as picked by hdd_select_queue()
+ */
+struct hdd_tx_flow_entry {
+	uint32_t hash;
+	uint32_t gen;
+	const void *sk;
+	qdf_time_t expire;
+	uint8_t flags;
+	uint8_t up;
+};
+
+/**
+ * struct hdd_tx_flow_cache - direct mapped per CPU tx flow cache
+ * @gen: generation of the cache, bumped to drop all the entries
+ * @entry: entries of each CPU, indexed by the skb L4 hash
+ *
+ * ndo_select_queue and ndo_start_xmit run with bottom halves disabled, so
+ * the entries of a CPU are only accessed from that CPU.
+ */
+struct hdd_tx_flow_cache {
+	uint32_t gen;
+	struct hdd_tx_flow_entry entry[NUM_CPUS][HDD_TX_FLOW_CACHE_SIZE];
+};
+#endif /* WLAN_HDD_TX_FLOW_CACHE */
+
+#ifdef WLAN_HDD_TWT_SHAPER
+#define HDD_TWT_SHAPER_NUM_TIDS 8
+#define HDD_TWT_SHAPER_BATCH_BINS 5
+
+/**
+ * struct hdd_twt_shaper_stats - TWT tx shaping counters
+ * @sps: service periods the hold queues were released for
+ * @sps_idle: service periods no frame was sent in
+ * @held: frames held outside a service period
+ * @tx_in_sp: frames sent in a service period, held frames included
+ * @tx_urgent: frames sent outside a service period as they were urgent
+ * @tx_deadline: held frames released early by the latency bound
+ * @overflow: frames sent outside a service period as the hold queues were
+ *  full
+ * @dropped: held frames dropped
+ * @tx_suspend: held frames released as the system suspended
+ * @resyncs: times the schedule was moved to follow the TSF
+ * @resyncs_rejected: TSF samples ignored as too far off the schedule
+ * @max_batch: most frames sent in one service period
+ * @batch_hist: service periods by frames sent in them, see
+ *  hdd_twt_shaper_batch_bin()
+ */
+struct hdd_twt_shaper_stats {
+	uint32_t sps;
+	uint32_t sps_idle;
+	uint32_t held;
+	uint32_t tx_in_sp;
+	uint32_t tx_urgent;
+	uint32_t tx_deadline;
+	uint32_t overflow;
+	uint32_t dropped;
+	uint32_t tx_suspend;
+	uint32_t resyncs;
+	uint32_t resyncs_rejected;
+	uint32_t max_batch;
+	uint32_t batch_hist[HDD_TWT_SHAPER_BATCH_BINS];
+};
+
+/**
+ * struct hdd_twt_shaper - TWT aware tx shaping of a station adapter
+ * @lock: protects the fields below, taken from ndo_start_xmit
+ * @timer: fires at the next service period edge or latency deadline
+ * @release_bh: moves the shaper through the schedule and sends the
+ *  released frames
+ * @initialized: timer and bottom half are set up
+ * @enabled: a TWT session is being shaped for
+ * @open: BE and BK frames pass, from the lead time before the start of a
+ *  service period to its end
+ * @releasing: held frames are being sent, new frames queue behind them
+ * @suspended: the system is suspended, nothing is held
+ * @resume_enable: shaping starts again on resume
+ * @max_delay_us: longest time a frame is held for
+ * @dialog_id: TWT dialog the schedule comes from
+ * @wake_dur_us: service period duration
+ * @wake_intvl_us: time between the starts of two service periods
+ * @next_sp_us: start of the current or next service period, in
+ *  qdf_ktime_get() microseconds
+ * @sp_tsf_us: TSF of the start of a service period reported by firmware,
+ *  0 if not known
+ * @resync_us: time the schedule is checked against the TSF next
+ * @first_hold_us: time the oldest held frame was held at
+ * @held: frames in @tidq
+ * @sp_tx: frames sent in the current service period
+ * @tidq: held frames of each TID of the peer
+ * @stats: shaping counters
+ */
+struct hdd_twt_shaper {
+	qdf_spinlock_t lock;
+	qdf_hrtimer_data_t timer;
+	qdf_bh_t release_bh;
+	bool initialized;
+	bool enabled;
+	bool open;
+	bool releasing;
+	bool suspended;
+	bool resume_enable;
+	uint32_t max_delay_us;
+	uint32_t dialog_id;
+	uint32_t wake_dur_us;
+	uint32_t wake_intvl_us;
+	uint64_t next_sp_us;
+	uint64_t sp_tsf_us;
+	uint64_t resync_us;
+	uint64_t first_hold_us;
+	uint32_t held;
+	uint32_t sp_tx;
+	qdf_nbuf_queue_t tidq[HDD_TWT_SHAPER_NUM_TIDS];
+	struct hdd_twt_shaper_stats stats;
+};
+#endif /* WLAN_HDD_TWT_SHAPER */
+
 /**
  * struct hdd_pmf_stats - Protected Management Frame statistics
  * @num_unprot_deauth_rx: Number of unprotected deauth frames received
@@ -1275,6 +1440,9 @@ enum qdisc_filter_status {
  *                          as per enum qca_sta_connect_fail_reason_codes
  * @upgrade_udp_qos_threshold: The threshold for user priority upgrade for
 			       any UDP packet.
+ * @tx_flow_cache: tx classification of established flows
+ * @twt_shaper: holds BE and BK frames for the service periods of a TWT
+ *  session
  * @gro_disallowed: Flag to check if GRO is enabled or disable for adapter
  * @gro_flushed: Flag to indicate if GRO explicit flush is done or not
  * @handle_feature_update: Handle feature update only if it is triggered
@@ -1506,6 +1674,12 @@ struct hdd_adapter {
 #endif
 	uint8_t link_status;
 	uint8_t upgrade_udp_qos_threshold;
+#ifdef WLAN_HDD_TX_FLOW_CACHE
+	struct hdd_tx_flow_cache tx_flow_cache;
+#endif
+#ifdef WLAN_HDD_TWT_SHAPER
+	struct hdd_twt_shaper twt_shaper;
+#endif
 
 	/* variable for temperature in Celsius */
 	int temperature;
@@ -1984,6 +2158,20 @@ struct hdd_rtpm_tput_policy_context {
 
 #define MAX_TGT_HW_NAME_LEN 32
 
+#ifdef WLAN_HDD_RX_OL_ENGINE
+/**
+ * struct hdd_rx_ol_engine - receive offload engine
+ * @paths: BIT() of each enum hdd_rx_ol_path enabled
+ * @rx: receive function of each path, NULL for the paths delivering the
+ *  frame to the stack without aggregation
+ */
+struct hdd_rx_ol_engine {
+	uint32_t paths;
+	QDF_STATUS (*rx[HDD_RX_OL_PATH_MAX])(struct hdd_adapter *adapter,
+					     struct sk_buff *skb);
+};
+#endif
+
 /**
  * struct hdd_context - hdd shared driver and psoc/device context
  * @psoc: object manager psoc context
@@ -2015,6 +2203,8 @@ struct hdd_rtpm_tput_policy_context {
  * @hdd_dual_sta_policy: Concurrent STA policy configuration
  * @last_pagefault_ssr_time: Time when last recovery was triggered because of
  * @host wakeup from fw with reason as pagefault
+ * @rx_ol_engine: receive offload path of each frame handed to
+ *  receive_offload_cb
  */
 struct hdd_context {
 	struct wlan_objmgr_psoc *psoc;
@@ -2278,6 +2468,9 @@ struct hdd_context {
 	bool is_fils_roaming_supported;
 	QDF_STATUS (*receive_offload_cb)(struct hdd_adapter *,
 					 struct sk_buff *);
+#ifdef WLAN_HDD_RX_OL_ENGINE
+	struct hdd_rx_ol_engine rx_ol_engine;
+#endif
 	qdf_atomic_t vendor_disable_lro_flag;
 
 	/* disable RX offload (GRO/LRO) in concurrency scenarios */
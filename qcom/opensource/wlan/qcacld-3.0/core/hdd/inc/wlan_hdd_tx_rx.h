@@ -427,6 +427,29 @@ void hdd_adapter_set_rps(uint8_t vdev_id, bool enable)
 
 void wlan_hdd_classify_pkt(struct sk_buff *skb);
 
+#ifdef WLAN_HDD_TX_FLOW_CACHE
+/**
+ * hdd_tx_classify_pkt() - classify a tx frame unless its flow is cached
+ * @adapter: adapter the frame is sent on
+ * @skb: frame being sent
+ * @cpu: CPU the frame is being sent from
+ *
+ * Frames of a flow cached as plain unicast data are neither broadcast,
+ * multicast nor any of the special frame types, so their classification
+ * is all zero and parsing them is skipped.
+ *
+ * Return: None
+ */
+void hdd_tx_classify_pkt(struct hdd_adapter *adapter,
+			 struct sk_buff *skb, int cpu);
+#else
+static inline void hdd_tx_classify_pkt(struct hdd_adapter *adapter,
+				       struct sk_buff *skb, int cpu)
+{
+	wlan_hdd_classify_pkt(skb);
+}
+#endif /* WLAN_HDD_TX_FLOW_CACHE */
+
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
 void hdd_reset_tcp_delack(struct hdd_context *hdd_ctx);
 
@@ -626,4 +649,23 @@ void hdd_pkt_add_timestamp(struct hdd_adapter *adapter,
 }
 #endif
 
+#ifdef WLAN_DP_LAT_TRACE
+#include "cdp_txrx_misc.h"
+
+/**
+ * hdd_lat_trace_stamp() - time stamp a packet at a DP latency trace stage
+ * @skb: socket buffer
+ * @stage: enum cdp_lat_trace_stage
+ *
+ * Return: None
+ */
+static inline void hdd_lat_trace_stamp(struct sk_buff *skb,
+				       enum cdp_lat_trace_stage stage)
+{
+	cdp_lat_trace_stamp(cds_get_context(QDF_MODULE_ID_SOC), skb, stage);
+}
+#else
+#define hdd_lat_trace_stamp(skb, stage)
+#endif
+
 #endif /* end #if !defined(WLAN_HDD_TX_RX_H) */
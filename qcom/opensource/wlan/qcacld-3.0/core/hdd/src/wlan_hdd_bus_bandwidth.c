@@ -207,6 +207,33 @@ bbm_get_bus_bw_level_vote(struct hdd_adapter *adapter,
 	return vote_lvl;
 }
 
+/**
+ * bbm_get_tput_vote() - Get the bus bw level for a throughput level by
+ *  considering connection modes across adapters
+ * @hdd_ctx: HDD context
+ * @tput_level: throughput level
+ *
+ * Returns: bus bw level
+ */
+static enum bus_bw_level
+bbm_get_tput_vote(struct hdd_context *hdd_ctx, enum tput_level tput_level)
+{
+	struct hdd_adapter *adapter;
+	struct hdd_adapter *next_adapter;
+	enum bus_bw_level next_vote = BUS_BW_LEVEL_NONE;
+	enum bus_bw_level tmp_vote;
+
+	hdd_for_each_adapter_dev_held_safe(hdd_ctx, adapter, next_adapter,
+					   NET_DEV_HOLD_BUS_BW_MGR) {
+		tmp_vote = bbm_get_bus_bw_level_vote(adapter, tput_level);
+		if (tmp_vote > next_vote)
+			next_vote = tmp_vote;
+		hdd_adapter_dev_put_debug(adapter, NET_DEV_HOLD_BUS_BW_MGR);
+	}
+
+	return next_vote;
+}
+
 /**
  * bbm_apply_tput_policy() - Apply tput BBM policy by considering
  *  throughput level and connection modes across adapters
@@ -218,10 +245,6 @@ bbm_get_bus_bw_level_vote(struct hdd_adapter *adapter,
 static void
 bbm_apply_tput_policy(struct hdd_context *hdd_ctx, enum tput_level tput_level)
 {
-	struct hdd_adapter *adapter;
-	struct hdd_adapter *next_adapter;
-	enum bus_bw_level next_vote = BUS_BW_LEVEL_NONE;
-	enum bus_bw_level tmp_vote;
 	struct bbm_context *bbm_ctx = hdd_ctx->bbm_ctx;
 
 	if (tput_level == TPUT_LEVEL_NONE) {
@@ -230,19 +253,37 @@ bbm_apply_tput_policy(struct hdd_context *hdd_ctx, enum tput_level tput_level)
 		 * is force cancelled
 		 */
 		if (!hdd_is_any_adapter_connected(hdd_ctx))
-			bbm_ctx->per_policy_vote[BBM_TPUT_POLICY] = next_vote;
+			bbm_ctx->per_policy_vote[BBM_TPUT_POLICY] =
+							BUS_BW_LEVEL_NONE;
 		return;
 	}
 
-	hdd_for_each_adapter_dev_held_safe(hdd_ctx, adapter, next_adapter,
-					   NET_DEV_HOLD_BUS_BW_MGR) {
-		tmp_vote = bbm_get_bus_bw_level_vote(adapter, tput_level);
-		if (tmp_vote > next_vote)
-			next_vote = tmp_vote;
-		hdd_adapter_dev_put_debug(adapter, NET_DEV_HOLD_BUS_BW_MGR);
+	bbm_ctx->per_policy_vote[BBM_TPUT_POLICY] =
+				bbm_get_tput_vote(hdd_ctx, tput_level);
+}
+
+/**
+ * bbm_apply_predict_policy() - Apply predictive BBM policy by considering
+ *  the predicted throughput level and connection modes across adapters
+ * @hdd_ctx: HDD context
+ * @tput_level: predicted throughput level
+ *
+ * Returns: None
+ */
+static void
+bbm_apply_predict_policy(struct hdd_context *hdd_ctx,
+			 enum tput_level tput_level)
+{
+	struct bbm_context *bbm_ctx = hdd_ctx->bbm_ctx;
+
+	if (tput_level == TPUT_LEVEL_NONE) {
+		bbm_ctx->per_policy_vote[BBM_PREDICT_POLICY] =
+							BUS_BW_LEVEL_NONE;
+		return;
 	}
 
-	bbm_ctx->per_policy_vote[BBM_TPUT_POLICY] = next_vote;
+	bbm_ctx->per_policy_vote[BBM_PREDICT_POLICY] =
+				bbm_get_tput_vote(hdd_ctx, tput_level);
 }
 
 /**
@@ -376,8 +417,10 @@ bbm_request_bus_bandwidth(struct hdd_context *hdd_ctx)
 
 	if (next_vote != bbm_ctx->curr_vote_level) {
 		pld_vote = bbm_convert_to_pld_bus_lvl(next_vote);
-		hdd_debug("Bus bandwidth vote level change from %d to %d pld_vote: %d",
-			  bbm_ctx->curr_vote_level, next_vote, pld_vote);
+		hdd_debug("Bus bandwidth vote level change from %d to %d pld_vote: %d tput: %d predict: %d",
+			  bbm_ctx->curr_vote_level, next_vote, pld_vote,
+			  bbm_ctx->per_policy_vote[BBM_TPUT_POLICY],
+			  bbm_ctx->per_policy_vote[BBM_PREDICT_POLICY]);
 		bbm_ctx->curr_vote_level = next_vote;
 		pld_request_bus_bandwidth(hdd_ctx->parent_dev, pld_vote);
 	}
@@ -400,6 +443,10 @@ void hdd_bbm_apply_independent_policy(struct hdd_context *hdd_ctx,
 	case BBM_TPUT_POLICY:
 		bbm_apply_tput_policy(hdd_ctx, params->policy_info.tput_level);
 		break;
+	case BBM_PREDICT_POLICY:
+		bbm_apply_predict_policy(hdd_ctx,
+					 params->policy_info.tput_level);
+		break;
 	case BBM_NON_PERSISTENT_POLICY:
 		bbm_apply_non_persistent_policy(hdd_ctx,
 						params->policy_info.flag);
@@ -432,6 +479,403 @@ done:
 	qdf_mutex_release(&bbm_ctx->bbm_lock);
 }
 
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+/* Window over which the NAPI demand indications are aggregated */
+#define BBM_PREDICT_WINDOW_US 10000
+/* Rx ring occupancy, in percent, from which demand exceeds service */
+#define BBM_PREDICT_BACKLOG_PCT 50
+/* Weight of the new sample in the rate decay and slope averages: 1/8 */
+#define BBM_PREDICT_EWMA_DIV 8
+
+/**
+ * bbm_predict_level_thresh() - Packet threshold of a throughput level
+ * @cfg: HDD config
+ * @level: throughput level
+ *
+ * Returns: packets per bus bw compute interval above which @level applies
+ */
+static uint32_t bbm_predict_level_thresh(struct hdd_config *cfg,
+					 enum tput_level level)
+{
+	switch (level) {
+	case TPUT_LEVEL_SUPER_HIGH:
+		return cfg->bus_bw_super_high_threshold;
+	case TPUT_LEVEL_ULTRA_HIGH:
+		return cfg->bus_bw_ultra_high_threshold;
+	case TPUT_LEVEL_VERY_HIGH:
+		return cfg->bus_bw_very_high_threshold;
+	case TPUT_LEVEL_HIGH:
+		return cfg->bus_bw_high_threshold;
+	case TPUT_LEVEL_MEDIUM:
+		return cfg->bus_bw_medium_threshold;
+	case TPUT_LEVEL_LOW:
+		return cfg->bus_bw_low_threshold;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * bbm_predict_rate_to_level() - Map a packet rate to a throughput level
+ * @cfg: HDD config
+ * @rate: packets per bus bw compute interval
+ *
+ * Uses the same thresholds as the periodic bus bw work.
+ *
+ * Returns: throughput level
+ */
+static enum tput_level bbm_predict_rate_to_level(struct hdd_config *cfg,
+						 uint64_t rate)
+{
+	enum tput_level level;
+
+	for (level = TPUT_LEVEL_SUPER_HIGH; level > TPUT_LEVEL_IDLE; level--) {
+		if (rate > bbm_predict_level_thresh(cfg, level))
+			return level;
+	}
+
+	return TPUT_LEVEL_IDLE;
+}
+
+/**
+ * bbm_predict_record() - Record a predicted level transition
+ * @predict: predictive estimator
+ * @now: current timestamp
+ * @level: new predicted level
+ * @projected: projected packet rate behind the transition
+ * @window_us: length of the closed estimation window
+ *
+ * Returns: None
+ */
+static void bbm_predict_record(struct bbm_predict_context *predict,
+			       uint64_t now, enum tput_level level,
+			       uint32_t projected, uint32_t window_us)
+{
+	struct bbm_predict_hist_entry *entry;
+
+	entry = &predict->hist[predict->hist_idx & BBM_PREDICT_HIST_MASK];
+	entry->qtime = now;
+	entry->from = predict->level;
+	entry->to = level;
+	entry->rate = predict->rate;
+	entry->slope = predict->slope;
+	entry->projected = projected;
+	entry->backlog = predict->win_backlog;
+	entry->window_us = window_us;
+	qdf_mem_copy(entry->napi_pkts, predict->napi_pkts,
+		     sizeof(entry->napi_pkts));
+	predict->hist_idx++;
+}
+
+/**
+ * bbm_predict_update() - Close the estimation window if it is due and
+ *  update the predicted throughput level
+ * @hdd_ctx: HDD context
+ * @predict: predictive estimator
+ * @now: current timestamp
+ *
+ * The packet rate of the window is projected one bus bw compute interval
+ * ahead using its smoothed slope. Rises are taken at once, and a rx ring
+ * which is not drained in time bumps the level by one more step. A lower
+ * level is taken only once the projection stayed below the current level
+ * threshold by the configured hysteresis for the configured hold time.
+ *
+ * Must be called with the estimator lock held.
+ *
+ * Returns: true if the predicted level changed
+ */
+static bool bbm_predict_update(struct hdd_context *hdd_ctx,
+			       struct bbm_predict_context *predict,
+			       uint64_t now)
+{
+	struct hdd_config *cfg = hdd_ctx->config;
+	uint32_t interval_us = cfg->bus_bw_compute_interval * 1000;
+	uint64_t window_us, rate, projected;
+	uint32_t prev_rate = predict->rate;
+	enum tput_level level;
+	uint64_t thresh;
+	bool change = false;
+
+	window_us = qdf_log_timestamp_to_usecs(now - predict->win_start);
+	if (window_us < BBM_PREDICT_WINDOW_US &&
+	    predict->win_backlog < BBM_PREDICT_BACKLOG_PCT)
+		return false;
+
+	if (!window_us || !interval_us)
+		return false;
+
+	window_us = qdf_min(window_us, (uint64_t)interval_us);
+	rate = qdf_do_div((uint64_t)predict->win_pkts * interval_us,
+			  (uint32_t)window_us);
+	rate = qdf_min(rate, (uint64_t)U32_MAX);
+
+	/* fast attack, slow decay */
+	if (rate >= predict->rate)
+		predict->rate = rate;
+	else
+		predict->rate -= (predict->rate - (uint32_t)rate) /
+				 BBM_PREDICT_EWMA_DIV;
+
+	predict->slope += ((int32_t)(predict->rate - prev_rate) -
+			   predict->slope) / BBM_PREDICT_EWMA_DIV;
+
+	projected = predict->rate;
+	if (predict->slope > 0)
+		projected += (uint64_t)predict->slope *
+			     (interval_us / BBM_PREDICT_WINDOW_US);
+	projected = qdf_min(projected, (uint64_t)U32_MAX);
+
+	level = bbm_predict_rate_to_level(cfg, projected);
+	if (predict->win_backlog >= BBM_PREDICT_BACKLOG_PCT &&
+	    level < TPUT_LEVEL_SUPER_HIGH)
+		level++;
+
+	if (level > predict->level) {
+		predict->down_ts = 0;
+		change = true;
+	} else if (level < predict->level) {
+		thresh = bbm_predict_level_thresh(cfg, predict->level);
+		if (projected * 100 >=
+		    thresh * (100 - cfg->bus_bw_predict_hyst_pct)) {
+			predict->down_ts = 0;
+		} else if (!predict->down_ts) {
+			predict->down_ts = now;
+		} else if (qdf_log_timestamp_to_usecs(now - predict->down_ts) >=
+			   (uint64_t)cfg->bus_bw_predict_hold_ms * 1000) {
+			predict->down_ts = 0;
+			change = true;
+		}
+	} else {
+		predict->down_ts = 0;
+	}
+
+	if (change) {
+		bbm_predict_record(predict, now, level, projected, window_us);
+		predict->level = level;
+	}
+
+	predict->win_start = now;
+	predict->win_pkts = 0;
+	predict->win_backlog = 0;
+	qdf_mem_zero(predict->napi_pkts, sizeof(predict->napi_pkts));
+
+	return change;
+}
+
+/**
+ * bbm_predict_vote_work() - Log the predicted level transitions and apply
+ *  the predicted level through BBM
+ * @arg: HDD context
+ *
+ * Returns: None
+ */
+static void bbm_predict_vote_work(void *arg)
+{
+	struct hdd_context *hdd_ctx = arg;
+	struct bbm_predict_context *predict;
+	struct bbm_predict_hist_entry entry;
+	struct bbm_params param = {0};
+
+	if (wlan_hdd_validate_context(hdd_ctx) || !hdd_ctx->bbm_ctx)
+		return;
+
+	predict = &hdd_ctx->bbm_ctx->predict;
+
+	while (true) {
+		qdf_spin_lock_bh(&predict->lock);
+		if (predict->log_idx == predict->hist_idx) {
+			param.policy_info.tput_level = predict->active ?
+					predict->level : TPUT_LEVEL_NONE;
+			qdf_spin_unlock_bh(&predict->lock);
+			break;
+		}
+		if (predict->hist_idx - predict->log_idx >
+		    BBM_PREDICT_HIST_SIZE)
+			predict->log_idx = predict->hist_idx -
+					   BBM_PREDICT_HIST_SIZE;
+		entry = predict->hist[predict->log_idx &
+				      BBM_PREDICT_HIST_MASK];
+		predict->log_idx++;
+		qdf_spin_unlock_bh(&predict->lock);
+
+		hdd_debug("predicted tput level %d -> %d rate %u slope %d projected %u backlog %u%% window %uus napi %u/%u/%u/%u/%u/%u/%u/%u",
+			  entry.from, entry.to, entry.rate, entry.slope,
+			  entry.projected, entry.backlog, entry.window_us,
+			  entry.napi_pkts[0], entry.napi_pkts[1],
+			  entry.napi_pkts[2], entry.napi_pkts[3],
+			  entry.napi_pkts[4], entry.napi_pkts[5],
+			  entry.napi_pkts[6], entry.napi_pkts[7]);
+	}
+
+	param.policy = BBM_PREDICT_POLICY;
+	hdd_bbm_apply_independent_policy(hdd_ctx, &param);
+}
+
+void hdd_bbm_predict_demand_ind(struct cdp_ctrl_objmgr_psoc *ctrl_psoc,
+				uint8_t intr_id, uint32_t pkts,
+				uint8_t backlog)
+{
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	struct bbm_predict_context *predict;
+	bool change;
+
+	if (!hdd_ctx || !hdd_ctx->bbm_ctx)
+		return;
+
+	predict = &hdd_ctx->bbm_ctx->predict;
+	if (!predict->active)
+		return;
+
+	qdf_spin_lock_bh(&predict->lock);
+	predict->win_pkts += pkts;
+	if (intr_id < BBM_PREDICT_MAX_NAPI)
+		predict->napi_pkts[intr_id] += pkts;
+	if (backlog > predict->win_backlog)
+		predict->win_backlog = backlog;
+	change = bbm_predict_update(hdd_ctx, predict, qdf_get_log_timestamp());
+	qdf_spin_unlock_bh(&predict->lock);
+
+	if (change)
+		qdf_sched_work(0, &predict->vote_work);
+}
+
+void hdd_bbm_predict_tick(struct hdd_context *hdd_ctx)
+{
+	struct bbm_predict_context *predict;
+	bool change;
+
+	if (!hdd_ctx->bbm_ctx)
+		return;
+
+	predict = &hdd_ctx->bbm_ctx->predict;
+	if (!predict->active)
+		return;
+
+	qdf_spin_lock_bh(&predict->lock);
+	change = bbm_predict_update(hdd_ctx, predict, qdf_get_log_timestamp());
+	qdf_spin_unlock_bh(&predict->lock);
+
+	if (change)
+		qdf_sched_work(0, &predict->vote_work);
+}
+
+void hdd_bbm_predict_start(struct hdd_context *hdd_ctx)
+{
+	struct bbm_predict_context *predict;
+
+	if (!hdd_ctx->bbm_ctx || !hdd_ctx->config->bus_bw_predict_enable)
+		return;
+
+	predict = &hdd_ctx->bbm_ctx->predict;
+
+	qdf_spin_lock_bh(&predict->lock);
+	predict->win_start = qdf_get_log_timestamp();
+	predict->win_pkts = 0;
+	predict->win_backlog = 0;
+	qdf_mem_zero(predict->napi_pkts, sizeof(predict->napi_pkts));
+	predict->rate = 0;
+	predict->slope = 0;
+	predict->level = TPUT_LEVEL_NONE;
+	predict->down_ts = 0;
+	predict->active = true;
+	qdf_spin_unlock_bh(&predict->lock);
+}
+
+void hdd_bbm_predict_stop(struct hdd_context *hdd_ctx)
+{
+	struct bbm_predict_context *predict;
+	struct bbm_params param = {0};
+
+	if (!hdd_ctx->bbm_ctx)
+		return;
+
+	predict = &hdd_ctx->bbm_ctx->predict;
+
+	qdf_spin_lock_bh(&predict->lock);
+	predict->active = false;
+	predict->level = TPUT_LEVEL_NONE;
+	qdf_spin_unlock_bh(&predict->lock);
+
+	qdf_cancel_work(&predict->vote_work);
+
+	param.policy = BBM_PREDICT_POLICY;
+	param.policy_info.tput_level = TPUT_LEVEL_NONE;
+	hdd_bbm_apply_independent_policy(hdd_ctx, &param);
+}
+
+void hdd_bbm_predict_display_hist(struct hdd_context *hdd_ctx)
+{
+	struct bbm_predict_context *predict;
+	struct bbm_predict_hist_entry *entry;
+	uint32_t i;
+
+	if (!hdd_ctx->bbm_ctx)
+		return;
+
+	predict = &hdd_ctx->bbm_ctx->predict;
+
+	hdd_nofl_debug("Bus BW predict: enable %d hysteresis %u%% hold %u ms level %d rate %u slope %d",
+		       hdd_ctx->config->bus_bw_predict_enable,
+		       hdd_ctx->config->bus_bw_predict_hyst_pct,
+		       hdd_ctx->config->bus_bw_predict_hold_ms,
+		       predict->level, predict->rate, predict->slope);
+	hdd_nofl_debug("[index][timestamp]: from -> to, rate, slope, projected, backlog, window_us, napi pkts");
+
+	for (i = 0; i < BBM_PREDICT_HIST_SIZE; i++) {
+		entry = &predict->hist[i];
+		if (!entry->qtime)
+			continue;
+		hdd_nofl_debug("[%2u][%15llu]: %d -> %d, %u, %d, %u, %u%%, %u, %u/%u/%u/%u/%u/%u/%u/%u",
+			       i, entry->qtime, entry->from, entry->to,
+			       entry->rate, entry->slope, entry->projected,
+			       entry->backlog, entry->window_us,
+			       entry->napi_pkts[0], entry->napi_pkts[1],
+			       entry->napi_pkts[2], entry->napi_pkts[3],
+			       entry->napi_pkts[4], entry->napi_pkts[5],
+			       entry->napi_pkts[6], entry->napi_pkts[7]);
+	}
+}
+
+/**
+ * bbm_predict_init() - Initialize the predictive estimator
+ * @hdd_ctx: HDD context
+ * @bbm_ctx: BBM context
+ *
+ * Returns: qdf status
+ */
+static QDF_STATUS bbm_predict_init(struct hdd_context *hdd_ctx,
+				   struct bbm_context *bbm_ctx)
+{
+	qdf_spinlock_create(&bbm_ctx->predict.lock);
+
+	return qdf_create_work(0, &bbm_ctx->predict.vote_work,
+			       bbm_predict_vote_work, hdd_ctx);
+}
+
+/**
+ * bbm_predict_deinit() - De-initialize the predictive estimator
+ * @bbm_ctx: BBM context
+ *
+ * Returns: None
+ */
+static void bbm_predict_deinit(struct bbm_context *bbm_ctx)
+{
+	bbm_ctx->predict.active = false;
+	qdf_destroy_work(0, &bbm_ctx->predict.vote_work);
+	qdf_spinlock_destroy(&bbm_ctx->predict.lock);
+}
+#else
+static inline QDF_STATUS bbm_predict_init(struct hdd_context *hdd_ctx,
+					  struct bbm_context *bbm_ctx)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline void bbm_predict_deinit(struct bbm_context *bbm_ctx)
+{
+}
+#endif
+
 int hdd_bbm_context_init(struct hdd_context *hdd_ctx)
 {
 	struct bbm_context *bbm_ctx;
@@ -447,10 +891,16 @@ int hdd_bbm_context_init(struct hdd_context *hdd_ctx)
 	if (QDF_IS_STATUS_ERROR(status))
 		goto free_ctx;
 
+	status = bbm_predict_init(hdd_ctx, bbm_ctx);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto destroy_lock;
+
 	hdd_ctx->bbm_ctx = bbm_ctx;
 
 	return 0;
 
+destroy_lock:
+	qdf_mutex_destroy(&bbm_ctx->bbm_lock);
 free_ctx:
 	qdf_mem_free(bbm_ctx);
 
@@ -465,6 +915,7 @@ void hdd_bbm_context_deinit(struct hdd_context *hdd_ctx)
 		return;
 
 	hdd_ctx->bbm_ctx = NULL;
+	bbm_predict_deinit(bbm_ctx);
 	qdf_mutex_destroy(&bbm_ctx->bbm_lock);
 
 	qdf_mem_free(bbm_ctx);
@@ -102,6 +102,8 @@ enum bbm_non_per_flag {
  *  is set without taking other policy vote levels into consideration.
  * @BBM_SELECT_TABLE_POLICY: policy where bus bw table is selected based on
  *  the latency level.
+ * @BBM_PREDICT_POLICY: policy where the throughput level is predicted from
+ *  the datapath demand indications, ahead of the periodic throughput policy.
  */
 enum bbm_policy {
 	BBM_DRIVER_MODE_POLICY,
@@ -109,6 +111,7 @@ enum bbm_policy {
 	BBM_USER_POLICY,
 	BBM_NON_PERSISTENT_POLICY,
 	BBM_SELECT_TABLE_POLICY,
+	BBM_PREDICT_POLICY,
 	BBM_MAX_POLICY,
 };
 
@@ -130,7 +133,8 @@ enum wlm_ll_level {
  *
  * @driver_mode: global driver mode. valid for BBM_DRIVER_MODE_POLICY.
  * @flag: BBM non persistent flag. valid for BBM_NON_PERSISTENT_POLICY.
- * @tput_level: throughput level. valid for BBM_TPUT_POLICY.
+ * @tput_level: throughput level. valid for BBM_TPUT_POLICY and
+ *  BBM_PREDICT_POLICY.
  * @wlm_level: latency level. valid for BBM_WLM_POLICY.
  * @user_level: user bus bandwidth vote. valid for BBM_USER_POLICY.
  * @set: set or reset user level. valid for BBM_USER_POLICY.
@@ -160,6 +164,70 @@ struct bbm_params {
 typedef const enum bus_bw_level
 	bus_bw_table_type[QCA_WLAN_802_11_MODE_INVALID][TPUT_LEVEL_MAX];
 
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+#define BBM_PREDICT_MAX_NAPI 8
+#define BBM_PREDICT_HIST_SIZE 32
+#define BBM_PREDICT_HIST_MASK (BBM_PREDICT_HIST_SIZE - 1)
+
+/**
+ * struct bbm_predict_hist_entry - predicted throughput level transition
+ * @qtime: time of the transition
+ * @from: previous predicted throughput level
+ * @to: new predicted throughput level
+ * @rate: smoothed packet rate, in packets per bus bw compute interval
+ * @slope: smoothed change of @rate per estimation window
+ * @projected: packet rate projected one compute interval ahead
+ * @backlog: highest residual rx ring occupancy in the window, in percent
+ * @window_us: length of the estimation window
+ * @napi_pkts: packets reaped per NAPI context in the window
+ */
+struct bbm_predict_hist_entry {
+	uint64_t qtime;
+	enum tput_level from;
+	enum tput_level to;
+	uint32_t rate;
+	int32_t slope;
+	uint32_t projected;
+	uint8_t backlog;
+	uint32_t window_us;
+	uint32_t napi_pkts[BBM_PREDICT_MAX_NAPI];
+};
+
+/**
+ * struct bbm_predict_context - Predictive bus bandwidth estimator
+ * @lock: protects the estimator against concurrent NAPI indications
+ * @vote_work: work applying the predicted level through BBM
+ * @active: estimator accepts demand indications
+ * @win_start: start of the current estimation window
+ * @win_pkts: packets indicated in the current window
+ * @napi_pkts: packets indicated per NAPI context in the current window
+ * @win_backlog: highest rx ring occupancy indicated in the current window
+ * @rate: smoothed packet rate, in packets per bus bw compute interval
+ * @slope: smoothed change of @rate per estimation window
+ * @level: predicted throughput level
+ * @down_ts: time from which a lower level has been predicted, 0 if none
+ * @hist_idx: next slot in @hist
+ * @log_idx: next entry of @hist to be logged by @vote_work
+ * @hist: predicted level transitions along with their inputs
+ */
+struct bbm_predict_context {
+	qdf_spinlock_t lock;
+	qdf_work_t vote_work;
+	bool active;
+	uint64_t win_start;
+	uint32_t win_pkts;
+	uint32_t napi_pkts[BBM_PREDICT_MAX_NAPI];
+	uint8_t win_backlog;
+	uint32_t rate;
+	int32_t slope;
+	enum tput_level level;
+	uint64_t down_ts;
+	uint32_t hist_idx;
+	uint32_t log_idx;
+	struct bbm_predict_hist_entry hist[BBM_PREDICT_HIST_SIZE];
+};
+#endif
+
 /**
  * struct bbm_context: Bus Bandwidth Manager context
  *
@@ -167,12 +235,16 @@ typedef const enum bus_bw_level
  * @curr_vote_level: current vote level
  * @per_policy_vote: per BBM policy related vote
  * @bbm_lock: BBM API lock
+ * @predict: predictive throughput estimator
  */
 struct bbm_context {
 	bus_bw_table_type *curr_bus_bw_lookup_table;
 	enum bus_bw_level curr_vote_level;
 	enum bus_bw_level per_policy_vote[BBM_MAX_POLICY];
 	qdf_mutex_t bbm_lock;
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+	struct bbm_predict_context predict;
+#endif
 };
 
 #ifdef FEATURE_BUS_BANDWIDTH_MGR
@@ -221,4 +293,74 @@ void hdd_bbm_apply_independent_policy(struct hdd_context *hdd_ctx,
 {
 }
 #endif
+
+#if defined(FEATURE_BUS_BANDWIDTH_MGR) && defined(WLAN_FEATURE_BUS_BW_PREDICT)
+/**
+ * hdd_bbm_predict_demand_ind() - Datapath demand indication
+ * @ctrl_psoc: control psoc handle
+ * @intr_id: datapath interrupt (NAPI) context id
+ * @pkts: packets reaped by the context since its last indication
+ * @backlog: residual rx ring occupancy of the context, in percent
+ *
+ * Called from the datapath interrupt context. Feeds the predictive estimator
+ * and schedules a bus bandwidth vote when the predicted level goes up, so
+ * that the vote does not have to wait for the periodic bus bw work.
+ *
+ * Returns: None
+ */
+void hdd_bbm_predict_demand_ind(struct cdp_ctrl_objmgr_psoc *ctrl_psoc,
+				uint8_t intr_id, uint32_t pkts,
+				uint8_t backlog);
+
+/**
+ * hdd_bbm_predict_tick() - Close the estimation window from the periodic
+ *  bus bw work
+ * @hdd_ctx: HDD context
+ *
+ * Lets the predicted level decay when the datapath stops indicating demand.
+ *
+ * Returns: None
+ */
+void hdd_bbm_predict_tick(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_bbm_predict_start() - Start accepting demand indications
+ * @hdd_ctx: HDD context
+ *
+ * Returns: None
+ */
+void hdd_bbm_predict_start(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_bbm_predict_stop() - Stop the estimator and remove its vote
+ * @hdd_ctx: HDD context
+ *
+ * Returns: None
+ */
+void hdd_bbm_predict_stop(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_bbm_predict_display_hist() - Print the predicted level transitions
+ * @hdd_ctx: HDD context
+ *
+ * Returns: None
+ */
+void hdd_bbm_predict_display_hist(struct hdd_context *hdd_ctx);
+#else
+static inline void hdd_bbm_predict_tick(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_bbm_predict_start(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_bbm_predict_stop(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_bbm_predict_display_hist(struct hdd_context *hdd_ctx)
+{
+}
+#endif
 #endif
@@ -49,6 +49,8 @@
 #include "wlan_hdd_cfr.h"
 #include "wlan_roam_debug.h"
 #include "wma_api.h"
+#include "wlan_hdd_tx_flow_cache.h"
+#include "wlan_hdd_twt_shaper.h"
 
 void hdd_handle_disassociation_event(struct hdd_adapter *adapter,
 				     struct qdf_mac_addr *peer_macaddr)
@@ -322,6 +324,7 @@ hdd_cm_disconnect_complete_pre_user_update(struct wlan_objmgr_vdev *vdev,
 	}
 
 	hdd_conn_set_authenticated(adapter, false);
+	hdd_twt_shaper_flush(adapter);
 	hdd_napi_serialize(0);
 	hdd_disable_and_flush_mc_addr_list(adapter, pmo_peer_disconnect);
 	__hdd_cm_disconnect_handler_pre_user_update(adapter);
@@ -423,6 +426,7 @@ static void hdd_cm_reset_udp_qos_upgrade_config(struct hdd_adapter *adapter)
 
 	if (reset) {
 		adapter->upgrade_udp_qos_threshold = QCA_WLAN_AC_BK;
+		hdd_tx_flow_cache_flush(adapter);
 		hdd_debug("UDP packets qos upgrade to: %d",
 			  adapter->upgrade_udp_qos_threshold);
 	}
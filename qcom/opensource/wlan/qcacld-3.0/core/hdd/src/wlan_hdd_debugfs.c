@@ -23,6 +23,7 @@
  * wlan_wcnss/wow_enable to enable/disable WoWL.
  * wlan_wcnss/wow_pattern to configure WoWL patterns.
  * wlan_wcnss/pattern_gen to configure periodic TX patterns.
+ * <iface>/pkt_capture_filter to set the packet capture rx data filter.
  */
 
 #ifdef WLAN_OPEN_SOURCE
@@ -35,6 +36,7 @@
 #include <wlan_hdd_debugfs_llstat.h>
 #include <wlan_hdd_debugfs_mibstat.h>
 #include "wlan_hdd_debugfs_unit_test.h"
+#include "wlan_pkt_capture_ucfg_api.h"
 
 
 #define MAX_USER_COMMAND_SIZE_WOWL_ENABLE 8
@@ -515,6 +517,261 @@ static const struct file_operations fops_patterngen = {
 	.llseek = default_llseek,
 };
 
+#ifdef WLAN_FEATURE_PKT_CAPTURE
+#define MAX_USER_COMMAND_SIZE_PKT_CAPTURE_FILTER 256
+#define PKT_CAPTURE_STATS_SIZE 256
+
+/**
+ * hdd_pkt_capture_parse_rule() - Parse one rx data capture filter rule
+ * @token: rule in "[!]<offset>,<size>,<mask>,<value>" format
+ * @rule: rule to fill
+ *
+ * Return: 0 on success, errno otherwise
+ */
+static int hdd_pkt_capture_parse_rule(char *token,
+				      struct pkt_capture_filter_rule *rule)
+{
+	char *field;
+	u32 val[4];
+	int i;
+
+	if (*token == '!') {
+		rule->negate = true;
+		token++;
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(val); i++) {
+		field = strsep(&token, ",");
+		if (!field || kstrtou32(field, 0, &val[i]))
+			return -EINVAL;
+	}
+
+	if (token || val[0] > U16_MAX)
+		return -EINVAL;
+
+	rule->offset = val[0];
+	rule->size = val[1];
+	rule->mask = val[2];
+	rule->value = val[3];
+
+	return 0;
+}
+
+/**
+ * __hdd_pkt_capture_filter_write() - Install the rx data capture filter
+ * @net_dev: net_device context used to register the debugfs file
+ * @buf: user buffer holding the command
+ * @count: command length
+ *
+ * "off" removes the filter, otherwise the command is a space separated
+ * list of rules in "[!]<offset>,<size>,<mask>,<value>" format which all
+ * have to match for an rx data frame to be captured.
+ *
+ * Return: number of bytes processed or errno
+ */
+static ssize_t __hdd_pkt_capture_filter_write(struct net_device *net_dev,
+					      const char __user *buf,
+					      size_t count)
+{
+	struct hdd_adapter *adapter = WLAN_HDD_GET_PRIV_PTR(net_dev);
+	char cmd[MAX_USER_COMMAND_SIZE_PKT_CAPTURE_FILTER + 1];
+	struct pkt_capture_filter_prog *prog;
+	struct wlan_objmgr_vdev *vdev;
+	char *sptr, *token;
+	QDF_STATUS status;
+	int errno = 0;
+
+	if (!count || count > MAX_USER_COMMAND_SIZE_PKT_CAPTURE_FILTER)
+		return -EINVAL;
+
+	if (copy_from_user(cmd, buf, count))
+		return -EFAULT;
+	cmd[count] = '\0';
+	if (cmd[count - 1] == '\n')
+		cmd[count - 1] = '\0';
+
+	prog = qdf_mem_malloc(sizeof(*prog));
+	if (!prog)
+		return -ENOMEM;
+
+	sptr = cmd;
+	if (strcmp(cmd, "off")) {
+		while ((token = strsep(&sptr, " "))) {
+			if (!*token)
+				continue;
+
+			if (prog->num_rules == PKT_CAPTURE_FILTER_MAX_RULES) {
+				errno = -EINVAL;
+				goto free_prog;
+			}
+
+			errno = hdd_pkt_capture_parse_rule(token,
+						&prog->rules[prog->num_rules]);
+			if (errno)
+				goto free_prog;
+			prog->num_rules++;
+		}
+	}
+
+	vdev = hdd_objmgr_get_vdev_by_user(adapter, WLAN_OSIF_ID);
+	if (!vdev) {
+		errno = -EINVAL;
+		goto free_prog;
+	}
+
+	status = ucfg_pkt_capture_set_filter_prog(vdev, prog);
+	hdd_objmgr_put_vdev_by_user(vdev, WLAN_OSIF_ID);
+	errno = qdf_status_to_os_return(status);
+
+free_prog:
+	qdf_mem_free(prog);
+	if (errno) {
+		hdd_err("Invalid filter, format: off or [!]off,size,mask,val");
+		return errno;
+	}
+
+	return count;
+}
+
+/**
+ * hdd_pkt_capture_filter_write() - SSR wrapper for
+ *	__hdd_pkt_capture_filter_write
+ * @file: file pointer
+ * @buf: user buffer holding the command
+ * @count: command length
+ * @ppos: position pointer
+ *
+ * Return: number of bytes processed or errno
+ */
+static ssize_t hdd_pkt_capture_filter_write(struct file *file,
+					    const char __user *buf,
+					    size_t count, loff_t *ppos)
+{
+	struct net_device *net_dev = file_inode(file)->i_private;
+	struct osif_vdev_sync *vdev_sync;
+	ssize_t err_size;
+
+	err_size = osif_vdev_sync_op_start(net_dev, &vdev_sync);
+	if (err_size)
+		return err_size;
+
+	err_size = __hdd_pkt_capture_filter_write(net_dev, buf, count);
+
+	osif_vdev_sync_op_stop(vdev_sync);
+
+	return err_size;
+}
+
+/**
+ * __hdd_pkt_capture_filter_read() - Report the data capture path counters
+ * @net_dev: net_device context used to register the debugfs file
+ * @buf: user buffer
+ * @count: size of the user buffer
+ * @ppos: position pointer
+ *
+ * Return: number of bytes read or errno
+ */
+static ssize_t __hdd_pkt_capture_filter_read(struct net_device *net_dev,
+					     char __user *buf, size_t count,
+					     loff_t *ppos)
+{
+	struct hdd_adapter *adapter = WLAN_HDD_GET_PRIV_PTR(net_dev);
+	struct pkt_capture_data_stats stats = {0};
+	char out[PKT_CAPTURE_STATS_SIZE];
+	struct wlan_objmgr_vdev *vdev;
+	QDF_STATUS status;
+	int len;
+
+	vdev = hdd_objmgr_get_vdev_by_user(adapter, WLAN_OSIF_ID);
+	if (!vdev)
+		return -EINVAL;
+
+	status = ucfg_pkt_capture_get_data_stats(vdev, &stats);
+	hdd_objmgr_put_vdev_by_user(vdev, WLAN_OSIF_ID);
+	if (QDF_IS_STATUS_ERROR(status))
+		return qdf_status_to_os_return(status);
+
+	len = qdf_scnprintf(out, sizeof(out),
+			    "rx_filtered %u\nrx_truncated %u\nrx_stolen %u\n"
+			    "rx_cloned %u\nrx_copied %u\nrx_alloc_fail %u\n"
+			    "mon_pkt_drop %u\n",
+			    stats.rx_filtered, stats.rx_truncated,
+			    stats.rx_stolen, stats.rx_cloned, stats.rx_copied,
+			    stats.rx_alloc_fail, stats.mon_pkt_drop);
+
+	return simple_read_from_buffer(buf, count, ppos, out, len);
+}
+
+/**
+ * hdd_pkt_capture_filter_read() - SSR wrapper for
+ *	__hdd_pkt_capture_filter_read
+ * @file: file pointer
+ * @buf: user buffer
+ * @count: size of the user buffer
+ * @ppos: position pointer
+ *
+ * Return: number of bytes read or errno
+ */
+static ssize_t hdd_pkt_capture_filter_read(struct file *file,
+					   char __user *buf,
+					   size_t count, loff_t *ppos)
+{
+	struct net_device *net_dev = file_inode(file)->i_private;
+	struct osif_vdev_sync *vdev_sync;
+	ssize_t err_size;
+
+	err_size = osif_vdev_sync_op_start(net_dev, &vdev_sync);
+	if (err_size)
+		return err_size;
+
+	err_size = __hdd_pkt_capture_filter_read(net_dev, buf, count, ppos);
+
+	osif_vdev_sync_op_stop(vdev_sync);
+
+	return err_size;
+}
+
+static const struct file_operations fops_pkt_capture_filter = {
+	.read = hdd_pkt_capture_filter_read,
+	.write = hdd_pkt_capture_filter_write,
+	.open = wcnss_debugfs_open,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+/**
+ * hdd_debugfs_pkt_capture_init() - Create the packet capture filter file
+ * @adapter: interface adapter pointer
+ *
+ * The file is only created on station interfaces when packet capture is
+ * enabled, as those are the only vdevs packet capture runs on.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS hdd_debugfs_pkt_capture_init(struct hdd_adapter *adapter)
+{
+	struct hdd_context *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+
+	if (adapter->device_mode != QDF_STA_MODE ||
+	    ucfg_pkt_capture_get_mode(hdd_ctx->psoc) ==
+						PACKET_CAPTURE_MODE_DISABLE)
+		return QDF_STATUS_SUCCESS;
+
+	if (!debugfs_create_file("pkt_capture_filter", 00400 | 00200,
+				 adapter->debugfs_phy, adapter->dev,
+				 &fops_pkt_capture_filter))
+		return QDF_STATUS_E_FAILURE;
+
+	return QDF_STATUS_SUCCESS;
+}
+#else
+static inline QDF_STATUS
+hdd_debugfs_pkt_capture_init(struct hdd_adapter *adapter)
+{
+	return QDF_STATUS_SUCCESS;
+}
+#endif /* WLAN_FEATURE_PKT_CAPTURE */
+
 /**
  * hdd_debugfs_init() - Initialize debugfs interface
  * @adapter: interface adapter pointer
@@ -554,6 +811,9 @@ QDF_STATUS hdd_debugfs_init(struct hdd_adapter *adapter)
 	if (wlan_hdd_create_ll_stats_file(adapter))
 		return QDF_STATUS_E_FAILURE;
 
+	if (QDF_IS_STATUS_ERROR(hdd_debugfs_pkt_capture_init(adapter)))
+		return QDF_STATUS_E_FAILURE;
+
 	return QDF_STATUS_SUCCESS;
 }
 
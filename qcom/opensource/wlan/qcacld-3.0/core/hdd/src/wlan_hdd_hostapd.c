@@ -6307,6 +6307,7 @@ int wlan_hdd_cfg80211_start_bss(struct hdd_adapter *adapter,
 		hdd_green_ap_start_state_mc(hdd_ctx, adapter->device_mode,
 					    true);
 		wlan_set_sap_user_config_freq(vdev, user_config_freq);
+		policy_mgr_invalidate_pcl_cache(hdd_ctx->psoc);
 	}
 
 	wlan_hdd_dhcp_offload_enable(hdd_ctx, adapter);
@@ -6496,6 +6497,7 @@ static int __wlan_hdd_cfg80211_stop_ap(struct wiphy *wiphy,
 					    false);
 		wlan_twt_concurrency_update(hdd_ctx);
 		wlan_set_sap_user_config_freq(adapter->vdev, 0);
+		policy_mgr_invalidate_pcl_cache(hdd_ctx->psoc);
 		status = ucfg_if_mgr_deliver_event(adapter->vdev,
 				WLAN_IF_MGR_EV_AP_STOP_BSS_COMPLETE,
 				NULL);
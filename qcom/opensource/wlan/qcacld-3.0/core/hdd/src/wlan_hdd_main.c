@@ -218,6 +218,7 @@
 #include "osif_vdev_mgr_util.h"
 #include "osif_twt_util.h"
 #include "wlan_twt_ucfg_ext_api.h"
+#include "wlan_hdd_tx_flow_cache.h"
 #ifdef WLAN_FEATURE_DYNAMIC_RX_AGGREGATION
 #include <net/pkt_cls.h>
 #endif
@@ -11436,6 +11437,7 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 	rx_packets = rx_packets * bw_interval_us;
 	rx_packets = qdf_do_div(rx_packets, (uint32_t)diff_us);
 
+	hdd_bbm_predict_tick(hdd_ctx);
 	hdd_pld_request_bus_bandwidth(hdd_ctx, tx_packets, rx_packets, diff_us);
 
 	return;
@@ -11657,6 +11659,8 @@ static void hdd_display_stats_help(void)
 	HDD_DUMP_STAT_HELP(CDP_NAPI_STATS);
 	HDD_DUMP_STAT_HELP(CDP_DP_NAPI_STATS);
 	HDD_DUMP_STAT_HELP(CDP_DP_RX_THREAD_STATS);
+	HDD_DUMP_STAT_HELP(CDP_WBUFF_STATS);
+	HDD_DUMP_STAT_HELP(CDP_DP_LAT_TRACE_STATS);
 }
 
 int hdd_wlan_dump_stats(struct hdd_adapter *adapter, int stats_id)
@@ -11694,6 +11698,9 @@ int hdd_wlan_dump_stats(struct hdd_adapter *adapter, int stats_id)
 		sme_display_disconnect_stats(hdd_ctx->mac_handle,
 					     adapter->vdev_id);
 		break;
+	case CDP_WBUFF_STATS:
+		wbuff_display_stats();
+		break;
 	default:
 		status = cdp_display_stats(cds_get_context(QDF_MODULE_ID_SOC),
 					   stats_id,
@@ -11730,6 +11737,9 @@ int hdd_wlan_clear_stats(struct hdd_adapter *adapter, int stats_id)
 	case CDP_NAPI_STATS:
 		hdd_clear_napi_stats();
 		break;
+	case CDP_WBUFF_STATS:
+		wbuff_clear_stats();
+		break;
 	default:
 		status = cdp_clear_stats(cds_get_context(QDF_MODULE_ID_SOC),
 					 OL_TXRX_PDEV_ID,
@@ -11788,6 +11798,8 @@ void wlan_hdd_display_tx_rx_histogram(struct hdd_context *hdd_ctx)
 				       hist->is_tx_pm_qos_high ? "HIGH" : "LOW");
 		}
 	}
+
+	hdd_bbm_predict_display_hist(hdd_ctx);
 }
 
 /**
@@ -16308,6 +16320,7 @@ int hdd_wlan_startup(struct hdd_context *hdd_ctx)
 	hdd_set_idle_ps_config(hdd_ctx, is_imps_enabled);
 	hdd_debugfs_mws_coex_info_init(hdd_ctx);
 	hdd_debugfs_ini_config_init(hdd_ctx);
+	hdd_debugfs_mon_cap_ring_init(hdd_ctx);
 	wlan_hdd_debugfs_unit_test_host_create(hdd_ctx);
 	wlan_hdd_create_mib_stats_lock();
 	wlan_cfg80211_init_interop_issues_ap(hdd_ctx->pdev);
@@ -17131,6 +17144,7 @@ static void __hdd_bus_bw_compute_timer_start(struct hdd_context *hdd_ctx)
 	qdf_periodic_work_start(&hdd_ctx->bus_bw_work,
 				hdd_ctx->config->bus_bw_compute_interval);
 	hdd_ctx->bw_vote_time = qdf_get_log_timestamp();
+	hdd_bbm_predict_start(hdd_ctx);
 }
 
 void hdd_bus_bw_compute_timer_start(struct hdd_context *hdd_ctx)
@@ -17191,6 +17205,7 @@ exit:
 	param.policy_info.tput_level = TPUT_LEVEL_NONE;
 	hdd_bbm_apply_independent_policy(hdd_ctx, &param);
 
+	hdd_bbm_predict_stop(hdd_ctx);
 }
 
 void hdd_bus_bw_compute_timer_stop(struct hdd_context *hdd_ctx)
@@ -17618,6 +17633,7 @@ static void hdd_set_adapter_wlm_def_level(struct hdd_context *hdd_ctx)
 			wlan_hdd_deinit_multi_client_info_table(adapter);
 
 		adapter->upgrade_udp_qos_threshold = QCA_WLAN_AC_BK;
+		hdd_tx_flow_cache_flush(adapter);
 		hdd_debug("UDP packets qos reset to: %d",
 			  adapter->upgrade_udp_qos_threshold);
 		hdd_adapter_dev_put_debug(adapter, dbgid);
@@ -54,6 +54,7 @@
 #include "nan_ucfg_api.h"
 #include "wlan_pkt_capture_ucfg_api.h"
 #include "wlan_hdd_object_manager.h"
+#include "wlan_hdd_tx_flow_cache.h"
 
 /* Ms to Time Unit Micro Sec */
 #define MS_TO_TU_MUS(x)   ((x) * 1024)
@@ -1119,10 +1120,12 @@ __hdd_indicate_mgmt_frame_to_user(struct hdd_adapter *adapter,
 	/* Channel indicated may be wrong. TODO */
 	/* Indicate an action frame. */
 
-	if (hdd_is_qos_action_frame(pb_frames, frm_len))
+	if (hdd_is_qos_action_frame(pb_frames, frm_len)) {
 		sme_update_dsc_pto_up_mapping(hdd_ctx->mac_handle,
 					      adapter->dscp_to_up_map,
 					      adapter->vdev_id);
+		hdd_tx_flow_cache_flush(adapter);
+	}
 
 	/* Indicate Frame Over Normal Interface */
 	hdd_debug("Indicate Frame over NL80211 sessionid : %d, idx :%d",
@@ -86,6 +86,7 @@
 #include "wlan_pkt_capture_ucfg_api.h"
 #include "wlan_hdd_thermal.h"
 #include "wlan_hdd_object_manager.h"
+#include "wlan_hdd_twt_shaper.h"
 #include <linux/igmp.h>
 #include "qdf_types.h"
 #include <linux/cpuidle.h>
@@ -1678,6 +1679,8 @@ hdd_suspend_wlan(void)
 		wlan_hdd_netif_queue_control(adapter,
 					     WLAN_STOP_ALL_NETIF_QUEUE,
 					     WLAN_CONTROL_PATH);
+		/* send the held frames while the data path still takes them */
+		hdd_twt_shaper_suspend(adapter);
 
 		if (adapter->device_mode == QDF_STA_MODE)
 			status = hdd_enable_default_pkt_filters(adapter);
@@ -1744,6 +1747,7 @@ static int hdd_resume_wlan(void)
 
 		/* Disable supported OffLoads */
 		hdd_disable_host_offloads(adapter, pmo_apps_resume);
+		hdd_twt_shaper_resume(adapter);
 
 		/* wake the tx queues */
 		hdd_debug("Enabling queues for dev mode %s",
@@ -764,6 +764,7 @@ void hdd_update_indoor_channel(struct hdd_context *hdd_ctx,
 							  disable))) {
 		hdd_err("Failed to notify sap event");
 	}
+	policy_mgr_invalidate_pcl_cache(hdd_ctx->psoc);
 	hdd_exit();
 
 }
@@ -1879,6 +1880,8 @@ int hdd_update_regulatory_config(struct hdd_context *hdd_ctx)
 
 	reg_program_config_vars(hdd_ctx, &config_vars);
 	ucfg_reg_set_config_vars(hdd_ctx->psoc, config_vars);
+	/* SRD and indoor channel use in the PCL follow these */
+	policy_mgr_invalidate_pcl_cache(hdd_ctx->psoc);
 	return 0;
 }
 
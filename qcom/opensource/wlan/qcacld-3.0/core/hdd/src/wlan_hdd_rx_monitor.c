@@ -22,11 +22,13 @@
 #include <linux/skbuff.h>
 #include <linux/etherdevice.h>
 #include <linux/if_ether.h>
+#include <linux/debugfs.h>
 #include <cds_sched.h>
 #include <cds_utils.h>
 #include "wlan_hdd_rx_monitor.h"
 #include "ol_txrx.h"
 #include "cdp_txrx_mon.h"
+#include "osif_psoc_sync.h"
 
 void hdd_rx_monitor_callback(ol_osif_vdev_handle context,
 				qdf_nbuf_t rxbuf,
@@ -116,3 +118,182 @@ int hdd_disable_monitor_mode(void)
 
 	return cdp_reset_monitor_mode(soc, OL_TXRX_PDEV_ID, false);
 }
+
+#if defined(FEATURE_MONITOR_MODE_SUPPORT) && defined(QCA_MONITOR_CAP_RING) && \
+	defined(WLAN_DEBUGFS)
+#define HDD_MON_CAP_RING_CMD_SIZE 64
+#define HDD_MON_CAP_RING_STATS_SIZE 256
+
+/**
+ * __hdd_mon_cap_ring_write() - enable or disable the monitor capture ring
+ * @hdd_ctx: HDD context
+ * @buf: user buffer holding the command
+ * @count: command length
+ *
+ * "off" disables the ring, otherwise the command is
+ * "<snaplen> [<subbuf_size> <num_subbufs>]" and enables it. Zero values
+ * select the full MPDU and the DP default ring geometry respectively.
+ *
+ * Return: number of bytes processed or errno
+ */
+static ssize_t __hdd_mon_cap_ring_write(struct hdd_context *hdd_ctx,
+					const char __user *buf, size_t count)
+{
+	void *soc = cds_get_context(QDF_MODULE_ID_SOC);
+	struct cdp_mon_cap_ring_cfg cfg = {0};
+	char cmd[HDD_MON_CAP_RING_CMD_SIZE + 1];
+	char *sptr, *token;
+	QDF_STATUS status;
+
+	if (!soc)
+		return -EINVAL;
+
+	if (!count || count > HDD_MON_CAP_RING_CMD_SIZE)
+		return -EINVAL;
+
+	if (copy_from_user(cmd, buf, count))
+		return -EFAULT;
+	cmd[count] = '\0';
+	if (cmd[count - 1] == '\n')
+		cmd[count - 1] = '\0';
+
+	if (!strcmp(cmd, "off")) {
+		status = cdp_mon_cap_ring_disable(soc, OL_TXRX_PDEV_ID);
+		if (status == QDF_STATUS_E_ALREADY)
+			return count;
+
+		return QDF_IS_STATUS_ERROR(status) ?
+			qdf_status_to_os_return(status) : count;
+	}
+
+	sptr = cmd;
+	token = strsep(&sptr, " ");
+	if (!token || kstrtou32(token, 0, &cfg.snaplen))
+		return -EINVAL;
+
+	token = strsep(&sptr, " ");
+	if (token) {
+		if (kstrtou32(token, 0, &cfg.subbuf_size))
+			return -EINVAL;
+
+		token = strsep(&sptr, " ");
+		if (!token || kstrtou32(token, 0, &cfg.num_subbufs))
+			return -EINVAL;
+	}
+
+	cfg.filter.mode = MON_FILTER_ALL;
+	cfg.filter.fp_mgmt = FILTER_MGMT_ALL;
+	cfg.filter.fp_ctrl = FILTER_CTRL_ALL;
+	cfg.filter.fp_data = FILTER_DATA_ALL;
+	cfg.filter.mo_mgmt = FILTER_MGMT_ALL;
+	cfg.filter.mo_ctrl = FILTER_CTRL_ALL;
+	cfg.filter.mo_data = FILTER_DATA_ALL;
+
+	status = cdp_mon_cap_ring_enable(soc, OL_TXRX_PDEV_ID, &cfg);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		hdd_err("capture ring enable failed: %d", status);
+		return qdf_status_to_os_return(status);
+	}
+
+	return count;
+}
+
+/**
+ * hdd_mon_cap_ring_write() - SSR wrapper for __hdd_mon_cap_ring_write
+ * @file: file pointer
+ * @buf: user buffer holding the command
+ * @count: command length
+ * @ppos: position pointer
+ *
+ * Return: number of bytes processed or errno
+ */
+static ssize_t hdd_mon_cap_ring_write(struct file *file,
+				      const char __user *buf,
+				      size_t count, loff_t *ppos)
+{
+	struct hdd_context *hdd_ctx = file_inode(file)->i_private;
+	struct osif_psoc_sync *psoc_sync;
+	ssize_t errno_size;
+
+	errno_size = wlan_hdd_validate_context(hdd_ctx);
+	if (errno_size)
+		return errno_size;
+
+	errno_size = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy),
+					     &psoc_sync);
+	if (errno_size)
+		return errno_size;
+
+	errno_size = __hdd_mon_cap_ring_write(hdd_ctx, buf, count);
+
+	osif_psoc_sync_op_stop(psoc_sync);
+
+	return errno_size;
+}
+
+/**
+ * hdd_mon_cap_ring_read() - report the monitor capture ring stats
+ * @file: file pointer
+ * @buf: user buffer
+ * @count: size of the user buffer
+ * @ppos: position pointer
+ *
+ * Return: number of bytes read or errno
+ */
+static ssize_t hdd_mon_cap_ring_read(struct file *file, char __user *buf,
+				     size_t count, loff_t *ppos)
+{
+	struct hdd_context *hdd_ctx = file_inode(file)->i_private;
+	void *soc = cds_get_context(QDF_MODULE_ID_SOC);
+	struct cdp_mon_cap_ring_stats stats = {0};
+	struct osif_psoc_sync *psoc_sync;
+	char out[HDD_MON_CAP_RING_STATS_SIZE];
+	QDF_STATUS status;
+	ssize_t errno_size;
+	int len;
+
+	errno_size = wlan_hdd_validate_context(hdd_ctx);
+	if (errno_size)
+		return errno_size;
+
+	if (!soc)
+		return -EINVAL;
+
+	errno_size = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy),
+					     &psoc_sync);
+	if (errno_size)
+		return errno_size;
+
+	status = cdp_mon_cap_ring_get_stats(soc, OL_TXRX_PDEV_ID, &stats);
+	osif_psoc_sync_op_stop(psoc_sync);
+	if (QDF_IS_STATUS_ERROR(status))
+		return qdf_status_to_os_return(status);
+
+	len = qdf_scnprintf(out, sizeof(out),
+			    "mpdu_captured %llu\nbytes_captured %llu\n"
+			    "mpdu_truncated %u\ndrop_ring_full %u\n"
+			    "drop_restitch %u\n",
+			    stats.mpdu_captured, stats.bytes_captured,
+			    stats.mpdu_truncated, stats.drop_ring_full,
+			    stats.drop_restitch);
+
+	return simple_read_from_buffer(buf, count, ppos, out, len);
+}
+
+static const struct file_operations fops_mon_cap_ring = {
+	.read = hdd_mon_cap_ring_read,
+	.write = hdd_mon_cap_ring_write,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+int hdd_debugfs_mon_cap_ring_init(struct hdd_context *hdd_ctx)
+{
+	if (!debugfs_create_file("mon_cap_ring", 00400 | 00200,
+				 qdf_debugfs_get_root(), hdd_ctx,
+				 &fops_mon_cap_ring))
+		return -EINVAL;
+
+	return 0;
+}
+#endif /* QCA_MONITOR_CAP_RING */
@@ -20,6 +20,7 @@
 #define __WLAN_HDD_RX_MONITOR_H
 
 struct ol_txrx_ops;
+struct hdd_context;
 
 #ifdef FEATURE_MONITOR_MODE_SUPPORT
 /**
@@ -83,5 +84,26 @@ static inline int hdd_disable_monitor_mode(void)
 
 #endif /* FEATURE_MONITOR_MODE_SUPPORT */
 
+#if defined(FEATURE_MONITOR_MODE_SUPPORT) && defined(QCA_MONITOR_CAP_RING) && \
+	defined(WLAN_DEBUGFS)
+/**
+ * hdd_debugfs_mon_cap_ring_init() - create the monitor capture ring file
+ * @hdd_ctx: HDD context
+ *
+ * Writing "<snaplen> [<subbuf_size> <num_subbufs>]" to mon_cap_ring enables
+ * the DP capture ring, "off" disables it and reading it returns the ring
+ * stats. The ring is torn down with the DP pdev, the file with the debugfs
+ * root.
+ *
+ * Return: 0 on success, errno otherwise
+ */
+int hdd_debugfs_mon_cap_ring_init(struct hdd_context *hdd_ctx);
+#else
+static inline int hdd_debugfs_mon_cap_ring_init(struct hdd_context *hdd_ctx)
+{
+	return 0;
+}
+#endif /* QCA_MONITOR_CAP_RING */
+
 #endif /* __WLAN_HDD_RX_MONITOR_H */
 
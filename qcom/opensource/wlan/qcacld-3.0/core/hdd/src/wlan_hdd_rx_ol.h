@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#if !defined(WLAN_HDD_RX_OL_H)
+#define WLAN_HDD_RX_OL_H
+/**
+ * DOC: wlan_hdd_rx_ol.h
+ *
+ * Rx offload engine
+ *
+ * The rx offload mode resolved by hdd_rx_ol_init() used to apply to every
+ * frame alike. The engine instead picks the offload path of each frame
+ * from the hints the target put in the nbuf control block:
+ *
+ *  - frames already aggregated by FISA are delivered as is,
+ *  - TCP frames eligible for LRO go to qdf_lro when LRO is the mode,
+ *  - TCP frames with a flow hash from the RX TLV go to GRO keyed by that
+ *    hash,
+ *  - other TCP frames go to GRO keyed by a hash computed by the stack, so
+ *    that flows without a target hash do not all share one GRO bucket,
+ *  - anything else is delivered without aggregation.
+ *
+ * The path picked is counted per adapter, which gives the split between
+ * the paths of a given traffic mix in the txrx stats.
+ */
+
+#include "wlan_hdd_main.h"
+
+#ifdef RECEIVE_OFFLOAD
+/**
+ * hdd_gro_rx_bh_disable() - GRO RX/flush function.
+ * @adapter: adapter the frame is received on
+ * @napi_to_use: napi to be used to give packets to the stack, gro flush
+ * @skb: pointer to sk_buff
+ *
+ * Function calls napi_gro_receive for the skb. If the skb indicates that a
+ * flush needs to be done (set by the lower DP layer), the function also calls
+ * napi_gro_flush. Local softirqs are disabled (and later enabled) while making
+ * napi_gro__ calls.
+ *
+ * Return: QDF_STATUS_SUCCESS if not dropped by napi_gro_receive or
+ *	   QDF error code.
+ */
+QDF_STATUS hdd_gro_rx_bh_disable(struct hdd_adapter *adapter,
+				 struct napi_struct *napi_to_use,
+				 struct sk_buff *skb);
+#endif
+
+#if defined(RECEIVE_OFFLOAD) && defined(WLAN_HDD_RX_OL_ENGINE)
+/**
+ * hdd_rx_ol_engine_init() - put the rx offload engine in front of the
+ * receive offload callback of the resolved mode
+ * @hdd_ctx: pointer to hdd_ctx
+ *
+ * The flush callbacks registered for the mode are kept, the engine only
+ * picks the path of each frame.
+ *
+ * Return: none
+ */
+void hdd_rx_ol_engine_init(struct hdd_context *hdd_ctx);
+#else
+static inline void hdd_rx_ol_engine_init(struct hdd_context *hdd_ctx)
+{
+}
+#endif
+
+#ifdef WLAN_HDD_RX_OL_ENGINE
+/**
+ * hdd_rx_ol_select() - pick the receive offload path of a frame
+ * @engine: rx offload engine
+ * @skb: frame being delivered to the stack
+ *
+ * Return: path of the frame
+ */
+static inline enum hdd_rx_ol_path
+hdd_rx_ol_select(struct hdd_rx_ol_engine *engine, struct sk_buff *skb)
+{
+	uint32_t paths = engine->paths;
+
+	if (skb_is_gso(skb))
+		return (paths & BIT(HDD_RX_OL_PATH_FISA)) ?
+			HDD_RX_OL_PATH_FISA : HDD_RX_OL_PATH_NONE;
+
+	if (!QDF_NBUF_CB_RX_TCP_PROTO(skb))
+		return HDD_RX_OL_PATH_NONE;
+
+	if ((paths & BIT(HDD_RX_OL_PATH_LRO)) &&
+	    QDF_NBUF_CB_RX_LRO_ELIGIBLE(skb))
+		return HDD_RX_OL_PATH_LRO;
+
+	if ((paths & BIT(HDD_RX_OL_PATH_HW_GRO)) &&
+	    QDF_NBUF_CB_RX_FLOW_ID(skb))
+		return HDD_RX_OL_PATH_HW_GRO;
+
+	if (paths & BIT(HDD_RX_OL_PATH_SW_GRO))
+		return HDD_RX_OL_PATH_SW_GRO;
+
+	return HDD_RX_OL_PATH_NONE;
+}
+
+/**
+ * hdd_rx_ol_engine_rx() - hand a frame to its receive offload path
+ * @engine: rx offload engine
+ * @adapter: adapter the frame is received on
+ * @skb: frame being delivered to the stack
+ * @path_cnt: per path frame counters, HDD_RX_OL_PATH_MAX entries
+ *
+ * The GRO paths set the flow hash GRO is keyed by before the frame is
+ * handed to GRO.
+ *
+ * Return: QDF_STATUS_SUCCESS if the frame was consumed by its path,
+ *	   QDF_STATUS_E_NOSUPPORT if it is to be delivered without offload,
+ *	   or the error of the path
+ */
+static inline QDF_STATUS hdd_rx_ol_engine_rx(struct hdd_rx_ol_engine *engine,
+					     struct hdd_adapter *adapter,
+					     struct sk_buff *skb,
+					     uint32_t *path_cnt)
+{
+	enum hdd_rx_ol_path path = hdd_rx_ol_select(engine, skb);
+
+	path_cnt[path]++;
+
+	if (path == HDD_RX_OL_PATH_HW_GRO)
+		skb_set_hash(skb, QDF_NBUF_CB_RX_FLOW_ID(skb),
+			     PKT_HASH_TYPE_L4);
+	else if (path == HDD_RX_OL_PATH_SW_GRO)
+		skb_get_hash(skb);
+
+	if (!engine->rx[path])
+		return QDF_STATUS_E_NOSUPPORT;
+
+	return engine->rx[path](adapter, skb);
+}
+
+/**
+ * hdd_rx_ol_eligible() - check if a frame is handed to receive_offload_cb
+ * @skb: frame being delivered to the stack
+ *
+ * Return: true for TCP frames and frames aggregated by FISA, unless they
+ *	   were cached before the peer was registered
+ */
+static inline bool hdd_rx_ol_eligible(struct sk_buff *skb)
+{
+	return (QDF_NBUF_CB_RX_TCP_PROTO(skb) || skb_is_gso(skb)) &&
+		!QDF_NBUF_CB_RX_PEER_CACHED_FRM(skb);
+}
+#else
+static inline bool hdd_rx_ol_eligible(struct sk_buff *skb)
+{
+	return QDF_NBUF_CB_RX_TCP_PROTO(skb) &&
+		!QDF_NBUF_CB_RX_PEER_CACHED_FRM(skb);
+}
+#endif /* WLAN_HDD_RX_OL_ENGINE */
+#endif /* WLAN_HDD_RX_OL_H */
@@ -696,6 +696,7 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 
 	hdd_pkt_add_timestamp(adapter, QDF_PKT_TX_DRIVER_ENTRY,
 			      qdf_get_log_timestamp(), skb);
+	hdd_lat_trace_stamp(skb, CDP_LAT_TX_HDD_XMIT);
 
 	if (QDF_IS_STATUS_ERROR(hdd_softap_validate_peer_state(adapter, skb)))
 		goto drop_pkt;
@@ -1120,6 +1121,7 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 		skb = next;
 		next = skb->next;
 		skb->next = NULL;
+		hdd_lat_trace_stamp(skb, CDP_LAT_RX_HDD);
 
 		hdd_softap_dump_sk_buff(skb);
 
@@ -1202,6 +1204,7 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 				qdf_status = QDF_STATUS_E_INVAL;
 			dev_kfree_skb(skb);
 		} else {
+			hdd_lat_trace_stamp(skb, CDP_LAT_RX_STACK);
 			qdf_status = hdd_rx_deliver_to_stack(adapter, skb);
 		}
 
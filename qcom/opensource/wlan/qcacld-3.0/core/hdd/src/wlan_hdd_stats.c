@@ -7152,6 +7152,85 @@ void wlan_hdd_display_tx_multiq_stats(struct hdd_tx_rx_stats *stats)
 }
 #endif
 
+#ifdef WLAN_HDD_TX_FLOW_CACHE
+static inline
+void wlan_hdd_display_tx_flow_cache_stats(struct hdd_tx_rx_stats *stats)
+{
+	uint32_t total_qselect_hit = 0;
+	uint32_t total_qselect_miss = 0;
+	uint32_t total_tx_hit = 0;
+	uint32_t total_tx_miss = 0;
+	uint8_t i;
+
+	for (i = 0; i < NUM_CPUS; i++) {
+		total_qselect_hit += stats->per_cpu[i].qselect_flow_hit;
+		total_qselect_miss += stats->per_cpu[i].qselect_flow_miss;
+		total_tx_hit += stats->per_cpu[i].tx_flow_hit;
+		total_tx_miss += stats->per_cpu[i].tx_flow_miss;
+	}
+
+	hdd_debug("TX_FLOW_CACHE: qselect hit %u miss %u xmit hit %u miss %u",
+		  total_qselect_hit, total_qselect_miss,
+		  total_tx_hit, total_tx_miss);
+}
+#else
+static inline
+void wlan_hdd_display_tx_flow_cache_stats(struct hdd_tx_rx_stats *stats)
+{
+}
+#endif
+
+#ifdef WLAN_HDD_RX_OL_ENGINE
+static inline
+void wlan_hdd_display_rx_ol_engine_stats(struct hdd_tx_rx_stats *stats)
+{
+	hdd_debug("RX_OL_ENGINE: none %u fisa %u lro %u hw_gro %u sw_gro %u",
+		  stats->rx_ol_path[HDD_RX_OL_PATH_NONE],
+		  stats->rx_ol_path[HDD_RX_OL_PATH_FISA],
+		  stats->rx_ol_path[HDD_RX_OL_PATH_LRO],
+		  stats->rx_ol_path[HDD_RX_OL_PATH_HW_GRO],
+		  stats->rx_ol_path[HDD_RX_OL_PATH_SW_GRO]);
+}
+#else
+static inline
+void wlan_hdd_display_rx_ol_engine_stats(struct hdd_tx_rx_stats *stats)
+{
+}
+#endif
+
+#ifdef WLAN_HDD_TWT_SHAPER
+static void wlan_hdd_display_twt_shaper_stats(struct hdd_adapter *adapter)
+{
+	struct hdd_twt_shaper_stats *stats = &adapter->twt_shaper.stats;
+	uint32_t total_tx;
+	uint32_t eff = 0;
+
+	if (!stats->sps && !stats->held)
+		return;
+
+	total_tx = stats->tx_in_sp + stats->tx_urgent + stats->tx_deadline +
+		   stats->overflow + stats->tx_suspend;
+	if (total_tx)
+		eff = qdf_do_div((uint64_t)stats->tx_in_sp * 100, total_tx);
+
+	hdd_debug("TWT_SHAPER: sps %u idle %u held %u in_sp %u urgent %u deadline %u overflow %u dropped %u max_batch %u eff %u%%",
+		  stats->sps, stats->sps_idle, stats->held, stats->tx_in_sp,
+		  stats->tx_urgent, stats->tx_deadline, stats->overflow,
+		  stats->dropped, stats->max_batch, eff);
+	hdd_debug("TWT_SHAPER: suspend %u resyncs %u rejected %u",
+		  stats->tx_suspend, stats->resyncs, stats->resyncs_rejected);
+	hdd_debug("TWT_SHAPER: batch 0 %u 1-4 %u 5-16 %u 17-64 %u 65+ %u",
+		  stats->batch_hist[0], stats->batch_hist[1],
+		  stats->batch_hist[2], stats->batch_hist[3],
+		  stats->batch_hist[4]);
+}
+#else
+static inline
+void wlan_hdd_display_twt_shaper_stats(struct hdd_adapter *adapter)
+{
+}
+#endif
+
 void wlan_hdd_display_txrx_stats(struct hdd_context *ctx)
 {
 	struct hdd_adapter *adapter = NULL, *next_adapter = NULL;
@@ -7209,6 +7288,8 @@ void wlan_hdd_display_txrx_stats(struct hdd_context *ctx)
 			  total_tx_orphaned);
 
 		wlan_hdd_display_tx_multiq_stats(stats);
+		wlan_hdd_display_tx_flow_cache_stats(stats);
+		wlan_hdd_display_twt_shaper_stats(adapter);
 
 		for (i = 0; i < NUM_CPUS; i++) {
 			if (stats->per_cpu[i].rx_packets == 0)
@@ -7230,6 +7311,8 @@ void wlan_hdd_display_txrx_stats(struct hdd_context *ctx)
 			  stats->rx_gro_low_tput_flush,
 			  qdf_atomic_read(&ctx->disable_rx_ol_in_concurrency),
 			  qdf_atomic_read(&ctx->disable_rx_ol_in_low_tput));
+
+		wlan_hdd_display_rx_ol_engine_stats(stats);
 	}
 }
 
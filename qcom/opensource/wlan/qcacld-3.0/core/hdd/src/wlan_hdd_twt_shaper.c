@@ -0,0 +1,580 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_twt_shaper.c
+ *
+ * TWT aware tx shaping, see wlan_hdd_twt_shaper.h
+ */
+
+#include "qdf_hrtimer.h"
+#include "qdf_time.h"
+#include "wlan_hdd_tsf.h"
+#include "wlan_hdd_twt_shaper.h"
+
+/* BE TIDs are released ahead of BK ones */
+static const uint8_t hdd_twt_shaper_tid_order[HDD_TWT_SHAPER_NUM_TIDS] = {
+	7, 6, 5, 4, 3, 0, 2, 1
+};
+
+static inline uint64_t hdd_twt_shaper_now_us(void)
+{
+	return qdf_ktime_to_us(qdf_ktime_get());
+}
+
+/**
+ * hdd_twt_shaper_arm() - start the timer for the next update
+ * @shaper: TWT shaper, locked
+ * @now_us: current time
+ *
+ * Return: None
+ */
+static void hdd_twt_shaper_arm(struct hdd_twt_shaper *shaper, uint64_t now_us)
+{
+	uint64_t expiry_us = hdd_twt_shaper_expiry(shaper);
+	uint64_t delay_us = 0;
+
+	if (expiry_us > now_us)
+		delay_us = expiry_us - now_us;
+
+	qdf_hrtimer_start(&shaper->timer,
+			  qdf_ns_to_ktime(delay_us * NSEC_PER_USEC),
+			  QDF_HRTIMER_MODE_REL);
+}
+
+/**
+ * hdd_twt_shaper_resync() - line the schedule up with the TSF
+ * @adapter: adapter
+ * @now_us: current time
+ *
+ * Called with the shaper locked and no service period open. Does nothing
+ * until HDD_TWT_SHAPER_RESYNC_US passed since the last check, or when
+ * firmware did not report the TSF of a service period or there is no host
+ * to TSF sync.
+ *
+ * Return: None
+ */
+static void hdd_twt_shaper_resync(struct hdd_adapter *adapter,
+				  uint64_t now_us)
+{
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+	uint64_t tsf_us;
+	uint32_t to_sp_us;
+
+	if (!shaper->sp_tsf_us || now_us < shaper->resync_us)
+		return;
+
+	shaper->resync_us = now_us + HDD_TWT_SHAPER_RESYNC_US;
+	if (QDF_IS_STATUS_ERROR(hdd_get_tsf_time(adapter,
+						 qdf_get_log_timestamp(),
+						 &tsf_us)))
+		return;
+
+	if (tsf_us < shaper->sp_tsf_us) {
+		if (shaper->sp_tsf_us - tsf_us > shaper->wake_intvl_us)
+			return;
+		to_sp_us = shaper->sp_tsf_us - tsf_us;
+	} else {
+		to_sp_us = shaper->wake_intvl_us -
+			   qdf_do_div_rem(tsf_us - shaper->sp_tsf_us,
+					  shaper->wake_intvl_us);
+	}
+
+	hdd_twt_shaper_reanchor(shaper, now_us, to_sp_us);
+}
+
+/**
+ * hdd_twt_shaper_dequeue() - take all the held frames
+ * @shaper: TWT shaper, locked
+ * @q: queue the frames are appended to, BE TIDs first
+ *
+ * Return: number of frames taken
+ */
+static uint32_t hdd_twt_shaper_dequeue(struct hdd_twt_shaper *shaper,
+				       qdf_nbuf_queue_t *q)
+{
+	uint32_t frames = shaper->held;
+	uint8_t tid;
+	int i;
+
+	for (i = 0; i < HDD_TWT_SHAPER_NUM_TIDS; i++) {
+		tid = hdd_twt_shaper_tid_order[i];
+		qdf_nbuf_queue_append(q, &shaper->tidq[tid]);
+		qdf_nbuf_queue_init(&shaper->tidq[tid]);
+	}
+	shaper->held = 0;
+
+	if (!shaper->enabled)
+		return frames;
+
+	if (shaper->open) {
+		shaper->sp_tx += frames;
+		shaper->stats.tx_in_sp += frames;
+	} else {
+		shaper->stats.tx_deadline += frames;
+	}
+
+	return frames;
+}
+
+static void hdd_twt_shaper_drop(struct hdd_adapter *adapter,
+				qdf_nbuf_queue_t *q)
+{
+	struct sk_buff *skb;
+
+	while ((skb = qdf_nbuf_queue_remove(q))) {
+		qdf_net_buf_debug_release_skb(skb);
+		kfree_skb(skb);
+		++adapter->stats.tx_dropped;
+	}
+}
+
+/**
+ * hdd_twt_shaper_send() - send released frames to the data path
+ * @adapter: adapter the frames were held for
+ * @q: released frames
+ *
+ * Return: None
+ */
+static void hdd_twt_shaper_send(struct hdd_adapter *adapter,
+				qdf_nbuf_queue_t *q)
+{
+	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
+	void *soc = cds_get_context(QDF_MODULE_ID_SOC);
+	struct sk_buff *skb;
+
+	if (!adapter->tx_fn || cds_is_driver_transitioning() ||
+	    hdd_ctx->hdd_wlan_suspended) {
+		adapter->twt_shaper.stats.dropped += qdf_nbuf_queue_len(q);
+		hdd_twt_shaper_drop(adapter, q);
+		return;
+	}
+
+	while ((skb = qdf_nbuf_queue_remove(q))) {
+		if (!adapter->tx_fn(soc, adapter->vdev_id, (qdf_nbuf_t)skb))
+			continue;
+
+		hdd_dp_debug_rl("Failed to send held packet from adapter %u",
+				adapter->vdev_id);
+		adapter->twt_shaper.stats.dropped++;
+		qdf_net_buf_debug_release_skb(skb);
+		kfree_skb(skb);
+		++adapter->stats.tx_dropped;
+	}
+}
+
+/**
+ * hdd_twt_shaper_release_bh() - move the shaper through the schedule and
+ * send the released frames
+ * @arg: adapter
+ *
+ * Frames that come in while a release is in progress in a service period
+ * are queued behind the released ones and sent in the same run, so that
+ * the frames of a TID are not reordered.
+ *
+ * Return: None
+ */
+static void hdd_twt_shaper_release_bh(void *arg)
+{
+	struct hdd_adapter *adapter = arg;
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+	enum hdd_twt_shaper_release release;
+	uint64_t now_us = hdd_twt_shaper_now_us();
+	qdf_nbuf_queue_t q;
+
+	qdf_spin_lock_bh(&shaper->lock);
+	if (shaper->enabled) {
+		release = hdd_twt_shaper_update(shaper, now_us);
+		if (release != HDD_TWT_SHAPER_RELEASE_NONE)
+			shaper->releasing = true;
+		if (!shaper->open)
+			hdd_twt_shaper_resync(adapter, now_us);
+		hdd_twt_shaper_arm(shaper, now_us);
+	}
+	qdf_spin_unlock_bh(&shaper->lock);
+
+	while (true) {
+		qdf_nbuf_queue_init(&q);
+
+		qdf_spin_lock_bh(&shaper->lock);
+		if (!shaper->releasing || !shaper->held) {
+			shaper->releasing = false;
+			qdf_spin_unlock_bh(&shaper->lock);
+			break;
+		}
+
+		hdd_twt_shaper_dequeue(shaper, &q);
+		/* frames held from now on wait for the next service period */
+		if (shaper->enabled && !shaper->open)
+			shaper->releasing = false;
+		qdf_spin_unlock_bh(&shaper->lock);
+
+		hdd_twt_shaper_send(adapter, &q);
+	}
+}
+
+static enum qdf_hrtimer_restart_status
+hdd_twt_shaper_timer_cb(qdf_hrtimer_data_t *timer)
+{
+	struct hdd_twt_shaper *shaper = qdf_container_of(timer,
+							 struct hdd_twt_shaper,
+							 timer);
+
+	qdf_sched_bh(&shaper->release_bh);
+
+	return QDF_HRTIMER_NORESTART;
+}
+
+bool __hdd_twt_shaper_tx(struct hdd_adapter *adapter, struct sk_buff *skb,
+			 sme_ac_enum_type ac)
+{
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+	uint8_t tid = skb->priority & (HDD_TWT_SHAPER_NUM_TIDS - 1);
+	uint64_t now_us;
+	bool held = false;
+
+	qdf_spin_lock_bh(&shaper->lock);
+	if (!shaper->enabled)
+		goto unlock;
+
+	if (hdd_twt_shaper_is_urgent(skb, ac) ||
+	    (shaper->open && !shaper->releasing)) {
+		if (shaper->open) {
+			shaper->sp_tx++;
+			shaper->stats.tx_in_sp++;
+		} else {
+			shaper->stats.tx_urgent++;
+		}
+		goto unlock;
+	}
+
+	if (shaper->held >= HDD_TWT_SHAPER_MAX_HELD) {
+		shaper->stats.overflow++;
+		goto unlock;
+	}
+
+	if (!shaper->held) {
+		now_us = hdd_twt_shaper_now_us();
+		shaper->first_hold_us = now_us;
+		/* the deadline may now come before the next service period */
+		if (!shaper->open)
+			hdd_twt_shaper_arm(shaper, now_us);
+	}
+
+	qdf_nbuf_queue_add(&shaper->tidq[tid], skb);
+	shaper->held++;
+	if (!shaper->open)
+		shaper->stats.held++;
+	held = true;
+
+unlock:
+	qdf_spin_unlock_bh(&shaper->lock);
+
+	return held;
+}
+
+/**
+ * hdd_twt_shaper_start() - start or carry on shaping
+ * @shaper: TWT shaper, locked
+ *
+ * The schedule carries on with the phase it had. While the system is
+ * suspended shaping only starts on resume.
+ *
+ * Return: None
+ */
+static void hdd_twt_shaper_start(struct hdd_twt_shaper *shaper)
+{
+	uint64_t now_us;
+
+	if (shaper->suspended) {
+		shaper->resume_enable = true;
+		return;
+	}
+
+	now_us = hdd_twt_shaper_now_us();
+	hdd_twt_shaper_skip_sps(shaper, now_us);
+	shaper->resync_us = now_us;
+	shaper->enabled = true;
+	hdd_twt_shaper_arm(shaper, now_us);
+}
+
+/**
+ * hdd_twt_shaper_stop() - stop shaping
+ * @shaper: TWT shaper, locked
+ *
+ * hdd_twt_shaper_stopped() is to be called once the shaper is unlocked.
+ *
+ * Return: true if the held frames are to be sent
+ */
+static bool hdd_twt_shaper_stop(struct hdd_twt_shaper *shaper)
+{
+	if (shaper->open)
+		hdd_twt_shaper_close_sp(shaper);
+	shaper->enabled = false;
+	shaper->resume_enable = false;
+	if (!shaper->held)
+		return false;
+
+	shaper->releasing = true;
+	return true;
+}
+
+/**
+ * hdd_twt_shaper_stopped() - finish stopping the shaper
+ * @shaper: TWT shaper, unlocked
+ * @release: the held frames are to be sent, see hdd_twt_shaper_stop()
+ *
+ * Return: None
+ */
+static void hdd_twt_shaper_stopped(struct hdd_twt_shaper *shaper,
+				   bool release)
+{
+	qdf_hrtimer_cancel(&shaper->timer);
+	if (release)
+		qdf_sched_bh(&shaper->release_bh);
+}
+
+static struct hdd_twt_shaper *
+hdd_twt_shaper_get(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id)
+{
+	struct hdd_adapter *adapter;
+
+	adapter = wlan_hdd_get_adapter_from_vdev(psoc, vdev_id);
+	if (!adapter || !adapter->twt_shaper.initialized)
+		return NULL;
+
+	return &adapter->twt_shaper;
+}
+
+void __hdd_twt_shaper_setup(struct hdd_adapter *adapter, uint32_t dialog_id,
+			    uint32_t wake_dur_us, uint32_t wake_intvl_us,
+			    uint32_t sp_offset_us, uint64_t sp_tsf_us)
+{
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+	uint8_t vdev_id = adapter->vdev_id;
+
+	if (!shaper->initialized)
+		return;
+
+	if (!wake_dur_us || wake_dur_us >= wake_intvl_us ||
+	    wake_intvl_us <= HDD_TWT_SHAPER_LEAD_US) {
+		hdd_debug("vdev %u dialog %u: not shaping for dur %u intvl %u",
+			  vdev_id, dialog_id, wake_dur_us, wake_intvl_us);
+		return;
+	}
+
+	qdf_spin_lock_bh(&shaper->lock);
+	if (shaper->wake_intvl_us && shaper->dialog_id != dialog_id) {
+		qdf_spin_unlock_bh(&shaper->lock);
+		hdd_debug("vdev %u: already shaping for dialog %u",
+			  vdev_id, shaper->dialog_id);
+		return;
+	}
+
+	shaper->dialog_id = dialog_id;
+	shaper->wake_dur_us = wake_dur_us;
+	shaper->wake_intvl_us = wake_intvl_us;
+	shaper->next_sp_us = hdd_twt_shaper_now_us() + sp_offset_us;
+	shaper->sp_tsf_us = sp_tsf_us;
+	shaper->open = false;
+	shaper->sp_tx = 0;
+	hdd_twt_shaper_start(shaper);
+	qdf_spin_unlock_bh(&shaper->lock);
+
+	hdd_debug("vdev %u dialog %u: shaping for dur %u intvl %u offset %u tsf %llu",
+		  vdev_id, dialog_id, wake_dur_us, wake_intvl_us,
+		  sp_offset_us, sp_tsf_us);
+}
+
+void hdd_twt_shaper_setup(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			  uint32_t dialog_id, uint32_t wake_dur_us,
+			  uint32_t wake_intvl_us, uint32_t sp_offset_us,
+			  uint64_t sp_tsf_us)
+{
+	struct hdd_adapter *adapter;
+
+	adapter = wlan_hdd_get_adapter_from_vdev(psoc, vdev_id);
+	if (!adapter)
+		return;
+
+	__hdd_twt_shaper_setup(adapter, dialog_id, wake_dur_us, wake_intvl_us,
+			       sp_offset_us, sp_tsf_us);
+}
+
+void hdd_twt_shaper_teardown(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			     uint32_t dialog_id)
+{
+	struct hdd_twt_shaper *shaper = hdd_twt_shaper_get(psoc, vdev_id);
+	bool release;
+
+	if (!shaper)
+		return;
+
+	qdf_spin_lock_bh(&shaper->lock);
+	if (!shaper->wake_intvl_us || shaper->dialog_id != dialog_id) {
+		qdf_spin_unlock_bh(&shaper->lock);
+		return;
+	}
+
+	release = hdd_twt_shaper_stop(shaper);
+	shaper->wake_intvl_us = 0;
+	shaper->sp_tsf_us = 0;
+	qdf_spin_unlock_bh(&shaper->lock);
+
+	hdd_twt_shaper_stopped(shaper, release);
+	hdd_debug("vdev %u dialog %u: shaping stopped", vdev_id, dialog_id);
+}
+
+void hdd_twt_shaper_pause(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			  uint32_t dialog_id, bool pause)
+{
+	struct hdd_twt_shaper *shaper = hdd_twt_shaper_get(psoc, vdev_id);
+	bool release = false;
+
+	if (!shaper)
+		return;
+
+	qdf_spin_lock_bh(&shaper->lock);
+	if (!shaper->wake_intvl_us || shaper->dialog_id != dialog_id) {
+		qdf_spin_unlock_bh(&shaper->lock);
+		return;
+	}
+
+	if (pause)
+		release = hdd_twt_shaper_stop(shaper);
+	else
+		hdd_twt_shaper_start(shaper);
+	qdf_spin_unlock_bh(&shaper->lock);
+
+	if (pause)
+		hdd_twt_shaper_stopped(shaper, release);
+}
+
+void hdd_twt_shaper_suspend(struct hdd_adapter *adapter)
+{
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+	qdf_nbuf_queue_t q;
+	bool enabled;
+
+	if (!shaper->initialized)
+		return;
+
+	qdf_nbuf_queue_init(&q);
+
+	qdf_spin_lock_bh(&shaper->lock);
+	if (shaper->suspended) {
+		qdf_spin_unlock_bh(&shaper->lock);
+		return;
+	}
+
+	enabled = shaper->enabled;
+	hdd_twt_shaper_stop(shaper);
+	shaper->resume_enable = enabled;
+	shaper->suspended = true;
+	/* the frames are sent from here rather than by the bottom half */
+	shaper->releasing = false;
+	shaper->stats.tx_suspend += hdd_twt_shaper_dequeue(shaper, &q);
+	qdf_spin_unlock_bh(&shaper->lock);
+
+	qdf_hrtimer_cancel(&shaper->timer);
+
+	local_bh_disable();
+	hdd_twt_shaper_send(adapter, &q);
+	local_bh_enable();
+}
+
+void hdd_twt_shaper_resume(struct hdd_adapter *adapter)
+{
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+
+	if (!shaper->initialized)
+		return;
+
+	qdf_spin_lock_bh(&shaper->lock);
+	shaper->suspended = false;
+	if (shaper->resume_enable && shaper->wake_intvl_us)
+		hdd_twt_shaper_start(shaper);
+	shaper->resume_enable = false;
+	qdf_spin_unlock_bh(&shaper->lock);
+}
+
+void hdd_twt_shaper_flush(struct hdd_adapter *adapter)
+{
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+	qdf_nbuf_queue_t q;
+
+	if (!shaper->initialized)
+		return;
+
+	qdf_nbuf_queue_init(&q);
+
+	qdf_spin_lock_bh(&shaper->lock);
+	shaper->enabled = false;
+	shaper->resume_enable = false;
+	shaper->open = false;
+	shaper->releasing = false;
+	shaper->wake_intvl_us = 0;
+	shaper->sp_tsf_us = 0;
+	shaper->sp_tx = 0;
+	shaper->stats.dropped += hdd_twt_shaper_dequeue(shaper, &q);
+	qdf_spin_unlock_bh(&shaper->lock);
+
+	qdf_hrtimer_cancel(&shaper->timer);
+	hdd_twt_shaper_drop(adapter, &q);
+}
+
+void hdd_twt_shaper_init(struct hdd_adapter *adapter)
+{
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+	int i;
+
+	if (shaper->initialized)
+		return;
+
+	if (adapter->device_mode != QDF_STA_MODE &&
+	    adapter->device_mode != QDF_P2P_CLIENT_MODE)
+		return;
+
+	qdf_mem_zero(shaper, sizeof(*shaper));
+	qdf_spinlock_create(&shaper->lock);
+	for (i = 0; i < HDD_TWT_SHAPER_NUM_TIDS; i++)
+		qdf_nbuf_queue_init(&shaper->tidq[i]);
+	shaper->max_delay_us =
+		adapter->hdd_ctx->config->twt_shaper_max_delay_ms *
+		USEC_PER_MSEC;
+
+	qdf_hrtimer_init(&shaper->timer, hdd_twt_shaper_timer_cb,
+			 QDF_CLOCK_MONOTONIC, QDF_HRTIMER_MODE_REL,
+			 QDF_CONTEXT_HARDWARE);
+	qdf_create_bh(&shaper->release_bh, hdd_twt_shaper_release_bh,
+		      adapter);
+	shaper->initialized = true;
+}
+
+void hdd_twt_shaper_deinit(struct hdd_adapter *adapter)
+{
+	struct hdd_twt_shaper *shaper = &adapter->twt_shaper;
+
+	if (!shaper->initialized)
+		return;
+
+	hdd_twt_shaper_flush(adapter);
+	qdf_destroy_bh(&shaper->release_bh);
+	qdf_spinlock_destroy(&shaper->lock);
+	shaper->initialized = false;
+}
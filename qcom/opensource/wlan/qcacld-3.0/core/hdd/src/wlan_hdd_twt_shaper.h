@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#if !defined(WLAN_HDD_TWT_SHAPER_H)
+#define WLAN_HDD_TWT_SHAPER_H
+/**
+ * DOC: wlan_hdd_twt_shaper.h
+ *
+ * TWT aware tx shaping
+ *
+ * Once a station has set up an individual TWT session with its AP, frames
+ * sent between two service periods sit in the firmware queues until the
+ * next one, and each of them may wake the target up on its way there. The
+ * shaper instead holds the BE and BK frames of the peer in per TID queues
+ * while no service period is running, and releases them as one burst
+ * shortly before the next service period starts.
+ *
+ * Frames are never held for longer than the gTwtShaperMaxDelay ini. VO
+ * and VI frames, broadcast and multicast frames and the special frames
+ * told apart by wlan_hdd_classify_pkt() are sent right away, so that
+ * interactive flows are not delayed.
+ *
+ * The schedule is anchored on the service period offset reported when the
+ * session is set up, or set up again after a renegotiation, and follows
+ * the wake interval from there on the host clock. As that clock drifts
+ * against the TSF the AP schedules service periods on, the schedule is
+ * lined up again with the service period TSF reported by firmware every
+ * HDD_TWT_SHAPER_RESYNC_US where host to TSF sync is available.
+ *
+ * The shaper stops on teardown and pause of the session and on
+ * disconnect. It also stops while the system is suspended, and sends the
+ * held frames before the data path stops taking them.
+ */
+
+#include "wlan_hdd_main.h"
+
+/* frames are released this long before a service period starts */
+#define HDD_TWT_SHAPER_LEAD_US 1000
+#define HDD_TWT_SHAPER_MAX_HELD 1024
+/* the schedule is checked against the TSF this often */
+#define HDD_TWT_SHAPER_RESYNC_US 1000000
+/* larger corrections come from a bad TSF sample */
+#define HDD_TWT_SHAPER_MAX_RESYNC_US 10000
+
+#ifdef WLAN_HDD_TWT_SHAPER
+/**
+ * enum hdd_twt_shaper_release - why the held frames are released
+ * @HDD_TWT_SHAPER_RELEASE_NONE: frames stay held
+ * @HDD_TWT_SHAPER_RELEASE_SP: a service period is about to start
+ * @HDD_TWT_SHAPER_RELEASE_DEADLINE: the oldest held frame reached the
+ *  latency bound
+ */
+enum hdd_twt_shaper_release {
+	HDD_TWT_SHAPER_RELEASE_NONE,
+	HDD_TWT_SHAPER_RELEASE_SP,
+	HDD_TWT_SHAPER_RELEASE_DEADLINE,
+};
+
+/**
+ * hdd_twt_shaper_batch_bin() - histogram bin of a service period
+ * @frames: frames sent in the service period
+ *
+ * Return: 0 for none, then 1 for 1-4, 2 for 5-16, 3 for 17-64 and 4 for
+ *	   more frames
+ */
+static inline uint8_t hdd_twt_shaper_batch_bin(uint32_t frames)
+{
+	if (!frames)
+		return 0;
+	if (frames <= 4)
+		return 1;
+	if (frames <= 16)
+		return 2;
+	if (frames <= 64)
+		return 3;
+
+	return HDD_TWT_SHAPER_BATCH_BINS - 1;
+}
+
+/**
+ * hdd_twt_shaper_skip_sps() - skip the service periods already over
+ * @shaper: TWT shaper
+ * @now_us: current time
+ *
+ * Return: None
+ */
+static inline void hdd_twt_shaper_skip_sps(struct hdd_twt_shaper *shaper,
+					   uint64_t now_us)
+{
+	uint64_t sp_end_us = shaper->next_sp_us + shaper->wake_dur_us;
+
+	if (now_us < sp_end_us)
+		return;
+
+	shaper->next_sp_us += (qdf_do_div(now_us - sp_end_us,
+					  shaper->wake_intvl_us) + 1) *
+			      shaper->wake_intvl_us;
+}
+
+/**
+ * hdd_twt_shaper_close_sp() - account for the service period that ended
+ * @shaper: TWT shaper
+ *
+ * Return: None
+ */
+static inline void hdd_twt_shaper_close_sp(struct hdd_twt_shaper *shaper)
+{
+	struct hdd_twt_shaper_stats *stats = &shaper->stats;
+
+	stats->batch_hist[hdd_twt_shaper_batch_bin(shaper->sp_tx)]++;
+	if (!shaper->sp_tx)
+		stats->sps_idle++;
+	if (shaper->sp_tx > stats->max_batch)
+		stats->max_batch = shaper->sp_tx;
+
+	shaper->sp_tx = 0;
+	shaper->open = false;
+	shaper->next_sp_us += shaper->wake_intvl_us;
+}
+
+/**
+ * hdd_twt_shaper_update() - move the shaper through the schedule
+ * @shaper: TWT shaper
+ * @now_us: current time
+ *
+ * Closes the service period that ended and opens the next one once its
+ * lead time is reached.
+ *
+ * Return: why the held frames are to be released, if they are
+ */
+static inline enum hdd_twt_shaper_release
+hdd_twt_shaper_update(struct hdd_twt_shaper *shaper, uint64_t now_us)
+{
+	if (shaper->open) {
+		if (now_us < shaper->next_sp_us + shaper->wake_dur_us)
+			return HDD_TWT_SHAPER_RELEASE_NONE;
+
+		hdd_twt_shaper_close_sp(shaper);
+	}
+
+	hdd_twt_shaper_skip_sps(shaper, now_us);
+
+	if (now_us + HDD_TWT_SHAPER_LEAD_US >= shaper->next_sp_us) {
+		shaper->open = true;
+		shaper->stats.sps++;
+		return shaper->held ? HDD_TWT_SHAPER_RELEASE_SP :
+				      HDD_TWT_SHAPER_RELEASE_NONE;
+	}
+
+	if (shaper->held &&
+	    now_us >= shaper->first_hold_us + shaper->max_delay_us)
+		return HDD_TWT_SHAPER_RELEASE_DEADLINE;
+
+	return HDD_TWT_SHAPER_RELEASE_NONE;
+}
+
+/**
+ * hdd_twt_shaper_expiry() - time the shaper is to be updated next
+ * @shaper: TWT shaper
+ *
+ * Return: end of the current service period, or the lead time of the
+ *	   next one or the deadline of the held frames, whichever is first
+ */
+static inline uint64_t hdd_twt_shaper_expiry(struct hdd_twt_shaper *shaper)
+{
+	uint64_t expiry_us;
+	uint64_t deadline_us;
+
+	if (shaper->open)
+		return shaper->next_sp_us + shaper->wake_dur_us;
+
+	expiry_us = shaper->next_sp_us - HDD_TWT_SHAPER_LEAD_US;
+	if (shaper->held) {
+		deadline_us = shaper->first_hold_us + shaper->max_delay_us;
+		if (deadline_us < expiry_us)
+			expiry_us = deadline_us;
+	}
+
+	return expiry_us;
+}
+
+/**
+ * hdd_twt_shaper_reanchor() - line the schedule up with the TSF
+ * @shaper: TWT shaper, with no service period open
+ * @now_us: current time
+ * @to_sp_us: time from @now_us to the next service period start by the
+ *  TSF, at most one wake interval
+ *
+ * The next service period start is moved to the closest one by the TSF.
+ *
+ * Return: true if the schedule was lined up, false if the correction was
+ *	   too large to come from clock drift and was ignored
+ */
+static inline bool hdd_twt_shaper_reanchor(struct hdd_twt_shaper *shaper,
+					   uint64_t now_us, uint32_t to_sp_us)
+{
+	int64_t half_us = shaper->wake_intvl_us / 2;
+	int64_t corr_us;
+
+	corr_us = (int64_t)(now_us + to_sp_us - shaper->next_sp_us);
+	if (corr_us > half_us)
+		corr_us -= shaper->wake_intvl_us;
+	else if (corr_us < -half_us)
+		corr_us += shaper->wake_intvl_us;
+
+	if (corr_us > HDD_TWT_SHAPER_MAX_RESYNC_US ||
+	    corr_us < -HDD_TWT_SHAPER_MAX_RESYNC_US) {
+		shaper->stats.resyncs_rejected++;
+		return false;
+	}
+
+	shaper->next_sp_us += corr_us;
+	shaper->stats.resyncs++;
+
+	return true;
+}
+
+/**
+ * hdd_twt_shaper_is_urgent() - check if a frame is never held
+ * @skb: frame being sent
+ * @ac: access category of the frame
+ *
+ * Return: true for VO and VI frames, broadcast and multicast frames and
+ *	   the special frames told apart by wlan_hdd_classify_pkt()
+ */
+static inline bool hdd_twt_shaper_is_urgent(struct sk_buff *skb,
+					    sme_ac_enum_type ac)
+{
+	if (ac == SME_AC_VO || ac == SME_AC_VI)
+		return true;
+
+	return QDF_NBUF_CB_GET_PACKET_TYPE(skb) ||
+		QDF_NBUF_CB_GET_IS_BCAST(skb) || QDF_NBUF_CB_GET_IS_MCAST(skb);
+}
+
+/**
+ * __hdd_twt_shaper_tx() - hold a frame until the next service period
+ * @adapter: adapter the frame is sent on
+ * @skb: frame being sent, already accounted for as sent
+ * @ac: access category of the frame
+ *
+ * Return: true if the frame is held and now owned by the shaper, false if
+ *	   it is to be sent right away
+ */
+bool __hdd_twt_shaper_tx(struct hdd_adapter *adapter, struct sk_buff *skb,
+			 sme_ac_enum_type ac);
+
+/**
+ * hdd_twt_shaper_tx() - hold a frame until the next service period
+ * @adapter: adapter the frame is sent on
+ * @skb: frame being sent, already accounted for as sent
+ * @ac: access category of the frame
+ *
+ * Return: true if the frame is held and now owned by the shaper, false if
+ *	   it is to be sent right away
+ */
+static inline bool hdd_twt_shaper_tx(struct hdd_adapter *adapter,
+				     struct sk_buff *skb, sme_ac_enum_type ac)
+{
+	if (qdf_likely(!adapter->twt_shaper.enabled))
+		return false;
+
+	return __hdd_twt_shaper_tx(adapter, skb, ac);
+}
+
+/**
+ * hdd_twt_shaper_init() - set up the TWT shaper of an adapter
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_twt_shaper_init(struct hdd_adapter *adapter);
+
+/**
+ * hdd_twt_shaper_deinit() - stop the TWT shaper of an adapter and drop the
+ * frames it holds
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_twt_shaper_deinit(struct hdd_adapter *adapter);
+
+/**
+ * hdd_twt_shaper_flush() - stop shaping and drop the held frames
+ * @adapter: adapter
+ *
+ * Used on disconnect, once there is no peer to send the frames to.
+ *
+ * Return: None
+ */
+void hdd_twt_shaper_flush(struct hdd_adapter *adapter);
+
+/**
+ * hdd_twt_shaper_suspend() - stop shaping for a system suspend
+ * @adapter: adapter
+ *
+ * The held frames are sent right away, so that they are not dropped once
+ * the data path is suspended.
+ *
+ * Return: None
+ */
+void hdd_twt_shaper_suspend(struct hdd_adapter *adapter);
+
+/**
+ * hdd_twt_shaper_resume() - start shaping again after a system suspend
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_twt_shaper_resume(struct hdd_adapter *adapter);
+
+/**
+ * __hdd_twt_shaper_setup() - start shaping for a TWT session of an adapter
+ * @adapter: adapter the session was set up on
+ * @dialog_id: TWT dialog of the session
+ * @wake_dur_us: service period duration
+ * @wake_intvl_us: time between the starts of two service periods
+ * @sp_offset_us: time until the first service period
+ * @sp_tsf_us: TSF of the start of the first service period, 0 if not
+ *  reported
+ *
+ * See hdd_twt_shaper_setup().
+ *
+ * Return: None
+ */
+void __hdd_twt_shaper_setup(struct hdd_adapter *adapter, uint32_t dialog_id,
+			    uint32_t wake_dur_us, uint32_t wake_intvl_us,
+			    uint32_t sp_offset_us, uint64_t sp_tsf_us);
+
+/**
+ * hdd_twt_shaper_setup() - start shaping for a TWT session
+ * @psoc: psoc
+ * @vdev_id: vdev the session was set up on
+ * @dialog_id: TWT dialog of the session
+ * @wake_dur_us: service period duration
+ * @wake_intvl_us: time between the starts of two service periods
+ * @sp_offset_us: time until the first service period
+ * @sp_tsf_us: TSF of the start of the first service period, 0 if not
+ *  reported
+ *
+ * Only one session is shaped for per adapter, further sessions of the
+ * same peer are ignored. Setting up the same session again moves the
+ * schedule to the new offset.
+ *
+ * Return: None
+ */
+void hdd_twt_shaper_setup(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			  uint32_t dialog_id, uint32_t wake_dur_us,
+			  uint32_t wake_intvl_us, uint32_t sp_offset_us,
+			  uint64_t sp_tsf_us);
+
+/**
+ * hdd_twt_shaper_teardown() - stop shaping for a TWT session
+ * @psoc: psoc
+ * @vdev_id: vdev of the session
+ * @dialog_id: TWT dialog of the session
+ *
+ * The held frames are sent right away.
+ *
+ * Return: None
+ */
+void hdd_twt_shaper_teardown(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			     uint32_t dialog_id);
+
+/**
+ * hdd_twt_shaper_pause() - pause or resume shaping for a TWT session
+ * @psoc: psoc
+ * @vdev_id: vdev of the session
+ * @dialog_id: TWT dialog of the session
+ * @pause: true when the session is paused, false when it is resumed
+ *
+ * The held frames are sent right away on pause. On resume the schedule
+ * carries on with the phase it had before the pause.
+ *
+ * Return: None
+ */
+void hdd_twt_shaper_pause(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			  uint32_t dialog_id, bool pause);
+#else
+static inline bool hdd_twt_shaper_tx(struct hdd_adapter *adapter,
+				     struct sk_buff *skb, sme_ac_enum_type ac)
+{
+	return false;
+}
+
+static inline void hdd_twt_shaper_init(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_twt_shaper_deinit(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_twt_shaper_flush(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_twt_shaper_suspend(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_twt_shaper_resume(struct hdd_adapter *adapter)
+{
+}
+
+static inline
+void hdd_twt_shaper_setup(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			  uint32_t dialog_id, uint32_t wake_dur_us,
+			  uint32_t wake_intvl_us, uint32_t sp_offset_us,
+			  uint64_t sp_tsf_us)
+{
+}
+
+static inline
+void hdd_twt_shaper_teardown(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			     uint32_t dialog_id)
+{
+}
+
+static inline
+void hdd_twt_shaper_pause(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			  uint32_t dialog_id, bool pause)
+{
+}
+#endif /* WLAN_HDD_TWT_SHAPER */
+#endif /* WLAN_HDD_TWT_SHAPER_H */
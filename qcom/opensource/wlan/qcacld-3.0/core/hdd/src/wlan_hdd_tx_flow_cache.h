@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#if !defined(WLAN_HDD_TX_FLOW_CACHE_H)
+#define WLAN_HDD_TX_FLOW_CACHE_H
+/**
+ * DOC: wlan_hdd_tx_flow_cache.h
+ *
+ * Tx flow cache
+ *
+ * The tx path parses the headers of every frame twice, once in
+ * hdd_select_queue() for the user priority and once in
+ * wlan_hdd_classify_pkt() for the special frames. Frames of a flow that is
+ * sent from a local socket carry the same L4 hash and socket, so the
+ * outcome of both is memoized per flow and reused for the following frames
+ * of the flow. Only flows whose frames are plain unicast data are cached,
+ * ARP, DHCP, EAPOL, WAPI, ICMP and ICMPv6 frames are always parsed.
+ *
+ * Entries are dropped when the DSCP to UP map or the UDP QoS upgrade
+ * threshold of the adapter changes, and expire after
+ * HDD_TX_FLOW_CACHE_TTL_MS so that a change in the TOS of a socket is
+ * picked up.
+ */
+
+#include "wlan_hdd_main.h"
+#include "qdf_time.h"
+
+#ifdef WLAN_HDD_TX_FLOW_CACHE
+/**
+ * hdd_tx_flow_cache_lookup() - find the cache entry of the flow of a frame
+ * @cache: tx flow cache
+ * @skb: frame being sent
+ * @cpu: CPU the frame is being sent from
+ *
+ * Return: entry of the flow, NULL if the flow is not cached
+ */
+static inline struct hdd_tx_flow_entry *
+hdd_tx_flow_cache_lookup(struct hdd_tx_flow_cache *cache,
+			 struct sk_buff *skb, int cpu)
+{
+	struct hdd_tx_flow_entry *entry;
+
+	if (!skb->l4_hash || !skb->sk)
+		return NULL;
+
+	entry = &cache->entry[cpu][skb->hash & (HDD_TX_FLOW_CACHE_SIZE - 1)];
+	if (entry->hash != skb->hash || entry->sk != skb->sk ||
+	    entry->gen != cache->gen || !entry->flags ||
+	    qdf_system_time_after(qdf_system_ticks(), entry->expire))
+		return NULL;
+
+	return entry;
+}
+
+/**
+ * hdd_tx_flow_cache_update() - memoize the classification of a flow
+ * @cache: tx flow cache
+ * @skb: frame the classification was done for
+ * @cpu: CPU the frame is being sent from
+ * @flags: HDD_TX_FLOW_* flags to set in the entry of the flow
+ * @up: user priority of the flow, used with HDD_TX_FLOW_UP
+ *
+ * The entry of another flow hashing to the same slot is replaced.
+ *
+ * Return: None
+ */
+static inline void hdd_tx_flow_cache_update(struct hdd_tx_flow_cache *cache,
+					    struct sk_buff *skb, int cpu,
+					    uint8_t flags, uint8_t up)
+{
+	struct hdd_tx_flow_entry *entry;
+
+	entry = hdd_tx_flow_cache_lookup(cache, skb, cpu);
+	if (!entry) {
+		if (!skb->l4_hash || !skb->sk)
+			return;
+
+		entry = &cache->entry[cpu][skb->hash &
+					   (HDD_TX_FLOW_CACHE_SIZE - 1)];
+		entry->hash = skb->hash;
+		entry->sk = skb->sk;
+		entry->gen = cache->gen;
+		entry->expire = qdf_system_ticks() +
+			qdf_system_msecs_to_ticks(HDD_TX_FLOW_CACHE_TTL_MS);
+		entry->flags = 0;
+	}
+
+	entry->flags |= flags;
+	if (flags & HDD_TX_FLOW_UP)
+		entry->up = up;
+}
+
+/**
+ * hdd_tx_flow_cache_flush() - drop all the entries of the tx flow cache of
+ * an adapter
+ * @adapter: adapter whose classification inputs changed
+ *
+ * Return: None
+ */
+static inline void hdd_tx_flow_cache_flush(struct hdd_adapter *adapter)
+{
+	adapter->tx_flow_cache.gen++;
+}
+#else
+static inline void hdd_tx_flow_cache_flush(struct hdd_adapter *adapter)
+{
+}
+#endif /* WLAN_HDD_TX_FLOW_CACHE */
+#endif /* WLAN_HDD_TX_FLOW_CACHE_H */
@@ -74,6 +74,9 @@
 #include <wlan_hdd_sar_limits.h>
 #include "wlan_hdd_object_manager.h"
 #include "wlan_hdd_mlo.h"
+#include "wlan_hdd_tx_flow_cache.h"
+#include "wlan_hdd_rx_ol.h"
+#include "wlan_hdd_twt_shaper.h"
 
 #ifdef TX_MULTIQ_PER_AC
 #if defined(QCA_LL_TX_FLOW_CONTROL_V2) || defined(QCA_LL_PDEV_TX_FLOW_CONTROL)
@@ -507,6 +510,7 @@ int hdd_set_udp_qos_upgrade_config(struct hdd_adapter *adapter,
 	}
 
 	adapter->upgrade_udp_qos_threshold = priority;
+	hdd_tx_flow_cache_flush(adapter);
 
 	hdd_debug("UDP packets qos upgrade to: %d", priority);
 
@@ -1041,6 +1045,30 @@ static void hdd_mark_icmp_req_to_fw(struct hdd_context *hdd_ctx,
 }
 #endif
 
+#ifdef WLAN_HDD_TX_FLOW_CACHE
+void hdd_tx_classify_pkt(struct hdd_adapter *adapter,
+			 struct sk_buff *skb, int cpu)
+{
+	struct hdd_tx_rx_stats *stats = &adapter->hdd_stats.tx_rx_stats;
+	struct hdd_tx_flow_entry *entry;
+
+	entry = hdd_tx_flow_cache_lookup(&adapter->tx_flow_cache, skb, cpu);
+	if (entry && (entry->flags & HDD_TX_FLOW_PLAIN)) {
+		++stats->per_cpu[cpu].tx_flow_hit;
+		qdf_mem_zero(skb->cb, sizeof(skb->cb));
+		return;
+	}
+
+	++stats->per_cpu[cpu].tx_flow_miss;
+	wlan_hdd_classify_pkt(skb);
+
+	if (!QDF_NBUF_CB_GET_PACKET_TYPE(skb) &&
+	    !QDF_NBUF_CB_GET_IS_BCAST(skb) && !QDF_NBUF_CB_GET_IS_MCAST(skb))
+		hdd_tx_flow_cache_update(&adapter->tx_flow_cache, skb, cpu,
+					 HDD_TX_FLOW_PLAIN, 0);
+}
+#endif /* WLAN_HDD_TX_FLOW_CACHE */
+
 #ifdef CONFIG_DP_PKT_ADD_TIMESTAMP
 void hdd_pkt_add_timestamp(struct hdd_adapter *adapter,
 			   enum qdf_pkt_timestamp_index index, uint64_t time,
@@ -1111,7 +1139,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 		goto drop_pkt;
 	}
 
-	wlan_hdd_classify_pkt(skb);
+	hdd_tx_classify_pkt(adapter, skb, cpu);
 
 	QDF_NBUF_CB_TX_EXTRA_FRAG_FLAGS_NOTIFY_COMP(skb) = 1;
 
@@ -1153,6 +1181,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 
 	hdd_pkt_add_timestamp(adapter, QDF_PKT_TX_DRIVER_ENTRY,
 			      qdf_get_log_timestamp(), skb);
+	hdd_lat_trace_stamp(skb, CDP_LAT_TX_HDD_XMIT);
 
 	/* track connectivity stats */
 	if (adapter->pkt_type_bitmap)
@@ -1314,6 +1343,11 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 
 	wlan_hdd_fix_broadcast_eapol(adapter, skb);
 
+	if (hdd_twt_shaper_tx(adapter, skb, ac)) {
+		netif_trans_update(dev);
+		return;
+	}
+
 	if (adapter->tx_fn(soc, adapter->vdev_id, (qdf_nbuf_t)skb)) {
 		hdd_dp_debug_rl("Failed to send packet from adapter %u",
 				adapter->vdev_id);
@@ -1504,6 +1538,8 @@ QDF_STATUS hdd_init_tx_rx(struct hdd_adapter *adapter)
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	hdd_twt_shaper_init(adapter);
+
 	return status;
 }
 
@@ -1521,6 +1557,7 @@ QDF_STATUS hdd_deinit_tx_rx(struct hdd_adapter *adapter)
 		return QDF_STATUS_E_FAILURE;
 
 	adapter->tx_fn = NULL;
+	hdd_twt_shaper_deinit(adapter);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -1664,91 +1701,67 @@ static void hdd_resolve_rx_ol_mode(struct hdd_context *hdd_ctx)
 
 #ifdef WLAN_FEATURE_DYNAMIC_RX_AGGREGATION
 /**
- * hdd_gro_rx_bh_disable() - GRO RX/flush function.
- * @napi_to_use: napi to be used to give packets to the stack, gro flush
- * @skb: pointer to sk_buff
+ * hdd_gro_flush_needed() - check if GRO is flushed after each frame
+ * @adapter: adapter the frame is received on
+ * @rx_ctx_id: rx context the frame is received on
  *
- * Function calls napi_gro_receive for the skb. If the skb indicates that a
- * flush needs to be done (set by the lower DP layer), the function also calls
- * napi_gro_flush. Local softirqs are disabled (and later enabled) while making
- * napi_gro__ calls.
+ * GRO is flushed after each frame while the bus bandwidth is idle, to keep
+ * the rx latency low, and while rx aggregation is disabled for the system
+ * or the adapter. In the latter case the rx context is also marked so
+ * that the following frames bypass GRO until aggregation is allowed again.
  *
- * Return: QDF_STATUS_SUCCESS if not dropped by napi_gro_receive or
- *	   QDF error code.
+ * Return: true if GRO is flushed after the frame
  */
-static QDF_STATUS hdd_gro_rx_bh_disable(struct hdd_adapter *adapter,
-					struct napi_struct *napi_to_use,
-					struct sk_buff *skb)
+static bool hdd_gro_flush_needed(struct hdd_adapter *adapter,
+				 uint8_t rx_ctx_id)
 {
-	QDF_STATUS status = QDF_STATUS_SUCCESS;
 	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
-	gro_result_t gro_ret;
 	uint32_t rx_aggregation;
-	uint8_t rx_ctx_id = QDF_NBUF_CB_RX_CTX_ID(skb);
 	int32_t gro_disallowed;
 
 	rx_aggregation = qdf_atomic_read(&hdd_ctx->dp_agg_param.rx_aggregation);
 	gro_disallowed = qdf_atomic_read(&adapter->gro_disallowed);
 
-	skb_set_hash(skb, QDF_NBUF_CB_RX_FLOW_ID(skb), PKT_HASH_TYPE_L4);
-
-	local_bh_disable();
-	gro_ret = napi_gro_receive(napi_to_use, skb);
-
-	if (hdd_get_current_throughput_level(hdd_ctx) == PLD_BUS_WIDTH_IDLE ||
-	    !rx_aggregation || gro_disallowed) {
-		if (HDD_IS_EXTRA_GRO_FLUSH_NECESSARY(gro_ret)) {
-			adapter->hdd_stats.tx_rx_stats.
-					rx_gro_low_tput_flush++;
-			dp_rx_napi_gro_flush(napi_to_use,
-					     DP_RX_GRO_NORMAL_FLUSH);
-		}
-		if (!rx_aggregation)
-			hdd_ctx->dp_agg_param.gro_force_flush[rx_ctx_id] = 1;
-		if (gro_disallowed)
-			adapter->gro_flushed[rx_ctx_id] = 1;
-	}
-	local_bh_enable();
+	if (hdd_get_current_throughput_level(hdd_ctx) != PLD_BUS_WIDTH_IDLE &&
+	    rx_aggregation && !gro_disallowed)
+		return false;
 
-	GRO_DROP_UPDATE_STATUS(gro_ret, status);
+	if (!rx_aggregation)
+		hdd_ctx->dp_agg_param.gro_force_flush[rx_ctx_id] = 1;
+	if (gro_disallowed)
+		adapter->gro_flushed[rx_ctx_id] = 1;
 
-	return status;
+	return true;
 }
+#else
+static bool hdd_gro_flush_needed(struct hdd_adapter *adapter,
+				 uint8_t rx_ctx_id)
+{
+	return hdd_get_current_throughput_level(adapter->hdd_ctx) ==
+		PLD_BUS_WIDTH_IDLE;
+}
+#endif /* WLAN_FEATURE_DYNAMIC_RX_AGGREGATION */
 
-#else /* WLAN_FEATURE_DYNAMIC_RX_AGGREGATION */
-
-/**
- * hdd_gro_rx_bh_disable() - GRO RX/flush function.
- * @napi_to_use: napi to be used to give packets to the stack, gro flush
- * @skb: pointer to sk_buff
- *
- * Function calls napi_gro_receive for the skb. If the skb indicates that a
- * flush needs to be done (set by the lower DP layer), the function also calls
- * napi_gro_flush. Local softirqs are disabled (and later enabled) while making
- * napi_gro__ calls.
- *
- * Return: QDF_STATUS_SUCCESS if not dropped by napi_gro_receive or
- *	   QDF error code.
- */
-static QDF_STATUS hdd_gro_rx_bh_disable(struct hdd_adapter *adapter,
-					struct napi_struct *napi_to_use,
-					struct sk_buff *skb)
+QDF_STATUS hdd_gro_rx_bh_disable(struct hdd_adapter *adapter,
+				 struct napi_struct *napi_to_use,
+				 struct sk_buff *skb)
 {
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
-	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
 	gro_result_t gro_ret;
+	uint8_t rx_ctx_id = QDF_NBUF_CB_RX_CTX_ID(skb);
 
-	skb_set_hash(skb, QDF_NBUF_CB_RX_FLOW_ID(skb), PKT_HASH_TYPE_L4);
+	/* the rx offload engine may have set the flow hash already */
+	if (!skb->l4_hash)
+		skb_set_hash(skb, QDF_NBUF_CB_RX_FLOW_ID(skb),
+			     PKT_HASH_TYPE_L4);
 
 	local_bh_disable();
 	gro_ret = napi_gro_receive(napi_to_use, skb);
 
-	if (hdd_get_current_throughput_level(hdd_ctx) == PLD_BUS_WIDTH_IDLE) {
-		if (HDD_IS_EXTRA_GRO_FLUSH_NECESSARY(gro_ret)) {
-			adapter->hdd_stats.tx_rx_stats.rx_gro_low_tput_flush++;
-			dp_rx_napi_gro_flush(napi_to_use,
-					     DP_RX_GRO_NORMAL_FLUSH);
-		}
+	if (hdd_gro_flush_needed(adapter, rx_ctx_id) &&
+	    HDD_IS_EXTRA_GRO_FLUSH_NECESSARY(gro_ret)) {
+		adapter->hdd_stats.tx_rx_stats.rx_gro_low_tput_flush++;
+		dp_rx_napi_gro_flush(napi_to_use, DP_RX_GRO_NORMAL_FLUSH);
 	}
 	local_bh_enable();
 
@@ -1756,7 +1769,6 @@ static QDF_STATUS hdd_gro_rx_bh_disable(struct hdd_adapter *adapter,
 
 	return status;
 }
-#endif /* WLAN_FEATURE_DYNAMIC_RX_AGGREGATION */
 
 /**
  * hdd_gro_rx_dp_thread() - Handle Rx procesing via GRO for DP thread
@@ -1940,6 +1952,53 @@ static void hdd_register_rx_ol_cb(struct hdd_context *hdd_ctx,
 	}
 }
 
+#ifdef WLAN_HDD_RX_OL_ENGINE
+/**
+ * hdd_rx_ol_engine_cb() - receive_offload_cb of the rx offload engine
+ * @adapter: adapter the frame is received on
+ * @skb: frame being delivered to the stack
+ *
+ * Return: QDF_STATUS_SUCCESS if the frame was consumed by its offload path
+ */
+static QDF_STATUS hdd_rx_ol_engine_cb(struct hdd_adapter *adapter,
+				      struct sk_buff *skb)
+{
+	return hdd_rx_ol_engine_rx(&adapter->hdd_ctx->rx_ol_engine, adapter,
+				   skb,
+				   adapter->hdd_stats.tx_rx_stats.rx_ol_path);
+}
+
+void hdd_rx_ol_engine_init(struct hdd_context *hdd_ctx)
+{
+	struct hdd_rx_ol_engine *engine = &hdd_ctx->rx_ol_engine;
+	QDF_STATUS (*mode_cb)(struct hdd_adapter *adapter,
+			      struct sk_buff *skb);
+
+	mode_cb = hdd_ctx->receive_offload_cb;
+	/* no offload mode, or no new one since the last init */
+	if (!mode_cb || mode_cb == hdd_rx_ol_engine_cb)
+		return;
+
+	qdf_mem_zero(engine, sizeof(*engine));
+
+	if (hdd_ctx->config->fisa_enable)
+		engine->paths |= BIT(HDD_RX_OL_PATH_FISA);
+
+	if (hdd_ctx->ol_enable == CFG_LRO_ENABLED) {
+		engine->paths |= BIT(HDD_RX_OL_PATH_LRO);
+		engine->rx[HDD_RX_OL_PATH_LRO] = mode_cb;
+	} else {
+		engine->paths |= BIT(HDD_RX_OL_PATH_HW_GRO) |
+				 BIT(HDD_RX_OL_PATH_SW_GRO);
+		engine->rx[HDD_RX_OL_PATH_HW_GRO] = mode_cb;
+		engine->rx[HDD_RX_OL_PATH_SW_GRO] = mode_cb;
+	}
+
+	hdd_ctx->receive_offload_cb = hdd_rx_ol_engine_cb;
+	hdd_debug("Rx offload engine paths 0x%x", engine->paths);
+}
+#endif /* WLAN_HDD_RX_OL_ENGINE */
+
 /**
  * hdd_rx_ol_send_config() - Send RX offload configuration to FW
  * @hdd_ctx: pointer to hdd_ctx
@@ -1990,6 +2049,7 @@ int hdd_rx_ol_init(struct hdd_context *hdd_ctx)
 
 	hdd_resolve_rx_ol_mode(hdd_ctx);
 	hdd_register_rx_ol_cb(hdd_ctx, hdd_ctx->is_wifi3_0_target);
+	hdd_rx_ol_engine_init(hdd_ctx);
 
 	if (!hdd_ctx->is_wifi3_0_target) {
 		ret = hdd_rx_ol_send_config(hdd_ctx);
@@ -2188,8 +2248,7 @@ QDF_STATUS hdd_rx_deliver_to_stack(struct hdd_adapter *adapter,
 	uint8_t rx_ctx_id = QDF_NBUF_CB_RX_CTX_ID(skb);
 	ol_txrx_soc_handle soc = cds_get_context(QDF_MODULE_ID_SOC);
 
-	if (QDF_NBUF_CB_RX_TCP_PROTO(skb) &&
-	    !QDF_NBUF_CB_RX_PEER_CACHED_FRM(skb))
+	if (hdd_rx_ol_eligible(skb))
 		skb_receive_offload_ok = true;
 
 	if (qdf_atomic_read(&adapter->gro_disallowed) == 0 &&
@@ -2272,8 +2331,7 @@ QDF_STATUS hdd_rx_deliver_to_stack(struct hdd_adapter *adapter,
 	int netif_status;
 	bool skb_receive_offload_ok = false;
 
-	if (QDF_NBUF_CB_RX_TCP_PROTO(skb) &&
-	    !QDF_NBUF_CB_RX_PEER_CACHED_FRM(skb))
+	if (hdd_rx_ol_eligible(skb))
 		skb_receive_offload_ok = true;
 
 	if (skb_receive_offload_ok && hdd_ctx->receive_offload_cb) {
@@ -2435,6 +2493,7 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 		skb = next;
 		next = skb->next;
 		skb->next = NULL;
+		hdd_lat_trace_stamp(skb, CDP_LAT_RX_HDD);
 		is_eapol = false;
 		is_dhcp = false;
 		send_over_nl = false;
@@ -2560,6 +2619,7 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 				qdf_status = QDF_STATUS_E_INVAL;
 			dev_kfree_skb(skb);
 		} else {
+			hdd_lat_trace_stamp(skb, CDP_LAT_RX_STACK);
 			qdf_status = hdd_rx_deliver_to_stack(adapter, skb);
 		}
 
@@ -3491,6 +3551,32 @@ static inline void hdd_ini_mscs_params(struct hdd_config *config,
 #endif
 
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
+#ifdef WLAN_FEATURE_BUS_BW_PREDICT
+/**
+ * hdd_ini_bus_bw_predict() - Initialize INIs of the predictive bus bandwidth
+ *  estimator
+ * @config: pointer to hdd config
+ * @psoc: pointer to psoc obj
+ *
+ * Return: none
+ */
+static void hdd_ini_bus_bw_predict(struct hdd_config *config,
+				   struct wlan_objmgr_psoc *psoc)
+{
+	config->bus_bw_predict_enable =
+		cfg_get(psoc, CFG_DP_BUS_BANDWIDTH_PREDICT_ENABLE);
+	config->bus_bw_predict_hyst_pct =
+		cfg_get(psoc, CFG_DP_BUS_BANDWIDTH_PREDICT_HYSTERESIS);
+	config->bus_bw_predict_hold_ms =
+		cfg_get(psoc, CFG_DP_BUS_BANDWIDTH_PREDICT_HOLD_TIME);
+}
+#else
+static inline void hdd_ini_bus_bw_predict(struct hdd_config *config,
+					  struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif
+
 /**
  * hdd_ini_tx_flow_control() - Initialize INIs concerned about bus bandwidth
  * @config: pointer to hdd config
@@ -3521,6 +3607,7 @@ static void hdd_ini_bus_bandwidth(struct hdd_config *config,
 		cfg_get(psoc, CFG_DP_BUS_LOW_BW_CNT_THRESHOLD);
 	config->enable_latency_crit_clients =
 		cfg_get(psoc, CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS);
+	hdd_ini_bus_bw_predict(config, psoc);
 }
 
 /**
@@ -3645,6 +3732,22 @@ hdd_dp_nud_tracking_cfg_update(struct hdd_config *config,
 }
 #endif
 
+#ifdef WLAN_HDD_TWT_SHAPER
+static void
+hdd_dp_twt_shaper_cfg_update(struct hdd_config *config,
+			     struct wlan_objmgr_psoc *psoc)
+{
+	config->twt_shaper_max_delay_ms =
+		cfg_get(psoc, CFG_DP_TWT_SHAPER_MAX_DELAY);
+}
+#else
+static void
+hdd_dp_twt_shaper_cfg_update(struct hdd_config *config,
+			     struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif
+
 #ifdef QCA_SUPPORT_TXRX_DRIVER_TCP_DEL_ACK
 static void hdd_ini_tcp_del_ack_settings(struct hdd_config *config,
 					 struct wlan_objmgr_psoc *psoc)
@@ -3735,6 +3838,7 @@ void hdd_dp_cfg_update(struct wlan_objmgr_psoc *psoc,
 		cfg_get(psoc, CFG_DP_ICMP_REQ_TO_FW_MARK_INTERVAL);
 	hdd_dp_dp_trace_cfg_update(config, psoc);
 	hdd_dp_nud_tracking_cfg_update(config, psoc);
+	hdd_dp_twt_shaper_cfg_update(config, psoc);
 }
 
 bool wlan_hdd_rx_rpm_mark_last_busy(struct hdd_context *hdd_ctx,
@@ -23,18 +23,91 @@
  * debugfs unit_test_host
  */
 #include "wlan_hdd_main.h"
+#include "cds_api.h"
+#include "dp_reo_desc_test.h"
+#include "dp_rx_desc_test.h"
+#include "dp_sim_test.h"
+#include "dp_swlm_test.h"
+#include "epping_bench_test.h"
+#include "hif_ce_recv_batch_test.h"
+#include "ol_tx_sched_test.h"
 #include "qdf_delayed_work_test.h"
+#include "qdf_dp_trace_test.h"
 #include "qdf_hashtable_test.h"
+#include "qdf_nbuf_tso_test.h"
 #include "qdf_periodic_work_test.h"
 #include "qdf_ptr_hash_test.h"
 #include "qdf_slist_test.h"
 #include "qdf_talloc_test.h"
 #include "qdf_str.h"
+#include "qdf_streamfs_test.h"
 #include "qdf_trace.h"
 #include "qdf_tracker_test.h"
 #include "qdf_types_test.h"
+#include "reg_chan_list_test.h"
+#include "wbuff_test.h"
 #include "wlan_dsc_test.h"
+#include "wlan_hdd_pcl_cache_test.h"
+#include "wlan_hdd_rx_ol_test.h"
+#include "wlan_hdd_twt_shaper_test.h"
+#include "wlan_hdd_tx_flow_cache_test.h"
 #include "wlan_hdd_unit_test.h"
+#include "wmi_log_test.h"
+
+/**
+ * hdd_dp_sim_unit_test() - run the DP simulator unit test suite
+ *
+ * The simulator drives the data path handlers, which map buffers and take
+ * runtime PM references, so it runs against the qdf device, the HIF handle
+ * and the psoc of the loaded driver.
+ *
+ * Return: number of failed test cases
+ */
+static uint32_t hdd_dp_sim_unit_test(void)
+{
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+
+	if (!hdd_ctx || !hdd_ctx->psoc)
+		return 1;
+
+	return dp_sim_unit_test(cds_get_context(QDF_MODULE_ID_QDF_DEVICE),
+				cds_get_context(QDF_MODULE_ID_HIF),
+				(struct cdp_ctrl_objmgr_psoc *)hdd_ctx->psoc);
+}
+
+/**
+ * hdd_qdf_nbuf_tso_unit_test() - run the qdf nbuf TSO unit test suite
+ *
+ * The TSO suite DMA maps fragments, so it runs against the qdf device of
+ * the loaded driver.
+ *
+ * Return: number of failed test cases
+ */
+static uint32_t hdd_qdf_nbuf_tso_unit_test(void)
+{
+	qdf_device_t osdev = cds_get_context(QDF_MODULE_ID_QDF_DEVICE);
+
+	return qdf_nbuf_tso_unit_test(osdev);
+}
+
+/**
+ * hdd_reg_chan_list_unit_test() - run the regulatory channel list unit test
+ * suite
+ *
+ * The suite recomputes the current channel list of the pdev of the loaded
+ * driver.
+ *
+ * Return: number of failed test cases
+ */
+static uint32_t hdd_reg_chan_list_unit_test(void)
+{
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+
+	if (!hdd_ctx || !hdd_ctx->pdev)
+		return 1;
+
+	return reg_chan_list_unit_test(hdd_ctx->pdev);
+}
 
 typedef uint32_t (*hdd_ut_callback)(void);
 
@@ -44,16 +117,37 @@ struct hdd_ut_entry {
 };
 
 struct hdd_ut_entry hdd_ut_entries[] = {
+	{ .name = "dp_reo_desc", .callback = dp_reo_desc_unit_test },
+	{ .name = "dp_rx_desc", .callback = dp_rx_desc_unit_test },
+	{ .name = "dp_sim", .callback = hdd_dp_sim_unit_test },
+	{ .name = "dp_swlm", .callback = dp_swlm_unit_test },
 	{ .name = "dsc", .callback = dsc_unit_test },
+	{ .name = "epping_bench", .callback = epping_bench_unit_test },
+	{ .name = "hdd_rx_ol_engine",
+	  .callback = hdd_rx_ol_engine_unit_test },
+	{ .name = "hdd_twt_shaper",
+	  .callback = hdd_twt_shaper_unit_test },
+	{ .name = "hdd_tx_flow_cache",
+	  .callback = hdd_tx_flow_cache_unit_test },
+	{ .name = "hif_ce_recv_batch",
+	  .callback = hif_ce_recv_batch_unit_test },
+	{ .name = "ol_tx_sched_drr", .callback = ol_tx_sched_drr_unit_test },
+	{ .name = "pcl_cache", .callback = hdd_pcl_cache_unit_test },
 	{ .name = "qdf_delayed_work", .callback = qdf_delayed_work_unit_test },
+	{ .name = "qdf_dp_trace", .callback = qdf_dp_trace_unit_test },
 	{ .name = "qdf_ht", .callback = qdf_ht_unit_test },
+	{ .name = "qdf_nbuf_tso", .callback = hdd_qdf_nbuf_tso_unit_test },
 	{ .name = "qdf_periodic_work",
 	  .callback = qdf_periodic_work_unit_test },
 	{ .name = "qdf_ptr_hash", .callback = qdf_ptr_hash_unit_test },
 	{ .name = "qdf_slist", .callback = qdf_slist_unit_test },
+	{ .name = "qdf_streamfs", .callback = qdf_streamfs_unit_test },
 	{ .name = "qdf_talloc", .callback = qdf_talloc_unit_test },
 	{ .name = "qdf_tracker", .callback = qdf_tracker_unit_test },
 	{ .name = "qdf_types", .callback = qdf_types_unit_test },
+	{ .name = "reg_chan_list", .callback = hdd_reg_chan_list_unit_test },
+	{ .name = "wbuff", .callback = wbuff_unit_test },
+	{ .name = "wmi_log", .callback = wmi_log_unit_test },
 };
 
 #define hdd_for_each_ut_entry(cursor) \
@@ -60,6 +60,7 @@
 #include "cfg_ucfg_api.h"
 #include "wlan_hdd_object_manager.h"
 #include "wlan_hdd_cm_api.h"
+#include "wlan_hdd_tx_flow_cache.h"
 
 #define HDD_WMM_UP_TO_AC_MAP_SIZE 8
 #define DSCP(x)	x
@@ -1647,6 +1648,7 @@ QDF_STATUS hdd_wmm_dscp_initial_state(struct hdd_adapter *adapter)
 	}
 
 	hdd_fill_dscp_to_up_map(dscp_to_up_map);
+	hdd_tx_flow_cache_flush(adapter);
 
 	if (hdd_custom_dscp_up_map(dscp_to_up_map) == QDF_STATUS_SUCCESS) {
 		/* Send DSCP to TID map table to FW */
@@ -2037,6 +2039,67 @@ uint16_t hdd_get_queue_index(uint16_t up, bool is_eapol)
 }
 #endif
 
+#ifdef WLAN_HDD_TX_FLOW_CACHE
+/**
+ * hdd_wmm_flow_cache_get_up() - get the user priority of a frame from the
+ *  tx flow cache
+ * @adapter: adapter upon which the packet is being transmitted
+ * @skb: pointer to network buffer
+ * @user_pri: user priority of the flow of the frame
+ *
+ * Return: true if the flow of the frame is cached
+ */
+static bool hdd_wmm_flow_cache_get_up(struct hdd_adapter *adapter,
+				      struct sk_buff *skb,
+				      enum sme_qos_wmmuptype *user_pri)
+{
+	struct hdd_tx_rx_stats *stats = &adapter->hdd_stats.tx_rx_stats;
+	int cpu = qdf_get_smp_processor_id();
+	struct hdd_tx_flow_entry *entry;
+
+	entry = hdd_tx_flow_cache_lookup(&adapter->tx_flow_cache, skb, cpu);
+	if (!entry || !(entry->flags & HDD_TX_FLOW_UP)) {
+		++stats->per_cpu[cpu].qselect_flow_miss;
+		return false;
+	}
+
+	++stats->per_cpu[cpu].qselect_flow_hit;
+	*user_pri = entry->up;
+
+	return true;
+}
+
+/**
+ * hdd_wmm_flow_cache_set_up() - memoize the user priority of a flow
+ * @adapter: adapter upon which the packet is being transmitted
+ * @skb: pointer to network buffer
+ * @user_pri: user priority picked for the frame
+ *
+ * Return: None
+ */
+static void hdd_wmm_flow_cache_set_up(struct hdd_adapter *adapter,
+				      struct sk_buff *skb,
+				      enum sme_qos_wmmuptype user_pri)
+{
+	hdd_tx_flow_cache_update(&adapter->tx_flow_cache, skb,
+				 qdf_get_smp_processor_id(), HDD_TX_FLOW_UP,
+				 user_pri);
+}
+#else
+static inline bool
+hdd_wmm_flow_cache_get_up(struct hdd_adapter *adapter, struct sk_buff *skb,
+			  enum sme_qos_wmmuptype *user_pri)
+{
+	return false;
+}
+
+static inline void
+hdd_wmm_flow_cache_set_up(struct hdd_adapter *adapter, struct sk_buff *skb,
+			  enum sme_qos_wmmuptype user_pri)
+{
+}
+#endif /* WLAN_HDD_TX_FLOW_CACHE */
+
 static uint16_t __hdd_wmm_select_queue(struct net_device *dev,
 				       struct sk_buff *skb)
 {
@@ -2053,6 +2116,14 @@ static uint16_t __hdd_wmm_select_queue(struct net_device *dev,
 		return TX_GET_QUEUE_IDX(HDD_LINUX_AC_BE, 0);
 	}
 
+	/* Established flows are not critical, reuse their user priority */
+	if (hdd_wmm_flow_cache_get_up(adapter, skb, &up)) {
+		skb->priority = up;
+		index = __hdd_get_queue_index(up);
+
+		return hdd_get_tx_queue_for_ac(adapter, skb, index);
+	}
+
 	/* Get the user priority from IP header */
 	hdd_wmm_classify_pkt(adapter, skb, &up, &is_crtical);
 
@@ -2070,6 +2141,9 @@ static uint16_t __hdd_wmm_select_queue(struct net_device *dev,
 		}
 	}
 
+	if (!is_crtical)
+		hdd_wmm_flow_cache_set_up(adapter, skb, up);
+
 	skb->priority = up;
 	index = hdd_get_queue_index(skb->priority, is_crtical);
 
@@ -2418,6 +2492,7 @@ QDF_STATUS hdd_wmm_assoc(struct hdd_adapter *adapter,
 	status = sme_update_dsc_pto_up_mapping(hdd_ctx->mac_handle,
 					       adapter->dscp_to_up_map,
 					       adapter->vdev_id);
+	hdd_tx_flow_cache_flush(adapter);
 
 	if (!QDF_IS_STATUS_SUCCESS(status))
 		hdd_wmm_dscp_initial_state(adapter);
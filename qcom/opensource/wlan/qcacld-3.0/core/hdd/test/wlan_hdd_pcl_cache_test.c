@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "cds_api.h"
+#include "wlan_hdd_main.h"
+#include "wlan_hdd_regulatory.h"
+#include "wlan_policy_mgr_api.h"
+#include "wlan_hdd_pcl_cache_test.h"
+
+/**
+ * struct hdd_pcl_cache_ut_pcl - a PCL as returned by policy_mgr_get_pcl()
+ * @freq: PCL channel frequencies
+ * @weight: PCL weights
+ * @len: length of the PCL
+ */
+struct hdd_pcl_cache_ut_pcl {
+	uint32_t freq[NUM_CHANNELS];
+	uint8_t weight[NUM_CHANNELS];
+	uint32_t len;
+};
+
+static QDF_STATUS hdd_pcl_cache_ut_get(struct wlan_objmgr_psoc *psoc,
+				       struct hdd_pcl_cache_ut_pcl *pcl)
+{
+	return policy_mgr_get_pcl(psoc, PM_SAP_MODE, pcl->freq, &pcl->len,
+				  pcl->weight, QDF_ARRAY_SIZE(pcl->weight));
+}
+
+static bool hdd_pcl_cache_ut_equal(struct hdd_pcl_cache_ut_pcl *a,
+				   struct hdd_pcl_cache_ut_pcl *b)
+{
+	return a->len == b->len &&
+	       !qdf_mem_cmp(a->freq, b->freq, a->len * sizeof(*a->freq)) &&
+	       !qdf_mem_cmp(a->weight, b->weight, a->len);
+}
+
+/**
+ * hdd_pcl_cache_ut_check() - request a PCL and check how it was served
+ * @psoc: psoc of the loaded driver
+ * @ref: PCL the request must match
+ * @hit: true if the PCL must come from the cache, false if computed
+ * @name: name of the step, for logging
+ *
+ * Return: number of failed checks
+ */
+static uint32_t hdd_pcl_cache_ut_check(struct wlan_objmgr_psoc *psoc,
+				       struct hdd_pcl_cache_ut_pcl *ref,
+				       bool hit, const char *name)
+{
+	struct policy_mgr_pcl_cache_stats before, after;
+	struct hdd_pcl_cache_ut_pcl *pcl;
+	uint32_t errors = 0;
+
+	pcl = qdf_mem_malloc(sizeof(*pcl));
+	if (!pcl)
+		return 1;
+
+	policy_mgr_get_pcl_cache_stats(psoc, &before);
+	if (QDF_IS_STATUS_ERROR(hdd_pcl_cache_ut_get(psoc, pcl))) {
+		qdf_nofl_alert("FAIL: %s: no PCL", name);
+		errors++;
+		goto free;
+	}
+	policy_mgr_get_pcl_cache_stats(psoc, &after);
+
+	if (after.hits != before.hits + hit ||
+	    after.misses != before.misses + !hit) {
+		qdf_nofl_alert("FAIL: %s: expected a %s, hits %llu->%llu misses %llu->%llu",
+			       name, hit ? "hit" : "miss",
+			       before.hits, after.hits,
+			       before.misses, after.misses);
+		errors++;
+	}
+
+	if (!hdd_pcl_cache_ut_equal(pcl, ref)) {
+		qdf_nofl_alert("FAIL: %s: PCL differs, len %u vs %u",
+			       name, pcl->len, ref->len);
+		errors++;
+	}
+
+free:
+	qdf_mem_free(pcl);
+
+	return errors;
+}
+
+/**
+ * hdd_pcl_cache_ut_invalidate() - check an update drops the cached PCL
+ * @hdd_ctx: HDD context of the loaded driver
+ * @ref: PCL the requests must match
+ * @update: update expected to invalidate the cache
+ * @name: name of the update, for logging
+ *
+ * Return: number of failed checks
+ */
+static uint32_t
+hdd_pcl_cache_ut_invalidate(struct hdd_context *hdd_ctx,
+			    struct hdd_pcl_cache_ut_pcl *ref,
+			    void (*update)(struct hdd_context *hdd_ctx),
+			    const char *name)
+{
+	struct policy_mgr_pcl_cache_stats before, after;
+	uint32_t errors = 0;
+
+	/* make sure the PCL is cached before the update */
+	hdd_pcl_cache_ut_get(hdd_ctx->psoc, ref);
+
+	policy_mgr_get_pcl_cache_stats(hdd_ctx->psoc, &before);
+	update(hdd_ctx);
+	policy_mgr_get_pcl_cache_stats(hdd_ctx->psoc, &after);
+
+	if (after.invalidations == before.invalidations) {
+		qdf_nofl_alert("FAIL: %s did not invalidate the cache", name);
+		errors++;
+	}
+
+	errors += hdd_pcl_cache_ut_check(hdd_ctx->psoc, ref, false, name);
+	errors += hdd_pcl_cache_ut_check(hdd_ctx->psoc, ref, true, name);
+
+	return errors;
+}
+
+static void hdd_pcl_cache_ut_flush(struct hdd_context *hdd_ctx)
+{
+	policy_mgr_invalidate_pcl_cache(hdd_ctx->psoc);
+}
+
+static void hdd_pcl_cache_ut_reg_config(struct hdd_context *hdd_ctx)
+{
+	hdd_update_regulatory_config(hdd_ctx);
+}
+
+uint32_t hdd_pcl_cache_unit_test(void)
+{
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	struct hdd_pcl_cache_ut_pcl *ref;
+	uint32_t errors = 0;
+
+	if (!hdd_ctx || !hdd_ctx->psoc)
+		return 1;
+
+	ref = qdf_mem_malloc(sizeof(*ref));
+	if (!ref)
+		return 1;
+
+	policy_mgr_invalidate_pcl_cache(hdd_ctx->psoc);
+	if (QDF_IS_STATUS_ERROR(hdd_pcl_cache_ut_get(hdd_ctx->psoc, ref))) {
+		qdf_nofl_alert("FAIL: no SAP PCL");
+		errors++;
+		goto free;
+	}
+
+	errors += hdd_pcl_cache_ut_check(hdd_ctx->psoc, ref, true, "hit");
+	errors += hdd_pcl_cache_ut_invalidate(hdd_ctx, ref,
+					      hdd_pcl_cache_ut_flush,
+					      "invalidate");
+	errors += hdd_pcl_cache_ut_invalidate(hdd_ctx, ref,
+					      hdd_pcl_cache_ut_reg_config,
+					      "regulatory config");
+
+free:
+	qdf_mem_free(ref);
+
+	return errors;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __WLAN_HDD_PCL_CACHE_TEST
+#define __WLAN_HDD_PCL_CACHE_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_HDD_PCL_CACHE_TEST
+/**
+ * hdd_pcl_cache_unit_test() - run the policy manager PCL cache unit test
+ * suite
+ *
+ * Requests the SAP PCL of the psoc of the loaded driver twice and checks
+ * the second request is served from the cache with the same list, then
+ * checks that an explicit invalidation and a regulatory configuration
+ * update both drop the cached PCL. Meant to be run with no connection
+ * coming up or going down.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t hdd_pcl_cache_unit_test(void);
+#else
+static inline uint32_t hdd_pcl_cache_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_HDD_PCL_CACHE_TEST */
+
+#endif /* __WLAN_HDD_PCL_CACHE_TEST */
@@ -0,0 +1,499 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <linux/bitops.h>
+#include <linux/etherdevice.h>
+#include <linux/ip.h>
+#include <linux/tcp.h>
+#include <linux/udp.h>
+#include <net/ip.h>
+#include "qdf_lro.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "dp_txrx.h"
+#include "wlan_hdd_lro.h"
+#include "wlan_hdd_rx_ol.h"
+#include "wlan_hdd_tx_rx.h"
+#include "wlan_hdd_rx_ol_test.h"
+
+#define ut_bench_iterations 100000
+#define ut_max_flows 16
+/* GRO_HASH_BUCKETS of the kernel */
+#define ut_gro_buckets 8
+#define ut_payload_len 100
+#define ut_port_base 5000
+
+/**
+ * struct hdd_rx_ol_ut_ctx - private receive context of the test
+ * @hdd_ctx: hdd context the offload mode is set up in
+ * @adapter: adapter the frames are received on
+ * @netdev: unregistered net device of the adapter
+ * @napi: napi GRO is done on, in place of the DP rx thread one
+ * @lro_ctx: LRO context the frames carry in their control block
+ * @seq: next TCP sequence number of each flow
+ */
+struct hdd_rx_ol_ut_ctx {
+	struct hdd_context *hdd_ctx;
+	struct hdd_adapter *adapter;
+	struct net_device *netdev;
+	struct napi_struct napi;
+	qdf_lro_ctx_t lro_ctx;
+	uint32_t seq[ut_max_flows];
+};
+
+static struct hdd_rx_ol_ut_ctx *ut_ctx;
+
+/* stands for hdd_gro_rx_dp_thread(), on the napi of the test */
+static QDF_STATUS hdd_rx_ol_ut_gro_rx(struct hdd_adapter *adapter,
+				      struct sk_buff *skb)
+{
+	return hdd_gro_rx_bh_disable(adapter, &ut_ctx->napi, skb);
+}
+
+static int hdd_rx_ol_ut_napi_poll(struct napi_struct *napi, int budget)
+{
+	return 0;
+}
+
+/**
+ * struct hdd_rx_ol_ut_mode - rx offload mode compared with the engine
+ * @name: name of the mode in the logs
+ * @path: path of the frames of the mode
+ * @ol_enable: offload mode resolved by hdd_resolve_rx_ol_mode()
+ * @fisa: whether the frames are aggregated by FISA
+ * @rx: receive_offload_cb registered for the mode
+ */
+struct hdd_rx_ol_ut_mode {
+	const char *name;
+	enum hdd_rx_ol_path path;
+	enum RX_OFFLOAD ol_enable;
+	bool fisa;
+	QDF_STATUS (*rx)(struct hdd_adapter *adapter, struct sk_buff *skb);
+};
+
+#if defined(FEATURE_LRO) && defined(WLAN_FEATURE_LRO_CTX_IN_CB)
+static const struct hdd_rx_ol_ut_mode ut_lro = {
+	"lro", HDD_RX_OL_PATH_LRO, CFG_LRO_ENABLED, false, hdd_lro_rx
+};
+#endif
+
+static const struct hdd_rx_ol_ut_mode ut_gro = {
+	"gro", HDD_RX_OL_PATH_HW_GRO, CFG_GRO_ENABLED, false,
+	hdd_rx_ol_ut_gro_rx
+};
+
+static const struct hdd_rx_ol_ut_mode ut_fisa = {
+	"fisa", HDD_RX_OL_PATH_FISA, CFG_GRO_ENABLED, true,
+	hdd_rx_ol_ut_gro_rx
+};
+
+/*
+ * a frame of a flow as handed to hdd_rx_deliver_to_stack(), past
+ * eth_type_trans; UDP aggregated by FISA for the FISA mode, TCP otherwise
+ */
+static struct sk_buff *hdd_rx_ol_ut_frame(struct hdd_rx_ol_ut_ctx *ut,
+					  bool fisa, uint32_t flow,
+					  bool hinted)
+{
+	struct sk_buff *skb;
+	struct ethhdr *eth;
+	struct iphdr *iph;
+	struct tcphdr *tcph;
+	struct udphdr *udph;
+	uint32_t l4_len = fisa ? sizeof(*udph) : sizeof(*tcph);
+	uint32_t len = sizeof(*iph) + l4_len + ut_payload_len;
+
+	skb = alloc_skb(ETH_HLEN + len, GFP_KERNEL);
+	if (!skb)
+		return NULL;
+
+	skb_reserve(skb, ETH_HLEN);
+	iph = skb_put_zero(skb, len);
+	iph->version = 4;
+	iph->ihl = sizeof(*iph) / 4;
+	iph->tot_len = htons(len);
+	iph->frag_off = htons(IP_DF);
+	iph->ttl = 64;
+	iph->protocol = fisa ? IPPROTO_UDP : IPPROTO_TCP;
+	iph->saddr = htonl(0xc0a80102);
+	iph->daddr = htonl(0xc0a80103);
+	iph->check = ip_fast_csum(iph, iph->ihl);
+
+	if (fisa) {
+		udph = (struct udphdr *)(iph + 1);
+		udph->source = htons(ut_port_base + flow);
+		udph->dest = htons(ut_port_base);
+		udph->len = htons(l4_len + ut_payload_len);
+	} else {
+		tcph = (struct tcphdr *)(iph + 1);
+		tcph->source = htons(ut_port_base + flow);
+		tcph->dest = htons(ut_port_base);
+		tcph->seq = htonl(ut->seq[flow]);
+		tcph->ack_seq = htonl(1);
+		tcph->doff = sizeof(*tcph) / 4;
+		tcph->ack = 1;
+		tcph->window = htons(0xffff);
+	}
+
+	eth = (struct ethhdr *)skb_push(skb, ETH_HLEN);
+	eth_zero_addr(eth->h_source);
+	eth_broadcast_addr(eth->h_dest);
+	eth->h_proto = htons(ETH_P_IP);
+	skb_reset_mac_header(skb);
+	skb_pull(skb, ETH_HLEN);
+
+	skb_reset_network_header(skb);
+	skb_set_transport_header(skb, sizeof(*iph));
+	skb->protocol = htons(ETH_P_IP);
+	skb->dev = ut->netdev;
+	/* dropped by ip_rcv() once past the offload */
+	skb->pkt_type = PACKET_OTHERHOST;
+	skb->ip_summed = CHECKSUM_UNNECESSARY;
+
+	if (fisa) {
+		skb_shinfo(skb)->gso_size = ut_payload_len;
+		skb_shinfo(skb)->gso_type = SKB_GSO_UDP_L4;
+		skb_shinfo(skb)->gso_segs = 1;
+		return skb;
+	}
+
+	QDF_NBUF_CB_RX_TCP_PROTO(skb) = 1;
+	QDF_NBUF_CB_RX_LRO_ELIGIBLE(skb) = 1;
+	QDF_NBUF_CB_RX_TCP_OFFSET(skb) = sizeof(*iph);
+	QDF_NBUF_CB_RX_TCP_SEQ_NUM(skb) = ut->seq[flow];
+	QDF_NBUF_CB_RX_TCP_ACK_NUM(skb) = 1;
+	QDF_NBUF_CB_RX_TCP_WIN(skb) = 0xffff;
+	QDF_NBUF_CB_RX_FLOW_ID(skb) = hinted ? (flow + 1) * 0x9e3779b1 : 0;
+#if defined(FEATURE_LRO) && defined(WLAN_FEATURE_LRO_CTX_IN_CB)
+	QDF_NBUF_CB_RX_LRO_CTX(skb) = (unsigned char *)ut->lro_ctx;
+#endif
+	ut->seq[flow] += ut_payload_len;
+
+	return skb;
+}
+
+static uint32_t hdd_rx_ol_ut_rules(struct hdd_rx_ol_ut_ctx *ut)
+{
+	/* no receive function, the engine only picks the path */
+	struct hdd_rx_ol_engine engine = {0};
+	uint32_t path_cnt[HDD_RX_OL_PATH_MAX] = {0};
+	uint8_t buckets = 0;
+	struct sk_buff *skb;
+	uint32_t errors = 0;
+	uint32_t flow;
+
+	engine.paths = BIT(HDD_RX_OL_PATH_FISA) | BIT(HDD_RX_OL_PATH_HW_GRO) |
+		       BIT(HDD_RX_OL_PATH_SW_GRO);
+
+	skb = hdd_rx_ol_ut_frame(ut, false, 0, true);
+	if (!skb)
+		return 1;
+
+	hdd_rx_ol_engine_rx(&engine, NULL, skb, path_cnt);
+	if (path_cnt[HDD_RX_OL_PATH_HW_GRO] != 1 || !skb->l4_hash ||
+	    skb->hash != QDF_NBUF_CB_RX_FLOW_ID(skb)) {
+		qdf_nofl_alert("FAIL: hinted TCP frame not on HW GRO");
+		errors++;
+	}
+
+	QDF_NBUF_CB_RX_TCP_PROTO(skb) = 0;
+	hdd_rx_ol_engine_rx(&engine, NULL, skb, path_cnt);
+	if (path_cnt[HDD_RX_OL_PATH_NONE] != 1) {
+		qdf_nofl_alert("FAIL: non TCP frame offloaded");
+		errors++;
+	}
+	kfree_skb(skb);
+
+	for (flow = 0; flow < ut_max_flows; flow++) {
+		skb = hdd_rx_ol_ut_frame(ut, false, flow, false);
+		if (!skb)
+			return errors + 1;
+
+		hdd_rx_ol_engine_rx(&engine, NULL, skb, path_cnt);
+		buckets |= BIT(skb->hash & (ut_gro_buckets - 1));
+		kfree_skb(skb);
+	}
+
+	if (path_cnt[HDD_RX_OL_PATH_SW_GRO] != ut_max_flows) {
+		qdf_nofl_alert("FAIL: TCP frames without hint not on SW GRO");
+		errors++;
+	}
+
+	/* flows without a target hash no longer share a single GRO bucket */
+	if (hweight8(buckets) <= 1) {
+		qdf_nofl_alert("FAIL: %u flows over %u GRO buckets",
+			       ut_max_flows, hweight8(buckets));
+		errors++;
+	}
+
+	skb = hdd_rx_ol_ut_frame(ut, true, 0, false);
+	if (!skb)
+		return errors + 1;
+
+	hdd_rx_ol_engine_rx(&engine, NULL, skb, path_cnt);
+	if (path_cnt[HDD_RX_OL_PATH_FISA] != 1) {
+		qdf_nofl_alert("FAIL: FISA aggregate not delivered as is");
+		errors++;
+	}
+
+	engine.paths &= ~BIT(HDD_RX_OL_PATH_FISA);
+	hdd_rx_ol_engine_rx(&engine, NULL, skb, path_cnt);
+	if (path_cnt[HDD_RX_OL_PATH_NONE] != 2) {
+		qdf_nofl_alert("FAIL: FISA aggregate counted without FISA");
+		errors++;
+	}
+	kfree_skb(skb);
+
+	qdf_mem_zero(&engine, sizeof(engine));
+	engine.paths = BIT(HDD_RX_OL_PATH_LRO);
+
+	skb = hdd_rx_ol_ut_frame(ut, false, 0, false);
+	if (!skb)
+		return errors + 1;
+
+	hdd_rx_ol_engine_rx(&engine, NULL, skb, path_cnt);
+	if (path_cnt[HDD_RX_OL_PATH_LRO] != 1) {
+		qdf_nofl_alert("FAIL: LRO eligible frame not on LRO");
+		errors++;
+	}
+
+	QDF_NBUF_CB_RX_LRO_ELIGIBLE(skb) = 0;
+	hdd_rx_ol_engine_rx(&engine, NULL, skb, path_cnt);
+	if (path_cnt[HDD_RX_OL_PATH_NONE] != 3) {
+		qdf_nofl_alert("FAIL: LRO ineligible frame on LRO");
+		errors++;
+	}
+	kfree_skb(skb);
+
+	return errors;
+}
+
+/*
+ * receive ut_bench_iterations frames of a mode through
+ * hdd_rx_deliver_to_stack(), with or without the engine in front of the
+ * receive function of the mode; returns the time taken in ns or -1
+ */
+static int64_t hdd_rx_ol_ut_run(struct hdd_rx_ol_ut_ctx *ut,
+				const struct hdd_rx_ol_ut_mode *mode,
+				uint32_t num_flows, bool hinted, bool engine)
+{
+	struct hdd_context *hdd_ctx = ut->hdd_ctx;
+	struct sk_buff *skb;
+	int64_t start, ns;
+	uint32_t i;
+
+	qdf_mem_zero(&ut->adapter->hdd_stats.tx_rx_stats,
+		     sizeof(ut->adapter->hdd_stats.tx_rx_stats));
+	qdf_mem_zero(ut->seq, sizeof(ut->seq));
+
+	hdd_ctx->ol_enable = mode->ol_enable;
+	hdd_ctx->config->fisa_enable = mode->fisa;
+	hdd_ctx->receive_offload_cb = mode->rx;
+	if (engine)
+		hdd_rx_ol_engine_init(hdd_ctx);
+
+	start = qdf_ktime_to_ns(qdf_ktime_get());
+	for (i = 0; i < ut_bench_iterations; i++) {
+		skb = hdd_rx_ol_ut_frame(ut, mode->fisa, i % num_flows,
+					 hinted);
+		if (!skb)
+			break;
+
+		hdd_rx_deliver_to_stack(ut->adapter, skb);
+	}
+	ns = qdf_ktime_to_ns(qdf_ktime_get()) - start;
+
+	local_bh_disable();
+	if (mode->ol_enable == CFG_LRO_ENABLED)
+		qdf_lro_flush(ut->lro_ctx);
+	else
+		dp_rx_napi_gro_flush(&ut->napi, DP_RX_GRO_NORMAL_FLUSH);
+	local_bh_enable();
+
+	return i == ut_bench_iterations ? ns : -1;
+}
+
+static uint32_t hdd_rx_ol_ut_bench(struct hdd_rx_ol_ut_ctx *ut,
+				   const struct hdd_rx_ol_ut_mode *mode,
+				   uint32_t num_flows, bool hinted)
+{
+	struct hdd_tx_rx_stats *stats = &ut->adapter->hdd_stats.tx_rx_stats;
+	enum hdd_rx_ol_path path = mode->path;
+	uint32_t mode_aggregated;
+	int64_t mode_ns, engine_ns;
+	uint32_t errors = 0;
+
+	if (path == HDD_RX_OL_PATH_HW_GRO && !hinted)
+		path = HDD_RX_OL_PATH_SW_GRO;
+
+	mode_ns = hdd_rx_ol_ut_run(ut, mode, num_flows, hinted, false);
+	mode_aggregated = stats->rx_aggregated;
+	engine_ns = hdd_rx_ol_ut_run(ut, mode, num_flows, hinted, true);
+	if (mode_ns < 0 || engine_ns < 0) {
+		qdf_nofl_alert("FAIL: %s frame alloc", mode->name);
+		return 1;
+	}
+
+	qdf_nofl_info("rx_ol: %s %u flows%s mode %lld ns/pkt engine %lld ns/pkt",
+		      mode->name, num_flows, hinted ? " hinted" : "",
+		      mode_ns / ut_bench_iterations,
+		      engine_ns / ut_bench_iterations);
+
+	if (stats->rx_ol_path[path] != ut_bench_iterations) {
+		qdf_nofl_alert("FAIL: %s %u of %u frames on path %u",
+			       mode->name, stats->rx_ol_path[path],
+			       ut_bench_iterations, path);
+		errors++;
+	}
+
+	if (!mode_aggregated || stats->rx_aggregated != mode_aggregated) {
+		qdf_nofl_alert("FAIL: %s engine %u mode %u frames aggregated",
+			       mode->name, stats->rx_aggregated,
+			       mode_aggregated);
+		errors++;
+	}
+
+	return errors;
+}
+
+/*
+ * FISA aggregates are UDP, hdd_rx_deliver_to_stack() never handed them to
+ * receive_offload_cb before the engine; they are still delivered without
+ * aggregation.
+ */
+static uint32_t hdd_rx_ol_ut_fisa(struct hdd_rx_ol_ut_ctx *ut)
+{
+	struct hdd_tx_rx_stats *stats = &ut->adapter->hdd_stats.tx_rx_stats;
+	int64_t engine_ns;
+	uint32_t errors = 0;
+
+	engine_ns = hdd_rx_ol_ut_run(ut, &ut_fisa, ut_max_flows, false, true);
+	if (engine_ns < 0) {
+		qdf_nofl_alert("FAIL: fisa frame alloc");
+		return 1;
+	}
+
+	qdf_nofl_info("rx_ol: fisa %u flows engine %lld ns/pkt",
+		      ut_max_flows, engine_ns / ut_bench_iterations);
+
+	if (stats->rx_ol_path[HDD_RX_OL_PATH_FISA] != ut_bench_iterations ||
+	    stats->rx_aggregated ||
+	    stats->rx_non_aggregated != ut_bench_iterations) {
+		qdf_nofl_alert("FAIL: fisa %u on path %u aggregated %u not",
+			       stats->rx_ol_path[HDD_RX_OL_PATH_FISA],
+			       stats->rx_aggregated,
+			       stats->rx_non_aggregated);
+		errors++;
+	}
+
+	return errors;
+}
+
+static struct hdd_rx_ol_ut_ctx *hdd_rx_ol_ut_ctx_create(void)
+{
+	struct hdd_rx_ol_ut_ctx *ut;
+
+	ut = qdf_mem_malloc(sizeof(*ut));
+	if (!ut)
+		return NULL;
+
+	ut->hdd_ctx = qdf_mem_malloc(sizeof(*ut->hdd_ctx));
+	if (!ut->hdd_ctx)
+		goto free_ut;
+
+	ut->hdd_ctx->config = qdf_mem_malloc(sizeof(*ut->hdd_ctx->config));
+	if (!ut->hdd_ctx->config)
+		goto free_hdd_ctx;
+
+	ut->adapter = qdf_mem_malloc(sizeof(*ut->adapter));
+	if (!ut->adapter)
+		goto free_config;
+
+	ut->netdev = alloc_etherdev(0);
+	if (!ut->netdev)
+		goto free_adapter;
+
+	ut->netdev->features |= NETIF_F_GRO | NETIF_F_LRO;
+	netif_napi_add(ut->netdev, &ut->napi, hdd_rx_ol_ut_napi_poll, 64);
+	napi_enable(&ut->napi);
+	ut->lro_ctx = qdf_lro_init();
+
+	/* high throughput, so that GRO is not flushed after each frame */
+	qdf_atomic_set(&ut->hdd_ctx->dp_agg_param.rx_aggregation, 1);
+	hdd_set_current_throughput_level(ut->hdd_ctx, PLD_BUS_WIDTH_HIGH);
+	ut->hdd_ctx->enable_dp_rx_threads = true;
+	ut->adapter->hdd_ctx = ut->hdd_ctx;
+	ut->adapter->dev = ut->netdev;
+
+	return ut;
+
+free_adapter:
+	qdf_mem_free(ut->adapter);
+free_config:
+	qdf_mem_free(ut->hdd_ctx->config);
+free_hdd_ctx:
+	qdf_mem_free(ut->hdd_ctx);
+free_ut:
+	qdf_mem_free(ut);
+
+	return NULL;
+}
+
+static void hdd_rx_ol_ut_ctx_destroy(struct hdd_rx_ol_ut_ctx *ut)
+{
+	qdf_lro_deinit(ut->lro_ctx);
+	netif_napi_del(&ut->napi);
+	free_netdev(ut->netdev);
+	qdf_mem_free(ut->adapter);
+	qdf_mem_free(ut->hdd_ctx->config);
+	qdf_mem_free(ut->hdd_ctx);
+	qdf_mem_free(ut);
+}
+
+uint32_t hdd_rx_ol_engine_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	ut_ctx = hdd_rx_ol_ut_ctx_create();
+	if (!ut_ctx) {
+		qdf_nofl_alert("FAIL: rx_ol test context alloc");
+		return 1;
+	}
+
+	errors += hdd_rx_ol_ut_rules(ut_ctx);
+#if defined(FEATURE_LRO) && defined(WLAN_FEATURE_LRO_CTX_IN_CB)
+	if (ut_ctx->lro_ctx) {
+		errors += hdd_rx_ol_ut_bench(ut_ctx, &ut_lro, ut_max_flows,
+					     true);
+	} else {
+		qdf_nofl_alert("FAIL: LRO context alloc");
+		errors++;
+	}
+#else
+	qdf_nofl_info("rx_ol: lro skipped, no LRO context in the nbuf cb");
+#endif
+	errors += hdd_rx_ol_ut_bench(ut_ctx, &ut_gro, ut_max_flows, true);
+	errors += hdd_rx_ol_ut_bench(ut_ctx, &ut_gro, ut_max_flows, false);
+	errors += hdd_rx_ol_ut_fisa(ut_ctx);
+
+	hdd_rx_ol_ut_ctx_destroy(ut_ctx);
+	ut_ctx = NULL;
+
+	return errors;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __WLAN_HDD_RX_OL_TEST
+#define __WLAN_HDD_RX_OL_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_HDD_RX_OL_ENGINE_TEST
+/**
+ * hdd_rx_ol_engine_unit_test() - run the rx offload engine unit test suite
+ *
+ * Checks the path picked for frames with and without target hints and the
+ * number of GRO hash buckets flows without a hint are spread over. Then
+ * receives frames through hdd_rx_deliver_to_stack() with the LRO and GRO
+ * receive functions, with and without the engine in front of them, on a
+ * private hdd context, comparing the frames aggregated and the per frame
+ * cost, and checks FISA aggregates are still delivered without
+ * aggregation.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t hdd_rx_ol_engine_unit_test(void);
+#else
+static inline uint32_t hdd_rx_ol_engine_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_HDD_RX_OL_ENGINE_TEST */
+
+#endif /* __WLAN_HDD_RX_OL_TEST */
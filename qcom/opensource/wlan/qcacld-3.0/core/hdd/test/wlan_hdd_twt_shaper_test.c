@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_threads.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "wlan_hdd_twt_shaper.h"
+#include "wlan_hdd_twt_shaper_test.h"
+
+#define ut_wake_dur_us 4000
+#define ut_sp_offset_us 10000
+#define ut_max_sent 8
+
+/**
+ * struct hdd_twt_shaper_ut_ctx - data path stub the shaper sends to
+ * @adapter: stub adapter the shaper runs on
+ * @sent: frames handed to the data path
+ * @order: marks of the first frames handed to the data path
+ * @inject: frame handed to the shaper from the data path once it is sent
+ *  the first released frame
+ * @inject_held: @inject was held by the shaper
+ */
+struct hdd_twt_shaper_ut_ctx {
+	struct hdd_adapter *adapter;
+	qdf_atomic_t sent;
+	uint32_t order[ut_max_sent];
+	qdf_nbuf_t inject;
+	bool inject_held;
+};
+
+static struct hdd_twt_shaper_ut_ctx ut;
+
+static qdf_nbuf_t hdd_twt_shaper_ut_tx_fn(struct cdp_soc_t *soc,
+					  uint8_t vdev_id, qdf_nbuf_t nbuf)
+{
+	int sent = qdf_atomic_inc_return(&ut.sent);
+	qdf_nbuf_t inject = ut.inject;
+
+	if (sent <= ut_max_sent)
+		ut.order[sent - 1] = nbuf->mark;
+	qdf_nbuf_free(nbuf);
+
+	/* frames sent while the release is in progress queue behind it */
+	if (inject) {
+		ut.inject = NULL;
+		ut.inject_held = __hdd_twt_shaper_tx(ut.adapter, inject,
+						     SME_AC_BE);
+		if (!ut.inject_held)
+			qdf_nbuf_free(inject);
+	}
+
+	return NULL;
+}
+
+static qdf_nbuf_t hdd_twt_shaper_ut_frame(uint8_t tid, uint32_t mark)
+{
+	qdf_nbuf_t nbuf = qdf_nbuf_alloc(NULL, 64, 0, 4, false);
+
+	if (!nbuf)
+		return NULL;
+
+	nbuf->priority = tid;
+	nbuf->mark = mark;
+
+	return nbuf;
+}
+
+/* hand a frame to the shaper, free it if it is to be sent right away */
+static bool hdd_twt_shaper_ut_tx(uint8_t tid, uint32_t mark,
+				 sme_ac_enum_type ac, bool bcast)
+{
+	qdf_nbuf_t nbuf = hdd_twt_shaper_ut_frame(tid, mark);
+
+	if (!nbuf)
+		return false;
+
+	QDF_NBUF_CB_GET_IS_BCAST(nbuf) = bcast;
+	if (__hdd_twt_shaper_tx(ut.adapter, nbuf, ac))
+		return true;
+
+	qdf_nbuf_free(nbuf);
+
+	return false;
+}
+
+static bool hdd_twt_shaper_ut_wait(uint32_t sent, uint32_t timeout_ms)
+{
+	while (qdf_atomic_read(&ut.sent) < sent) {
+		if (!timeout_ms--)
+			return false;
+		qdf_sleep(1);
+	}
+
+	return true;
+}
+
+static uint64_t hdd_twt_shaper_ut_now_us(void)
+{
+	return qdf_ktime_to_us(qdf_ktime_get());
+}
+
+static QDF_STATUS hdd_twt_shaper_ut_start(uint32_t max_delay_us,
+					  uint32_t wake_intvl_us,
+					  uint32_t wake_dur_us,
+					  uint32_t sp_offset_us)
+{
+	struct hdd_adapter *adapter;
+
+	qdf_mem_zero(&ut, sizeof(ut));
+	adapter = qdf_mem_malloc(sizeof(*adapter));
+	if (!adapter)
+		return QDF_STATUS_E_NOMEM;
+
+	adapter->hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	if (!adapter->hdd_ctx) {
+		qdf_mem_free(adapter);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	adapter->device_mode = QDF_STA_MODE;
+	adapter->tx_fn = hdd_twt_shaper_ut_tx_fn;
+	hdd_twt_shaper_init(adapter);
+	adapter->twt_shaper.max_delay_us = max_delay_us;
+	ut.adapter = adapter;
+
+	__hdd_twt_shaper_setup(adapter, 1, wake_dur_us, wake_intvl_us,
+			       sp_offset_us, 0);
+	if (!adapter->twt_shaper.enabled) {
+		hdd_twt_shaper_deinit(adapter);
+		qdf_mem_free(adapter);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void hdd_twt_shaper_ut_stop(void)
+{
+	hdd_twt_shaper_deinit(ut.adapter);
+	qdf_mem_free(ut.adapter);
+	ut.adapter = NULL;
+}
+
+/* urgent frames, overflow and the deadline of the held frames */
+static uint32_t hdd_twt_shaper_ut_hold(void)
+{
+	struct hdd_twt_shaper_stats *stats;
+	uint64_t hold_us, sent_us;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	if (QDF_IS_STATUS_ERROR(hdd_twt_shaper_ut_start(20000, 1000000, 10000,
+							500000))) {
+		qdf_nofl_alert("FAIL: shaper not started");
+		return 1;
+	}
+	stats = &ut.adapter->twt_shaper.stats;
+
+	if (hdd_twt_shaper_ut_tx(6, 0, SME_AC_VO, false) ||
+	    hdd_twt_shaper_ut_tx(0, 0, SME_AC_BE, true) ||
+	    stats->tx_urgent != 2) {
+		qdf_nofl_alert("FAIL: urgent frames held, %u sent",
+			       stats->tx_urgent);
+		errors++;
+	}
+
+	hold_us = hdd_twt_shaper_ut_now_us();
+	for (i = 0; i < HDD_TWT_SHAPER_MAX_HELD; i++) {
+		if (!hdd_twt_shaper_ut_tx(0, i, SME_AC_BE, false))
+			break;
+	}
+	if (i != HDD_TWT_SHAPER_MAX_HELD ||
+	    hdd_twt_shaper_ut_tx(0, i, SME_AC_BE, false) ||
+	    stats->overflow != 1) {
+		qdf_nofl_alert("FAIL: %u frames held, overflow %u", i,
+			       stats->overflow);
+		errors++;
+	}
+
+	/* the first hold moves the timer from the service period to the
+	 * deadline, which comes long before the service period
+	 */
+	if (!hdd_twt_shaper_ut_wait(HDD_TWT_SHAPER_MAX_HELD, 400)) {
+		qdf_nofl_alert("FAIL: %u frames released by the deadline",
+			       qdf_atomic_read(&ut.sent));
+		errors++;
+	}
+	sent_us = hdd_twt_shaper_ut_now_us();
+
+	if (sent_us - hold_us < 20000 || stats->tx_deadline != i ||
+	    stats->sps) {
+		qdf_nofl_alert("FAIL: released after %llu us, deadline %u sps %u",
+			       sent_us - hold_us, stats->tx_deadline,
+			       stats->sps);
+		errors++;
+	}
+
+	hdd_twt_shaper_ut_stop();
+
+	return errors;
+}
+
+/* release at the service period, and frames sent during the release */
+static uint32_t hdd_twt_shaper_ut_release(void)
+{
+	static const uint32_t order[] = {2, 3, 1, 4};
+	struct hdd_twt_shaper_stats *stats;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	if (QDF_IS_STATUS_ERROR(hdd_twt_shaper_ut_start(1000000, 1000000,
+							50000, 30000))) {
+		qdf_nofl_alert("FAIL: shaper not started");
+		return 1;
+	}
+	stats = &ut.adapter->twt_shaper.stats;
+
+	ut.inject = hdd_twt_shaper_ut_frame(1, 4);
+	if (!ut.inject || !hdd_twt_shaper_ut_tx(1, 1, SME_AC_BK, false) ||
+	    !hdd_twt_shaper_ut_tx(0, 2, SME_AC_BE, false) ||
+	    !hdd_twt_shaper_ut_tx(0, 3, SME_AC_BE, false)) {
+		qdf_nofl_alert("FAIL: frames not held before the sp");
+		errors++;
+		goto stop;
+	}
+
+	if (!hdd_twt_shaper_ut_wait(QDF_ARRAY_SIZE(order), 500) ||
+	    !ut.inject_held) {
+		qdf_nofl_alert("FAIL: %u frames released, inject held %d",
+			       qdf_atomic_read(&ut.sent), ut.inject_held);
+		errors++;
+		goto stop;
+	}
+
+	/* BE ahead of BK, the frame sent during the release last */
+	for (i = 0; i < QDF_ARRAY_SIZE(order); i++) {
+		if (ut.order[i] != order[i]) {
+			qdf_nofl_alert("FAIL: frame %u released as %u",
+				       order[i], ut.order[i]);
+			errors++;
+		}
+	}
+
+	/* once the release is over, frames pass in the service period */
+	for (i = 0; ut.adapter->twt_shaper.releasing && i < 10; i++)
+		qdf_sleep(1);
+	if (hdd_twt_shaper_ut_tx(0, 5, SME_AC_BE, false) ||
+	    stats->sps != 1 || stats->tx_in_sp != 5 || stats->tx_deadline) {
+		qdf_nofl_alert("FAIL: sps %u in sp %u deadline %u",
+			       stats->sps, stats->tx_in_sp,
+			       stats->tx_deadline);
+		errors++;
+	}
+
+	/* and are held again once it is over */
+	qdf_sleep(100);
+	if (!hdd_twt_shaper_ut_tx(0, 6, SME_AC_BE, false)) {
+		qdf_nofl_alert("FAIL: frame not held after the sp");
+		errors++;
+	}
+
+	hdd_twt_shaper_flush(ut.adapter);
+	if (stats->dropped != 1 || stats->batch_hist[2] != 1) {
+		qdf_nofl_alert("FAIL: dropped %u batch 5-16 %u",
+			       stats->dropped, stats->batch_hist[2]);
+		errors++;
+	}
+
+stop:
+	hdd_twt_shaper_ut_stop();
+
+	return errors;
+}
+
+/* the held frames are sent on suspend, shaping starts again on resume */
+static uint32_t hdd_twt_shaper_ut_suspend(void)
+{
+	struct hdd_twt_shaper *shaper;
+	uint32_t errors = 0;
+
+	if (QDF_IS_STATUS_ERROR(hdd_twt_shaper_ut_start(1000000, 1000000,
+							10000, 500000))) {
+		qdf_nofl_alert("FAIL: shaper not started");
+		return 1;
+	}
+	shaper = &ut.adapter->twt_shaper;
+
+	hdd_twt_shaper_ut_tx(0, 1, SME_AC_BE, false);
+	hdd_twt_shaper_ut_tx(0, 2, SME_AC_BE, false);
+	hdd_twt_shaper_suspend(ut.adapter);
+	if (qdf_atomic_read(&ut.sent) != 2 || shaper->stats.tx_suspend != 2 ||
+	    shaper->enabled) {
+		qdf_nofl_alert("FAIL: %u sent on suspend, enabled %d",
+			       qdf_atomic_read(&ut.sent), shaper->enabled);
+		errors++;
+	}
+
+	hdd_twt_shaper_resume(ut.adapter);
+	if (!shaper->enabled ||
+	    !hdd_twt_shaper_ut_tx(0, 3, SME_AC_BE, false)) {
+		qdf_nofl_alert("FAIL: not shaping after resume");
+		errors++;
+	}
+
+	hdd_twt_shaper_ut_stop();
+
+	return errors;
+}
+
+static uint32_t hdd_twt_shaper_ut_schedule(void)
+{
+	struct hdd_twt_shaper shaper = {0};
+	uint32_t errors = 0;
+
+	if (hdd_twt_shaper_batch_bin(0) || hdd_twt_shaper_batch_bin(4) != 1 ||
+	    hdd_twt_shaper_batch_bin(5) != 2 ||
+	    hdd_twt_shaper_batch_bin(64) != 3 ||
+	    hdd_twt_shaper_batch_bin(65) != HDD_TWT_SHAPER_BATCH_BINS - 1) {
+		qdf_nofl_alert("FAIL: batch histogram bins");
+		errors++;
+	}
+
+	shaper.wake_dur_us = ut_wake_dur_us;
+	shaper.wake_intvl_us = 50000;
+	shaper.next_sp_us = ut_sp_offset_us;
+
+	/* a resume long after the pause keeps the phase of the schedule */
+	hdd_twt_shaper_skip_sps(&shaper, 1000000);
+	if (shaper.next_sp_us != 1010000) {
+		qdf_nofl_alert("FAIL: next sp at %llu us after skip",
+			       shaper.next_sp_us);
+		errors++;
+	}
+
+	/* the service period in progress is not skipped */
+	hdd_twt_shaper_skip_sps(&shaper, 1010000 + ut_wake_dur_us - 1);
+	if (shaper.next_sp_us != 1010000) {
+		qdf_nofl_alert("FAIL: running sp skipped");
+		errors++;
+	}
+
+	/* drift is corrected to the closest service period by the TSF */
+	if (!hdd_twt_shaper_reanchor(&shaper, 1000000, 10200) ||
+	    shaper.next_sp_us != 1010200 ||
+	    !hdd_twt_shaper_reanchor(&shaper, 1010100, 49900) ||
+	    shaper.next_sp_us != 1010000) {
+		qdf_nofl_alert("FAIL: next sp at %llu us after resync",
+			       shaper.next_sp_us);
+		errors++;
+	}
+
+	/* a sample off by more than drift is ignored */
+	if (hdd_twt_shaper_reanchor(&shaper, 1000000, 25000) ||
+	    shaper.next_sp_us != 1010000 || shaper.stats.resyncs != 2 ||
+	    shaper.stats.resyncs_rejected != 1) {
+		qdf_nofl_alert("FAIL: bad TSF sample applied");
+		errors++;
+	}
+
+	return errors;
+}
+
+uint32_t hdd_twt_shaper_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += hdd_twt_shaper_ut_schedule();
+	errors += hdd_twt_shaper_ut_hold();
+	errors += hdd_twt_shaper_ut_release();
+	errors += hdd_twt_shaper_ut_suspend();
+
+	return errors;
+}
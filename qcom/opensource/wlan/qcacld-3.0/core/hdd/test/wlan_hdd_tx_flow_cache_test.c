@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <linux/ip.h>
+#include <linux/tcp.h>
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "wlan_hdd_tx_rx.h"
+#include "wlan_hdd_tx_flow_cache.h"
+#include "wlan_hdd_tx_flow_cache_test.h"
+
+#define ut_cpu 0
+#define ut_bench_iterations 100000
+#define ut_frame_len (ETH_HLEN + sizeof(struct iphdr) + sizeof(struct tcphdr))
+
+/* flows are told apart by socket address only, the sockets are not used */
+static uint8_t ut_sk[2];
+
+static const uint8_t ut_ucast_da[ETH_ALEN] = {
+	0x00, 0x03, 0x7f, 0x01, 0x02, 0x03};
+static const uint8_t ut_bcast_da[ETH_ALEN] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+static const uint8_t ut_mcast_da[ETH_ALEN] = {
+	0x01, 0x00, 0x5e, 0x00, 0x00, 0x01};
+
+static struct sk_buff *hdd_tx_flow_cache_ut_frame(uint32_t hash, void *sk,
+						  const uint8_t *da)
+{
+	struct sk_buff *skb;
+	struct ethhdr *eh;
+	struct iphdr *iph;
+
+	skb = alloc_skb(ut_frame_len, GFP_KERNEL);
+	if (!skb)
+		return NULL;
+
+	eh = skb_put_zero(skb, ut_frame_len);
+	qdf_mem_copy(eh->h_dest, da, ETH_ALEN);
+	eh->h_proto = htons(ETH_P_IP);
+
+	iph = (struct iphdr *)(eh + 1);
+	iph->version = 4;
+	iph->ihl = sizeof(*iph) / 4;
+	iph->tot_len = htons(ut_frame_len - ETH_HLEN);
+	iph->protocol = IPPROTO_TCP;
+
+	skb_reset_mac_header(skb);
+	skb_set_network_header(skb, ETH_HLEN);
+	skb->protocol = htons(ETH_P_IP);
+	skb->sk = sk;
+	skb_set_hash(skb, hash, PKT_HASH_TYPE_L4);
+
+	return skb;
+}
+
+static void hdd_tx_flow_cache_ut_free(struct sk_buff *skb)
+{
+	skb->sk = NULL;
+	kfree_skb(skb);
+}
+
+static uint32_t hdd_tx_flow_cache_ut_rules(struct hdd_tx_flow_cache *cache)
+{
+	struct hdd_tx_flow_entry *entry;
+	struct sk_buff *skb, *other_sk, *alias;
+	uint32_t errors = 0;
+
+	skb = hdd_tx_flow_cache_ut_frame(7, &ut_sk[0], ut_ucast_da);
+	other_sk = hdd_tx_flow_cache_ut_frame(7, &ut_sk[1], ut_ucast_da);
+	alias = hdd_tx_flow_cache_ut_frame(7 + HDD_TX_FLOW_CACHE_SIZE,
+					   &ut_sk[0], ut_ucast_da);
+	if (!skb || !other_sk || !alias) {
+		errors++;
+		goto free;
+	}
+
+	if (hdd_tx_flow_cache_lookup(cache, skb, ut_cpu)) {
+		qdf_nofl_alert("FAIL: hit in an empty cache");
+		errors++;
+	}
+
+	hdd_tx_flow_cache_update(cache, skb, ut_cpu, HDD_TX_FLOW_PLAIN, 0);
+	hdd_tx_flow_cache_update(cache, skb, ut_cpu, HDD_TX_FLOW_UP, 5);
+	entry = hdd_tx_flow_cache_lookup(cache, skb, ut_cpu);
+	if (!entry || entry->flags != (HDD_TX_FLOW_PLAIN | HDD_TX_FLOW_UP) ||
+	    entry->up != 5) {
+		qdf_nofl_alert("FAIL: flow not memoized");
+		errors++;
+	}
+
+	if (hdd_tx_flow_cache_lookup(cache, other_sk, ut_cpu)) {
+		qdf_nofl_alert("FAIL: hit for the same hash from another socket");
+		errors++;
+	}
+
+	/* a flow hashing to the same slot replaces the cached one */
+	hdd_tx_flow_cache_update(cache, alias, ut_cpu, HDD_TX_FLOW_PLAIN, 0);
+	if (hdd_tx_flow_cache_lookup(cache, skb, ut_cpu) ||
+	    !hdd_tx_flow_cache_lookup(cache, alias, ut_cpu)) {
+		qdf_nofl_alert("FAIL: aliasing flow did not replace the entry");
+		errors++;
+	}
+
+	/* as done by hdd_tx_flow_cache_flush() */
+	cache->gen++;
+	if (hdd_tx_flow_cache_lookup(cache, alias, ut_cpu)) {
+		qdf_nofl_alert("FAIL: hit after flush");
+		errors++;
+	}
+
+	skb->l4_hash = 0;
+	hdd_tx_flow_cache_update(cache, skb, ut_cpu, HDD_TX_FLOW_PLAIN, 0);
+	if (hdd_tx_flow_cache_lookup(cache, skb, ut_cpu)) {
+		qdf_nofl_alert("FAIL: frame without L4 hash cached");
+		errors++;
+	}
+
+free:
+	if (skb)
+		hdd_tx_flow_cache_ut_free(skb);
+	if (other_sk)
+		hdd_tx_flow_cache_ut_free(other_sk);
+	if (alias)
+		hdd_tx_flow_cache_ut_free(alias);
+
+	return errors;
+}
+
+/* group addressed frames are classified every time and never cached */
+static uint32_t hdd_tx_flow_cache_ut_group(struct hdd_adapter *adapter,
+					   const uint8_t *da,
+					   const char *name)
+{
+	struct hdd_tx_rx_stats *stats = &adapter->hdd_stats.tx_rx_stats;
+	struct sk_buff *skb;
+	uint32_t hit, miss;
+	uint32_t errors = 0;
+	int i;
+
+	skb = hdd_tx_flow_cache_ut_frame(11, &ut_sk[0], da);
+	if (!skb)
+		return 1;
+
+	hdd_tx_flow_cache_flush(adapter);
+	hit = stats->per_cpu[ut_cpu].tx_flow_hit;
+	miss = stats->per_cpu[ut_cpu].tx_flow_miss;
+
+	for (i = 0; i < 2; i++) {
+		hdd_tx_classify_pkt(adapter, skb, ut_cpu);
+		if (!QDF_NBUF_CB_GET_IS_BCAST(skb) &&
+		    !QDF_NBUF_CB_GET_IS_MCAST(skb)) {
+			qdf_nofl_alert("FAIL: %s frame %d not classified",
+				       name, i);
+			errors++;
+		}
+	}
+
+	if (stats->per_cpu[ut_cpu].tx_flow_hit != hit ||
+	    stats->per_cpu[ut_cpu].tx_flow_miss != miss + 2) {
+		qdf_nofl_alert("FAIL: %s frames hit the cache", name);
+		errors++;
+	}
+
+	if (hdd_tx_flow_cache_lookup(&adapter->tx_flow_cache, skb, ut_cpu)) {
+		qdf_nofl_alert("FAIL: %s flow cached", name);
+		errors++;
+	}
+
+	hdd_tx_flow_cache_ut_free(skb);
+
+	return errors;
+}
+
+static uint32_t hdd_tx_flow_cache_ut_bench(struct hdd_adapter *adapter,
+					   uint32_t num_flows)
+{
+	struct hdd_tx_rx_stats *stats = &adapter->hdd_stats.tx_rx_stats;
+	struct sk_buff *skb;
+	int64_t start, parse_ns, cached_ns;
+	uint32_t hits;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	skb = hdd_tx_flow_cache_ut_frame(0, &ut_sk[0], ut_ucast_da);
+	if (!skb)
+		return 1;
+
+	hdd_tx_flow_cache_flush(adapter);
+
+	start = qdf_ktime_to_ns(qdf_ktime_get());
+	for (i = 0; i < ut_bench_iterations; i++)
+		wlan_hdd_classify_pkt(skb);
+	parse_ns = qdf_ktime_to_ns(qdf_ktime_get()) - start;
+
+	hits = stats->per_cpu[ut_cpu].tx_flow_hit;
+	start = qdf_ktime_to_ns(qdf_ktime_get());
+	for (i = 0; i < ut_bench_iterations; i++) {
+		skb->hash = i % num_flows;
+		hdd_tx_classify_pkt(adapter, skb, ut_cpu);
+	}
+	cached_ns = qdf_ktime_to_ns(qdf_ktime_get()) - start;
+	hits = stats->per_cpu[ut_cpu].tx_flow_hit - hits;
+
+	qdf_nofl_info("tx_flow_cache: %u flows parse %lld ns/pkt cached %lld ns/pkt hit rate %u%%",
+		      num_flows, parse_ns / ut_bench_iterations,
+		      cached_ns / ut_bench_iterations,
+		      (uint32_t)((uint64_t)hits * 100 / ut_bench_iterations));
+
+	/* every flow misses once when it fits the cache */
+	if (num_flows <= HDD_TX_FLOW_CACHE_SIZE &&
+	    hits != ut_bench_iterations - num_flows) {
+		qdf_nofl_alert("FAIL: %u flows %u hits, expected %u",
+			       num_flows, hits,
+			       ut_bench_iterations - num_flows);
+		errors++;
+	}
+
+	hdd_tx_flow_cache_ut_free(skb);
+
+	return errors;
+}
+
+uint32_t hdd_tx_flow_cache_unit_test(void)
+{
+	struct hdd_adapter *adapter;
+	uint32_t errors = 0;
+
+	/* only the flow cache and the tx stats of the adapter are used */
+	adapter = qdf_mem_malloc(sizeof(*adapter));
+	if (!adapter)
+		return 1;
+
+	errors += hdd_tx_flow_cache_ut_rules(&adapter->tx_flow_cache);
+	errors += hdd_tx_flow_cache_ut_group(adapter, ut_bcast_da, "bcast");
+	errors += hdd_tx_flow_cache_ut_group(adapter, ut_mcast_da, "mcast");
+	errors += hdd_tx_flow_cache_ut_bench(adapter, 1);
+	errors += hdd_tx_flow_cache_ut_bench(adapter, HDD_TX_FLOW_CACHE_SIZE);
+	errors += hdd_tx_flow_cache_ut_bench(adapter,
+					     HDD_TX_FLOW_CACHE_SIZE * 2);
+
+	qdf_mem_free(adapter);
+
+	return errors;
+}
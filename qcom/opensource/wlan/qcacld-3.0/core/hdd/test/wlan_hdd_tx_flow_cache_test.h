@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __WLAN_HDD_TX_FLOW_CACHE_TEST
+#define __WLAN_HDD_TX_FLOW_CACHE_TEST
+
+#include "qdf_types.h"
+
+#ifdef WLAN_HDD_TX_FLOW_CACHE_TEST
+/**
+ * hdd_tx_flow_cache_unit_test() - run the tx flow cache unit test suite
+ *
+ * Checks the hit, miss, replacement and flush rules of the cache and that
+ * broadcast and multicast frames are never cached, then times
+ * hdd_tx_classify_pkt() against a full parse of a TCP frame and logs the
+ * cost per frame and the hit rate of a few flow mixes.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t hdd_tx_flow_cache_unit_test(void);
+#else
+static inline uint32_t hdd_tx_flow_cache_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_HDD_TX_FLOW_CACHE_TEST */
+
+#endif /* __WLAN_HDD_TX_FLOW_CACHE_TEST */
@@ -40,6 +40,7 @@
 #include "lim_send_messages.h"
 #include "cfg_ucfg_api.h"
 #include <lim_assoc_utils.h>
+#include "wlan_policy_mgr_api.h"
 
 #ifdef WLAN_ALLOCATE_GLOBAL_BUFFERS_DYNAMICALLY
 static struct sDphHashNode *g_dph_node_array;
@@ -1012,6 +1013,7 @@ void pe_delete_session(struct mac_context *mac_ctx, struct pe_session *session)
 	if (LIM_IS_AP_ROLE(session)) {
 		lim_check_and_reset_protection_params(mac_ctx);
 		wlan_set_sap_user_config_freq(session->vdev, 0);
+		policy_mgr_invalidate_pcl_cache(mac_ctx->psoc);
 	}
 
 	session->user_edca_set = 0;
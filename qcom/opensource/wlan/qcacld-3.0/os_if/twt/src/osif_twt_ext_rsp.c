@@ -32,6 +32,7 @@
 #include <wlan_twt_ucfg_ext_api.h>
 #include <wlan_twt_ucfg_ext_cfg.h>
 #include <wlan_cp_stats_ucfg_api.h>
+#include "wlan_hdd_twt_shaper.h"
 
 /**
  * osif_twt_get_setup_event_len() - Calculates the length of twt
@@ -927,6 +928,8 @@ osif_twt_setup_complete_cb(struct wlan_objmgr_psoc *psoc,
 			   struct twt_add_dialog_complete_event *event,
 			   bool renego_fail)
 {
+	struct twt_add_dialog_additional_params *add_params =
+						&event->additional_params;
 	uint32_t vdev_id = event->params.vdev_id;
 
 	osif_debug("TWT: add dialog_id:%d, status:%d vdev_id:%d renego_fail:%d peer mac_addr "
@@ -936,6 +939,16 @@ osif_twt_setup_complete_cb(struct wlan_objmgr_psoc *psoc,
 
 	osif_twt_setup_response(psoc, event);
 
+	if (event->params.status == HOST_ADD_TWT_STATUS_OK &&
+	    event->params.num_additional_twt_params &&
+	    !add_params->bcast)
+		hdd_twt_shaper_setup(psoc, vdev_id, event->params.dialog_id,
+				     add_params->wake_dur_us,
+				     add_params->wake_intvl_us,
+				     add_params->sp_offset_us,
+				     (uint64_t)add_params->sp_tsf_us_hi << 32 |
+				     add_params->sp_tsf_us_lo);
+
 	if (renego_fail)
 		osif_twt_handle_renego_failure(psoc, event);
 
@@ -955,6 +968,11 @@ osif_twt_teardown_complete_cb(struct wlan_objmgr_psoc *psoc,
 
 	osif_twt_teardown_response(psoc, event);
 
+	/* the session is gone unless the teardown itself failed */
+	if (event->status == HOST_TWT_DEL_STATUS_OK ||
+	    event->status >= HOST_TWT_DEL_STATUS_PEER_INIT_TEARDOWN)
+		hdd_twt_shaper_teardown(psoc, vdev_id, event->dialog_id);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -994,6 +1012,9 @@ osif_twt_resume_complete_cb(struct wlan_objmgr_psoc *psoc,
 		   event->status, vdev_id,
 		   QDF_MAC_ADDR_REF(event->peer_macaddr.bytes));
 
+	if (event->status == HOST_TWT_RESUME_STATUS_OK)
+		hdd_twt_shaper_pause(psoc, vdev_id, event->dialog_id, false);
+
 	data_len = osif_twt_get_event_len() + nla_total_size(sizeof(u8));
 	data_len += NLA_HDRLEN;
 
@@ -1295,6 +1316,9 @@ osif_twt_pause_complete_cb(struct wlan_objmgr_psoc *psoc,
 		   event->status, vdev_id,
 		   QDF_MAC_ADDR_REF(event->peer_macaddr.bytes));
 
+	if (event->status == HOST_TWT_PAUSE_STATUS_OK)
+		hdd_twt_shaper_pause(psoc, vdev_id, event->dialog_id, true);
+
 	data_len = osif_twt_get_event_len() + nla_total_size(sizeof(u8));
 	data_len += NLA_HDRLEN;
 
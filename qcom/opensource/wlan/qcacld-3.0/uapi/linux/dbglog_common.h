@@ -60,9 +60,46 @@ typedef enum {
 	DBGLOG_PROCESS_PRINT_RAW,       /* print them in debug view */
 	DBGLOG_PROCESS_POOL_RAW,        /* user buffer pool to save them */
 	DBGLOG_PROCESS_NET_RAW,         /* user buffer pool to save them */
+	DBGLOG_PROCESS_STREAM_RAW,      /* relay raw buffers, decode in user */
 	DBGLOG_PROCESS_MAX,
 } dbglog_process_t;
 
+/*
+ * With DBGLOG_PROCESS_STREAM_RAW the firmware log buffers are not parsed
+ * by the driver. Each WMI event buffer is written unmodified as one record
+ * to the streamfs channel of its event, fwlog/<channel><cpu> in debugfs.
+ * A record is a struct dbglog_stream_rec_hdr, whose type is one of the
+ * dbglog_stream_rec_type below, followed by the event buffer. The decoder
+ * merges the per CPU files in sequence number order and parses the
+ * buffers with the tables of dbglog_id.h and dbglog.h.
+ */
+enum dbglog_stream_rec_type {
+	DBGLOG_STREAM_REC_DBGLOG,       /* WMI_DEBUG_MESG_EVENTID */
+	DBGLOG_STREAM_REC_DIAG,         /* WMI_DIAG_EVENTID */
+	DBGLOG_STREAM_REC_DIAG_DATA,    /* WMI_DIAG_DATA_CONTAINER_EVENTID */
+	DBGLOG_STREAM_REC_MAX,
+};
+
+#define DBGLOG_STREAM_REC_MAGIC 0x5153
+
+/*
+ * Header of each record of a fwlog channel, in host byte order:
+ * magic: DBGLOG_STREAM_REC_MAGIC
+ * type:  enum dbglog_stream_rec_type
+ * len:   length of the event buffer following the header
+ * seq:   sequence number, shared by the per CPU files of a channel; a gap
+ *        means records were dropped
+ * lost:  records dropped by the driver since the previous record, because
+ *        the reader was lagging
+ */
+struct dbglog_stream_rec_hdr {
+	A_UINT16 magic;
+	A_UINT16 type;
+	A_UINT32 len;
+	A_UINT32 seq;
+	A_UINT32 lost;
+};
+
 enum cnss_diag_type {
 	DIAG_TYPE_FW_EVENT,           /* send fw event- to diag */
 	DIAG_TYPE_FW_LOG,             /* send log event- to diag */